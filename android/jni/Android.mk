@@ -17,12 +17,16 @@ LOCAL_SRC_FILES := \
 	src/gus_pat.c \
 	src/internal_midi.c \
 	src/lock.c \
+	src/mixer.c \
 	src/mus2mid.c \
 	src/patches.c \
 	src/reverb.c \
+	src/resample.c \
 	src/sample.c \
+	src/sample_cache.c \
 	src/wildmidi_lib.c \
 	src/wm_error.c \
+	src/wm_thread.c \
 	src/xmi2mid.c
 
 include $(BUILD_SHARED_LIBRARY)
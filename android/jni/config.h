@@ -49,6 +49,16 @@
 #define __builtin_expect(x,c) x
 #endif
 
+/* atomic lock operations, sleeping on a futex where there is one */
+#define HAVE___ATOMIC_BUILTINS
+#define HAVE_LINUX_FUTEX
+
+/* thread support used by multi-threaded rendering */
+#define HAVE_PTHREAD
+
+/* files are loaded with mmap() */
+#define HAVE_MMAP
+
 /* define this if you are running a bigendian system (motorola, sparc, etc) */
 /* #undef WORDS_BIGENDIAN */
 
@@ -31,15 +31,52 @@
 #endif
 #define MEM_CHUNK 8192
 
-extern int16_t _WM_MasterVolume;
-extern uint16_t _WM_SampleRate;
-extern uint16_t _WM_MixerOptions;
+struct _patch_set;
+struct _patch;
+struct _hndl;
+struct _WM_Queue;
 
-extern float _WM_reverb_room_width;  /* = 16.875f; */
-extern float _WM_reverb_room_length; /* = 22.5f;   */
+/*
+ * Everything one engine setup needs: what used to be the library globals.
+ * WildMidi_Init() sets up a default context, WildMidi_CreateContext() any
+ * number of additional ones. Every midi handle belongs to exactly one.
+ */
+struct _WM_TraceEvent;
+struct _rsm_filter;
+
+struct _context {
+    int lock;               /* guards the handle list */
+    uint32_t sample_rate;   /* that is mixed at, which songs are timed in */
+    uint32_t output_rate;   /* that is played at, see WildMidi_CreateContextRate() */
+    struct _rsm_filter *resample; /* from the one to the other, or NULL */
+    uint16_t mixer_options;
+    int16_t master_volume;
+
+    float reverb_room_width;  /* = 16.875f; */
+    float reverb_room_length; /* = 22.5f;   */
+
+    float reverb_listen_posx; /* = 8.4375f; */
+    float reverb_listen_posy; /* = 16.875f; */
+
+    struct _patch_set *patches;
+    struct _hndl *first_handle;
+    struct _song *first_song; /* see WildMidi_Parse(), also guarded by lock */
+
+    /* what WildMidi_PreloadPatches() holds, and of which patch set, and
+       the thread WildMidi_OpenAsync() opens on, all guarded by lock */
+    struct _patch_set *preload_set;
+    struct _patch **preload;
+    uint32_t preload_count;
+    struct _WM_Queue *loader;
+
+    /* what handles opened from now on are traced with, see
+       WildMidi_SetTraceCtx(), guarded by lock */
+    uint32_t trace_size;
+    void (*trace_callback)(void *user, const struct _WM_TraceEvent *event);
+    void *trace_user;
 
-extern float _WM_reverb_listen_posx; /* = 8.4375f; */
-extern float _WM_reverb_listen_posy; /* = 16.875f; */
+    uint8_t probe;          /* timing and meta data only, see WildMidi_Probe */
+};
 
 extern void _cvt_reset_options (void);
 extern uint16_t _cvt_get_option (uint16_t tag);
@@ -49,6 +49,30 @@
 #define __builtin_expect(x,c) x
 #endif
 
+/* Define if the compiler has the `__atomic' built-in functions */
+#cmakedefine HAVE___ATOMIC_BUILTINS
+
+/* Define if locks can sleep on a linux futex */
+#cmakedefine HAVE_LINUX_FUTEX
+
+/* Define if files can be loaded with mmap() */
+#cmakedefine HAVE_MMAP
+
+/* Define if the compiler can build the SIMD mixer kernels */
+#cmakedefine HAVE_SSE2_INTRINSICS
+#cmakedefine HAVE_AVX2_INTRINSICS
+#cmakedefine HAVE_NEON_INTRINSICS
+
+/* Define for the thread support used by multi-threaded rendering */
+#cmakedefine HAVE_PTHREAD
+#cmakedefine HAVE_WIN32_THREADS
+
+/* Define to build the tracing hooks, see WildMidi_SetTrace() */
+#cmakedefine WILDMIDI_TRACE 1
+
+/* Define to count how the locks are taken, see WildMidi_GetLockStats() */
+#cmakedefine WILDMIDI_LOCK_STATS 1
+
 /* define this if you are running a bigendian system (motorola, sparc, etc) */
 #cmakedefine WORDS_BIGENDIAN 1
 
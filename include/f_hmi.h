@@ -24,6 +24,6 @@
 #ifndef __HMI_H
 #define __HMI_H
 
-extern struct _mdi *_WM_ParseNewHmi(const uint8_t *hmi_data, uint32_t hmi_size);
+extern struct _mdi *_WM_ParseNewHmi(struct _context *ctx, const uint8_t *hmi_data, uint32_t hmi_size);
 
 #endif /* __HMI_H */
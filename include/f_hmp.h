@@ -24,6 +24,6 @@
 #ifndef __HMP_H
 #define __HMP_H
 
-extern struct _mdi *_WM_ParseNewHmp(const uint8_t *hmp_data, uint32_t hmp_size);
+extern struct _mdi *_WM_ParseNewHmp(struct _context *ctx, const uint8_t *hmp_data, uint32_t hmp_size);
 
 #endif /* __HMP_H */
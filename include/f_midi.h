@@ -24,7 +24,10 @@
 #ifndef __MIDI_H
 #define __MIDI_H
 
-extern struct _mdi *_WM_ParseNewMidi(const uint8_t *midi_data, uint32_t midi_size);
+extern struct _mdi *_WM_ParseNewMidi(struct _context *ctx, const uint8_t *midi_data, uint32_t midi_size);
 extern int _WM_Event2Midi(struct _mdi *mdi, uint8_t **out, uint32_t *outsize);
+extern int _WM_WriteMidi(struct _mdi *mdi,
+                         int (*write_fn)(void *ctx, const uint8_t *data, uint32_t size),
+                         void *ctx);
 
 #endif /* __MIDI_H */
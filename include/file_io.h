@@ -30,5 +30,9 @@ extern void *_WM_BufferFileImpl(const char *filename, uint32_t *size);
 extern void  _WM_FreeBufferFileImpl(void*);
 extern void * (*_WM_BufferFile)(const char *, uint32_t *);
 extern void   (*_WM_FreeBufferFile)(void*);
+extern const void *_WM_MapFileImpl(const char *filename, uint32_t *size);
+extern void  _WM_UnmapFileImpl(const void *buf, uint32_t size);
+extern const void * (*_WM_MapFile)(const char *, uint32_t *);
+extern void   (*_WM_UnmapFile)(const void *, uint32_t);
 
 #endif /* __FILE_IO_H */
@@ -0,0 +1,3082 @@
+/* gauss_table.h -- generated by gen_gauss.c, do not edit */
+
+#ifndef __GAUSS_TABLE_H
+#define __GAUSS_TABLE_H
+
+/* 35 taps per sample fraction, Q14 */
+static const int16_t gauss_table[(1<<FPBITS)][GAUSS_TAPS] = {
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+     0, 0, 0, 0, 0, 16384, 0, 0, 0, 0, 0, 0,
+     0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0, -1, 1, -1, 2,
+     -2, 3, -5, 8, -16, 16384, 16, -8, 5, -3, 2, -2,
+     1, -1, 1, 0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 1, -1, 2, -2, 3,
+     -5, 6, -9, 15, -32, 16384, 32, -15, 9, -6, 5, -3,
+     2, -2, 1, -1, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, -1, 1, -2, 2, -3, 5,
+     -7, 10, -14, 23, -47, 16384, 48, -23, 14, -10, 7, -5,
+     3, -2, 2, -1, 1, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 1, -1, 1, -2, 3, -5, 6,
+     -9, 13, -19, 30, -63, 16384, 63, -30, 19, -13, 9, -6,
+     5, -3, 2, -1, 1, -1, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 1, -1, 2, -3, 4, -6, 8,
+     -11, 16, -24, 38, -79, 16383, 79, -38, 24, -16, 11, -8,
+     6, -4, 3, -2, 1, -1, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 1, -1, 2, -3, 5, -7, 10,
+     -14, 19, -28, 45, -94, 16383, 95, -46, 28, -19, 14, -10,
+     7, -5, 3, -2, 1, -1, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 1, -2, 2, -4, 6, -8, 11,
+     -16, 23, -33, 53, -110, 16383, 111, -53, 33, -23, 16, -11,
+     8, -6, 4, -2, 2, -1, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, -1, 1, -2, 3, -4, 6, -9, 13,
+     -18, 26, -38, 60, -125, 16382, 127, -61, 38, -26, 18, -13,
+     9, -6, 4, -3, 2, -1, 1, 0, 0, 0, 0},
+    {0, 0, 0, 0, -1, 1, -2, 3, -5, 7, -10, 15,
+     -20, 29, -42, 68, -141, 16382, 143, -69, 43, -29, 20, -15,
+     10, -7, 5, -3, 2, -1, 1, 0, 0, 0, 0},
+    {0, 0, 0, 0, -1, 1, -2, 4, -5, 8, -11, 16,
+     -23, 32, -47, 75, -156, 16381, 159, -76, 47, -32, 23, -16,
+     11, -8, 5, -4, 2, -1, 1, 0, 0, 0, 0},
+    {0, 0, 0, 0, -1, 1, -2, 4, -6, 9, -13, 18,
+     -25, 35, -52, 83, -172, 16381, 176, -84, 52, -36, 25, -18,
+     13, -9, 6, -4, 2, -1, 1, 0, 0, 0, 0},
+    {0, 0, 0, 0, -1, 2, -3, 4, -6, 10, -14, 19,
+     -27, 39, -56, 90, -187, 16380, 192, -92, 57, -39, 27, -19,
+     14, -10, 6, -4, 3, -2, 1, 0, 0, 0, 0},
+    {0, 0, 0, 0, -1, 2, -3, 5, -7, 10, -15, 21,
+     -29, 42, -61, 98, -203, 16380, 208, -99, 62, -42, 30, -21,
+     15, -10, 7, -5, 3, -2, 1, 0, 0, 0, 0},
+    {0, 0, 0, 0, -1, 2, -3, 5, -8, 11, -16, 23,
+     -32, 45, -66, 105, -218, 16379, 224, -107, 66, -45, 32, -23,
+     16, -11, 8, -5, 3, -2, 1, 0, 0, 0, 0},
+    {0, 0, 0, 0, -1, 2, -3, 5, -8, 12, -17, 24,
+     -34, 48, -71, 113, -233, 16378, 240, -115, 71, -48, 34, -24,
+     17, -12, 8, -5, 3, -2, 1, 0, 0, 0, 0},
+    {0, 0, 0, 1, -1, 2, -3, 6, -9, 13, -18, 26,
+     -36, 51, -75, 120, -249, 16377, 257, -122, 76, -52, 36, -26,
+     18, -13, 9, -6, 3, -2, 1, -1, 0, 0, 0},
+    {0, 0, 0, 1, -1, 2, -4, 6, -9, 14, -19, 27,
+     -39, 55, -80, 128, -264, 16377, 273, -130, 81, -55, 39, -28,
+     20, -14, 9, -6, 4, -2, 1, -1, 0, 0, 0},
+    {0, 0, 0, 1, -1, 2, -4, 6, -10, 14, -21, 29,
+     -41, 58, -85, 135, -279, 16376, 289, -138, 86, -58, 41, -29,
+     21, -14, 10, -6, 4, -2, 1, -1, 0, 0, 0},
+    {0, 0, 0, 1, -1, 2, -4, 7, -10, 15, -22, 31,
+     -43, 61, -89, 143, -294, 16375, 305, -145, 90, -61, 43, -31,
+     22, -15, 10, -7, 4, -2, 1, -1, 0, 0, 0},
+    {0, 0, 0, 1, -1, 3, -4, 7, -11, 16, -23, 32,
+     -45, 64, -94, 150, -310, 16374, 322, -153, 95, -65, 46, -32,
+     23, -16, 11, -7, 4, -3, 1, -1, 0, 0, 0},
+    {0, 0, 0, 1, -1, 3, -5, 7, -11, 17, -24, 34,
+     -48, 67, -99, 158, -325, 16373, 338, -161, 100, -68, 48, -34,
+     24, -17, 11, -7, 5, -3, 1, -1, 0, 0, 0},
+    {0, 0, 0, 1, -2, 3, -5, 8, -12, 17, -25, 35,
+     -50, 70, -103, 165, -340, 16372, 355, -169, 105, -71, 50, -36,
+     25, -18, 12, -8, 5, -3, 2, -1, 0, 0, 0},
+    {0, 0, 0, 1, -2, 3, -5, 8, -12, 18, -26, 37,
+     -52, 74, -108, 172, -355, 16371, 371, -176, 109, -74, 52, -37,
+     26, -18, 12, -8, 5, -3, 2, -1, 0, 0, 0},
+    {0, 0, 0, 1, -2, 3, -5, 8, -13, 19, -27, 39,
+     -54, 77, -112, 180, -370, 16369, 388, -184, 114, -78, 55, -39,
+     28, -19, 13, -8, 5, -3, 2, -1, 0, 0, 0},
+    {0, 0, 0, 1, -2, 3, -5, 9, -13, 20, -29, 40,
+     -57, 80, -117, 187, -385, 16368, 404, -192, 119, -81, 57, -41,
+     29, -20, 13, -9, 5, -3, 2, -1, 0, 0, 0},
+    {0, 0, 0, 1, -2, 3, -6, 9, -14, 21, -30, 42,
+     -59, 83, -122, 195, -400, 16367, 421, -200, 124, -84, 59, -42,
+     30, -21, 14, -9, 6, -3, 2, -1, 0, 0, 0},
+    {0, 0, 0, 1, -2, 3, -6, 9, -15, 21, -31, 43,
+     -61, 86, -126, 202, -415, 16365, 437, -207, 129, -87, 62, -44,
+     31, -22, 15, -10, 6, -3, 2, -1, 0, 0, 0},
+    {0, 0, 0, 1, -2, 4, -6, 10, -15, 22, -32, 45,
+     -63, 90, -131, 209, -430, 16364, 454, -215, 133, -91, 64, -45,
+     32, -22, 15, -10, 6, -4, 2, -1, 0, 0, 0},
+    {0, 0, 0, 1, -2, 4, -6, 10, -16, 23, -33, 47,
+     -65, 93, -136, 217, -445, 16363, 471, -223, 138, -94, 66, -47,
+     33, -23, 16, -10, 6, -4, 2, -1, 0, 0, 0},
+    {0, 0, 0, 1, -2, 4, -7, 11, -16, 24, -34, 48,
+     -68, 96, -140, 224, -460, 16361, 487, -231, 143, -97, 68, -49,
+     34, -24, 16, -11, 7, -4, 2, -1, 0, 0, 0},
+    {0, 0, 0, 1, -2, 4, -7, 11, -17, 25, -35, 50,
+     -70, 99, -145, 231, -474, 16360, 504, -238, 148, -100, 71, -50,
+     36, -25, 17, -11, 7, -4, 2, -1, 0, 0, 0},
+    {0, 0, 0, 1, -2, 4, -7, 11, -17, 25, -36, 51,
+     -72, 102, -149, 239, -489, 16358, 521, -246, 153, -104, 73, -52,
+     37, -26, 17, -11, 7, -4, 2, -1, 0, 0, 0},
+    {0, 0, 0, 1, -2, 4, -7, 12, -18, 26, -38, 53,
+     -74, 105, -154, 246, -504, 16356, 537, -254, 157, -107, 75, -54,
+     38, -26, 18, -12, 7, -4, 2, -1, 0, 0, 0},
+    {0, 0, 0, 1, -2, 4, -7, 12, -18, 27, -39, 55,
+     -77, 108, -159, 253, -519, 16355, 554, -262, 162, -110, 78, -55,
+     39, -27, 18, -12, 7, -4, 2, -1, 0, 0, 0},
+    {0, 0, 0, 1, -2, 4, -8, 12, -19, 28, -40, 56,
+     -79, 112, -163, 261, -533, 16353, 571, -270, 167, -113, 80, -57,
+     40, -28, 19, -12, 8, -4, 2, -1, 0, 0, 0},
+    {0, 0, 0, 1, -2, 5, -8, 13, -19, 29, -41, 58,
+     -81, 115, -168, 268, -548, 16351, 588, -277, 172, -117, 82, -58,
+     41, -29, 19, -13, 8, -5, 2, -1, 0, 0, 0},
+    {0, 0, 0, 1, -3, 5, -8, 13, -20, 29, -42, 59,
+     -83, 118, -172, 275, -563, 16349, 605, -285, 177, -120, 85, -60,
+     42, -30, 20, -13, 8, -5, 3, -1, 0, 0, 0},
+    {0, 0, -1, 1, -3, 5, -8, 13, -20, 30, -43, 61,
+     -86, 121, -177, 282, -577, 16347, 622, -293, 181, -123, 87, -62,
+     44, -30, 21, -13, 8, -5, 3, -1, 1, 0, 0},
+    {0, 0, -1, 1, -3, 5, -8, 14, -21, 31, -44, 63,
+     -88, 124, -182, 290, -592, 16345, 639, -301, 186, -127, 89, -63,
+     45, -31, 21, -14, 9, -5, 3, -1, 1, 0, 0},
+    {0, 0, -1, 1, -3, 5, -9, 14, -21, 32, -45, 64,
+     -90, 127, -186, 297, -606, 16343, 656, -309, 191, -130, 91, -65,
+     46, -32, 22, -14, 9, -5, 3, -1, 1, 0, 0},
+    {0, 0, -1, 1, -3, 5, -9, 14, -22, 32, -47, 66,
+     -92, 130, -191, 304, -621, 16341, 673, -316, 196, -133, 94, -67,
+     47, -33, 22, -14, 9, -5, 3, -1, 1, 0, 0},
+    {0, 0, -1, 1, -3, 5, -9, 15, -22, 33, -48, 67,
+     -94, 134, -195, 311, -635, 16339, 690, -324, 201, -136, 96, -68,
+     48, -34, 23, -15, 9, -5, 3, -1, 1, 0, 0},
+    {0, 0, -1, 1, -3, 5, -9, 15, -23, 34, -49, 69,
+     -97, 137, -200, 319, -650, 16337, 707, -332, 206, -140, 98, -70,
+     49, -34, 23, -15, 9, -5, 3, -1, 1, 0, 0},
+    {0, 0, -1, 1, -3, 6, -10, 15, -24, 35, -50, 71,
+     -99, 140, -204, 326, -664, 16335, 724, -340, 210, -143, 101, -71,
+     51, -35, 24, -15, 10, -6, 3, -1, 1, 0, 0},
+    {0, 0, -1, 1, -3, 6, -10, 16, -24, 36, -51, 72,
+     -101, 143, -209, 333, -679, 16332, 741, -348, 215, -146, 103, -73,
+     52, -36, 24, -16, 10, -6, 3, -1, 1, 0, 0},
+    {0, 0, -1, 2, -3, 6, -10, 16, -25, 36, -52, 74,
+     -103, 146, -214, 340, -693, 16330, 758, -356, 220, -149, 105, -75,
+     53, -37, 25, -16, 10, -6, 3, -2, 1, 0, 0},
+    {0, 0, -1, 2, -3, 6, -10, 16, -25, 37, -53, 75,
+     -106, 149, -218, 347, -707, 16328, 775, -364, 225, -153, 107, -76,
+     54, -38, 25, -17, 10, -6, 3, -2, 1, 0, 0},
+    {0, 0, -1, 2, -3, 6, -10, 17, -26, 38, -54, 77,
+     -108, 152, -223, 355, -721, 16325, 792, -371, 230, -156, 110, -78,
+     55, -38, 26, -17, 10, -6, 3, -2, 1, 0, 0},
+    {0, 0, -1, 2, -3, 6, -11, 17, -26, 39, -56, 78,
+     -110, 155, -227, 362, -736, 16323, 809, -379, 234, -159, 112, -80,
+     56, -39, 26, -17, 11, -6, 3, -2, 1, 0, 0},
+    {0, 0, -1, 2, -3, 6, -11, 17, -27, 39, -57, 80,
+     -112, 159, -232, 369, -750, 16320, 827, -387, 239, -162, 114, -81,
+     57, -40, 27, -18, 11, -6, 3, -2, 1, 0, 0},
+    {0, 0, -1, 2, -3, 6, -11, 18, -27, 40, -58, 82,
+     -114, 162, -236, 376, -764, 16318, 844, -395, 244, -166, 117, -83,
+     59, -41, 28, -18, 11, -6, 3, -2, 1, 0, 0},
+    {0, 0, -1, 2, -4, 7, -11, 18, -28, 41, -59, 83,
+     -117, 165, -241, 383, -778, 16315, 861, -403, 249, -169, 119, -84,
+     60, -41, 28, -18, 11, -7, 4, -2, 1, 0, 0},
+    {0, 0, -1, 2, -4, 7, -11, 18, -28, 42, -60, 85,
+     -119, 168, -245, 390, -792, 16313, 879, -411, 254, -172, 121, -86,
+     61, -42, 29, -19, 12, -7, 4, -2, 1, 0, 0},
+    {0, 0, -1, 2, -4, 7, -12, 19, -29, 43, -61, 86,
+     -121, 171, -250, 397, -806, 16310, 896, -419, 259, -175, 123, -88,
+     62, -43, 29, -19, 12, -7, 4, -2, 1, 0, 0},
+    {0, 0, -1, 2, -4, 7, -12, 19, -29, 43, -62, 88,
+     -123, 174, -254, 404, -820, 16307, 913, -427, 263, -179, 126, -89,
+     63, -44, 30, -19, 12, -7, 4, -2, 1, 0, 0},
+    {0, 0, -1, 2, -4, 7, -12, 20, -30, 44, -63, 89,
+     -125, 177, -259, 412, -834, 16304, 931, -434, 268, -182, 128, -91,
+     64, -45, 30, -20, 12, -7, 4, -2, 1, 0, 0},
+    {0, 0, -1, 2, -4, 7, -12, 20, -30, 45, -65, 91,
+     -128, 180, -263, 419, -848, 16301, 948, -442, 273, -185, 130, -93,
+     65, -45, 31, -20, 12, -7, 4, -2, 1, 0, 0},
+    {0, 0, -1, 2, -4, 7, -13, 20, -31, 46, -66, 93,
+     -130, 183, -268, 426, -862, 16298, 966, -450, 278, -188, 133, -94,
+     67, -46, 31, -20, 13, -7, 4, -2, 1, 0, 0},
+    {0, 0, -1, 2, -4, 7, -13, 21, -31, 46, -67, 94,
+     -132, 186, -272, 433, -876, 16296, 983, -458, 283, -192, 135, -96,
+     68, -47, 32, -21, 13, -8, 4, -2, 1, 0, 0},
+    {0, 0, -1, 2, -4, 8, -13, 21, -32, 47, -68, 96,
+     -134, 190, -277, 440, -890, 16292, 1001, -466, 288, -195, 137, -97,
+     69, -48, 32, -21, 13, -8, 4, -2, 1, 0, 0},
+    {0, 0, -1, 2, -4, 8, -13, 21, -33, 48, -69, 97,
+     -136, 193, -281, 447, -904, 16289, 1018, -474, 292, -198, 139, -99,
+     70, -49, 33, -21, 13, -8, 4, -2, 1, 0, 0},
+    {0, 0, -1, 2, -4, 8, -13, 22, -33, 49, -70, 99,
+     -139, 196, -286, 454, -918, 16286, 1036, -482, 297, -202, 142, -101,
+     71, -49, 33, -22, 14, -8, 4, -2, 1, 0, 0},
+    {0, 0, -1, 2, -4, 8, -14, 22, -34, 50, -71, 100,
+     -141, 199, -290, 461, -931, 16283, 1053, -490, 302, -205, 144, -102,
+     72, -50, 34, -22, 14, -8, 4, -2, 1, 0, 0},
+    {0, 0, -1, 2, -4, 8, -14, 22, -34, 50, -72, 102,
+     -143, 202, -295, 468, -945, 16280, 1071, -498, 307, -208, 146, -104,
+     73, -51, 34, -22, 14, -8, 4, -2, 1, 0, 0},
+    {0, 0, -1, 2, -4, 8, -14, 23, -35, 51, -73, 104,
+     -145, 205, -299, 475, -959, 16277, 1089, -506, 312, -211, 149, -106,
+     75, -52, 35, -23, 14, -8, 4, -2, 1, 0, 0},
+    {0, 0, -1, 2, -4, 8, -14, 23, -35, 52, -74, 105,
+     -147, 208, -303, 482, -972, 16273, 1106, -514, 317, -215, 151, -107,
+     76, -53, 36, -23, 14, -8, 5, -2, 1, 0, 0},
+    {0, 0, -1, 2, -5, 8, -14, 23, -36, 53, -76, 107,
+     -149, 211, -308, 489, -986, 16270, 1124, -522, 321, -218, 153, -109,
+     77, -53, 36, -24, 15, -9, 5, -2, 1, 0, 0},
+    {0, 0, -1, 2, -5, 9, -15, 24, -36, 53, -77, 108,
+     -152, 214, -312, 496, -1000, 16267, 1142, -529, 326, -221, 155, -110,
+     78, -54, 37, -24, 15, -9, 5, -2, 1, 0, 0},
+    {0, 0, -1, 2, -5, 9, -15, 24, -37, 54, -78, 110,
+     -154, 217, -317, 503, -1013, 16263, 1159, -537, 331, -224, 158, -112,
+     79, -55, 37, -24, 15, -9, 5, -2, 1, 0, 0},
+    {0, 0, -1, 2, -5, 9, -15, 24, -37, 55, -79, 111,
+     -156, 220, -321, 510, -1027, 16260, 1177, -545, 336, -228, 160, -114,
+     80, -56, 38, -25, 15, -9, 5, -2, 1, 0, 0},
+    {0, 0, -1, 2, -5, 9, -15, 25, -38, 56, -80, 113,
+     -158, 223, -326, 517, -1040, 16256, 1195, -553, 341, -231, 162, -115,
+     81, -57, 38, -25, 15, -9, 5, -2, 1, 0, 0},
+    {0, 0, -1, 2, -5, 9, -16, 25, -38, 56, -81, 114,
+     -160, 226, -330, 523, -1054, 16252, 1213, -561, 346, -234, 165, -117,
+     83, -57, 39, -25, 16, -9, 5, -2, 1, 0, 0},
+    {0, 0, -1, 2, -5, 9, -16, 25, -39, 57, -82, 116,
+     -162, 229, -334, 530, -1067, 16249, 1231, -569, 350, -237, 167, -119,
+     84, -58, 39, -26, 16, -9, 5, -2, 1, 0, 0},
+    {0, 0, -1, 2, -5, 9, -16, 26, -39, 58, -83, 117,
+     -165, 232, -339, 537, -1081, 16245, 1249, -577, 355, -241, 169, -120,
+     85, -59, 40, -26, 16, -9, 5, -2, 1, 0, 0},
+    {0, 0, -1, 2, -5, 9, -16, 26, -40, 59, -84, 119,
+     -167, 235, -343, 544, -1094, 16241, 1266, -585, 360, -244, 171, -122,
+     86, -60, 40, -26, 16, -10, 5, -2, 1, 0, 0},
+    {0, 0, -1, 2, -5, 10, -16, 26, -40, 60, -85, 121,
+     -169, 238, -348, 551, -1107, 16237, 1284, -593, 365, -247, 174, -123,
+     87, -60, 41, -27, 17, -10, 5, -2, 1, 0, 0},
+    {0, 0, -1, 3, -5, 10, -17, 27, -41, 60, -87, 122,
+     -171, 241, -352, 558, -1121, 16233, 1302, -601, 370, -250, 176, -125,
+     88, -61, 41, -27, 17, -10, 5, -3, 1, 0, 0},
+    {0, 0, -1, 3, -5, 10, -17, 27, -41, 61, -88, 124,
+     -173, 244, -356, 565, -1134, 16230, 1320, -609, 375, -254, 178, -127,
+     89, -62, 42, -27, 17, -10, 5, -3, 1, 0, 0},
+    {0, 0, -1, 3, -5, 10, -17, 27, -42, 62, -89, 125,
+     -175, 247, -361, 572, -1147, 16226, 1338, -617, 379, -257, 181, -128,
+     91, -63, 42, -28, 17, -10, 5, -3, 1, 0, 0},
+    {0, 0, -1, 3, -5, 10, -17, 28, -42, 63, -90, 127,
+     -177, 250, -365, 578, -1160, 16222, 1356, -625, 384, -260, 183, -130,
+     92, -64, 43, -28, 17, -10, 5, -3, 1, 0, 0},
+    {0, 0, -1, 3, -5, 10, -17, 28, -43, 63, -91, 128,
+     -180, 253, -369, 585, -1173, 16217, 1374, -633, 389, -263, 185, -131,
+     93, -64, 44, -28, 18, -10, 6, -3, 1, 0, 0},
+    {0, 0, -1, 3, -6, 10, -18, 28, -43, 64, -92, 130,
+     -182, 256, -374, 592, -1186, 16213, 1392, -641, 394, -267, 187, -133,
+     94, -65, 44, -29, 18, -10, 6, -3, 1, 0, 0},
+    {0, 0, -1, 3, -6, 10, -18, 29, -44, 65, -93, 131,
+     -184, 259, -378, 599, -1199, 16209, 1411, -649, 399, -270, 190, -135,
+     95, -66, 45, -29, 18, -11, 6, -3, 1, 0, 0},
+    {0, 0, -1, 3, -6, 11, -18, 29, -44, 66, -94, 133,
+     -186, 262, -382, 606, -1213, 16205, 1429, -657, 404, -273, 192, -136,
+     96, -67, 45, -29, 18, -11, 6, -3, 1, 0, 0},
+    {0, 0, -1, 3, -6, 11, -18, 29, -45, 66, -95, 134,
+     -188, 265, -387, 612, -1226, 16201, 1447, -665, 408, -276, 194, -138,
+     97, -68, 46, -30, 18, -11, 6, -3, 1, 0, 0},
+    {0, 0, -1, 3, -6, 11, -18, 30, -45, 67, -96, 136,
+     -190, 268, -391, 619, -1239, 16196, 1465, -673, 413, -280, 196, -139,
+     98, -68, 46, -30, 19, -11, 6, -3, 1, 0, 0},
+    {0, 0, -1, 3, -6, 11, -19, 30, -46, 68, -97, 137,
+     -192, 271, -395, 626, -1251, 16192, 1483, -681, 418, -283, 199, -141,
+     100, -69, 47, -30, 19, -11, 6, -3, 1, 0, 0},
+    {0, 0, -1, 3, -6, 11, -19, 30, -47, 69, -99, 139,
+     -195, 274, -400, 633, -1264, 16188, 1502, -689, 423, -286, 201, -143,
+     101, -70, 47, -31, 19, -11, 6, -3, 1, 0, 0},
+    {0, 0, -1, 3, -6, 11, -19, 31, -47, 69, -100, 140,
+     -197, 277, -404, 639, -1277, 16183, 1520, -697, 428, -289, 203, -144,
+     102, -71, 48, -31, 19, -11, 6, -3, 1, 0, 0},
+    {0, 0, -1, 3, -6, 11, -19, 31, -48, 70, -101, 142,
+     -199, 280, -408, 646, -1290, 16179, 1538, -705, 433, -293, 205, -146,
+     103, -71, 48, -31, 20, -11, 6, -3, 1, 0, 0},
+    {0, 0, -1, 3, -6, 11, -20, 31, -48, 71, -102, 143,
+     -201, 283, -413, 653, -1303, 16174, 1556, -713, 437, -296, 208, -147,
+     104, -72, 49, -32, 20, -12, 6, -3, 1, 0, 0},
+    {0, 0, -1, 3, -6, 12, -20, 32, -49, 72, -103, 145,
+     -203, 286, -417, 659, -1316, 16169, 1575, -721, 442, -299, 210, -149,
+     105, -73, 49, -32, 20, -12, 6, -3, 1, 0, 0},
+    {0, 0, -1, 3, -6, 12, -20, 32, -49, 72, -104, 147,
+     -205, 289, -421, 666, -1328, 16165, 1593, -729, 447, -302, 212, -151,
+     106, -74, 50, -32, 20, -12, 6, -3, 1, 0, 0},
+    {0, 0, -1, 3, -6, 12, -20, 32, -50, 73, -105, 148,
+     -207, 292, -425, 673, -1341, 16160, 1612, -737, 452, -305, 215, -152,
+     107, -75, 50, -33, 20, -12, 6, -3, 1, 0, 0},
+    {0, 0, -1, 3, -6, 12, -20, 33, -50, 74, -106, 150,
+     -209, 295, -430, 679, -1354, 16155, 1630, -745, 457, -309, 217, -154,
+     109, -75, 51, -33, 21, -12, 6, -3, 1, 0, 0},
+    {0, 0, -1, 3, -6, 12, -21, 33, -51, 75, -107, 151,
+     -211, 298, -434, 686, -1366, 16150, 1648, -753, 461, -312, 219, -155,
+     110, -76, 51, -34, 21, -12, 7, -3, 1, 0, 0},
+    {0, 0, -1, 3, -7, 12, -21, 33, -51, 75, -108, 153,
+     -214, 301, -438, 692, -1379, 16145, 1667, -761, 466, -315, 221, -157,
+     111, -77, 52, -34, 21, -12, 7, -3, 1, 0, 0},
+    {0, 0, -1, 3, -7, 12, -21, 34, -52, 76, -109, 154,
+     -216, 304, -443, 699, -1391, 16141, 1685, -769, 471, -318, 224, -159,
+     112, -78, 53, -34, 21, -12, 7, -3, 1, 0, 0},
+    {0, 0, -1, 3, -7, 12, -21, 34, -52, 77, -110, 156,
+     -218, 307, -447, 706, -1404, 16136, 1704, -777, 476, -322, 226, -160,
+     113, -78, 53, -35, 21, -13, 7, -3, 1, 0, 0},
+    {0, 0, -1, 3, -7, 12, -21, 34, -53, 78, -111, 157,
+     -220, 310, -451, 712, -1416, 16131, 1722, -785, 481, -325, 228, -162,
+     114, -79, 54, -35, 22, -13, 7, -3, 1, 0, 0},
+    {0, 0, -1, 3, -7, 13, -22, 35, -53, 78, -112, 159,
+     -222, 313, -455, 719, -1429, 16125, 1741, -793, 486, -328, 230, -163,
+     115, -80, 54, -35, 22, -13, 7, -3, 1, 0, 0},
+    {0, 0, -1, 3, -7, 13, -22, 35, -54, 79, -114, 160,
+     -224, 316, -459, 725, -1441, 16120, 1759, -801, 490, -331, 233, -165,
+     116, -81, 55, -36, 22, -13, 7, -3, 1, 0, 0},
+    {0, 0, -1, 3, -7, 13, -22, 35, -54, 80, -115, 162,
+     -226, 319, -464, 732, -1454, 16115, 1778, -809, 495, -335, 235, -167,
+     118, -82, 55, -36, 22, -13, 7, -3, 1, 0, 0},
+    {0, 0, -1, 3, -7, 13, -22, 36, -55, 81, -116, 163,
+     -228, 322, -468, 738, -1466, 16110, 1797, -817, 500, -338, 237, -168,
+     119, -82, 56, -36, 22, -13, 7, -3, 1, 0, 0},
+    {0, 0, -1, 3, -7, 13, -22, 36, -55, 81, -117, 165,
+     -230, 324, -472, 745, -1478, 16105, 1815, -825, 505, -341, 239, -170,
+     120, -83, 56, -37, 23, -13, 7, -3, 1, 0, 0},
+    {0, 0, -1, 3, -7, 13, -23, 36, -56, 82, -118, 166,
+     -232, 327, -476, 751, -1491, 16099, 1834, -833, 510, -344, 242, -171,
+     121, -84, 57, -37, 23, -13, 7, -3, 1, 0, 0},
+    {0, 0, -1, 3, -7, 13, -23, 37, -56, 83, -119, 167,
+     -234, 330, -480, 758, -1503, 16094, 1853, -841, 514, -347, 244, -173,
+     122, -85, 57, -37, 23, -13, 7, -3, 1, 0, 0},
+    {0, 0, -1, 3, -7, 13, -23, 37, -57, 84, -120, 169,
+     -236, 333, -485, 764, -1515, 16089, 1871, -849, 519, -351, 246, -175,
+     123, -85, 58, -38, 23, -14, 7, -4, 1, 0, 0},
+    {0, 0, -1, 4, -7, 14, -23, 37, -57, 84, -121, 170,
+     -238, 336, -489, 771, -1527, 16083, 1890, -857, 524, -354, 248, -176,
+     124, -86, 58, -38, 24, -14, 7, -4, 1, 0, 0},
+    {0, 0, -1, 4, -7, 14, -23, 38, -58, 85, -122, 172,
+     -241, 339, -493, 777, -1539, 16078, 1909, -865, 529, -357, 251, -178,
+     125, -87, 59, -38, 24, -14, 7, -4, 1, 0, 0},
+    {0, 0, -1, 4, -7, 14, -24, 38, -58, 86, -123, 173,
+     -243, 342, -497, 784, -1551, 16072, 1928, -873, 534, -360, 253, -179,
+     127, -88, 59, -39, 24, -14, 8, -4, 1, 0, 0},
+    {0, 0, -1, 4, -7, 14, -24, 38, -59, 86, -124, 175,
+     -245, 345, -501, 790, -1563, 16066, 1947, -881, 538, -363, 255, -181,
+     128, -89, 60, -39, 24, -14, 8, -4, 1, 0, 0},
+    {0, 0, -1, 4, -8, 14, -24, 39, -59, 87, -125, 176,
+     -247, 348, -505, 797, -1575, 16061, 1965, -889, 543, -367, 257, -182,
+     129, -89, 60, -39, 24, -14, 8, -4, 1, 0, 0},
+    {0, 0, -1, 4, -8, 14, -24, 39, -60, 88, -126, 178,
+     -249, 350, -510, 803, -1587, 16055, 1984, -897, 548, -370, 259, -184,
+     130, -90, 61, -40, 25, -14, 8, -4, 2, 0, 0},
+    {0, 0, -2, 4, -8, 14, -24, 39, -60, 89, -127, 179,
+     -251, 353, -514, 809, -1599, 16049, 2003, -905, 553, -373, 262, -186,
+     131, -91, 61, -40, 25, -14, 8, -4, 2, 0, 0},
+    {0, 0, -2, 4, -8, 14, -25, 40, -61, 89, -128, 181,
+     -253, 356, -518, 816, -1611, 16044, 2022, -913, 558, -376, 264, -187,
+     132, -92, 62, -40, 25, -15, 8, -4, 2, 0, 0},
+    {0, 0, -2, 4, -8, 15, -25, 40, -61, 90, -129, 182,
+     -255, 359, -522, 822, -1623, 16038, 2041, -921, 562, -379, 266, -189,
+     133, -92, 62, -41, 25, -15, 8, -4, 2, 0, 0},
+    {0, 0, -2, 4, -8, 15, -25, 40, -62, 91, -130, 184,
+     -257, 362, -526, 828, -1635, 16032, 2060, -929, 567, -383, 268, -190,
+     134, -93, 63, -41, 25, -15, 8, -4, 2, 0, 0},
+    {0, 0, -2, 4, -8, 15, -25, 41, -62, 92, -131, 185,
+     -259, 365, -530, 835, -1647, 16026, 2079, -937, 572, -386, 271, -192,
+     135, -94, 63, -41, 26, -15, 8, -4, 2, 0, 0},
+    {0, 0, -2, 4, -8, 15, -25, 41, -63, 92, -132, 187,
+     -261, 368, -534, 841, -1659, 16020, 2098, -945, 577, -389, 273, -193,
+     136, -95, 64, -42, 26, -15, 8, -4, 2, 0, 0},
+    {0, 0, -2, 4, -8, 15, -26, 41, -63, 93, -133, 188,
+     -263, 370, -538, 847, -1670, 16014, 2117, -953, 582, -392, 275, -195,
+     138, -95, 64, -42, 26, -15, 8, -4, 2, 0, 0},
+    {0, 0, -2, 4, -8, 15, -26, 42, -64, 94, -135, 190,
+     -265, 373, -542, 854, -1682, 16008, 2136, -961, 586, -395, 277, -197,
+     139, -96, 65, -42, 26, -15, 8, -4, 2, -1, 0},
+    {0, 1, -2, 4, -8, 15, -26, 42, -64, 94, -136, 191,
+     -267, 376, -546, 860, -1694, 16001, 2155, -969, 591, -399, 279, -198,
+     140, -97, 65, -43, 26, -15, 8, -4, 2, -1, 0},
+    {0, 1, -2, 4, -8, 15, -26, 42, -65, 95, -137, 192,
+     -269, 379, -550, 866, -1705, 15995, 2174, -977, 596, -402, 282, -200,
+     141, -98, 66, -43, 27, -16, 8, -4, 2, -1, 0},
+    {0, 1, -2, 4, -8, 15, -26, 42, -65, 96, -138, 194,
+     -271, 382, -555, 872, -1717, 15989, 2193, -985, 601, -405, 284, -201,
+     142, -98, 67, -43, 27, -16, 8, -4, 2, -1, 0},
+    {0, 1, -2, 4, -8, 16, -27, 43, -66, 97, -139, 195,
+     -273, 385, -559, 879, -1728, 15983, 2212, -993, 605, -408, 286, -203,
+     143, -99, 67, -44, 27, -16, 8, -4, 2, -1, 0},
+    {0, 1, -2, 4, -8, 16, -27, 43, -66, 97, -140, 197,
+     -275, 387, -563, 885, -1740, 15976, 2232, -1001, 610, -411, 288, -204,
+     144, -100, 68, -44, 27, -16, 9, -4, 2, -1, 0},
+    {0, 1, -2, 4, -9, 16, -27, 43, -67, 98, -141, 198,
+     -277, 390, -567, 891, -1751, 15970, 2251, -1009, 615, -414, 291, -206,
+     145, -101, 68, -44, 27, -16, 9, -4, 2, -1, 0},
+    {0, 1, -2, 4, -9, 16, -27, 44, -67, 99, -142, 200,
+     -279, 393, -571, 897, -1763, 15964, 2270, -1017, 620, -418, 293, -208,
+     146, -102, 69, -45, 28, -16, 9, -4, 2, -1, 0},
+    {0, 1, -2, 4, -9, 16, -27, 44, -67, 100, -143, 201,
+     -281, 396, -575, 903, -1774, 15957, 2289, -1025, 624, -421, 295, -209,
+     147, -102, 69, -45, 28, -16, 9, -4, 2, -1, 0},
+    {0, 1, -2, 4, -9, 16, -28, 44, -68, 100, -144, 203,
+     -283, 399, -579, 910, -1786, 15950, 2308, -1033, 629, -424, 297, -211,
+     149, -103, 70, -45, 28, -16, 9, -4, 2, -1, 0},
+    {0, 1, -2, 4, -9, 16, -28, 45, -68, 101, -145, 204,
+     -285, 401, -583, 916, -1797, 15944, 2328, -1041, 634, -427, 299, -212,
+     150, -104, 70, -46, 28, -17, 9, -4, 2, -1, 0},
+    {0, 1, -2, 4, -9, 16, -28, 45, -69, 102, -146, 205,
+     -287, 404, -587, 922, -1808, 15937, 2347, -1049, 639, -430, 302, -214,
+     151, -105, 71, -46, 29, -17, 9, -4, 2, -1, 0},
+    {0, 1, -2, 4, -9, 16, -28, 45, -69, 102, -147, 207,
+     -289, 407, -591, 928, -1820, 15931, 2366, -1057, 643, -433, 304, -215,
+     152, -105, 71, -46, 29, -17, 9, -4, 2, -1, 0},
+    {0, 1, -2, 4, -9, 17, -28, 46, -70, 103, -148, 208,
+     -291, 410, -595, 934, -1831, 15924, 2386, -1065, 648, -437, 306, -217,
+     153, -106, 72, -47, 29, -17, 9, -4, 2, -1, 0},
+    {0, 1, -2, 4, -9, 17, -29, 46, -70, 104, -149, 210,
+     -293, 412, -599, 940, -1842, 15917, 2405, -1073, 653, -440, 308, -218,
+     154, -107, 72, -47, 29, -17, 9, -4, 2, -1, 0},
+    {0, 1, -2, 4, -9, 17, -29, 46, -71, 104, -150, 211,
+     -295, 415, -603, 946, -1853, 15910, 2424, -1081, 658, -443, 310, -220,
+     155, -108, 73, -47, 29, -17, 9, -4, 2, -1, 0},
+    {0, 1, -2, 4, -9, 17, -29, 47, -71, 105, -151, 212,
+     -297, 418, -606, 952, -1864, 15903, 2444, -1089, 662, -446, 313, -221,
+     156, -108, 73, -48, 30, -17, 9, -4, 2, -1, 0},
+    {0, 1, -2, 4, -9, 17, -29, 47, -72, 106, -152, 214,
+     -299, 421, -610, 958, -1875, 15896, 2463, -1097, 667, -449, 315, -223,
+     157, -109, 74, -48, 30, -17, 9, -4, 2, -1, 0},
+    {0, 1, -2, 4, -9, 17, -29, 47, -72, 107, -153, 215,
+     -301, 423, -614, 964, -1886, 15889, 2483, -1105, 672, -452, 317, -225,
+     158, -110, 74, -48, 30, -17, 9, -4, 2, -1, 0},
+    {0, 1, -2, 4, -9, 17, -30, 48, -73, 107, -154, 217,
+     -303, 426, -618, 970, -1897, 15882, 2502, -1113, 677, -456, 319, -226,
+     159, -111, 75, -49, 30, -18, 9, -5, 2, -1, 0},
+    {0, 1, -2, 5, -9, 17, -30, 48, -73, 108, -155, 218,
+     -305, 429, -622, 976, -1908, 15875, 2521, -1121, 681, -459, 321, -228,
+     160, -111, 75, -49, 30, -18, 9, -5, 2, -1, 0},
+    {0, 1, -2, 5, -9, 18, -30, 48, -74, 109, -156, 220,
+     -307, 432, -626, 982, -1919, 15868, 2541, -1129, 686, -462, 323, -229,
+     162, -112, 76, -49, 31, -18, 10, -5, 2, -1, 0},
+    {0, 1, -2, 5, -9, 18, -30, 48, -74, 109, -157, 221,
+     -309, 434, -630, 988, -1930, 15861, 2560, -1137, 691, -465, 326, -231,
+     163, -113, 76, -50, 31, -18, 10, -5, 2, -1, 0},
+    {0, 1, -2, 5, -10, 18, -30, 49, -75, 110, -158, 222,
+     -311, 437, -634, 994, -1941, 15854, 2580, -1145, 695, -468, 328, -232,
+     164, -114, 77, -50, 31, -18, 10, -5, 2, -1, 0},
+    {0, 1, -2, 5, -10, 18, -31, 49, -75, 111, -159, 224,
+     -313, 440, -638, 1000, -1952, 15847, 2600, -1153, 700, -471, 330, -234,
+     165, -114, 77, -50, 31, -18, 10, -5, 2, -1, 0},
+    {0, 1, -2, 5, -10, 18, -31, 49, -76, 112, -160, 225,
+     -315, 443, -642, 1006, -1963, 15839, 2619, -1161, 705, -474, 332, -235,
+     166, -115, 78, -51, 31, -18, 10, -5, 2, -1, 0},
+    {0, 1, -2, 5, -10, 18, -31, 50, -76, 112, -161, 227,
+     -317, 445, -646, 1012, -1973, 15832, 2639, -1168, 710, -477, 334, -237,
+     167, -116, 78, -51, 32, -18, 10, -5, 2, -1, 0},
+    {0, 1, -2, 5, -10, 18, -31, 50, -77, 113, -162, 228,
+     -318, 448, -649, 1018, -1984, 15824, 2658, -1176, 714, -481, 336, -238,
+     168, -116, 79, -51, 32, -19, 10, -5, 2, -1, 0},
+    {0, 1, -2, 5, -10, 18, -31, 50, -77, 114, -163, 229,
+     -320, 451, -653, 1024, -1995, 15817, 2678, -1184, 719, -484, 339, -240,
+     169, -117, 79, -52, 32, -19, 10, -5, 2, -1, 0},
+    {0, 1, -2, 5, -10, 18, -32, 51, -78, 114, -164, 231,
+     -322, 453, -657, 1030, -2006, 15810, 2698, -1192, 724, -487, 341, -241,
+     170, -118, 80, -52, 32, -19, 10, -5, 2, -1, 0},
+    {0, 1, -2, 5, -10, 19, -32, 51, -78, 115, -165, 232,
+     -324, 456, -661, 1036, -2016, 15802, 2717, -1200, 728, -490, 343, -243,
+     171, -119, 80, -52, 32, -19, 10, -5, 2, -1, 0},
+    {0, 1, -2, 5, -10, 19, -32, 51, -78, 116, -166, 233,
+     -326, 459, -665, 1042, -2027, 15794, 2737, -1208, 733, -493, 345, -244,
+     172, -119, 81, -52, 33, -19, 10, -5, 2, -1, 0},
+    {0, 1, -2, 5, -10, 19, -32, 52, -79, 116, -167, 235,
+     -328, 461, -669, 1047, -2037, 15787, 2757, -1216, 738, -496, 347, -246,
+     173, -120, 81, -53, 33, -19, 10, -5, 2, -1, 0},
+    {0, 1, -2, 5, -10, 19, -32, 52, -79, 117, -168, 236,
+     -330, 464, -672, 1053, -2048, 15779, 2776, -1224, 742, -499, 349, -247,
+     174, -121, 82, -53, 33, -19, 10, -5, 2, -1, 0},
+    {0, 1, -2, 5, -10, 19, -32, 52, -80, 118, -169, 238,
+     -332, 467, -676, 1059, -2058, 15771, 2796, -1232, 747, -502, 352, -249,
+     175, -122, 82, -53, 33, -19, 10, -5, 2, -1, 0},
+    {0, 1, -2, 5, -10, 19, -33, 52, -80, 118, -170, 239,
+     -334, 469, -680, 1065, -2069, 15763, 2816, -1240, 752, -505, 354, -250,
+     177, -122, 83, -54, 33, -19, 10, -5, 2, -1, 0},
+    {0, 1, -2, 5, -10, 19, -33, 53, -81, 119, -171, 240,
+     -336, 472, -684, 1071, -2079, 15756, 2836, -1248, 756, -508, 356, -252,
+     178, -123, 83, -54, 34, -20, 10, -5, 2, -1, 0},
+    {0, 1, -2, 5, -10, 19, -33, 53, -81, 120, -172, 242,
+     -338, 475, -688, 1076, -2089, 15748, 2856, -1256, 761, -512, 358, -254,
+     179, -124, 84, -54, 34, -20, 11, -5, 2, -1, 0},
+    {0, 1, -2, 5, -10, 19, -33, 53, -82, 120, -173, 243,
+     -339, 477, -691, 1082, -2100, 15740, 2875, -1264, 766, -515, 360, -255,
+     180, -125, 84, -55, 34, -20, 11, -5, 2, -1, 0},
+    {0, 1, -2, 5, -11, 20, -33, 54, -82, 121, -174, 244,
+     -341, 480, -695, 1088, -2110, 15732, 2895, -1272, 770, -518, 362, -257,
+     181, -125, 85, -55, 34, -20, 11, -5, 2, -1, 0},
+    {0, 1, -2, 5, -11, 20, -34, 54, -83, 122, -175, 246,
+     -343, 482, -699, 1093, -2120, 15724, 2915, -1280, 775, -521, 364, -258,
+     182, -126, 85, -55, 34, -20, 11, -5, 2, -1, 0},
+    {0, 1, -2, 5, -11, 20, -34, 54, -83, 122, -176, 247,
+     -345, 485, -703, 1099, -2130, 15716, 2935, -1288, 780, -524, 367, -260,
+     183, -127, 86, -56, 35, -20, 11, -5, 2, -1, 0},
+    {0, 1, -2, 5, -11, 20, -34, 55, -84, 123, -177, 248,
+     -347, 488, -706, 1105, -2140, 15708, 2955, -1295, 784, -527, 369, -261,
+     184, -127, 86, -56, 35, -20, 11, -5, 2, -1, 0},
+    {0, 1, -2, 5, -11, 20, -34, 55, -84, 124, -178, 250,
+     -349, 490, -710, 1111, -2151, 15699, 2975, -1303, 789, -530, 371, -263,
+     185, -128, 87, -56, 35, -20, 11, -5, 2, -1, 0},
+    {0, 1, -2, 5, -11, 20, -34, 55, -84, 124, -178, 251,
+     -351, 493, -714, 1116, -2161, 15691, 2995, -1311, 794, -533, 373, -264,
+     186, -129, 87, -57, 35, -20, 11, -5, 2, -1, 0},
+    {0, 1, -2, 5, -11, 20, -35, 56, -85, 125, -179, 252,
+     -353, 496, -717, 1122, -2171, 15683, 3015, -1319, 798, -536, 375, -265,
+     187, -130, 87, -57, 35, -21, 11, -5, 2, -1, 0},
+    {0, 1, -2, 5, -11, 20, -35, 56, -85, 126, -180, 254,
+     -354, 498, -721, 1127, -2181, 15675, 3035, -1327, 803, -539, 377, -267,
+     188, -130, 88, -57, 36, -21, 11, -5, 2, -1, 0},
+    {0, 1, -2, 5, -11, 20, -35, 56, -86, 127, -181, 255,
+     -356, 501, -725, 1133, -2191, 15666, 3055, -1335, 807, -542, 379, -268,
+     189, -131, 88, -58, 36, -21, 11, -5, 2, -1, 0},
+    {0, 1, -2, 5, -11, 21, -35, 56, -86, 127, -182, 257,
+     -358, 503, -728, 1139, -2201, 15658, 3075, -1343, 812, -545, 381, -270,
+     190, -132, 89, -58, 36, -21, 11, -5, 2, -1, 0},
+    {0, 1, -2, 5, -11, 21, -35, 57, -87, 128, -183, 258,
+     -360, 506, -732, 1144, -2211, 15649, 3095, -1351, 817, -548, 384, -271,
+     191, -133, 89, -58, 36, -21, 11, -5, 2, -1, 0},
+    {0, 1, -2, 5, -11, 21, -35, 57, -87, 129, -184, 259,
+     -362, 508, -736, 1150, -2220, 15641, 3115, -1359, 821, -551, 386, -273,
+     192, -133, 90, -59, 36, -21, 11, -5, 2, -1, 0},
+    {0, 1, -2, 5, -11, 21, -36, 57, -88, 129, -185, 261,
+     -364, 511, -739, 1155, -2230, 15632, 3135, -1366, 826, -554, 388, -274,
+     193, -134, 90, -59, 36, -21, 11, -5, 2, -1, 0},
+    {0, 1, -2, 5, -11, 21, -36, 58, -88, 130, -186, 262,
+     -366, 514, -743, 1161, -2240, 15624, 3155, -1374, 831, -557, 390, -276,
+     194, -135, 91, -59, 37, -21, 11, -5, 2, -1, 0},
+    {0, 1, -2, 5, -11, 21, -36, 58, -89, 130, -187, 263,
+     -367, 516, -747, 1166, -2250, 15615, 3175, -1382, 835, -561, 392, -277,
+     195, -135, 91, -59, 37, -21, 12, -6, 2, -1, 0},
+    {0, 1, -2, 5, -11, 21, -36, 58, -89, 131, -188, 264,
+     -369, 519, -750, 1172, -2260, 15606, 3195, -1390, 840, -564, 394, -279,
+     196, -136, 92, -60, 37, -22, 12, -6, 2, -1, 0},
+    {0, 1, -2, 6, -11, 21, -36, 58, -89, 132, -189, 266,
+     -371, 521, -754, 1177, -2269, 15598, 3215, -1398, 844, -567, 396, -280,
+     197, -137, 92, -60, 37, -22, 12, -6, 2, -1, 0},
+    {0, 1, -2, 6, -12, 21, -37, 59, -90, 132, -190, 267,
+     -373, 524, -758, 1183, -2279, 15589, 3235, -1406, 849, -570, 398, -282,
+     198, -138, 93, -60, 37, -22, 12, -6, 2, -1, 0},
+    {0, 1, -2, 6, -12, 22, -37, 59, -90, 133, -191, 268,
+     -375, 526, -761, 1188, -2288, 15580, 3256, -1414, 853, -573, 400, -283,
+     199, -138, 93, -61, 38, -22, 12, -6, 2, -1, 0},
+    {0, 1, -2, 6, -12, 22, -37, 59, -91, 134, -192, 270,
+     -376, 529, -765, 1194, -2298, 15571, 3276, -1421, 858, -576, 402, -285,
+     201, -139, 94, -61, 38, -22, 12, -6, 2, -1, 0},
+    {0, 1, -2, 6, -12, 22, -37, 60, -91, 134, -193, 271,
+     -378, 531, -768, 1199, -2308, 15562, 3296, -1429, 863, -579, 404, -286,
+     202, -140, 94, -61, 38, -22, 12, -6, 2, -1, 0},
+    {0, 1, -2, 6, -12, 22, -37, 60, -92, 135, -194, 272,
+     -380, 534, -772, 1204, -2317, 15553, 3316, -1437, 867, -582, 407, -288,
+     203, -140, 95, -62, 38, -22, 12, -6, 2, -1, 0},
+    {0, 1, -2, 6, -12, 22, -37, 60, -92, 136, -194, 274,
+     -382, 536, -775, 1210, -2327, 15544, 3337, -1445, 872, -585, 409, -289,
+     204, -141, 95, -62, 38, -22, 12, -6, 2, -1, 0},
+    {0, 1, -2, 6, -12, 22, -38, 61, -93, 136, -195, 275,
+     -384, 539, -779, 1215, -2336, 15535, 3357, -1453, 876, -588, 411, -291,
+     205, -142, 96, -62, 39, -22, 12, -6, 2, -1, 0},
+    {0, 1, -2, 6, -12, 22, -38, 61, -93, 137, -196, 276,
+     -385, 541, -783, 1220, -2345, 15526, 3377, -1461, 881, -591, 413, -292,
+     206, -142, 96, -63, 39, -23, 12, -6, 2, -1, 0},
+    {0, 1, -2, 6, -12, 22, -38, 61, -93, 138, -197, 277,
+     -387, 544, -786, 1226, -2355, 15517, 3397, -1468, 885, -594, 415, -293,
+     207, -143, 97, -63, 39, -23, 12, -6, 2, -1, 0},
+    {0, 1, -2, 6, -12, 22, -38, 61, -94, 138, -198, 279,
+     -389, 546, -790, 1231, -2364, 15508, 3418, -1476, 890, -597, 417, -295,
+     208, -144, 97, -63, 39, -23, 12, -6, 2, -1, 0},
+    {0, 1, -2, 6, -12, 22, -38, 62, -94, 139, -199, 280,
+     -391, 549, -793, 1236, -2373, 15499, 3438, -1484, 894, -600, 419, -296,
+     209, -145, 98, -63, 39, -23, 12, -6, 2, -1, 0},
+    {0, 1, -2, 6, -12, 23, -39, 62, -95, 140, -200, 281,
+     -393, 551, -797, 1242, -2383, 15489, 3458, -1492, 899, -603, 421, -298,
+     210, -145, 98, -64, 40, -23, 12, -6, 2, -1, 0},
+    {0, 1, -2, 6, -12, 23, -39, 62, -95, 140, -201, 283,
+     -394, 554, -800, 1247, -2392, 15480, 3479, -1500, 903, -606, 423, -299,
+     211, -146, 98, -64, 40, -23, 12, -6, 2, -1, 0},
+    {0, 1, -2, 6, -12, 23, -39, 63, -96, 141, -202, 284,
+     -396, 556, -804, 1252, -2401, 15471, 3499, -1507, 908, -609, 425, -301,
+     212, -147, 99, -64, 40, -23, 12, -6, 2, -1, 0},
+    {0, 1, -2, 6, -12, 23, -39, 63, -96, 142, -203, 285,
+     -398, 558, -807, 1257, -2410, 15461, 3519, -1515, 912, -611, 427, -302,
+     213, -147, 99, -65, 40, -23, 13, -6, 2, -1, 0},
+    {0, 1, -2, 6, -12, 23, -39, 63, -96, 142, -204, 286,
+     -400, 561, -811, 1263, -2419, 15452, 3540, -1523, 917, -614, 429, -304,
+     214, -148, 100, -65, 40, -23, 13, -6, 2, -1, 0},
+    {0, 1, -2, 6, -12, 23, -39, 63, -97, 143, -205, 288,
+     -401, 563, -814, 1268, -2428, 15442, 3560, -1531, 921, -617, 431, -305,
+     215, -149, 100, -65, 40, -24, 13, -6, 2, -1, 0},
+    {0, 1, -2, 6, -12, 23, -40, 64, -97, 143, -205, 289,
+     -403, 566, -817, 1273, -2437, 15433, 3581, -1538, 926, -620, 433, -306,
+     216, -149, 101, -66, 41, -24, 13, -6, 2, -1, 0},
+    {0, 1, -2, 6, -13, 23, -40, 64, -98, 144, -206, 290,
+     -405, 568, -821, 1278, -2446, 15423, 3601, -1546, 930, -623, 435, -308,
+     217, -150, 101, -66, 41, -24, 13, -6, 2, -1, 0},
+    {0, 1, -2, 6, -13, 23, -40, 64, -98, 145, -207, 291,
+     -407, 571, -824, 1283, -2455, 15413, 3622, -1554, 935, -626, 437, -309,
+     218, -151, 102, -66, 41, -24, 13, -6, 2, -1, 0},
+    {0, 1, -2, 6, -13, 23, -40, 64, -99, 145, -208, 293,
+     -408, 573, -828, 1288, -2464, 15404, 3642, -1562, 939, -629, 439, -311,
+     219, -151, 102, -66, 41, -24, 13, -6, 3, -1, 0},
+    {0, 1, -2, 6, -13, 24, -40, 65, -99, 146, -209, 294,
+     -410, 575, -831, 1294, -2473, 15394, 3663, -1569, 944, -632, 441, -312,
+     220, -152, 103, -67, 41, -24, 13, -6, 3, -1, 0},
+    {0, 1, -2, 6, -13, 24, -41, 65, -99, 147, -210, 295,
+     -412, 578, -834, 1299, -2482, 15384, 3683, -1577, 948, -635, 443, -313,
+     221, -153, 103, -67, 42, -24, 13, -6, 3, -1, 0},
+    {0, 1, -3, 6, -13, 24, -41, 65, -100, 147, -211, 296,
+     -414, 580, -838, 1304, -2490, 15374, 3704, -1585, 953, -638, 445, -315,
+     222, -154, 104, -67, 42, -24, 13, -6, 3, -1, 0},
+    {0, 1, -3, 6, -13, 24, -41, 66, -100, 148, -212, 298,
+     -415, 583, -841, 1309, -2499, 15364, 3724, -1593, 957, -641, 447, -316,
+     223, -154, 104, -68, 42, -24, 13, -6, 3, -1, 0},
+    {0, 1, -3, 6, -13, 24, -41, 66, -101, 148, -213, 299,
+     -417, 585, -845, 1314, -2508, 15354, 3745, -1600, 962, -644, 449, -318,
+     224, -155, 104, -68, 42, -25, 13, -6, 3, -1, 0},
+    {0, 1, -3, 6, -13, 24, -41, 66, -101, 149, -213, 300,
+     -419, 587, -848, 1319, -2517, 15344, 3765, -1608, 966, -647, 451, -319,
+     225, -156, 105, -68, 42, -25, 13, -6, 3, -1, 0},
+    {0, 1, -3, 6, -13, 24, -41, 66, -102, 150, -214, 301,
+     -420, 590, -851, 1324, -2525, 15334, 3786, -1616, 971, -650, 453, -321,
+     226, -156, 105, -69, 42, -25, 13, -6, 3, -1, 0},
+    {0, 1, -3, 6, -13, 24, -42, 67, -102, 150, -215, 303,
+     -422, 592, -855, 1329, -2534, 15324, 3807, -1623, 975, -653, 455, -322,
+     227, -157, 106, -69, 43, -25, 13, -6, 3, -1, 0},
+    {0, 1, -3, 6, -13, 24, -42, 67, -102, 151, -216, 304,
+     -424, 594, -858, 1334, -2542, 15314, 3827, -1631, 979, -655, 457, -323,
+     228, -158, 106, -69, 43, -25, 13, -6, 3, -1, 0},
+    {0, 1, -3, 6, -13, 25, -42, 67, -103, 151, -217, 305,
+     -425, 597, -861, 1339, -2551, 15304, 3848, -1639, 984, -658, 459, -325,
+     229, -158, 107, -69, 43, -25, 13, -6, 3, -1, 0},
+    {0, 1, -3, 6, -13, 25, -42, 68, -103, 152, -218, 306,
+     -427, 599, -865, 1344, -2559, 15294, 3869, -1646, 988, -661, 461, -326,
+     230, -159, 107, -70, 43, -25, 14, -6, 3, -1, 0},
+    {0, 1, -3, 6, -13, 25, -42, 68, -104, 153, -219, 308,
+     -429, 601, -868, 1349, -2568, 15284, 3889, -1654, 993, -664, 463, -328,
+     231, -160, 108, -70, 43, -25, 14, -6, 3, -1, 0},
+    {0, 1, -3, 6, -13, 25, -42, 68, -104, 153, -220, 309,
+     -430, 604, -871, 1354, -2576, 15273, 3910, -1662, 997, -667, 465, -329,
+     231, -160, 108, -70, 44, -25, 14, -7, 3, -1, 0},
+    {0, 1, -3, 6, -13, 25, -43, 68, -105, 154, -220, 310,
+     -432, 606, -874, 1359, -2585, 15263, 3931, -1669, 1001, -670, 467, -330,
+     232, -161, 109, -71, 44, -25, 14, -7, 3, -1, 0},
+    {0, 1, -3, 6, -13, 25, -43, 69, -105, 155, -221, 311,
+     -434, 608, -878, 1363, -2593, 15253, 3951, -1677, 1006, -673, 469, -332,
+     233, -162, 109, -71, 44, -26, 14, -7, 3, -1, 0},
+    {0, 1, -3, 6, -14, 25, -43, 69, -105, 155, -222, 312,
+     -435, 611, -881, 1368, -2601, 15242, 3972, -1685, 1010, -676, 471, -333,
+     234, -162, 109, -71, 44, -26, 14, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 25, -43, 69, -106, 156, -223, 314,
+     -437, 613, -884, 1373, -2609, 15232, 3993, -1692, 1015, -678, 473, -334,
+     235, -163, 110, -71, 44, -26, 14, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 25, -43, 69, -106, 156, -224, 315,
+     -439, 615, -887, 1378, -2618, 15221, 4014, -1700, 1019, -681, 475, -336,
+     236, -164, 110, -72, 44, -26, 14, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 25, -43, 70, -107, 157, -225, 316,
+     -440, 618, -891, 1383, -2626, 15211, 4034, -1708, 1023, -684, 477, -337,
+     237, -164, 111, -72, 45, -26, 14, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 25, -44, 70, -107, 158, -226, 317,
+     -442, 620, -894, 1388, -2634, 15200, 4055, -1715, 1028, -687, 479, -339,
+     238, -165, 111, -72, 45, -26, 14, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 26, -44, 70, -107, 158, -226, 318,
+     -444, 622, -897, 1392, -2642, 15190, 4076, -1723, 1032, -690, 481, -340,
+     239, -166, 112, -73, 45, -26, 14, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 26, -44, 70, -108, 159, -227, 319,
+     -445, 624, -900, 1397, -2650, 15179, 4097, -1730, 1036, -693, 483, -341,
+     240, -166, 112, -73, 45, -26, 14, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 26, -44, 71, -108, 159, -228, 321,
+     -447, 627, -903, 1402, -2658, 15168, 4118, -1738, 1041, -695, 485, -343,
+     241, -167, 113, -73, 45, -26, 14, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 26, -44, 71, -109, 160, -229, 322,
+     -449, 629, -907, 1407, -2666, 15157, 4138, -1745, 1045, -698, 487, -344,
+     242, -168, 113, -73, 46, -27, 14, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 26, -44, 71, -109, 161, -230, 323,
+     -450, 631, -910, 1411, -2674, 15146, 4159, -1753, 1049, -701, 489, -345,
+     243, -168, 113, -74, 46, -27, 14, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 26, -45, 72, -109, 161, -231, 324,
+     -452, 633, -913, 1416, -2682, 15136, 4180, -1761, 1054, -704, 491, -347,
+     244, -169, 114, -74, 46, -27, 14, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 26, -45, 72, -110, 162, -231, 325,
+     -453, 636, -916, 1421, -2690, 15125, 4201, -1768, 1058, -707, 493, -348,
+     245, -170, 114, -74, 46, -27, 14, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 26, -45, 72, -110, 162, -232, 326,
+     -455, 638, -919, 1425, -2698, 15114, 4222, -1776, 1062, -710, 495, -349,
+     246, -170, 115, -75, 46, -27, 14, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 26, -45, 72, -111, 163, -233, 328,
+     -457, 640, -922, 1430, -2706, 15103, 4243, -1783, 1067, -712, 497, -351,
+     247, -171, 115, -75, 46, -27, 14, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 26, -45, 73, -111, 163, -234, 329,
+     -458, 642, -925, 1435, -2713, 15092, 4264, -1791, 1071, -715, 499, -352,
+     248, -171, 116, -75, 47, -27, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 27, -45, 73, -111, 164, -235, 330,
+     -460, 644, -929, 1439, -2721, 15081, 4285, -1798, 1075, -718, 500, -353,
+     249, -172, 116, -75, 47, -27, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 27, -46, 73, -112, 165, -236, 331,
+     -461, 647, -932, 1444, -2729, 15069, 4306, -1806, 1079, -721, 502, -355,
+     250, -173, 116, -76, 47, -27, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 27, -46, 73, -112, 165, -236, 332,
+     -463, 649, -935, 1448, -2736, 15058, 4327, -1813, 1084, -724, 504, -356,
+     250, -173, 117, -76, 47, -27, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 27, -46, 74, -113, 166, -237, 333,
+     -465, 651, -938, 1453, -2744, 15047, 4347, -1821, 1088, -726, 506, -357,
+     251, -174, 117, -76, 47, -28, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -15, 27, -46, 74, -113, 166, -238, 335,
+     -466, 653, -941, 1458, -2752, 15036, 4368, -1828, 1092, -729, 508, -359,
+     252, -175, 118, -77, 47, -28, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -15, 27, -46, 74, -113, 167, -239, 336,
+     -468, 655, -944, 1462, -2759, 15025, 4389, -1836, 1096, -732, 510, -360,
+     253, -175, 118, -77, 48, -28, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -15, 27, -46, 74, -114, 167, -240, 337,
+     -469, 657, -947, 1467, -2767, 15013, 4410, -1843, 1101, -735, 512, -361,
+     254, -176, 119, -77, 48, -28, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -15, 27, -47, 75, -114, 168, -241, 338,
+     -471, 660, -950, 1471, -2774, 15002, 4431, -1851, 1105, -737, 514, -363,
+     255, -177, 119, -77, 48, -28, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -15, 27, -47, 75, -115, 169, -241, 339,
+     -472, 662, -953, 1476, -2782, 14990, 4453, -1858, 1109, -740, 516, -364,
+     256, -177, 119, -78, 48, -28, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -15, 27, -47, 75, -115, 169, -242, 340,
+     -474, 664, -956, 1480, -2789, 14979, 4474, -1865, 1113, -743, 518, -365,
+     257, -178, 120, -78, 48, -28, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -15, 27, -47, 75, -115, 170, -243, 341,
+     -475, 666, -959, 1484, -2796, 14967, 4495, -1873, 1117, -746, 519, -367,
+     258, -178, 120, -78, 48, -28, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -15, 28, -47, 76, -116, 170, -244, 342,
+     -477, 668, -962, 1489, -2804, 14956, 4516, -1880, 1122, -748, 521, -368,
+     259, -179, 121, -78, 49, -28, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -15, 28, -47, 76, -116, 171, -245, 344,
+     -479, 670, -965, 1493, -2811, 14944, 4537, -1888, 1126, -751, 523, -369,
+     260, -180, 121, -79, 49, -28, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -15, 28, -47, 76, -116, 171, -245, 345,
+     -480, 672, -968, 1498, -2818, 14933, 4558, -1895, 1130, -754, 525, -371,
+     261, -180, 122, -79, 49, -29, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -15, 28, -48, 76, -117, 172, -246, 346,
+     -482, 674, -971, 1502, -2825, 14921, 4579, -1903, 1134, -756, 527, -372,
+     262, -181, 122, -79, 49, -29, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -15, 28, -48, 77, -117, 172, -247, 347,
+     -483, 677, -974, 1506, -2833, 14909, 4600, -1910, 1138, -759, 529, -373,
+     262, -182, 122, -80, 49, -29, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -15, 28, -48, 77, -118, 173, -248, 348,
+     -485, 679, -977, 1511, -2840, 14897, 4621, -1917, 1143, -762, 531, -375,
+     263, -182, 123, -80, 49, -29, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -15, 28, -48, 77, -118, 174, -248, 349,
+     -486, 681, -980, 1515, -2847, 14886, 4642, -1925, 1147, -765, 532, -376,
+     264, -183, 123, -80, 50, -29, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -15, 28, -48, 77, -118, 174, -249, 350,
+     -488, 683, -983, 1519, -2854, 14874, 4663, -1932, 1151, -767, 534, -377,
+     265, -183, 124, -80, 50, -29, 16, -7, 3, -1, 0},
+    {0, 1, -3, 7, -15, 28, -48, 78, -119, 175, -250, 351,
+     -489, 685, -985, 1523, -2861, 14862, 4685, -1939, 1155, -770, 536, -378,
+     266, -184, 124, -81, 50, -29, 16, -7, 3, -1, 0},
+    {0, 1, -3, 7, -15, 28, -49, 78, -119, 175, -251, 352,
+     -491, 687, -988, 1528, -2868, 14850, 4706, -1947, 1159, -773, 538, -380,
+     267, -185, 124, -81, 50, -29, 16, -7, 3, -1, 0},
+    {0, 1, -3, 7, -15, 28, -49, 78, -119, 176, -252, 353,
+     -492, 689, -991, 1532, -2875, 14838, 4727, -1954, 1163, -775, 540, -381,
+     268, -185, 125, -81, 50, -29, 16, -8, 3, -1, 0},
+    {0, 1, -3, 7, -15, 29, -49, 78, -120, 176, -252, 354,
+     -494, 691, -994, 1536, -2882, 14826, 4748, -1961, 1167, -778, 542, -382,
+     269, -186, 125, -81, 50, -29, 16, -8, 3, -1, 0},
+    {0, 1, -3, 7, -15, 29, -49, 79, -120, 177, -253, 355,
+     -495, 693, -997, 1540, -2888, 14814, 4769, -1969, 1171, -781, 543, -383,
+     270, -186, 126, -82, 51, -29, 16, -8, 3, -1, 0},
+    {0, 1, -3, 7, -15, 29, -49, 79, -121, 177, -254, 357,
+     -497, 695, -1000, 1545, -2895, 14802, 4790, -1976, 1176, -783, 545, -385,
+     270, -187, 126, -82, 51, -30, 16, -8, 3, -1, 0},
+    {0, 1, -3, 7, -16, 29, -49, 79, -121, 178, -255, 358,
+     -498, 697, -1003, 1549, -2902, 14789, 4812, -1983, 1180, -786, 547, -386,
+     271, -188, 127, -82, 51, -30, 16, -8, 3, -1, 0},
+    {0, 1, -3, 7, -16, 29, -49, 79, -121, 178, -255, 359,
+     -499, 699, -1005, 1553, -2909, 14777, 4833, -1990, 1184, -789, 549, -387,
+     272, -188, 127, -82, 51, -30, 16, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 29, -50, 80, -122, 179, -256, 360,
+     -501, 701, -1008, 1557, -2916, 14765, 4854, -1998, 1188, -791, 551, -389,
+     273, -189, 127, -83, 51, -30, 16, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 29, -50, 80, -122, 180, -257, 361,
+     -502, 703, -1011, 1561, -2922, 14753, 4875, -2005, 1192, -794, 552, -390,
+     274, -190, 128, -83, 51, -30, 16, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 29, -50, 80, -122, 180, -258, 362,
+     -504, 705, -1014, 1565, -2929, 14740, 4897, -2012, 1196, -796, 554, -391,
+     275, -190, 128, -83, 52, -30, 16, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 29, -50, 80, -123, 181, -258, 363,
+     -505, 707, -1017, 1569, -2935, 14728, 4918, -2019, 1200, -799, 556, -392,
+     276, -191, 129, -84, 52, -30, 16, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 29, -50, 81, -123, 181, -259, 364,
+     -507, 709, -1019, 1573, -2942, 14716, 4939, -2027, 1204, -802, 558, -394,
+     277, -191, 129, -84, 52, -30, 16, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 29, -50, 81, -123, 182, -260, 365,
+     -508, 711, -1022, 1577, -2949, 14703, 4960, -2034, 1208, -804, 560, -395,
+     277, -192, 129, -84, 52, -30, 16, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 30, -50, 81, -124, 182, -261, 366,
+     -510, 713, -1025, 1581, -2955, 14691, 4982, -2041, 1212, -807, 561, -396,
+     278, -192, 130, -84, 52, -30, 16, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 30, -51, 81, -124, 183, -261, 367,
+     -511, 715, -1028, 1585, -2962, 14678, 5003, -2048, 1216, -809, 563, -397,
+     279, -193, 130, -85, 52, -30, 16, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 30, -51, 81, -124, 183, -262, 368,
+     -512, 717, -1030, 1589, -2968, 14665, 5024, -2055, 1220, -812, 565, -398,
+     280, -194, 131, -85, 53, -31, 16, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 30, -51, 82, -125, 184, -263, 369,
+     -514, 719, -1033, 1593, -2974, 14653, 5046, -2062, 1224, -815, 567, -400,
+     281, -194, 131, -85, 53, -31, 16, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 30, -51, 82, -125, 184, -264, 370,
+     -515, 721, -1036, 1597, -2981, 14640, 5067, -2070, 1228, -817, 568, -401,
+     282, -195, 131, -85, 53, -31, 16, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 30, -51, 82, -126, 185, -264, 371,
+     -517, 723, -1038, 1601, -2987, 14628, 5088, -2077, 1232, -820, 570, -402,
+     283, -195, 132, -86, 53, -31, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 30, -51, 82, -126, 185, -265, 372,
+     -518, 725, -1041, 1605, -2993, 14615, 5110, -2084, 1236, -822, 572, -403,
+     283, -196, 132, -86, 53, -31, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 30, -51, 83, -126, 186, -266, 373,
+     -519, 726, -1044, 1609, -2999, 14602, 5131, -2091, 1240, -825, 574, -405,
+     284, -197, 132, -86, 53, -31, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 30, -52, 83, -127, 186, -267, 374,
+     -521, 728, -1046, 1613, -3006, 14589, 5152, -2098, 1244, -827, 575, -406,
+     285, -197, 133, -86, 53, -31, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 30, -52, 83, -127, 187, -267, 375,
+     -522, 730, -1049, 1617, -3012, 14576, 5174, -2105, 1248, -830, 577, -407,
+     286, -198, 133, -87, 54, -31, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 30, -52, 83, -127, 187, -268, 376,
+     -523, 732, -1052, 1621, -3018, 14563, 5195, -2112, 1252, -832, 579, -408,
+     287, -198, 134, -87, 54, -31, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 30, -52, 84, -128, 188, -269, 377,
+     -525, 734, -1054, 1624, -3024, 14550, 5217, -2119, 1256, -835, 581, -409,
+     288, -199, 134, -87, 54, -31, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 31, -52, 84, -128, 188, -269, 378,
+     -526, 736, -1057, 1628, -3030, 14537, 5238, -2126, 1260, -838, 582, -411,
+     288, -199, 134, -87, 54, -31, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -17, 31, -52, 84, -128, 189, -270, 379,
+     -528, 738, -1060, 1632, -3036, 14524, 5259, -2133, 1264, -840, 584, -412,
+     289, -200, 135, -88, 54, -32, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -17, 31, -52, 84, -129, 189, -271, 380,
+     -529, 740, -1062, 1636, -3042, 14511, 5281, -2140, 1267, -843, 586, -413,
+     290, -201, 135, -88, 54, -32, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -17, 31, -53, 84, -129, 190, -271, 381,
+     -530, 741, -1065, 1639, -3048, 14498, 5302, -2147, 1271, -845, 587, -414,
+     291, -201, 136, -88, 55, -32, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -17, 31, -53, 85, -129, 190, -272, 382,
+     -532, 743, -1067, 1643, -3054, 14485, 5324, -2154, 1275, -848, 589, -415,
+     292, -202, 136, -88, 55, -32, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -17, 31, -53, 85, -130, 191, -273, 383,
+     -533, 745, -1070, 1647, -3060, 14472, 5345, -2161, 1279, -850, 591, -417,
+     293, -202, 136, -89, 55, -32, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -17, 31, -53, 85, -130, 191, -274, 384,
+     -534, 747, -1072, 1651, -3065, 14459, 5367, -2168, 1283, -853, 593, -418,
+     293, -203, 137, -89, 55, -32, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -17, 31, -53, 85, -130, 192, -274, 385,
+     -536, 749, -1075, 1654, -3071, 14445, 5388, -2175, 1287, -855, 594, -419,
+     294, -203, 137, -89, 55, -32, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -17, 31, -53, 86, -131, 192, -275, 386,
+     -537, 751, -1077, 1658, -3077, 14432, 5409, -2182, 1291, -857, 596, -420,
+     295, -204, 137, -89, 55, -32, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -17, 31, -53, 86, -131, 193, -276, 387,
+     -538, 752, -1080, 1662, -3083, 14419, 5431, -2189, 1294, -860, 598, -421,
+     296, -205, 138, -90, 55, -32, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -17, 31, -54, 86, -131, 193, -276, 388,
+     -539, 754, -1082, 1665, -3088, 14405, 5452, -2196, 1298, -862, 599, -422,
+     297, -205, 138, -90, 56, -32, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -17, 31, -54, 86, -132, 194, -277, 389,
+     -541, 756, -1085, 1669, -3094, 14392, 5474, -2203, 1302, -865, 601, -424,
+     297, -206, 139, -90, 56, -32, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -17, 32, -54, 86, -132, 194, -278, 390,
+     -542, 758, -1087, 1672, -3099, 14378, 5495, -2210, 1306, -867, 603, -425,
+     298, -206, 139, -90, 56, -33, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -17, 32, -54, 87, -132, 195, -278, 391,
+     -543, 759, -1090, 1676, -3105, 14365, 5517, -2217, 1310, -870, 604, -426,
+     299, -207, 139, -90, 56, -33, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -17, 32, -54, 87, -133, 195, -279, 392,
+     -545, 761, -1092, 1679, -3111, 14351, 5538, -2224, 1313, -872, 606, -427,
+     300, -207, 140, -91, 56, -33, 18, -8, 3, -1, 0},
+    {0, 1, -3, 8, -17, 32, -54, 87, -133, 196, -280, 393,
+     -546, 763, -1095, 1683, -3116, 14338, 5560, -2231, 1317, -875, 608, -428,
+     301, -208, 140, -91, 56, -33, 18, -8, 3, -1, 0},
+    {0, 1, -3, 8, -17, 32, -54, 87, -133, 196, -280, 393,
+     -547, 765, -1097, 1686, -3121, 14324, 5581, -2238, 1321, -877, 609, -429,
+     301, -208, 140, -91, 56, -33, 18, -8, 3, -1, 0},
+    {0, 1, -3, 8, -17, 32, -55, 87, -134, 197, -281, 394,
+     -548, 766, -1099, 1690, -3127, 14310, 5603, -2244, 1325, -879, 611, -430,
+     302, -209, 141, -91, 57, -33, 18, -8, 3, -1, 0},
+    {0, 1, -3, 8, -17, 32, -55, 88, -134, 197, -282, 395,
+     -550, 768, -1102, 1693, -3132, 14297, 5624, -2251, 1329, -882, 612, -432,
+     303, -209, 141, -92, 57, -33, 18, -8, 3, -1, 0},
+    {0, 1, -3, 8, -17, 32, -55, 88, -134, 197, -282, 396,
+     -551, 770, -1104, 1697, -3138, 14283, 5646, -2258, 1332, -884, 614, -433,
+     304, -210, 141, -92, 57, -33, 18, -8, 3, -1, 0},
+    {0, 1, -3, 8, -17, 32, -55, 88, -135, 198, -283, 397,
+     -552, 772, -1107, 1700, -3143, 14269, 5667, -2265, 1336, -887, 616, -434,
+     305, -211, 142, -92, 57, -33, 18, -9, 3, -1, 0},
+    {0, 1, -3, 8, -17, 32, -55, 88, -135, 198, -284, 398,
+     -553, 773, -1109, 1704, -3148, 14255, 5689, -2272, 1340, -889, 617, -435,
+     305, -211, 142, -92, 57, -33, 18, -9, 3, -1, 0},
+    {0, 1, -3, 8, -17, 32, -55, 88, -135, 199, -284, 399,
+     -555, 775, -1111, 1707, -3153, 14241, 5711, -2278, 1343, -891, 619, -436,
+     306, -212, 143, -93, 57, -33, 18, -9, 3, -1, 0},
+    {0, 1, -3, 8, -17, 32, -55, 89, -135, 199, -285, 400,
+     -556, 777, -1114, 1710, -3158, 14228, 5732, -2285, 1347, -894, 621, -437,
+     307, -212, 143, -93, 57, -33, 18, -9, 3, -1, 0},
+    {0, 1, -3, 8, -17, 32, -55, 89, -136, 200, -286, 401,
+     -557, 778, -1116, 1714, -3164, 14214, 5754, -2292, 1351, -896, 622, -438,
+     308, -213, 143, -93, 58, -34, 18, -9, 3, -1, 0},
+    {0, 1, -3, 8, -18, 33, -56, 89, -136, 200, -286, 402,
+     -558, 780, -1118, 1717, -3169, 14200, 5775, -2299, 1355, -898, 624, -439,
+     308, -213, 144, -93, 58, -34, 18, -9, 4, -1, 0},
+    {0, 1, -3, 8, -18, 33, -56, 89, -136, 201, -287, 402,
+     -560, 782, -1121, 1720, -3174, 14186, 5797, -2305, 1358, -901, 625, -440,
+     309, -214, 144, -93, 58, -34, 18, -9, 4, -1, 0},
+    {0, 1, -3, 8, -18, 33, -56, 90, -137, 201, -288, 403,
+     -561, 783, -1123, 1724, -3179, 14171, 5818, -2312, 1362, -903, 627, -442,
+     310, -214, 144, -94, 58, -34, 18, -9, 4, -1, 0},
+    {0, 1, -3, 8, -18, 33, -56, 90, -137, 202, -288, 404,
+     -562, 785, -1125, 1727, -3184, 14157, 5840, -2319, 1365, -905, 629, -443,
+     311, -215, 145, -94, 58, -34, 18, -9, 4, -1, 0},
+    {0, 1, -3, 9, -18, 33, -56, 90, -137, 202, -289, 405,
+     -563, 787, -1128, 1730, -3189, 14143, 5862, -2325, 1369, -908, 630, -444,
+     312, -215, 145, -94, 58, -34, 18, -9, 4, -1, 0},
+    {0, 1, -3, 9, -18, 33, -56, 90, -138, 202, -289, 406,
+     -564, 788, -1130, 1734, -3194, 14129, 5883, -2332, 1373, -910, 632, -445,
+     312, -216, 145, -94, 58, -34, 18, -9, 4, -1, 0},
+    {0, 1, -3, 9, -18, 33, -56, 90, -138, 203, -290, 407,
+     -566, 790, -1132, 1737, -3199, 14115, 5905, -2339, 1376, -912, 633, -446,
+     313, -216, 146, -95, 59, -34, 18, -9, 4, -1, 0},
+    {0, 1, -3, 9, -18, 33, -56, 91, -138, 203, -291, 408,
+     -567, 792, -1134, 1740, -3203, 14101, 5926, -2345, 1380, -915, 635, -447,
+     314, -217, 146, -95, 59, -34, 18, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 33, -57, 91, -139, 204, -291, 409,
+     -568, 793, -1136, 1743, -3208, 14086, 5948, -2352, 1384, -917, 636, -448,
+     315, -217, 146, -95, 59, -34, 18, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 33, -57, 91, -139, 204, -292, 409,
+     -569, 795, -1139, 1746, -3213, 14072, 5970, -2359, 1387, -919, 638, -449,
+     315, -218, 147, -95, 59, -34, 18, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 33, -57, 91, -139, 205, -293, 410,
+     -570, 796, -1141, 1749, -3218, 14058, 5991, -2365, 1391, -922, 639, -450,
+     316, -218, 147, -95, 59, -34, 18, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 33, -57, 91, -139, 205, -293, 411,
+     -571, 798, -1143, 1753, -3222, 14043, 6013, -2372, 1394, -924, 641, -451,
+     317, -219, 147, -96, 59, -34, 18, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 33, -57, 91, -140, 205, -294, 412,
+     -573, 799, -1145, 1756, -3227, 14029, 6034, -2378, 1398, -926, 643, -452,
+     317, -219, 148, -96, 59, -35, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 33, -57, 92, -140, 206, -294, 413,
+     -574, 801, -1147, 1759, -3232, 14014, 6056, -2385, 1401, -928, 644, -453,
+     318, -220, 148, -96, 60, -35, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 34, -57, 92, -140, 206, -295, 414,
+     -575, 803, -1150, 1762, -3236, 14000, 6078, -2391, 1405, -931, 646, -454,
+     319, -220, 148, -96, 60, -35, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 34, -57, 92, -141, 207, -296, 414,
+     -576, 804, -1152, 1765, -3241, 13985, 6099, -2398, 1408, -933, 647, -456,
+     320, -221, 149, -97, 60, -35, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 34, -58, 92, -141, 207, -296, 415,
+     -577, 806, -1154, 1768, -3245, 13971, 6121, -2404, 1412, -935, 649, -457,
+     320, -221, 149, -97, 60, -35, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 34, -58, 92, -141, 208, -297, 416,
+     -578, 807, -1156, 1771, -3250, 13956, 6143, -2411, 1415, -937, 650, -458,
+     321, -222, 149, -97, 60, -35, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 34, -58, 93, -141, 208, -297, 417,
+     -579, 809, -1158, 1774, -3254, 13941, 6164, -2417, 1419, -939, 652, -459,
+     322, -222, 150, -97, 60, -35, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 34, -58, 93, -142, 208, -298, 418,
+     -581, 810, -1160, 1777, -3259, 13926, 6186, -2424, 1422, -942, 653, -460,
+     323, -223, 150, -97, 60, -35, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 34, -58, 93, -142, 209, -299, 419,
+     -582, 812, -1162, 1780, -3263, 13912, 6208, -2430, 1426, -944, 655, -461,
+     323, -223, 150, -98, 60, -35, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 34, -58, 93, -142, 209, -299, 419,
+     -583, 813, -1164, 1783, -3267, 13897, 6229, -2437, 1429, -946, 656, -462,
+     324, -224, 151, -98, 61, -35, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 34, -58, 93, -143, 210, -300, 420,
+     -584, 815, -1166, 1786, -3272, 13882, 6251, -2443, 1433, -948, 658, -463,
+     325, -224, 151, -98, 61, -35, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 34, -58, 94, -143, 210, -300, 421,
+     -585, 816, -1168, 1789, -3276, 13867, 6273, -2449, 1436, -950, 659, -464,
+     325, -225, 151, -98, 61, -35, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 34, -58, 94, -143, 210, -301, 422,
+     -586, 818, -1170, 1791, -3280, 13852, 6294, -2456, 1440, -953, 660, -465,
+     326, -225, 152, -98, 61, -35, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 34, -59, 94, -143, 211, -301, 423,
+     -587, 819, -1172, 1794, -3284, 13837, 6316, -2462, 1443, -955, 662, -466,
+     327, -226, 152, -99, 61, -36, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -19, 34, -59, 94, -144, 211, -302, 423,
+     -588, 821, -1174, 1797, -3288, 13822, 6338, -2469, 1447, -957, 663, -467,
+     327, -226, 152, -99, 61, -36, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -19, 34, -59, 94, -144, 212, -303, 424,
+     -589, 822, -1176, 1800, -3292, 13807, 6359, -2475, 1450, -959, 665, -468,
+     328, -227, 153, -99, 61, -36, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -19, 34, -59, 94, -144, 212, -303, 425,
+     -590, 824, -1178, 1803, -3297, 13792, 6381, -2481, 1453, -961, 666, -469,
+     329, -227, 153, -99, 61, -36, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -19, 35, -59, 95, -145, 212, -304, 426,
+     -591, 825, -1180, 1806, -3301, 13777, 6403, -2487, 1457, -963, 668, -470,
+     330, -228, 153, -99, 62, -36, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -19, 35, -59, 95, -145, 213, -304, 426,
+     -592, 826, -1182, 1808, -3305, 13762, 6424, -2494, 1460, -965, 669, -471,
+     330, -228, 154, -100, 62, -36, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -19, 35, -59, 95, -145, 213, -305, 427,
+     -593, 828, -1184, 1811, -3308, 13747, 6446, -2500, 1463, -968, 671, -472,
+     331, -229, 154, -100, 62, -36, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -19, 35, -59, 95, -145, 214, -305, 428,
+     -594, 829, -1186, 1814, -3312, 13732, 6468, -2506, 1467, -970, 672, -473,
+     332, -229, 154, -100, 62, -36, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -19, 35, -59, 95, -146, 214, -306, 429,
+     -596, 831, -1188, 1817, -3316, 13717, 6489, -2513, 1470, -972, 673, -474,
+     332, -230, 154, -100, 62, -36, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -19, 35, -60, 96, -146, 214, -306, 429,
+     -597, 832, -1190, 1819, -3320, 13701, 6511, -2519, 1473, -974, 675, -475,
+     333, -230, 155, -100, 62, -36, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -19, 35, -60, 96, -146, 215, -307, 430,
+     -598, 833, -1192, 1822, -3324, 13686, 6533, -2525, 1477, -976, 676, -476,
+     334, -230, 155, -101, 62, -36, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -19, 35, -60, 96, -146, 215, -307, 431,
+     -599, 835, -1194, 1825, -3328, 13671, 6555, -2531, 1480, -978, 678, -477,
+     334, -231, 155, -101, 62, -36, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -19, 35, -60, 96, -147, 216, -308, 432,
+     -600, 836, -1196, 1827, -3331, 13655, 6576, -2537, 1483, -980, 679, -478,
+     335, -231, 156, -101, 63, -36, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -19, 35, -60, 96, -147, 216, -309, 432,
+     -601, 838, -1198, 1830, -3335, 13640, 6598, -2543, 1486, -982, 680, -479,
+     336, -232, 156, -101, 63, -36, 20, -9, 4, -1, 0},
+    {0, 1, -4, 9, -19, 35, -60, 96, -147, 216, -309, 433,
+     -602, 839, -1199, 1832, -3339, 13624, 6620, -2550, 1490, -984, 682, -480,
+     336, -232, 156, -101, 63, -37, 20, -9, 4, -1, 0},
+    {0, 1, -4, 9, -19, 35, -60, 97, -147, 217, -310, 434,
+     -603, 840, -1201, 1835, -3342, 13609, 6641, -2556, 1493, -986, 683, -480,
+     337, -233, 157, -102, 63, -37, 20, -9, 4, -1, 0},
+    {0, 1, -4, 9, -19, 35, -60, 97, -148, 217, -310, 435,
+     -604, 842, -1203, 1837, -3346, 13593, 6663, -2562, 1496, -988, 685, -481,
+     338, -233, 157, -102, 63, -37, 20, -9, 4, -1, 0},
+    {0, 1, -4, 9, -19, 35, -60, 97, -148, 217, -311, 435,
+     -605, 843, -1205, 1840, -3350, 13578, 6685, -2568, 1499, -990, 686, -482,
+     338, -234, 157, -102, 63, -37, 20, -9, 4, -1, 0},
+    {0, 1, -4, 9, -19, 35, -61, 97, -148, 218, -311, 436,
+     -606, 844, -1207, 1843, -3353, 13562, 6707, -2574, 1503, -992, 687, -483,
+     339, -234, 157, -102, 63, -37, 20, -9, 4, -1, 0},
+    {0, 1, -4, 9, -19, 36, -61, 97, -148, 218, -312, 437,
+     -606, 846, -1209, 1845, -3357, 13547, 6728, -2580, 1506, -994, 689, -484,
+     340, -234, 158, -102, 63, -37, 20, -9, 4, -1, 0},
+    {0, 1, -4, 9, -19, 36, -61, 97, -149, 218, -312, 437,
+     -607, 847, -1210, 1848, -3360, 13531, 6750, -2586, 1509, -996, 690, -485,
+     340, -235, 158, -103, 64, -37, 20, -9, 4, -1, 0},
+    {0, 1, -4, 9, -19, 36, -61, 98, -149, 219, -313, 438,
+     -608, 848, -1212, 1850, -3363, 13515, 6772, -2592, 1512, -998, 691, -486,
+     341, -235, 158, -103, 64, -37, 20, -9, 4, -1, 0},
+    {0, 1, -4, 9, -19, 36, -61, 98, -149, 219, -313, 439,
+     -609, 849, -1214, 1852, -3367, 13500, 6793, -2598, 1515, -1000, 693, -487,
+     341, -236, 159, -103, 64, -37, 20, -10, 4, -1, 0},
+    {0, 1, -4, 9, -19, 36, -61, 98, -149, 220, -314, 440,
+     -610, 851, -1216, 1855, -3370, 13484, 6815, -2604, 1519, -1002, 694, -488,
+     342, -236, 159, -103, 64, -37, 20, -10, 4, -1, 0},
+    {0, 1, -4, 9, -19, 36, -61, 98, -150, 220, -314, 440,
+     -611, 852, -1217, 1857, -3373, 13468, 6837, -2610, 1522, -1004, 695, -489,
+     343, -237, 159, -103, 64, -37, 20, -10, 4, -1, 0},
+    {0, 1, -4, 9, -19, 36, -61, 98, -150, 220, -315, 441,
+     -612, 853, -1219, 1860, -3377, 13452, 6859, -2616, 1525, -1006, 697, -490,
+     343, -237, 160, -104, 64, -37, 20, -10, 4, -1, 0},
+    {0, 1, -4, 9, -19, 36, -61, 98, -150, 221, -315, 442,
+     -613, 854, -1221, 1862, -3380, 13436, 6880, -2622, 1528, -1008, 698, -491,
+     344, -237, 160, -104, 64, -37, 20, -10, 4, -1, 0},
+    {0, 1, -4, 9, -19, 36, -61, 98, -150, 221, -316, 442,
+     -614, 856, -1222, 1864, -3383, 13420, 6902, -2628, 1531, -1010, 699, -492,
+     345, -238, 160, -104, 64, -37, 20, -10, 4, -1, 0},
+    {0, 1, -4, 9, -19, 36, -62, 99, -151, 221, -316, 443,
+     -615, 857, -1224, 1867, -3386, 13404, 6924, -2634, 1534, -1012, 701, -492,
+     345, -238, 160, -104, 64, -37, 20, -10, 4, -1, 0},
+    {0, 1, -4, 9, -19, 36, -62, 99, -151, 222, -317, 444,
+     -616, 858, -1226, 1869, -3389, 13388, 6945, -2640, 1537, -1014, 702, -493,
+     346, -239, 161, -104, 65, -38, 20, -10, 4, -1, 0},
+    {0, 1, -4, 9, -19, 36, -62, 99, -151, 222, -317, 444,
+     -617, 859, -1227, 1871, -3392, 13372, 6967, -2645, 1540, -1016, 703, -494,
+     346, -239, 161, -104, 65, -38, 20, -10, 4, -1, 0},
+    {0, 1, -4, 9, -20, 36, -62, 99, -151, 222, -318, 445,
+     -618, 861, -1229, 1873, -3395, 13356, 6989, -2651, 1543, -1018, 704, -495,
+     347, -240, 161, -105, 65, -38, 20, -10, 4, -1, 0},
+    {0, 1, -4, 9, -20, 36, -62, 99, -152, 223, -318, 446,
+     -618, 862, -1231, 1876, -3398, 13340, 7011, -2657, 1546, -1020, 706, -496,
+     348, -240, 161, -105, 65, -38, 20, -10, 4, -1, 0},
+    {0, 1, -4, 9, -20, 36, -62, 99, -152, 223, -319, 446,
+     -619, 863, -1232, 1878, -3401, 13324, 7032, -2663, 1549, -1022, 707, -497,
+     348, -240, 162, -105, 65, -38, 20, -10, 4, -1, 0},
+    {0, 1, -4, 9, -20, 36, -62, 100, -152, 223, -319, 447,
+     -620, 864, -1234, 1880, -3404, 13308, 7054, -2669, 1552, -1024, 708, -498,
+     349, -241, 162, -105, 65, -38, 20, -10, 4, -1, 0},
+    {0, 1, -4, 9, -20, 36, -62, 100, -152, 224, -319, 448,
+     -621, 865, -1235, 1882, -3407, 13292, 7076, -2675, 1555, -1025, 709, -499,
+     349, -241, 162, -105, 65, -38, 20, -10, 4, -1, 0},
+    {0, 1, -4, 9, -20, 36, -62, 100, -152, 224, -320, 448,
+     -622, 866, -1237, 1884, -3410, 13276, 7097, -2680, 1558, -1027, 711, -499,
+     350, -242, 163, -105, 65, -38, 20, -10, 4, -1, 0},
+    {0, 1, -4, 9, -20, 37, -62, 100, -153, 224, -320, 449,
+     -623, 868, -1239, 1887, -3413, 13259, 7119, -2686, 1561, -1029, 712, -500,
+     351, -242, 163, -106, 65, -38, 20, -10, 4, -1, 0},
+    {0, 1, -4, 9, -20, 37, -62, 100, -153, 225, -321, 449,
+     -624, 869, -1240, 1889, -3416, 13243, 7141, -2692, 1564, -1031, 713, -501,
+     351, -242, 163, -106, 65, -38, 20, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -63, 100, -153, 225, -321, 450,
+     -625, 870, -1242, 1891, -3419, 13227, 7162, -2697, 1567, -1033, 714, -502,
+     352, -243, 163, -106, 66, -38, 20, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -63, 100, -153, 225, -322, 451,
+     -625, 871, -1243, 1893, -3421, 13210, 7184, -2703, 1570, -1035, 716, -503,
+     352, -243, 164, -106, 66, -38, 20, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -63, 101, -154, 226, -322, 451,
+     -626, 872, -1245, 1895, -3424, 13194, 7206, -2709, 1573, -1037, 717, -504,
+     353, -244, 164, -106, 66, -38, 20, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -63, 101, -154, 226, -323, 452,
+     -627, 873, -1246, 1897, -3427, 13178, 7228, -2714, 1576, -1038, 718, -504,
+     354, -244, 164, -107, 66, -38, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -63, 101, -154, 226, -323, 453,
+     -628, 874, -1248, 1899, -3429, 13161, 7249, -2720, 1579, -1040, 719, -505,
+     354, -244, 164, -107, 66, -38, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -63, 101, -154, 227, -323, 453,
+     -629, 875, -1249, 1901, -3432, 13145, 7271, -2726, 1582, -1042, 720, -506,
+     355, -245, 165, -107, 66, -38, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -63, 101, -154, 227, -324, 454,
+     -629, 877, -1251, 1903, -3434, 13128, 7293, -2731, 1585, -1044, 722, -507,
+     355, -245, 165, -107, 66, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -63, 101, -155, 227, -324, 454,
+     -630, 878, -1252, 1905, -3437, 13112, 7314, -2737, 1588, -1045, 723, -508,
+     356, -246, 165, -107, 66, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -63, 101, -155, 227, -325, 455,
+     -631, 879, -1254, 1907, -3439, 13095, 7336, -2742, 1591, -1047, 724, -509,
+     356, -246, 165, -107, 66, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -63, 102, -155, 228, -325, 455,
+     -632, 880, -1255, 1909, -3442, 13078, 7358, -2748, 1593, -1049, 725, -509,
+     357, -246, 166, -107, 67, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -63, 102, -155, 228, -326, 456,
+     -633, 881, -1256, 1911, -3444, 13062, 7379, -2753, 1596, -1051, 726, -510,
+     357, -247, 166, -108, 67, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -64, 102, -155, 228, -326, 457,
+     -633, 882, -1258, 1913, -3446, 13045, 7401, -2759, 1599, -1053, 728, -511,
+     358, -247, 166, -108, 67, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -64, 102, -156, 229, -326, 457,
+     -634, 883, -1259, 1915, -3449, 13028, 7423, -2764, 1602, -1054, 729, -512,
+     359, -247, 166, -108, 67, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -64, 102, -156, 229, -327, 458,
+     -635, 884, -1261, 1916, -3451, 13012, 7445, -2770, 1605, -1056, 730, -513,
+     359, -248, 167, -108, 67, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -64, 102, -156, 229, -327, 458,
+     -636, 885, -1262, 1918, -3453, 12995, 7466, -2775, 1607, -1058, 731, -513,
+     360, -248, 167, -108, 67, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -64, 102, -156, 229, -328, 459,
+     -636, 886, -1263, 1920, -3456, 12978, 7488, -2781, 1610, -1059, 732, -514,
+     360, -248, 167, -108, 67, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -64, 103, -156, 230, -328, 459,
+     -637, 887, -1265, 1922, -3458, 12961, 7510, -2786, 1613, -1061, 733, -515,
+     361, -249, 167, -109, 67, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 38, -64, 103, -157, 230, -328, 460,
+     -638, 888, -1266, 1924, -3460, 12944, 7531, -2791, 1616, -1063, 734, -516,
+     361, -249, 168, -109, 67, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 38, -64, 103, -157, 230, -329, 461,
+     -639, 889, -1267, 1925, -3462, 12927, 7553, -2797, 1618, -1064, 736, -516,
+     362, -250, 168, -109, 67, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 38, -64, 103, -157, 231, -329, 461,
+     -639, 890, -1269, 1927, -3464, 12910, 7575, -2802, 1621, -1066, 737, -517,
+     362, -250, 168, -109, 67, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 38, -64, 103, -157, 231, -330, 462,
+     -640, 891, -1270, 1929, -3466, 12893, 7596, -2807, 1624, -1068, 738, -518,
+     363, -250, 168, -109, 68, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 38, -64, 103, -157, 231, -330, 462,
+     -641, 892, -1271, 1931, -3468, 12876, 7618, -2813, 1626, -1069, 739, -519,
+     363, -251, 169, -109, 68, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 38, -64, 103, -158, 231, -330, 463,
+     -642, 893, -1272, 1932, -3470, 12859, 7639, -2818, 1629, -1071, 740, -519,
+     364, -251, 169, -109, 68, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 38, -65, 103, -158, 232, -331, 463,
+     -642, 894, -1274, 1934, -3472, 12842, 7661, -2823, 1632, -1073, 741, -520,
+     364, -251, 169, -110, 68, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 38, -65, 104, -158, 232, -331, 464,
+     -643, 895, -1275, 1936, -3474, 12825, 7683, -2828, 1634, -1074, 742, -521,
+     365, -252, 169, -110, 68, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 38, -65, 104, -158, 232, -332, 464,
+     -644, 896, -1276, 1937, -3476, 12808, 7704, -2834, 1637, -1076, 743, -522,
+     365, -252, 169, -110, 68, -40, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 38, -65, 104, -158, 233, -332, 465,
+     -644, 896, -1277, 1939, -3478, 12791, 7726, -2839, 1640, -1078, 744, -522,
+     366, -252, 170, -110, 68, -40, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 38, -65, 104, -158, 233, -332, 465,
+     -645, 897, -1278, 1940, -3479, 12774, 7748, -2844, 1642, -1079, 745, -523,
+     366, -253, 170, -110, 68, -40, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 38, -65, 104, -159, 233, -333, 466,
+     -646, 898, -1280, 1942, -3481, 12756, 7769, -2849, 1645, -1081, 746, -524,
+     367, -253, 170, -110, 68, -40, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 38, -65, 104, -159, 233, -333, 466,
+     -646, 899, -1281, 1943, -3483, 12739, 7791, -2854, 1647, -1082, 747, -525,
+     367, -253, 170, -111, 68, -40, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 38, -65, 104, -159, 234, -333, 467,
+     -647, 900, -1282, 1945, -3485, 12722, 7813, -2859, 1650, -1084, 748, -525,
+     368, -254, 171, -111, 68, -40, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 38, -65, 104, -159, 234, -334, 467,
+     -648, 901, -1283, 1947, -3486, 12705, 7834, -2865, 1653, -1086, 749, -526,
+     368, -254, 171, -111, 69, -40, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 38, -65, 104, -159, 234, -334, 468,
+     -648, 902, -1284, 1948, -3488, 12687, 7856, -2870, 1655, -1087, 750, -527,
+     369, -254, 171, -111, 69, -40, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 38, -65, 105, -160, 234, -334, 468,
+     -649, 903, -1285, 1949, -3489, 12670, 7877, -2875, 1658, -1089, 752, -527,
+     369, -255, 171, -111, 69, -40, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 38, -65, 105, -160, 235, -335, 469,
+     -650, 903, -1287, 1951, -3491, 12652, 7899, -2880, 1660, -1090, 753, -528,
+     370, -255, 171, -111, 69, -40, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 38, -65, 105, -160, 235, -335, 469,
+     -650, 904, -1288, 1952, -3493, 12635, 7921, -2885, 1663, -1092, 754, -529,
+     370, -255, 172, -111, 69, -40, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 38, -65, 105, -160, 235, -335, 470,
+     -651, 905, -1289, 1954, -3494, 12617, 7942, -2890, 1665, -1093, 755, -529,
+     371, -256, 172, -111, 69, -40, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 38, -66, 105, -160, 235, -336, 470,
+     -651, 906, -1290, 1955, -3495, 12600, 7964, -2895, 1668, -1095, 756, -530,
+     371, -256, 172, -112, 69, -40, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 38, -66, 105, -160, 236, -336, 470,
+     -652, 907, -1291, 1957, -3497, 12582, 7985, -2900, 1670, -1096, 757, -531,
+     372, -256, 172, -112, 69, -40, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 38, -66, 105, -161, 236, -336, 471,
+     -653, 908, -1292, 1958, -3498, 12565, 8007, -2905, 1673, -1098, 757, -531,
+     372, -257, 172, -112, 69, -40, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -66, 105, -161, 236, -337, 471,
+     -653, 908, -1293, 1959, -3500, 12547, 8028, -2909, 1675, -1099, 758, -532,
+     372, -257, 173, -112, 69, -40, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -66, 105, -161, 236, -337, 472,
+     -654, 909, -1294, 1961, -3501, 12530, 8050, -2914, 1677, -1101, 759, -533,
+     373, -257, 173, -112, 69, -40, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -66, 106, -161, 236, -337, 472,
+     -654, 910, -1295, 1962, -3502, 12512, 8072, -2919, 1680, -1102, 760, -533,
+     373, -257, 173, -112, 69, -40, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -66, 106, -161, 237, -338, 473,
+     -655, 911, -1296, 1963, -3503, 12494, 8093, -2924, 1682, -1104, 761, -534,
+     374, -258, 173, -112, 70, -40, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -66, 106, -161, 237, -338, 473,
+     -656, 911, -1297, 1964, -3505, 12477, 8115, -2929, 1685, -1105, 762, -535,
+     374, -258, 173, -113, 70, -40, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -66, 106, -161, 237, -338, 473,
+     -656, 912, -1298, 1966, -3506, 12459, 8136, -2934, 1687, -1106, 763, -535,
+     375, -258, 174, -113, 70, -40, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -66, 106, -162, 237, -339, 474,
+     -657, 913, -1299, 1967, -3507, 12441, 8158, -2938, 1689, -1108, 764, -536,
+     375, -259, 174, -113, 70, -41, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -66, 106, -162, 238, -339, 474,
+     -657, 914, -1300, 1968, -3508, 12423, 8179, -2943, 1692, -1109, 765, -537,
+     376, -259, 174, -113, 70, -41, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -66, 106, -162, 238, -339, 475,
+     -658, 914, -1301, 1969, -3509, 12405, 8201, -2948, 1694, -1111, 766, -537,
+     376, -259, 174, -113, 70, -41, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -66, 106, -162, 238, -340, 475,
+     -658, 915, -1302, 1970, -3510, 12388, 8222, -2953, 1696, -1112, 767, -538,
+     376, -260, 174, -113, 70, -41, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -66, 106, -162, 238, -340, 476,
+     -659, 916, -1303, 1971, -3511, 12370, 8244, -2957, 1699, -1113, 768, -538,
+     377, -260, 175, -113, 70, -41, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -66, 106, -162, 238, -340, 476,
+     -659, 916, -1303, 1973, -3512, 12352, 8265, -2962, 1701, -1115, 769, -539,
+     377, -260, 175, -113, 70, -41, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -67, 107, -162, 239, -340, 476,
+     -660, 917, -1304, 1974, -3513, 12334, 8287, -2967, 1703, -1116, 770, -540,
+     378, -260, 175, -113, 70, -41, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -67, 107, -163, 239, -341, 477,
+     -660, 918, -1305, 1975, -3514, 12316, 8308, -2971, 1705, -1118, 771, -540,
+     378, -261, 175, -114, 70, -41, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -67, 107, -163, 239, -341, 477,
+     -661, 918, -1306, 1976, -3515, 12298, 8330, -2976, 1708, -1119, 771, -541,
+     378, -261, 175, -114, 70, -41, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -67, 107, -163, 239, -341, 477,
+     -661, 919, -1307, 1977, -3516, 12280, 8351, -2980, 1710, -1120, 772, -541,
+     379, -261, 176, -114, 70, -41, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -67, 107, -163, 239, -342, 478,
+     -662, 920, -1308, 1978, -3516, 12262, 8373, -2985, 1712, -1122, 773, -542,
+     379, -261, 176, -114, 70, -41, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -67, 107, -163, 240, -342, 478,
+     -662, 920, -1309, 1979, -3517, 12244, 8394, -2989, 1714, -1123, 774, -543,
+     380, -262, 176, -114, 71, -41, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -67, 107, -163, 240, -342, 479,
+     -663, 921, -1309, 1980, -3518, 12226, 8416, -2994, 1716, -1124, 775, -543,
+     380, -262, 176, -114, 71, -41, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -67, 107, -163, 240, -342, 479,
+     -663, 922, -1310, 1981, -3519, 12207, 8437, -2998, 1718, -1125, 776, -544,
+     380, -262, 176, -114, 71, -41, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -67, 107, -164, 240, -343, 479,
+     -664, 922, -1311, 1982, -3519, 12189, 8458, -3003, 1721, -1127, 777, -544,
+     381, -262, 176, -114, 71, -41, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -67, 107, -164, 240, -343, 480,
+     -664, 923, -1312, 1983, -3520, 12171, 8480, -3007, 1723, -1128, 777, -545,
+     381, -263, 177, -114, 71, -41, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -67, 107, -164, 241, -343, 480,
+     -665, 923, -1313, 1984, -3521, 12153, 8501, -3012, 1725, -1129, 778, -545,
+     382, -263, 177, -115, 71, -41, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -67, 107, -164, 241, -343, 480,
+     -665, 924, -1313, 1984, -3521, 12134, 8523, -3016, 1727, -1131, 779, -546,
+     382, -263, 177, -115, 71, -41, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -67, 108, -164, 241, -344, 481,
+     -666, 925, -1314, 1985, -3522, 12116, 8544, -3021, 1729, -1132, 780, -547,
+     382, -264, 177, -115, 71, -41, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -67, 108, -164, 241, -344, 481,
+     -666, 925, -1315, 1986, -3522, 12098, 8566, -3025, 1731, -1133, 781, -547,
+     383, -264, 177, -115, 71, -41, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -67, 108, -164, 241, -344, 481,
+     -667, 926, -1315, 1987, -3523, 12080, 8587, -3029, 1733, -1134, 781, -548,
+     383, -264, 177, -115, 71, -41, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -67, 108, -164, 241, -344, 482,
+     -667, 926, -1316, 1988, -3523, 12061, 8608, -3034, 1735, -1135, 782, -548,
+     383, -264, 178, -115, 71, -41, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -67, 108, -165, 242, -345, 482,
+     -667, 927, -1317, 1989, -3523, 12043, 8630, -3038, 1737, -1137, 783, -549,
+     384, -264, 178, -115, 71, -41, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 40, -67, 108, -165, 242, -345, 482,
+     -668, 927, -1317, 1989, -3524, 12024, 8651, -3042, 1739, -1138, 784, -549,
+     384, -265, 178, -115, 71, -41, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 40, -67, 108, -165, 242, -345, 483,
+     -668, 928, -1318, 1990, -3524, 12006, 8672, -3046, 1741, -1139, 785, -550,
+     384, -265, 178, -115, 71, -41, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 40, -68, 108, -165, 242, -345, 483,
+     -669, 928, -1319, 1991, -3524, 11987, 8694, -3051, 1743, -1140, 785, -550,
+     385, -265, 178, -116, 71, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 40, -68, 108, -165, 242, -345, 483,
+     -669, 929, -1319, 1992, -3525, 11969, 8715, -3055, 1745, -1141, 786, -551,
+     385, -265, 178, -116, 71, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 40, -68, 108, -165, 242, -346, 483,
+     -669, 929, -1320, 1992, -3525, 11950, 8736, -3059, 1747, -1143, 787, -551,
+     385, -266, 178, -116, 72, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 40, -68, 108, -165, 243, -346, 484,
+     -670, 930, -1321, 1993, -3525, 11932, 8758, -3063, 1749, -1144, 788, -552,
+     386, -266, 179, -116, 72, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 40, -68, 108, -165, 243, -346, 484,
+     -670, 930, -1321, 1994, -3525, 11913, 8779, -3067, 1751, -1145, 788, -552,
+     386, -266, 179, -116, 72, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 40, -68, 108, -165, 243, -346, 484,
+     -670, 931, -1322, 1994, -3525, 11895, 8800, -3071, 1753, -1146, 789, -553,
+     386, -266, 179, -116, 72, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 40, -68, 109, -166, 243, -347, 485,
+     -671, 931, -1322, 1995, -3525, 11876, 8822, -3075, 1755, -1147, 790, -553,
+     387, -267, 179, -116, 72, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 40, -68, 109, -166, 243, -347, 485,
+     -671, 932, -1323, 1995, -3525, 11857, 8843, -3079, 1757, -1148, 790, -554,
+     387, -267, 179, -116, 72, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 40, -68, 109, -166, 243, -347, 485,
+     -672, 932, -1323, 1996, -3525, 11839, 8864, -3083, 1759, -1149, 791, -554,
+     387, -267, 179, -116, 72, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 40, -68, 109, -166, 243, -347, 485,
+     -672, 933, -1324, 1997, -3525, 11820, 8885, -3087, 1760, -1150, 792, -555,
+     388, -267, 179, -116, 72, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 40, -68, 109, -166, 244, -347, 486,
+     -672, 933, -1324, 1997, -3525, 11801, 8907, -3091, 1762, -1151, 792, -555,
+     388, -267, 180, -116, 72, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 40, -68, 109, -166, 244, -347, 486,
+     -673, 933, -1325, 1998, -3525, 11782, 8928, -3095, 1764, -1152, 793, -555,
+     388, -268, 180, -117, 72, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -68, 109, -166, 244, -348, 486,
+     -673, 934, -1325, 1998, -3525, 11764, 8949, -3099, 1766, -1153, 794, -556,
+     389, -268, 180, -117, 72, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -68, 109, -166, 244, -348, 486,
+     -673, 934, -1326, 1999, -3525, 11745, 8970, -3103, 1768, -1155, 795, -556,
+     389, -268, 180, -117, 72, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -68, 109, -166, 244, -348, 487,
+     -673, 935, -1326, 1999, -3525, 11726, 8991, -3107, 1769, -1156, 795, -557,
+     389, -268, 180, -117, 72, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -68, 109, -166, 244, -348, 487,
+     -674, 935, -1327, 1999, -3525, 11707, 9013, -3111, 1771, -1157, 796, -557,
+     390, -268, 180, -117, 72, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -68, 109, -166, 244, -348, 487,
+     -674, 935, -1327, 2000, -3524, 11688, 9034, -3115, 1773, -1158, 796, -558,
+     390, -269, 180, -117, 72, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -68, 109, -167, 244, -349, 487,
+     -674, 936, -1328, 2000, -3524, 11669, 9055, -3118, 1775, -1159, 797, -558,
+     390, -269, 181, -117, 72, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -68, 109, -167, 245, -349, 487,
+     -675, 936, -1328, 2001, -3524, 11650, 9076, -3122, 1776, -1160, 798, -559,
+     390, -269, 181, -117, 72, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -68, 109, -167, 245, -349, 488,
+     -675, 936, -1329, 2001, -3524, 11631, 9097, -3126, 1778, -1161, 798, -559,
+     391, -269, 181, -117, 72, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -68, 109, -167, 245, -349, 488,
+     -675, 937, -1329, 2001, -3523, 11612, 9118, -3130, 1780, -1162, 799, -559,
+     391, -269, 181, -117, 72, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -68, 109, -167, 245, -349, 488,
+     -675, 937, -1329, 2002, -3523, 11593, 9140, -3133, 1781, -1163, 800, -560,
+     391, -270, 181, -117, 73, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -68, 110, -167, 245, -349, 488,
+     -676, 937, -1330, 2002, -3522, 11574, 9161, -3137, 1783, -1163, 800, -560,
+     392, -270, 181, -117, 73, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -68, 110, -167, 245, -349, 489,
+     -676, 938, -1330, 2002, -3522, 11555, 9182, -3141, 1785, -1164, 801, -561,
+     392, -270, 181, -117, 73, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -68, 110, -167, 245, -350, 489,
+     -676, 938, -1330, 2003, -3521, 11536, 9203, -3144, 1786, -1165, 801, -561,
+     392, -270, 181, -118, 73, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -68, 110, -167, 245, -350, 489,
+     -676, 938, -1331, 2003, -3521, 11517, 9224, -3148, 1788, -1166, 802, -561,
+     392, -270, 181, -118, 73, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -69, 110, -167, 245, -350, 489,
+     -677, 939, -1331, 2003, -3520, 11498, 9245, -3152, 1790, -1167, 803, -562,
+     393, -270, 182, -118, 73, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -69, 110, -167, 246, -350, 489,
+     -677, 939, -1331, 2003, -3520, 11479, 9266, -3155, 1791, -1168, 803, -562,
+     393, -271, 182, -118, 73, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -69, 110, -167, 246, -350, 489,
+     -677, 939, -1332, 2004, -3519, 11459, 9287, -3159, 1793, -1169, 804, -562,
+     393, -271, 182, -118, 73, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -69, 110, -167, 246, -350, 490,
+     -677, 939, -1332, 2004, -3518, 11440, 9308, -3162, 1794, -1170, 804, -563,
+     393, -271, 182, -118, 73, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -69, 110, -168, 246, -350, 490,
+     -678, 940, -1332, 2004, -3518, 11421, 9329, -3166, 1796, -1171, 805, -563,
+     394, -271, 182, -118, 73, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -69, 110, -168, 246, -351, 490,
+     -678, 940, -1332, 2004, -3517, 11402, 9350, -3169, 1797, -1172, 805, -564,
+     394, -271, 182, -118, 73, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -69, 110, -168, 246, -351, 490,
+     -678, 940, -1333, 2004, -3516, 11382, 9371, -3173, 1799, -1172, 806, -564,
+     394, -271, 182, -118, 73, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -69, 110, -168, 246, -351, 490,
+     -678, 940, -1333, 2004, -3515, 11363, 9392, -3176, 1800, -1173, 806, -564,
+     394, -271, 182, -118, 73, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -69, 110, -168, 246, -351, 490,
+     -678, 941, -1333, 2004, -3515, 11344, 9413, -3179, 1802, -1174, 807, -565,
+     394, -272, 182, -118, 73, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -69, 110, -168, 246, -351, 491,
+     -678, 941, -1333, 2004, -3514, 11324, 9434, -3183, 1803, -1175, 807, -565,
+     395, -272, 183, -118, 73, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -69, 110, -168, 246, -351, 491,
+     -679, 941, -1333, 2004, -3513, 11305, 9455, -3186, 1805, -1176, 808, -565,
+     395, -272, 183, -118, 73, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -69, 110, -168, 246, -351, 491,
+     -679, 941, -1334, 2004, -3512, 11285, 9476, -3189, 1806, -1176, 808, -566,
+     395, -272, 183, -118, 73, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -69, 110, -168, 246, -351, 491,
+     -679, 941, -1334, 2004, -3511, 11266, 9497, -3193, 1807, -1177, 809, -566,
+     395, -272, 183, -118, 73, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -69, 110, -168, 247, -351, 491,
+     -679, 941, -1334, 2004, -3510, 11247, 9518, -3196, 1809, -1178, 809, -566,
+     396, -272, 183, -118, 73, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -69, 110, -168, 247, -352, 491,
+     -679, 942, -1334, 2004, -3509, 11227, 9539, -3199, 1810, -1179, 810, -566,
+     396, -272, 183, -119, 73, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 40, -69, 110, -168, 247, -352, 491,
+     -679, 942, -1334, 2004, -3508, 11208, 9560, -3202, 1812, -1180, 810, -567,
+     396, -273, 183, -119, 73, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 40, -69, 110, -168, 247, -352, 491,
+     -680, 942, -1334, 2004, -3507, 11188, 9580, -3206, 1813, -1180, 811, -567,
+     396, -273, 183, -119, 73, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 40, -69, 110, -168, 247, -352, 491,
+     -680, 942, -1334, 2004, -3506, 11168, 9601, -3209, 1814, -1181, 811, -567,
+     396, -273, 183, -119, 73, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 40, -69, 110, -168, 247, -352, 492,
+     -680, 942, -1334, 2004, -3505, 11149, 9622, -3212, 1815, -1182, 812, -568,
+     396, -273, 183, -119, 73, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 40, -69, 110, -168, 247, -352, 492,
+     -680, 942, -1335, 2004, -3504, 11129, 9643, -3215, 1817, -1182, 812, -568,
+     397, -273, 183, -119, 73, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 40, -69, 110, -168, 247, -352, 492,
+     -680, 942, -1335, 2004, -3502, 11110, 9664, -3218, 1818, -1183, 813, -568,
+     397, -273, 183, -119, 73, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 40, -69, 110, -168, 247, -352, 492,
+     -680, 942, -1335, 2004, -3501, 11090, 9684, -3221, 1819, -1184, 813, -568,
+     397, -273, 184, -119, 73, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 40, -69, 111, -168, 247, -352, 492,
+     -680, 943, -1335, 2004, -3500, 11070, 9705, -3224, 1821, -1184, 813, -569,
+     397, -273, 184, -119, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 40, -69, 111, -168, 247, -352, 492,
+     -680, 943, -1335, 2003, -3499, 11051, 9726, -3227, 1822, -1185, 814, -569,
+     397, -274, 184, -119, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -168, 247, -352, 492,
+     -680, 943, -1335, 2003, -3497, 11031, 9747, -3230, 1823, -1186, 814, -569,
+     398, -274, 184, -119, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 247, -352, 492,
+     -680, 943, -1335, 2003, -3496, 11011, 9768, -3233, 1824, -1186, 815, -570,
+     398, -274, 184, -119, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 247, -352, 492,
+     -680, 943, -1335, 2003, -3494, 10991, 9788, -3236, 1825, -1187, 815, -570,
+     398, -274, 184, -119, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 247, -352, 492,
+     -681, 943, -1335, 2002, -3493, 10972, 9809, -3239, 1826, -1188, 815, -570,
+     398, -274, 184, -119, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 247, -352, 492,
+     -681, 943, -1335, 2002, -3492, 10952, 9830, -3242, 1828, -1188, 816, -570,
+     398, -274, 184, -119, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 247, -352, 492,
+     -681, 943, -1335, 2002, -3490, 10932, 9850, -3244, 1829, -1189, 816, -570,
+     398, -274, 184, -119, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 247, -353, 492,
+     -681, 943, -1335, 2001, -3489, 10912, 9871, -3247, 1830, -1189, 816, -571,
+     398, -274, 184, -119, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 247, -353, 492,
+     -681, 943, -1334, 2001, -3487, 10892, 9892, -3250, 1831, -1190, 817, -571,
+     399, -274, 184, -119, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 247, -353, 492,
+     -681, 943, -1334, 2001, -3486, 10872, 9912, -3253, 1832, -1191, 817, -571,
+     399, -274, 184, -119, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 247, -353, 492,
+     -681, 943, -1334, 2000, -3484, 10853, 9933, -3255, 1833, -1191, 817, -571,
+     399, -275, 184, -119, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 247, -353, 493,
+     -681, 943, -1334, 2000, -3482, 10833, 9953, -3258, 1834, -1192, 818, -572,
+     399, -275, 184, -119, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 248, -353, 493,
+     -681, 943, -1334, 2000, -3481, 10813, 9974, -3261, 1835, -1192, 818, -572,
+     399, -275, 184, -119, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 248, -353, 493,
+     -681, 943, -1334, 1999, -3479, 10793, 9995, -3263, 1836, -1193, 818, -572,
+     399, -275, 184, -119, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 248, -353, 493,
+     -681, 943, -1334, 1999, -3477, 10773, 10015, -3266, 1837, -1193, 819, -572,
+     399, -275, 184, -119, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 248, -353, 493,
+     -681, 943, -1334, 1998, -3475, 10753, 10036, -3269, 1838, -1194, 819, -572,
+     399, -275, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 248, -353, 493,
+     -681, 943, -1333, 1998, -3474, 10733, 10056, -3271, 1839, -1194, 819, -572,
+     400, -275, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 248, -353, 493,
+     -681, 943, -1333, 1997, -3472, 10713, 10077, -3274, 1840, -1195, 819, -573,
+     400, -275, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 248, -353, 493,
+     -681, 943, -1333, 1997, -3470, 10693, 10097, -3276, 1841, -1195, 820, -573,
+     400, -275, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 248, -353, 493,
+     -681, 942, -1333, 1996, -3468, 10673, 10118, -3279, 1842, -1196, 820, -573,
+     400, -275, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 248, -353, 493,
+     -681, 942, -1333, 1995, -3466, 10652, 10138, -3281, 1843, -1196, 820, -573,
+     400, -275, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 248, -353, 493,
+     -681, 942, -1332, 1995, -3464, 10632, 10159, -3284, 1844, -1197, 821, -573,
+     400, -275, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 248, -353, 492,
+     -681, 942, -1332, 1994, -3462, 10612, 10179, -3286, 1845, -1197, 821, -573,
+     400, -275, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 248, -353, 492,
+     -680, 942, -1332, 1994, -3460, 10592, 10199, -3288, 1845, -1197, 821, -574,
+     400, -275, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 248, -353, 492,
+     -680, 942, -1332, 1993, -3458, 10572, 10220, -3291, 1846, -1198, 821, -574,
+     400, -275, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 248, -353, 492,
+     -680, 942, -1331, 1992, -3456, 10552, 10240, -3293, 1847, -1198, 821, -574,
+     400, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 248, -353, 492,
+     -680, 942, -1331, 1992, -3454, 10531, 10261, -3295, 1848, -1199, 822, -574,
+     400, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 248, -353, 492,
+     -680, 941, -1331, 1991, -3452, 10511, 10281, -3298, 1849, -1199, 822, -574,
+     401, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 248, -353, 492,
+     -680, 941, -1330, 1990, -3450, 10491, 10301, -3300, 1849, -1199, 822, -574,
+     401, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 248, -353, 492,
+     -680, 941, -1330, 1990, -3448, 10471, 10321, -3302, 1850, -1200, 822, -574,
+     401, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 247, -353, 492,
+     -680, 941, -1330, 1989, -3446, 10450, 10342, -3304, 1851, -1200, 822, -574,
+     401, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 247, -352, 492,
+     -680, 941, -1329, 1988, -3443, 10430, 10362, -3306, 1852, -1200, 823, -574,
+     401, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 247, -352, 492,
+     -680, 940, -1329, 1987, -3441, 10410, 10382, -3308, 1852, -1201, 823, -575,
+     401, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 247, -352, 492,
+     -679, 940, -1329, 1986, -3439, 10389, 10403, -3310, 1853, -1201, 823, -575,
+     401, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 247, -352, 492,
+     -679, 940, -1328, 1986, -3436, 10369, 10423, -3313, 1854, -1201, 823, -575,
+     401, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 247, -352, 492,
+     -679, 940, -1328, 1985, -3434, 10348, 10443, -3315, 1854, -1202, 823, -575,
+     401, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 247, -352, 492,
+     -679, 940, -1327, 1984, -3432, 10328, 10463, -3317, 1855, -1202, 823, -575,
+     401, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 247, -352, 492,
+     -679, 939, -1327, 1983, -3429, 10308, 10483, -3319, 1856, -1202, 823, -575,
+     401, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 247, -352, 491,
+     -679, 939, -1326, 1982, -3427, 10287, 10503, -3320, 1856, -1202, 824, -575,
+     401, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 247, -352, 491,
+     -679, 939, -1326, 1981, -3424, 10267, 10524, -3322, 1857, -1203, 824, -575,
+     401, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 247, -352, 491,
+     -678, 939, -1325, 1980, -3422, 10246, 10544, -3324, 1857, -1203, 824, -575,
+     401, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 247, -352, 491,
+     -678, 938, -1325, 1979, -3419, 10226, 10564, -3326, 1858, -1203, 824, -575,
+     401, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -169, 247, -352, 491,
+     -678, 938, -1324, 1978, -3417, 10205, 10584, -3328, 1858, -1203, 824, -575,
+     401, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -168, 247, -352, 491,
+     -678, 938, -1324, 1977, -3414, 10185, 10604, -3330, 1859, -1203, 824, -575,
+     401, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -168, 247, -352, 491,
+     -678, 937, -1323, 1976, -3412, 10164, 10624, -3332, 1859, -1204, 824, -575,
+     401, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -168, 247, -352, 491,
+     -677, 937, -1323, 1975, -3409, 10144, 10644, -3333, 1860, -1204, 824, -575,
+     401, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -168, 247, -351, 490,
+     -677, 937, -1322, 1974, -3406, 10123, 10664, -3335, 1860, -1204, 824, -575,
+     401, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 111, -168, 247, -351, 490,
+     -677, 936, -1322, 1973, -3404, 10102, 10684, -3337, 1861, -1204, 824, -575,
+     401, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 110, -168, 247, -351, 490,
+     -677, 936, -1321, 1972, -3401, 10082, 10704, -3338, 1861, -1204, 824, -575,
+     401, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 41, -69, 110, -168, 247, -351, 490,
+     -677, 936, -1321, 1971, -3398, 10061, 10724, -3340, 1862, -1204, 824, -575,
+     401, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 40, -69, 110, -168, 247, -351, 490,
+     -676, 935, -1320, 1970, -3395, 10040, 10744, -3342, 1862, -1204, 824, -575,
+     401, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 40, -69, 110, -168, 246, -351, 490,
+     -676, 935, -1319, 1969, -3393, 10020, 10763, -3343, 1862, -1205, 824, -575,
+     401, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 40, -69, 110, -168, 246, -351, 490,
+     -676, 935, -1319, 1968, -3390, 9999, 10783, -3345, 1863, -1205, 824, -575,
+     401, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 40, -69, 110, -168, 246, -351, 489,
+     -676, 934, -1318, 1967, -3387, 9978, 10803, -3346, 1863, -1205, 824, -575,
+     401, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 40, -69, 110, -168, 246, -351, 489,
+     -675, 934, -1318, 1966, -3384, 9958, 10823, -3348, 1863, -1205, 824, -575,
+     401, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 40, -69, 110, -168, 246, -351, 489,
+     -675, 933, -1317, 1964, -3381, 9937, 10843, -3349, 1864, -1205, 824, -575,
+     401, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 40, -69, 110, -168, 246, -350, 489,
+     -675, 933, -1316, 1963, -3378, 9916, 10863, -3351, 1864, -1205, 824, -575,
+     401, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 40, -69, 110, -168, 246, -350, 489,
+     -675, 933, -1316, 1962, -3375, 9895, 10882, -3352, 1864, -1205, 824, -575,
+     401, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 40, -69, 110, -168, 246, -350, 489,
+     -674, 932, -1315, 1961, -3372, 9875, 10902, -3353, 1864, -1205, 824, -575,
+     401, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 40, -69, 110, -168, 246, -350, 488,
+     -674, 932, -1314, 1959, -3369, 9854, 10922, -3355, 1865, -1205, 824, -575,
+     401, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 40, -69, 110, -168, 246, -350, 488,
+     -674, 931, -1313, 1958, -3366, 9833, 10942, -3356, 1865, -1205, 824, -575,
+     401, -276, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 11, -22, 40, -69, 110, -168, 246, -350, 488,
+     -673, 931, -1313, 1957, -3363, 9812, 10961, -3357, 1865, -1205, 824, -575,
+     401, -275, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -69, 110, -168, 246, -350, 488,
+     -673, 930, -1312, 1955, -3360, 9791, 10981, -3358, 1865, -1205, 824, -575,
+     401, -275, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -69, 110, -167, 245, -349, 487,
+     -673, 930, -1311, 1954, -3357, 9770, 11001, -3360, 1865, -1205, 824, -575,
+     401, -275, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -69, 110, -167, 245, -349, 487,
+     -672, 929, -1311, 1953, -3354, 9749, 11020, -3361, 1866, -1205, 824, -575,
+     401, -275, 185, -120, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -69, 110, -167, 245, -349, 487,
+     -672, 929, -1310, 1951, -3350, 9729, 11040, -3362, 1866, -1205, 824, -574,
+     400, -275, 185, -119, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -69, 110, -167, 245, -349, 487,
+     -672, 928, -1309, 1950, -3347, 9708, 11059, -3363, 1866, -1205, 824, -574,
+     400, -275, 185, -119, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -69, 110, -167, 245, -349, 487,
+     -671, 928, -1308, 1949, -3344, 9687, 11079, -3364, 1866, -1205, 824, -574,
+     400, -275, 185, -119, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -69, 110, -167, 245, -349, 486,
+     -671, 927, -1307, 1947, -3341, 9666, 11099, -3365, 1866, -1205, 823, -574,
+     400, -275, 184, -119, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -69, 110, -167, 245, -349, 486,
+     -671, 927, -1307, 1946, -3337, 9645, 11118, -3366, 1866, -1204, 823, -574,
+     400, -275, 184, -119, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -69, 110, -167, 245, -348, 486,
+     -670, 926, -1306, 1944, -3334, 9624, 11138, -3367, 1866, -1204, 823, -574,
+     400, -275, 184, -119, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -69, 110, -167, 245, -348, 486,
+     -670, 926, -1305, 1943, -3331, 9603, 11157, -3368, 1866, -1204, 823, -574,
+     400, -275, 184, -119, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -69, 110, -167, 244, -348, 485,
+     -670, 925, -1304, 1941, -3327, 9582, 11176, -3369, 1866, -1204, 823, -574,
+     400, -275, 184, -119, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -68, 110, -167, 244, -348, 485,
+     -669, 925, -1303, 1940, -3324, 9561, 11196, -3370, 1866, -1204, 823, -574,
+     400, -275, 184, -119, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -68, 109, -167, 244, -348, 485,
+     -669, 924, -1302, 1938, -3320, 9540, 11215, -3371, 1866, -1204, 823, -573,
+     400, -275, 184, -119, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -68, 109, -167, 244, -347, 485,
+     -669, 924, -1301, 1937, -3317, 9519, 11235, -3372, 1866, -1204, 822, -573,
+     399, -275, 184, -119, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -68, 109, -167, 244, -347, 484,
+     -668, 923, -1300, 1935, -3313, 9498, 11254, -3373, 1866, -1203, 822, -573,
+     399, -274, 184, -119, 74, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -68, 109, -166, 244, -347, 484,
+     -668, 922, -1300, 1934, -3310, 9477, 11273, -3373, 1866, -1203, 822, -573,
+     399, -274, 184, -119, 73, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -68, 109, -166, 244, -347, 484,
+     -667, 922, -1299, 1932, -3306, 9456, 11293, -3374, 1866, -1203, 822, -573,
+     399, -274, 184, -119, 73, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -68, 109, -166, 244, -347, 483,
+     -667, 921, -1298, 1930, -3303, 9434, 11312, -3375, 1866, -1203, 822, -573,
+     399, -274, 184, -119, 73, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -68, 109, -166, 243, -346, 483,
+     -666, 921, -1297, 1929, -3299, 9413, 11331, -3376, 1866, -1203, 821, -573,
+     399, -274, 184, -119, 73, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -68, 109, -166, 243, -346, 483,
+     -666, 920, -1296, 1927, -3296, 9392, 11350, -3376, 1865, -1202, 821, -572,
+     399, -274, 184, -119, 73, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -68, 109, -166, 243, -346, 483,
+     -666, 919, -1295, 1926, -3292, 9371, 11370, -3377, 1865, -1202, 821, -572,
+     399, -274, 184, -119, 73, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -68, 109, -166, 243, -346, 482,
+     -665, 919, -1294, 1924, -3288, 9350, 11389, -3378, 1865, -1202, 821, -572,
+     398, -274, 184, -119, 73, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -68, 109, -166, 243, -346, 482,
+     -665, 918, -1293, 1922, -3285, 9329, 11408, -3378, 1865, -1202, 821, -572,
+     398, -274, 183, -119, 73, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -68, 109, -166, 243, -345, 482,
+     -664, 917, -1292, 1920, -3281, 9308, 11427, -3379, 1865, -1201, 820, -572,
+     398, -274, 183, -119, 73, -43, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -68, 109, -166, 243, -345, 481,
+     -664, 917, -1291, 1919, -3277, 9286, 11446, -3379, 1864, -1201, 820, -571,
+     398, -273, 183, -119, 73, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -68, 109, -165, 242, -345, 481,
+     -663, 916, -1290, 1917, -3273, 9265, 11465, -3380, 1864, -1201, 820, -571,
+     398, -273, 183, -119, 73, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -68, 109, -165, 242, -345, 481,
+     -663, 915, -1289, 1915, -3269, 9244, 11485, -3380, 1864, -1200, 820, -571,
+     398, -273, 183, -119, 73, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -22, 40, -68, 109, -165, 242, -345, 480,
+     -662, 915, -1288, 1913, -3266, 9223, 11504, -3381, 1864, -1200, 819, -571,
+     398, -273, 183, -118, 73, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 40, -68, 108, -165, 242, -344, 480,
+     -662, 914, -1287, 1912, -3262, 9201, 11523, -3381, 1863, -1200, 819, -571,
+     397, -273, 183, -118, 73, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 40, -68, 108, -165, 242, -344, 480,
+     -661, 913, -1286, 1910, -3258, 9180, 11542, -3381, 1863, -1199, 819, -570,
+     397, -273, 183, -118, 73, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 40, -68, 108, -165, 242, -344, 479,
+     -661, 912, -1284, 1908, -3254, 9159, 11561, -3382, 1863, -1199, 818, -570,
+     397, -273, 183, -118, 73, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 40, -68, 108, -165, 241, -344, 479,
+     -660, 912, -1283, 1906, -3250, 9138, 11580, -3382, 1862, -1199, 818, -570,
+     397, -273, 183, -118, 73, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 40, -68, 108, -165, 241, -343, 479,
+     -660, 911, -1282, 1904, -3246, 9116, 11599, -3382, 1862, -1198, 818, -570,
+     397, -272, 183, -118, 73, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 40, -68, 108, -165, 241, -343, 478,
+     -659, 910, -1281, 1902, -3242, 9095, 11617, -3382, 1862, -1198, 817, -569,
+     396, -272, 183, -118, 73, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 40, -68, 108, -164, 241, -343, 478,
+     -659, 910, -1280, 1901, -3238, 9074, 11636, -3383, 1861, -1197, 817, -569,
+     396, -272, 182, -118, 73, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 40, -68, 108, -164, 241, -343, 478,
+     -658, 909, -1279, 1899, -3234, 9052, 11655, -3383, 1861, -1197, 817, -569,
+     396, -272, 182, -118, 73, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 40, -67, 108, -164, 241, -342, 477,
+     -658, 908, -1278, 1897, -3230, 9031, 11674, -3383, 1860, -1197, 816, -569,
+     396, -272, 182, -118, 73, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 40, -67, 108, -164, 240, -342, 477,
+     -657, 907, -1277, 1895, -3226, 9010, 11693, -3383, 1860, -1196, 816, -568,
+     396, -272, 182, -118, 73, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 40, -67, 108, -164, 240, -342, 476,
+     -657, 906, -1275, 1893, -3222, 8988, 11712, -3383, 1859, -1196, 816, -568,
+     395, -272, 182, -118, 73, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 40, -67, 108, -164, 240, -342, 476,
+     -656, 906, -1274, 1891, -3218, 8967, 11730, -3383, 1859, -1195, 815, -568,
+     395, -272, 182, -118, 73, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -67, 108, -164, 240, -341, 476,
+     -656, 905, -1273, 1889, -3213, 8946, 11749, -3383, 1858, -1195, 815, -567,
+     395, -271, 182, -118, 73, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -67, 108, -164, 240, -341, 475,
+     -655, 904, -1272, 1887, -3209, 8924, 11768, -3383, 1858, -1194, 815, -567,
+     395, -271, 182, -118, 73, -42, 23, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -67, 107, -164, 240, -341, 475,
+     -655, 903, -1271, 1885, -3205, 8903, 11787, -3383, 1857, -1194, 814, -567,
+     395, -271, 182, -117, 73, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -67, 107, -163, 239, -340, 474,
+     -654, 902, -1269, 1883, -3201, 8881, 11805, -3383, 1857, -1193, 814, -566,
+     394, -271, 182, -117, 72, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -67, 107, -163, 239, -340, 474,
+     -653, 902, -1268, 1881, -3196, 8860, 11824, -3383, 1856, -1193, 813, -566,
+     394, -271, 181, -117, 72, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -67, 107, -163, 239, -340, 474,
+     -653, 901, -1267, 1879, -3192, 8839, 11843, -3383, 1855, -1192, 813, -566,
+     394, -271, 181, -117, 72, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -67, 107, -163, 239, -340, 473,
+     -652, 900, -1265, 1877, -3188, 8817, 11861, -3382, 1855, -1192, 812, -566,
+     394, -270, 181, -117, 72, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -67, 107, -163, 239, -339, 473,
+     -652, 899, -1264, 1875, -3184, 8796, 11880, -3382, 1854, -1191, 812, -565,
+     393, -270, 181, -117, 72, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -67, 107, -163, 238, -339, 472,
+     -651, 898, -1263, 1872, -3179, 8774, 11898, -3382, 1853, -1190, 812, -565,
+     393, -270, 181, -117, 72, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -67, 107, -163, 238, -339, 472,
+     -651, 897, -1262, 1870, -3175, 8753, 11917, -3382, 1853, -1190, 811, -565,
+     393, -270, 181, -117, 72, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -67, 107, -162, 238, -338, 472,
+     -650, 896, -1260, 1868, -3170, 8731, 11935, -3381, 1852, -1189, 811, -564,
+     393, -270, 181, -117, 72, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -67, 107, -162, 238, -338, 471,
+     -649, 896, -1259, 1866, -3166, 8710, 11954, -3381, 1851, -1189, 810, -564,
+     392, -270, 181, -117, 72, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -67, 107, -162, 237, -338, 471,
+     -649, 895, -1258, 1864, -3161, 8688, 11972, -3381, 1851, -1188, 810, -564,
+     392, -269, 180, -117, 72, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -67, 106, -162, 237, -337, 470,
+     -648, 894, -1256, 1862, -3157, 8667, 11991, -3380, 1850, -1187, 809, -563,
+     392, -269, 180, -117, 72, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -67, 106, -162, 237, -337, 470,
+     -647, 893, -1255, 1859, -3152, 8645, 12009, -3380, 1849, -1187, 809, -563,
+     392, -269, 180, -117, 72, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -66, 106, -162, 237, -337, 469,
+     -647, 892, -1254, 1857, -3148, 8624, 12027, -3379, 1848, -1186, 808, -562,
+     391, -269, 180, -116, 72, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -66, 106, -162, 237, -337, 469,
+     -646, 891, -1252, 1855, -3143, 8602, 12046, -3379, 1847, -1186, 808, -562,
+     391, -269, 180, -116, 72, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -66, 106, -161, 236, -336, 468,
+     -645, 890, -1251, 1853, -3139, 8581, 12064, -3378, 1847, -1185, 807, -562,
+     391, -268, 180, -116, 72, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -66, 106, -161, 236, -336, 468,
+     -645, 889, -1249, 1850, -3134, 8559, 12082, -3378, 1846, -1184, 807, -561,
+     391, -268, 180, -116, 72, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -66, 106, -161, 236, -336, 468,
+     -644, 888, -1248, 1848, -3130, 8537, 12100, -3377, 1845, -1183, 806, -561,
+     390, -268, 180, -116, 72, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -66, 106, -161, 236, -335, 467,
+     -643, 887, -1247, 1846, -3125, 8516, 12119, -3377, 1844, -1183, 806, -560,
+     390, -268, 179, -116, 72, -42, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -66, 106, -161, 235, -335, 467,
+     -643, 886, -1245, 1843, -3120, 8494, 12137, -3376, 1843, -1182, 805, -560,
+     390, -268, 179, -116, 72, -41, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -66, 106, -161, 235, -335, 466,
+     -642, 885, -1244, 1841, -3115, 8473, 12155, -3375, 1842, -1181, 805, -560,
+     389, -267, 179, -116, 71, -41, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -66, 105, -160, 235, -334, 466,
+     -641, 884, -1242, 1839, -3111, 8451, 12173, -3374, 1841, -1181, 804, -559,
+     389, -267, 179, -116, 71, -41, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -66, 105, -160, 235, -334, 465,
+     -641, 883, -1241, 1836, -3106, 8429, 12191, -3374, 1840, -1180, 803, -559,
+     389, -267, 179, -116, 71, -41, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -66, 105, -160, 235, -334, 465,
+     -640, 882, -1239, 1834, -3101, 8408, 12209, -3373, 1839, -1179, 803, -558,
+     389, -267, 179, -116, 71, -41, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -66, 105, -160, 234, -333, 464,
+     -639, 881, -1238, 1832, -3096, 8386, 12227, -3372, 1838, -1178, 802, -558,
+     388, -266, 178, -115, 71, -41, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -66, 105, -160, 234, -333, 464,
+     -639, 880, -1236, 1829, -3092, 8364, 12245, -3371, 1837, -1177, 802, -558,
+     388, -266, 178, -115, 71, -41, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -66, 105, -160, 234, -332, 463,
+     -638, 879, -1235, 1827, -3087, 8343, 12263, -3370, 1836, -1177, 801, -557,
+     388, -266, 178, -115, 71, -41, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 39, -66, 105, -160, 234, -332, 463,
+     -637, 878, -1233, 1824, -3082, 8321, 12281, -3369, 1835, -1176, 800, -557,
+     387, -266, 178, -115, 71, -41, 22, -11, 4, -1, 0},
+    {0, 1, -4, 10, -21, 38, -66, 105, -159, 233, -332, 462,
+     -636, 877, -1232, 1822, -3077, 8299, 12299, -3368, 1834, -1175, 800, -556,
+     387, -266, 178, -115, 71, -41, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 38, -65, 105, -159, 233, -331, 462,
+     -636, 876, -1230, 1819, -3072, 8278, 12317, -3367, 1833, -1174, 799, -556,
+     387, -265, 178, -115, 71, -41, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 38, -65, 105, -159, 233, -331, 461,
+     -635, 875, -1229, 1817, -3067, 8256, 12335, -3366, 1832, -1173, 799, -555,
+     386, -265, 178, -115, 71, -41, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 38, -65, 104, -159, 233, -331, 460,
+     -634, 874, -1227, 1814, -3062, 8234, 12353, -3365, 1831, -1172, 798, -555,
+     386, -265, 177, -115, 71, -41, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 38, -65, 104, -159, 232, -330, 460,
+     -633, 873, -1225, 1812, -3057, 8213, 12371, -3364, 1830, -1172, 797, -554,
+     386, -265, 177, -115, 71, -41, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 38, -65, 104, -158, 232, -330, 459,
+     -633, 872, -1224, 1809, -3052, 8191, 12389, -3363, 1829, -1171, 797, -554,
+     385, -264, 177, -114, 71, -41, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 38, -65, 104, -158, 232, -329, 459,
+     -632, 871, -1222, 1807, -3047, 8169, 12406, -3362, 1827, -1170, 796, -553,
+     385, -264, 177, -114, 71, -41, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 38, -65, 104, -158, 231, -329, 458,
+     -631, 870, -1221, 1804, -3042, 8148, 12424, -3361, 1826, -1169, 795, -553,
+     385, -264, 177, -114, 70, -41, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 38, -65, 104, -158, 231, -329, 458,
+     -630, 869, -1219, 1802, -3037, 8126, 12442, -3359, 1825, -1168, 795, -552,
+     384, -264, 177, -114, 70, -41, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 38, -65, 104, -158, 231, -328, 457,
+     -630, 867, -1217, 1799, -3032, 8104, 12460, -3358, 1824, -1167, 794, -552,
+     384, -263, 176, -114, 70, -41, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 38, -65, 104, -158, 231, -328, 457,
+     -629, 866, -1216, 1796, -3027, 8082, 12477, -3357, 1823, -1166, 793, -551,
+     383, -263, 176, -114, 70, -41, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 38, -65, 103, -157, 230, -328, 456,
+     -628, 865, -1214, 1794, -3022, 8061, 12495, -3356, 1821, -1165, 793, -551,
+     383, -263, 176, -114, 70, -41, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -21, 38, -65, 103, -157, 230, -327, 456,
+     -627, 864, -1212, 1791, -3017, 8039, 12512, -3354, 1820, -1164, 792, -550,
+     383, -263, 176, -114, 70, -41, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 38, -65, 103, -157, 230, -327, 455,
+     -626, 863, -1211, 1788, -3011, 8017, 12530, -3353, 1819, -1163, 791, -550,
+     382, -262, 176, -114, 70, -41, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 38, -64, 103, -157, 230, -326, 454,
+     -626, 862, -1209, 1786, -3006, 7995, 12548, -3351, 1817, -1162, 790, -549,
+     382, -262, 175, -113, 70, -41, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 38, -64, 103, -157, 229, -326, 454,
+     -625, 861, -1207, 1783, -3001, 7974, 12565, -3350, 1816, -1161, 790, -549,
+     382, -262, 175, -113, 70, -41, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 38, -64, 103, -156, 229, -326, 453,
+     -624, 859, -1206, 1780, -2996, 7952, 12583, -3348, 1815, -1160, 789, -548,
+     381, -262, 175, -113, 70, -40, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 38, -64, 103, -156, 229, -325, 453,
+     -623, 858, -1204, 1778, -2990, 7930, 12600, -3347, 1813, -1159, 788, -548,
+     381, -261, 175, -113, 70, -40, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 38, -64, 103, -156, 228, -325, 452,
+     -622, 857, -1202, 1775, -2985, 7908, 12617, -3345, 1812, -1158, 787, -547,
+     380, -261, 175, -113, 70, -40, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 38, -64, 102, -156, 228, -324, 451,
+     -622, 856, -1201, 1772, -2980, 7886, 12635, -3344, 1811, -1157, 787, -547,
+     380, -261, 175, -113, 70, -40, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 38, -64, 102, -156, 228, -324, 451,
+     -621, 855, -1199, 1769, -2974, 7865, 12652, -3342, 1809, -1156, 786, -546,
+     380, -260, 174, -113, 70, -40, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 38, -64, 102, -155, 228, -323, 450,
+     -620, 854, -1197, 1767, -2969, 7843, 12670, -3340, 1808, -1155, 785, -545,
+     379, -260, 174, -113, 69, -40, 22, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 38, -64, 102, -155, 227, -323, 450,
+     -619, 852, -1195, 1764, -2964, 7821, 12687, -3339, 1806, -1154, 784, -545,
+     379, -260, 174, -112, 69, -40, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -64, 102, -155, 227, -323, 449,
+     -618, 851, -1193, 1761, -2958, 7799, 12704, -3337, 1805, -1153, 784, -544,
+     378, -260, 174, -112, 69, -40, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -64, 102, -155, 227, -322, 448,
+     -617, 850, -1192, 1758, -2953, 7777, 12721, -3335, 1803, -1152, 783, -544,
+     378, -259, 174, -112, 69, -40, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -64, 102, -155, 226, -322, 448,
+     -616, 849, -1190, 1755, -2947, 7756, 12739, -3333, 1802, -1151, 782, -543,
+     378, -259, 173, -112, 69, -40, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -64, 102, -154, 226, -321, 447,
+     -616, 847, -1188, 1752, -2942, 7734, 12756, -3332, 1800, -1150, 781, -543,
+     377, -259, 173, -112, 69, -40, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -63, 101, -154, 226, -321, 447,
+     -615, 846, -1186, 1750, -2936, 7712, 12773, -3330, 1799, -1148, 780, -542,
+     377, -258, 173, -112, 69, -40, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -63, 101, -154, 225, -320, 446,
+     -614, 845, -1184, 1747, -2931, 7690, 12790, -3328, 1797, -1147, 780, -541,
+     376, -258, 173, -112, 69, -40, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -63, 101, -154, 225, -320, 445,
+     -613, 844, -1183, 1744, -2925, 7668, 12807, -3326, 1796, -1146, 779, -541,
+     376, -258, 173, -112, 69, -40, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -63, 101, -154, 225, -319, 445,
+     -612, 842, -1181, 1741, -2920, 7646, 12824, -3324, 1794, -1145, 778, -540,
+     375, -258, 172, -111, 69, -40, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -63, 101, -153, 224, -319, 444,
+     -611, 841, -1179, 1738, -2914, 7625, 12841, -3322, 1792, -1144, 777, -540,
+     375, -257, 172, -111, 69, -40, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -63, 101, -153, 224, -319, 443,
+     -610, 840, -1177, 1735, -2909, 7603, 12858, -3320, 1791, -1143, 776, -539,
+     375, -257, 172, -111, 69, -40, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -63, 101, -153, 224, -318, 443,
+     -609, 839, -1175, 1732, -2903, 7581, 12875, -3318, 1789, -1141, 775, -538,
+     374, -257, 172, -111, 68, -40, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -63, 100, -153, 223, -318, 442,
+     -608, 837, -1173, 1729, -2897, 7559, 12892, -3316, 1787, -1140, 774, -538,
+     374, -256, 172, -111, 68, -40, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -63, 100, -153, 223, -317, 441,
+     -607, 836, -1171, 1726, -2892, 7537, 12909, -3314, 1786, -1139, 773, -537,
+     373, -256, 171, -111, 68, -40, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -63, 100, -152, 223, -317, 441,
+     -606, 835, -1169, 1723, -2886, 7515, 12926, -3311, 1784, -1138, 773, -536,
+     373, -256, 171, -111, 68, -40, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -63, 100, -152, 223, -316, 440,
+     -606, 833, -1168, 1720, -2880, 7493, 12943, -3309, 1782, -1136, 772, -536,
+     372, -255, 171, -110, 68, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -62, 100, -152, 222, -316, 439,
+     -605, 832, -1166, 1717, -2875, 7471, 12960, -3307, 1780, -1135, 771, -535,
+     372, -255, 171, -110, 68, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -62, 100, -152, 222, -315, 439,
+     -604, 831, -1164, 1714, -2869, 7450, 12976, -3305, 1779, -1134, 770, -534,
+     371, -255, 170, -110, 68, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -62, 100, -151, 222, -315, 438,
+     -603, 829, -1162, 1711, -2863, 7428, 12993, -3302, 1777, -1133, 769, -534,
+     371, -254, 170, -110, 68, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 37, -62, 99, -151, 221, -314, 437,
+     -602, 828, -1160, 1708, -2857, 7406, 13010, -3300, 1775, -1131, 768, -533,
+     370, -254, 170, -110, 68, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 10, -20, 36, -62, 99, -151, 221, -314, 437,
+     -601, 827, -1158, 1705, -2852, 7384, 13027, -3298, 1773, -1130, 767, -532,
+     370, -254, 170, -110, 68, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 9, -20, 36, -62, 99, -151, 221, -313, 436,
+     -600, 825, -1156, 1702, -2846, 7362, 13043, -3295, 1771, -1129, 766, -532,
+     369, -253, 170, -110, 68, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 9, -20, 36, -62, 99, -150, 220, -313, 435,
+     -599, 824, -1154, 1699, -2840, 7340, 13060, -3293, 1769, -1127, 765, -531,
+     369, -253, 169, -109, 67, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 9, -20, 36, -62, 99, -150, 220, -312, 435,
+     -598, 822, -1152, 1696, -2834, 7318, 13076, -3290, 1768, -1126, 764, -530,
+     368, -253, 169, -109, 67, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 9, -20, 36, -62, 99, -150, 219, -312, 434,
+     -597, 821, -1150, 1692, -2828, 7296, 13093, -3288, 1766, -1125, 763, -530,
+     368, -252, 169, -109, 67, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 9, -20, 36, -62, 98, -150, 219, -311, 433,
+     -596, 820, -1148, 1689, -2822, 7274, 13109, -3285, 1764, -1123, 762, -529,
+     367, -252, 169, -109, 67, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 9, -20, 36, -62, 98, -150, 219, -311, 432,
+     -595, 818, -1146, 1686, -2816, 7252, 13126, -3282, 1762, -1122, 761, -528,
+     367, -252, 168, -109, 67, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 9, -20, 36, -61, 98, -149, 218, -310, 432,
+     -594, 817, -1144, 1683, -2811, 7231, 13142, -3280, 1760, -1121, 760, -528,
+     366, -251, 168, -109, 67, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 9, -19, 36, -61, 98, -149, 218, -310, 431,
+     -593, 815, -1142, 1680, -2805, 7209, 13159, -3277, 1758, -1119, 759, -527,
+     366, -251, 168, -108, 67, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 9, -19, 36, -61, 98, -149, 218, -309, 430,
+     -592, 814, -1140, 1677, -2799, 7187, 13175, -3275, 1756, -1118, 758, -526,
+     365, -251, 168, -108, 67, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 9, -19, 36, -61, 98, -149, 217, -309, 430,
+     -591, 813, -1138, 1673, -2793, 7165, 13192, -3272, 1754, -1116, 757, -525,
+     365, -250, 167, -108, 67, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 9, -19, 36, -61, 98, -148, 217, -308, 429,
+     -590, 811, -1135, 1670, -2787, 7143, 13208, -3269, 1752, -1115, 756, -525,
+     364, -250, 167, -108, 67, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 9, -19, 36, -61, 97, -148, 217, -308, 428,
+     -589, 810, -1133, 1667, -2781, 7121, 13224, -3266, 1750, -1113, 755, -524,
+     364, -249, 167, -108, 66, -39, 21, -10, 4, -1, 0},
+    {0, 1, -4, 9, -19, 36, -61, 97, -148, 216, -307, 427,
+     -588, 808, -1131, 1664, -2775, 7099, 13240, -3263, 1748, -1112, 754, -523,
+     363, -249, 167, -108, 66, -38, 21, -10, 4, -1, 0},
+    {0, 1, -4, 9, -19, 36, -61, 97, -148, 216, -307, 427,
+     -587, 807, -1129, 1660, -2768, 7077, 13257, -3261, 1746, -1111, 753, -522,
+     363, -249, 166, -108, 66, -38, 21, -10, 4, -1, 0},
+    {0, 1, -4, 9, -19, 36, -61, 97, -147, 216, -306, 426,
+     -586, 805, -1127, 1657, -2762, 7055, 13273, -3258, 1744, -1109, 752, -522,
+     362, -248, 166, -107, 66, -38, 20, -10, 4, -1, 0},
+    {0, 1, -4, 9, -19, 36, -61, 97, -147, 215, -306, 425,
+     -585, 804, -1125, 1654, -2756, 7033, 13289, -3255, 1741, -1108, 751, -521,
+     362, -248, 166, -107, 66, -38, 20, -10, 4, -1, 0},
+    {0, 1, -4, 9, -19, 36, -60, 97, -147, 215, -305, 424,
+     -584, 802, -1123, 1651, -2750, 7011, 13305, -3252, 1739, -1106, 750, -520,
+     361, -248, 166, -107, 66, -38, 20, -10, 4, -1, 0},
+    {0, 1, -4, 9, -19, 35, -60, 96, -147, 214, -305, 424,
+     -583, 801, -1121, 1647, -2744, 6989, 13321, -3249, 1737, -1105, 749, -519,
+     361, -247, 165, -107, 66, -38, 20, -10, 4, -1, 0},
+    {0, 1, -4, 9, -19, 35, -60, 96, -146, 214, -304, 423,
+     -581, 799, -1118, 1644, -2738, 6967, 13337, -3246, 1735, -1103, 748, -519,
+     360, -247, 165, -107, 66, -38, 20, -10, 4, -1, 0},
+    {0, 1, -4, 9, -19, 35, -60, 96, -146, 214, -303, 422,
+     -580, 798, -1116, 1641, -2732, 6946, 13353, -3243, 1733, -1102, 747, -518,
+     360, -246, 165, -107, 66, -38, 20, -10, 4, -1, 0},
+    {0, 1, -4, 9, -19, 35, -60, 96, -146, 213, -303, 421,
+     -579, 796, -1114, 1637, -2725, 6924, 13369, -3239, 1731, -1100, 746, -517,
+     359, -246, 165, -106, 66, -38, 20, -10, 4, -1, 0},
+    {0, 1, -4, 9, -19, 35, -60, 96, -146, 213, -302, 421,
+     -578, 795, -1112, 1634, -2719, 6902, 13385, -3236, 1728, -1098, 744, -516,
+     358, -246, 164, -106, 65, -38, 20, -10, 4, -1, 0},
+    {0, 1, -4, 9, -19, 35, -60, 96, -145, 212, -302, 420,
+     -577, 793, -1110, 1630, -2713, 6880, 13401, -3233, 1726, -1097, 743, -515,
+     358, -245, 164, -106, 65, -38, 20, -10, 4, -1, 0},
+    {0, 1, -4, 9, -19, 35, -60, 95, -145, 212, -301, 419,
+     -576, 792, -1108, 1627, -2707, 6858, 13417, -3230, 1724, -1095, 742, -515,
+     357, -245, 164, -106, 65, -38, 20, -10, 4, -1, 0},
+    {0, 1, -4, 9, -19, 35, -60, 95, -145, 212, -301, 418,
+     -575, 790, -1105, 1624, -2700, 6836, 13433, -3227, 1722, -1094, 741, -514,
+     357, -244, 164, -106, 65, -38, 20, -10, 4, -1, 0},
+    {0, 1, -4, 9, -19, 35, -59, 95, -144, 211, -300, 417,
+     -574, 789, -1103, 1620, -2694, 6814, 13449, -3223, 1719, -1092, 740, -513,
+     356, -244, 163, -105, 65, -38, 20, -10, 4, -1, 0},
+    {0, 1, -4, 9, -19, 35, -59, 95, -144, 211, -300, 417,
+     -573, 787, -1101, 1617, -2688, 6792, 13465, -3220, 1717, -1090, 739, -512,
+     356, -244, 163, -105, 65, -38, 20, -10, 4, -1, 0},
+    {0, 1, -4, 9, -19, 35, -59, 95, -144, 211, -299, 416,
+     -572, 786, -1099, 1613, -2682, 6770, 13480, -3217, 1715, -1089, 738, -511,
+     355, -243, 163, -105, 65, -38, 20, -10, 4, -1, 0},
+    {0, 1, -4, 9, -19, 35, -59, 95, -144, 210, -298, 415,
+     -571, 784, -1096, 1610, -2675, 6748, 13496, -3213, 1712, -1087, 737, -511,
+     354, -243, 162, -105, 65, -37, 20, -10, 4, -1, 0},
+    {0, 1, -4, 9, -19, 35, -59, 94, -143, 210, -298, 414,
+     -569, 783, -1094, 1606, -2669, 6726, 13512, -3210, 1710, -1086, 735, -510,
+     354, -242, 162, -105, 65, -37, 20, -10, 4, -1, 0},
+    {0, 1, -4, 9, -19, 35, -59, 94, -143, 209, -297, 413,
+     -568, 781, -1092, 1603, -2662, 6704, 13527, -3206, 1708, -1084, 734, -509,
+     353, -242, 162, -105, 64, -37, 20, -10, 4, -1, 0},
+    {0, 1, -4, 9, -19, 35, -59, 94, -143, 209, -297, 413,
+     -567, 779, -1090, 1599, -2656, 6682, 13543, -3203, 1705, -1082, 733, -508,
+     353, -242, 162, -104, 64, -37, 20, -10, 4, -1, 0},
+    {0, 1, -4, 9, -19, 35, -59, 94, -143, 209, -296, 412,
+     -566, 778, -1087, 1596, -2650, 6660, 13559, -3199, 1703, -1081, 732, -507,
+     352, -241, 161, -104, 64, -37, 20, -9, 4, -1, 0},
+    {0, 1, -4, 9, -19, 34, -59, 94, -142, 208, -296, 411,
+     -565, 776, -1085, 1592, -2643, 6638, 13574, -3196, 1700, -1079, 731, -506,
+     351, -241, 161, -104, 64, -37, 20, -9, 4, -1, 0},
+    {0, 1, -4, 9, -19, 34, -58, 93, -142, 208, -295, 410,
+     -564, 775, -1083, 1589, -2637, 6616, 13590, -3192, 1698, -1077, 729, -505,
+     351, -240, 161, -104, 64, -37, 20, -9, 4, -1, 0},
+    {0, 1, -4, 9, -19, 34, -58, 93, -142, 207, -294, 409,
+     -563, 773, -1080, 1585, -2630, 6595, 13605, -3188, 1695, -1075, 728, -505,
+     350, -240, 160, -104, 64, -37, 20, -9, 4, -1, 0},
+    {0, 1, -4, 9, -19, 34, -58, 93, -141, 207, -294, 409,
+     -561, 771, -1078, 1582, -2624, 6573, 13620, -3185, 1693, -1074, 727, -504,
+     350, -240, 160, -103, 64, -37, 20, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 34, -58, 93, -141, 207, -293, 408,
+     -560, 770, -1076, 1578, -2617, 6551, 13636, -3181, 1690, -1072, 726, -503,
+     349, -239, 160, -103, 64, -37, 20, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 34, -58, 93, -141, 206, -293, 407,
+     -559, 768, -1073, 1575, -2611, 6529, 13651, -3177, 1688, -1070, 725, -502,
+     348, -239, 160, -103, 64, -37, 20, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 34, -58, 93, -141, 206, -292, 406,
+     -558, 767, -1071, 1571, -2604, 6507, 13667, -3174, 1685, -1069, 723, -501,
+     348, -238, 159, -103, 63, -37, 20, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 34, -58, 92, -140, 205, -291, 405,
+     -557, 765, -1069, 1567, -2598, 6485, 13682, -3170, 1683, -1067, 722, -500,
+     347, -238, 159, -103, 63, -37, 20, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 34, -58, 92, -140, 205, -291, 404,
+     -556, 763, -1066, 1564, -2591, 6463, 13697, -3166, 1680, -1065, 721, -499,
+     346, -237, 159, -103, 63, -37, 20, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 34, -58, 92, -140, 204, -290, 404,
+     -554, 762, -1064, 1560, -2584, 6441, 13712, -3162, 1677, -1063, 720, -498,
+     346, -237, 158, -102, 63, -37, 20, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 34, -57, 92, -139, 204, -290, 403,
+     -553, 760, -1062, 1556, -2578, 6419, 13728, -3158, 1675, -1061, 718, -498,
+     345, -236, 158, -102, 63, -36, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 34, -57, 92, -139, 204, -289, 402,
+     -552, 758, -1059, 1553, -2571, 6397, 13743, -3154, 1672, -1060, 717, -497,
+     345, -236, 158, -102, 63, -36, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 34, -57, 91, -139, 203, -288, 401,
+     -551, 757, -1057, 1549, -2565, 6375, 13758, -3150, 1669, -1058, 716, -496,
+     344, -236, 158, -102, 63, -36, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 34, -57, 91, -139, 203, -288, 400,
+     -550, 755, -1054, 1545, -2558, 6353, 13773, -3146, 1667, -1056, 714, -495,
+     343, -235, 157, -102, 63, -36, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 33, -57, 91, -138, 202, -287, 399,
+     -548, 753, -1052, 1542, -2551, 6331, 13788, -3142, 1664, -1054, 713, -494,
+     343, -235, 157, -101, 62, -36, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 33, -57, 91, -138, 202, -287, 398,
+     -547, 752, -1050, 1538, -2545, 6310, 13803, -3138, 1661, -1052, 712, -493,
+     342, -234, 157, -101, 62, -36, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 33, -57, 91, -138, 201, -286, 397,
+     -546, 750, -1047, 1534, -2538, 6288, 13818, -3134, 1659, -1050, 710, -492,
+     341, -234, 156, -101, 62, -36, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 33, -57, 90, -137, 201, -285, 397,
+     -545, 748, -1045, 1531, -2531, 6266, 13833, -3129, 1656, -1048, 709, -491,
+     341, -233, 156, -101, 62, -36, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 33, -57, 90, -137, 201, -285, 396,
+     -544, 746, -1042, 1527, -2524, 6244, 13848, -3125, 1653, -1047, 708, -490,
+     340, -233, 156, -101, 62, -36, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 33, -56, 90, -137, 200, -284, 395,
+     -542, 745, -1040, 1523, -2518, 6222, 13863, -3121, 1650, -1045, 706, -489,
+     339, -232, 155, -100, 62, -36, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 33, -56, 90, -137, 200, -283, 394,
+     -541, 743, -1037, 1519, -2511, 6200, 13877, -3117, 1648, -1043, 705, -488,
+     339, -232, 155, -100, 62, -36, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 33, -56, 90, -136, 199, -283, 393,
+     -540, 741, -1035, 1515, -2504, 6178, 13892, -3112, 1645, -1041, 704, -487,
+     338, -231, 155, -100, 62, -36, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 33, -56, 89, -136, 199, -282, 392,
+     -539, 740, -1032, 1512, -2497, 6156, 13907, -3108, 1642, -1039, 702, -486,
+     337, -231, 154, -100, 61, -36, 19, -9, 4, -1, 0},
+    {0, 1, -4, 9, -18, 33, -56, 89, -136, 198, -281, 391,
+     -537, 738, -1030, 1508, -2490, 6134, 13922, -3104, 1639, -1037, 701, -485,
+     337, -231, 154, -100, 61, -36, 19, -9, 4, -1, 0},
+    {0, 1, -3, 9, -18, 33, -56, 89, -135, 198, -281, 390,
+     -536, 736, -1027, 1504, -2484, 6112, 13936, -3099, 1636, -1035, 700, -484,
+     336, -230, 154, -99, 61, -35, 19, -9, 4, -1, 0},
+    {0, 1, -3, 9, -18, 33, -56, 89, -135, 197, -280, 389,
+     -535, 734, -1025, 1500, -2477, 6091, 13951, -3095, 1633, -1033, 698, -483,
+     335, -230, 153, -99, 61, -35, 19, -9, 4, -1, 0},
+    {0, 1, -3, 9, -18, 33, -56, 89, -135, 197, -280, 389,
+     -534, 733, -1022, 1496, -2470, 6069, 13966, -3090, 1630, -1031, 697, -482,
+     335, -229, 153, -99, 61, -35, 19, -9, 4, -1, 0},
+    {0, 1, -3, 8, -18, 33, -55, 88, -134, 196, -279, 388,
+     -532, 731, -1020, 1493, -2463, 6047, 13980, -3086, 1627, -1029, 696, -481,
+     334, -229, 153, -99, 61, -35, 19, -9, 4, -1, 0},
+    {0, 1, -3, 8, -18, 32, -55, 88, -134, 196, -278, 387,
+     -531, 729, -1017, 1489, -2456, 6025, 13995, -3081, 1624, -1027, 694, -480,
+     333, -228, 153, -98, 61, -35, 19, -9, 4, -1, 0},
+    {0, 1, -3, 8, -18, 32, -55, 88, -134, 196, -278, 386,
+     -530, 727, -1015, 1485, -2449, 6003, 14009, -3076, 1621, -1025, 693, -479,
+     332, -228, 152, -98, 61, -35, 19, -9, 4, -1, 0},
+    {0, 1, -3, 8, -17, 32, -55, 88, -133, 195, -277, 385,
+     -529, 725, -1012, 1481, -2442, 5981, 14024, -3072, 1619, -1023, 691, -478,
+     332, -227, 152, -98, 60, -35, 19, -9, 4, -1, 0},
+    {0, 1, -3, 8, -17, 32, -55, 88, -133, 195, -276, 384,
+     -527, 724, -1010, 1477, -2435, 5959, 14038, -3067, 1615, -1021, 690, -477,
+     331, -227, 152, -98, 60, -35, 19, -9, 4, -1, 0},
+    {0, 1, -3, 8, -17, 32, -55, 87, -133, 194, -276, 383,
+     -526, 722, -1007, 1473, -2428, 5937, 14052, -3062, 1612, -1019, 688, -476,
+     330, -226, 151, -98, 60, -35, 19, -9, 4, -1, 0},
+    {0, 1, -3, 8, -17, 32, -55, 87, -133, 194, -275, 382,
+     -525, 720, -1005, 1469, -2421, 5916, 14067, -3058, 1609, -1017, 687, -475,
+     330, -226, 151, -97, 60, -35, 19, -9, 4, -1, 0},
+    {0, 1, -3, 8, -17, 32, -54, 87, -132, 193, -274, 381,
+     -523, 718, -1002, 1465, -2414, 5894, 14081, -3053, 1606, -1015, 686, -474,
+     329, -225, 151, -97, 60, -35, 19, -9, 4, -1, 0},
+    {0, 1, -3, 8, -17, 32, -54, 87, -132, 193, -274, 380,
+     -522, 716, -999, 1461, -2407, 5872, 14095, -3048, 1603, -1013, 684, -473,
+     328, -225, 150, -97, 60, -35, 18, -9, 4, -1, 0},
+    {0, 1, -3, 8, -17, 32, -54, 87, -132, 192, -273, 379,
+     -521, 715, -997, 1457, -2400, 5850, 14110, -3043, 1600, -1011, 683, -472,
+     327, -224, 150, -97, 60, -35, 18, -9, 4, -1, 0},
+    {0, 1, -3, 8, -17, 32, -54, 86, -131, 192, -272, 378,
+     -519, 713, -994, 1453, -2393, 5828, 14124, -3038, 1597, -1009, 681, -471,
+     327, -224, 150, -97, 59, -34, 18, -9, 4, -1, 0},
+    {0, 1, -3, 8, -17, 32, -54, 86, -131, 191, -272, 377,
+     -518, 711, -991, 1449, -2386, 5806, 14138, -3033, 1594, -1006, 680, -470,
+     326, -223, 149, -96, 59, -34, 18, -9, 4, -1, 0},
+    {0, 1, -3, 8, -17, 32, -54, 86, -131, 191, -271, 376,
+     -517, 709, -989, 1445, -2379, 5785, 14152, -3028, 1591, -1004, 678, -469,
+     325, -223, 149, -96, 59, -34, 18, -9, 4, -1, 0},
+    {0, 1, -3, 8, -17, 32, -54, 86, -130, 190, -270, 375,
+     -515, 707, -986, 1441, -2372, 5763, 14166, -3023, 1588, -1002, 677, -468,
+     325, -222, 148, -96, 59, -34, 18, -9, 4, -1, 0},
+    {0, 1, -3, 8, -17, 31, -54, 86, -130, 190, -270, 375,
+     -514, 705, -984, 1437, -2365, 5741, 14180, -3018, 1584, -1000, 675, -467,
+     324, -222, 148, -96, 59, -34, 18, -9, 4, -1, 0},
+    {0, 1, -3, 8, -17, 31, -53, 85, -130, 189, -269, 374,
+     -513, 703, -981, 1433, -2358, 5719, 14194, -3013, 1581, -998, 674, -466,
+     323, -221, 148, -95, 59, -34, 18, -9, 4, -1, 0},
+    {0, 1, -3, 8, -17, 31, -53, 85, -129, 189, -268, 373,
+     -511, 702, -978, 1429, -2351, 5697, 14208, -3008, 1578, -996, 672, -465,
+     322, -221, 147, -95, 59, -34, 18, -9, 4, -1, 0},
+    {0, 1, -3, 8, -17, 31, -53, 85, -129, 188, -267, 372,
+     -510, 700, -976, 1425, -2344, 5675, 14222, -3003, 1575, -994, 671, -464,
+     322, -220, 147, -95, 58, -34, 18, -9, 3, -1, 0},
+    {0, 1, -3, 8, -17, 31, -53, 85, -129, 188, -267, 371,
+     -509, 698, -973, 1421, -2337, 5654, 14236, -2998, 1572, -991, 669, -463,
+     321, -220, 147, -95, 58, -34, 18, -9, 3, -1, 0},
+    {0, 1, -3, 8, -17, 31, -53, 84, -128, 188, -266, 370,
+     -507, 696, -970, 1417, -2329, 5632, 14250, -2993, 1568, -989, 668, -462,
+     320, -219, 146, -94, 58, -34, 18, -9, 3, -1, 0},
+    {0, 1, -3, 8, -17, 31, -53, 84, -128, 187, -265, 369,
+     -506, 694, -968, 1413, -2322, 5610, 14264, -2987, 1565, -987, 666, -461,
+     319, -219, 146, -94, 58, -34, 18, -9, 3, -1, 0},
+    {0, 1, -3, 8, -17, 31, -53, 84, -128, 187, -265, 368,
+     -505, 692, -965, 1409, -2315, 5588, 14277, -2982, 1562, -985, 665, -460,
+     319, -218, 146, -94, 58, -34, 18, -9, 3, -1, 0},
+    {0, 1, -3, 8, -17, 31, -52, 84, -127, 186, -264, 367,
+     -503, 690, -962, 1405, -2308, 5567, 14291, -2977, 1558, -983, 663, -459,
+     318, -217, 145, -94, 58, -33, 18, -9, 3, -1, 0},
+    {0, 1, -3, 8, -17, 31, -52, 84, -127, 186, -263, 366,
+     -502, 688, -959, 1401, -2301, 5545, 14305, -2971, 1555, -980, 662, -457,
+     317, -217, 145, -94, 58, -33, 18, -8, 3, -1, 0},
+    {0, 1, -3, 8, -17, 31, -52, 83, -127, 185, -263, 365,
+     -501, 686, -957, 1397, -2293, 5523, 14318, -2966, 1552, -978, 660, -456,
+     316, -216, 145, -93, 57, -33, 18, -8, 3, -1, 0},
+    {0, 1, -3, 8, -17, 31, -52, 83, -126, 185, -262, 364,
+     -499, 685, -954, 1393, -2286, 5501, 14332, -2960, 1548, -976, 658, -455,
+     315, -216, 144, -93, 57, -33, 18, -8, 3, -1, 0},
+    {0, 1, -3, 8, -17, 31, -52, 83, -126, 184, -261, 363,
+     -498, 683, -951, 1389, -2279, 5479, 14346, -2955, 1545, -974, 657, -454,
+     315, -215, 144, -93, 57, -33, 18, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 30, -52, 83, -126, 184, -260, 362,
+     -496, 681, -949, 1384, -2272, 5458, 14359, -2949, 1542, -971, 655, -453,
+     314, -215, 144, -93, 57, -33, 18, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 30, -52, 82, -125, 183, -260, 361,
+     -495, 679, -946, 1380, -2264, 5436, 14373, -2944, 1538, -969, 654, -452,
+     313, -214, 143, -92, 57, -33, 18, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 30, -52, 82, -125, 183, -259, 360,
+     -494, 677, -943, 1376, -2257, 5414, 14386, -2938, 1535, -967, 652, -451,
+     312, -214, 143, -92, 57, -33, 18, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 30, -51, 82, -125, 182, -258, 359,
+     -492, 675, -940, 1372, -2250, 5393, 14400, -2933, 1531, -964, 650, -450,
+     311, -213, 142, -92, 57, -33, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 30, -51, 82, -124, 182, -258, 358,
+     -491, 673, -937, 1368, -2242, 5371, 14413, -2927, 1528, -962, 649, -448,
+     311, -213, 142, -92, 56, -33, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 30, -51, 82, -124, 181, -257, 357,
+     -489, 671, -935, 1364, -2235, 5349, 14426, -2921, 1524, -960, 647, -447,
+     310, -212, 142, -91, 56, -33, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 30, -51, 81, -124, 181, -256, 356,
+     -488, 669, -932, 1359, -2228, 5327, 14440, -2916, 1521, -957, 646, -446,
+     309, -211, 141, -91, 56, -33, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 30, -51, 81, -123, 180, -255, 355,
+     -487, 667, -929, 1355, -2220, 5306, 14453, -2910, 1517, -955, 644, -445,
+     308, -211, 141, -91, 56, -32, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 30, -51, 81, -123, 179, -255, 354,
+     -485, 665, -926, 1351, -2213, 5284, 14466, -2904, 1514, -953, 642, -444,
+     307, -210, 141, -91, 56, -32, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 30, -51, 81, -122, 179, -254, 353,
+     -484, 663, -923, 1347, -2206, 5262, 14479, -2898, 1510, -950, 641, -443,
+     307, -210, 140, -90, 56, -32, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 30, -50, 80, -122, 178, -253, 352,
+     -482, 661, -921, 1342, -2198, 5241, 14492, -2892, 1506, -948, 639, -442,
+     306, -209, 140, -90, 56, -32, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 30, -50, 80, -122, 178, -252, 351,
+     -481, 659, -918, 1338, -2191, 5219, 14505, -2886, 1503, -946, 637, -440,
+     305, -209, 139, -90, 55, -32, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 29, -50, 80, -121, 177, -252, 349,
+     -479, 657, -915, 1334, -2183, 5197, 14518, -2880, 1499, -943, 636, -439,
+     304, -208, 139, -90, 55, -32, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 29, -50, 80, -121, 177, -251, 348,
+     -478, 655, -912, 1330, -2176, 5176, 14532, -2874, 1496, -941, 634, -438,
+     303, -208, 139, -89, 55, -32, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 29, -50, 79, -121, 176, -250, 347,
+     -477, 653, -909, 1325, -2168, 5154, 14544, -2868, 1492, -938, 632, -437,
+     303, -207, 138, -89, 55, -32, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 29, -50, 79, -120, 176, -249, 346,
+     -475, 651, -906, 1321, -2161, 5132, 14557, -2862, 1488, -936, 631, -436,
+     302, -206, 138, -89, 55, -32, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 29, -49, 79, -120, 175, -249, 345,
+     -474, 649, -904, 1317, -2154, 5111, 14570, -2856, 1485, -933, 629, -435,
+     301, -206, 137, -89, 55, -32, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 29, -49, 79, -120, 175, -248, 344,
+     -472, 647, -901, 1313, -2146, 5089, 14583, -2850, 1481, -931, 627, -433,
+     300, -205, 137, -88, 54, -32, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 29, -49, 79, -119, 174, -247, 343,
+     -471, 645, -898, 1308, -2139, 5068, 14596, -2844, 1477, -929, 626, -432,
+     299, -205, 137, -88, 54, -31, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 29, -49, 78, -119, 174, -246, 342,
+     -469, 643, -895, 1304, -2131, 5046, 14609, -2838, 1473, -926, 624, -431,
+     298, -204, 136, -88, 54, -31, 17, -8, 3, -1, 0},
+    {0, 1, -3, 8, -16, 29, -49, 78, -119, 173, -246, 341,
+     -468, 641, -892, 1300, -2123, 5024, 14621, -2831, 1470, -924, 622, -430,
+     298, -204, 136, -88, 54, -31, 17, -8, 3, -1, 0},
+    {0, 1, -3, 7, -15, 29, -49, 78, -118, 173, -245, 340,
+     -466, 639, -889, 1295, -2116, 5003, 14634, -2825, 1466, -921, 620, -429,
+     297, -203, 136, -87, 54, -31, 17, -8, 3, -1, 0},
+    {0, 1, -3, 7, -15, 29, -49, 78, -118, 172, -244, 339,
+     -465, 637, -886, 1291, -2108, 4981, 14647, -2819, 1462, -919, 619, -427,
+     296, -202, 135, -87, 54, -31, 17, -8, 3, -1, 0},
+    {0, 1, -3, 7, -15, 28, -48, 77, -117, 172, -243, 338,
+     -463, 635, -883, 1286, -2101, 4960, 14659, -2812, 1458, -916, 617, -426,
+     295, -202, 135, -87, 54, -31, 17, -8, 3, -1, 0},
+    {0, 1, -3, 7, -15, 28, -48, 77, -117, 171, -243, 337,
+     -462, 633, -880, 1282, -2093, 4938, 14672, -2806, 1454, -913, 615, -425,
+     294, -201, 134, -87, 53, -31, 16, -8, 3, -1, 0},
+    {0, 1, -3, 7, -15, 28, -48, 77, -117, 170, -242, 336,
+     -460, 631, -878, 1278, -2086, 4917, 14685, -2800, 1451, -911, 613, -424,
+     293, -201, 134, -86, 53, -31, 16, -8, 3, -1, 0},
+    {0, 1, -3, 7, -15, 28, -48, 77, -116, 170, -241, 335,
+     -459, 629, -875, 1273, -2078, 4895, 14697, -2793, 1447, -908, 612, -422,
+     292, -200, 134, -86, 53, -31, 16, -8, 3, -1, 0},
+    {0, 1, -3, 7, -15, 28, -48, 76, -116, 169, -240, 334,
+     -457, 627, -872, 1269, -2070, 4873, 14709, -2787, 1443, -906, 610, -421,
+     292, -199, 133, -86, 53, -31, 16, -8, 3, -1, 0},
+    {0, 1, -3, 7, -15, 28, -48, 76, -116, 169, -239, 332,
+     -456, 624, -869, 1265, -2063, 4852, 14722, -2780, 1439, -903, 608, -420,
+     291, -199, 133, -86, 53, -31, 16, -8, 3, -1, 0},
+    {0, 1, -3, 7, -15, 28, -48, 76, -115, 168, -239, 331,
+     -454, 622, -866, 1260, -2055, 4830, 14734, -2773, 1435, -901, 606, -419,
+     290, -198, 132, -85, 53, -30, 16, -8, 3, -1, 0},
+    {0, 1, -3, 7, -15, 28, -47, 76, -115, 168, -238, 330,
+     -453, 620, -863, 1256, -2048, 4809, 14747, -2767, 1431, -898, 605, -417,
+     289, -198, 132, -85, 52, -30, 16, -8, 3, -1, 0},
+    {0, 1, -3, 7, -15, 28, -47, 75, -114, 167, -237, 329,
+     -451, 618, -860, 1251, -2040, 4787, 14759, -2760, 1427, -896, 603, -416,
+     288, -197, 132, -85, 52, -30, 16, -8, 3, -1, 0},
+    {0, 1, -3, 7, -15, 28, -47, 75, -114, 167, -236, 328,
+     -450, 616, -857, 1247, -2032, 4766, 14771, -2753, 1423, -893, 601, -415,
+     287, -196, 131, -85, 52, -30, 16, -8, 3, -1, 0},
+    {0, 1, -3, 7, -15, 28, -47, 75, -114, 166, -236, 327,
+     -448, 614, -854, 1242, -2025, 4745, 14783, -2747, 1419, -890, 599, -414,
+     286, -196, 131, -84, 52, -30, 16, -8, 3, -1, 0},
+    {0, 1, -3, 7, -15, 27, -47, 75, -113, 166, -235, 326,
+     -447, 612, -851, 1238, -2017, 4723, 14795, -2740, 1415, -888, 597, -412,
+     285, -195, 130, -84, 52, -30, 16, -8, 3, -1, 0},
+    {0, 1, -3, 7, -15, 27, -47, 74, -113, 165, -234, 325,
+     -445, 610, -848, 1233, -2009, 4702, 14808, -2733, 1411, -885, 596, -411,
+     284, -195, 130, -84, 52, -30, 16, -8, 3, -1, 0},
+    {0, 1, -3, 7, -15, 27, -46, 74, -113, 164, -233, 324,
+     -444, 608, -845, 1229, -2002, 4680, 14820, -2726, 1407, -882, 594, -410,
+     284, -194, 129, -84, 51, -30, 16, -8, 3, -1, 0},
+    {0, 1, -3, 7, -15, 27, -46, 74, -112, 164, -232, 323,
+     -442, 605, -842, 1224, -1994, 4659, 14832, -2719, 1403, -880, 592, -409,
+     283, -193, 129, -83, 51, -30, 16, -8, 3, -1, 0},
+    {0, 1, -3, 7, -15, 27, -46, 74, -112, 163, -232, 321,
+     -441, 603, -839, 1220, -1986, 4637, 14844, -2713, 1399, -877, 590, -407,
+     282, -193, 129, -83, 51, -30, 16, -8, 3, -1, 0},
+    {0, 1, -3, 7, -15, 27, -46, 73, -111, 163, -231, 320,
+     -439, 601, -836, 1215, -1978, 4616, 14856, -2706, 1395, -874, 588, -406,
+     281, -192, 128, -83, 51, -29, 16, -7, 3, -1, 0},
+    {0, 1, -3, 7, -15, 27, -46, 73, -111, 162, -230, 319,
+     -438, 599, -833, 1211, -1971, 4594, 14867, -2699, 1391, -872, 586, -405,
+     280, -191, 128, -82, 51, -29, 16, -7, 3, -1, 0},
+    {0, 1, -3, 7, -15, 27, -46, 73, -111, 162, -229, 318,
+     -436, 597, -830, 1206, -1963, 4573, 14879, -2692, 1387, -869, 584, -403,
+     279, -191, 127, -82, 51, -29, 16, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 27, -46, 73, -110, 161, -228, 317,
+     -434, 595, -827, 1202, -1955, 4552, 14891, -2685, 1383, -866, 583, -402,
+     278, -190, 127, -82, 50, -29, 16, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 27, -45, 72, -110, 161, -228, 316,
+     -433, 593, -824, 1197, -1947, 4530, 14903, -2677, 1379, -864, 581, -401,
+     277, -190, 127, -82, 50, -29, 16, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 27, -45, 72, -109, 160, -227, 315,
+     -431, 590, -821, 1193, -1940, 4509, 14915, -2670, 1374, -861, 579, -399,
+     276, -189, 126, -81, 50, -29, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 26, -45, 72, -109, 159, -226, 314,
+     -430, 588, -818, 1188, -1932, 4488, 14926, -2663, 1370, -858, 577, -398,
+     275, -188, 126, -81, 50, -29, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 26, -45, 72, -109, 159, -225, 312,
+     -428, 586, -815, 1184, -1924, 4466, 14938, -2656, 1366, -855, 575, -397,
+     274, -188, 125, -81, 50, -29, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 26, -45, 71, -108, 158, -224, 311,
+     -427, 584, -811, 1179, -1916, 4445, 14950, -2649, 1362, -853, 573, -395,
+     274, -187, 125, -81, 50, -29, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 26, -45, 71, -108, 158, -223, 310,
+     -425, 582, -808, 1174, -1908, 4424, 14961, -2641, 1358, -850, 571, -394,
+     273, -186, 124, -80, 49, -29, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 26, -44, 71, -108, 157, -223, 309,
+     -423, 580, -805, 1170, -1900, 4402, 14973, -2634, 1353, -847, 569, -393,
+     272, -186, 124, -80, 49, -28, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 26, -44, 71, -107, 156, -222, 308,
+     -422, 577, -802, 1165, -1893, 4381, 14984, -2627, 1349, -844, 567, -391,
+     271, -185, 124, -80, 49, -28, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 26, -44, 70, -107, 156, -221, 307,
+     -420, 575, -799, 1161, -1885, 4360, 14996, -2619, 1345, -841, 566, -390,
+     270, -184, 123, -79, 49, -28, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 26, -44, 70, -106, 155, -220, 306,
+     -419, 573, -796, 1156, -1877, 4339, 15007, -2612, 1340, -839, 564, -389,
+     269, -184, 123, -79, 49, -28, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 26, -44, 70, -106, 155, -219, 304,
+     -417, 571, -793, 1151, -1869, 4317, 15018, -2604, 1336, -836, 562, -387,
+     268, -183, 122, -79, 49, -28, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 26, -44, 70, -106, 154, -219, 303,
+     -415, 569, -790, 1147, -1861, 4296, 15030, -2597, 1332, -833, 560, -386,
+     267, -182, 122, -79, 48, -28, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 26, -43, 69, -105, 154, -218, 302,
+     -414, 566, -787, 1142, -1853, 4275, 15041, -2589, 1327, -830, 558, -385,
+     266, -182, 121, -78, 48, -28, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 25, -43, 69, -105, 153, -217, 301,
+     -412, 564, -784, 1138, -1845, 4254, 15052, -2582, 1323, -827, 556, -383,
+     265, -181, 121, -78, 48, -28, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 25, -43, 69, -104, 152, -216, 300,
+     -411, 562, -780, 1133, -1837, 4232, 15063, -2574, 1319, -825, 554, -382,
+     264, -181, 120, -78, 48, -28, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 25, -43, 68, -104, 152, -215, 299,
+     -409, 560, -777, 1128, -1830, 4211, 15074, -2567, 1314, -822, 552, -381,
+     263, -180, 120, -77, 48, -28, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 25, -43, 68, -104, 151, -214, 297,
+     -407, 557, -774, 1124, -1822, 4190, 15086, -2559, 1310, -819, 550, -379,
+     262, -179, 120, -77, 47, -27, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -14, 25, -43, 68, -103, 151, -214, 296,
+     -406, 555, -771, 1119, -1814, 4169, 15097, -2551, 1306, -816, 548, -378,
+     261, -179, 119, -77, 47, -27, 15, -7, 3, -1, 0},
+    {0, 1, -3, 7, -13, 25, -42, 68, -103, 150, -213, 295,
+     -404, 553, -768, 1114, -1806, 4148, 15108, -2543, 1301, -813, 546, -376,
+     260, -178, 119, -77, 47, -27, 15, -7, 3, -1, 0},
+    {0, 1, -3, 6, -13, 25, -42, 67, -102, 149, -212, 294,
+     -403, 551, -765, 1110, -1798, 4127, 15119, -2536, 1297, -810, 544, -375,
+     259, -177, 118, -76, 47, -27, 14, -7, 3, -1, 0},
+    {0, 1, -3, 6, -13, 25, -42, 67, -102, 149, -211, 293,
+     -401, 549, -762, 1105, -1790, 4105, 15129, -2528, 1292, -807, 542, -374,
+     258, -177, 118, -76, 47, -27, 14, -7, 3, -1, 0},
+    {0, 1, -3, 6, -13, 25, -42, 67, -102, 148, -210, 291,
+     -399, 546, -758, 1100, -1782, 4084, 15140, -2520, 1288, -804, 540, -372,
+     257, -176, 117, -76, 47, -27, 14, -7, 3, -1, 0},
+    {0, 1, -3, 6, -13, 25, -42, 67, -101, 148, -209, 290,
+     -398, 544, -755, 1095, -1774, 4063, 15151, -2512, 1283, -801, 538, -371,
+     256, -175, 117, -75, 46, -27, 14, -7, 3, -1, 0},
+    {0, 1, -3, 6, -13, 24, -42, 66, -101, 147, -208, 289,
+     -396, 542, -752, 1091, -1766, 4042, 15162, -2504, 1279, -798, 536, -369,
+     255, -175, 116, -75, 46, -27, 14, -7, 3, -1, 0},
+    {0, 1, -3, 6, -13, 24, -41, 66, -100, 146, -208, 288,
+     -394, 539, -749, 1086, -1758, 4021, 15173, -2496, 1274, -795, 534, -368,
+     254, -174, 116, -75, 46, -27, 14, -7, 3, -1, 0},
+    {0, 1, -3, 6, -13, 24, -41, 66, -100, 146, -207, 287,
+     -393, 537, -746, 1081, -1750, 4000, 15183, -2488, 1269, -792, 532, -367,
+     253, -173, 116, -75, 46, -27, 14, -7, 3, -1, 0},
+    {0, 1, -3, 6, -13, 24, -41, 66, -99, 145, -206, 286,
+     -391, 535, -742, 1077, -1742, 3979, 15194, -2480, 1265, -790, 530, -365,
+     252, -172, 115, -74, 46, -26, 14, -7, 3, -1, 0},
+    {0, 1, -3, 6, -13, 24, -41, 65, -99, 145, -205, 284,
+     -389, 533, -739, 1072, -1734, 3958, 15205, -2472, 1260, -787, 528, -364,
+     251, -172, 115, -74, 45, -26, 14, -7, 3, -1, 0},
+    {0, 1, -3, 6, -13, 24, -41, 65, -99, 144, -204, 283,
+     -388, 530, -736, 1067, -1726, 3937, 15215, -2464, 1256, -784, 526, -362,
+     250, -171, 114, -74, 45, -26, 14, -7, 3, -1, 0},
+    {0, 1, -3, 6, -13, 24, -41, 65, -98, 143, -203, 282,
+     -386, 528, -733, 1062, -1718, 3916, 15226, -2456, 1251, -781, 524, -361,
+     249, -170, 114, -73, 45, -26, 14, -7, 3, -1, 0},
+    {0, 1, -3, 6, -13, 24, -40, 64, -98, 143, -202, 281,
+     -384, 526, -730, 1058, -1710, 3895, 15236, -2447, 1246, -778, 522, -359,
+     248, -170, 113, -73, 45, -26, 14, -7, 3, -1, 0},
+    {0, 1, -3, 6, -13, 24, -40, 64, -97, 142, -202, 280,
+     -383, 523, -726, 1053, -1702, 3874, 15247, -2439, 1242, -775, 520, -358,
+     247, -169, 113, -73, 45, -26, 14, -7, 3, -1, 0},
+    {0, 1, -3, 6, -13, 24, -40, 64, -97, 142, -201, 278,
+     -381, 521, -723, 1048, -1694, 3853, 15257, -2431, 1237, -772, 518, -357,
+     246, -168, 112, -72, 45, -26, 14, -7, 3, -1, 0},
+    {0, 1, -3, 6, -13, 23, -40, 64, -97, 141, -200, 277,
+     -379, 519, -720, 1043, -1686, 3832, 15267, -2423, 1232, -768, 516, -355,
+     245, -168, 112, -72, 44, -26, 14, -7, 3, -1, 0},
+    {0, 1, -3, 6, -13, 23, -40, 63, -96, 140, -199, 276,
+     -378, 517, -717, 1038, -1677, 3811, 15278, -2414, 1228, -765, 513, -354,
+     244, -167, 111, -72, 44, -26, 14, -7, 3, -1, 0},
+    {0, 1, -2, 6, -13, 23, -40, 63, -96, 140, -198, 275,
+     -376, 514, -713, 1034, -1669, 3790, 15288, -2406, 1223, -762, 511, -352,
+     243, -166, 111, -72, 44, -25, 14, -6, 3, -1, 0},
+    {0, 1, -2, 6, -13, 23, -39, 63, -95, 139, -197, 273,
+     -374, 512, -710, 1029, -1661, 3769, 15298, -2398, 1218, -759, 509, -351,
+     242, -166, 110, -71, 44, -25, 14, -6, 3, -1, 0},
+    {0, 1, -2, 6, -12, 23, -39, 63, -95, 139, -196, 272,
+     -373, 510, -707, 1024, -1653, 3748, 15308, -2389, 1214, -756, 507, -349,
+     241, -165, 110, -71, 44, -25, 13, -6, 3, -1, 0},
+    {0, 1, -2, 6, -12, 23, -39, 62, -94, 138, -195, 271,
+     -371, 507, -704, 1019, -1645, 3727, 15318, -2381, 1209, -753, 505, -348,
+     240, -164, 110, -71, 43, -25, 13, -6, 3, -1, 0},
+    {0, 1, -2, 6, -12, 23, -39, 62, -94, 137, -195, 270,
+     -369, 505, -700, 1014, -1637, 3707, 15329, -2372, 1204, -750, 503, -346,
+     239, -163, 109, -70, 43, -25, 13, -6, 3, -1, 0},
+    {0, 1, -2, 6, -12, 23, -39, 62, -94, 137, -194, 269,
+     -368, 503, -697, 1009, -1629, 3686, 15339, -2363, 1199, -747, 501, -345,
+     238, -163, 109, -70, 43, -25, 13, -6, 3, -1, 0},
+    {0, 1, -2, 6, -12, 23, -39, 61, -93, 136, -193, 267,
+     -366, 500, -694, 1005, -1621, 3665, 15349, -2355, 1194, -744, 499, -343,
+     237, -162, 108, -70, 43, -25, 13, -6, 3, -1, 0},
+    {0, 1, -2, 6, -12, 23, -38, 61, -93, 135, -192, 266,
+     -364, 498, -691, 1000, -1613, 3644, 15358, -2346, 1190, -741, 497, -342,
+     236, -161, 108, -69, 43, -25, 13, -6, 3, -1, 0},
+    {0, 1, -2, 6, -12, 22, -38, 61, -92, 135, -191, 265,
+     -363, 496, -687, 995, -1604, 3623, 15368, -2338, 1185, -738, 494, -341,
+     235, -161, 107, -69, 43, -25, 13, -6, 3, -1, 0},
+    {0, 1, -2, 6, -12, 22, -38, 61, -92, 134, -190, 264,
+     -361, 493, -684, 990, -1596, 3602, 15378, -2329, 1180, -735, 492, -339,
+     234, -160, 107, -69, 42, -24, 13, -6, 3, -1, 0},
+    {0, 1, -2, 6, -12, 22, -38, 60, -92, 134, -189, 262,
+     -359, 491, -681, 985, -1588, 3582, 15388, -2320, 1175, -731, 490, -338,
+     233, -159, 106, -68, 42, -24, 13, -6, 3, -1, 0},
+    {0, 1, -2, 6, -12, 22, -38, 60, -91, 133, -188, 261,
+     -357, 489, -677, 980, -1580, 3561, 15398, -2311, 1170, -728, 488, -336,
+     232, -159, 106, -68, 42, -24, 13, -6, 2, -1, 0},
+    {0, 1, -2, 6, -12, 22, -37, 60, -91, 132, -187, 260,
+     -356, 486, -674, 975, -1572, 3540, 15407, -2302, 1165, -725, 486, -335,
+     231, -158, 105, -68, 42, -24, 13, -6, 2, -1, 0},
+    {0, 1, -2, 6, -12, 22, -37, 59, -90, 132, -187, 259,
+     -354, 484, -671, 971, -1564, 3519, 15417, -2294, 1160, -722, 484, -333,
+     230, -157, 105, -68, 42, -24, 13, -6, 2, -1, 0},
+    {0, 1, -2, 6, -12, 22, -37, 59, -90, 131, -186, 257,
+     -352, 481, -667, 966, -1556, 3499, 15427, -2285, 1155, -719, 482, -332,
+     229, -156, 104, -67, 41, -24, 13, -6, 2, -1, 0},
+    {0, 1, -2, 6, -12, 22, -37, 59, -89, 130, -185, 256,
+     -351, 479, -664, 961, -1547, 3478, 15436, -2276, 1150, -716, 479, -330,
+     228, -156, 104, -67, 41, -24, 13, -6, 2, -1, 0},
+    {0, 1, -2, 6, -12, 22, -37, 59, -89, 130, -184, 255,
+     -349, 477, -661, 956, -1539, 3457, 15446, -2267, 1145, -712, 477, -329,
+     227, -155, 103, -67, 41, -24, 13, -6, 2, -1, 0},
+    {0, 1, -2, 6, -12, 22, -37, 58, -88, 129, -183, 254,
+     -347, 474, -657, 951, -1531, 3437, 15455, -2258, 1140, -709, 475, -327,
+     226, -154, 103, -66, 41, -24, 13, -6, 2, -1, 0},
+    {0, 1, -2, 6, -12, 21, -36, 58, -88, 129, -182, 252,
+     -345, 472, -654, 946, -1523, 3416, 15465, -2249, 1135, -706, 473, -325,
+     225, -153, 102, -66, 41, -23, 13, -6, 2, -1, 0},
+    {0, 1, -2, 6, -12, 21, -36, 58, -88, 128, -181, 251,
+     -344, 470, -651, 941, -1515, 3395, 15474, -2240, 1130, -703, 471, -324,
+     224, -153, 102, -66, 40, -23, 12, -6, 2, -1, 0},
+    {0, 1, -2, 6, -11, 21, -36, 57, -87, 127, -180, 250,
+     -342, 467, -647, 936, -1506, 3375, 15484, -2231, 1125, -700, 468, -322,
+     223, -152, 101, -65, 40, -23, 12, -6, 2, -1, 0},
+    {0, 1, -2, 6, -11, 21, -36, 57, -87, 127, -179, 249,
+     -340, 465, -644, 931, -1498, 3354, 15493, -2221, 1120, -696, 466, -321,
+     222, -151, 101, -65, 40, -23, 12, -6, 2, -1, 0},
+    {0, 1, -2, 5, -11, 21, -36, 57, -86, 126, -178, 247,
+     -339, 462, -641, 926, -1490, 3334, 15502, -2212, 1115, -693, 464, -319,
+     221, -151, 100, -65, 40, -23, 12, -6, 2, -1, 0},
+    {0, 1, -2, 5, -11, 21, -35, 57, -86, 125, -178, 246,
+     -337, 460, -637, 921, -1482, 3313, 15511, -2203, 1110, -690, 462, -318,
+     219, -150, 100, -64, 40, -23, 12, -6, 2, -1, 0},
+    {0, 1, -2, 5, -11, 21, -35, 56, -85, 125, -177, 245,
+     -335, 458, -634, 916, -1473, 3292, 15521, -2194, 1105, -687, 460, -316,
+     218, -149, 99, -64, 39, -23, 12, -6, 2, -1, 0},
+    {0, 1, -2, 5, -11, 21, -35, 56, -85, 124, -176, 244,
+     -333, 455, -631, 912, -1465, 3272, 15530, -2184, 1100, -683, 457, -315,
+     217, -148, 99, -64, 39, -23, 12, -6, 2, -1, 0},
+    {0, 1, -2, 5, -11, 21, -35, 56, -85, 123, -175, 242,
+     -332, 453, -627, 907, -1457, 3251, 15539, -2175, 1095, -680, 455, -313,
+     216, -148, 98, -63, 39, -23, 12, -6, 2, -1, 0},
+    {0, 1, -2, 5, -11, 20, -35, 55, -84, 123, -174, 241,
+     -330, 450, -624, 902, -1449, 3231, 15548, -2166, 1090, -677, 453, -312,
+     215, -147, 98, -63, 39, -22, 12, -6, 2, -1, 0},
+    {0, 1, -2, 5, -11, 20, -35, 55, -84, 122, -173, 240,
+     -328, 448, -621, 897, -1440, 3210, 15557, -2156, 1085, -673, 451, -310,
+     214, -146, 97, -63, 39, -22, 12, -6, 2, -1, 0},
+    {0, 1, -2, 5, -11, 20, -34, 55, -83, 121, -172, 238,
+     -326, 446, -617, 892, -1432, 3190, 15566, -2147, 1079, -670, 448, -309,
+     213, -145, 97, -62, 38, -22, 12, -6, 2, -1, 0},
+    {0, 1, -2, 5, -11, 20, -34, 55, -83, 121, -171, 237,
+     -324, 443, -614, 887, -1424, 3170, 15575, -2137, 1074, -667, 446, -307,
+     212, -145, 96, -62, 38, -22, 12, -6, 2, -1, 0},
+    {0, 1, -2, 5, -11, 20, -34, 54, -82, 120, -170, 236,
+     -323, 441, -610, 882, -1416, 3149, 15583, -2128, 1069, -663, 444, -305,
+     211, -144, 96, -62, 38, -22, 12, -6, 2, -1, 0},
+    {0, 1, -2, 5, -11, 20, -34, 54, -82, 120, -169, 235,
+     -321, 438, -607, 877, -1407, 3129, 15592, -2118, 1064, -660, 442, -304,
+     210, -143, 95, -62, 38, -22, 12, -6, 2, -1, 0},
+    {0, 1, -2, 5, -11, 20, -34, 54, -81, 119, -168, 233,
+     -319, 436, -604, 872, -1399, 3108, 15601, -2109, 1059, -657, 439, -302,
+     209, -142, 95, -61, 38, -22, 12, -6, 2, -1, 0},
+    {0, 1, -2, 5, -11, 20, -33, 53, -81, 118, -167, 232,
+     -317, 433, -600, 867, -1391, 3088, 15610, -2099, 1053, -653, 437, -301,
+     208, -142, 94, -61, 37, -22, 12, -6, 2, -1, 0},
+    {0, 1, -2, 5, -11, 20, -33, 53, -81, 118, -166, 231,
+     -316, 431, -597, 862, -1382, 3068, 15618, -2089, 1048, -650, 435, -299,
+     206, -141, 94, -61, 37, -22, 11, -5, 2, -1, 0},
+    {0, 1, -2, 5, -11, 19, -33, 53, -80, 117, -166, 229,
+     -314, 429, -593, 857, -1374, 3047, 15627, -2080, 1043, -647, 433, -297,
+     205, -140, 93, -60, 37, -21, 11, -5, 2, -1, 0},
+    {0, 1, -2, 5, -10, 19, -33, 53, -80, 116, -165, 228,
+     -312, 426, -590, 852, -1366, 3027, 15636, -2070, 1037, -643, 430, -296,
+     204, -139, 93, -60, 37, -21, 11, -5, 2, -1, 0},
+    {0, 1, -2, 5, -10, 19, -33, 52, -79, 116, -164, 227,
+     -310, 424, -587, 847, -1358, 3007, 15644, -2060, 1032, -640, 428, -294,
+     203, -139, 92, -60, 37, -21, 11, -5, 2, -1, 0},
+    {0, 1, -2, 5, -10, 19, -33, 52, -79, 115, -163, 226,
+     -309, 421, -583, 842, -1349, 2986, 15653, -2050, 1027, -637, 426, -293,
+     202, -138, 92, -59, 36, -21, 11, -5, 2, -1, 0},
+    {0, 1, -2, 5, -10, 19, -32, 52, -78, 114, -162, 224,
+     -307, 419, -580, 837, -1341, 2966, 15661, -2041, 1022, -633, 423, -291,
+     201, -137, 91, -59, 36, -21, 11, -5, 2, -1, 0},
+    {0, 1, -2, 5, -10, 19, -32, 51, -78, 114, -161, 223,
+     -305, 416, -576, 832, -1333, 2946, 15669, -2031, 1016, -630, 421, -290,
+     200, -136, 91, -59, 36, -21, 11, -5, 2, -1, 0},
+    {0, 1, -2, 5, -10, 19, -32, 51, -77, 113, -160, 222,
+     -303, 414, -573, 827, -1324, 2926, 15678, -2021, 1011, -626, 419, -288,
+     199, -136, 90, -58, 36, -21, 11, -5, 2, -1, 0},
+    {0, 1, -2, 5, -10, 19, -32, 51, -77, 112, -159, 220,
+     -301, 411, -569, 822, -1316, 2905, 15686, -2011, 1005, -623, 416, -286,
+     198, -135, 90, -58, 36, -21, 11, -5, 2, -1, 0},
+    {0, 1, -2, 5, -10, 19, -32, 50, -77, 112, -158, 219,
+     -300, 409, -566, 816, -1308, 2885, 15694, -2001, 1000, -619, 414, -285,
+     196, -134, 89, -58, 35, -20, 11, -5, 2, -1, 0},
+    {0, 1, -2, 5, -10, 19, -31, 50, -76, 111, -157, 218,
+     -298, 406, -562, 811, -1299, 2865, 15702, -1991, 995, -616, 412, -283,
+     195, -133, 89, -57, 35, -20, 11, -5, 2, -1, 0},
+    {0, 1, -2, 5, -10, 18, -31, 50, -76, 110, -156, 216,
+     -296, 404, -559, 806, -1291, 2845, 15711, -1981, 989, -613, 409, -281,
+     194, -133, 88, -57, 35, -20, 11, -5, 2, -1, 0},
+    {0, 1, -2, 5, -10, 18, -31, 50, -75, 110, -155, 215,
+     -294, 401, -556, 801, -1283, 2825, 15719, -1971, 984, -609, 407, -280,
+     193, -132, 88, -57, 35, -20, 11, -5, 2, -1, 0},
+    {0, 1, -2, 5, -10, 18, -31, 49, -75, 109, -154, 214,
+     -292, 399, -552, 796, -1274, 2805, 15727, -1961, 978, -606, 405, -278,
+     192, -131, 87, -56, 35, -20, 11, -5, 2, -1, 0},
+    {0, 1, -2, 5, -10, 18, -31, 49, -74, 108, -153, 212,
+     -291, 397, -549, 791, -1266, 2784, 15735, -1950, 973, -602, 402, -277,
+     191, -130, 87, -56, 34, -20, 11, -5, 2, -1, 0},
+    {0, 1, -2, 5, -10, 18, -31, 49, -74, 108, -152, 211,
+     -289, 394, -545, 786, -1258, 2764, 15743, -1940, 967, -599, 400, -275,
+     190, -129, 86, -56, 34, -20, 11, -5, 2, -1, 0},
+    {0, 1, -2, 5, -10, 18, -30, 48, -73, 107, -151, 210,
+     -287, 392, -542, 781, -1249, 2744, 15751, -1930, 962, -595, 398, -273,
+     189, -129, 86, -55, 34, -20, 10, -5, 2, -1, 0},
+    {0, 1, -2, 5, -10, 18, -30, 48, -73, 106, -150, 208,
+     -285, 389, -538, 776, -1241, 2724, 15759, -1920, 956, -592, 395, -272,
+     187, -128, 85, -55, 34, -20, 10, -5, 2, -1, 0},
+    {0, 1, -2, 5, -10, 18, -30, 48, -72, 106, -150, 207,
+     -283, 387, -535, 771, -1233, 2704, 15766, -1909, 951, -588, 393, -270,
+     186, -127, 85, -55, 34, -19, 10, -5, 2, -1, 0},
+    {0, 1, -2, 5, -9, 18, -30, 47, -72, 105, -149, 206,
+     -281, 384, -531, 766, -1224, 2684, 15774, -1899, 945, -585, 391, -268,
+     185, -126, 84, -54, 33, -19, 10, -5, 2, -1, 0},
+    {0, 1, -2, 5, -9, 17, -30, 47, -71, 104, -148, 205,
+     -280, 382, -528, 761, -1216, 2664, 15782, -1889, 940, -581, 388, -267,
+     184, -126, 84, -54, 33, -19, 10, -5, 2, -1, 0},
+    {0, 1, -2, 5, -9, 17, -29, 47, -71, 104, -147, 203,
+     -278, 379, -524, 756, -1207, 2644, 15790, -1878, 934, -578, 386, -265,
+     183, -125, 83, -54, 33, -19, 10, -5, 2, -1, 0},
+    {0, 1, -2, 4, -9, 17, -29, 47, -71, 103, -146, 202,
+     -276, 377, -521, 750, -1199, 2624, 15797, -1868, 929, -574, 383, -263,
+     182, -124, 83, -53, 33, -19, 10, -5, 2, -1, 0},
+    {0, 1, -2, 4, -9, 17, -29, 46, -70, 102, -145, 201,
+     -274, 374, -517, 745, -1191, 2604, 15805, -1857, 923, -571, 381, -262,
+     181, -123, 82, -53, 33, -19, 10, -5, 2, -1, 0},
+    {0, 1, -2, 4, -9, 17, -29, 46, -70, 102, -144, 199,
+     -272, 372, -514, 740, -1182, 2584, 15812, -1847, 918, -567, 379, -260,
+     179, -122, 82, -53, 32, -19, 10, -5, 2, -1, 0},
+    {0, 1, -2, 4, -9, 17, -29, 46, -69, 101, -143, 198,
+     -271, 369, -510, 735, -1174, 2565, 15820, -1836, 912, -564, 376, -258,
+     178, -122, 81, -52, 32, -19, 10, -5, 2, -1, 0},
+    {0, 1, -2, 4, -9, 17, -28, 45, -69, 100, -142, 197,
+     -269, 367, -507, 730, -1166, 2545, 15827, -1826, 906, -560, 374, -257,
+     177, -121, 81, -52, 32, -18, 10, -5, 2, -1, 0},
+    {0, 1, -2, 4, -9, 17, -28, 45, -68, 100, -141, 195,
+     -267, 364, -503, 725, -1157, 2525, 15835, -1815, 901, -556, 371, -255,
+     176, -120, 80, -52, 32, -18, 10, -5, 2, -1, 0},
+    {0, 1, -2, 4, -9, 17, -28, 45, -68, 99, -140, 194,
+     -265, 361, -500, 720, -1149, 2505, 15842, -1804, 895, -553, 369, -253,
+     175, -119, 79, -51, 31, -18, 10, -5, 2, -1, 0},
+    {0, 1, -2, 4, -9, 16, -28, 44, -67, 98, -139, 193,
+     -263, 359, -496, 715, -1140, 2485, 15849, -1794, 889, -549, 367, -252,
+     174, -118, 79, -51, 31, -18, 10, -5, 2, -1, 0},
+    {0, 1, -2, 4, -9, 16, -28, 44, -67, 98, -138, 191,
+     -261, 356, -493, 710, -1132, 2465, 15856, -1783, 884, -546, 364, -250,
+     172, -118, 78, -50, 31, -18, 10, -5, 2, -1, 0},
+    {0, 1, -2, 4, -9, 16, -27, 44, -66, 97, -137, 190,
+     -259, 354, -489, 704, -1124, 2446, 15864, -1772, 878, -542, 362, -248,
+     171, -117, 78, -50, 31, -18, 10, -5, 2, -1, 0},
+    {0, 1, -2, 4, -9, 16, -27, 43, -66, 96, -136, 188,
+     -258, 351, -486, 699, -1115, 2426, 15871, -1761, 872, -538, 359, -247,
+     170, -116, 77, -50, 31, -18, 9, -4, 2, -1, 0},
+    {0, 1, -2, 4, -9, 16, -27, 43, -65, 95, -135, 187,
+     -256, 349, -482, 694, -1107, 2406, 15878, -1750, 866, -535, 357, -245,
+     169, -115, 77, -49, 30, -18, 9, -4, 2, -1, 0},
+    {0, 1, -2, 4, -9, 16, -27, 43, -65, 95, -134, 186,
+     -254, 346, -479, 689, -1098, 2387, 15885, -1739, 861, -531, 354, -243,
+     168, -114, 76, -49, 30, -17, 9, -4, 2, -1, 0},
+    {0, 1, -2, 4, -9, 16, -27, 43, -65, 94, -133, 184,
+     -252, 344, -475, 684, -1090, 2367, 15892, -1729, 855, -528, 352, -242,
+     167, -114, 76, -49, 30, -17, 9, -4, 2, -1, 0},
+    {0, 1, -2, 4, -8, 16, -26, 42, -64, 93, -132, 183,
+     -250, 341, -472, 679, -1082, 2347, 15899, -1718, 849, -524, 350, -240,
+     165, -113, 75, -48, 30, -17, 9, -4, 2, -1, 0},
+    {0, 1, -2, 4, -8, 15, -26, 42, -64, 93, -131, 182,
+     -248, 339, -468, 674, -1073, 2328, 15906, -1707, 843, -520, 347, -238,
+     164, -112, 75, -48, 30, -17, 9, -4, 2, -1, 0},
+    {0, 1, -2, 4, -8, 15, -26, 42, -63, 92, -130, 180,
+     -247, 336, -464, 668, -1065, 2308, 15913, -1696, 838, -517, 345, -237,
+     163, -111, 74, -48, 29, -17, 9, -4, 2, -1, 0},
+    {0, 1, -2, 4, -8, 15, -26, 41, -63, 91, -129, 179,
+     -245, 334, -461, 663, -1056, 2288, 15920, -1684, 832, -513, 342, -235,
+     162, -110, 74, -47, 29, -17, 9, -4, 2, -1, 0},
+    {0, 1, -2, 4, -8, 15, -26, 41, -62, 91, -128, 178,
+     -243, 331, -457, 658, -1048, 2269, 15926, -1673, 826, -509, 340, -233,
+     161, -110, 73, -47, 29, -17, 9, -4, 2, -1, 0},
+    {0, 1, -2, 4, -8, 15, -26, 41, -62, 90, -127, 176,
+     -241, 329, -454, 653, -1040, 2249, 15933, -1662, 820, -506, 337, -231,
+     160, -109, 72, -47, 29, -17, 9, -4, 2, -1, 0},
+    {0, 1, -2, 4, -8, 15, -25, 40, -61, 89, -126, 175,
+     -239, 326, -450, 648, -1031, 2230, 15940, -1651, 814, -502, 335, -230,
+     158, -108, 72, -46, 28, -16, 9, -4, 2, -1, 0},
+    {0, 0, -2, 4, -8, 15, -25, 40, -61, 89, -125, 174,
+     -237, 323, -447, 643, -1023, 2210, 15946, -1640, 808, -498, 332, -228,
+     157, -107, 71, -46, 28, -16, 9, -4, 2, -1, 0},
+    {0, 0, -2, 4, -8, 15, -25, 40, -60, 88, -124, 172,
+     -235, 321, -443, 637, -1014, 2191, 15953, -1629, 803, -495, 330, -226,
+     156, -106, 71, -46, 28, -16, 9, -4, 2, -1, 0},
+    {0, 0, -2, 4, -8, 15, -25, 39, -60, 87, -123, 171,
+     -233, 318, -440, 632, -1006, 2171, 15960, -1617, 797, -491, 327, -225,
+     155, -106, 70, -45, 28, -16, 9, -4, 2, -1, 0},
+    {0, 0, -2, 4, -8, 14, -25, 39, -59, 87, -122, 169,
+     -232, 316, -436, 627, -997, 2152, 15966, -1606, 791, -487, 325, -223,
+     154, -105, 70, -45, 28, -16, 9, -4, 2, -1, 0},
+    {0, 0, -2, 4, -8, 14, -24, 39, -59, 86, -121, 168,
+     -230, 313, -432, 622, -989, 2132, 15972, -1595, 785, -483, 322, -221,
+     152, -104, 69, -45, 27, -16, 8, -4, 2, -1, 0},
+    {0, 0, -2, 4, -8, 14, -24, 38, -58, 85, -120, 167,
+     -228, 311, -429, 617, -981, 2113, 15979, -1583, 779, -480, 320, -219,
+     151, -103, 69, -44, 27, -16, 8, -4, 2, -1, 0},
+    {0, 0, -2, 4, -8, 14, -24, 38, -58, 84, -119, 165,
+     -226, 308, -425, 612, -972, 2094, 15985, -1572, 773, -476, 317, -218,
+     150, -102, 68, -44, 27, -16, 8, -4, 2, 0, 0},
+    {0, 0, -1, 4, -8, 14, -24, 38, -57, 84, -118, 164,
+     -224, 305, -422, 606, -964, 2074, 15991, -1560, 767, -472, 315, -216,
+     149, -101, 68, -43, 27, -15, 8, -4, 2, 0, 0},
+    {0, 0, -1, 4, -8, 14, -24, 38, -57, 83, -117, 163,
+     -222, 303, -418, 601, -955, 2055, 15998, -1549, 761, -469, 312, -214,
+     148, -101, 67, -43, 27, -15, 8, -4, 2, 0, 0},
+    {0, 0, -1, 4, -7, 14, -23, 37, -56, 82, -116, 161,
+     -220, 300, -415, 596, -947, 2036, 16004, -1537, 755, -465, 310, -212,
+     146, -100, 66, -43, 26, -15, 8, -4, 2, 0, 0},
+    {0, 0, -1, 4, -7, 14, -23, 37, -56, 82, -116, 160,
+     -218, 298, -411, 591, -938, 2016, 16010, -1526, 749, -461, 307, -211,
+     145, -99, 66, -42, 26, -15, 8, -4, 2, 0, 0},
+    {0, 0, -1, 4, -7, 14, -23, 37, -56, 81, -115, 159,
+     -217, 295, -407, 586, -930, 1997, 16016, -1514, 743, -457, 305, -209,
+     144, -98, 65, -42, 26, -15, 8, -4, 2, 0, 0},
+    {0, 0, -1, 4, -7, 13, -23, 36, -55, 80, -114, 157,
+     -215, 293, -404, 580, -922, 1978, 16022, -1503, 737, -453, 302, -207,
+     143, -97, 65, -42, 26, -15, 8, -4, 2, 0, 0},
+    {0, 0, -1, 3, -7, 13, -23, 36, -55, 80, -113, 156,
+     -213, 290, -400, 575, -913, 1958, 16028, -1491, 731, -450, 300, -205,
+     142, -96, 64, -41, 25, -15, 8, -4, 2, 0, 0},
+    {0, 0, -1, 3, -7, 13, -22, 36, -54, 79, -112, 154,
+     -211, 287, -397, 570, -905, 1939, 16034, -1479, 725, -446, 297, -204,
+     140, -96, 64, -41, 25, -15, 8, -4, 1, 0, 0},
+    {0, 0, -1, 3, -7, 13, -22, 35, -54, 78, -111, 153,
+     -209, 285, -393, 565, -896, 1920, 16040, -1467, 719, -442, 294, -202,
+     139, -95, 63, -41, 25, -14, 8, -4, 1, 0, 0},
+    {0, 0, -1, 3, -7, 13, -22, 35, -53, 77, -110, 152,
+     -207, 282, -390, 560, -888, 1901, 16046, -1456, 713, -438, 292, -200,
+     138, -94, 63, -40, 25, -14, 8, -4, 1, 0, 0},
+    {0, 0, -1, 3, -7, 13, -22, 35, -53, 77, -109, 150,
+     -205, 280, -386, 554, -879, 1882, 16052, -1444, 707, -435, 289, -198,
+     137, -93, 62, -40, 25, -14, 8, -4, 1, 0, 0},
+    {0, 0, -1, 3, -7, 13, -22, 34, -52, 76, -108, 149,
+     -203, 277, -382, 549, -871, 1863, 16057, -1432, 701, -431, 287, -197,
+     135, -92, 61, -40, 24, -14, 7, -4, 1, 0, 0},
+    {0, 0, -1, 3, -7, 13, -21, 34, -52, 75, -107, 147,
+     -201, 274, -379, 544, -863, 1844, 16063, -1420, 695, -427, 284, -195,
+     134, -91, 61, -39, 24, -14, 7, -4, 1, 0, 0},
+    {0, 0, -1, 3, -7, 12, -21, 34, -51, 75, -106, 146,
+     -200, 272, -375, 539, -854, 1825, 16069, -1408, 688, -423, 282, -193,
+     133, -91, 60, -39, 24, -14, 7, -4, 1, 0, 0},
+    {0, 0, -1, 3, -7, 12, -21, 33, -51, 74, -105, 145,
+     -198, 269, -372, 533, -846, 1805, 16074, -1396, 682, -419, 279, -191,
+     132, -90, 60, -38, 24, -14, 7, -3, 1, 0, 0},
+    {0, 0, -1, 3, -7, 12, -21, 33, -50, 73, -104, 143,
+     -196, 267, -368, 528, -837, 1786, 16080, -1384, 676, -415, 276, -190,
+     131, -89, 59, -38, 23, -14, 7, -3, 1, 0, 0},
+    {0, 0, -1, 3, -7, 12, -21, 33, -50, 72, -103, 142,
+     -194, 264, -364, 523, -829, 1767, 16085, -1372, 670, -412, 274, -188,
+     129, -88, 59, -38, 23, -13, 7, -3, 1, 0, 0},
+    {0, 0, -1, 3, -6, 12, -20, 32, -49, 72, -102, 141,
+     -192, 261, -361, 518, -820, 1749, 16091, -1360, 664, -408, 271, -186,
+     128, -87, 58, -37, 23, -13, 7, -3, 1, 0, 0},
+    {0, 0, -1, 3, -6, 12, -20, 32, -49, 71, -101, 139,
+     -190, 259, -357, 513, -812, 1730, 16096, -1348, 658, -404, 269, -184,
+     127, -86, 58, -37, 23, -13, 7, -3, 1, 0, 0},
+    {0, 0, -1, 3, -6, 12, -20, 32, -48, 70, -100, 138,
+     -188, 256, -353, 507, -804, 1711, 16102, -1336, 651, -400, 266, -182,
+     126, -86, 57, -37, 23, -13, 7, -3, 1, 0, 0},
+    {0, 0, -1, 3, -6, 12, -20, 32, -48, 70, -99, 136,
+     -186, 254, -350, 502, -795, 1692, 16107, -1324, 645, -396, 264, -181,
+     124, -85, 56, -36, 22, -13, 7, -3, 1, 0, 0},
+    {0, 0, -1, 3, -6, 12, -20, 31, -47, 69, -98, 135,
+     -184, 251, -346, 497, -787, 1673, 16112, -1312, 639, -392, 261, -179,
+     123, -84, 56, -36, 22, -13, 7, -3, 1, 0, 0},
+    {0, 0, -1, 3, -6, 11, -19, 31, -47, 68, -97, 134,
+     -182, 248, -343, 492, -778, 1654, 16117, -1299, 633, -388, 258, -177,
+     122, -83, 55, -36, 22, -13, 7, -3, 1, 0, 0},
+    {0, 0, -1, 3, -6, 11, -19, 31, -46, 68, -96, 132,
+     -181, 246, -339, 486, -770, 1635, 16123, -1287, 627, -384, 256, -175,
+     121, -82, 55, -35, 22, -13, 7, -3, 1, 0, 0},
+    {0, 0, -1, 3, -6, 11, -19, 30, -46, 67, -95, 131,
+     -179, 243, -335, 481, -761, 1616, 16128, -1275, 620, -381, 253, -173,
+     119, -81, 54, -35, 21, -12, 7, -3, 1, 0, 0},
+    {0, 0, -1, 3, -6, 11, -19, 30, -45, 66, -94, 129,
+     -177, 241, -332, 476, -753, 1598, 16133, -1263, 614, -377, 251, -172,
+     118, -81, 54, -35, 21, -12, 7, -3, 1, 0, 0},
+    {0, 0, -1, 3, -6, 11, -19, 30, -45, 65, -93, 128,
+     -175, 238, -328, 471, -745, 1579, 16138, -1250, 608, -373, 248, -170,
+     117, -80, 53, -34, 21, -12, 6, -3, 1, 0, 0},
+    {0, 0, -1, 3, -6, 11, -18, 29, -44, 65, -91, 127,
+     -173, 235, -325, 465, -736, 1560, 16143, -1238, 602, -369, 245, -168,
+     116, -79, 52, -34, 21, -12, 6, -3, 1, 0, 0},
+    {0, 0, -1, 3, -6, 11, -18, 29, -44, 64, -90, 125,
+     -171, 233, -321, 460, -728, 1541, 16148, -1225, 595, -365, 243, -166,
+     114, -78, 52, -33, 21, -12, 6, -3, 1, 0, 0},
+    {0, 0, -1, 3, -6, 11, -18, 29, -43, 63, -89, 124,
+     -169, 230, -317, 455, -719, 1523, 16153, -1213, 589, -361, 240, -164,
+     113, -77, 51, -33, 20, -12, 6, -3, 1, 0, 0},
+    {0, 0, -1, 3, -6, 10, -18, 28, -43, 63, -88, 122,
+     -167, 228, -314, 450, -711, 1504, 16157, -1200, 583, -357, 237, -163,
+     112, -76, 51, -33, 20, -12, 6, -3, 1, 0, 0},
+    {0, 0, -1, 3, -6, 10, -18, 28, -42, 62, -87, 121,
+     -165, 225, -310, 444, -703, 1485, 16162, -1188, 576, -353, 235, -161,
+     111, -75, 50, -32, 20, -11, 6, -3, 1, 0, 0},
+    {0, 0, -1, 3, -6, 10, -17, 28, -42, 61, -86, 120,
+     -163, 222, -306, 439, -694, 1467, 16167, -1175, 570, -349, 232, -159,
+     109, -75, 50, -32, 20, -11, 6, -3, 1, 0, 0},
+    {0, 0, -1, 3, -5, 10, -17, 27, -41, 60, -85, 118,
+     -161, 220, -303, 434, -686, 1448, 16171, -1163, 564, -345, 229, -157,
+     108, -74, 49, -32, 19, -11, 6, -3, 1, 0, 0},
+    {0, 0, -1, 3, -5, 10, -17, 27, -41, 60, -84, 117,
+     -159, 217, -299, 429, -677, 1430, 16176, -1150, 557, -341, 227, -155,
+     107, -73, 48, -31, 19, -11, 6, -3, 1, 0, 0},
+    {0, 0, -1, 3, -5, 10, -17, 27, -40, 59, -83, 115,
+     -157, 214, -295, 423, -669, 1411, 16181, -1137, 551, -337, 224, -154,
+     106, -72, 48, -31, 19, -11, 6, -3, 1, 0, 0},
+    {0, 0, -1, 3, -5, 10, -17, 26, -40, 58, -82, 114,
+     -156, 212, -292, 418, -661, 1393, 16185, -1125, 544, -333, 221, -152,
+     104, -71, 47, -30, 19, -11, 6, -3, 1, 0, 0},
+    {0, 0, -1, 3, -5, 10, -16, 26, -39, 58, -81, 113,
+     -154, 209, -288, 413, -652, 1374, 16190, -1112, 538, -329, 219, -150,
+     103, -70, 47, -30, 18, -11, 6, -3, 1, 0, 0},
+    {0, 0, -1, 2, -5, 10, -16, 26, -39, 57, -80, 111,
+     -152, 207, -285, 408, -644, 1356, 16194, -1099, 532, -325, 216, -148,
+     102, -69, 46, -30, 18, -11, 6, -3, 1, 0, 0},
+    {0, 0, -1, 2, -5, 9, -16, 25, -38, 56, -79, 110,
+     -150, 204, -281, 402, -635, 1337, 16198, -1086, 525, -321, 214, -146,
+     101, -69, 46, -29, 18, -10, 6, -3, 1, 0, 0},
+    {0, 0, -1, 2, -5, 9, -16, 25, -38, 55, -78, 108,
+     -148, 201, -277, 397, -627, 1319, 16203, -1073, 519, -317, 211, -144,
+     99, -68, 45, -29, 18, -10, 5, -3, 1, 0, 0},
+    {0, 0, -1, 2, -5, 9, -16, 25, -38, 55, -77, 107,
+     -146, 199, -274, 392, -618, 1301, 16207, -1061, 512, -313, 208, -143,
+     98, -67, 44, -29, 18, -10, 5, -3, 1, 0, 0},
+    {0, 0, -1, 2, -5, 9, -15, 24, -37, 54, -76, 106,
+     -144, 196, -270, 387, -610, 1282, 16211, -1048, 506, -309, 206, -141,
+     97, -66, 44, -28, 17, -10, 5, -3, 1, 0, 0},
+    {0, 0, -1, 2, -5, 9, -15, 24, -37, 53, -75, 104,
+     -142, 193, -266, 381, -602, 1264, 16215, -1035, 499, -305, 203, -139,
+     96, -65, 43, -28, 17, -10, 5, -3, 1, 0, 0},
+    {0, 0, -1, 2, -5, 9, -15, 24, -36, 53, -74, 103,
+     -140, 191, -263, 376, -593, 1246, 16220, -1022, 493, -301, 200, -137,
+     94, -64, 43, -27, 17, -10, 5, -2, 1, 0, 0},
+    {0, 0, -1, 2, -5, 9, -15, 23, -36, 52, -73, 101,
+     -138, 188, -259, 371, -585, 1227, 16224, -1009, 486, -297, 197, -135,
+     93, -63, 42, -27, 17, -10, 5, -2, 1, 0, 0},
+    {0, 0, -1, 2, -5, 9, -15, 23, -35, 51, -72, 100,
+     -136, 185, -255, 366, -577, 1209, 16228, -996, 480, -293, 195, -133,
+     92, -62, 42, -27, 16, -9, 5, -2, 1, 0, 0},
+    {0, 0, -1, 2, -5, 8, -14, 23, -35, 50, -71, 98,
+     -134, 183, -252, 360, -568, 1191, 16232, -983, 473, -289, 192, -131,
+     90, -62, 41, -26, 16, -9, 5, -2, 1, 0, 0},
+    {0, 0, -1, 2, -4, 8, -14, 22, -34, 50, -70, 97,
+     -132, 180, -248, 355, -560, 1173, 16236, -969, 467, -285, 189, -130,
+     89, -61, 40, -26, 16, -9, 5, -2, 1, 0, 0},
+    {0, 0, -1, 2, -4, 8, -14, 22, -34, 49, -69, 96,
+     -130, 178, -244, 350, -551, 1154, 16239, -956, 460, -281, 187, -128,
+     88, -60, 40, -26, 16, -9, 5, -2, 1, 0, 0},
+    {0, 0, -1, 2, -4, 8, -14, 22, -33, 48, -68, 94,
+     -129, 175, -241, 345, -543, 1136, 16243, -943, 454, -277, 184, -126,
+     87, -59, 39, -25, 16, -9, 5, -2, 1, 0, 0},
+    {0, 0, -1, 2, -4, 8, -13, 21, -33, 47, -67, 93,
+     -127, 172, -237, 339, -535, 1118, 16247, -930, 447, -273, 181, -124,
+     85, -58, 39, -25, 15, -9, 5, -2, 1, 0, 0},
+    {0, 0, -1, 2, -4, 8, -13, 21, -32, 47, -66, 91,
+     -125, 170, -234, 334, -526, 1100, 16251, -917, 441, -269, 179, -122,
+     84, -57, 38, -25, 15, -9, 5, -2, 1, 0, 0},
+    {0, 0, -1, 2, -4, 8, -13, 21, -32, 46, -65, 90,
+     -123, 167, -230, 329, -518, 1082, 16254, -903, 434, -265, 176, -120,
+     83, -56, 38, -24, 15, -9, 5, -2, 1, 0, 0},
+    {0, 0, -1, 2, -4, 8, -13, 21, -31, 45, -64, 89,
+     -121, 164, -226, 324, -510, 1064, 16258, -890, 427, -261, 173, -118,
+     82, -55, 37, -24, 15, -8, 4, -2, 1, 0, 0},
+    {0, 0, -1, 2, -4, 7, -13, 20, -31, 45, -63, 87,
+     -119, 162, -223, 318, -501, 1046, 16262, -877, 421, -257, 170, -117,
+     80, -55, 36, -23, 14, -8, 4, -2, 1, 0, 0},
+    {0, 0, -1, 2, -4, 7, -12, 20, -30, 44, -62, 86,
+     -117, 159, -219, 313, -493, 1028, 16265, -863, 414, -253, 168, -115,
+     79, -54, 36, -23, 14, -8, 4, -2, 1, 0, 0},
+    {0, 0, -1, 2, -4, 7, -12, 20, -30, 43, -61, 84,
+     -115, 156, -215, 308, -485, 1010, 16269, -850, 408, -249, 165, -113,
+     78, -53, 35, -23, 14, -8, 4, -2, 1, 0, 0},
+    {0, 0, -1, 2, -4, 7, -12, 19, -29, 42, -60, 83,
+     -113, 154, -212, 303, -476, 992, 16272, -836, 401, -245, 162, -111,
+     76, -52, 35, -22, 14, -8, 4, -2, 1, 0, 0},
+    {0, 0, -1, 2, -4, 7, -12, 19, -29, 42, -59, 81,
+     -111, 151, -208, 297, -468, 974, 16275, -823, 394, -241, 160, -109,
+     75, -51, 34, -22, 13, -8, 4, -2, 1, 0, 0},
+    {0, 0, -1, 2, -4, 7, -12, 19, -28, 41, -58, 80,
+     -109, 148, -204, 292, -459, 956, 16279, -809, 388, -236, 157, -107,
+     74, -50, 33, -21, 13, -8, 4, -2, 1, 0, 0},
+    {0, 0, -1, 2, -4, 7, -11, 18, -28, 40, -57, 79,
+     -107, 146, -201, 287, -451, 938, 16282, -796, 381, -232, 154, -105,
+     72, -49, 33, -21, 13, -7, 4, -2, 1, 0, 0},
+    {0, 0, -1, 2, -4, 7, -11, 18, -27, 39, -56, 77,
+     -105, 143, -197, 282, -443, 921, 16285, -782, 374, -228, 151, -104,
+     71, -48, 32, -21, 13, -7, 4, -2, 1, 0, 0},
+    {0, 0, -1, 2, -4, 6, -11, 18, -27, 39, -55, 76,
+     -103, 140, -193, 276, -434, 903, 16288, -769, 368, -224, 149, -102,
+     70, -48, 32, -20, 13, -7, 4, -2, 1, 0, 0},
+    {0, 0, -1, 2, -3, 6, -11, 17, -26, 38, -54, 74,
+     -101, 138, -190, 271, -426, 885, 16291, -755, 361, -220, 146, -100,
+     69, -47, 31, -20, 12, -7, 4, -2, 1, 0, 0},
+    {0, 0, -1, 2, -3, 6, -11, 17, -26, 37, -53, 73,
+     -99, 135, -186, 266, -418, 867, 16295, -741, 354, -216, 143, -98,
+     67, -46, 30, -20, 12, -7, 4, -2, 1, 0, 0},
+    {0, 0, -1, 2, -3, 6, -10, 17, -25, 37, -52, 71,
+     -97, 133, -182, 261, -409, 850, 16298, -727, 347, -212, 140, -96,
+     66, -45, 30, -19, 12, -7, 4, -2, 1, 0, 0},
+    {0, 0, -1, 2, -3, 6, -10, 16, -25, 36, -51, 70,
+     -96, 130, -179, 255, -401, 832, 16301, -714, 341, -208, 138, -94,
+     65, -44, 29, -19, 12, -7, 4, -2, 1, 0, 0},
+    {0, 0, -1, 2, -3, 6, -10, 16, -24, 35, -50, 69,
+     -94, 127, -175, 250, -393, 814, 16303, -700, 334, -203, 135, -92,
+     63, -43, 29, -18, 11, -7, 3, -2, 1, 0, 0},
+    {0, 0, -1, 2, -3, 6, -10, 16, -24, 34, -49, 67,
+     -92, 125, -171, 245, -385, 797, 16306, -686, 327, -199, 132, -90,
+     62, -42, 28, -18, 11, -6, 3, -2, 1, 0, 0},
+    {0, 0, -1, 1, -3, 6, -10, 15, -23, 34, -48, 66,
+     -90, 122, -168, 240, -376, 779, 16309, -672, 320, -195, 129, -88,
+     61, -41, 28, -18, 11, -6, 3, -2, 1, 0, 0},
+    {0, 0, -1, 1, -3, 6, -9, 15, -23, 33, -47, 64,
+     -88, 119, -164, 234, -368, 761, 16312, -658, 314, -191, 127, -87,
+     60, -40, 27, -17, 11, -6, 3, -2, 1, 0, 0},
+    {0, 0, -1, 1, -3, 5, -9, 15, -22, 32, -45, 63,
+     -86, 117, -160, 229, -360, 744, 16315, -644, 307, -187, 124, -85,
+     58, -40, 26, -17, 10, -6, 3, -2, 1, 0, 0},
+    {0, 0, -1, 1, -3, 5, -9, 14, -22, 31, -44, 61,
+     -84, 114, -157, 224, -351, 726, 16317, -630, 300, -183, 121, -83,
+     57, -39, 26, -17, 10, -6, 3, -1, 1, 0, 0},
+    {0, 0, -1, 1, -3, 5, -9, 14, -21, 31, -43, 60,
+     -82, 111, -153, 219, -343, 709, 16320, -617, 293, -179, 118, -81,
+     56, -38, 25, -16, 10, -6, 3, -1, 1, 0, 0},
+    {0, 0, -1, 1, -3, 5, -9, 14, -21, 30, -42, 59,
+     -80, 109, -149, 213, -335, 691, 16322, -602, 287, -174, 116, -79,
+     54, -37, 25, -16, 10, -6, 3, -1, 1, 0, 0},
+    {0, 0, -1, 1, -3, 5, -8, 13, -20, 29, -41, 57,
+     -78, 106, -146, 208, -327, 674, 16325, -588, 280, -170, 113, -77,
+     53, -36, 24, -15, 9, -5, 3, -1, 1, 0, 0},
+    {0, 0, -1, 1, -3, 5, -8, 13, -20, 29, -40, 56,
+     -76, 103, -142, 203, -318, 656, 16327, -574, 273, -166, 110, -75,
+     52, -35, 23, -15, 9, -5, 3, -1, 1, 0, 0},
+    {0, 0, -1, 1, -3, 5, -8, 13, -19, 28, -39, 54,
+     -74, 101, -138, 198, -310, 639, 16330, -560, 266, -162, 107, -73,
+     50, -34, 23, -15, 9, -5, 3, -1, 1, 0, 0},
+    {0, 0, 0, 1, -2, 5, -8, 12, -19, 27, -38, 53,
+     -72, 98, -135, 192, -302, 622, 16332, -546, 259, -158, 104, -71,
+     49, -33, 22, -14, 9, -5, 3, -1, 1, 0, 0},
+    {0, 0, 0, 1, -2, 4, -7, 12, -18, 26, -37, 51,
+     -70, 95, -131, 187, -293, 604, 16335, -532, 252, -153, 102, -69,
+     48, -32, 22, -14, 9, -5, 3, -1, 1, 0, 0},
+    {0, 0, 0, 1, -2, 4, -7, 12, -18, 26, -36, 50,
+     -68, 93, -128, 182, -285, 587, 16337, -518, 246, -149, 99, -68,
+     46, -32, 21, -14, 8, -5, 3, -1, 0, 0, 0},
+    {0, 0, 0, 1, -2, 4, -7, 11, -17, 25, -35, 49,
+     -66, 90, -124, 177, -277, 570, 16339, -503, 239, -145, 96, -66,
+     45, -31, 20, -13, 8, -5, 2, -1, 0, 0, 0},
+    {0, 0, 0, 1, -2, 4, -7, 11, -17, 24, -34, 47,
+     -64, 87, -120, 172, -269, 553, 16341, -489, 232, -141, 93, -64,
+     44, -30, 20, -13, 8, -5, 2, -1, 0, 0, 0},
+    {0, 0, 0, 1, -2, 4, -7, 11, -16, 23, -33, 46,
+     -62, 85, -117, 166, -260, 535, 16343, -475, 225, -137, 90, -62,
+     42, -29, 19, -12, 8, -4, 2, -1, 0, 0, 0},
+    {0, 0, 0, 1, -2, 4, -6, 10, -16, 23, -32, 44,
+     -60, 82, -113, 161, -252, 518, 16345, -460, 218, -132, 88, -60,
+     41, -28, 19, -12, 7, -4, 2, -1, 0, 0, 0},
+    {0, 0, 0, 1, -2, 4, -6, 10, -15, 22, -31, 43,
+     -58, 79, -109, 156, -244, 501, 16347, -446, 211, -128, 85, -58,
+     40, -27, 18, -12, 7, -4, 2, -1, 0, 0, 0},
+    {0, 0, 0, 1, -2, 4, -6, 10, -15, 21, -30, 41,
+     -57, 77, -106, 151, -236, 484, 16349, -432, 204, -124, 82, -56,
+     39, -26, 17, -11, 7, -4, 2, -1, 0, 0, 0},
+    {0, 0, 0, 1, -2, 3, -6, 9, -14, 21, -29, 40,
+     -55, 74, -102, 145, -228, 467, 16351, -417, 197, -120, 79, -54,
+     37, -25, 17, -11, 7, -4, 2, -1, 0, 0, 0},
+    {0, 0, 0, 1, -2, 3, -6, 9, -14, 20, -28, 39,
+     -53, 71, -98, 140, -219, 450, 16353, -403, 190, -116, 76, -52,
+     36, -24, 16, -10, 6, -4, 2, -1, 0, 0, 0},
+    {0, 0, 0, 1, -2, 3, -5, 9, -13, 19, -27, 37,
+     -51, 69, -95, 135, -211, 433, 16355, -388, 183, -111, 74, -50,
+     35, -24, 16, -10, 6, -4, 2, -1, 0, 0, 0},
+    {0, 0, 0, 1, -2, 3, -5, 8, -13, 18, -26, 36,
+     -49, 66, -91, 130, -203, 416, 16357, -374, 176, -107, 71, -48,
+     33, -23, 15, -10, 6, -3, 2, -1, 0, 0, 0},
+    {0, 0, 0, 1, -2, 3, -5, 8, -12, 18, -25, 34,
+     -47, 64, -87, 125, -195, 399, 16358, -359, 169, -103, 68, -46,
+     32, -22, 14, -9, 6, -3, 2, -1, 0, 0, 0},
+    {0, 0, 0, 1, -2, 3, -5, 8, -12, 17, -24, 33,
+     -45, 61, -84, 119, -187, 382, 16360, -345, 163, -99, 65, -45,
+     31, -21, 14, -9, 5, -3, 2, -1, 0, 0, 0},
+    {0, 0, 0, 1, -1, 3, -5, 7, -11, 16, -23, 31,
+     -43, 58, -80, 114, -178, 365, 16362, -330, 156, -94, 62, -43,
+     29, -20, 13, -9, 5, -3, 2, -1, 0, 0, 0},
+    {0, 0, 0, 1, -1, 3, -4, 7, -11, 15, -22, 30,
+     -41, 56, -76, 109, -170, 348, 16363, -315, 149, -90, 60, -41,
+     28, -19, 13, -8, 5, -3, 2, -1, 0, 0, 0},
+    {0, 0, 0, 1, -1, 2, -4, 7, -10, 15, -21, 29,
+     -39, 53, -73, 104, -162, 331, 16365, -301, 142, -86, 57, -39,
+     27, -18, 12, -8, 5, -3, 1, -1, 0, 0, 0},
+    {0, 0, 0, 1, -1, 2, -4, 6, -10, 14, -20, 27,
+     -37, 50, -69, 98, -154, 314, 16366, -286, 135, -82, 54, -37,
+     25, -17, 11, -7, 5, -3, 1, -1, 0, 0, 0},
+    {0, 0, 0, 1, -1, 2, -4, 6, -9, 13, -19, 26,
+     -35, 48, -65, 93, -146, 297, 16367, -271, 128, -77, 51, -35,
+     24, -16, 11, -7, 4, -2, 1, -1, 0, 0, 0},
+    {0, 0, 0, 1, -1, 2, -4, 6, -9, 12, -18, 24,
+     -33, 45, -62, 88, -138, 281, 16369, -256, 121, -73, 48, -33,
+     23, -15, 10, -7, 4, -2, 1, -1, 0, 0, 0},
+    {0, 0, 0, 1, -1, 2, -3, 5, -8, 12, -17, 23,
+     -31, 42, -58, 83, -129, 264, 16370, -241, 114, -69, 45, -31,
+     21, -14, 10, -6, 4, -2, 1, -1, 0, 0, 0},
+    {0, 0, 0, 0, -1, 2, -3, 5, -8, 11, -16, 21,
+     -29, 40, -55, 78, -121, 247, 16371, -227, 106, -65, 43, -29,
+     20, -14, 9, -6, 4, -2, 1, -1, 0, 0, 0},
+    {0, 0, 0, 0, -1, 2, -3, 5, -7, 10, -14, 20,
+     -27, 37, -51, 72, -113, 230, 16373, -212, 99, -60, 40, -27,
+     19, -13, 8, -5, 3, -2, 1, 0, 0, 0, 0},
+    {0, 0, 0, 0, -1, 2, -3, 4, -7, 10, -13, 19,
+     -25, 34, -47, 67, -105, 214, 16374, -197, 92, -56, 37, -25,
+     17, -12, 8, -5, 3, -2, 1, 0, 0, 0, 0},
+    {0, 0, 0, 0, -1, 1, -3, 4, -6, 9, -12, 17,
+     -23, 32, -44, 62, -97, 197, 16375, -182, 85, -52, 34, -23,
+     16, -11, 7, -5, 3, -2, 1, 0, 0, 0, 0},
+    {0, 0, 0, 0, -1, 1, -2, 4, -6, 8, -11, 16,
+     -21, 29, -40, 57, -89, 181, 16376, -167, 78, -47, 31, -21,
+     15, -10, 7, -4, 3, -2, 1, 0, 0, 0, 0},
+    {0, 0, 0, 0, -1, 1, -2, 3, -5, 7, -10, 14,
+     -19, 26, -36, 52, -81, 164, 16377, -152, 71, -43, 28, -19,
+     13, -9, 6, -4, 2, -1, 1, 0, 0, 0, 0},
+    {0, 0, 0, 0, -1, 1, -2, 3, -5, 7, -9, 13,
+     -18, 24, -33, 47, -73, 147, 16378, -137, 64, -39, 26, -17,
+     12, -8, 5, -3, 2, -1, 1, 0, 0, 0, 0},
+    {0, 0, 0, 0, -1, 1, -2, 3, -4, 6, -8, 11,
+     -16, 21, -29, 41, -65, 131, 16379, -122, 57, -35, 23, -16,
+     11, -7, 5, -3, 2, -1, 1, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 1, -1, 2, -4, 5, -7, 10,
+     -14, 18, -25, 36, -56, 114, 16380, -107, 50, -30, 20, -14,
+     9, -6, 4, -3, 2, -1, 1, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 1, -1, 2, -3, 4, -6, 9,
+     -12, 16, -22, 31, -48, 98, 16380, -91, 43, -26, 17, -12,
+     8, -5, 4, -2, 1, -1, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 1, -1, 2, -3, 4, -5, 7,
+     -10, 13, -18, 26, -40, 82, 16381, -76, 36, -22, 14, -10,
+     7, -5, 3, -2, 1, -1, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, -1, 1, -2, 3, -4, 6,
+     -8, 11, -15, 21, -32, 65, 16382, -61, 29, -17, 11, -8,
+     5, -4, 2, -2, 1, -1, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, -1, 1, -2, 2, -3, 4,
+     -6, 8, -11, 15, -24, 49, 16382, -46, 21, -13, 9, -6,
+     4, -3, 2, -1, 1, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 1, -1, 1, -2, 3,
+     -4, 5, -7, 10, -16, 33, 16383, -31, 14, -9, 6, -4,
+     3, -2, 1, -1, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0, -1, 1, -1, 1,
+     -2, 3, -4, 5, -8, 16, 16384, -15, 7, -4, 3, -2,
+     1, -1, 1, 0, 0, 0, 0, 0, 0, 0, 0}
+};
+
+#endif /* __GAUSS_TABLE_H */
@@ -24,6 +24,11 @@
 #ifndef __INTERNAL_MIDI_H
 #define __INTERNAL_MIDI_H
 
+/* every channel and key has at most one note playing, a replay note only
+   takes over its place once the note it replays has ended */
+#define WM_MAX_VOICES (16 * 128)
+#define WM_KEY_BLOCK 32 /* keys added to the note pool at a time */
+
 struct _channel {
     uint8_t bank;
     struct _patch *patch;
@@ -43,12 +48,14 @@ struct _channel {
     uint8_t isdrum;
 };
 
+union _event_value {
+    uint32_t value;
+    char * string;
+};
+
 struct _event_data {
     uint8_t channel;
-    union Data {
-        uint32_t value;
-        char * string;
-    } data;
+    union _event_value data;
 };
 
 struct _note {
@@ -65,17 +72,18 @@ struct _note {
     uint8_t hold;
     uint8_t active;
     struct _note *replay;
-    struct _note *next;
     uint32_t left_mix_volume;
     uint32_t right_mix_volume;
     uint8_t is_off;
     uint8_t ignore_chan_events;
+    /* playing a ping pong loop backwards, and whether it turned yet */
+    uint8_t reverse;
+    uint8_t turned;
 };
 
 struct _mdi;
 
 enum _event_type {
-    ev_null = -1,
     ev_midi_divisions,
     ev_note_off,
     ev_note_on,
@@ -119,39 +127,188 @@ enum _event_type {
     ev_meta_instrumentname,
     ev_meta_lyric,
     ev_meta_marker,
-    ev_meta_cuepoint
+    ev_meta_cuepoint,
+    ev_null     /* ends the event list, has no entry in _WM_event_table */
 };
 
+/*
+ * Events are packed into 8 bytes: the type, which picks the function that
+ * runs it from _WM_event_table, the channel, 16 bits of data and the
+ * samples to wait before the next one. Data that does not fit, the text of
+ * meta events and the odd wide meta value such as a tempo, is kept in
+ * mdi->event_ext instead. Such events have WM_EVENT_EXT set in channel,
+ * its low bits and data then make up the index.
+ */
+#define WM_EVENT_EXT        0x80
+#define WM_EVENT_EXT_MAX    (1UL << 23)
+#define WM_EVENT_EXT_INDEX(ev) \
+    ((((uint32_t) (ev)->channel & 0x7f) << 16) | (ev)->data)
+
 struct _event {
-    enum _event_type evtype;
-    void (*do_event)(struct _mdi *mdi, struct _event_data *data);
-    struct _event_data event_data;
+    uint8_t evtype;     /* enum _event_type */
+    uint8_t channel;
+    uint16_t data;
     uint32_t samples_to_next;
-    uint32_t samples_to_next_fixed;
+};
+
+typedef void (*_WM_EventFunc)(struct _mdi *mdi, struct _event_data *data);
+extern const _WM_EventFunc _WM_event_table[ev_null];
+
+/* a key that is down, or kept sounding by the hold pedal */
+struct _seek_held {
+    uint8_t channel;
+    uint8_t note;
+    uint16_t state;
+};
+
+/* a place playback can be picked up from, see WildMidi_SetSeekIndex() */
+struct _seek_point {
+    uint32_t event;     /* the next event to run */
+    uint32_t sample;    /* the song position it is run at */
+    struct _channel channel[16];
+    char *lyric;
+    uint32_t held;      /* where its keys start in the held list */
+    uint32_t held_count;
+};
+
+struct _seek_index {
+    uint32_t interval;  /* in samples */
+    uint8_t restart_notes;
+    struct _seek_point *point;
+    uint32_t point_count;
+    struct _seek_held *held;
+    uint32_t held_count;
+};
+
+/* where one of the songs of a file starts, see _WM_BuildSongIndex() */
+struct _song_start {
+    uint32_t event;     /* its first event */
+    uint32_t sample;    /* the song position it starts at */
+    struct _channel channel[16];
+    char *lyric;
+};
+
+/*
+ * Messages from WildMidi_Live(), a ring with a single producer that only
+ * moves head and a single consumer, the mixer, that only moves tail.
+ */
+#define WM_LIVE_EVENTS 256 /* a power of 2 */
+
+struct _live_event {
+    uint32_t frame;     /* into the output call that picks it up */
+    uint32_t message;
+};
+
+struct _live_queue {
+    struct _live_event event[WM_LIVE_EVENTS];
+    uint32_t head;
+    uint32_t tail;
+};
+
+struct _WM_Pool;
+struct _WM_TraceEvent;
+struct _bus;
+
+/*
+ * The trace of a handle, see WildMidi_SetTrace(). Whoever holds the lock
+ * of the handle, or is still opening it, is the only one to add to the
+ * ring, WildMidi_ReadTrace() the only one to take from it, so head and tail
+ * are handed over as those of the live queue are.
+ */
+struct _trace {
+    void (*callback)(void *user, const struct _WM_TraceEvent *event);
+    void *user;
+    struct _WM_TraceEvent *ring;    /* mask + 1 events, or NULL */
+    uint32_t mask;
+    uint32_t head;
+    uint32_t tail;
+};
+
+/*
+ * What a song holds on to until it is closed, the text of its meta events,
+ * its notes and its patch map, is carved out of a list of blocks, see
+ * _WM_SongAlloc(). The first block comes with the _mdi itself.
+ */
+struct _song_block {
+    struct _song_block *next;
+    uint32_t size;
+    uint32_t used;
+};
+
+/*
+ * A song parsed once for the handles WildMidi_Instantiate() makes of it,
+ * its mdi is never played. It goes with the last of its references, the
+ * caller's and one for each handle, counted under the context lock.
+ */
+struct _song {
+    struct _mdi *mdi;
+    uint32_t refs;
+    struct _song *prev;
+    struct _song *next;     /* in the list of the context */
 };
 
 struct _mdi {
     int lock;
+    struct _context *ctx;
+    /* the patches of ctx when this was opened, see WildMidi_ReloadConfig() */
+    struct _patch_set *patch_set;
+    struct _song_block *arena; /* the block being carved up */
+    /* the shared song this plays the events of, NULL for one of its own,
+       see _WM_ShareMDI() */
+    struct _song *song;
     uint32_t samples_to_mix;
     struct _event *events;
     struct _event *current_event;
     uint32_t event_count;
     uint32_t events_size; /* try to stay optimally ahead to prevent reallocs */
+    union _event_value *event_ext;  /* see struct _event */
+    uint32_t event_ext_count;
+    uint32_t event_ext_size;
     struct _WM_Info extra_info;
     struct _WM_Info *tmp_info;
     uint16_t midi_master_vol;
     struct _channel channel[16];
-    struct _note *note;
-    struct _note note_table[2][16][128];
+    /* the notes being played, in no particular order */
+    struct _note **voice;
+    uint32_t voice_count;
+    /* most notes played at once, 0 for no limit, see WildMidi_SetPolyphony() */
+    uint32_t max_voices;
+    uint32_t stolen_voices;
+    /* counted as it plays for WildMidi_GetStats() */
+    uint32_t peak_voices;
+    uint64_t events_done;
+    uint64_t clipped;
+    uint64_t render_ns;
+    uint64_t worst_render_ns;
+    /* the mixer.h kernels for the resampling option, picked by
+       _WM_PickMixer() whenever the options change */
+    const struct _WM_Mixer *mixer;
+    /* the two notes of each key come from a pool that grows with the
+       polyphony, see WM_KeyNotes() in internal_midi.c */
+    uint16_t key_map[16][128]; /* pool slot + 1, 0 when the key has none */
+    struct _note *note_block[WM_MAX_VOICES / WM_KEY_BLOCK];
+    uint16_t key_slots; /* in the blocks, there is a voice for each */
+    uint16_t free_key;  /* first unused slot + 1, linked through noteid */
 
     struct _patch **patches;
     uint32_t patch_count;
+    struct _patch_page *patch_map[256];
     int16_t amp;
 
     int32_t *mix_buffer;
     uint32_t mix_buffer_size;
 
     struct _rvb *reverb;
+    struct _rsm *resample; /* of the mix to the output rate, see WM_MixOutput() */
+
+    /* multi-threaded rendering, see WildMidi_SetRenderThreads() */
+    struct _WM_Pool *pool;
+    int32_t *pool_buffer;
+    uint32_t pool_buffer_size;
+
+    /* one accumulator per channel, see WildMidi_RenderStems() */
+    int32_t *stem_buffer;
+    uint32_t stem_buffer_size;
 
     int32_t dyn_vol_peak;
     double dyn_vol_adjust;
@@ -159,10 +316,52 @@ struct _mdi {
     double dyn_vol_to_reach;
 
     uint8_t is_type2;
+    uint8_t events_pruned; /* see WM_MO_PRUNEEVENTS, done the once */
 
     char *lyric;
+
+    struct _seek_index *seek_index;
+
+    /* the songs of a type 2 file, NULL until first asked for */
+    struct _song_start *song_start;
+    uint32_t song_count;
+
+    /* read a window of events at a time, see WM_MO_STREAM in f_midi.c */
+    struct _midi_stream *stream;
+    uint8_t streaming; /* and there is more of the song to read */
+
+    /* mixed into this together with other songs, see WildMidi_BusAdd() */
+    struct _bus *bus;
+
+    /* only set up once WildMidi_Live() is first called */
+    struct _live_queue *live;
+    struct _trace *trace;   /* NULL unless built with WILDMIDI_TRACE */
 };
 
+/*
+ * True while there is an event to do at event, once the window of a
+ * streamed song runs out the next one is read and event moved to it.
+ */
+#define WM_HAVE_EVENT(mdi, event) (((event)->evtype != ev_null) || \
+            ((mdi)->streaming && _WM_StreamMore((mdi), &(event))))
+
+
+/*
+ * Tracing points, nothing at all unless built with WILDMIDI_TRACE and
+ * a test of mdi->trace when not tracing.
+ */
+#ifdef WILDMIDI_TRACE
+extern struct _trace *_WM_NewTrace(uint32_t size, void (*callback)(void *user, const struct _WM_TraceEvent *event), void *user);
+extern void _WM_TracePut(struct _trace *trace, const struct _WM_TraceEvent *event);
+extern void _WM_Trace(struct _mdi *mdi, uint8_t type, uint8_t phase, uint8_t channel, uint32_t arg);
+extern uint32_t _WM_ReadTrace(struct _trace *trace, struct _WM_TraceEvent *events, uint32_t count);
+#define WM_TRACE(mdi, type, phase, channel, arg) do { \
+        if (__builtin_expect(((mdi)->trace != NULL), 0)) \
+            _WM_Trace((mdi), (type), (phase), (channel), (arg)); \
+    } while (0)
+#else
+#define WM_TRACE(mdi, type, phase, channel, arg) do { } while (0)
+#endif
 
 extern int16_t _WM_lin_volume[];
 extern uint32_t _WM_freq_table[];
@@ -232,21 +431,66 @@ extern int _WM_midi_setup_tempo(struct _mdi *mdi, uint32_t setting);
  */
 extern int _WM_midi_setup_divisions(struct _mdi *mdi, uint32_t divisions);
 
+/*
+ * The tracks of a file that have not ended yet, in the order their next
+ * events are due at: by absolute tick, then by track number for those
+ * due at the same tick, which is the order the loaders have always
+ * merged their tracks in. The ticks may wrap, they are only compared by
+ * how far they are past now.
+ */
+struct _track_due {
+    uint32_t tick;          /* the tick the track is next due at */
+    uint32_t track;
+};
+
+struct _track_heap {
+    uint32_t count;
+    uint32_t now;           /* the tick being merged */
+    struct _track_due *due; /* the track due first at 0 */
+};
+
+#define _WM_TrackDue(h) (((h)->count) && ((h)->due[0].tick == (h)->now))
+#define _WM_FirstTrack(h) ((h)->due[0].track)
+
+extern int _WM_AllocTrackHeap(struct _track_heap *heap, uint32_t tracks);
+extern void _WM_FreeTrackHeap(struct _track_heap *heap);
+extern void _WM_AddTrack(struct _track_heap *heap, uint32_t track, uint32_t tick);
+extern void _WM_RequeueTrack(struct _track_heap *heap, uint32_t tick);
+extern void _WM_DropTrack(struct _track_heap *heap);
+extern uint32_t _WM_StepTrackHeap(struct _track_heap *heap);
+
 /* ===================== */
 
 /*
  * All other declarations
  */
 
-extern struct _mdi * _WM_initMDI(void);
+extern struct _mdi * _WM_initMDI(struct _context *ctx);
+extern struct _mdi * _WM_ShareMDI(struct _song *song);
 extern void _WM_freeMDI(struct _mdi *mdi);
+extern void *_WM_SongAlloc(struct _mdi *mdi, uint32_t size);
+extern void _WM_EventData(struct _mdi *mdi, const struct _event *event, struct _event_data *data);
+extern void _WM_DoEvent(struct _mdi *mdi, const struct _event *event);
+extern void _WM_DoLiveEvent(struct _mdi *mdi, uint32_t message);
 extern uint32_t _WM_SetupMidiEvent(struct _mdi *mdi, const uint8_t *event_data, uint32_t inlen, uint8_t running_event);
 extern void _WM_ResetToStart(struct _mdi *mdi);
+extern void _WM_DropEvents(struct _mdi *mdi, const char *keep);
+/* streamed midi, in f_midi.c */
+extern int _WM_StreamMore(struct _mdi *mdi, struct _event **event);
+extern void _WM_RestartStream(struct _mdi *mdi);
+extern void _WM_FreeStream(struct _mdi *mdi);
+extern int _WM_BuildSeekIndex(struct _mdi *mdi, uint32_t interval, uint8_t restart_notes);
+extern void _WM_SeekIndexed(struct _mdi *mdi, uint32_t sample_pos);
+extern void _WM_FreeSeekIndex(struct _mdi *mdi);
+extern int _WM_BuildSongIndex(struct _mdi *mdi);
+extern uint32_t _WM_SongAt(struct _mdi *mdi, uint32_t event);
+extern void _WM_SongSeekSample(struct _mdi *mdi, uint32_t sample_pos);
+extern void _WM_StartSong(struct _mdi *mdi, uint32_t song);
 extern void _WM_do_pan_adjust(struct _mdi *mdi, uint8_t ch);
 extern void _WM_do_note_off_extra(struct _note *nte);
 /* extern void _WM_DynamicVolumeAdjust(struct _mdi *mdi, int32_t *tmp_buffer, uint32_t buffer_used);*/
 extern void _WM_AdjustChannelVolumes(struct _mdi *mdi, uint8_t ch);
-extern float _WM_GetSamplesPerTick(uint32_t divisions, uint32_t tempo);
+extern float _WM_GetSamplesPerTick(uint32_t divisions, uint32_t tempo, uint32_t rate);
 
 #endif /* __INTERNAL_MIDI_H */
 
@@ -31,6 +31,34 @@ extern void _WM_Unlock (int *wmlock);
 #if defined WM_NO_LOCK
 #define _WM_Lock(p) do {} while (0)
 #define _WM_Unlock(p) do {} while (0)
+
+#elif defined WILDMIDI_LOCK_STATS
+#include <stdint.h>
+
+/*
+ * Built with lock statistics every place a lock is taken counts into a
+ * site of its own, named after the lock as it is written there, see
+ * WildMidi_GetLockStats(). Sites that take the same lock of different
+ * structures, say mdi->lock of every handle, count together.
+ */
+struct _WM_LockSite {
+    const char *name;
+    struct _WM_LockSite *next;
+    int registered;
+    uint64_t acquired;
+    uint64_t contended;
+    uint64_t wait_ns;
+    uint64_t max_wait_ns;
+};
+
+struct _WM_LockStats;
+extern void _WM_LockAt (int *wmlock, struct _WM_LockSite *site);
+extern uint32_t _WM_GetLockStats (struct _WM_LockStats *stats, uint32_t count);
+
+#define _WM_Lock(p) do { \
+        static struct _WM_LockSite wm_lock_site = { #p, NULL, 0, 0, 0, 0, 0 }; \
+        _WM_LockAt((p), &wm_lock_site); \
+    } while (0)
 #endif
 
 #endif /* __LOCK_H */
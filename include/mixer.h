@@ -0,0 +1,58 @@
+/*
+ * mixer.h -- Midi Wavetable Processing library
+ *
+ * Copyright (C) WildMIDI Developers 2001-2016
+ *
+ * This file is part of WildMIDI.
+ *
+ * WildMIDI is free software: you can redistribute and/or modify the player
+ * under the terms of the GNU General Public License and you can redistribute
+ * and/or modify the library under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either version 3 of
+ * the licenses, or(at your option) any later version.
+ *
+ * WildMIDI is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License and
+ * the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License and the
+ * GNU Lesser General Public License along with WildMIDI.  If not,  see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __MIXER_H
+#define __MIXER_H
+
+#define FPBITS 10
+#define FPMASK ((1L<<FPBITS)-1L)
+
+struct _note;
+struct _mdi;
+
+/*
+ * Mix count frames of a single note into buffer (interleaved left/right
+ * accumulators). The kernels only step sample_pos and env_level, writing
+ * them back to the note when done, it is up to the caller to hand them
+ * runs in which no loop wraps, no sample ends and no envelope stage
+ * changes before the last frame. For a note playing backwards sample_inc
+ * is the negated increment, so sample_pos has to be stepped modulo 2^32.
+ */
+typedef void (*_WM_MixFunc)(struct _note *nte, int32_t *buffer, uint32_t count);
+
+/* the kernels of a resampler, for notes playing forwards and backwards */
+struct _WM_Mixer {
+    _WM_MixFunc forward;
+    _WM_MixFunc reverse;
+};
+
+extern struct _WM_Mixer _WM_MixLinear;
+extern struct _WM_Mixer _WM_MixGauss;
+
+/* pick the fastest kernels the running cpu supports */
+extern void _WM_InitMixer(void);
+
+/* set mdi->mixer to the kernels for its mixer options */
+extern void _WM_PickMixer(struct _mdi *mdi);
+
+#endif /* __MIXER_H */
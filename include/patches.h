@@ -32,10 +32,26 @@ struct _env {
 
 struct _sample;
 struct _mdi;
+struct _rvb_room;
+
+/* the key range of one sample, kept in sample list order */
+struct _sample_range {
+    uint32_t freq_low;
+    uint32_t freq_high;
+    struct _sample *sample;
+};
+
+/*
+ * Besides 0 (not loaded) and 1 (loaded, or failed to), patch->loaded goes
+ * through these while the songs that want the patch are being opened.
+ */
+#define WM_PATCH_PENDING  2     /* wanted by a song, waiting to be decoded */
+#define WM_PATCH_DECODING 3     /* being decoded, held in patch->lock */
 
 struct _patch {
     uint16_t patchid;
     uint8_t loaded;
+    int lock;
     char *filename;
     int16_t amp;
     uint8_t keep;
@@ -44,14 +60,85 @@ struct _patch {
     uint8_t  note;
     uint32_t inuse_count;
     struct _sample *first_sample;
+    /* the frames of the samples decoded from the .pat file, NULL when
+       they come from the sample cache */
+    uint8_t *sample_pool;
+    uint32_t sample_pool_size;
+    /* built with the samples so a note on scans one small array */
+    struct _sample_range *ranges;
+    uint16_t range_count;
+    /* the heap its samples take, and its place on the idle list of the
+       patch set while no song uses it, see _WM_unuse_patch() */
+    uint32_t sample_bytes;
+    uint8_t idle;
+    struct _patch *idle_prev;
+    struct _patch *idle_next;
     struct _patch *next;
 };
 
-extern struct _patch *_WM_patch[128];
+/*
+ * What the patch ids of one bank resolve to for a single song. Filled in
+ * by _WM_load_patch() while the song is parsed, so playback finds its
+ * patches without going near the patch set lock.
+ */
+struct _patch_page {
+    struct _patch *patch[256];
+    uint8_t resolved[256];
+};
+
+/*
+ * The patches of one config file, loaded for one sample rate. Contexts set
+ * up with the same config file and rate share a single set, along with all
+ * the sample data decoded for it.
+ */
+struct _patch_set {
+    int refs;
+    char *config_file;
+    uint32_t rate;
+    int lock;
+    struct _patch *patch[128];
+
+    /* config file settings */
+    int fix_release;
+    int auto_amp;
+    int auto_amp_with_amp;
+    float reverb_room_width;
+    float reverb_room_length;
+    float reverb_listen_posx;
+    float reverb_listen_posy;
+    /* worked out from the above when a song first wants reverb */
+    struct _rvb_room *reverb_room;
 
-extern int _WM_patch_lock;
+    /* see sample_cache.h */
+    char *cache_file;
+    uint32_t config_hash;
+    const uint8_t *cache;
+    uint32_t cache_size;
+
+    /* patches no song uses keep their samples while they fit in
+       sample_budget bytes, the least recently used go first. With no
+       budget they go as soon as the last song using them is closed. */
+    size_t sample_budget;
+    size_t resident;
+    uint32_t hits;
+    uint32_t misses;
+    struct _patch *idle_first;
+    struct _patch *idle_last;
+
+    struct _patch_set *next;
+};
 
 extern struct _patch *_WM_get_patch_data(struct _mdi *mdi, uint16_t patchid);
 extern void _WM_load_patch(struct _mdi *mdi, uint16_t patchid);
+extern void _WM_decode_patches(struct _mdi *mdi);
+extern int _WM_hold_patches(struct _mdi *mdi, struct _patch ***list, uint32_t *count);
+extern void _WM_release_patches(struct _patch_set *patches, struct _patch **list, uint32_t count);
+extern void _WM_unuse_patch(struct _patch_set *patches, struct _patch *patch);
+
+/* patch set references, see wildmidi_lib.c */
+struct _context;
+extern struct _patch_set *_WM_CurrentPatchSet(struct _context *ctx);
+extern void _WM_HoldPatchSet(struct _patch_set *patches);
+extern void _WM_PutPatchSet(struct _patch_set *patches);
 
 #endif /* __PATCHES_H */
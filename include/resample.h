@@ -0,0 +1,63 @@
+/*
+ * resample.h -- Midi Wavetable Processing library
+ *
+ * Copyright (C) WildMIDI Developers 2001-2016
+ *
+ * This file is part of WildMIDI.
+ *
+ * WildMIDI is free software: you can redistribute and/or modify the player
+ * under the terms of the GNU General Public License and you can redistribute
+ * and/or modify the library under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either version 3 of
+ * the licenses, or(at your option) any later version.
+ *
+ * WildMIDI is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License and
+ * the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License and the
+ * GNU Lesser General Public License along with WildMIDI.  If not,  see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __RESAMPLE_H
+#define __RESAMPLE_H
+
+/* the input frames each output frame is made of, and the filters for the
+   positions in between two input frames it can be at */
+#define RSM_TAPS        16
+#define RSM_PHASE_BITS  9
+#define RSM_PHASES      (1 << RSM_PHASE_BITS)
+#define RSM_SHIFT       14  /* fraction bits of the coefficients */
+
+/* what the two rates make of the filter, shared by all its users */
+struct _rsm_filter {
+    uint32_t in_rate;
+    uint32_t out_rate;
+    uint64_t step;      /* input frames between output frames, 32.32 */
+    int16_t coeff[RSM_PHASES][RSM_TAPS];
+};
+
+struct _rsm {
+    const struct _rsm_filter *filter;
+    /* stereo input frames, the first of them are what is left of earlier
+       calls, and the output of the last call */
+    int32_t *in;
+    uint32_t in_size;   /* in frames */
+    uint32_t have;
+    int32_t *out;
+    uint32_t out_size;
+    uint64_t pos;       /* of the next output frame past in[0], 32.32 */
+    uint32_t quiet;     /* frames of silence at the end of in */
+};
+
+extern struct _rsm_filter *_WM_init_resample_filter(uint32_t in_rate, uint32_t out_rate);
+extern struct _rsm *_WM_init_resample(const struct _rsm_filter *filter);
+extern void _WM_reset_resample(struct _rsm *rsm);
+extern void _WM_free_resample(struct _rsm *rsm);
+extern uint32_t _WM_resample_needs(const struct _rsm *rsm, uint32_t frames);
+extern int32_t *_WM_resample_input(struct _rsm *rsm, uint32_t frames, int silent);
+extern uint32_t _WM_do_resample(struct _rsm *rsm, uint32_t frames, int *silent);
+
+#endif /* __RESAMPLE_H */
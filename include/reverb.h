@@ -25,30 +25,52 @@
 #ifndef __REVERB_H
 #define __REVERB_H
 
+/* 8 reflective points with 6 band filters each, all fed the same input */
+#define RVB_FILTERS 48
+
+struct _rvb;
+
+typedef void (*_WM_ReverbFilter)(struct _rvb *rvb, int32_t *l_val, int32_t *r_val);
+
+/* what the rate and the room make of the reverb, shared by all its users */
+struct _rvb_room {
+    /* filter data, one column per filter so they can be run side by side */
+    int32_t coeff[5][RVB_FILTERS];
+    _WM_ReverbFilter filter;
+    /* buffer sizes are powers of 2 */
+    int l_buf_size;
+    int r_buf_size;
+    /* where the taps start off in the buffers */
+    int l_sp_in[8];
+    int r_sp_in[8];
+    int l_in[4];
+    int r_in[4];
+    int gain;
+};
+
 struct _rvb {
-    /* filter data */
-    int32_t l_buf_flt_in[8][6][2];
-    int32_t l_buf_flt_out[8][6][2];
-    int32_t r_buf_flt_in[8][6][2];
-    int32_t r_buf_flt_out[8][6][2];
-    int32_t coeff[8][6][5];
-    /* buffer data */
+    const struct _rvb_room *room;
+    int32_t l_buf_flt_out[2][RVB_FILTERS];
+    int32_t r_buf_flt_out[2][RVB_FILTERS];
+    int32_t l_buf_flt_in[2];
+    int32_t r_buf_flt_in[2];
     int32_t *l_buf;
     int32_t *r_buf;
-    int l_buf_size;
-    int r_buf_size;
     int l_out;
     int r_out;
     int l_sp_in[8];
     int r_sp_in[8];
     int l_in[4];
     int r_in[4];
-    int gain;
-    uint32_t max_reverb_time;
+    /* frames since anything went into the delay lines, and whether they
+       and the filters have since been drained to silence */
+    int quiet;
+    int idle;
 };
 
+extern struct _rvb_room *_WM_init_reverb_room(int rate, float room_x, float room_y, float listen_x, float listen_y);
 extern void _WM_reset_reverb (struct _rvb *rvb);
-extern struct _rvb *_WM_init_reverb(int rate, float room_x, float room_y, float listen_x, float listen_y);
+extern struct _rvb *_WM_init_reverb(const struct _rvb_room *room);
 extern void _WM_free_reverb (struct _rvb *rvb);
 extern void _WM_do_reverb (struct _rvb *rvb, int32_t *buffer, int size);
 
@@ -33,6 +33,17 @@
 #define SAMPLE_ENVELOPE  0x40
 #define SAMPLE_CLAMPED   0x80
 
+/* zeroed frames kept on both sides of the sample data, enough for the
+   gauss resampler window to be read anywhere inside the sample */
+#define SAMPLE_GUARD     32
+
+/* the samples of a patch share one pool, each of them taking a slot of
+   the frames and their guards starting on a SAMPLE_POOL_ALIGN boundary */
+#define SAMPLE_POOL_ALIGN 64
+#define SAMPLE_POOL_SLOT(frames) \
+    ((((frames) + (SAMPLE_GUARD * 2)) * sizeof(int16_t) + (SAMPLE_POOL_ALIGN - 1)) \
+     & ~(uint32_t)(SAMPLE_POOL_ALIGN - 1))
+
 #ifdef DEBUG_SAMPLES
 #define SAMPLE_CONVERT_DEBUG(dx) printf("\r%s\n",dx)
 #else
@@ -40,6 +51,7 @@
 #endif
 
 struct _patch;
+struct _patch_set;
 struct _mdi;
 
 struct _sample {
@@ -56,18 +68,20 @@ struct _sample {
     int32_t env_rate[7];
     int32_t env_target[7];
     uint32_t inc_div;
-    int16_t *data;
+    int16_t *data;      /* in the pool of the patch or the sample cache */
     struct _sample *next;
 
     uint32_t note_off_decay;
 };
 
-extern int _WM_fix_release;
-extern int _WM_auto_amp;
-extern int _WM_auto_amp_with_amp;
-
+extern uint8_t *_WM_alloc_sample_pool(uint32_t size);
+extern void _WM_free_sample_pool(uint8_t *pool);
 extern struct _sample *_WM_get_sample_data(struct _patch *sample_patch, uint32_t freq);
-extern int _WM_load_sample(struct _patch *sample_patch);
+extern void _WM_free_samples(struct _patch *sample_patch);
+extern uint32_t _WM_sample_bytes(struct _patch *sample_patch);
+extern int _WM_load_sample(struct _patch_set *patches, struct _patch *sample_patch);
+extern int _WM_decode_sample(struct _patch_set *patches, struct _patch *sample_patch);
+extern int _WM_build_ranges(struct _patch *sample_patch);
 extern uint32_t _WM_get_decay_samples(struct _mdi * mdi, uint8_t channel, uint8_t note);
 
 #endif /* __SAMPLE_H */
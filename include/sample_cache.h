@@ -0,0 +1,55 @@
+/*
+ * sample_cache.h -- Midi Wavetable Processing library
+ *
+ * Copyright (C) WildMIDI Developers 2001-2016
+ *
+ * This file is part of WildMIDI.
+ *
+ * WildMIDI is free software: you can redistribute and/or modify the player
+ * under the terms of the GNU General Public License and you can redistribute
+ * and/or modify the library under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either version 3 of
+ * the licenses, or(at your option) any later version.
+ *
+ * WildMIDI is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License and
+ * the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License and the
+ * GNU Lesser General Public License along with WildMIDI.  If not,  see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __SAMPLE_CACHE_H
+#define __SAMPLE_CACHE_H
+
+/*
+ * The sample cache holds the samples of every patch of a patch set the way
+ * _WM_load_sample() leaves them, converted, with their envelopes worked out
+ * for the rate of the set and any amp or auto_amp applied. Loading a patch
+ * from it opens no .pat file and copies no frames, the samples use the
+ * frames in the cache where they are.
+ *
+ * A cache only fits the config it was written for: it is keyed to the text
+ * of the config files read and the sample rate, and ignored when either
+ * differs. It has to be written again after changing any of the patches.
+ */
+
+/* bump whenever the layout of the cache file changes */
+#define WM_CACHE_VERSION 2
+
+struct _patch;
+struct _patch_set;
+
+/* the key of the config text, feed it every config file read */
+#define WM_CACHE_HASH_INIT 2166136261U
+extern uint32_t _WM_CacheHash(uint32_t hash, const void *data, uint32_t size);
+
+extern void _WM_OpenSampleCache(struct _patch_set *patches);
+extern void _WM_CloseSampleCache(struct _patch_set *patches);
+extern int _WM_LoadCachedSample(struct _patch_set *patches, struct _patch *sample_patch);
+extern int _WM_WriteSampleCache(struct _patch_set *patches, const char *cache_file);
+
+#endif /* __SAMPLE_CACHE_H */
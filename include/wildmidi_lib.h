@@ -38,6 +38,8 @@
 #define WM_MO_ENHANCED_RESAMPLING 0x0002
 #define WM_MO_REVERB            0x0004
 #define WM_MO_LOOP              0x0008
+#define WM_MO_PRUNEEVENTS       0x0400
+#define WM_MO_STREAM            0x0800
 #define WM_MO_SAVEASTYPE0       0x1000
 #define WM_MO_ROUNDTEMPO        0x2000
 #define WM_MO_STRIPSILENCE      0x4000
@@ -50,6 +52,14 @@
 /* for WildMidi_GetString */
 #define WM_GS_VERSION           0x0001
 
+/* sample formats for WildMidi_Render, interleaved stereo in host byte order */
+#define WM_FMT_S16              0x0001
+#define WM_FMT_S32              0x0002
+#define WM_FMT_FLOAT            0x0003
+#define WM_FMT_U8               0x0004
+/* unsigned 8bit too, the average of both channels */
+#define WM_FMT_U8_MONO          0x0005
+
 /* set our symbol export visiblity */
 #if defined _WIN32 || defined __CYGWIN__
   /* ========== NOTE TO WINDOWS DEVELOPERS:
@@ -96,7 +106,95 @@ struct _WM_Info {
     uint32_t total_midi_time;
 };
 
+/* where a song of a type 2 or multi song file is, see WildMidi_GetSongInfo() */
+struct _WM_SongInfo {
+    uint32_t start_sample;  /* the output sample the song starts at */
+    uint32_t total_samples; /* how long it plays for */
+};
+
+/* what WildMidi_GetTimeline() reports, the flags of its types */
+#define WM_TIMELINE_LYRIC    0x0001
+#define WM_TIMELINE_TEXT     0x0002
+#define WM_TIMELINE_MARKER   0x0004
+#define WM_TIMELINE_CUEPOINT 0x0008
+#define WM_TIMELINE_TEMPO    0x0010
+#define WM_TIMELINE_TIMESIG  0x0020
+#define WM_TIMELINE_ALL      0x003f
+
+struct _WM_TimelineEvent {
+    uint32_t sample;    /* the output sample it is played at */
+    uint32_t value;     /* tempo: microseconds a quarter note,
+                           time signature: nn << 24 | dd << 16 | cc << 8 | bb */
+    const char *text;   /* the text, NULL for tempo and time signature */
+    uint16_t type;      /* WM_TIMELINE_LYRIC ... */
+};
+
+/* the sample memory of a config, see WildMidi_GetSampleStats() */
+struct _WM_SampleStats {
+    uint32_t budget;    /* kilobytes of samples held before unused patches go */
+    uint32_t resident;  /* kilobytes of decoded samples held */
+    uint32_t hits;      /* patches a song found already decoded */
+    uint32_t misses;    /* patches that had to be decoded for a song */
+};
+
+/* what a midi handle has been doing, see WildMidi_GetStats() */
+struct _WM_Stats {
+    uint32_t voices;          /* notes playing now */
+    uint32_t peak_voices;     /* most notes played at once */
+    uint32_t stolen_voices;   /* notes cut short for the polyphony limit */
+    uint32_t worst_render_us; /* longest a single render call took */
+    uint64_t events;          /* midi events played */
+    uint64_t clipped;         /* output samples beyond the 16 bit range */
+    uint64_t render_us;       /* time spent rendering in all */
+    uint64_t sample_bytes;    /* decoded samples of the patches held */
+    uint64_t event_bytes;     /* the events and text of the song held */
+};
+
+/* how a lock of the library has been taken, see WildMidi_GetLockStats() */
+struct _WM_LockStats {
+    const char *name;         /* the lock as the library sources name it */
+    uint64_t acquired;        /* times it was taken */
+    uint64_t contended;       /* times another thread held it */
+    uint64_t wait_us;         /* time spent waiting for it in all */
+    uint64_t max_wait_us;     /* longest a single wait took */
+};
+
+/* what WildMidi_SetTrace() records, and what arg is for each */
+#define WM_TRACE_NOTE_ON    1   /* note << 8 | velocity */
+#define WM_TRACE_NOTE_OFF   2   /* note */
+#define WM_TRACE_EVENT      3   /* the type of event played */
+#define WM_TRACE_PATCH_LOAD 4   /* the patch id */
+#define WM_TRACE_MIX        5   /* the frames mixed */
+
+/* the phase of a trace event, patch loads and mixing have a begin and end */
+#define WM_TRACE_INSTANT    0
+#define WM_TRACE_BEGIN      1
+#define WM_TRACE_END        2
+
+struct _WM_TraceEvent {
+    uint64_t time;      /* nanoseconds of a monotonic clock */
+    uint32_t arg;
+    uint8_t type;       /* WM_TRACE_NOTE_ON ... */
+    uint8_t phase;      /* WM_TRACE_INSTANT, WM_TRACE_BEGIN or WM_TRACE_END */
+    uint8_t channel;
+    uint8_t thread;     /* 0, or the worker a patch was loaded on */
+};
+
+/* conversion options for a single WildMidi_ConvertToMidiOpt() or
+ * WildMidi_ConvertBufferToMidiOpt() call, as WM_CO_XMI_TYPE and
+ * WM_CO_FREQUENCY set them for all the others */
+struct _WM_CvtOptions {
+    uint16_t xmi_convert_type;
+    uint16_t frequency;
+};
+
 typedef void midi;
+typedef void wm_context;
+typedef void wm_song;
+typedef void wm_bus;
+
+/* the gain of a handle on a bus that leaves it as loud as it is */
+#define WM_BUS_UNITY            0x0100
 
 typedef void * (*_WM_VIO_Allocate)(const char *, uint32_t *);
 typedef void   (*_WM_VIO_Free)(void *);
@@ -119,38 +217,128 @@ struct _WM_VIO {
     _WM_VIO_Free free_file;
 };
 
+typedef const void * (*_WM_VIO_MapFile)(const char *, uint32_t *);
+typedef void   (*_WM_VIO_UnmapFile)(const void *, uint32_t);
+
+struct _WM_VIO_Map {
+    /*
+    This function should return a read-only view of the requested
+    file, for instance a memory mapping of it, and fill the second
+    parameter with the size of the file. Unlike allocate_file the
+    view needs neither the extra byte nor to be writable.
+
+    Midi files and instrument patches are loaded through it, the
+    configuration files still go through allocate_file.
+    */
+    _WM_VIO_MapFile map_file;
+
+    /*
+    This function should release the view returned by map_file,
+    it is passed the size map_file returned.
+    */
+    _WM_VIO_UnmapFile unmap_file;
+};
+
+struct _WM_BatchSink {
+    /*
+    This function is called when a job of WildMidi_RenderBatch starts,
+    with the index of its file in the list and the info of the song.
+    It should return what write and close are to be passed, or NULL
+    if it cannot take the song, which then counts as failed. When the
+    file cannot be opened, info is NULL and the return value is ignored.
+    */
+    void * (*open)(void *user, uint32_t job, const char *midifile, const struct _WM_Info *info);
+
+    /*
+    This function gets the audio of the song in order, frames of it
+    in the format asked for. A nonzero return stops the song.
+    */
+    int (*write)(void *out, const void *data, uint32_t frames);
+
+    /*
+    This function ends the song, status is 0 if all of it was written
+    and -1 otherwise.
+    */
+    void (*close)(void *out, int status);
+};
+
 WM_SYMBOL const char * WildMidi_GetString (uint16_t info);
 WM_SYMBOL long WildMidi_GetVersion (void);
+WM_SYMBOL int WildMidi_GetLockStats (struct _WM_LockStats *stats, uint32_t count);
 WM_SYMBOL int WildMidi_Init (const char *config_file, uint16_t rate, uint16_t mixer_options);
 WM_SYMBOL int WildMidi_InitVIO(struct _WM_VIO * callbacks, const char *config_file, uint16_t rate, uint16_t mixer_options);
+WM_SYMBOL int WildMidi_InitVIOMap(struct _WM_VIO * callbacks, struct _WM_VIO_Map * map_callbacks, const char *config_file, uint16_t rate, uint16_t mixer_options);
 WM_SYMBOL int WildMidi_MasterVolume (uint8_t master_volume);
+WM_SYMBOL int WildMidi_SaveSampleCache (const char *cache_file);
+WM_SYMBOL int WildMidi_ReloadConfig (const char *config_file);
+WM_SYMBOL int WildMidi_GetSampleStats (struct _WM_SampleStats *stats);
 WM_SYMBOL midi * WildMidi_Open (const char *midifile);
 WM_SYMBOL midi * WildMidi_OpenBuffer (const uint8_t *midibuffer, uint32_t size);
+WM_SYMBOL int WildMidi_OpenAsync (const char *midifile, void (*done)(void *user, midi *handle), void *user);
+WM_SYMBOL int WildMidi_PreloadPatches (const uint16_t *patchids, uint32_t count);
+WM_SYMBOL int WildMidi_Probe (const uint8_t *midibuffer, uint32_t size, struct _WM_Info *info);
+WM_SYMBOL wm_context * WildMidi_CreateContext (const char *config_file, uint16_t rate, uint16_t mixer_options);
+WM_SYMBOL wm_context * WildMidi_CreateContextRate (const char *config_file, uint32_t rate, uint32_t mix_rate, uint16_t mixer_options);
+WM_SYMBOL int WildMidi_FreeContext (wm_context *context);
+WM_SYMBOL int WildMidi_MasterVolumeCtx (wm_context *context, uint8_t master_volume);
+WM_SYMBOL int WildMidi_SaveSampleCacheCtx (wm_context *context, const char *cache_file);
+WM_SYMBOL int WildMidi_ReloadConfigCtx (wm_context *context, const char *config_file);
+WM_SYMBOL int WildMidi_GetSampleStatsCtx (wm_context *context, struct _WM_SampleStats *stats);
+WM_SYMBOL int WildMidi_SetTraceCtx (wm_context *context, uint32_t ring_size, void (*callback)(void *user, const struct _WM_TraceEvent *event), void *user);
+WM_SYMBOL midi * WildMidi_OpenCtx (wm_context *context, const char *midifile);
+WM_SYMBOL midi * WildMidi_OpenBufferCtx (wm_context *context, const uint8_t *midibuffer, uint32_t size);
+WM_SYMBOL int WildMidi_OpenAsyncCtx (wm_context *context, const char *midifile, void (*done)(void *user, midi *handle), void *user);
+WM_SYMBOL int WildMidi_PreloadPatchesCtx (wm_context *context, const uint16_t *patchids, uint32_t count);
+WM_SYMBOL int WildMidi_ProbeCtx (wm_context *context, const uint8_t *midibuffer, uint32_t size, struct _WM_Info *info);
+WM_SYMBOL int WildMidi_RenderBatchCtx (wm_context *context, const char * const *midifiles, uint32_t count, uint8_t threads, uint16_t format, const struct _WM_BatchSink *sink, void *user);
+WM_SYMBOL wm_song * WildMidi_Parse (const uint8_t *midibuffer, uint32_t size);
+WM_SYMBOL wm_song * WildMidi_ParseCtx (wm_context *context, const uint8_t *midibuffer, uint32_t size);
+WM_SYMBOL midi * WildMidi_Instantiate (wm_song *song);
+WM_SYMBOL int WildMidi_ReleaseSong (wm_song *song);
 WM_SYMBOL int WildMidi_GetMidiOutput (midi *handle, int8_t **buffer, uint32_t *size);
+WM_SYMBOL int WildMidi_WriteMidi (midi *handle, int (*write_fn)(void *ctx, const uint8_t *data, uint32_t size), void *ctx);
 WM_SYMBOL int WildMidi_GetOutput (midi *handle, int8_t *buffer, uint32_t size);
+WM_SYMBOL int WildMidi_GetOutputFloat (midi *handle, float *buffer, uint32_t count);
+WM_SYMBOL int WildMidi_GetOutputS32 (midi *handle, int32_t *buffer, uint32_t count);
+WM_SYMBOL int WildMidi_Render (midi *handle, uint32_t frames, void *out, uint16_t format);
+WM_SYMBOL int WildMidi_RenderStems (midi *handle, uint32_t frames, void *out, void **stems, uint16_t format);
+WM_SYMBOL wm_bus * WildMidi_CreateBus (uint16_t options);
+WM_SYMBOL int WildMidi_FreeBus (wm_bus *bus);
+WM_SYMBOL int WildMidi_BusAdd (wm_bus *bus, midi *handle, uint16_t gain);
+WM_SYMBOL int WildMidi_BusRemove (wm_bus *bus, midi *handle);
+WM_SYMBOL int WildMidi_BusRender (wm_bus *bus, uint32_t frames, void *out, uint16_t format);
+WM_SYMBOL int WildMidi_RenderBatch (const char * const *midifiles, uint32_t count, uint8_t threads, uint16_t format, const struct _WM_BatchSink *sink, void *user);
 WM_SYMBOL int WildMidi_SetOption (midi *handle, uint16_t options, uint16_t setting);
+WM_SYMBOL int WildMidi_SetRenderThreads (midi *handle, uint8_t threads);
+WM_SYMBOL int WildMidi_SetPolyphony (midi *handle, uint16_t voices);
+WM_SYMBOL long WildMidi_GetStolenVoices (midi *handle);
+WM_SYMBOL int WildMidi_GetStats (midi *handle, struct _WM_Stats *stats);
+WM_SYMBOL int WildMidi_SetTrace (midi *handle, uint32_t ring_size, void (*callback)(void *user, const struct _WM_TraceEvent *event), void *user);
+WM_SYMBOL int WildMidi_ReadTrace (midi *handle, struct _WM_TraceEvent *events, uint32_t count);
+WM_SYMBOL int WildMidi_Live (midi *handle, uint32_t midi_event, uint32_t frame);
 WM_SYMBOL int WildMidi_SetCvtOption (uint16_t tag, uint16_t setting);
 WM_SYMBOL int WildMidi_ConvertToMidi (const char *file, uint8_t **out, uint32_t *size);
 WM_SYMBOL int WildMidi_ConvertBufferToMidi (const uint8_t *in, uint32_t insize,
                                             uint8_t **out, uint32_t *size);
+WM_SYMBOL int WildMidi_ConvertToMidiOpt (const char *file, uint8_t **out, uint32_t *size,
+                                         const struct _WM_CvtOptions *options);
+WM_SYMBOL int WildMidi_ConvertBufferToMidiOpt (const uint8_t *in, uint32_t insize,
+                                               uint8_t **out, uint32_t *size,
+                                               const struct _WM_CvtOptions *options);
 WM_SYMBOL struct _WM_Info * WildMidi_GetInfo (midi * handle);
 WM_SYMBOL int WildMidi_FastSeek (midi * handle, unsigned long int *sample_pos);
+WM_SYMBOL int WildMidi_SetSeekIndex (midi * handle, uint16_t interval, uint8_t restart_notes);
 WM_SYMBOL int WildMidi_SongSeek (midi * handle, int8_t nextsong);
+WM_SYMBOL int WildMidi_GetSongInfo (midi * handle, uint32_t song, struct _WM_SongInfo *info);
 WM_SYMBOL int WildMidi_Close (midi * handle);
 WM_SYMBOL int WildMidi_Shutdown (void);
 WM_SYMBOL char * WildMidi_GetLyric (midi * handle);
+WM_SYMBOL int WildMidi_GetTimeline (midi * handle, uint16_t types, void (*callback)(void *user, const struct _WM_TimelineEvent *event), void *user);
 
 WM_SYMBOL char * WildMidi_GetError (void);
 WM_SYMBOL void WildMidi_ClearError (void);
 
 
-/* NOTE: Not Yet Implemented Or Tested Properly */
-/* Due to delay in audio output in the player, this is not being developed
-   futher at the moment. Further Development will occur when output latency
-   has been reduced enough to "appear" instant.
-WM_SYMBOL int WildMidi_Live (midi * handle, uint32_t midi_event);
- */
-
 /* reserved for future coding
  * need to change these to use a time for cmd_pos and new_cmd_pos
 
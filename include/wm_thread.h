@@ -0,0 +1,71 @@
+/*
+ * wm_thread.h -- Midi Wavetable Processing library
+ *
+ * Copyright (C) WildMIDI Developers 2001-2016
+ *
+ * This file is part of WildMIDI.
+ *
+ * WildMIDI is free software: you can redistribute and/or modify the player
+ * under the terms of the GNU General Public License and you can redistribute
+ * and/or modify the library under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either version 3 of
+ * the licenses, or(at your option) any later version.
+ *
+ * WildMIDI is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License and
+ * the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License and the
+ * GNU Lesser General Public License along with WildMIDI.  If not,  see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __WM_THREAD_H
+#define __WM_THREAD_H
+
+/*
+ * A small pool of worker threads. _WM_PoolRun() calls job once for every
+ * thread of the pool, with worker numbers 0 to threads - 1. Worker 0 is
+ * the calling thread itself, the call returns once all of them finished.
+ *
+ * Only available when built with thread support (WM_HAVE_THREADS below),
+ * otherwise _WM_PoolCreate() always fails.
+ */
+#if defined(HAVE_PTHREAD) || defined(HAVE_WIN32_THREADS)
+#define WM_HAVE_THREADS 1
+#endif
+
+/* most threads a pool may have, the caller included */
+#define WM_MAX_THREADS 64
+
+struct _WM_Pool;
+
+typedef void (*_WM_PoolJob)(void *data, int worker);
+
+/* how many cpus the system has online, 1 without thread support */
+extern int _WM_CpuCount(void);
+
+extern struct _WM_Pool *_WM_PoolCreate(int threads);
+extern int _WM_PoolThreads(struct _WM_Pool *pool);
+extern void _WM_PoolRun(struct _WM_Pool *pool, _WM_PoolJob job, void *data);
+extern void _WM_PoolFree(struct _WM_Pool *pool);
+
+/*
+ * A thread of its own that runs the jobs posted to it one at a time, in
+ * the order they came. _WM_QueuePost() returns right away, _WM_QueueFree()
+ * runs what is still queued before it returns. Without thread support
+ * _WM_QueueCreate() always fails.
+ */
+struct _WM_Queue;
+
+typedef void (*_WM_QueueJob)(void *data);
+
+extern struct _WM_Queue *_WM_QueueCreate(void);
+extern int _WM_QueuePost(struct _WM_Queue *queue, _WM_QueueJob job, void *data);
+extern void _WM_QueueFree(struct _WM_Queue *queue);
+
+/* nanoseconds since some point in the past, for timing things */
+extern uint64_t _WM_Clock(void);
+
+#endif /* __WM_THREAD_H */
@@ -14,6 +14,15 @@
 #define __builtin_expect(x,c) x
 #endif
 
+/* atomic lock operations, sleeping on a futex where there is one */
+#define HAVE___ATOMIC_BUILTINS
+
+/* thread support used by multi-threaded rendering */
+#define HAVE_PTHREAD
+
+/* files are loaded with mmap() */
+#define HAVE_MMAP
+
 #if defined(__POWERPC__) || defined(__ppc__) || defined(__BIG_ENDIAN__)
 #define WORDS_BIGENDIAN 1
 #endif
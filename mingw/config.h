@@ -14,5 +14,8 @@
 #define __builtin_expect(x,c) x
 #endif
 
+/* thread support used by multi-threaded rendering */
+#define HAVE_WIN32_THREADS
+
 #define HAVE_STDINT_H 1
 #define HAVE_INTTYPES_H 1
@@ -11,6 +11,8 @@
  * NOTE: This file is intended for developer use to aide in
  *       feature development, and bug hunting.
  * COMPILING: gcc -Wall -W -O2 -o devtest DevTest.c
+ *       add -DDT_HAVE_PTHREAD -pthread to scan on several threads, and
+ *       -DDT_WITH_LIBRARY -lWildMidi for --library
  *
  * Copyright (C) WildMIDI Developers 2001-2016
  *
@@ -40,10 +42,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdarg.h>
+#include <time.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 
 #ifdef _WIN32
+#include <windows.h>
 #include <getopt_long.h>
 #include <io.h>
 #undef close
@@ -56,17 +61,85 @@
 #include <unistd.h>
 #include <pwd.h>
 #include <getopt.h>
+#include <dirent.h>
+#include <sys/mman.h>
+#ifdef DT_HAVE_PTHREAD
+#include <pthread.h>
+#endif
+#endif
+
+#ifdef DT_WITH_LIBRARY
+#include "wildmidi_lib.h"
 #endif
 
 #define WMIDI_UNUSED(x) (void)(x)
 
 static struct option const long_options[] = {
     { "debug-level", 1, 0, 'd' },
+    { "scan", 0, 0, 's' },
+    { "jobs", 1, 0, 'j' },
+#ifdef DT_WITH_LIBRARY
+    { "library", 0, 0, 'l' },
+#endif
     { "version", 0, 0, 'v' },
     { "help", 0, 0, 'h' },
     { NULL, 0, NULL, 0 }
 };
 
+/*
+ * A scan checks files on several threads, each with the state of the
+ * checks below of its own, and what they would print about a file is
+ * kept to show with the summary rather than printed as it comes.
+ */
+#if defined(_MSC_VER)
+#define DT_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__) || defined(__clang__)
+#define DT_THREAD_LOCAL __thread
+#endif
+
+#if defined(DT_THREAD_LOCAL) && (defined(_WIN32) || defined(DT_HAVE_PTHREAD))
+#define DT_THREADS 1
+#else
+#undef DT_THREAD_LOCAL
+#define DT_THREAD_LOCAL
+#endif
+
+#if defined(_MSC_VER) && (_MSC_VER < 1900)
+#define vsnprintf _vsnprintf
+#endif
+
+#define DT_REPORT_SIZE 1024
+
+static DT_THREAD_LOCAL char *dt_report = NULL;
+static DT_THREAD_LOCAL size_t dt_report_len = 0;
+
+static int DT_Printf(const char *fmt, ...) {
+    va_list args;
+    int ret;
+
+    va_start(args, fmt);
+    if (dt_report == NULL) {
+        ret = vprintf(fmt, args);
+    } else {
+        /* only as much as fits, the start says what went wrong */
+        if (dt_report_len < (DT_REPORT_SIZE - 1)) {
+            ret = vsnprintf(dt_report + dt_report_len, DT_REPORT_SIZE - dt_report_len, fmt, args);
+            if (ret > 0) {
+                dt_report_len += ret;
+                if (dt_report_len > (DT_REPORT_SIZE - 1)) {
+                    dt_report_len = DT_REPORT_SIZE - 1;
+                }
+            }
+        } else {
+            ret = 0;
+        }
+    }
+    va_end(args);
+    return ret;
+}
+
+#define printf DT_Printf
+
 #define EVENT_DATA_8BIT 1
 
 
@@ -128,6 +201,12 @@ static void do_version(void) {
 static void do_help(void) {
     do_version();
     printf(" -d N   --debug-level N    Verbose output\n");
+    printf(" -s     --scan             Check the files and every file in the directories\n");
+    printf("                           given, then list the failures and the throughput\n");
+    printf(" -j N   --jobs N           Scan on N threads, 0 for one per cpu (implies -s)\n");
+#ifdef DT_WITH_LIBRARY
+    printf(" -l     --library          Scan with the parsers of libWildMidi (implies -s)\n");
+#endif
     printf(" -h     --help             Display this information\n");
     printf(" -v     --version          Display version information\n\n");
 }
@@ -222,10 +301,10 @@ DT_BufferFile(const char *filename, unsigned long int *size) {
     return data;
 }
 
-static char check_notes[16][128];
+static DT_THREAD_LOCAL char check_notes[16][128];
 
 static void zero_check_notes(void) {
-
+    memset(check_notes, 0, sizeof(check_notes));
 }
 
 static int count_check_notes(void) {
@@ -705,9 +784,9 @@ static int check_midi_event (unsigned char *midi_data, unsigned long int midi_si
     return rtn_cnt;
 }
 
-static uint32_t time_mins = 0;
-static float time_secs = 0.0f;
-static float secs_per_tick = 0.0f;
+static DT_THREAD_LOCAL uint32_t time_mins = 0;
+static DT_THREAD_LOCAL float time_secs = 0.0f;
+static DT_THREAD_LOCAL float secs_per_tick = 0.0f;
 static float frequency = 0.0f;
 
 static void set_secs_per_tick (unsigned long int divisions, unsigned long int tempo) {
@@ -810,8 +889,7 @@ static int8_t test_mus(unsigned char * mus_data, unsigned long mus_size, uint32_
 
     if (verbose) {
         /* Setup secs_per_tick */
-        if (frequency == 0.0) frequency = 140.0;
-        set_secs_per_tick (60, (uint32_t)(60000000.0f / frequency));
+        set_secs_per_tick (60, (uint32_t)(60000000.0f / ((frequency == 0.0) ? 140.0f : frequency)));
         add_and_display_time(0);
     }
 
@@ -1998,21 +2076,472 @@ static int test_guspat(unsigned char * gus_patch, unsigned long int filesize,
     return 0;
 }
 
+/* checks the file in data with the test for its kind, notes_on is set to
+   the notes left on at its end */
+static int DT_CheckBuffer(unsigned char *filebuffer, unsigned long int filesize,
+                          int verbose, int *notes_on) {
+    uint8_t mus_hdr[] = { 'M', 'U', 'S', 0x1A };
+    uint8_t xmi_hdr[] = { 'F', 'O', 'R', 'M' };
+    int testret;
+
+    zero_check_notes();
+    *notes_on = 0;
+    if ((filesize >= 8) && (memcmp(filebuffer,"HMIMIDIP", 8) == 0)) {
+        testret = test_hmp(filebuffer, filesize, verbose);
+        *notes_on = count_check_notes();
+    } else if ((filesize >= 18) && (memcmp(filebuffer, "HMI-MIDISONG061595", 18) == 0)) {
+        testret = test_hmi(filebuffer, filesize, verbose);
+        *notes_on = count_check_notes();
+    } else if ((filesize >= 4) && (memcmp(filebuffer, mus_hdr, 4) == 0)) {
+        testret = test_mus(filebuffer, filesize, verbose);
+        *notes_on = count_check_notes();
+    } else if ((filesize >= 4) && (memcmp(filebuffer, xmi_hdr, 4) == 0)) {
+        testret = test_xmidi(filebuffer, filesize, verbose);
+        *notes_on = count_check_notes();
+    } else  if ((filesize >= 22) &&
+                ((memcmp(filebuffer, "GF1PATCH110\0ID#000002", 22) == 0) ||
+                 (memcmp(filebuffer, "GF1PATCH100\0ID#000002", 22) == 0))) {
+        testret = test_guspat(filebuffer, filesize, verbose);
+    } else {
+        testret = test_midi(filebuffer, filesize, verbose);
+        *notes_on = count_check_notes();
+    }
+    return testret;
+}
+
+/*
+ * =========================
+ * Scanning a corpus
+ * =========================
+ */
+
+struct _dt_file {
+    char *name;
+    unsigned long int size;
+    int status;         /* 0 good, -1 failed, 1 not readable */
+    int notes_on;
+    char *report;       /* what the check said of a failed file */
+};
+
+struct _dt_scan {
+    struct _dt_file *file;
+    unsigned long int count;
+    unsigned long int size;
+    unsigned long int next;
+    int library;
+#if defined(_WIN32) && defined(DT_THREADS)
+    CRITICAL_SECTION lock;
+#elif defined(DT_THREADS)
+    pthread_mutex_t lock;
+#endif
+};
+
+static double DT_Now(void) {
+#ifdef _WIN32
+    LARGE_INTEGER freq, now;
+    QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+    return (double) now.QuadPart / (double) freq.QuadPart;
+#elif defined(CLOCK_MONOTONIC)
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double) now.tv_sec + ((double) now.tv_nsec / 1e9);
+#else
+    return (double) time(NULL);
+#endif
+}
+
+#ifdef DT_THREADS
+static int DT_CpuCount(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int) info.dwNumberOfProcessors;
+#elif defined(_SC_NPROCESSORS_ONLN)
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return (cpus > 0) ? (int) cpus : 1;
+#else
+    return 1;
+#endif
+}
+#endif
+
+static int DT_AddFile(struct _dt_scan *scan, const char *name) {
+    struct _dt_file *file;
+
+    if ((scan->count & (scan->count - 1)) == 0) {
+        /* doubles at each power of two */
+        file = realloc(scan->file, sizeof(struct _dt_file) * (scan->count ? scan->count * 2 : 64));
+        if (file == NULL) {
+            fprintf(stderr, "Unable to get ram for the file list: %s\n", strerror(errno));
+            return -1;
+        }
+        scan->file = file;
+    }
+    file = &scan->file[scan->count];
+    memset(file, 0, sizeof(struct _dt_file));
+    file->name = malloc(strlen(name) + 1);
+    if (file->name == NULL) {
+        fprintf(stderr, "Unable to get ram for the file list: %s\n", strerror(errno));
+        return -1;
+    }
+    strcpy(file->name, name);
+    scan->count++;
+    return 0;
+}
+
+/* what a directory of a corpus holds that is worth checking */
+static int DT_KnownFile(const char *name) {
+    static const char *known[] = {
+        ".mid", ".midi", ".rmi", ".kar", ".smf", ".xmi", ".mus", ".hmp", ".hmi", ".pat", NULL
+    };
+    const char *ext = strrchr(name, '.');
+    int i, j;
+
+    if (ext == NULL) {
+        return 0;
+    }
+    for (i = 0; known[i] != NULL; i++) {
+        for (j = 0; (ext[j] != 0) && (known[i][j] != 0); j++) {
+            if (((ext[j] >= 'A') && (ext[j] <= 'Z') ? ext[j] + 32 : ext[j]) != known[i][j]) {
+                break;
+            }
+        }
+        if ((ext[j] == 0) && (known[i][j] == 0)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* adds name, or the known files under it if it is a directory */
+static int DT_Walk(struct _dt_scan *scan, const char *name, int top) {
+    struct stat st;
+    char *path;
+    size_t len;
+    int ret = 0;
+#ifdef _WIN32
+    WIN32_FIND_DATAA entry;
+    HANDLE dir;
+#else
+    struct dirent *entry;
+    DIR *dir;
+#endif
+
+    if (stat(name, &st) != 0) {
+        if (top) {
+            fprintf(stderr, "Unable to stat %s: %s\n", name, strerror(errno));
+        }
+        return 0;
+    }
+    if (!(st.st_mode & S_IFDIR)) {
+        /* the files given are checked whatever they are called */
+        if (top || DT_KnownFile(name)) {
+            return DT_AddFile(scan, name);
+        }
+        return 0;
+    }
+
+    len = strlen(name);
+    path = malloc(len + 2 + 1024);
+    if (path == NULL) {
+        fprintf(stderr, "Unable to get ram to walk %s: %s\n", name, strerror(errno));
+        return -1;
+    }
+    strcpy(path, name);
+    if ((len == 0) || ((path[len - 1] != '/') && (path[len - 1] != '\\'))) {
+        path[len++] = '/';
+    }
+
+#ifdef _WIN32
+    strcpy(path + len, "*");
+    if ((dir = FindFirstFileA(path, &entry)) == INVALID_HANDLE_VALUE) {
+        free(path);
+        return 0;
+    }
+    do {
+        if ((strcmp(entry.cFileName, ".") == 0) || (strcmp(entry.cFileName, "..") == 0)
+                || (strlen(entry.cFileName) >= 1024)) {
+            continue;
+        }
+        strcpy(path + len, entry.cFileName);
+        ret = DT_Walk(scan, path, 0);
+    } while ((ret == 0) && FindNextFileA(dir, &entry));
+    FindClose(dir);
+#else
+    if ((dir = opendir(name)) == NULL) {
+        fprintf(stderr, "Unable to open %s: %s\n", name, strerror(errno));
+        free(path);
+        return 0;
+    }
+    while ((ret == 0) && ((entry = readdir(dir)) != NULL)) {
+        if ((strcmp(entry->d_name, ".") == 0) || (strcmp(entry->d_name, "..") == 0)
+                || (strlen(entry->d_name) >= 1024)) {
+            continue;
+        }
+        strcpy(path + len, entry->d_name);
+        ret = DT_Walk(scan, path, 0);
+    }
+    closedir(dir);
+#endif
+    free(path);
+    return ret;
+}
+
+/* the whole of a file to look at, mapped where we can, NULL if it cannot be read */
+static unsigned char *DT_MapFile(const char *name, unsigned long int *size) {
+    unsigned char *data;
+    struct stat st;
+    int fd;
+
+#ifdef _WIN32
+    if ((fd = open(name, (O_RDONLY | O_BINARY))) == -1) {
+#else
+    if ((fd = open(name, O_RDONLY)) == -1) {
+#endif
+        printf("Unable to open %s: %s\n", name, strerror(errno));
+        return NULL;
+    }
+    if ((fstat(fd, &st) != 0) || (st.st_size <= 0)) {
+        printf("Unable to read %s: empty or not a file\n", name);
+        close(fd);
+        return NULL;
+    }
+    *size = (unsigned long int) st.st_size;
+
+#ifndef _WIN32
+    /* private so the checks are free to scribble over it */
+    data = mmap(NULL, *size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        printf("Unable to map %s: %s\n", name, strerror(errno));
+        return NULL;
+    }
+#else
+    data = malloc(*size);
+    if (data == NULL) {
+        printf("Unable to get ram for %s: %s\n", name, strerror(errno));
+        close(fd);
+        return NULL;
+    }
+    if (read(fd, data, *size) != (int) *size) {
+        printf("Unable to read %s: %s\n", name, strerror(errno));
+        free(data);
+        close(fd);
+        return NULL;
+    }
+    close(fd);
+#endif
+    return data;
+}
+
+static void DT_UnmapFile(unsigned char *data, unsigned long int size) {
+#ifndef _WIN32
+    munmap(data, size);
+#else
+    WMIDI_UNUSED(size);
+    free(data);
+#endif
+}
+
+static void DT_ScanFile(struct _dt_scan *scan, struct _dt_file *file) {
+    char report[DT_REPORT_SIZE];
+    unsigned char *data;
+    unsigned long int size = 0;
+
+    report[0] = 0;
+    dt_report = report;
+    dt_report_len = 0;
+
+    if ((data = DT_MapFile(file->name, &size)) == NULL) {
+        file->status = 1;
+    } else {
+        file->size = size;
+#ifdef DT_WITH_LIBRARY
+        if (scan->library && !((size >= 22) &&
+                ((memcmp(data, "GF1PATCH110\0ID#000002", 22) == 0) ||
+                 (memcmp(data, "GF1PATCH100\0ID#000002", 22) == 0)))) {
+            struct _WM_Info info;
+            /* the error is that of the library, another thread may have
+               failed since */
+            if (WildMidi_Probe(data, size, &info) != 0) {
+                file->status = -1;
+                printf("%s\n", WildMidi_GetError() ? WildMidi_GetError() : "WildMidi_Probe failed");
+            } else {
+                file->status = 0;
+                free(info.copyright);
+            }
+        } else
+#endif
+        {
+            WMIDI_UNUSED(scan);
+            file->status = (DT_CheckBuffer(data, size, 0, &file->notes_on) != 0) ? -1 : 0;
+        }
+        DT_UnmapFile(data, size);
+    }
+
+    if ((file->status != 0) && (report[0] != 0)) {
+        file->report = malloc(strlen(report) + 1);
+        if (file->report) {
+            strcpy(file->report, report);
+        }
+    }
+    dt_report = NULL;
+}
+
+#if defined(_WIN32) && defined(DT_THREADS)
+#define dt_scan_lock(s)     EnterCriticalSection(&(s)->lock)
+#define dt_scan_unlock(s)   LeaveCriticalSection(&(s)->lock)
+#elif defined(DT_THREADS)
+#define dt_scan_lock(s)     pthread_mutex_lock(&(s)->lock)
+#define dt_scan_unlock(s)   pthread_mutex_unlock(&(s)->lock)
+#else
+#define dt_scan_lock(s)     do {} while (0)
+#define dt_scan_unlock(s)   do {} while (0)
+#endif
+
+#if defined(_WIN32) && defined(DT_THREADS)
+static DWORD WINAPI DT_ScanWorker(LPVOID data) {
+#else
+static void *DT_ScanWorker(void *data) {
+#endif
+    struct _dt_scan *scan = data;
+    unsigned long int i;
+
+    for (;;) {
+        dt_scan_lock(scan);
+        i = scan->next++;
+        dt_scan_unlock(scan);
+        if (i >= scan->count) {
+            break;
+        }
+        DT_ScanFile(scan, &scan->file[i]);
+    }
+    return 0;
+}
+
+static int DT_Scan(char **names, int count, int jobs, int library) {
+    struct _dt_scan scan;
+    unsigned long int failed = 0, unread = 0, notes_on = 0, i;
+    double start, took;
+    int threads = 1;
+    int n;
+#if defined(_WIN32) && defined(DT_THREADS)
+    HANDLE worker[64];
+#elif defined(DT_THREADS)
+    pthread_t worker[64];
+#endif
+
+    memset(&scan, 0, sizeof(scan));
+    scan.library = library;
+    for (n = 0; n < count; n++) {
+        if (DT_Walk(&scan, names[n], 1) != 0) {
+            return 1;
+        }
+    }
+
+#ifdef DT_THREADS
+    threads = (jobs > 0) ? jobs : DT_CpuCount();
+    if (threads > 64) {
+        threads = 64;
+    }
+    if ((unsigned long int) threads > scan.count) {
+        threads = (scan.count) ? (int) scan.count : 1;
+    }
+#else
+    WMIDI_UNUSED(jobs);
+#endif
+
+    start = DT_Now();
+#ifdef DT_THREADS
+#ifdef _WIN32
+    InitializeCriticalSection(&scan.lock);
+#else
+    pthread_mutex_init(&scan.lock, NULL);
+#endif
+    /* with this thread as the first worker */
+    for (n = 1; n < threads; n++) {
+#ifdef _WIN32
+        if ((worker[n] = CreateThread(NULL, 0, DT_ScanWorker, &scan, 0, NULL)) == NULL) {
+#else
+        if (pthread_create(&worker[n], NULL, DT_ScanWorker, &scan) != 0) {
+#endif
+            break;
+        }
+    }
+    threads = n;
+#endif
+    DT_ScanWorker(&scan);
+#ifdef DT_THREADS
+    for (n = 1; n < threads; n++) {
+#ifdef _WIN32
+        WaitForSingleObject(worker[n], INFINITE);
+        CloseHandle(worker[n]);
+#else
+        pthread_join(worker[n], NULL);
+#endif
+    }
+#ifdef _WIN32
+    DeleteCriticalSection(&scan.lock);
+#else
+    pthread_mutex_destroy(&scan.lock);
+#endif
+#endif
+    took = DT_Now() - start;
+
+    for (i = 0; i < scan.count; i++) {
+        struct _dt_file *file = &scan.file[i];
+
+        scan.size += file->size;
+        if (file->notes_on) {
+            notes_on++;
+        }
+        if (file->status != 0) {
+            if (file->status < 0) {
+                failed++;
+                printf("FAILED: %s\n", file->name);
+            } else {
+                unread++;
+                printf("UNREAD: %s\n", file->name);
+            }
+            if (file->report) {
+                printf("%s%s", file->report,
+                        (file->report[strlen(file->report) - 1] == '\n') ? "" : "\n");
+            }
+        }
+        free(file->report);
+        free(file->name);
+    }
+    free(scan.file);
+
+    printf("\nScanned %lu files, %.1f MB on %i thread%s in %.3f seconds%s\n",
+            scan.count, (double) scan.size / (1024.0 * 1024.0), threads,
+            (threads == 1) ? "" : "s", took, (library) ? " with libWildMidi" : "");
+    printf("%lu failed, %lu could not be read, %lu with notes still on at the end\n",
+            failed, unread, notes_on);
+    if (took > 0.0) {
+        printf("%.0f files/s, %.2f MB/s\n", (double) scan.count / took,
+                ((double) scan.size / (1024.0 * 1024.0)) / took);
+    }
+    return (failed || unread) ? 1 : 0;
+}
+
 int main(int argc, char ** argv) {
     int i;
     int option_index = 0;
     int verbose = 0;
     int testret = 0;
-    uint8_t mus_hdr[] = { 'M', 'U', 'S', 0x1A };
-    uint8_t xmi_hdr[] = { 'F', 'O', 'R', 'M' };
     int notes_still_on = 0;
+    int scan = 0;
+    int jobs = 0;
+    int library = 0;
 
     unsigned char *filebuffer = NULL;
     unsigned long int filesize = 0;
 
     do_version();
     while (1) {
-        i = getopt_long(argc, argv, "d:f:vh", long_options, &option_index);
+        i = getopt_long(argc, argv, "d:f:sj:lvh", long_options, &option_index);
         if (i == -1)
             break;
         switch (i) {
@@ -2022,6 +2551,19 @@ int main(int argc, char ** argv) {
         case 'f': /* Frequency */
             frequency = atof(optarg);
             break;
+        case 's': /* Scan */
+            scan = 1;
+            break;
+        case 'j': /* Scan threads */
+            jobs = atoi(optarg);
+            scan = 1;
+            break;
+#ifdef DT_WITH_LIBRARY
+        case 'l': /* Scan with the library */
+            library = 1;
+            scan = 1;
+            break;
+#endif
         case 'v': /* Version */
             return 0;
         case 'h': /* help */
@@ -2036,29 +2578,14 @@ int main(int argc, char ** argv) {
         return 0;
     }
 
+    if (scan) {
+        return DT_Scan(&argv[optind], argc - optind, jobs, library);
+    }
+
     while (optind < argc) {
         printf("Testing: %s\n", argv[optind]);
-        zero_check_notes();
         if ((filebuffer = DT_BufferFile(argv[optind], &filesize)) != NULL) {
-            if (memcmp(filebuffer,"HMIMIDIP", 8) == 0) {
-                testret = test_hmp(filebuffer, filesize, verbose);
-                notes_still_on = count_check_notes();
-            } else if (memcmp(filebuffer, "HMI-MIDISONG061595", 18) == 0) {
-                testret = test_hmi(filebuffer, filesize, verbose);
-                notes_still_on = count_check_notes();
-            } else if (memcmp(filebuffer, mus_hdr, 4) == 0) {
-                testret = test_mus(filebuffer, filesize, verbose);
-                notes_still_on = count_check_notes();
-            } else if (memcmp(filebuffer, xmi_hdr, 4) == 0) {
-                testret = test_xmidi(filebuffer, filesize, verbose);
-                notes_still_on = count_check_notes();
-            } else  if ((memcmp(filebuffer, "GF1PATCH110\0ID#000002", 22) == 0) ||
-                        (memcmp(filebuffer, "GF1PATCH100\0ID#000002", 22) == 0)) {
-                testret = test_guspat(filebuffer, filesize, verbose);
-            } else {
-                testret = test_midi(filebuffer, filesize, verbose);
-                notes_still_on = count_check_notes();
-            }
+            testret = DT_CheckBuffer(filebuffer, filesize, verbose, &notes_still_on);
             free(filebuffer);
             if (notes_still_on) {
                 printf("%i notes still on after end of file\n",notes_still_on);
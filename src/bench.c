@@ -0,0 +1,500 @@
+/*
+ * bench.c -- Midi Wavetable Processing library
+ *
+ * Copyright (C) WildMIDI Developers 2001-2016
+ *
+ * This file is part of WildMIDI.
+ *
+ * WildMIDI is free software: you can redistribute and/or modify the player
+ * under the terms of the GNU General Public License and you can redistribute
+ * and/or modify the library under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either version 3 of
+ * the licenses, or(at your option) any later version.
+ *
+ * WildMIDI is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License and
+ * the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License and the
+ * GNU Lesser General Public License along with WildMIDI.  If not,  see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * wildmidi-bench renders a fixed set of songs as fast as it can, with
+ * linear and gauss resampling, with and without reverb and a few block
+ * sizes, and prints how long everything took as a JSON document so the
+ * numbers can be compared from one release to the next.
+ *
+ * The songs are written here note by note rather than read from files so
+ * every run plays exactly the same notes, all on patch 0 of bank 0 which
+ * any config has. That also gives the number of voice frames, a voice
+ * counting from its note on to its note off, which the render times are
+ * divided by. Midi files given on the command line are rendered as well,
+ * without a voice frame count.
+ */
+
+#include "config.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if (defined _WIN32) || (defined __CYGWIN__)
+#include <windows.h>
+#include <psapi.h>
+#include "getopt_long.h"
+#else
+#include <getopt.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#endif
+
+#include "wildmidi_lib.h"
+
+#define BENCH_DIVISIONS 480
+/* 120 beats a minute */
+#define BENCH_TEMPO 500000
+#define MAX_BLOCKS 8
+
+struct _bench_song {
+    const char *name;
+    uint16_t voices;
+    uint8_t *data;
+    uint32_t size;
+    uint32_t notes;
+    double voice_frames;
+    double open_ms;
+};
+
+static struct option const long_options[] = {
+    { "config", 1, 0, 'c' },
+    { "rate", 1, 0, 'r' },
+    { "seconds", 1, 0, 's' },
+    { "blocks", 1, 0, 'b' },
+    { "runs", 1, 0, 'n' },
+    { "version", 0, 0, 'v' },
+    { "help", 0, 0, 'h' },
+    { NULL, 0, NULL, 0 }
+};
+
+static void do_help(void) {
+    printf("Usage: wildmidi-bench [options] [midifile ...]\n\n");
+    printf("  -c P  --config=P    Point to your wildmidi.cfg config file name/path\n");
+    printf("                      defaults to: %s\n", WILDMIDI_CFG);
+    printf("  -r N  --rate=N      Set sample rate to N samples per second (Hz)\n");
+    printf("  -s N  --seconds=N   Make the songs N seconds long, default is 10\n");
+    printf("  -b L  --blocks=L    Render in blocks of the frames in the comma separated\n");
+    printf("                      list L, default is 64,1024,8192\n");
+    printf("  -n N  --runs=N      Render everything N times and keep the fastest\n");
+    printf("  -v    --version     Display version info and exit\n");
+    printf("  -h    --help        Display this help and exit\n");
+}
+
+static void do_version(void) {
+    printf("\nwildmidi-bench for WildMidi %s\n", PACKAGE_VERSION);
+    printf("Copyright (C) WildMIDI Developers 2001-2016\n\n");
+    printf("Report bugs to %s\n", PACKAGE_BUGREPORT);
+    printf("WildMIDI homepage is at %s\n\n", PACKAGE_URL);
+}
+
+/* milliseconds since some point in the past */
+static double bench_clock(void) {
+#if (defined _WIN32) || (defined __CYGWIN__)
+    LARGE_INTEGER count, freq;
+    QueryPerformanceCounter(&count);
+    QueryPerformanceFrequency(&freq);
+    return ((double) count.QuadPart * 1000.0 / (double) freq.QuadPart);
+#elif defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6);
+#else
+    return ((double) clock() * 1000.0 / CLOCKS_PER_SEC);
+#endif
+}
+
+/* the most memory the process had at any time in kilobytes, -1 if unknown */
+static long bench_peak_rss(void) {
+#if (defined _WIN32) || (defined __CYGWIN__)
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+        return (-1);
+    return ((long) (pmc.PeakWorkingSetSize / 1024));
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return (-1);
+#if defined(__APPLE__)
+    return ((long) (usage.ru_maxrss / 1024));
+#else
+    return ((long) usage.ru_maxrss);
+#endif
+#endif
+}
+
+static uint8_t *song_data;
+static uint32_t song_size;
+static uint32_t song_alloc;
+
+static int put_byte(uint8_t byte) {
+    if (song_size == song_alloc) {
+        uint8_t *more = (uint8_t *) realloc(song_data, song_alloc + 4096);
+        if (more == NULL)
+            return (-1);
+        song_data = more;
+        song_alloc += 4096;
+    }
+    song_data[song_size++] = byte;
+    return (0);
+}
+
+static int put_event(uint32_t delta, uint8_t status, uint8_t data1, uint8_t data2) {
+    uint8_t vlq[5];
+    int i = 0;
+
+    do {
+        vlq[i++] = delta & 0x7f;
+        delta >>= 7;
+    } while (delta);
+    while (i > 1) {
+        if (put_byte(vlq[--i] | 0x80) != 0)
+            return (-1);
+    }
+    if ((put_byte(vlq[0]) != 0) || (put_byte(status) != 0)
+            || (put_byte(data1) != 0))
+        return (-1);
+    if (((status & 0xe0) != 0xc0) && (put_byte(data2) != 0))
+        return (-1);
+    return (0);
+}
+
+/*
+ * Writes song as a type 0 midi file of seconds at 120 beats a minute.
+ * Every beat each of the voices plays a note for three quarters of it,
+ * spread over the 15 melodic channels an octave apart on each so no two
+ * notes of a channel clash.
+ */
+static int make_song(struct _bench_song *song, uint16_t seconds, uint16_t rate) {
+    static const uint8_t header[] = {
+        'M', 'T', 'h', 'd', 0, 0, 0, 6, 0, 0, 0, 1,
+        BENCH_DIVISIONS >> 8, BENCH_DIVISIONS & 0xff,
+        'M', 'T', 'r', 'k', 0, 0, 0, 0,
+        0, 0xff, 0x51, 3,
+        (BENCH_TEMPO >> 16) & 0xff, (BENCH_TEMPO >> 8) & 0xff, BENCH_TEMPO & 0xff
+    };
+    uint32_t beats = seconds * 2;
+    uint32_t beat, track;
+    uint16_t v;
+    uint8_t ch;
+
+    song_data = NULL;
+    song_size = song_alloc = 0;
+    for (v = 0; v < sizeof(header); v++) {
+        if (put_byte(header[v]) != 0)
+            goto _nomem;
+    }
+
+    for (ch = 0; ch < 16; ch++) {
+        if (put_event(0, 0xc0 | ch, 0, 0) != 0)
+            goto _nomem;
+    }
+    for (beat = 0; beat < beats; beat++) {
+        for (v = 0; v < song->voices; v++) {
+            ch = v % 15;
+            if (ch >= 9) ch++;
+            if (put_event((beat && !v) ? (BENCH_DIVISIONS / 4) : 0, 0x90 | ch,
+                          36 + ((v / 15) * 12) + ((beat * 5 + ch * 2) % 12), 100) != 0)
+                goto _nomem;
+        }
+        for (v = 0; v < song->voices; v++) {
+            ch = v % 15;
+            if (ch >= 9) ch++;
+            if (put_event((v) ? 0 : (BENCH_DIVISIONS * 3 / 4), 0x80 | ch,
+                          36 + ((v / 15) * 12) + ((beat * 5 + ch * 2) % 12), 0) != 0)
+                goto _nomem;
+        }
+    }
+    /* the last quarter beat rest */
+    if ((put_byte(BENCH_DIVISIONS / 4) != 0) || (put_byte(0xff) != 0) || (put_byte(0x2f) != 0)
+            || (put_byte(0) != 0))
+        goto _nomem;
+
+    track = song_size - 22;
+    song_data[18] = (track >> 24) & 0xff;
+    song_data[19] = (track >> 16) & 0xff;
+    song_data[20] = (track >> 8) & 0xff;
+    song_data[21] = track & 0xff;
+
+    song->data = song_data;
+    song->size = song_size;
+    song->notes = beats * song->voices;
+    song->voice_frames = (double) song->notes * rate * (BENCH_TEMPO / 1e6) * 3 / 4;
+    return (0);
+
+_nomem:
+    free(song_data);
+    fprintf(stderr, "Out of memory\n");
+    return (-1);
+}
+
+static midi *open_song(const struct _bench_song *song) {
+    midi *handle;
+
+    if (song->data != NULL) {
+        handle = WildMidi_OpenBuffer(song->data, song->size);
+    } else {
+        handle = WildMidi_Open(song->name);
+    }
+    if (handle == NULL) {
+        fprintf(stderr, "Unable to open %s: %s\n", song->name, WildMidi_GetError());
+        WildMidi_ClearError();
+    }
+    return (handle);
+}
+
+/*
+ * Renders song through in blocks of block frames, returns the time it
+ * took in milliseconds or a negative value on error.
+ */
+static double render_song(const struct _bench_song *song, uint16_t options,
+                          int8_t *buffer, uint32_t block, uint32_t *frames) {
+    midi *handle;
+    double start, ms;
+    int got;
+
+    if ((handle = open_song(song)) == NULL)
+        return (-1.0);
+    if (((options & WM_MO_ENHANCED_RESAMPLING)
+            && (WildMidi_SetOption(handle, WM_MO_ENHANCED_RESAMPLING, WM_MO_ENHANCED_RESAMPLING) != 0))
+            || ((options & WM_MO_REVERB)
+            && (WildMidi_SetOption(handle, WM_MO_REVERB, WM_MO_REVERB) != 0))) {
+        fprintf(stderr, "Unable to set options: %s\n", WildMidi_GetError());
+        WildMidi_Close(handle);
+        return (-1.0);
+    }
+
+    *frames = 0;
+    start = bench_clock();
+    while ((got = WildMidi_GetOutput(handle, buffer, block * 4)) > 0) {
+        *frames += got / 4;
+    }
+    ms = bench_clock() - start;
+
+    WildMidi_Close(handle);
+    return ((got < 0) ? -1.0 : ms);
+}
+
+static void print_string(const char *str) {
+    putchar('"');
+    for (; *str; str++) {
+        if ((*str == '"') || (*str == '\\')) {
+            printf("\\%c", *str);
+        } else if ((unsigned char) *str < 0x20) {
+            printf("\\u%04x", (unsigned char) *str);
+        } else {
+            putchar(*str);
+        }
+    }
+    putchar('"');
+}
+
+int main(int argc, char **argv) {
+    static const struct {
+        const char *name;
+        uint16_t options;
+    } modes[] = {
+        { "linear", 0 },
+        { "linear+reverb", WM_MO_REVERB },
+        { "gauss", WM_MO_ENHANCED_RESAMPLING },
+        { "gauss+reverb", WM_MO_ENHANCED_RESAMPLING | WM_MO_REVERB }
+    };
+    static const char *song_names[] = { "voices8", "voices32", "voices96" };
+    static const uint16_t song_voices[] = { 8, 32, 96 };
+    const char *config_file = WILDMIDI_CFG;
+    uint32_t rate = 44100;
+    uint32_t seconds = 10;
+    uint32_t blocks[MAX_BLOCKS] = { 64, 1024, 8192 };
+    uint32_t block_count = 3;
+    uint32_t runs = 1;
+    struct _bench_song *songs;
+    uint32_t song_count;
+    int8_t *buffer;
+    midi *resident;
+    double start, init_ms, first_ms, ms, best;
+    uint32_t i, m, b, r, frames;
+    int first_render = 1;
+    int option_index = 0;
+    int c;
+    char *next;
+
+    while ((c = getopt_long(argc, argv, "c:r:s:b:n:vh", long_options, &option_index)) != -1) {
+        switch (c) {
+        case 'c':
+            config_file = optarg;
+            break;
+        case 'r':
+            rate = (uint32_t) strtoul(optarg, NULL, 10);
+            if ((rate < 11025) || (rate > 65535)) {
+                fprintf(stderr, "Error: rate out of bounds (11025 - 65535).\n");
+                return (1);
+            }
+            break;
+        case 's':
+            seconds = (uint32_t) strtoul(optarg, NULL, 10);
+            if ((seconds == 0) || (seconds > 3600)) {
+                fprintf(stderr, "Error: seconds out of bounds (1 - 3600).\n");
+                return (1);
+            }
+            break;
+        case 'b':
+            block_count = 0;
+            next = optarg;
+            do {
+                if (block_count == MAX_BLOCKS) {
+                    fprintf(stderr, "Error: at most %d block sizes.\n", MAX_BLOCKS);
+                    return (1);
+                }
+                blocks[block_count] = (uint32_t) strtoul(next, &next, 10);
+                if ((blocks[block_count] == 0) || (blocks[block_count] > 65536)) {
+                    fprintf(stderr, "Error: block size out of bounds (1 - 65536).\n");
+                    return (1);
+                }
+                block_count++;
+            } while (*next++ == ',');
+            break;
+        case 'n':
+            runs = (uint32_t) strtoul(optarg, NULL, 10);
+            if ((runs == 0) || (runs > 100)) {
+                fprintf(stderr, "Error: runs out of bounds (1 - 100).\n");
+                return (1);
+            }
+            break;
+        case 'v':
+            do_version();
+            return (0);
+        case 'h':
+            do_help();
+            return (0);
+        default:
+            do_help();
+            return (1);
+        }
+    }
+
+    song_count = 3 + (argc - optind);
+    songs = (struct _bench_song *) calloc(song_count, sizeof(struct _bench_song));
+    buffer = (int8_t *) malloc(65536 * 4);
+    if ((songs == NULL) || (buffer == NULL)) {
+        fprintf(stderr, "Out of memory\n");
+        return (1);
+    }
+    for (i = 0; i < 3; i++) {
+        songs[i].name = song_names[i];
+        songs[i].voices = song_voices[i];
+        if (make_song(&songs[i], (uint16_t) seconds, (uint16_t) rate) != 0)
+            return (1);
+    }
+    for (; i < song_count; i++) {
+        songs[i].name = argv[optind + i - 3];
+    }
+
+    start = bench_clock();
+    if (WildMidi_Init(config_file, (uint16_t) rate, 0) == -1) {
+        fprintf(stderr, "%s\n", WildMidi_GetError());
+        return (1);
+    }
+    init_ms = bench_clock() - start;
+
+    /* the first open loads the patches, which then stay loaded as long
+       as it is, the other opens only time parsing the song */
+    start = bench_clock();
+    if ((resident = open_song(&songs[0])) == NULL) {
+        WildMidi_Shutdown();
+        return (1);
+    }
+    first_ms = bench_clock() - start;
+
+    for (i = 0; i < song_count; i++) {
+        midi *handle;
+
+        songs[i].open_ms = -1.0;
+        for (r = 0; r < runs; r++) {
+            start = bench_clock();
+            if ((handle = open_song(&songs[i])) == NULL)
+                break;
+            ms = bench_clock() - start;
+            WildMidi_Close(handle);
+            if ((songs[i].open_ms < 0.0) || (ms < songs[i].open_ms))
+                songs[i].open_ms = ms;
+        }
+    }
+
+    printf("{\n  \"version\": \"%s\",\n  \"config\": ", WildMidi_GetString(WM_GS_VERSION));
+    print_string(config_file);
+    printf(",\n  \"rate\": %u,\n  \"seconds\": %u,\n  \"runs\": %u,\n", rate, seconds, runs);
+    printf("  \"init_ms\": %.3f,\n", init_ms);
+    ms = first_ms - songs[0].open_ms;
+    printf("  \"patch_load_ms\": %.3f,\n", (ms > 0.0) ? ms : 0.0);
+    printf("  \"songs\": [");
+    for (i = 0; i < song_count; i++) {
+        printf("%s\n    { \"name\": ", (i) ? "," : "");
+        print_string(songs[i].name);
+        if (songs[i].data != NULL) {
+            printf(", \"voices\": %u, \"notes\": %u, \"voice_frames\": %.0f",
+                   songs[i].voices, songs[i].notes, songs[i].voice_frames);
+        }
+        if (songs[i].open_ms < 0.0) {
+            printf(", \"open_ms\": null }");
+        } else {
+            printf(", \"open_ms\": %.3f }", songs[i].open_ms);
+        }
+    }
+    printf("\n  ],\n  \"render\": [");
+
+    for (i = 0; i < song_count; i++) {
+        if (songs[i].open_ms < 0.0)
+            continue;
+        for (m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+            for (b = 0; b < block_count; b++) {
+                best = -1.0;
+                frames = 0;
+                for (r = 0; r < runs; r++) {
+                    ms = render_song(&songs[i], modes[m].options, buffer, blocks[b], &frames);
+                    if (ms < 0.0)
+                        break;
+                    if ((best < 0.0) || (ms < best))
+                        best = ms;
+                }
+                if (best < 0.0)
+                    continue;
+                if (best <= 0.0)
+                    best = 0.001;
+
+                printf("%s\n    { \"song\": ", (first_render) ? "" : ",");
+                first_render = 0;
+                print_string(songs[i].name);
+                printf(", \"mode\": \"%s\", \"block\": %u, \"frames\": %u, \"ms\": %.3f, \"frames_per_sec\": %.0f",
+                       modes[m].name, blocks[b], frames, best, frames * 1000.0 / best);
+                if (songs[i].data != NULL) {
+                    printf(", \"ns_per_voice_frame\": %.3f", best * 1e6 / songs[i].voice_frames);
+                }
+                printf(" }");
+                fflush(stdout);
+            }
+        }
+    }
+    printf("\n  ],\n  \"peak_rss_kb\": %ld\n}\n", bench_peak_rss());
+
+    WildMidi_Close(resident);
+    WildMidi_Shutdown();
+    for (i = 0; i < song_count; i++) {
+        free(songs[i].data);
+    }
+    free(songs);
+    free(buffer);
+    return (0);
+}
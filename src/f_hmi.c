@@ -32,14 +32,13 @@
 #include "wm_error.h"
 #include "wildmidi_lib.h"
 #include "internal_midi.h"
-#include "reverb.h"
 #include "f_hmi.h"
 
 /*
  Turns hmp file data into an event stream
  */
 struct _mdi *
-_WM_ParseNewHmi(const uint8_t *hmi_data, uint32_t hmi_size) {
+_WM_ParseNewHmi(struct _context *ctx, const uint8_t *hmi_data, uint32_t hmi_size) {
     uint32_t hmi_tmp = 0;
     const uint8_t *hmi_base = hmi_data;
     const uint8_t *data_end = hmi_data + hmi_size;
@@ -54,15 +53,16 @@ _WM_ParseNewHmi(const uint8_t *hmi_data, uint32_t hmi_size) {
     const uint8_t *hmi_addr = NULL;
     uint32_t *hmi_track_header_length = NULL;
     struct _mdi *hmi_mdi = NULL;
+    uint8_t parsed = 0;
     float tempo_f =  5000000.0f;
-    uint32_t *hmi_track_end = NULL;
     uint8_t hmi_tracks_ended = 0;
     uint8_t *hmi_running_event = NULL;
     uint32_t setup_ret = 0;
     uint32_t *hmi_delta = NULL;
+    uint32_t *hmi_next = NULL;
+    struct _track_heap heap;
 
     uint32_t smallest_delta = 0;
-    uint32_t subtract_delta = 0;
 
     uint32_t sample_count = 0;
     float sample_count_f = 0;
@@ -71,7 +71,8 @@ _WM_ParseNewHmi(const uint8_t *hmi_data, uint32_t hmi_size) {
     float samples_per_delta_f = 0;
 
     struct _note {
-        uint32_t length;
+        uint32_t length;    /* 0 once the note is off */
+        uint32_t end;       /* the tick it goes off at */
         uint8_t channel;
     } *note;
 
@@ -107,25 +108,38 @@ _WM_ParseNewHmi(const uint8_t *hmi_data, uint32_t hmi_size) {
         return NULL;
     }
 
-    hmi_mdi = _WM_initMDI();
+    hmi_mdi = _WM_initMDI(ctx);
+    if (hmi_mdi == NULL) {
+        return NULL;
+    }
 
     _WM_midi_setup_divisions(hmi_mdi, hmi_division);
 
-    if ((_WM_MixerOptions & WM_MO_ROUNDTEMPO)) {
+    if ((ctx->mixer_options & WM_MO_ROUNDTEMPO)) {
         tempo_f = (float) (60000000 / hmi_bpm) + 0.5f;
     } else {
         tempo_f = (float) (60000000 / hmi_bpm);
     }
-    samples_per_delta_f = _WM_GetSamplesPerTick(hmi_division, (uint32_t)tempo_f);
+    samples_per_delta_f = _WM_GetSamplesPerTick(hmi_division, (uint32_t)tempo_f, ctx->sample_rate);
 
     _WM_midi_setup_tempo(hmi_mdi, (uint32_t)tempo_f);
 
-    hmi_track_offset = (uint32_t *) malloc(sizeof(uint32_t) * hmi_track_cnt);
-    hmi_track_header_length = (uint32_t *) malloc(sizeof(uint32_t) * hmi_track_cnt);
-    hmi_track_end = (uint32_t *) malloc(sizeof(uint32_t) * hmi_track_cnt);
-    hmi_delta = (uint32_t *) malloc(sizeof(uint32_t) * hmi_track_cnt);
-    note = (struct _note *) malloc(sizeof(struct _note) * 128 * hmi_track_cnt);
-    hmi_running_event = (uint8_t *) malloc(sizeof(uint8_t) * 128 * hmi_track_cnt);
+    /* the arrays of the tracks are all in the one allocation at note */
+    note = (struct _note *) malloc(((sizeof(struct _note) + sizeof(uint8_t)) * 128
+                                    + (sizeof(uint32_t) * 4)) * hmi_track_cnt);
+    if (note == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, 0);
+        _WM_freeMDI(hmi_mdi);
+        return NULL;
+    }
+    hmi_track_offset = (uint32_t *) &note[128 * hmi_track_cnt];
+    hmi_track_header_length = &hmi_track_offset[hmi_track_cnt];
+    hmi_delta = &hmi_track_header_length[hmi_track_cnt];
+    hmi_next = &hmi_delta[hmi_track_cnt];
+    hmi_running_event = (uint8_t *) &hmi_next[hmi_track_cnt];
+    if (_WM_AllocTrackHeap(&heap, hmi_track_cnt) == -1) {
+        goto _hmi_end;
+    }
 
     hmi_data += 370;
 
@@ -182,8 +196,9 @@ _WM_ParseNewHmi(const uint8_t *hmi_data, uint32_t hmi_size) {
         if (hmi_delta[i] < smallest_delta) {
             smallest_delta = hmi_delta[i];
         }
+        hmi_next[i] = hmi_delta[i];
+        _WM_AddTrack(&heap, i, hmi_next[i]);
 
-        hmi_track_end[i] = 0;
         hmi_running_event[i] = 0;
 
         for (j = 0; j < 128; j++) {
@@ -208,7 +223,7 @@ _WM_ParseNewHmi(const uint8_t *hmi_data, uint32_t hmi_size) {
         goto _hmi_end;
     }
 
-    subtract_delta = smallest_delta;
+    heap.now = smallest_delta;
     sample_count_f= (((float) smallest_delta * samples_per_delta_f) + sample_remainder);
 
     sample_count = (uint32_t) sample_count_f;
@@ -217,34 +232,25 @@ _WM_ParseNewHmi(const uint8_t *hmi_data, uint32_t hmi_size) {
     hmi_mdi->events[hmi_mdi->event_count - 1].samples_to_next += sample_count;
     hmi_mdi->extra_info.approx_total_samples += sample_count;
 
+    /*
+     * A track is due when its next event is or one of its notes has to
+     * be turned off, whichever comes first.
+     */
     while (hmi_tracks_ended < hmi_track_cnt) {
-        smallest_delta = 0;
-        for (i = 0; i < hmi_track_cnt; i++) {
-            if (hmi_track_end[i]) continue;
+        while (_WM_TrackDue(&heap)) {
+            i = _WM_FirstTrack(&heap);
 
             /* first check to see if any active notes need turning off. */
             for (j = 0; j < 128; j++) {
                 hmi_tmp = (128 * i) + j;
-                if (note[hmi_tmp].length) {
-                    note[hmi_tmp].length -= subtract_delta;
-                    if (note[hmi_tmp].length) {
-                        if ((!smallest_delta) || (smallest_delta > note[hmi_tmp].length)) {
-                            smallest_delta = note[hmi_tmp].length;
-                        }
-                    } else {
-                        _WM_midi_setup_noteoff(hmi_mdi, note[hmi_tmp].channel, j, 0);
-                    }
+                if ((note[hmi_tmp].length) && (note[hmi_tmp].end == heap.now)) {
+                    note[hmi_tmp].length = 0;
+                    _WM_midi_setup_noteoff(hmi_mdi, note[hmi_tmp].channel, j, 0);
                 }
             }
 
-            if (hmi_delta[i]) {
-                hmi_delta[i] -= subtract_delta;
-                if (hmi_delta[i]) {
-                    if ((!smallest_delta) || (smallest_delta > hmi_delta[i])) {
-                        smallest_delta = hmi_delta[i];
-                    }
-                    continue;
-                }
+            if (hmi_next[i] != heap.now) {
+                goto _hmi_requeue_track;
             }
 
             do {
@@ -282,8 +288,8 @@ _WM_ParseNewHmi(const uint8_t *hmi_data, uint32_t hmi_size) {
                         goto _hmi_end;
                     }
                     if ((hmi_data[0] == 0xff) && (hmi_data[1] == 0x2f) && (hmi_data[2] == 0x00)) {
-                        hmi_track_end[i] = 1;
                         hmi_tracks_ended++;
+                        _WM_DropTrack(&heap);
                         for(j = 0; j < 128; j++) {
                             hmi_tmp = (128 * i) + j;
                             if (note[hmi_tmp].length) {
@@ -339,9 +345,7 @@ _WM_ParseNewHmi(const uint8_t *hmi_data, uint32_t hmi_size) {
                         hmi_track_offset[i]++;
 
                         if (note[hmi_tmp].length) {
-                            if ((!smallest_delta) || (smallest_delta > note[hmi_tmp].length)) {
-                                smallest_delta = note[hmi_tmp].length;
-                            }
+                            note[hmi_tmp].end = heap.now + note[hmi_tmp].length;
                         } else {
                             _WM_midi_setup_noteoff(hmi_mdi, note[hmi_tmp].channel, j, 0);
                         }
@@ -373,9 +377,17 @@ _WM_ParseNewHmi(const uint8_t *hmi_data, uint32_t hmi_size) {
                 data_size--;
                 hmi_track_offset[i]++;
             } while (!hmi_delta[i]);
-            if ((!smallest_delta) || (smallest_delta > hmi_delta[i])) {
-                smallest_delta = hmi_delta[i];
+            hmi_next[i] = heap.now + hmi_delta[i];
+
+        _hmi_requeue_track:
+            smallest_delta = hmi_next[i] - heap.now;
+            for (j = 0; j < 128; j++) {
+                hmi_tmp = (128 * i) + j;
+                if ((note[hmi_tmp].length) && ((note[hmi_tmp].end - heap.now) < smallest_delta)) {
+                    smallest_delta = note[hmi_tmp].end - heap.now;
+                }
             }
+            _WM_RequeueTrack(&heap, (heap.now + smallest_delta));
 
         _hmi_next_track:
             hmi_tmp = 0;
@@ -383,6 +395,7 @@ _WM_ParseNewHmi(const uint8_t *hmi_data, uint32_t hmi_size) {
         }
 
         /* convert smallest delta to samples till next */
+        smallest_delta = _WM_StepTrackHeap(&heap);
         if ((float)smallest_delta >= 0x7fffffff / samples_per_delta_f) {
             /* DEBUG */
             /* fprintf(stderr,"INTEGER OVERFLOW (samples_per_delta: %f, smallest_delta: %u)\n", */
@@ -390,7 +403,6 @@ _WM_ParseNewHmi(const uint8_t *hmi_data, uint32_t hmi_size) {
             _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_CORUPT, NULL, 0);
             goto _hmi_end;
         }
-        subtract_delta = smallest_delta;
         sample_count_f= (((float) smallest_delta * samples_per_delta_f) + sample_remainder);
 
         sample_count = (uint32_t) sample_count_f;
@@ -400,27 +412,19 @@ _WM_ParseNewHmi(const uint8_t *hmi_data, uint32_t hmi_size) {
         hmi_mdi->extra_info.approx_total_samples += sample_count;
     }
 
-    if ((hmi_mdi->reverb = _WM_init_reverb(_WM_SampleRate, _WM_reverb_room_width, _WM_reverb_room_length, _WM_reverb_listen_posx, _WM_reverb_listen_posy)) == NULL) {
-        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, 0);
-        goto _hmi_end;
-    }
-
     hmi_mdi->extra_info.current_sample = 0;
     hmi_mdi->current_event = &hmi_mdi->events[0];
     hmi_mdi->samples_to_mix = 0;
-    hmi_mdi->note = NULL;
+    hmi_mdi->voice_count = 0;
 
     _WM_ResetToStart(hmi_mdi);
+    parsed = 1;
 
 _hmi_end:
-    free(hmi_track_offset);
-    free(hmi_track_header_length);
-    free(hmi_track_end);
-    free(hmi_delta);
+    _WM_FreeTrackHeap(&heap);
     free(note);
-    free(hmi_running_event);
 
-    if (hmi_mdi->reverb) return (hmi_mdi);
+    if (parsed) return (hmi_mdi);
     _WM_freeMDI(hmi_mdi);
     return 0;
 }
@@ -32,14 +32,13 @@
 #include "wm_error.h"
 #include "wildmidi_lib.h"
 #include "internal_midi.h"
-#include "reverb.h"
 #include "f_hmp.h"
 
 /*
  Turns hmp file data into an event stream
  */
 struct _mdi *
-_WM_ParseNewHmp(const uint8_t *hmp_data, uint32_t hmp_size) {
+_WM_ParseNewHmp(struct _context *ctx, const uint8_t *hmp_data, uint32_t hmp_size) {
     uint8_t is_hmp2 = 0;
     uint32_t zero_cnt = 0;
     uint32_t i = 0;
@@ -50,15 +49,15 @@ _WM_ParseNewHmp(const uint8_t *hmp_data, uint32_t hmp_size) {
     uint32_t hmp_bpm = 0;
     uint32_t hmp_song_time = 0;
     struct _mdi *hmp_mdi;
+    uint8_t parsed = 0;
     const uint8_t **hmp_chunk;
     uint32_t *chunk_length;
     uint32_t *chunk_ofs;
     uint32_t *chunk_delta;
-    uint8_t *chunk_end;
+    struct _track_heap heap;
     uint32_t chunk_num = 0;
     uint32_t hmp_track = 0;
     uint32_t smallest_delta = 0;
-    uint32_t subtract_delta = 0;
     uint32_t end_of_chunks = 0;
     uint32_t var_len_shift = 0;
 
@@ -154,13 +153,13 @@ _WM_ParseNewHmp(const uint8_t *hmp_data, uint32_t hmp_size) {
     }
 
     /* Slow but needed for accuracy */
-    if ((_WM_MixerOptions & WM_MO_ROUNDTEMPO)) {
+    if ((ctx->mixer_options & WM_MO_ROUNDTEMPO)) {
         tempo_f = (float) (60000000 / hmp_bpm) + 0.5f;
     } else {
         tempo_f = (float) (60000000 / hmp_bpm);
     }
 
-    samples_per_delta_f = _WM_GetSamplesPerTick(hmp_divisions, (uint32_t) tempo_f);
+    samples_per_delta_f = _WM_GetSamplesPerTick(hmp_divisions, (uint32_t) tempo_f, ctx->sample_rate);
 
     /* DEBUG */
     /* fprintf(stderr, "DEBUG: Samples Per Delta Tick: %f\r\n",samples_per_delta_f); */
@@ -185,16 +184,27 @@ _WM_ParseNewHmp(const uint8_t *hmp_data, uint32_t hmp_size) {
         hmp_size -= 712;
     }
 
-    hmp_mdi = _WM_initMDI();
+    hmp_mdi = _WM_initMDI(ctx);
+    if (hmp_mdi == NULL) {
+        return NULL;
+    }
 
     _WM_midi_setup_divisions(hmp_mdi, hmp_divisions);
     _WM_midi_setup_tempo(hmp_mdi, (uint32_t)tempo_f);
 
-    hmp_chunk = (const uint8_t **) malloc(sizeof(uint8_t *) * hmp_chunks);
-    chunk_length = (uint32_t *) malloc(sizeof(uint32_t) * hmp_chunks);
-    chunk_delta = (uint32_t *) malloc(sizeof(uint32_t) * hmp_chunks);
-    chunk_ofs = (uint32_t *) malloc(sizeof(uint32_t) * hmp_chunks);
-    chunk_end = (uint8_t *) malloc(sizeof(uint8_t) * hmp_chunks);
+    /* the arrays of the chunks are all in the one allocation at hmp_chunk */
+    hmp_chunk = (const uint8_t **) malloc((sizeof(uint8_t *) + (sizeof(uint32_t) * 3)) * hmp_chunks);
+    if (hmp_chunk == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, 0);
+        _WM_freeMDI(hmp_mdi);
+        return NULL;
+    }
+    chunk_length = (uint32_t *) &hmp_chunk[hmp_chunks];
+    chunk_delta = &chunk_length[hmp_chunks];
+    chunk_ofs = &chunk_delta[hmp_chunks];
+    if (_WM_AllocTrackHeap(&heap, hmp_chunks) == -1) {
+        goto _hmp_end;
+    }
 
     smallest_delta = 0x7fffffff;
     /* store chunk info for use, and check chunk lengths */
@@ -247,12 +257,12 @@ _WM_ParseNewHmp(const uint8_t *hmp_data, uint32_t hmp_size) {
         if (chunk_delta[i] < smallest_delta) {
             smallest_delta = chunk_delta[i];
         }
+        _WM_AddTrack(&heap, i, chunk_delta[i]);
 
         /* goto start of next chunk */
         hmp_data = hmp_chunk[i] + chunk_length[i];
         chunk_length[i] -= chunk_ofs[i];
         hmp_chunk[i] += chunk_ofs[i]++;
-        chunk_end[i] = 0;
     }
 
     if (smallest_delta >= 0x7fffffff) {
@@ -270,7 +280,7 @@ _WM_ParseNewHmp(const uint8_t *hmp_data, uint32_t hmp_size) {
         goto _hmp_end;
     }
 
-    subtract_delta = smallest_delta;
+    heap.now = smallest_delta;
     sample_count_f = (((float) smallest_delta * samples_per_delta_f) + sample_remainder);
 
     sample_count = (uint32_t) sample_count_f;
@@ -280,25 +290,11 @@ _WM_ParseNewHmp(const uint8_t *hmp_data, uint32_t hmp_size) {
     hmp_mdi->extra_info.approx_total_samples += sample_count;
 
     while (end_of_chunks < hmp_chunks) {
-        smallest_delta = 0;
-
         /* DEBUG */
-        /* fprintf(stderr,"DEBUG: Delta Ticks: %u\r\n",subtract_delta); */
-
-        for (i = 0; i < hmp_chunks; i++) {
-            if (chunk_end[i])
-                continue;
-
-            if (chunk_delta[i]) {
-                chunk_delta[i] -= subtract_delta;
-                if (chunk_delta[i]) {
-                    if ((!smallest_delta)
-                        || (smallest_delta > chunk_delta[i])) {
-                        smallest_delta = chunk_delta[i];
-                    }
-                    continue;
-                }
-            }
+        /* fprintf(stderr,"DEBUG: Delta Ticks: %u\r\n",smallest_delta); */
+
+        while (_WM_TrackDue(&heap)) {
+            i = _WM_FirstTrack(&heap);
             do {
                 if (((hmp_chunk[i][0] & 0xf0) == 0xb0 ) && ((hmp_chunk[i][1] == 110) || (hmp_chunk[i][1] == 111)) && (hmp_chunk[i][2] > 0x7f)) {
                     /* Reserved for loop markers */
@@ -315,7 +311,7 @@ _WM_ParseNewHmp(const uint8_t *hmp_data, uint32_t hmp_size) {
                     if ((hmp_chunk[i][0] == 0xff) && (hmp_chunk[i][1] == 0x2f) && (hmp_chunk[i][2] == 0x00)) {
                         /* End of Chunk */
                         end_of_chunks++;
-                        chunk_end[i] = 1;
+                        _WM_DropTrack(&heap);
                         chunk_length[i] -= 3;
                         hmp_chunk[i] += 3;
                         goto NEXT_CHUNK;
@@ -350,13 +346,11 @@ _WM_ParseNewHmp(const uint8_t *hmp_data, uint32_t hmp_size) {
                 hmp_chunk[i]++;
                 chunk_length[i]--;
             } while (!chunk_delta[i]);
-
-            if ((!smallest_delta) || (smallest_delta > chunk_delta[i])) {
-                smallest_delta = chunk_delta[i];
-            }
+            _WM_RequeueTrack(&heap, (heap.now + chunk_delta[i]));
         NEXT_CHUNK: continue;
         }
 
+        smallest_delta = _WM_StepTrackHeap(&heap);
         if ((float)smallest_delta >= 0x7fffffff / samples_per_delta_f) {
             /* DEBUG */
             /* fprintf(stderr,"INTEGER OVERFLOW (samples_per_delta: %f, smallest_delta: %u)\n", */
@@ -365,7 +359,6 @@ _WM_ParseNewHmp(const uint8_t *hmp_data, uint32_t hmp_size) {
             goto _hmp_end;
         }
 
-        subtract_delta = smallest_delta;
         sample_count_f= (((float) smallest_delta * samples_per_delta_f) + sample_remainder);
 
         sample_count = (uint32_t) sample_count_f;
@@ -378,25 +371,18 @@ _WM_ParseNewHmp(const uint8_t *hmp_data, uint32_t hmp_size) {
         /* fprintf(stderr,"DEBUG: Sample Count %u\r\n",sample_count); */
     }
 
-    if ((hmp_mdi->reverb = _WM_init_reverb(_WM_SampleRate, _WM_reverb_room_width, _WM_reverb_room_length, _WM_reverb_listen_posx, _WM_reverb_listen_posy)) == NULL) {
-        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, 0);
-        goto _hmp_end;
-    }
-
     hmp_mdi->extra_info.current_sample = 0;
     hmp_mdi->current_event = &hmp_mdi->events[0];
     hmp_mdi->samples_to_mix = 0;
-    hmp_mdi->note = NULL;
+    hmp_mdi->voice_count = 0;
 
     _WM_ResetToStart(hmp_mdi);
+    parsed = 1;
 
 _hmp_end:
     free((void*)hmp_chunk);
-    free(chunk_length);
-    free(chunk_delta);
-    free(chunk_ofs);
-    free(chunk_end);
-    if (hmp_mdi->reverb) return (hmp_mdi);
+    _WM_FreeTrackHeap(&heap);
+    if (parsed) return (hmp_mdi);
     _WM_freeMDI(hmp_mdi);
     return NULL;
 }
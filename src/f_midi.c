@@ -33,19 +33,365 @@
 #include "f_midi.h"
 #include "wildmidi_lib.h"
 #include "internal_midi.h"
-#include "reverb.h"
+#include "patches.h"
 #include "sample.h"
 
 
+/*
+ * The tracks of a midi file while their events are merged into the
+ * event list, in time order across all tracks for type 1.
+ */
+struct _midi_tracks {
+    uint32_t type;
+    uint32_t count;
+    uint32_t ended;             /* tracks that reached their end */
+    const uint8_t **data;       /* at the next event of each track */
+    uint32_t *size;             /* what is left of each track */
+    uint32_t *delta;            /* ticks to the next event of each track */
+    uint8_t *end;
+    uint8_t *running_event;
+    struct _track_heap heap;    /* the tracks by when they are next due */
+    uint32_t divisions;
+    float samples_per_delta;
+    float sample_remainder;
+    uint32_t samples;           /* the samples the merged events take */
+};
+
+/*
+ * A song opened with WM_MO_STREAM. Only a window of WM_STREAM_EVENTS
+ * events is converted at a time, the next is read once the player has
+ * done the last event of the one before. The parse keeps its own channel
+ * states as the events it reads run ahead of those being played.
+ */
+#define WM_STREAM_EVENTS 4096
+
+struct _midi_stream {
+    uint8_t *file;              /* our copy of the midi file */
+    struct _midi_tracks tracks;
+    const uint8_t **start;      /* the tracks as they are at the start,
+                                   allocated with the two below */
+    uint32_t *start_size;
+    uint32_t *start_delta;
+    struct _channel channel[16];
+    uint32_t strip;             /* samples of leading silence stripped */
+    char *lyric;                /* the lyric shown from a dropped window */
+};
+
+/* the arrays of the tracks are all in the one allocation at data */
+static int
+WM_AllocTracks(struct _midi_tracks *t, uint32_t type, uint32_t count) {
+    memset(t, 0, sizeof(struct _midi_tracks));
+    t->type = type;
+    t->count = count;
+    t->data = (const uint8_t **) malloc((sizeof(uint8_t *) + (sizeof(uint32_t) * 2) + 2) * count);
+    if (t->data == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, 0);
+        return (-1);
+    }
+    t->size = (uint32_t *) &t->data[count];
+    t->delta = &t->size[count];
+    t->end = (uint8_t *) &t->delta[count];
+    t->running_event = &t->end[count];
+    return (_WM_AllocTrackHeap(&t->heap, count));
+}
+
+static void
+WM_FreeTracks(struct _midi_tracks *t) {
+    free((void*)t->data);
+    _WM_FreeTrackHeap(&t->heap);
+}
+
+/* count the samples up to the first event from the first deltas */
+static int
+WM_StartTracks(struct _mdi *mdi, struct _midi_tracks *t) {
+    uint32_t smallest_delta = 0x7fffffff;
+    uint32_t sample_count;
+    float sample_count_f;
+    uint32_t i;
+
+    t->heap.count = 0;
+    t->heap.now = 0;
+    for (i = 0; i < t->count; i++) {
+        _WM_AddTrack(&t->heap, i, t->delta[i]);
+        if (t->type == 1) {
+            if (t->delta[i] < smallest_delta) {
+                smallest_delta = t->delta[i];
+            }
+        } else {
+            /*
+             * Type 0 & 2 midi only needs delta from 1st track
+             * for initial sample calculations.
+             */
+            if (i == 0) smallest_delta = t->delta[i];
+        }
+    }
+
+    if (smallest_delta >= 0x7fffffff) {
+        /* DEBUG */
+        /* fprintf(stderr,"CRAZY SMALLEST DELTA %u\n", smallest_delta); */
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_CORUPT, NULL, 0);
+        return (-1);
+    }
+
+    if ((float)smallest_delta >= 0x7fffffff / t->samples_per_delta) {
+        /* DEBUG */
+        /* fprintf(stderr,"INTEGER OVERFLOW (samples_per_delta: %f, smallest_delta: %u)\n", */
+        /*        samples_per_delta_f, smallest_delta); */
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_CORUPT, NULL, 0);
+        return (-1);
+    }
+
+    t->heap.now = smallest_delta;
+    sample_count_f = (((float) smallest_delta * t->samples_per_delta) + t->sample_remainder);
+    sample_count = (uint32_t) sample_count_f;
+    t->sample_remainder = sample_count_f - (float) sample_count;
+    if (t->type != 1) {
+        t->sample_remainder = 0;
+    }
+
+    mdi->events[mdi->event_count - 1].samples_to_next += sample_count;
+    t->samples += sample_count;
+    return (0);
+}
+
+/*
+ * Add the events of every track that are due now and count the samples
+ * to the next of them. A type 0 track may run out without an end of
+ * track event, as with a full read of the file.
+ */
+static int
+WM_MergeTracks(struct _mdi *mdi, struct _midi_tracks *t) {
+    struct _track_heap *heap = &t->heap;
+    const uint8_t **tracks = t->data;
+    uint32_t *track_size = t->size;
+    uint32_t *track_delta = t->delta;
+    uint8_t *running_event = t->running_event;
+    uint32_t smallest_delta;
+    uint32_t setup_ret;
+    uint32_t sample_count;
+    float sample_count_f;
+    uint32_t tempo;
+    uint32_t i;
+
+    while (_WM_TrackDue(heap)) {
+        i = _WM_FirstTrack(heap);
+        track_delta[i] = 0;
+        do {
+            setup_ret = _WM_SetupMidiEvent(mdi, tracks[i], track_size[i], running_event[i]);
+            if (setup_ret == 0) {
+                return (-1);
+            }
+            if (tracks[i][0] > 0x7f) {
+                if (tracks[i][0] < 0xf0) {
+                    /* Events 0x80 - 0xef set running event */
+                    running_event[i] = tracks[i][0];
+                } else if ((tracks[i][0] == 0xf0) || (tracks[i][0] == 0xf7)) {
+                    /* Sysex resets running event */
+                    running_event[i] = 0;
+                } else if ((tracks[i][0] == 0xff) && (tracks[i][1] == 0x2f) && (tracks[i][2] == 0x00)) {
+                    /* End of Track */
+                    t->ended++;
+                    _WM_DropTrack(heap);
+                    tracks[i] += 3;
+                    track_size[i] -= 3;
+                    goto NEXT_TRACK;
+                } else if ((tracks[i][0] == 0xff) && (tracks[i][1] == 0x51) && (tracks[i][2] == 0x03)) {
+                    /* Tempo */
+                    tempo = (tracks[i][3] << 16) + (tracks[i][4] << 8)+ tracks[i][5];
+                    if (!tempo)
+                        tempo = 500000;
+
+                    t->samples_per_delta = _WM_GetSamplesPerTick(t->divisions, tempo, mdi->ctx->sample_rate);
+                }
+            }
+            tracks[i] += setup_ret;
+            track_size[i] -= setup_ret;
+
+            if (*tracks[i] > 0x7f) {
+                do {
+                    if (!track_size[i]) break;
+                    track_delta[i] = (track_delta[i] << 7) + (*tracks[i] & 0x7F);
+                    tracks[i]++;
+                    track_size[i]--;
+                } while (*tracks[i] > 0x7f);
+            }
+            if (!track_size[i]) {
+                if (t->type != 0) {
+                    _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_CORUPT, "(too short)", 0);
+                    return (-1);
+                }
+                t->ended++;
+                _WM_DropTrack(heap);
+                goto NEXT_TRACK;
+            }
+            track_delta[i] = (track_delta[i] << 7) + (*tracks[i] & 0x7F);
+            tracks[i]++;
+            track_size[i]--;
+        } while (!track_delta[i]);
+        _WM_RequeueTrack(heap, (heap->now + track_delta[i]));
+    NEXT_TRACK: continue;
+    }
+
+    smallest_delta = _WM_StepTrackHeap(heap);
+    if ((float)smallest_delta >= 0x7fffffff / t->samples_per_delta) {
+        /* DEBUG */
+        /* fprintf(stderr,"INTEGER OVERFLOW (samples_per_delta: %f, smallest_delta: %u)\n", */
+        /*        samples_per_delta_f, smallest_delta); */
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_CORUPT, NULL, 0);
+        return (-1);
+    }
+    sample_count_f = (((float) smallest_delta * t->samples_per_delta)
+                      + t->sample_remainder);
+    sample_count = (uint32_t) sample_count_f;
+    t->sample_remainder = sample_count_f - (float) sample_count;
+
+    mdi->events[mdi->event_count - 1].samples_to_next += sample_count;
+    t->samples += sample_count;
+    return (0);
+}
+
+static void
+WM_SwapChannels(struct _mdi *mdi, struct _midi_stream *stream) {
+    struct _channel channel[16];
+
+    memcpy(channel, mdi->channel, sizeof(channel));
+    memcpy(mdi->channel, stream->channel, sizeof(channel));
+    memcpy(stream->channel, channel, sizeof(channel));
+}
+
+/* convert the next window of events, after those there are */
+static void
+WM_ReadStream(struct _mdi *mdi) {
+    struct _midi_stream *stream = mdi->stream;
+    struct _midi_tracks *t = &stream->tracks;
+
+    WM_SwapChannels(mdi, stream);
+    while ((t->ended != t->count) && (mdi->event_count < WM_STREAM_EVENTS)) {
+        if (WM_MergeTracks(mdi, t) == -1) {
+            /* what was read plays, the error is left for the caller */
+            t->ended = t->count;
+        }
+    }
+    WM_SwapChannels(mdi, stream);
+    _WM_decode_patches(mdi);
+
+    mdi->streaming = (t->ended != t->count);
+    mdi->events[mdi->event_count].evtype = ev_null;
+    mdi->events[mdi->event_count].channel = 0;
+    mdi->events[mdi->event_count].data = 0;
+    mdi->events[mdi->event_count].samples_to_next = 0;
+}
+
+/* the length of the song is known up to where it has been read */
+static void
+WM_StreamLength(struct _mdi *mdi) {
+    struct _midi_stream *stream = mdi->stream;
+    uint32_t samples = stream->tracks.samples - stream->strip;
+
+    if (samples > mdi->extra_info.approx_total_samples) {
+        mdi->extra_info.approx_total_samples = samples;
+    }
+}
+
+/* empty the window, holding on to the lyric being shown */
+static void
+WM_DropWindow(struct _mdi *mdi) {
+    struct _midi_stream *stream = mdi->stream;
+
+    if (stream->lyric != mdi->lyric) {
+        free(stream->lyric);
+        stream->lyric = mdi->lyric;
+    }
+    _WM_DropEvents(mdi, stream->lyric);
+}
+
+/*
+ * Called with the events of the window all done, reads the next one and
+ * points event at its first event. Returns 0 once the song has ended.
+ */
+int
+_WM_StreamMore(struct _mdi *mdi, struct _event **event) {
+    if (!mdi->streaming) {
+        return (0);
+    }
+    WM_DropWindow(mdi);
+    WM_ReadStream(mdi);
+    WM_StreamLength(mdi);
+    *event = mdi->events;
+    mdi->current_event = *event;
+    return ((*event)->evtype != ev_null);
+}
+
+/* read the song from the start again, see _WM_ResetToStart() */
+void
+_WM_RestartStream(struct _mdi *mdi) {
+    struct _midi_stream *stream = mdi->stream;
+    struct _midi_tracks *t = &stream->tracks;
+    struct _event *event;
+
+    WM_DropWindow(mdi);
+    free(mdi->extra_info.copyright);
+    mdi->extra_info.copyright = NULL;
+
+    memcpy((void*)t->data, stream->start, sizeof(uint8_t *) * t->count);
+    memcpy(t->size, stream->start_size, sizeof(uint32_t) * t->count);
+    memcpy(t->delta, stream->start_delta, sizeof(uint32_t) * t->count);
+    memset(t->running_event, 0, t->count);
+    t->ended = 0;
+    t->samples_per_delta = _WM_GetSamplesPerTick(t->divisions, 500000, mdi->ctx->sample_rate);
+    t->sample_remainder = 0;
+    t->samples = 0;
+
+    /* the channels as _WM_initMDI() leaves them */
+    memset(stream->channel, 0, sizeof(stream->channel));
+    stream->channel[9].isdrum = 1;
+
+    _WM_midi_setup_divisions(mdi, t->divisions);
+    if (WM_StartTracks(mdi, t) == -1) {
+        t->ended = t->count;
+    }
+    WM_ReadStream(mdi);
+
+    if (mdi->extra_info.mixer_options & WM_MO_STRIPSILENCE) {
+        /*
+         * Only silence up to the first note on is stripped, within the
+         * first window, the end of the song is not known in advance.
+         */
+        stream->strip = 0;
+        event = mdi->events;
+        while ((event->evtype != ev_note_on) && (event->evtype != ev_null)) {
+            stream->strip += event->samples_to_next;
+            event->samples_to_next = 0;
+            event++;
+        }
+    }
+    WM_StreamLength(mdi);
+}
+
+void
+_WM_FreeStream(struct _mdi *mdi) {
+    struct _midi_stream *stream = mdi->stream;
+
+    if (stream == NULL) {
+        return;
+    }
+    WM_FreeTracks(&stream->tracks);
+    free((void*)stream->start);
+    free(stream->lyric);
+    free(stream->file);
+    free(stream);
+    mdi->stream = NULL;
+    mdi->streaming = 0;
+}
+
 struct _mdi *
-_WM_ParseNewMidi(const uint8_t *midi_data, uint32_t midi_size) {
+_WM_ParseNewMidi(struct _context *ctx, const uint8_t *midi_data, uint32_t midi_size) {
     struct _mdi *mdi;
 
     uint32_t tmp_val;
     uint32_t midi_type;
     const uint8_t **tracks;
     uint32_t *track_size;
-    uint32_t end_of_tracks = 0;
     uint32_t no_tracks;
     uint32_t i;
     uint32_t divisions = 96;
@@ -56,19 +402,23 @@ _WM_ParseNewMidi(const uint8_t *midi_data, uint32_t midi_size) {
     float sample_count_f = 0;
     float sample_remainder = 0;
     uint8_t *sysex_store = NULL;
+    const uint8_t *midi_file;
+    uint8_t *midi_copy = NULL;
+    struct _midi_tracks t;
+    struct _midi_stream *stream;
 
     uint32_t *track_delta;
     uint8_t *track_end;
     uint32_t smallest_delta = 0;
-    uint32_t subtract_delta = 0;
     uint8_t *running_event;
     uint32_t setup_ret = 0;
+    uint8_t parsed = 0;
 
     if (midi_size < 14) {
         _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_CORUPT, "(too short)", 0);
         return (NULL);
     }
-
+    midi_file = midi_data;
     if (!memcmp(midi_data, "RIFF", 4)) {
         if (midi_size < 34) {
             _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_CORUPT, "(too short)", 0);
@@ -141,18 +491,38 @@ _WM_ParseNewMidi(const uint8_t *midi_data, uint32_t midi_size) {
         return (NULL);
     }
 
-    samples_per_delta_f = _WM_GetSamplesPerTick(divisions, tempo);
+    samples_per_delta_f = _WM_GetSamplesPerTick(divisions, tempo, ctx->sample_rate);
 
-    mdi = _WM_initMDI();
+    if ((ctx->mixer_options & WM_MO_STREAM) && (midi_type != 2)) {
+        /* the tracks are read as the song plays, after the caller's
+         * buffer is gone */
+        midi_copy = (uint8_t *) malloc(midi_size + (midi_data - midi_file));
+        if (midi_copy == NULL) {
+            _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, 0);
+            return (NULL);
+        }
+        memcpy(midi_copy, midi_file, midi_size + (midi_data - midi_file));
+        midi_data = midi_copy + (midi_data - midi_file);
+    }
+
+    mdi = _WM_initMDI(ctx);
+    if (mdi == NULL) {
+        free(midi_copy);
+        return (NULL);
+    }
     _WM_midi_setup_divisions(mdi,divisions);
 
-    tracks = (const uint8_t **) malloc(sizeof(uint8_t *) * no_tracks);
-    track_size = (uint32_t *) malloc(sizeof(uint32_t) * no_tracks);
-    track_delta = (uint32_t *) malloc(sizeof(uint32_t) * no_tracks);
-    track_end = (uint8_t *) malloc(sizeof(uint8_t) * no_tracks);
-    running_event = (uint8_t *) malloc(sizeof(uint8_t) * no_tracks);
+    if (WM_AllocTracks(&t, midi_type, no_tracks) == -1) {
+        goto _end;
+    }
+    t.divisions = divisions;
+    t.samples_per_delta = samples_per_delta_f;
+    tracks = t.data;
+    track_size = t.size;
+    track_delta = t.delta;
+    track_end = t.end;
+    running_event = t.running_event;
 
-    smallest_delta = 0x7fffffff;
     for (i = 0; i < no_tracks; i++) {
         if (midi_size < 8) {
             _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_CORUPT, "(too short)", 0);
@@ -216,137 +586,63 @@ _WM_ParseNewMidi(const uint8_t *midi_data, uint32_t midi_size) {
         track_delta[i] = (track_delta[i] << 7) + (*tracks[i] & 0x7F);
         tracks[i]++;
         track_size[i]--;
-
-        if (midi_type == 1 ) {
-            if (track_delta[i] < smallest_delta) {
-                smallest_delta = track_delta[i];
-            }
-        } else {
-            /*
-             * Type 0 & 2 midi only needs delta from 1st track
-             * for initial sample calculations.
-             */
-            if (i == 0) smallest_delta = track_delta[i];
-        }
     }
 
-    if (smallest_delta >= 0x7fffffff) {
-        /* DEBUG */
-        /* fprintf(stderr,"CRAZY SMALLEST DELTA %u\n", smallest_delta); */
-        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_CORUPT, NULL, 0);
-        goto _end;
+    if (midi_copy) {
+        /* play it as it is read, see _WM_RestartStream() */
+        stream = (struct _midi_stream *) malloc(sizeof(struct _midi_stream));
+        if (stream == NULL) {
+            _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, 0);
+            goto _end;
+        }
+        memset(stream, 0, sizeof(struct _midi_stream));
+        stream->file = midi_copy;
+        stream->tracks = t;
+        t.data = NULL;
+        t.size = NULL;
+        t.delta = NULL;
+        t.end = NULL;
+        t.running_event = NULL;
+        t.heap.due = NULL;
+        midi_copy = NULL;
+        mdi->stream = stream;
+
+        /* start_size and start_delta come along with start */
+        stream->start = (const uint8_t **) malloc((sizeof(uint8_t *) + (sizeof(uint32_t) * 2)) * no_tracks);
+        if (stream->start == NULL) {
+            _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, 0);
+            goto _end;
+        }
+        stream->start_size = (uint32_t *) &stream->start[no_tracks];
+        stream->start_delta = &stream->start_size[no_tracks];
+        memcpy((void*)stream->start, tracks, sizeof(uint8_t *) * no_tracks);
+        memcpy(stream->start_size, track_size, sizeof(uint32_t) * no_tracks);
+        memcpy(stream->start_delta, track_delta, sizeof(uint32_t) * no_tracks);
+        goto _finish;
     }
 
-    if ((float)smallest_delta >= 0x7fffffff / samples_per_delta_f) {
-        /* DEBUG */
-        /* fprintf(stderr,"INTEGER OVERFLOW (samples_per_delta: %f, smallest_delta: %u)\n", */
-        /*        samples_per_delta_f, smallest_delta); */
-        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_CORUPT, NULL, 0);
+    if (WM_StartTracks(mdi, &t) == -1) {
         goto _end;
     }
-
-    subtract_delta = smallest_delta;
-    sample_count_f = (((float) smallest_delta * samples_per_delta_f) + sample_remainder);
-    sample_count = (uint32_t) sample_count_f;
-    sample_remainder = sample_count_f - (float) sample_count;
-
-    mdi->events[mdi->event_count - 1].samples_to_next += sample_count;
-    mdi->extra_info.approx_total_samples += sample_count;
+    smallest_delta = t.heap.now;
 
     /*
      * Handle type 0 & 2 the same, but type 1 differently
      */
     if (midi_type == 1) {
         /* Type 1 */
-        while (end_of_tracks != no_tracks) {
-            smallest_delta = 0;
-            for (i = 0; i < no_tracks; i++) {
-                if (track_end[i])
-                    continue;
-                if (track_delta[i]) {
-                    track_delta[i] -= subtract_delta;
-                    if (track_delta[i]) {
-                        if (!smallest_delta || (smallest_delta > track_delta[i])) {
-                            smallest_delta = track_delta[i];
-                        }
-                        continue;
-                    }
-                }
-                do {
-                    setup_ret = _WM_SetupMidiEvent(mdi, tracks[i], track_size[i], running_event[i]);
-                    if (setup_ret == 0) {
-                        goto _end;
-                    }
-                    if (tracks[i][0] > 0x7f) {
-                        if (tracks[i][0] < 0xf0) {
-                            /* Events 0x80 - 0xef set running event */
-                            running_event[i] = tracks[i][0];
-                        } else if ((tracks[i][0] == 0xf0) || (tracks[i][0] == 0xf7)) {
-                            /* Sysex resets running event */
-                            running_event[i] = 0;
-                        } else if ((tracks[i][0] == 0xff) && (tracks[i][1] == 0x2f) && (tracks[i][2] == 0x00)) {
-                            /* End of Track */
-                            end_of_tracks++;
-                            track_end[i] = 1;
-                            tracks[i] += 3;
-                            track_size[i] -= 3;
-                            goto NEXT_TRACK;
-                        } else if ((tracks[i][0] == 0xff) && (tracks[i][1] == 0x51) && (tracks[i][2] == 0x03)) {
-                            /* Tempo */
-                            tempo = (tracks[i][3] << 16) + (tracks[i][4] << 8)+ tracks[i][5];
-                            if (!tempo)
-                                tempo = 500000;
-
-                            samples_per_delta_f = _WM_GetSamplesPerTick(divisions, tempo);
-                        }
-                    }
-                    tracks[i] += setup_ret;
-                    track_size[i] -= setup_ret;
-
-                    if (*tracks[i] > 0x7f) {
-                        do {
-                            if (!track_size[i]) break;
-                            track_delta[i] = (track_delta[i] << 7) + (*tracks[i] & 0x7F);
-                            tracks[i]++;
-                            track_size[i]--;
-                        } while (*tracks[i] > 0x7f);
-                    }
-                    if (!track_size[i]) {
-                        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_CORUPT, "(too short)", 0);
-                        goto _end;
-                    }
-                    track_delta[i] = (track_delta[i] << 7) + (*tracks[i] & 0x7F);
-                    tracks[i]++;
-                    track_size[i]--;
-                } while (!track_delta[i]);
-                if ((!smallest_delta) || (smallest_delta > track_delta[i])) {
-                    smallest_delta = track_delta[i];
-                }
-            NEXT_TRACK: continue;
-            }
-
-            if ((float)smallest_delta >= 0x7fffffff / samples_per_delta_f) {
-                /* DEBUG */
-                /* fprintf(stderr,"INTEGER OVERFLOW (samples_per_delta: %f, smallest_delta: %u)\n", */
-                /*        samples_per_delta_f, smallest_delta); */
-                _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_CORUPT, NULL, 0);
+        while (t.ended != no_tracks) {
+            if (WM_MergeTracks(mdi, &t) == -1) {
                 goto _end;
             }
-            subtract_delta = smallest_delta;
-            sample_count_f = (((float) smallest_delta * samples_per_delta_f)
-                              + sample_remainder);
-            sample_count = (uint32_t) sample_count_f;
-            sample_remainder = sample_count_f - (float) sample_count;
-
-            mdi->events[mdi->event_count - 1].samples_to_next += sample_count;
-            mdi->extra_info.approx_total_samples += sample_count;
         }
+        mdi->extra_info.approx_total_samples += t.samples;
     } else {
         /* Type 0 & 2 */
         if (midi_type == 2) {
             mdi->is_type2 = 1;
         }
-        sample_remainder = 0;
+        mdi->extra_info.approx_total_samples += t.samples;
         for (i = 0; i < no_tracks; i++) {
             running_event[i] = 0;
             do {
@@ -371,7 +667,7 @@ _WM_ParseNewMidi(const uint8_t *midi_data, uint32_t midi_size) {
                         if (!tempo)
                             tempo = 500000;
 
-                        samples_per_delta_f = _WM_GetSamplesPerTick(divisions, tempo);
+                        samples_per_delta_f = _WM_GetSamplesPerTick(divisions, tempo, ctx->sample_rate);
                     }
                 }
                 tracks[i] += setup_ret;
@@ -419,40 +715,34 @@ _WM_ParseNewMidi(const uint8_t *midi_data, uint32_t midi_size) {
         }
     }
 
-    if ((mdi->reverb = _WM_init_reverb(_WM_SampleRate, _WM_reverb_room_width,
-            _WM_reverb_room_length, _WM_reverb_listen_posx, _WM_reverb_listen_posy))
-          == NULL) {
-        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, 0);
-        goto _end;
-    }
-
+_finish:
     mdi->extra_info.current_sample = 0;
     mdi->current_event = &mdi->events[0];
     mdi->samples_to_mix = 0;
-    mdi->note = NULL;
+    mdi->voice_count = 0;
 
     _WM_ResetToStart(mdi);
+    parsed = 1;
 
 _end:   free(sysex_store);
-    free(track_end);
-    free(track_delta);
-    free(running_event);
-    free((void*)tracks);
-    free(track_size);
-    if (mdi->reverb) return (mdi);
+    free(midi_copy);
+    WM_FreeTracks(&t);
+    if (parsed) return (mdi);
     _WM_freeMDI(mdi);
     return (NULL);
 }
 
 /*
- Convert WildMIDI's MDI events into a type 0 MIDI file.
+ Convert WildMIDI's MDI events into a MIDI file, handing it to write_fn
+ in order a chunk at a time.
 
  returns
  0 = successful
- -1 = failed
+ -1 = failed, or write_fn returned nonzero
 
- **out points to place to store stuff
- *outsize points to where to store byte counts
+ The file is never held in memory. Each track is run through twice, the
+ first time only counting its bytes so that the length in its header is
+ known before any of it is written, and the sink never has to seek.
 
  NOTE: This will only write out events that we do support.
 
@@ -461,561 +751,664 @@ _end:   free(sysex_store);
  Type 2 midi files will have each original track play on the same track one
  after the other in the type 0 file.
  */
-int
-_WM_Event2Midi(struct _mdi *mdi, uint8_t **out, uint32_t *outsize) {
-    uint32_t out_ofs = 0;
-    uint8_t running_event = 0;
-    uint32_t divisions = 96;
-    uint32_t tempo = 500000;
-    float samples_per_tick = 0;
-    unsigned long int value = 0;
-    float value_f = 0;
-    struct _event *event = mdi->events;
-    uint32_t track_size = 0;
-    uint32_t track_start = 0;
-    uint32_t track_count = 0;
 
-    if (!mdi->event_count) {
-        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_CONVERT, "(No events to convert)", 0);
-        return -1;
-    }
+#define SMF_CHUNK 4096
+
+/* the conversion state carried along the events, from track to track */
+struct _smf_state {
+    uint32_t divisions;
+    uint32_t tempo;
+    float samples_per_tick;
+    uint8_t running_event;
+};
+
+/* where the file goes, only counted when there is no write_fn */
+struct _smf_out {
+    int (*write_fn)(void *ctx, const uint8_t *data, uint32_t size);
+    void *ctx;
+    uint32_t total;
+    uint32_t fill;
+    int failed;
+    uint8_t chunk[SMF_CHUNK];
+};
+
+static void WM_SmfFlush(struct _smf_out *o) {
+    if ((o->fill) && (o->write_fn) && (!o->failed)
+            && (o->write_fn(o->ctx, o->chunk, o->fill) != 0))
+        o->failed = 1;
+    o->total += o->fill;
+    o->fill = 0;
+}
 
-    samples_per_tick = _WM_GetSamplesPerTick(divisions, tempo);
+static void WM_SmfPut(struct _smf_out *o, const uint8_t *data, uint32_t size) {
+    uint32_t len;
+
+    while (size) {
+        len = SMF_CHUNK - o->fill;
+        if (len > size)
+            len = size;
+        memcpy(&o->chunk[o->fill], data, len);
+        o->fill += len;
+        data += len;
+        size -= len;
+        if (o->fill == SMF_CHUNK)
+            WM_SmfFlush(o);
+    }
+}
 
-    /*
-     Note: This isn't accurate but will allow enough space for
-            events plus delta values.
-     */
-    (*out) = (uint8_t *) malloc (sizeof(uint8_t) * (mdi->event_count * 12));
+static uint8_t *WM_SmfVarLen(uint8_t *p, unsigned long int value) {
+    if (value > 0x0fffffff)
+        *p++ = (((value >> 28) &0x7f) | 0x80);
+    if (value > 0x1fffff)
+        *p++ = (((value >> 21) &0x7f) | 0x80);
+    if (value > 0x3fff)
+        *p++ = (((value >> 14) & 0x7f) | 0x80);
+    if (value > 0x7f)
+        *p++ = (((value >> 7) & 0x7f) | 0x80);
+    *p++ = (value & 0x7f);
+    return (p);
+}
 
-    /* Midi Header */
-    (*out)[0] = 'M';
-    (*out)[1] = 'T';
-    (*out)[2] = 'h';
-    (*out)[3] = 'd';
-    (*out)[4] = 0x00;
-    (*out)[5] = 0x00;
-    (*out)[6] = 0x00;
-    (*out)[7] = 0x06;
-    if ((!(_WM_MixerOptions & WM_MO_SAVEASTYPE0)) && (mdi->is_type2)) {
-        /* Type 2 */
-        (*out)[8] = 0x00;
-        (*out)[9] = 0x02;
-    } else {
-        /* Type 0 */
-        (*out)[8] = 0x00;
-        (*out)[9] = 0x00;
-    }
-    /* No. of tracks stored in 10-11 *** See below */
-    /* Division stored in 12-13 *** See below */
-    /* Track Header */
-    (*out)[14] = 'M';
-    (*out)[15] = 'T';
-    (*out)[16] = 'r';
-    (*out)[17] = 'k';
-    /* Track size stored in 18-21 *** see below */
-    out_ofs = 22;
-    track_start = out_ofs;
-    track_count++;
+/*
+ Write one track from event on, all of the song unless type 2 is kept.
+ Returns the event following the track.
+ */
+static struct _event *
+WM_SmfTrack(struct _mdi *mdi, struct _event *event, struct _smf_state *st,
+            struct _smf_out *o, int split) {
+    unsigned long int value = 0;
+    float value_f = 0;
+    struct _event_data data;
+    uint8_t *p;
+
+    if (event != mdi->events) {
+        /* a track following another starts at once, the delta of the end
+           of the track before is dropped */
+        o->chunk[o->fill++] = 0;
+        st->running_event = 0;
+    }
 
     do {
+        /* room for any event other than text, and its delta */
+        if (o->fill > SMF_CHUNK - 32)
+            WM_SmfFlush(o);
+        p = &o->chunk[o->fill];
+
+        _WM_EventData(mdi, event, &data);
         /* TODO Is there a better way? */
         switch (event->evtype) {
         case ev_midi_divisions:
             /* DEBUG */
-            /* fprintf(stderr,"Division: %u\r\n",event->event_data.data); */
-            divisions = event->event_data.data.value;
-            (*out)[12] = (divisions >> 8) & 0xff;
-            (*out)[13] = divisions & 0xff;
-            samples_per_tick = _WM_GetSamplesPerTick(divisions, tempo);
+            /* fprintf(stderr,"Division: %u\r\n",data.data); */
+            st->divisions = data.data.value;
+            st->samples_per_tick = _WM_GetSamplesPerTick(st->divisions, st->tempo, mdi->ctx->sample_rate);
             break;
         case ev_note_off:
             /* DEBUG */
-            /* fprintf(stderr,"Note Off: %u %.4x\r\n",event->event_data.channel, event->event_data.data); */
-            if (running_event != (0x80 | event->event_data.channel)) {
-                (*out)[out_ofs++] = 0x80 | event->event_data.channel;
-                running_event = (*out)[out_ofs - 1];
+            /* fprintf(stderr,"Note Off: %u %.4x\r\n",data.channel, data.data); */
+            if (st->running_event != (0x80 | data.channel)) {
+                *p++ = 0x80 | data.channel;
+                st->running_event = p[-1];
             }
-            (*out)[out_ofs++] = (event->event_data.data.value >> 8) & 0xff;
-            (*out)[out_ofs++] = event->event_data.data.value & 0xff;
+            *p++ = (data.data.value >> 8) & 0xff;
+            *p++ = data.data.value & 0xff;
             break;
         case ev_note_on:
             /* DEBUG */
-            /* fprintf(stderr,"Note On: %u %.4x\r\n",event->event_data.channel, event->event_data.data); */
-            if (running_event != (0x90 | event->event_data.channel)) {
-                (*out)[out_ofs++] = 0x90 | event->event_data.channel;
-                running_event = (*out)[out_ofs - 1];
+            /* fprintf(stderr,"Note On: %u %.4x\r\n",data.channel, data.data); */
+            if (st->running_event != (0x90 | data.channel)) {
+                *p++ = 0x90 | data.channel;
+                st->running_event = p[-1];
             }
-            (*out)[out_ofs++] = (event->event_data.data.value >> 8) & 0xff;
-            (*out)[out_ofs++] = event->event_data.data.value & 0xff;
+            *p++ = (data.data.value >> 8) & 0xff;
+            *p++ = data.data.value & 0xff;
             break;
         case ev_aftertouch:
             /* DEBUG */
-            /* fprintf(stderr,"Aftertouch: %u %.4x\r\n",event->event_data.channel, event->event_data.data); */
-            if (running_event != (0xa0 | event->event_data.channel)) {
-                (*out)[out_ofs++] = 0xa0 | event->event_data.channel;
-                running_event = (*out)[out_ofs - 1];
+            /* fprintf(stderr,"Aftertouch: %u %.4x\r\n",data.channel, data.data); */
+            if (st->running_event != (0xa0 | data.channel)) {
+                *p++ = 0xa0 | data.channel;
+                st->running_event = p[-1];
             }
-            (*out)[out_ofs++] = (event->event_data.data.value >> 8) & 0xff;
-            (*out)[out_ofs++] = event->event_data.data.value & 0xff;
+            *p++ = (data.data.value >> 8) & 0xff;
+            *p++ = data.data.value & 0xff;
             break;
         case ev_control_bank_select:
             /* DEBUG */
-            /* fprintf(stderr,"Control Bank Select: %u %.4x\r\n",event->event_data.channel, event->event_data.data); */
-            if (running_event != (0xb0 | event->event_data.channel)) {
-                (*out)[out_ofs++] = 0xb0 | event->event_data.channel;
-                running_event = (*out)[out_ofs - 1];
+            /* fprintf(stderr,"Control Bank Select: %u %.4x\r\n",data.channel, data.data); */
+            if (st->running_event != (0xb0 | data.channel)) {
+                *p++ = 0xb0 | data.channel;
+                st->running_event = p[-1];
             }
-            (*out)[out_ofs++] = 0;
-            (*out)[out_ofs++] = event->event_data.data.value & 0xff;
+            *p++ = 0;
+            *p++ = data.data.value & 0xff;
             break;
         case ev_control_data_entry_course:
             /* DEBUG */
-            /* fprintf(stderr,"Control Data Entry Course: %u %.4x\r\n",event->event_data.channel, event->event_data.data); */
-            if (running_event != (0xb0 | event->event_data.channel)) {
-                (*out)[out_ofs++] = 0xb0 | event->event_data.channel;
-                running_event = (*out)[out_ofs - 1];
+            /* fprintf(stderr,"Control Data Entry Course: %u %.4x\r\n",data.channel, data.data); */
+            if (st->running_event != (0xb0 | data.channel)) {
+                *p++ = 0xb0 | data.channel;
+                st->running_event = p[-1];
             }
-            (*out)[out_ofs++] = 6;
-            (*out)[out_ofs++] = event->event_data.data.value & 0xff;
+            *p++ = 6;
+            *p++ = data.data.value & 0xff;
             break;
         case ev_control_channel_volume:
             /* DEBUG */
-            /* fprintf(stderr,"Control Channel Volume: %u %.4x\r\n",event->event_data.channel, event->event_data.data); */
-            if (running_event != (0xb0 | event->event_data.channel)) {
-                (*out)[out_ofs++] = 0xb0 | event->event_data.channel;
-                running_event = (*out)[out_ofs - 1];
+            /* fprintf(stderr,"Control Channel Volume: %u %.4x\r\n",data.channel, data.data); */
+            if (st->running_event != (0xb0 | data.channel)) {
+                *p++ = 0xb0 | data.channel;
+                st->running_event = p[-1];
             }
-            (*out)[out_ofs++] = 7;
-            (*out)[out_ofs++] = event->event_data.data.value & 0xff;
+            *p++ = 7;
+            *p++ = data.data.value & 0xff;
             break;
         case ev_control_channel_balance:
             /* DEBUG */
-            /* fprintf(stderr,"Control Channel Balance: %u %.4x\r\n",event->event_data.channel, event->event_data.data); */
-            if (running_event != (0xb0 | event->event_data.channel)) {
-                (*out)[out_ofs++] = 0xb0 | event->event_data.channel;
-                running_event = (*out)[out_ofs - 1];
+            /* fprintf(stderr,"Control Channel Balance: %u %.4x\r\n",data.channel, data.data); */
+            if (st->running_event != (0xb0 | data.channel)) {
+                *p++ = 0xb0 | data.channel;
+                st->running_event = p[-1];
             }
-            (*out)[out_ofs++] = 8;
-            (*out)[out_ofs++] = event->event_data.data.value & 0xff;
+            *p++ = 8;
+            *p++ = data.data.value & 0xff;
             break;
         case ev_control_channel_pan:
             /* DEBUG */
-            /* fprintf(stderr,"Control Channel Pan: %u %.4x\r\n",event->event_data.channel, event->event_data.data); */
-            if (running_event != (0xb0 | event->event_data.channel)) {
-                (*out)[out_ofs++] = 0xb0 | event->event_data.channel;
-                running_event = (*out)[out_ofs - 1];
+            /* fprintf(stderr,"Control Channel Pan: %u %.4x\r\n",data.channel, data.data); */
+            if (st->running_event != (0xb0 | data.channel)) {
+                *p++ = 0xb0 | data.channel;
+                st->running_event = p[-1];
             }
-            (*out)[out_ofs++] = 10;
-            (*out)[out_ofs++] = event->event_data.data.value & 0xff;
+            *p++ = 10;
+            *p++ = data.data.value & 0xff;
             break;
         case ev_control_channel_expression:
             /* DEBUG */
-            /* fprintf(stderr,"Control Channel Expression: %u %.4x\r\n",event->event_data.channel, event->event_data.data); */
-            if (running_event != (0xb0 | event->event_data.channel)) {
-                (*out)[out_ofs++] = 0xb0 | event->event_data.channel;
-                running_event = (*out)[out_ofs - 1];
+            /* fprintf(stderr,"Control Channel Expression: %u %.4x\r\n",data.channel, data.data); */
+            if (st->running_event != (0xb0 | data.channel)) {
+                *p++ = 0xb0 | data.channel;
+                st->running_event = p[-1];
             }
-            (*out)[out_ofs++] = 11;
-            (*out)[out_ofs++] = event->event_data.data.value & 0xff;
+            *p++ = 11;
+            *p++ = data.data.value & 0xff;
             break;
         case ev_control_data_entry_fine:
             /* DEBUG */
-            /* fprintf(stderr,"Control Data Entry Fine: %u %.4x\r\n",event->event_data.channel, event->event_data.data); */
-            if (running_event != (0xb0 | event->event_data.channel)) {
-                (*out)[out_ofs++] = 0xb0 | event->event_data.channel;
-                running_event = (*out)[out_ofs - 1];
+            /* fprintf(stderr,"Control Data Entry Fine: %u %.4x\r\n",data.channel, data.data); */
+            if (st->running_event != (0xb0 | data.channel)) {
+                *p++ = 0xb0 | data.channel;
+                st->running_event = p[-1];
             }
-            (*out)[out_ofs++] = 38;
-            (*out)[out_ofs++] = event->event_data.data.value & 0xff;
+            *p++ = 38;
+            *p++ = data.data.value & 0xff;
             break;
         case ev_control_channel_hold:
             /* DEBUG */
-            /* fprintf(stderr,"Control Channel Hold: %u %.4x\r\n",event->event_data.channel, event->event_data.data); */
-            if (running_event != (0xb0 | event->event_data.channel)) {
-                (*out)[out_ofs++] = 0xb0 | event->event_data.channel;
-                running_event = (*out)[out_ofs - 1];
+            /* fprintf(stderr,"Control Channel Hold: %u %.4x\r\n",data.channel, data.data); */
+            if (st->running_event != (0xb0 | data.channel)) {
+                *p++ = 0xb0 | data.channel;
+                st->running_event = p[-1];
             }
-            (*out)[out_ofs++] = 64;
-            (*out)[out_ofs++] = event->event_data.data.value & 0xff;
+            *p++ = 64;
+            *p++ = data.data.value & 0xff;
             break;
         case ev_control_data_increment:
             /* DEBUG */
-            /* fprintf(stderr,"Control Data Increment: %u %.4x\r\n",event->event_data.channel, event->event_data.data); */
-            if (running_event != (0xb0 | event->event_data.channel)) {
-                (*out)[out_ofs++] = 0xb0 | event->event_data.channel;
-                running_event = (*out)[out_ofs - 1];
+            /* fprintf(stderr,"Control Data Increment: %u %.4x\r\n",data.channel, data.data); */
+            if (st->running_event != (0xb0 | data.channel)) {
+                *p++ = 0xb0 | data.channel;
+                st->running_event = p[-1];
             }
-            (*out)[out_ofs++] = 96;
-            (*out)[out_ofs++] = event->event_data.data.value & 0xff;
+            *p++ = 96;
+            *p++ = data.data.value & 0xff;
             break;
         case ev_control_data_decrement:
             /* DEBUG */
-            /* fprintf(stderr,"Control Data Decrement: %u %.4x\r\n",event->event_data.channel, event->event_data.data); */
-            if (running_event != (0xb0 | event->event_data.channel)) {
-                (*out)[out_ofs++] = 0xb0 | event->event_data.channel;
-                running_event = (*out)[out_ofs - 1];
+            /* fprintf(stderr,"Control Data Decrement: %u %.4x\r\n",data.channel, data.data); */
+            if (st->running_event != (0xb0 | data.channel)) {
+                *p++ = 0xb0 | data.channel;
+                st->running_event = p[-1];
             }
-            (*out)[out_ofs++] = 97;
-            (*out)[out_ofs++] = event->event_data.data.value & 0xff;
+            *p++ = 97;
+            *p++ = data.data.value & 0xff;
             break;
         case ev_control_non_registered_param_fine:
             /* DEBUG */
-            /* fprintf(stderr,"Control Non Registered Param: %u %.4x\r\n",event->event_data.channel, event->event_data.data); */
-            if (running_event != (0xb0 | event->event_data.channel)) {
-                (*out)[out_ofs++] = 0xb0 | event->event_data.channel;
-                running_event = (*out)[out_ofs - 1];
+            /* fprintf(stderr,"Control Non Registered Param: %u %.4x\r\n",data.channel, data.data); */
+            if (st->running_event != (0xb0 | data.channel)) {
+                *p++ = 0xb0 | data.channel;
+                st->running_event = p[-1];
             }
-            (*out)[out_ofs++] = 98;
-            (*out)[out_ofs++] = event->event_data.data.value & 0x7f;
+            *p++ = 98;
+            *p++ = data.data.value & 0x7f;
             break;
         case ev_control_non_registered_param_course:
             /* DEBUG */
-            /* fprintf(stderr,"Control Non Registered Param: %u %.4x\r\n",event->event_data.channel, event->event_data.data); */
-            if (running_event != (0xb0 | event->event_data.channel)) {
-                (*out)[out_ofs++] = 0xb0 | event->event_data.channel;
-                running_event = (*out)[out_ofs - 1];
+            /* fprintf(stderr,"Control Non Registered Param: %u %.4x\r\n",data.channel, data.data); */
+            if (st->running_event != (0xb0 | data.channel)) {
+                *p++ = 0xb0 | data.channel;
+                st->running_event = p[-1];
             }
-            (*out)[out_ofs++] = 99;
-            (*out)[out_ofs++] = (event->event_data.data.value >> 7) & 0x7f;
+            *p++ = 99;
+            *p++ = (data.data.value >> 7) & 0x7f;
             break;
         case ev_control_registered_param_fine:
             /* DEBUG */
-            /* fprintf(stderr,"Control Registered Param Fine: %u %.4x\r\n",event->event_data.channel, event->event_data.data); */
-            if (running_event != (0xb0 | event->event_data.channel)) {
-                (*out)[out_ofs++] = 0xb0 | event->event_data.channel;
-                running_event = (*out)[out_ofs - 1];
+            /* fprintf(stderr,"Control Registered Param Fine: %u %.4x\r\n",data.channel, data.data); */
+            if (st->running_event != (0xb0 | data.channel)) {
+                *p++ = 0xb0 | data.channel;
+                st->running_event = p[-1];
             }
-            (*out)[out_ofs++] = 100;
-            (*out)[out_ofs++] = event->event_data.data.value & 0x7f;
+            *p++ = 100;
+            *p++ = data.data.value & 0x7f;
             break;
         case ev_control_registered_param_course:
             /* DEBUG */
-            /* fprintf(stderr,"Control Registered Param Course: %u %.4x\r\n",event->event_data.channel, event->event_data.data); */
-            if (running_event != (0xb0 | event->event_data.channel)) {
-                (*out)[out_ofs++] = 0xb0 | event->event_data.channel;
-                running_event = (*out)[out_ofs - 1];
+            /* fprintf(stderr,"Control Registered Param Course: %u %.4x\r\n",data.channel, data.data); */
+            if (st->running_event != (0xb0 | data.channel)) {
+                *p++ = 0xb0 | data.channel;
+                st->running_event = p[-1];
             }
-            (*out)[out_ofs++] = 101;
-            (*out)[out_ofs++] = (event->event_data.data.value >> 7) & 0x7f;
+            *p++ = 101;
+            *p++ = (data.data.value >> 7) & 0x7f;
             break;
         case ev_control_channel_sound_off:
             /* DEBUG */
-            /* fprintf(stderr,"Control Channel Sound Off: %u %.4x\r\n",event->event_data.channel, event->event_data.data); */
-            if (running_event != (0xb0 | event->event_data.channel)) {
-                (*out)[out_ofs++] = 0xb0 | event->event_data.channel;
-                running_event = (*out)[out_ofs - 1];
+            /* fprintf(stderr,"Control Channel Sound Off: %u %.4x\r\n",data.channel, data.data); */
+            if (st->running_event != (0xb0 | data.channel)) {
+                *p++ = 0xb0 | data.channel;
+                st->running_event = p[-1];
             }
-            (*out)[out_ofs++] = 120;
-            (*out)[out_ofs++] = event->event_data.data.value & 0xff;
+            *p++ = 120;
+            *p++ = data.data.value & 0xff;
             break;
         case ev_control_channel_controllers_off:
             /* DEBUG */
-            /* fprintf(stderr,"Control Channel Controllers Off: %u %.4x\r\n",event->event_data.channel, event->event_data.data); */
-            if (running_event != (0xb0 | event->event_data.channel)) {
-                (*out)[out_ofs++] = 0xb0 | event->event_data.channel;
-                running_event = (*out)[out_ofs - 1];
+            /* fprintf(stderr,"Control Channel Controllers Off: %u %.4x\r\n",data.channel, data.data); */
+            if (st->running_event != (0xb0 | data.channel)) {
+                *p++ = 0xb0 | data.channel;
+                st->running_event = p[-1];
             }
-            (*out)[out_ofs++] = 121;
-            (*out)[out_ofs++] = event->event_data.data.value & 0xff;
+            *p++ = 121;
+            *p++ = data.data.value & 0xff;
             break;
         case ev_control_channel_notes_off:
             /* DEBUG */
-            /* fprintf(stderr,"Control Channel Notes Off: %u %.4x\r\n",event->event_data.channel, event->event_data.data); */
-            if (running_event != (0xb0 | event->event_data.channel)) {
-                (*out)[out_ofs++] = 0xb0 | event->event_data.channel;
-                running_event = (*out)[out_ofs - 1];
+            /* fprintf(stderr,"Control Channel Notes Off: %u %.4x\r\n",data.channel, data.data); */
+            if (st->running_event != (0xb0 | data.channel)) {
+                *p++ = 0xb0 | data.channel;
+                st->running_event = p[-1];
             }
-            (*out)[out_ofs++] = 123;
-            (*out)[out_ofs++] = event->event_data.data.value & 0xff;
+            *p++ = 123;
+            *p++ = data.data.value & 0xff;
             break;
         case ev_control_dummy:
             /* DEBUG */
-            /* fprintf(stderr,"Control Dummy Event: %u %.4x\r\n",event->event_data.channel, event->event_data.data); */
-            if (running_event != (0xb0 | event->event_data.channel)) {
-                (*out)[out_ofs++] = 0xb0 | event->event_data.channel;
-                running_event = (*out)[out_ofs - 1];
+            /* fprintf(stderr,"Control Dummy Event: %u %.4x\r\n",data.channel, data.data); */
+            if (st->running_event != (0xb0 | data.channel)) {
+                *p++ = 0xb0 | data.channel;
+                st->running_event = p[-1];
             }
-            (*out)[out_ofs++] = (event->event_data.data.value >> 8) & 0xff;
-            (*out)[out_ofs++] = event->event_data.data.value & 0xff;
+            *p++ = (data.data.value >> 8) & 0xff;
+            *p++ = data.data.value & 0xff;
             break;
         case ev_patch:
             /* DEBUG */
-            /* fprintf(stderr,"Patch: %u %.4x\r\n",event->event_data.channel, event->event_data.data); */
-            if (running_event != (0xc0 | event->event_data.channel)) {
-                (*out)[out_ofs++] = 0xc0 | event->event_data.channel;
-                running_event = (*out)[out_ofs - 1];
+            /* fprintf(stderr,"Patch: %u %.4x\r\n",data.channel, data.data); */
+            if (st->running_event != (0xc0 | data.channel)) {
+                *p++ = 0xc0 | data.channel;
+                st->running_event = p[-1];
             }
-            (*out)[out_ofs++] = event->event_data.data.value & 0xff;
+            *p++ = data.data.value & 0xff;
             break;
         case ev_channel_pressure:
             /* DEBUG */
-            /* fprintf(stderr,"Channel Pressure: %u %.4x\r\n",event->event_data.channel, event->event_data.data); */
-            if (running_event != (0xd0 | event->event_data.channel)) {
-                (*out)[out_ofs++] = 0xd0 | event->event_data.channel;
-                running_event = (*out)[out_ofs - 1];
+            /* fprintf(stderr,"Channel Pressure: %u %.4x\r\n",data.channel, data.data); */
+            if (st->running_event != (0xd0 | data.channel)) {
+                *p++ = 0xd0 | data.channel;
+                st->running_event = p[-1];
             }
-            (*out)[out_ofs++] = event->event_data.data.value & 0xff;
+            *p++ = data.data.value & 0xff;
             break;
         case ev_pitch:
             /* DEBUG */
-            /* fprintf(stderr,"Pitch: %u %.4x\r\n",event->event_data.channel, event->event_data.data); */
-            if (running_event != (0xe0 | event->event_data.channel)) {
-                (*out)[out_ofs++] = 0xe0 | event->event_data.channel;
-                running_event = (*out)[out_ofs - 1];
+            /* fprintf(stderr,"Pitch: %u %.4x\r\n",data.channel, data.data); */
+            if (st->running_event != (0xe0 | data.channel)) {
+                *p++ = 0xe0 | data.channel;
+                st->running_event = p[-1];
             }
-            (*out)[out_ofs++] = event->event_data.data.value & 0x7f;
-            (*out)[out_ofs++] = (event->event_data.data.value >> 7) & 0x7f;
+            *p++ = data.data.value & 0x7f;
+            *p++ = (data.data.value >> 7) & 0x7f;
             break;
         case ev_sysex_roland_drum_track: {
             /* DEBUG */
-            /* fprintf(stderr,"Sysex Roland Drum Track: %u %.4x\r\n",event->event_data.channel, event->event_data.data); */
+            /* fprintf(stderr,"Sysex Roland Drum Track: %u %.4x\r\n",data.channel, data.data); */
             uint8_t foo[] = {0xf0, 0x09, 0x41, 0x10, 0x42, 0x12, 0x40, 0x00, 0x15, 0x00, 0xf7};
-            uint8_t foo_ch = event->event_data.channel;
+            uint8_t foo_ch = data.channel;
             if (foo_ch == 9) {
                 foo_ch = 0;
             } else if (foo_ch < 9) {
                 foo_ch++;
             }
             foo[7] = 0x10 | foo_ch;
-            foo[9] = event->event_data.data.value;
-            memcpy(&((*out)[out_ofs]),foo,11);
-            out_ofs += 11;
-            running_event = 0;
+            foo[9] = data.data.value;
+            memcpy(p, foo, 11);
+            p += 11;
+            st->running_event = 0;
           } break;
         case ev_sysex_gm_reset: {
             /* DEBUG */
             /* fprintf(stderr,"Sysex GM Reset\r\n"); */
             uint8_t foo[] = {0xf0, 0x05, 0x7e, 0x7f, 0x09, 0x01, 0xf7};
-            memcpy(&((*out)[out_ofs]),foo,7);
-            out_ofs += 7;
-            running_event = 0;
+            memcpy(p, foo, 7);
+            p += 7;
+            st->running_event = 0;
           } break;
         case ev_sysex_roland_reset: {
             /* DEBUG */
             /* fprintf(stderr,"Sysex Roland Reset\r\n"); */
             uint8_t foo[] = {0xf0, 0x0a, 0x41, 0x10, 0x42, 0x12, 0x40, 0x00, 0x7f, 0x00, 0x41, 0xf7};
-            memcpy(&((*out)[out_ofs]),foo,12);
-            out_ofs += 12;
-            running_event = 0;
+            memcpy(p, foo, 12);
+            p += 12;
+            st->running_event = 0;
           } break;
         case ev_sysex_yamaha_reset: {
             /* DEBUG */
             /* fprintf(stderr,"Sysex Yamaha Reset\r\n"); */
             uint8_t foo[] = {0xf0, 0x08, 0x43, 0x10, 0x4c, 0x00, 0x00, 0x7e, 0x00, 0xf7};
-            memcpy(&((*out)[out_ofs]),foo,10);
-            out_ofs += 10;
-            running_event = 0;
+            memcpy(p, foo, 10);
+            p += 10;
+            st->running_event = 0;
           } break;
         case ev_meta_endoftrack:
             /* DEBUG */
             /* fprintf(stderr,"End Of Track\r\n"); */
-            if ((!(_WM_MixerOptions & WM_MO_SAVEASTYPE0)) && (mdi->is_type2)) {
+            if (split) {
                 /* Write end of track marker */
-                (*out)[out_ofs++] = 0xff;
-                (*out)[out_ofs++] = 0x2f;
-                (*out)[out_ofs++] = 0x00;
-                track_size = out_ofs - track_start;
-                (*out)[track_start - 4] = (track_size >> 24) & 0xff;
-                (*out)[track_start - 3] = (track_size >> 16) & 0xff;
-                (*out)[track_start - 2] = (track_size >> 8) & 0xff;
-                (*out)[track_start - 1] = track_size & 0xff;
-
-                if (event[1].evtype != ev_null) {
-                    (*out)[out_ofs++] = 'M';
-                    (*out)[out_ofs++] = 'T';
-                    (*out)[out_ofs++] = 'r';
-                    (*out)[out_ofs++] = 'k';
-                    track_count++;
-                    out_ofs += 4;
-                    track_start = out_ofs;
-
-                    /* write out a 0 delta */
-                    (*out)[out_ofs++] = 0;
-
-                    running_event = 0;
-                }
+                *p++ = 0xff;
+                *p++ = 0x2f;
+                *p++ = 0x00;
+                o->fill = p - o->chunk;
+                return (event + 1);
             }
             goto NEXT_EVENT;
         case ev_meta_tempo:
             /* DEBUG */
-            /* fprintf(stderr,"Tempo: %u\r\n",event->event_data.data); */
-            tempo = event->event_data.data.value & 0xffffff;
+            /* fprintf(stderr,"Tempo: %u\r\n",data.data); */
+            st->tempo = data.data.value & 0xffffff;
 
-            samples_per_tick = _WM_GetSamplesPerTick(divisions, tempo);
+            st->samples_per_tick = _WM_GetSamplesPerTick(st->divisions, st->tempo, mdi->ctx->sample_rate);
 
             /* DEBUG */
             /* fprintf(stderr,"\rDEBUG: div %i, tempo %i, bpm %f, pps %f, spd %f\r\n", divisions, tempo, bpm_f, pulses_per_second_f, samples_per_delta_f); */
 
-            (*out)[out_ofs++] = 0xff;
-            (*out)[out_ofs++] = 0x51;
-            (*out)[out_ofs++] = 0x03;
-            (*out)[out_ofs++] = (tempo & 0xff0000) >> 16;
-            (*out)[out_ofs++] = (tempo & 0xff00) >> 8;
-            (*out)[out_ofs++] = (tempo & 0xff);
+            *p++ = 0xff;
+            *p++ = 0x51;
+            *p++ = 0x03;
+            *p++ = (st->tempo & 0xff0000) >> 16;
+            *p++ = (st->tempo & 0xff00) >> 8;
+            *p++ = (st->tempo & 0xff);
             break;
         case ev_meta_timesignature:
             /* DEBUG */
-            /* fprintf(stderr,"Time Signature: %x\r\n",event->event_data.data); */
-            (*out)[out_ofs++] = 0xff;
-            (*out)[out_ofs++] = 0x58;
-            (*out)[out_ofs++] = 0x04;
-            (*out)[out_ofs++] = (event->event_data.data.value & 0xff000000) >> 24;
-            (*out)[out_ofs++] = (event->event_data.data.value & 0xff0000) >> 16;
-            (*out)[out_ofs++] = (event->event_data.data.value & 0xff00) >> 8;
-            (*out)[out_ofs++] = (event->event_data.data.value & 0xff);
+            /* fprintf(stderr,"Time Signature: %x\r\n",data.data); */
+            *p++ = 0xff;
+            *p++ = 0x58;
+            *p++ = 0x04;
+            *p++ = (data.data.value & 0xff000000) >> 24;
+            *p++ = (data.data.value & 0xff0000) >> 16;
+            *p++ = (data.data.value & 0xff00) >> 8;
+            *p++ = (data.data.value & 0xff);
             break;
         case ev_meta_keysignature:
             /* DEBUG */
-            /* fprintf(stderr,"Key Signature: %x\r\n",event->event_data.data); */
-            (*out)[out_ofs++] = 0xff;
-            (*out)[out_ofs++] = 0x59;
-            (*out)[out_ofs++] = 0x02;
-            (*out)[out_ofs++] = (event->event_data.data.value & 0xff00) >> 8;
-            (*out)[out_ofs++] = (event->event_data.data.value & 0xff);
+            /* fprintf(stderr,"Key Signature: %x\r\n",data.data); */
+            *p++ = 0xff;
+            *p++ = 0x59;
+            *p++ = 0x02;
+            *p++ = (data.data.value & 0xff00) >> 8;
+            *p++ = (data.data.value & 0xff);
             break;
         case ev_meta_sequenceno:
             /* DEBUG */
-            /* fprintf(stderr,"Sequence Number: %x\r\n",event->event_data.data); */
-            (*out)[out_ofs++] = 0xff;
-            (*out)[out_ofs++] = 0x00;
-            (*out)[out_ofs++] = 0x02;
-            (*out)[out_ofs++] = (event->event_data.data.value & 0xff00) >> 8;
-            (*out)[out_ofs++] = (event->event_data.data.value & 0xff);
+            /* fprintf(stderr,"Sequence Number: %x\r\n",data.data); */
+            *p++ = 0xff;
+            *p++ = 0x00;
+            *p++ = 0x02;
+            *p++ = (data.data.value & 0xff00) >> 8;
+            *p++ = (data.data.value & 0xff);
             break;
         case ev_meta_channelprefix:
             /* DEBUG */
-            /* fprintf(stderr,"Channel Prefix: %x\r\n",event->event_data.data); */
-            (*out)[out_ofs++] = 0xff;
-            (*out)[out_ofs++] = 0x20;
-            (*out)[out_ofs++] = 0x01;
-            (*out)[out_ofs++] = (event->event_data.data.value & 0xff);
+            /* fprintf(stderr,"Channel Prefix: %x\r\n",data.data); */
+            *p++ = 0xff;
+            *p++ = 0x20;
+            *p++ = 0x01;
+            *p++ = (data.data.value & 0xff);
             break;
         case ev_meta_portprefix:
             /* DEBUG */
-            /* fprintf(stderr,"Port Prefix: %x\r\n",event->event_data.data); */
-            (*out)[out_ofs++] = 0xff;
-            (*out)[out_ofs++] = 0x21;
-            (*out)[out_ofs++] = 0x01;
-            (*out)[out_ofs++] = (event->event_data.data.value & 0xff);
+            /* fprintf(stderr,"Port Prefix: %x\r\n",data.data); */
+            *p++ = 0xff;
+            *p++ = 0x21;
+            *p++ = 0x01;
+            *p++ = (data.data.value & 0xff);
             break;
         case ev_meta_smpteoffset:
             /* DEBUG */
-            /* fprintf(stderr,"SMPTE Offset: %x\r\n",event->event_data.data); */
-            (*out)[out_ofs++] = 0xff;
-            (*out)[out_ofs++] = 0x54;
-            (*out)[out_ofs++] = 0x05;
+            /* fprintf(stderr,"SMPTE Offset: %x\r\n",data.data); */
+            *p++ = 0xff;
+            *p++ = 0x54;
+            *p++ = 0x05;
             /*
              Remember because of the 5 bytes we stored it a little hacky.
              */
-            (*out)[out_ofs++] = (event->event_data.channel & 0xff);
-            (*out)[out_ofs++] = (event->event_data.data.value & 0xff000000) >> 24;
-            (*out)[out_ofs++] = (event->event_data.data.value & 0xff0000) >> 16;
-            (*out)[out_ofs++] = (event->event_data.data.value & 0xff00) >> 8;
-            (*out)[out_ofs++] = (event->event_data.data.value & 0xff);
+            *p++ = (data.channel & 0xff);
+            *p++ = (data.data.value & 0xff000000) >> 24;
+            *p++ = (data.data.value & 0xff0000) >> 16;
+            *p++ = (data.data.value & 0xff00) >> 8;
+            *p++ = (data.data.value & 0xff);
             break;
 
         case ev_meta_text:
-            (*out)[out_ofs++] = 0xff;
-            (*out)[out_ofs++] = 0x01;
+            *p++ = 0xff;
+            *p++ = 0x01;
 
             goto _WRITE_TEXT;
 
         case ev_meta_copyright:
-            (*out)[out_ofs++] = 0xff;
-            (*out)[out_ofs++] = 0x02;
+            *p++ = 0xff;
+            *p++ = 0x02;
 
             goto _WRITE_TEXT;
 
         case ev_meta_trackname:
-            (*out)[out_ofs++] = 0xff;
-            (*out)[out_ofs++] = 0x03;
+            *p++ = 0xff;
+            *p++ = 0x03;
 
             goto _WRITE_TEXT;
 
         case ev_meta_instrumentname:
-            (*out)[out_ofs++] = 0xff;
-            (*out)[out_ofs++] = 0x04;
+            *p++ = 0xff;
+            *p++ = 0x04;
 
             goto _WRITE_TEXT;
 
         case ev_meta_lyric:
-            (*out)[out_ofs++] = 0xff;
-            (*out)[out_ofs++] = 0x05;
+            *p++ = 0xff;
+            *p++ = 0x05;
 
             goto _WRITE_TEXT;
 
         case ev_meta_marker:
-            (*out)[out_ofs++] = 0xff;
-            (*out)[out_ofs++] = 0x06;
+            *p++ = 0xff;
+            *p++ = 0x06;
 
             goto _WRITE_TEXT;
 
         case ev_meta_cuepoint:
-            (*out)[out_ofs++] = 0xff;
-            (*out)[out_ofs++] = 0x07;
+            *p++ = 0xff;
+            *p++ = 0x07;
 
             _WRITE_TEXT:
-            value = strlen(event->event_data.data.string);
-            if (value > 0x0fffffff)
-                (*out)[out_ofs++] = (((value >> 28) &0x7f) | 0x80);
-            if (value > 0x1fffff)
-                (*out)[out_ofs++] = (((value >> 21) &0x7f) | 0x80);
-            if (value > 0x3fff)
-                (*out)[out_ofs++] = (((value >> 14) & 0x7f) | 0x80);
-            if (value > 0x7f)
-                (*out)[out_ofs++] = (((value >> 7) & 0x7f) | 0x80);
-            (*out)[out_ofs++] = (value & 0x7f);
-
-            memcpy(&(*out)[out_ofs], event->event_data.data.string, value);
-            out_ofs += value;
+            value = strlen(data.data.string);
+            p = WM_SmfVarLen(p, value);
+
+            o->fill = p - o->chunk;
+            WM_SmfPut(o, (const uint8_t *) data.data.string, value);
+            if (o->fill > SMF_CHUNK - 8)
+                WM_SmfFlush(o);
+            p = &o->chunk[o->fill];
             break;
 
         default:
             /* DEBUG */
-            /* fprintf(stderr,"Unknown Event %.2x %.4x\n",event->event_data.channel, event->event_data.data.value); */
+            /* fprintf(stderr,"Unknown Event %.2x %.4x\n",data.channel, data.data.value); */
             event++;
             continue;
         }
 
-        value_f = (float)event->samples_to_next / samples_per_tick;
+        value_f = (float)event->samples_to_next / st->samples_per_tick;
         value = (uint32_t) (value_f + 0.5f);
 
         /* DEBUG */
         /* fprintf(stderr,"\rDEBUG: STN %i, SPD %f, Delta %i\r\n", event->samples_to_next, samples_per_delta_f, value); */
 
-        if (value > 0x0fffffff)
-            (*out)[out_ofs++] = (((value >> 28) &0x7f) | 0x80);
-        if (value > 0x1fffff)
-            (*out)[out_ofs++] = (((value >> 21) &0x7f) | 0x80);
-        if (value > 0x3fff)
-            (*out)[out_ofs++] = (((value >> 14) & 0x7f) | 0x80);
-        if (value > 0x7f)
-            (*out)[out_ofs++] = (((value >> 7) & 0x7f) | 0x80);
-        (*out)[out_ofs++] = (value & 0x7f);
+        p = WM_SmfVarLen(p, value);
     NEXT_EVENT:
+        o->fill = p - o->chunk;
         event++;
     } while (event->evtype != ev_null);
 
-    if ((_WM_MixerOptions & WM_MO_SAVEASTYPE0) || (!mdi->is_type2)) {
-        /* Write end of track marker */
-        (*out)[out_ofs++] = 0xff;
-        (*out)[out_ofs++] = 0x2f;
-        (*out)[out_ofs++] = 0x00;
-
-        /* Write last track size */
-        track_size = out_ofs - track_start;
-        (*out)[track_start - 4] = (track_size >> 24) & 0xff;
-        (*out)[track_start - 3] = (track_size >> 16) & 0xff;
-        (*out)[track_start - 2] = (track_size >> 8) & 0xff;
-        (*out)[track_start - 1] = track_size & 0xff;
-    }
-    /* write track count */
-    (*out)[10] = (track_count >> 8) & 0xff;
-    (*out)[11] = track_count & 0xff;
-
-    (*out) = (uint8_t *) realloc((*out), out_ofs);
-    (*outsize) = out_ofs;
+    /* Write end of track marker */
+    p = &o->chunk[o->fill];
+    *p++ = 0xff;
+    *p++ = 0x2f;
+    *p++ = 0x00;
+    o->fill = p - o->chunk;
+
+    return (event);
+}
+
+int
+_WM_WriteMidi(struct _mdi *mdi,
+              int (*write_fn)(void *ctx, const uint8_t *data, uint32_t size),
+              void *ctx) {
+    struct _smf_out out, count;
+    struct _smf_state st, probe;
+    struct _event *event;
+    struct _event_data data;
+    uint32_t track_count = 1;
+    uint32_t divisions = 96;
+    uint8_t header[14] = { 'M', 'T', 'h', 'd', 0x00, 0x00, 0x00, 0x06 };
+    int split = (!(mdi->extra_info.mixer_options & WM_MO_SAVEASTYPE0)) && (mdi->is_type2);
+
+    if (!mdi->event_count) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_CONVERT, "(No events to convert)", 0);
+        return -1;
+    }
+
+    /* the header holds the track count and the last division set */
+    for (event = mdi->events; event->evtype != ev_null; event++) {
+        if (event->evtype == ev_midi_divisions) {
+            _WM_EventData(mdi, event, &data);
+            divisions = data.data.value;
+        } else if ((split) && (event->evtype == ev_meta_endoftrack)
+                && (event[1].evtype != ev_null)) {
+            track_count++;
+        }
+    }
+
+    /* Midi Header */
+    header[8] = 0x00;
+    header[9] = (split) ? 0x02 : 0x00;
+    header[10] = (track_count >> 8) & 0xff;
+    header[11] = track_count & 0xff;
+    header[12] = (divisions >> 8) & 0xff;
+    header[13] = divisions & 0xff;
+
+    memset(&out, 0, sizeof(out));
+    out.write_fn = write_fn;
+    out.ctx = ctx;
+    WM_SmfPut(&out, header, 14);
+
+    st.divisions = 96;
+    st.tempo = 500000;
+    st.samples_per_tick = _WM_GetSamplesPerTick(st.divisions, st.tempo, mdi->ctx->sample_rate);
+    st.running_event = 0;
+
+    event = mdi->events;
+    do {
+        /* a dry run of the track for its size */
+        memset(&count, 0, sizeof(count));
+        probe = st;
+        WM_SmfTrack(mdi, event, &probe, &count, split);
+        WM_SmfFlush(&count);
+
+        /* Track Header */
+        header[0] = 'M';
+        header[1] = 'T';
+        header[2] = 'r';
+        header[3] = 'k';
+        header[4] = (count.total >> 24) & 0xff;
+        header[5] = (count.total >> 16) & 0xff;
+        header[6] = (count.total >> 8) & 0xff;
+        header[7] = count.total & 0xff;
+        WM_SmfPut(&out, header, 8);
+
+        event = WM_SmfTrack(mdi, event, &st, &out, split);
+    } while ((event->evtype != ev_null) && (!out.failed));
+
+    WM_SmfFlush(&out);
+    return ((out.failed) ? -1 : 0);
+}
+
+/* a growing buffer as the sink of _WM_WriteMidi */
+struct _smf_buffer {
+    uint8_t *data;
+    uint32_t size;
+    uint32_t alloc;
+};
+
+static int WM_SmfToBuffer(void *ctx, const uint8_t *data, uint32_t size) {
+    struct _smf_buffer *buf = (struct _smf_buffer *) ctx;
+    uint8_t *grown;
+    uint32_t alloc = buf->alloc;
+
+    while (alloc - buf->size < size)
+        alloc = (alloc) ? alloc * 2 : SMF_CHUNK * 4;
+    if (alloc != buf->alloc) {
+        grown = (uint8_t *) realloc(buf->data, alloc);
+        if (grown == NULL) {
+            _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, 0);
+            return -1;
+        }
+        buf->data = grown;
+        buf->alloc = alloc;
+    }
+    memcpy(&buf->data[buf->size], data, size);
+    buf->size += size;
+    return 0;
+}
+
+/*
+ Convert WildMIDI's MDI events into a MIDI file in memory.
+
+ **out points to place to store stuff
+ *outsize points to where to store byte counts
+ */
+int
+_WM_Event2Midi(struct _mdi *mdi, uint8_t **out, uint32_t *outsize) {
+    struct _smf_buffer buf = { NULL, 0, 0 };
+
+    if (_WM_WriteMidi(mdi, WM_SmfToBuffer, &buf) < 0) {
+        free(buf.data);
+        return -1;
+    }
+
+    (*out) = (uint8_t *) realloc(buf.data, buf.size);
+    (*outsize) = buf.size;
 
     return 0;
 }
@@ -32,7 +32,6 @@
 #include "wm_error.h"
 #include "wildmidi_lib.h"
 #include "internal_midi.h"
-#include "reverb.h"
 #include "f_mus.h"
 
 #ifdef DEBUG_MUS
@@ -45,7 +44,7 @@
  Turns mus file data into an event stream.
  */
 struct _mdi *
-_WM_ParseNewMus(const uint8_t *mus_data, uint32_t mus_size) {
+_WM_ParseNewMus(struct _context *ctx, const uint8_t *mus_data, uint32_t mus_size) {
     uint8_t mus_hdr[] = { 'M', 'U', 'S', 0x1A };
     uint32_t mus_song_ofs = 0;
     uint32_t mus_song_len = 0;
@@ -56,6 +55,7 @@ _WM_ParseNewMus(const uint8_t *mus_data, uint32_t mus_size) {
     uint16_t * mus_mid_instr = NULL;
     uint16_t mus_instr_cnt = 0;
     struct _mdi *mus_mdi;
+    uint8_t parsed = 0;
     uint32_t mus_divisions = 60;
     float tempo_f = 0;
     uint16_t mus_freq = 0;
@@ -119,16 +119,20 @@ _WM_ParseNewMus(const uint8_t *mus_data, uint32_t mus_size) {
     mus_freq = _cvt_get_option(WM_CO_FREQUENCY);
     if (mus_freq == 0) mus_freq = 140;
 
-    if ((_WM_MixerOptions & WM_MO_ROUNDTEMPO)) {
+    if ((ctx->mixer_options & WM_MO_ROUNDTEMPO)) {
         tempo_f = (float) (60000000 / mus_freq) + 0.5f;
     } else {
         tempo_f = (float) (60000000 / mus_freq);
     }
 
-    samples_per_tick_f = _WM_GetSamplesPerTick(mus_divisions, (uint32_t)tempo_f);
+    samples_per_tick_f = _WM_GetSamplesPerTick(mus_divisions, (uint32_t)tempo_f, ctx->sample_rate);
 
     /* initialise the mdi structure */
-    mus_mdi = _WM_initMDI();
+    mus_mdi = _WM_initMDI(ctx);
+    if (mus_mdi == NULL) {
+        free(mus_mid_instr);
+        return NULL;
+    }
     _WM_midi_setup_divisions(mus_mdi, mus_divisions);
     _WM_midi_setup_tempo(mus_mdi, (uint32_t)tempo_f);
 
@@ -355,21 +359,18 @@ _WM_ParseNewMus(const uint8_t *mus_data, uint32_t mus_size) {
 
 _mus_end_of_song:
     /* Finalise mdi structure */
-    if ((mus_mdi->reverb = _WM_init_reverb(_WM_SampleRate, _WM_reverb_room_width, _WM_reverb_room_length, _WM_reverb_listen_posx, _WM_reverb_listen_posy)) == NULL) {
-        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, 0);
-        goto _mus_end;
-    }
     _WM_midi_setup_endoftrack(mus_mdi);
     mus_mdi->extra_info.current_sample = 0;
     mus_mdi->current_event = &mus_mdi->events[0];
     mus_mdi->samples_to_mix = 0;
-    mus_mdi->note = NULL;
+    mus_mdi->voice_count = 0;
 
     _WM_ResetToStart(mus_mdi);
+    parsed = 1;
 
 _mus_end:
     free(mus_mid_instr);
-    if (mus_mdi->reverb) return (mus_mdi);
+    if (parsed) return (mus_mdi);
     _WM_freeMDI(mus_mdi);
     return NULL;
 }
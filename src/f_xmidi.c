@@ -32,12 +32,12 @@
 #include "wm_error.h"
 #include "wildmidi_lib.h"
 #include "internal_midi.h"
-#include "reverb.h"
 #include "f_xmidi.h"
 
 
-struct _mdi *_WM_ParseNewXmi(const uint8_t *xmi_data, uint32_t xmi_size) {
+struct _mdi *_WM_ParseNewXmi(struct _context *ctx, const uint8_t *xmi_data, uint32_t xmi_size) {
     struct _mdi *xmi_mdi = NULL;
+    uint8_t parsed = 0;
     uint32_t xmi_tmpdata = 0;
     uint8_t xmi_formcnt = 0;
     uint32_t xmi_catlen = 0;
@@ -131,11 +131,14 @@ struct _mdi *_WM_ParseNewXmi(const uint8_t *xmi_data, uint32_t xmi_size) {
     xmi_data += 4;
     xmi_size -= 4;
 
-    xmi_mdi = _WM_initMDI();
+    xmi_mdi = _WM_initMDI(ctx);
+    if (xmi_mdi == NULL) {
+        return NULL;
+    }
     _WM_midi_setup_divisions(xmi_mdi, xmi_divisions);
     _WM_midi_setup_tempo(xmi_mdi, xmi_tempo);
 
-    xmi_samples_per_delta_f = _WM_GetSamplesPerTick(xmi_divisions, xmi_tempo);
+    xmi_samples_per_delta_f = _WM_GetSamplesPerTick(xmi_divisions, xmi_tempo, ctx->sample_rate);
 
     xmi_notelen = (uint32_t *) malloc(sizeof(uint32_t) * 16 * 128);
     memset(xmi_notelen, 0, (sizeof(uint32_t) * 16 * 128));
@@ -329,23 +332,20 @@ struct _mdi *_WM_ParseNewXmi(const uint8_t *xmi_data, uint32_t xmi_size) {
     }
 
     /* Finalise mdi structure */
-    if ((xmi_mdi->reverb = _WM_init_reverb(_WM_SampleRate, _WM_reverb_room_width, _WM_reverb_room_length, _WM_reverb_listen_posx, _WM_reverb_listen_posy)) == NULL) {
-        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, 0);
-        goto _xmi_end;
-    }
     xmi_mdi->extra_info.current_sample = 0;
     xmi_mdi->current_event = &xmi_mdi->events[0];
     xmi_mdi->samples_to_mix = 0;
-    xmi_mdi->note = NULL;
+    xmi_mdi->voice_count = 0;
     /* More than 1 event form in XMI means treat as type 2 */
     if (xmi_evnt_cnt > 1) {
         xmi_mdi->is_type2 = 1;
     }
     _WM_ResetToStart(xmi_mdi);
+    parsed = 1;
 
 _xmi_end:
     if (xmi_notelen) free(xmi_notelen);
-    if (xmi_mdi->reverb) return (xmi_mdi);
+    if (parsed) return (xmi_mdi);
     _WM_freeMDI(xmi_mdi);
     return NULL;
 }
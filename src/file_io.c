@@ -64,6 +64,9 @@
 #include <pwd.h>
 #endif
 #include <unistd.h>
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#endif
 #endif
 
 #if !defined(O_BINARY)
@@ -74,10 +77,133 @@
 # endif
 #endif
 
+#include "lock.h"
 #include "wm_error.h"
 #include "file_io.h"
 void* (*_WM_BufferFile)(const char *, uint32_t *) = _WM_BufferFileImpl;
 void  (*_WM_FreeBufferFile)(void*)                = _WM_FreeBufferFileImpl;
+const void * (*_WM_MapFile)(const char *, uint32_t *) = _WM_MapFileImpl;
+void  (*_WM_UnmapFile)(const void *, uint32_t)        = _WM_UnmapFileImpl;
+
+#if defined(_WIN32) || (defined(HAVE_MMAP) && (defined(__unix) || defined(__unix__) || defined(__APPLE__)))
+#define WM_MAP_FILES
+#endif
+
+#ifdef WM_MAP_FILES
+/*
+ * Files of at least this size are mapped instead of read, below it the
+ * cost of setting up the mapping is more than the copy it saves.
+ */
+#define WM_MAPFILE_MIN 0x4000
+
+/*
+ * Mapped buffers handed out by _WM_BufferFileImpl(), so that
+ * _WM_FreeBufferFileImpl() can tell them from malloc()ed ones.
+ * There are only ever as many of them as files being loaded at once.
+ */
+struct _mapped_file {
+    void *data;
+    size_t size;
+    struct _mapped_file *next;
+};
+
+static struct _mapped_file *mapped_files = NULL;
+static int mapped_files_lock = 0;
+
+static size_t WM_PageSize(void) {
+    static size_t page_size = 0;
+    if (!page_size) {
+#ifdef _WIN32
+        SYSTEM_INFO si;
+        GetSystemInfo(&si);
+        page_size = si.dwPageSize;
+#else
+        long ps = sysconf(_SC_PAGESIZE);
+        page_size = (ps > 0) ? (size_t) ps : 4096;
+#endif
+    }
+    return page_size;
+}
+
+/*
+ * Map the file copy-on-write so the buffer stays writable like a malloc()ed
+ * one. The part of the last page past the end of the file reads as zero,
+ * which gives us the terminating NUL for free, so only files whose size is
+ * not a multiple of the page size can be mapped.
+ *
+ * Read-only callers get a shared mapping of any size instead, every
+ * process mapping the same file then uses the same pages of memory.
+ */
+static void *WM_MapFd(int fd, uint32_t size, int read_only) {
+    struct _mapped_file *mf;
+    void *data;
+#ifdef _WIN32
+    HANDLE fh, mh;
+#endif
+
+    if (size < WM_MAPFILE_MIN || (!read_only && (size % WM_PageSize()) == 0))
+        return NULL;
+    if ((mf = (struct _mapped_file *) malloc(sizeof(struct _mapped_file))) == NULL)
+        return NULL;
+
+#ifdef _WIN32
+    fh = (HANDLE) _get_osfhandle(fd);
+    if (fh == INVALID_HANDLE_VALUE ||
+        (mh = CreateFileMappingA(fh, NULL, (read_only) ? PAGE_READONLY : PAGE_WRITECOPY, 0, 0, NULL)) == NULL) {
+        free(mf);
+        return NULL;
+    }
+    data = MapViewOfFile(mh, (read_only) ? FILE_MAP_READ : FILE_MAP_COPY, 0, 0, 0);
+    /* the view keeps the mapping object alive */
+    CloseHandle(mh);
+    if (data == NULL) {
+        free(mf);
+        return NULL;
+    }
+#else
+    if (read_only)
+        data = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    else
+        data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+        free(mf);
+        return NULL;
+    }
+#endif
+
+    mf->data = data;
+    mf->size = size;
+    _WM_Lock(&mapped_files_lock);
+    mf->next = mapped_files;
+    mapped_files = mf;
+    _WM_Unlock(&mapped_files_lock);
+    return data;
+}
+
+static int WM_UnmapBuffer(void *buf) {
+    struct _mapped_file **mfp, *mf = NULL;
+
+    _WM_Lock(&mapped_files_lock);
+    for (mfp = &mapped_files; *mfp; mfp = &(*mfp)->next) {
+        if ((*mfp)->data == buf) {
+            mf = *mfp;
+            *mfp = mf->next;
+            break;
+        }
+    }
+    _WM_Unlock(&mapped_files_lock);
+
+    if (!mf)
+        return 0;
+#ifdef _WIN32
+    UnmapViewOfFile(mf->data);
+#else
+    munmap(mf->data, mf->size);
+#endif
+    free(mf);
+    return 1;
+}
+#endif /* WM_MAP_FILES */
 
 #ifdef WILDMIDI_AMIGA
 static long AMIGA_filesize (const char *path) {
@@ -116,7 +242,7 @@ static void AMIGA_close (BPTR fd) {
 }
 #endif
 
-void *_WM_BufferFileImpl(const char *filename, uint32_t *size) {
+static void *WM_LoadFile(const char *filename, uint32_t *size, int read_only) {
     char *buffer_file = NULL;
     uint8_t *data;
 #ifdef __DJGPP__
@@ -181,6 +307,10 @@ void *_WM_BufferFileImpl(const char *filename, uint32_t *size) {
     long pos;
 #endif
 
+#ifndef WM_MAP_FILES
+    (void) read_only;
+#endif
+
     if (buffer_file == NULL) {
         buffer_file = (char *) malloc(strlen(filename) + 1);
         if (buffer_file == NULL) {
@@ -265,11 +395,27 @@ void *_WM_BufferFileImpl(const char *filename, uint32_t *size) {
         return NULL;
     }
 
+#ifdef WM_MAP_FILES
+    if ((buffer_fd = open(buffer_file,(O_RDONLY | O_BINARY))) == -1) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_OPEN, filename, errno);
+        free(buffer_file);
+        return NULL;
+    }
+    if ((data = (uint8_t *) WM_MapFd(buffer_fd, *size, read_only)) != NULL) {
+        close(buffer_fd);
+        free(buffer_file);
+        return data;
+    }
+#endif
+
     /* +1 needed for parsing text files without a newline at the end */
     data = (uint8_t *) malloc(*size + 1);
     if (data == NULL) {
         _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
         free(buffer_file);
+#ifdef WM_MAP_FILES
+        close(buffer_fd);
+#endif
         return NULL;
     }
 
@@ -289,12 +435,14 @@ void *_WM_BufferFileImpl(const char *filename, uint32_t *size) {
     }
     AMIGA_close(buffer_fd);
 #elif defined(__DJGPP__) || defined(_WIN32) || defined(__OS2__) || defined(__EMX__) || defined(_3DS) || defined(GEKKO) || defined(__vita__) || defined(__SWITCH__) || defined(__riscos__) || defined(__unix) || defined(__unix__) || defined(__APPLE__)
+#ifndef WM_MAP_FILES
     if ((buffer_fd = open(buffer_file,(O_RDONLY | O_BINARY))) == -1) {
         _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_OPEN, filename, errno);
         free(buffer_file);
         free(data);
         return NULL;
     }
+#endif
     if (read(buffer_fd, data, *size) != (long) *size) {
         _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_READ, filename, errno);
         free(buffer_file);
@@ -320,6 +468,31 @@ void *_WM_BufferFileImpl(const char *filename, uint32_t *size) {
     return data;
 }
 
+void *_WM_BufferFileImpl(const char *filename, uint32_t *size) {
+    return WM_LoadFile(filename, size, 0);
+}
+
 void _WM_FreeBufferFileImpl(void *buf) {
+#ifdef WM_MAP_FILES
+    if (buf && WM_UnmapBuffer(buf))
+        return;
+#endif
     free(buf);
 }
+
+/*
+ * Read-only views of a file for the loaders that don't need the buffer
+ * terminated or writable. Unless an embedder supplies its own mapping
+ * callbacks these go through the _WM_BufferFile() ones, or when those are
+ * ours too map the file shared.
+ */
+const void *_WM_MapFileImpl(const char *filename, uint32_t *size) {
+    if (_WM_BufferFile != _WM_BufferFileImpl)
+        return _WM_BufferFile(filename, size);
+    return WM_LoadFile(filename, size, 1);
+}
+
+void _WM_UnmapFileImpl(const void *buf, uint32_t size) {
+    (void) size;
+    _WM_FreeBufferFile((void *) buf);
+}
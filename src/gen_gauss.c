@@ -0,0 +1,82 @@
+/*
+ * gen_gauss.c -- Midi Wavetable Processing library
+ *
+ * Copyright (C) WildMIDI Developers 2001-2016
+ *
+ * This file is part of WildMIDI.
+ *
+ * WildMIDI is free software: you can redistribute and/or modify the player
+ * under the terms of the GNU General Public License and you can redistribute
+ * and/or modify the library under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either version 3 of
+ * the licenses, or(at your option) any later version.
+ *
+ * WildMIDI is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License and
+ * the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License and the
+ * GNU Lesser General Public License along with WildMIDI.  If not,  see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Writes include/gauss_table.h, the gauss interpolation table used by the
+ * enhanced resampling mixer. The table ships with the sources so nothing
+ * has to be computed at runtime, regenerate it with "make gauss_table"
+ * after changing anything here.
+ */
+
+#include <math.h>
+#include <stdio.h>
+
+#ifndef M_PI
+#define M_PI  3.14159265358979323846
+#endif
+
+/* these must match mixer.c */
+#define FPBITS 10
+#define MAX_GAUSS_ORDER 34
+#define GAUSS_BITS 14
+
+/* Gauss Interpolation code adapted from code supplied by Eric. A. Welsh */
+int main(void) {
+    int n = MAX_GAUSS_ORDER;
+    int m, i, k, n_half = (n >> 1);
+    double ck;
+    double x, x_inc, xz;
+    double z[MAX_GAUSS_ORDER + 1];
+
+    for (i = 0; i <= n; i++) {
+        z[i] = i / (4 * M_PI);
+    }
+
+    printf("/* gauss_table.h -- generated by gen_gauss.c, do not edit */\n\n");
+    printf("#ifndef __GAUSS_TABLE_H\n#define __GAUSS_TABLE_H\n\n");
+    printf("/* %d taps per sample fraction, Q%d */\n", n + 1, GAUSS_BITS);
+    printf("static const int16_t gauss_table[(1<<FPBITS)][GAUSS_TAPS] = {\n");
+
+    x_inc = 1.0 / (1<<FPBITS);
+    for (m = 0, x = 0.0; m < (1<<FPBITS); m++, x += x_inc) {
+        xz = (x + n_half) / (4 * M_PI);
+
+        printf("    {");
+        for (k = 0; k <= n; k++) {
+            ck = 1.0;
+
+            for (i = 0; i <= n; i++) {
+                if (i == k)
+                    continue;
+
+                ck *= (sin(xz - z[i])) / (sin(z[k] - z[i]));
+            }
+            printf("%s%d", (k) ? ((k % 12) ? ", " : ",\n     ") : "",
+                   (int) floor(ck * (1 << GAUSS_BITS) + 0.5));
+        }
+        printf("}%s\n", (m < (1<<FPBITS) - 1) ? "," : "");
+    }
+
+    printf("};\n\n#endif /* __GAUSS_TABLE_H */\n");
+    return (0);
+}
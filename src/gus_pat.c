@@ -29,6 +29,13 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(HAVE_SSE2_INTRINSICS)
+#include <emmintrin.h>
+#endif
+#if defined(HAVE_NEON_INTRINSICS)
+#include <arm_neon.h>
+#endif
+
 #include "gus_pat.h"
 #include "common.h"
 #include "wm_error.h"
@@ -53,707 +60,388 @@
 #define GUSPAT_END_DEBUG()
 #endif
 
-/* sample data conversion functions
- * convert data to signed shorts
- */
-
-/* 8bit signed */
-static int convert_8s(uint8_t *data, struct _sample *gus_sample) {
-    uint8_t *read_data = data;
-    uint8_t *read_end = data + gus_sample->data_length;
-    int16_t *write_data = NULL;
+#if defined(__GNUC__) || defined(__clang__)
+#define WM_TARGET(x) __attribute__((target(x)))
+#else
+#define WM_TARGET(x)
+#endif
 
-    SAMPLE_CONVERT_DEBUG(__FUNCTION__);
-    gus_sample->data = (int16_t *) calloc((gus_sample->data_length + 2), sizeof(int16_t));
-    if (__builtin_expect((gus_sample->data != NULL), 1)) {
-        write_data = gus_sample->data;
-        do {
-            *write_data++ = (*read_data++) << 8;
-        } while (read_data != read_end);
-        return 0;
+/*
+ * Sample data conversion. The .pat files hold 8 or 16 bit samples, signed
+ * or unsigned, some of them reversed, all of which ends up as signed 16
+ * bit samples in playing order. A ping pong loop is kept as it is, the
+ * mixer turns around at its ends (see WM_MixNote()).
+ *
+ * The data goes through the kernels of _WM_SampleConvert in two steps,
+ * converted to 16 bit and then reversed in place if need be. Each kernel
+ * comes in plain c and in vector versions for the cpus that have them,
+ * see cvt_pick().
+ */
+struct _WM_SampleConvert {
+    /* count samples from src to dst, indexed by the SAMPLE_16BIT and
+       SAMPLE_UNSIGNED bits of the modes */
+    void (*convert[4])(const uint8_t *src, int16_t *dst, uint32_t count);
+    /* reverse count samples in place */
+    void (*reverse)(int16_t *data, uint32_t count);
+};
+
+static void cvt_8s_c(const uint8_t *src, int16_t *dst, uint32_t count) {
+    while (count--) {
+        *dst++ = (*src++) << 8;
     }
-
-    _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
-
-    return -1;
 }
 
-/* 8bit signed ping pong */
-static int convert_8sp(uint8_t *data, struct _sample *gus_sample) {
-    uint32_t loop_length = gus_sample->loop_end
-            - gus_sample->loop_start;
-    uint32_t dloop_length = loop_length * 2;
-    uint32_t new_length = gus_sample->data_length + dloop_length;
-    uint8_t *read_data = data;
-    uint8_t *read_end = data + gus_sample->loop_start;
-    int16_t *write_data = NULL;
-    int16_t *write_data_a = NULL;
-    int16_t *write_data_b = NULL;
-
-    SAMPLE_CONVERT_DEBUG(__FUNCTION__);
-    gus_sample->data = (int16_t *) calloc((new_length + 2), sizeof(int16_t));
-    if (__builtin_expect((gus_sample->data != NULL), 1)) {
-        write_data = gus_sample->data;
-        while (read_data < read_end) {
-            *write_data++ = (*read_data++) << 8;
-        }
-
-        *write_data = (*read_data++ << 8);
-        write_data_a = write_data + dloop_length;
-        *write_data_a-- = *write_data;
-        write_data++;
-        write_data_b = write_data + dloop_length;
-        read_end = data + gus_sample->loop_end;
-        do {
-            *write_data = (*read_data++) << 8;
-            *write_data_a-- = *write_data;
-            *write_data_b++ = *write_data;
-            write_data++;
-        } while (read_data != read_end);
-
-        *write_data = (*read_data++ << 8);
-        *write_data_b++ = *write_data;
-        read_end = data + gus_sample->data_length;
-        while (read_data < read_end) {
-            *write_data_b++ = (*read_data++) << 8;
-        }
-        gus_sample->loop_start += loop_length;
-        gus_sample->loop_end += dloop_length;
-        gus_sample->data_length = new_length;
-        gus_sample->modes ^= SAMPLE_PINGPONG;
-        return 0;
+static void cvt_8u_c(const uint8_t *src, int16_t *dst, uint32_t count) {
+    while (count--) {
+        *dst++ = ((*src++) ^ 0x80) << 8;
     }
-
-    _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
-    return -1;
 }
 
-/* 8bit signed reverse */
-static int convert_8sr(uint8_t *data, struct _sample *gus_sample) {
-    uint8_t *read_data = data;
-    uint8_t *read_end = data + gus_sample->data_length;
-    int16_t *write_data = NULL;
-    uint32_t tmp_loop = 0;
-
-    SAMPLE_CONVERT_DEBUG(__FUNCTION__);
-    gus_sample->data = (int16_t *) calloc((gus_sample->data_length + 2), sizeof(int16_t));
-    if (__builtin_expect((gus_sample->data != NULL), 1)) {
-        write_data = gus_sample->data + gus_sample->data_length - 1;
-        do {
-            *write_data-- = (*read_data++) << 8;
-        } while (read_data != read_end);
-        tmp_loop = gus_sample->loop_end;
-        gus_sample->loop_end = gus_sample->data_length - gus_sample->loop_start;
-        gus_sample->loop_start = gus_sample->data_length - tmp_loop;
-        gus_sample->loop_fraction = ((gus_sample->loop_fraction & 0x0f) << 4)
-                | ((gus_sample->loop_fraction & 0xf0) >> 4);
-        gus_sample->modes ^= SAMPLE_REVERSE;
-        return 0;
+static void cvt_16s_c(const uint8_t *src, int16_t *dst, uint32_t count) {
+    while (count--) {
+        *dst++ = src[0] | (src[1] << 8);
+        src += 2;
     }
-    _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
-    return -1;
 }
 
-/* 8bit signed reverse ping pong */
-static int convert_8srp(uint8_t *data, struct _sample *gus_sample) {
-    uint32_t loop_length = gus_sample->loop_end
-            - gus_sample->loop_start;
-    uint32_t dloop_length = loop_length * 2;
-    uint32_t new_length = gus_sample->data_length + dloop_length;
-    uint8_t *read_data = data + gus_sample->data_length - 1;
-    uint8_t *read_end = data + gus_sample->loop_end;
-    int16_t *write_data = NULL;
-    int16_t *write_data_a = NULL;
-    int16_t *write_data_b = NULL;
-
-    SAMPLE_CONVERT_DEBUG(__FUNCTION__);
-    gus_sample->data = (int16_t *) calloc((new_length + 2), sizeof(int16_t));
-    if (__builtin_expect((gus_sample->data != NULL), 1)) {
-        write_data = gus_sample->data;
-        do {
-            *write_data++ = (*read_data--) << 8;
-        } while (read_data != read_end);
-
-        *write_data = (*read_data-- << 8);
-        write_data_a = write_data + dloop_length;
-        *write_data_a-- = *write_data;
-        write_data++;
-        write_data_b = write_data + dloop_length;
-        read_end = data + gus_sample->loop_start;
-        do {
-            *write_data = (*read_data--) << 8;
-            *write_data_a-- = *write_data;
-            *write_data_b++ = *write_data;
-            write_data++;
-        } while (read_data != read_end);
-
-        *write_data = (*read_data-- << 8);
-        *write_data_b++ = *write_data;
-        read_end = data - 1;
-        do {
-            *write_data_b++ = (*read_data--) << 8;
-            write_data_b++;
-        } while (read_data != read_end);
-        gus_sample->loop_start += loop_length;
-        gus_sample->loop_end += dloop_length;
-        gus_sample->data_length = new_length;
-        gus_sample->modes ^= SAMPLE_PINGPONG | SAMPLE_REVERSE;
-        return 0;
+static void cvt_16u_c(const uint8_t *src, int16_t *dst, uint32_t count) {
+    while (count--) {
+        *dst++ = src[0] | ((src[1] ^ 0x80) << 8);
+        src += 2;
     }
-
-    _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
-    return -1;
 }
 
-/* 8bit unsigned */
-static int convert_8u(uint8_t *data, struct _sample *gus_sample) {
-    uint8_t *read_data = data;
-    uint8_t *read_end = data + gus_sample->data_length;
-    int16_t *write_data = NULL;
+static void cvt_reverse_c(int16_t *data, uint32_t count) {
+    int16_t *end = data + count - 1;
+    int16_t tmp;
 
-    SAMPLE_CONVERT_DEBUG(__FUNCTION__);
-    gus_sample->data = (int16_t *) calloc((gus_sample->data_length + 2), sizeof(int16_t));
-    if (__builtin_expect((gus_sample->data != NULL), 1)) {
-        write_data = gus_sample->data;
-        do {
-            *write_data++ = ((*read_data++) ^ 0x80) << 8;
-        } while (read_data != read_end);
-        gus_sample->modes ^= SAMPLE_UNSIGNED;
-        return 0;
+    if (count == 0) return;
+    while (data < end) {
+        tmp = *data;
+        *data++ = *end;
+        *end-- = tmp;
     }
-    _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
-    return -1;
 }
 
-/* 8bit unsigned ping pong */
-static int convert_8up(uint8_t *data, struct _sample *gus_sample) {
-    uint32_t loop_length = gus_sample->loop_end
-            - gus_sample->loop_start;
-    uint32_t dloop_length = loop_length * 2;
-    uint32_t new_length = gus_sample->data_length + dloop_length;
-    uint8_t *read_data = data;
-    uint8_t *read_end = data + gus_sample->loop_start;
-    int16_t *write_data = NULL;
-    int16_t *write_data_a = NULL;
-    int16_t *write_data_b = NULL;
+static const struct _WM_SampleConvert cvt_c = {
+    { cvt_8s_c, cvt_16s_c, cvt_8u_c, cvt_16u_c },
+    cvt_reverse_c
+};
 
-    SAMPLE_CONVERT_DEBUG(__FUNCTION__);
-    gus_sample->data = (int16_t *) calloc((new_length + 2), sizeof(int16_t));
-    if (__builtin_expect((gus_sample->data != NULL), 1)) {
-        write_data = gus_sample->data;
-        while (read_data < read_end) {
-            *write_data++ = ((*read_data++) ^ 0x80) << 8;
-        }
+#if defined(HAVE_SSE2_INTRINSICS)
 
-        *write_data = ((*read_data++) ^ 0x80) << 8;
-        write_data_a = write_data + dloop_length;
-        *write_data_a-- = *write_data;
-        write_data++;
-        write_data_b = write_data + dloop_length;
-        read_end = data + gus_sample->loop_end;
-        do {
-            *write_data = ((*read_data++) ^ 0x80) << 8;
-            *write_data_a-- = *write_data;
-            *write_data_b++ = *write_data;
-            write_data++;
-        } while (read_data != read_end);
-
-        *write_data = ((*read_data++) ^ 0x80) << 8;
-        *write_data_b++ = *write_data;
-        read_end = data + gus_sample->data_length;
-        while (read_data < read_end) {
-            *write_data_b++ = ((*read_data++) ^ 0x80) << 8;
-        }
+WM_TARGET("sse2")
+static inline __m128i sse2_reverse8(__m128i x) {
+    x = _mm_shufflelo_epi16(x, _MM_SHUFFLE(0, 1, 2, 3));
+    x = _mm_shufflehi_epi16(x, _MM_SHUFFLE(0, 1, 2, 3));
+    return (_mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2)));
+}
+
+/* the byte goes to the top of the sample, the bottom is left 0 */
+WM_TARGET("sse2")
+static void cvt_8_sse2(const uint8_t *src, int16_t *dst, uint32_t count, __m128i flip) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i x;
 
-        gus_sample->loop_start += loop_length;
-        gus_sample->loop_end += dloop_length;
-        gus_sample->data_length = new_length;
-        gus_sample->modes ^= SAMPLE_PINGPONG | SAMPLE_UNSIGNED;
-        return 0;
+    for (; count >= 16; count -= 16, src += 16, dst += 16) {
+        x = _mm_xor_si128(_mm_loadu_si128((const __m128i *) src), flip);
+        _mm_storeu_si128((__m128i *) dst, _mm_unpacklo_epi8(zero, x));
+        _mm_storeu_si128((__m128i *) (dst + 8), _mm_unpackhi_epi8(zero, x));
     }
+    if (_mm_cvtsi128_si32(flip)) {
+        cvt_8u_c(src, dst, count);
+    } else {
+        cvt_8s_c(src, dst, count);
+    }
+}
 
-    _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
-    return -1;
+WM_TARGET("sse2")
+static void cvt_8s_sse2(const uint8_t *src, int16_t *dst, uint32_t count) {
+    cvt_8_sse2(src, dst, count, _mm_setzero_si128());
 }
 
-/* 8bit unsigned reverse */
-static int convert_8ur(uint8_t *data, struct _sample *gus_sample) {
-    uint8_t *read_data = data;
-    uint8_t *read_end = data + gus_sample->data_length;
-    int16_t *write_data = NULL;
-    uint32_t tmp_loop = 0;
+WM_TARGET("sse2")
+static void cvt_8u_sse2(const uint8_t *src, int16_t *dst, uint32_t count) {
+    cvt_8_sse2(src, dst, count, _mm_set1_epi8((char) 0x80));
+}
 
-    SAMPLE_CONVERT_DEBUG(__FUNCTION__);
-    gus_sample->data = (int16_t *) calloc((gus_sample->data_length + 2), sizeof(int16_t));
-    if (__builtin_expect((gus_sample->data != NULL), 1)) {
-        write_data = gus_sample->data + gus_sample->data_length - 1;
-        do {
-            *write_data-- = ((*read_data++) ^ 0x80) << 8;
-        } while (read_data != read_end);
-        tmp_loop = gus_sample->loop_end;
-        gus_sample->loop_end = gus_sample->data_length - gus_sample->loop_start;
-        gus_sample->loop_start = gus_sample->data_length - tmp_loop;
-        gus_sample->loop_fraction = ((gus_sample->loop_fraction & 0x0f) << 4)
-                | ((gus_sample->loop_fraction & 0xf0) >> 4);
-        gus_sample->modes ^= SAMPLE_REVERSE | SAMPLE_UNSIGNED;
-        return 0;
+/* x86 is little endian like the files, only the sign may need flipping */
+WM_TARGET("sse2")
+static void cvt_16_sse2(const uint8_t *src, int16_t *dst, uint32_t count, __m128i flip) {
+    for (; count >= 8; count -= 8, src += 16, dst += 8) {
+        _mm_storeu_si128((__m128i *) dst,
+                _mm_xor_si128(_mm_loadu_si128((const __m128i *) src), flip));
+    }
+    if (_mm_cvtsi128_si32(flip)) {
+        cvt_16u_c(src, dst, count);
+    } else {
+        cvt_16s_c(src, dst, count);
     }
-    _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
-    return -1;
 }
 
-/* 8bit unsigned reverse ping pong */
-static int convert_8urp(uint8_t *data, struct _sample *gus_sample) {
-    uint32_t loop_length = gus_sample->loop_end
-            - gus_sample->loop_start;
-    uint32_t dloop_length = loop_length * 2;
-    uint32_t new_length = gus_sample->data_length + dloop_length;
-    uint8_t *read_data = data + gus_sample->data_length - 1;
-    uint8_t *read_end = data + gus_sample->loop_end;
-    int16_t *write_data = NULL;
-    int16_t *write_data_a = NULL;
-    int16_t *write_data_b = NULL;
+WM_TARGET("sse2")
+static void cvt_16s_sse2(const uint8_t *src, int16_t *dst, uint32_t count) {
+    cvt_16_sse2(src, dst, count, _mm_setzero_si128());
+}
 
-    SAMPLE_CONVERT_DEBUG(__FUNCTION__);
-    gus_sample->data = (int16_t *) calloc((new_length + 2), sizeof(int16_t));
-    if (__builtin_expect((gus_sample->data != NULL), 1)) {
-        write_data = gus_sample->data;
-        do {
-            *write_data++ = ((*read_data--) ^ 0x80) << 8;
-        } while (read_data != read_end);
-
-        *write_data = ((*read_data--) ^ 0x80) << 8;
-        write_data_a = write_data + dloop_length;
-        *write_data_a-- = *write_data;
-        write_data++;
-        write_data_b = write_data + dloop_length;
-        read_end = data + gus_sample->loop_start;
-        do {
-            *write_data = ((*read_data--) ^ 0x80) << 8;
-            *write_data_a-- = *write_data;
-            *write_data_b++ = *write_data;
-            write_data++;
-        } while (read_data != read_end);
-
-        *write_data = ((*read_data--) ^ 0x80) << 8;
-        *write_data_b++ = *write_data;
-        read_end = data - 1;
-        do {
-            *write_data_b++ = ((*read_data--) ^ 0x80) << 8;
-        } while (read_data != read_end);
-        gus_sample->loop_start += loop_length;
-        gus_sample->loop_end += dloop_length;
-        gus_sample->data_length = new_length;
-        gus_sample->modes ^= SAMPLE_PINGPONG | SAMPLE_REVERSE | SAMPLE_UNSIGNED;
-        return 0;
-    }
+WM_TARGET("sse2")
+static void cvt_16u_sse2(const uint8_t *src, int16_t *dst, uint32_t count) {
+    cvt_16_sse2(src, dst, count, _mm_set1_epi16((short) 0x8000));
+}
 
-    _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
-    return -1;
+WM_TARGET("sse2")
+static void cvt_reverse_sse2(int16_t *data, uint32_t count) {
+    int16_t *end = data + count;
+    __m128i head, tail;
+
+    /* swap 8 from each end until they meet */
+    while ((end - data) >= 16) {
+        end -= 8;
+        head = _mm_loadu_si128((const __m128i *) data);
+        tail = _mm_loadu_si128((const __m128i *) end);
+        _mm_storeu_si128((__m128i *) data, sse2_reverse8(tail));
+        _mm_storeu_si128((__m128i *) end, sse2_reverse8(head));
+        data += 8;
+    }
+    cvt_reverse_c(data, (uint32_t) (end - data));
 }
 
-/* 16bit signed */
-static int convert_16s(uint8_t *data, struct _sample *gus_sample) {
-    uint8_t *read_data = data;
-    uint8_t *read_end = data + gus_sample->data_length;
-    int16_t *write_data = NULL;
+static const struct _WM_SampleConvert cvt_sse2 = {
+    { cvt_8s_sse2, cvt_16s_sse2, cvt_8u_sse2, cvt_16u_sse2 },
+    cvt_reverse_sse2
+};
 
-    SAMPLE_CONVERT_DEBUG(__FUNCTION__);
-    gus_sample->data = (int16_t *) calloc(((gus_sample->data_length >> 1) + 2), sizeof(int16_t));
-    if (__builtin_expect((gus_sample->data != NULL), 1)) {
-        write_data = gus_sample->data;
-        do {
-            *write_data = *read_data++;
-            *write_data++ |= (*read_data++) << 8;
-        } while (read_data < read_end);
+#endif /* HAVE_SSE2_INTRINSICS */
 
-        gus_sample->loop_start >>= 1;
-        gus_sample->loop_end >>= 1;
-        gus_sample->data_length >>= 1;
-        return 0;
-    }
-    _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
-    return -1;
+#if defined(HAVE_NEON_INTRINSICS) && !defined(__ARM_BIG_ENDIAN)
+
+static inline int16x8_t neon_reverse8(int16x8_t x) {
+    x = vrev64q_s16(x);
+    return (vcombine_s16(vget_high_s16(x), vget_low_s16(x)));
 }
 
-/* 16bit signed ping pong */
-static int convert_16sp(uint8_t *data, struct _sample *gus_sample) {
-    uint32_t loop_length = gus_sample->loop_end
-            - gus_sample->loop_start;
-    uint32_t dloop_length = loop_length * 2;
-    uint32_t new_length = gus_sample->data_length + dloop_length;
-    uint8_t *read_data = data;
-    uint8_t *read_end = data + gus_sample->loop_start;
-    int16_t *write_data = NULL;
-    int16_t *write_data_a = NULL;
-    int16_t *write_data_b = NULL;
+static void cvt_8_neon(const uint8_t *src, int16_t *dst, uint32_t count, uint8_t flip) {
+    const uint8x16_t flips = vdupq_n_u8(flip);
+    int8x16_t x;
 
-    SAMPLE_CONVERT_DEBUG(__FUNCTION__);
-    gus_sample->data = (int16_t *) calloc(((new_length >> 1) + 2), sizeof(int16_t));
-    if (__builtin_expect((gus_sample->data != NULL), 1)) {
-        write_data = gus_sample->data;
-        do {
-            *write_data = (*read_data++);
-            *write_data++ |= (*read_data++) << 8;
-        } while (read_data < read_end);
-
-        *write_data = (*read_data++);
-        *write_data |= (*read_data++) << 8;
-        write_data_a = write_data + (dloop_length >> 1);
-        *write_data_a-- = *write_data;
-        write_data++;
-        write_data_b = write_data + (dloop_length >> 1);
-        read_end = data + gus_sample->loop_end;
-        do {
-            *write_data = (*read_data++);
-            *write_data |= (*read_data++) << 8;
-            *write_data_a-- = *write_data;
-            *write_data_b++ = *write_data;
-            write_data++;
-        } while (read_data < read_end);
-
-        *write_data = *(read_data++);
-        *write_data |= (*read_data++) << 8;
-        *write_data_b++ = *write_data;
-        read_end = data + gus_sample->data_length;
-        if (__builtin_expect((read_data != read_end), 1)) {
-            do {
-                *write_data_b = *(read_data++);
-                *write_data_b++ |= (*read_data++) << 8;
-            } while (read_data < read_end);
-        }
-        gus_sample->loop_start += loop_length;
-        gus_sample->loop_end += dloop_length;
-        gus_sample->data_length = new_length;
-        gus_sample->modes ^= SAMPLE_PINGPONG;
-        gus_sample->loop_start >>= 1;
-        gus_sample->loop_end >>= 1;
-        gus_sample->data_length >>= 1;
-        return 0;
+    for (; count >= 16; count -= 16, src += 16, dst += 16) {
+        x = vreinterpretq_s8_u8(veorq_u8(vld1q_u8(src), flips));
+        vst1q_s16(dst, vshll_n_s8(vget_low_s8(x), 8));
+        vst1q_s16(dst + 8, vshll_n_s8(vget_high_s8(x), 8));
+    }
+    if (flip) {
+        cvt_8u_c(src, dst, count);
+    } else {
+        cvt_8s_c(src, dst, count);
     }
-
-    _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
-    return -1;
 }
 
-/* 16bit signed reverse */
-static int convert_16sr(uint8_t *data, struct _sample *gus_sample) {
-    uint8_t *read_data = data;
-    uint8_t *read_end = data + gus_sample->data_length;
-    int16_t *write_data = NULL;
-    uint32_t tmp_loop = 0;
+static void cvt_8s_neon(const uint8_t *src, int16_t *dst, uint32_t count) {
+    cvt_8_neon(src, dst, count, 0x00);
+}
 
-    SAMPLE_CONVERT_DEBUG(__FUNCTION__);
-    gus_sample->data = (int16_t *) calloc(((gus_sample->data_length >> 1) + 2), sizeof(int16_t));
-    if (__builtin_expect((gus_sample->data != NULL), 1)) {
-        write_data = gus_sample->data + (gus_sample->data_length >> 1) - 1;
-        do {
-            *write_data = *read_data++;
-            *write_data-- |= (*read_data++) << 8;
-        } while (read_data < read_end);
-        tmp_loop = gus_sample->loop_end;
-        gus_sample->loop_end = gus_sample->data_length - gus_sample->loop_start;
-        gus_sample->loop_start = gus_sample->data_length - tmp_loop;
-        gus_sample->loop_fraction = ((gus_sample->loop_fraction & 0x0f) << 4)
-                | ((gus_sample->loop_fraction & 0xf0) >> 4);
-        gus_sample->loop_start >>= 1;
-        gus_sample->loop_end >>= 1;
-        gus_sample->data_length >>= 1;
-        gus_sample->modes ^= SAMPLE_REVERSE;
-        return 0;
-    }
-    _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
-    return -1;
+static void cvt_8u_neon(const uint8_t *src, int16_t *dst, uint32_t count) {
+    cvt_8_neon(src, dst, count, 0x80);
 }
 
-/* 16bit signed reverse ping pong */
-static int convert_16srp(uint8_t *data, struct _sample *gus_sample) {
-    uint32_t loop_length = gus_sample->loop_end
-            - gus_sample->loop_start;
-    uint32_t dloop_length = loop_length * 2;
-    uint32_t new_length = gus_sample->data_length + dloop_length;
-    uint8_t *read_data = data + gus_sample->data_length - 1;
-    uint8_t *read_end = data + gus_sample->loop_end;
-    int16_t *write_data = NULL;
-    int16_t *write_data_a = NULL;
-    int16_t *write_data_b = NULL;
+static void cvt_16_neon(const uint8_t *src, int16_t *dst, uint32_t count, uint16_t flip) {
+    const uint16x8_t flips = vdupq_n_u16(flip);
 
-    SAMPLE_CONVERT_DEBUG(__FUNCTION__);
-    gus_sample->data = (int16_t *) calloc(((new_length >> 1) + 2), sizeof(int16_t));
-    if (__builtin_expect((gus_sample->data != NULL), 1)) {
-        write_data = gus_sample->data;
-        do {
-            *write_data = (*read_data--) << 8;
-            *write_data++ |= *read_data--;
-        } while (read_data < read_end);
-
-        *write_data = (*read_data-- << 8);
-        *write_data |= *read_data--;
-        write_data_a = write_data + (dloop_length >> 1);
-        *write_data_a-- = *write_data;
-        write_data++;
-        write_data_b = write_data + (dloop_length >> 1);
-        read_end = data + gus_sample->loop_start;
-        do {
-            *write_data = (*read_data--) << 8;
-            *write_data |= *read_data--;
-            *write_data_a-- = *write_data;
-            *write_data_b++ = *write_data;
-            write_data++;
-        } while (read_data < read_end);
-
-        *write_data = ((*read_data--) << 8);
-        *write_data |= *read_data--;
-        *write_data_b++ = *write_data;
-        read_end = data - 1;
-        do {
-            *write_data_b = (*read_data--) << 8;
-            *write_data_b++ |= *read_data--;
-        } while (read_data < read_end);
-        gus_sample->loop_start += loop_length;
-        gus_sample->loop_end += dloop_length;
-        gus_sample->data_length = new_length;
-        gus_sample->modes ^= SAMPLE_PINGPONG | SAMPLE_REVERSE;
-        return 0;
+    for (; count >= 8; count -= 8, src += 16, dst += 8) {
+        vst1q_s16(dst, vreinterpretq_s16_u16(
+                veorq_u16(vreinterpretq_u16_u8(vld1q_u8(src)), flips)));
+    }
+    if (flip) {
+        cvt_16u_c(src, dst, count);
+    } else {
+        cvt_16s_c(src, dst, count);
     }
+}
 
-    _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
-    return -1;
+static void cvt_16s_neon(const uint8_t *src, int16_t *dst, uint32_t count) {
+    cvt_16_neon(src, dst, count, 0x0000);
 }
 
-/* 16bit unsigned */
-static int convert_16u(uint8_t *data, struct _sample *gus_sample) {
-    uint8_t *read_data = data;
-    uint8_t *read_end = data + gus_sample->data_length;
-    int16_t *write_data = NULL;
+static void cvt_16u_neon(const uint8_t *src, int16_t *dst, uint32_t count) {
+    cvt_16_neon(src, dst, count, 0x8000);
+}
 
-    SAMPLE_CONVERT_DEBUG(__FUNCTION__);
-    gus_sample->data = (int16_t *) calloc(((gus_sample->data_length >> 1) + 2), sizeof(int16_t));
-    if (__builtin_expect((gus_sample->data != NULL), 1)) {
-        write_data = gus_sample->data;
-        do {
-            *write_data = *read_data++;
-            *write_data++ |= ((*read_data++) ^ 0x80) << 8;
-        } while (read_data < read_end);
-        gus_sample->loop_start >>= 1;
-        gus_sample->loop_end >>= 1;
-        gus_sample->data_length >>= 1;
-        gus_sample->modes ^= SAMPLE_UNSIGNED;
-        return 0;
+static void cvt_reverse_neon(int16_t *data, uint32_t count) {
+    int16_t *end = data + count;
+    int16x8_t head, tail;
+
+    while ((end - data) >= 16) {
+        end -= 8;
+        head = vld1q_s16(data);
+        tail = vld1q_s16(end);
+        vst1q_s16(data, neon_reverse8(tail));
+        vst1q_s16(end, neon_reverse8(head));
+        data += 8;
     }
-    _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
-    return -1;
+    cvt_reverse_c(data, (uint32_t) (end - data));
 }
 
-/* 16bit unsigned ping pong */
-static int convert_16up(uint8_t *data, struct _sample *gus_sample) {
-    uint32_t loop_length = gus_sample->loop_end
-            - gus_sample->loop_start;
-    uint32_t dloop_length = loop_length * 2;
-    uint32_t new_length = gus_sample->data_length + dloop_length;
-    uint8_t *read_data = data;
-    uint8_t *read_end = data + gus_sample->loop_start;
-    int16_t *write_data = NULL;
-    int16_t *write_data_a = NULL;
-    int16_t *write_data_b = NULL;
+static const struct _WM_SampleConvert cvt_neon = {
+    { cvt_8s_neon, cvt_16s_neon, cvt_8u_neon, cvt_16u_neon },
+    cvt_reverse_neon
+};
 
-    SAMPLE_CONVERT_DEBUG(__FUNCTION__);
-    gus_sample->data = (int16_t *) calloc(((new_length >> 1) + 2), sizeof(int16_t));
-    if (__builtin_expect((gus_sample->data != NULL), 1)) {
-        write_data = gus_sample->data;
-        do {
-            *write_data = (*read_data++);
-            *write_data++ |= ((*read_data++) ^ 0x80) << 8;
-        } while (read_data < read_end);
-
-        *write_data = (*read_data++);
-        *write_data |= ((*read_data++) ^ 0x80) << 8;
-        write_data_a = write_data + (dloop_length >> 1);
-        *write_data_a-- = *write_data;
-        write_data++;
-        write_data_b = write_data + (dloop_length >> 1);
-        read_end = data + gus_sample->loop_end;
-        do {
-            *write_data = (*read_data++);
-            *write_data |= ((*read_data++) ^ 0x80) << 8;
-            *write_data_a-- = *write_data;
-            *write_data_b++ = *write_data;
-            write_data++;
-        } while (read_data < read_end);
-
-        *write_data = (*read_data++);
-        *write_data |= ((*read_data++) ^ 0x80) << 8;
-        *write_data_b++ = *write_data;
-        read_end = data + gus_sample->data_length;
-        if (__builtin_expect((read_data != read_end), 1)) {
-            do {
-                *write_data_b = (*read_data++);
-                *write_data_b++ |= ((*read_data++) ^ 0x80) << 8;
-            } while (read_data < read_end);
-        }
-        gus_sample->loop_start += loop_length;
-        gus_sample->loop_end += dloop_length;
-        gus_sample->data_length = new_length;
-        gus_sample->modes ^= SAMPLE_PINGPONG;
-        gus_sample->loop_start >>= 1;
-        gus_sample->loop_end >>= 1;
-        gus_sample->data_length >>= 1;
-        return 0;
-    }
+#endif /* HAVE_NEON_INTRINSICS */
 
-    _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
-    return -1;
+static const struct _WM_SampleConvert *cvt_pick(void) {
+#if defined(HAVE_SSE2_INTRINSICS)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    return (&cvt_sse2);
+#elif defined(__GNUC__) || defined(__clang__)
+    if (__builtin_cpu_supports("sse2"))
+        return (&cvt_sse2);
+#endif
+#endif
+#if defined(HAVE_NEON_INTRINSICS) && !defined(__ARM_BIG_ENDIAN)
+    return (&cvt_neon);
+#endif
+    return (&cvt_c);
 }
 
-/* 16bit unsigned reverse */
-static int convert_16ur(uint8_t *data, struct _sample *gus_sample) {
-    uint8_t *read_data = data;
-    uint8_t *read_end = data + gus_sample->data_length;
-    int16_t *write_data = NULL;
-    uint32_t tmp_loop = 0;
+/* frames a sample takes in the pool, two past its end for interpolation */
+#define GUS_SAMPLE_FRAMES(data_length, modes) \
+    (((data_length) >> ((modes) & SAMPLE_16BIT)) + 2)
+
+/*
+ * Convert the data of gus_sample, its loop and length in bytes of the file
+ * as read from the patch, to signed 16 bit samples the way the mixer plays
+ * them, with the loop and length set to match. The samples go to the zero
+ * filled slot of the pool at slot.
+ */
+static void convert_sample(const struct _WM_SampleConvert *cvt, const uint8_t *data, struct _sample *gus_sample, uint8_t *slot) {
+    uint8_t wide = gus_sample->modes & SAMPLE_16BIT;
+    uint32_t count = gus_sample->data_length >> wide;
+    uint32_t tmp_loop;
+    int16_t *samples;
 
     SAMPLE_CONVERT_DEBUG(__FUNCTION__);
-    gus_sample->data = (int16_t *) calloc(((gus_sample->data_length >> 1) + 2), sizeof(int16_t));
-    if (__builtin_expect((gus_sample->data != NULL), 1)) {
-        write_data = gus_sample->data + (gus_sample->data_length >> 1) - 1;
-        do {
-            *write_data = *read_data++;
-            *write_data-- |= ((*read_data++) ^ 0x80) << 8;
-        } while (read_data < read_end);
+    samples = ((int16_t *) slot) + SAMPLE_GUARD;
+    gus_sample->data = samples;
+
+    cvt->convert[gus_sample->modes & (SAMPLE_16BIT | SAMPLE_UNSIGNED)](data, samples, count);
+    gus_sample->modes &= ~SAMPLE_UNSIGNED;
+
+    if (gus_sample->modes & SAMPLE_REVERSE) {
+        cvt->reverse(samples, count);
         tmp_loop = gus_sample->loop_end;
         gus_sample->loop_end = gus_sample->data_length - gus_sample->loop_start;
         gus_sample->loop_start = gus_sample->data_length - tmp_loop;
         gus_sample->loop_fraction = ((gus_sample->loop_fraction & 0x0f) << 4)
                 | ((gus_sample->loop_fraction & 0xf0) >> 4);
+        gus_sample->modes ^= SAMPLE_REVERSE;
+    }
+
+    if (wide) {
         gus_sample->loop_start >>= 1;
         gus_sample->loop_end >>= 1;
         gus_sample->data_length >>= 1;
-        gus_sample->modes ^= SAMPLE_REVERSE | SAMPLE_UNSIGNED;
-        return 0;
     }
-    _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
-    return -1;
-}
-
-/* 16bit unsigned reverse ping pong */
-static int convert_16urp(uint8_t *data, struct _sample *gus_sample) {
-    uint32_t loop_length = gus_sample->loop_end
-            - gus_sample->loop_start;
-    uint32_t dloop_length = loop_length * 2;
-    uint32_t new_length = gus_sample->data_length + dloop_length;
-    uint8_t *read_data = data + gus_sample->data_length - 1;
-    uint8_t *read_end = data + gus_sample->loop_end;
-    int16_t *write_data = NULL;
-    int16_t *write_data_a = NULL;
-    int16_t *write_data_b = NULL;
 
-    SAMPLE_CONVERT_DEBUG(__FUNCTION__);
-    gus_sample->data = (int16_t *) calloc(((new_length >> 1) + 2), sizeof(int16_t));
-    if (__builtin_expect((gus_sample->data != NULL), 1)) {
-        write_data = gus_sample->data;
-        do {
-            *write_data = ((*read_data--) ^ 0x80) << 8;
-            *write_data++ |= *read_data--;
-        } while (read_data < read_end);
-
-        *write_data = ((*read_data--) ^ 0x80) << 8;
-        *write_data |= *read_data--;
-        write_data_a = write_data + (dloop_length >> 1);
-        *write_data_a-- = *write_data;
-        write_data++;
-        write_data_b = write_data + (dloop_length >> 1);
-        read_end = data + gus_sample->loop_start;
-        do {
-            *write_data = ((*read_data--) ^ 0x80) << 8;
-            *write_data |= *read_data--;
-            *write_data_a-- = *write_data;
-            *write_data_b++ = *write_data;
-            write_data++;
-        } while (read_data < read_end);
-
-        *write_data = ((*read_data--) ^ 0x80) << 8;
-        *write_data |= *read_data--;
-        *write_data_b++ = *write_data;
-        read_end = data - 1;
-        do {
-            *write_data_b = ((*read_data--) ^ 0x80) << 8;
-            *write_data_b++ |= *read_data--;
-        } while (read_data < read_end);
-        gus_sample->loop_start += loop_length;
-        gus_sample->loop_end += dloop_length;
-        gus_sample->data_length = new_length;
-        gus_sample->modes ^= SAMPLE_PINGPONG | SAMPLE_REVERSE | SAMPLE_UNSIGNED;
-        return 0;
+    /* the mixer turns around at both ends of a ping pong loop, which has
+       to be in the sample and at least one sample long for that */
+    if ((gus_sample->modes & SAMPLE_PINGPONG)
+            && ((gus_sample->loop_end > gus_sample->data_length)
+                || (gus_sample->loop_start >= gus_sample->loop_end))) {
+        gus_sample->modes ^= SAMPLE_PINGPONG;
     }
+}
 
-    _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
-    return -1;
+/*
+ * The bytes the pool for the samples of the patch takes. Stops at the first
+ * sample running past the end of the file, which the loader reports.
+ */
+static uint32_t sample_pool_size(const uint8_t *gus_patch, uint32_t gus_size) {
+    uint32_t size = 0;
+    uint32_t gus_ptr = 239;
+    uint32_t data_length;
+    uint8_t no_of_samples = gus_patch[198];
+
+    while (no_of_samples--) {
+        if ((gus_ptr + 96) > gus_size) {
+            break;
+        }
+        data_length = (gus_patch[gus_ptr + 11] << 24)
+                    | (gus_patch[gus_ptr + 10] << 16)
+                    | (gus_patch[gus_ptr + 9]  <<  8)
+                    |  gus_patch[gus_ptr + 8];
+        gus_ptr += 96;
+        if (data_length > (gus_size - gus_ptr)) {
+            break;
+        }
+        size += SAMPLE_POOL_SLOT(GUS_SAMPLE_FRAMES(data_length, gus_patch[gus_ptr - 96 + 55]));
+        gus_ptr += data_length;
+    }
+    return (size);
 }
 
 /* sample loading */
 
-struct _sample * _WM_load_gus_pat(const char *filename, int fix_release) {
-    uint8_t *gus_patch;
+/*
+ * Load the samples of the patch in filename. Their frames are all placed in
+ * the one pool returned in pool, which the caller frees along with them.
+ */
+struct _sample * _WM_load_gus_pat(const char *filename, int fix_release, uint32_t rate,
+                                  uint8_t **pool, uint32_t *pool_size) {
+    const uint8_t *gus_patch;
     uint32_t gus_size;
     uint32_t gus_ptr;
+    uint32_t pool_ptr;
     uint8_t no_of_samples;
     uint8_t envsusreltime, envreltime;
+    uint8_t env[12];
     struct _sample *gus_sample = NULL;
     struct _sample *first_gus_sample = NULL;
     uint32_t i = 0;
 
-    int (*do_convert[])(uint8_t *data, struct _sample *gus_sample) = {
-        convert_8s,
-        convert_16s,
-        convert_8u,
-        convert_16u,
-        convert_8sp,
-        convert_16sp,
-        convert_8up,
-        convert_16up,
-        convert_8sr,
-        convert_16sr,
-        convert_8ur,
-        convert_16ur,
-        convert_8srp,
-        convert_16srp,
-        convert_8urp,
-        convert_16urp
-    };
+    const struct _WM_SampleConvert *cvt = cvt_pick();
     uint32_t tmp_loop;
 
     WMIDI_UNUSED(fix_release);
 
     SAMPLE_CONVERT_DEBUG(__FUNCTION__); SAMPLE_CONVERT_DEBUG(filename);
 
-    if ((gus_patch = (uint8_t *) _WM_BufferFile(filename, &gus_size)) == NULL) {
+    if ((gus_patch = (const uint8_t *) _WM_MapFile(filename, &gus_size)) == NULL) {
         return NULL;
     }
     if (gus_size < 239) {
         _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_CORUPT, filename, 0);
-        _WM_FreeBufferFile(gus_patch);
+        _WM_UnmapFile(gus_patch, gus_size);
         return NULL;
     }
     if (memcmp(gus_patch, "GF1PATCH110\0ID#000002", 22)
             && memcmp(gus_patch, "GF1PATCH100\0ID#000002", 22)) {
         _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID, filename, 0);
-        _WM_FreeBufferFile(gus_patch);
+        _WM_UnmapFile(gus_patch, gus_size);
         return NULL;
     }
     if (gus_patch[82] > 1) {
         _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID, filename, 0);
-        _WM_FreeBufferFile(gus_patch);
+        _WM_UnmapFile(gus_patch, gus_size);
         return NULL;
     }
     if (gus_patch[151] > 1) {
         _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID, filename, 0);
-        _WM_FreeBufferFile(gus_patch);
+        _WM_UnmapFile(gus_patch, gus_size);
         return NULL;
     }
 
     GUSPAT_FILENAME_DEBUG(filename);
     GUSPAT_INT_DEBUG("voices",gus_patch[83]);
 
+    *pool_size = sample_pool_size(gus_patch, gus_size);
+    if ((*pool = _WM_alloc_sample_pool(*pool_size)) == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
+        *pool_size = 0;
+        _WM_UnmapFile(gus_patch, gus_size);
+        return NULL;
+    }
+    pool_ptr = 0;
+
     no_of_samples = gus_patch[198];
     gus_ptr = 239;
     while (no_of_samples) {
@@ -767,8 +455,7 @@ struct _sample * _WM_load_gus_pat(const char *filename, int fix_release) {
         }
         if (gus_sample == NULL) {
             _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, 0);
-            _WM_FreeBufferFile(gus_patch);
-            return NULL;
+            goto _fail;
         }
 
         gus_sample->next = NULL;
@@ -826,58 +513,61 @@ struct _sample * _WM_load_gus_pat(const char *filename, int fix_release) {
         /* All sorts of annoying things happen with pat files.
            One of them is that the sustained release time and
            normal release time gets mixed up because software got muddled */
-        envsusreltime = env_time_table[gus_patch[gus_ptr + 40]];
-        envreltime = env_time_table[gus_patch[gus_ptr + 41]];
+        /* the patch may be a read-only mapping, fix up a copy of the
+           envelope rates (env[0-5]) and levels (env[6-11]) */
+        memcpy(env, &gus_patch[gus_ptr + 37], 12);
+        envsusreltime = env_time_table[env[3]];
+        envreltime = env_time_table[env[4]];
         if (envsusreltime < envreltime) {
             /* EXPERIMENTAL */
-            gus_patch[gus_ptr + 40] = gus_patch[gus_ptr + 41];
+            env[3] = env[4];
             /* timidity does this: */
-            gus_patch[gus_ptr + 41] = 0x3f;
-            gus_patch[gus_ptr + 42] = 0x3f;
+            env[4] = 0x3f;
+            env[5] = 0x3f;
 
-            gus_patch[gus_ptr + 46] = gus_patch[gus_ptr + 47];
-            gus_patch[gus_ptr + 47] = 0;
-            gus_patch[gus_ptr + 48] = 0;
+            env[9] = env[10];
+            env[10] = 0;
+            env[11] = 0;
         }
 
         /* lets set up the envelope data */
         for (i = 0; i < 6; i++) {
             GUSPAT_INT_DEBUG("Envelope #",i);
             if (gus_sample->modes & SAMPLE_ENVELOPE) {
-                uint8_t env_rate = gus_patch[gus_ptr + 37 + i];
-                gus_sample->env_target[i] = 16448 * gus_patch[gus_ptr + 43 + i];
-                GUSPAT_INT_DEBUG("Envelope Level",gus_patch[gus_ptr+43+i]); GUSPAT_FLOAT_DEBUG("Envelope Time",env_time_table[env_rate]);
+                uint8_t env_rate = env[i];
+                gus_sample->env_target[i] = 16448 * env[6 + i];
+                GUSPAT_INT_DEBUG("Envelope Level",env[6+i]); GUSPAT_FLOAT_DEBUG("Envelope Time",env_time_table[env_rate]);
                 gus_sample->env_rate[i] = (int32_t) (4194303.0f
-                        / ((float) _WM_SampleRate * env_time_table[env_rate]));
+                        / ((float) rate * env_time_table[env_rate]));
                 GUSPAT_INT_DEBUG("Envelope Rate",gus_sample->env_rate[i]); GUSPAT_INT_DEBUG("GUSPAT Rate",env_rate);
                 if (gus_sample->env_rate[i] == 0) {
                     _WM_DEBUG_MSG("%s: Warning: found invalid envelope(%u) rate setting in %s. Using %f instead.",
                                   __FUNCTION__, i, filename, env_time_table[63]);
                     gus_sample->env_rate[i] = (int32_t) (4194303.0f
-                            / ((float) _WM_SampleRate * env_time_table[63]));
+                            / ((float) rate * env_time_table[63]));
                     GUSPAT_FLOAT_DEBUG("Envelope Time",env_time_table[63]);
                 }
             } else {
                 gus_sample->env_target[i] = 4194303;
                 gus_sample->env_rate[i] = (int32_t) (4194303.0f
-                        / ((float) _WM_SampleRate * env_time_table[63]));
+                        / ((float) rate * env_time_table[63]));
                 GUSPAT_FLOAT_DEBUG("Envelope Time",env_time_table[63]);
             }
         }
 
         gus_sample->env_target[6] = 0;
         gus_sample->env_rate[6] = (int32_t) (4194303.0f
-                / ((float) _WM_SampleRate * env_time_table[63]));
+                / ((float) rate * env_time_table[63]));
 
         gus_ptr += 96;
         tmp_cnt = gus_sample->data_length;
 
-        if (do_convert[(((gus_sample->modes & 0x18) >> 1)
-                | (gus_sample->modes & 0x03))](&gus_patch[gus_ptr], gus_sample)
-                == -1) {
-            _WM_FreeBufferFile(gus_patch);
-            return NULL;
+        if ((gus_ptr > gus_size) || (tmp_cnt > (gus_size - gus_ptr))) {
+            _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_CORUPT, "(sample data past end of file)", 0);
+            goto _fail;
         }
+        convert_sample(cvt, &gus_patch[gus_ptr], gus_sample, (*pool + pool_ptr));
+        pool_ptr += SAMPLE_POOL_SLOT(GUS_SAMPLE_FRAMES(tmp_cnt, gus_sample->modes));
 
         /*
          Test and set decay expected decay time after a note off
@@ -902,7 +592,7 @@ struct _sample * _WM_load_gus_pat(const char *filename, int fix_release) {
             gus_sample->note_off_decay = (uint32_t)samples_f;
 
         } else {
-            gus_sample->note_off_decay = gus_sample->data_length * _WM_SampleRate / gus_sample->rate;
+            gus_sample->note_off_decay = (uint32_t) (((uint64_t) gus_sample->data_length * rate) / gus_sample->rate);
         }
 
         gus_ptr += tmp_cnt;
@@ -914,6 +604,18 @@ struct _sample * _WM_load_gus_pat(const char *filename, int fix_release) {
         gus_sample->data_length = gus_sample->data_length << 10;
         no_of_samples--;
     }
-    _WM_FreeBufferFile(gus_patch);
+    _WM_UnmapFile(gus_patch, gus_size);
     return first_gus_sample;
+
+_fail:
+    while (first_gus_sample) {
+        gus_sample = first_gus_sample->next;
+        free(first_gus_sample);
+        first_gus_sample = gus_sample;
+    }
+    _WM_free_sample_pool(*pool);
+    *pool = NULL;
+    *pool_size = 0;
+    _WM_UnmapFile(gus_patch, gus_size);
+    return NULL;
 }
@@ -23,6 +23,7 @@
 
 #include "config.h"
 
+#include <errno.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
@@ -33,10 +34,13 @@
 #include "lock.h"
 #include "wm_error.h"
 #include "reverb.h"
+#include "resample.h"
 #include "sample.h"
+#include "wm_thread.h"
 #include "wildmidi_lib.h"
 #include "patches.h"
 #include "internal_midi.h"
+#include "mixer.h"
 
 #define HOLD_OFF 0x02
 
@@ -407,10 +411,10 @@ void _WM_DynamicVolumeAdjust(struct _mdi *mdi, int32_t *tmp_buffer, uint32_t buf
             if (volume != volume_to_reach) {
                 if (volume_to_reach == MAX_DYN_VOL) {
                     /* if we want normal volume then adjust to it slower */
-                    volume_adjust = (volume_to_reach - volume) / ((double)_WM_SampleRate * 0.1);
+                    volume_adjust = (volume_to_reach - volume) / ((double)mdi->ctx->sample_rate * 0.1);
                 } else {
                     /* if we want to clamp the volume then adjust quickly */
-                    volume_adjust = (volume_to_reach - volume) / ((double)_WM_SampleRate * 0.0001);
+                    volume_adjust = (volume_to_reach - volume) / ((double)mdi->ctx->sample_rate * 0.0001);
                 }
             }
         }
@@ -484,7 +488,7 @@ void _WM_AdjustNoteVolumes(struct _mdi *mdi, uint8_t ch, struct _note *nte) {
      FIXME: Still needs tuning. Clipping heard at a value of 3.75
      */
 #define VOL_DIVISOR 4.0
-    volume_adj = ((double)_WM_MasterVolume / 1024.0) / VOL_DIVISOR;
+    volume_adj = ((double)mdi->ctx->master_volume / 1024.0) / VOL_DIVISOR;
 
     MIDI_EVENT_DEBUG(__FUNCTION__,ch, 0);
 
@@ -513,26 +517,26 @@ void _WM_AdjustNoteVolumes(struct _mdi *mdi, uint8_t ch, struct _note *nte) {
 /* Should be called in any function that effects channel volumes */
 /* Calling this function with a value > 15 will make it adjust notes on all channels */
 void _WM_AdjustChannelVolumes(struct _mdi *mdi, uint8_t ch) {
-    struct _note *nte = mdi->note;
-    if (nte != NULL) {
-        do {
-            if (ch <= 15) {
-                if ((nte->noteid >> 8) == ch) {
-                    goto _DO_ADJUST;
-                }
-            } else {
-            _DO_ADJUST:
-                if (!nte->ignore_chan_events) {
-                    _WM_AdjustNoteVolumes(mdi, ch, nte);
-                    if (nte->replay) _WM_AdjustNoteVolumes(mdi, ch, nte->replay);
-                }
+    struct _note *nte;
+    uint32_t i;
+
+    for (i = 0; i < mdi->voice_count; i++) {
+        nte = mdi->voice[i];
+        if (ch <= 15) {
+            if ((nte->noteid >> 8) == ch) {
+                goto _DO_ADJUST;
+            }
+        } else {
+        _DO_ADJUST:
+            if (!nte->ignore_chan_events) {
+                _WM_AdjustNoteVolumes(mdi, ch, nte);
+                if (nte->replay) _WM_AdjustNoteVolumes(mdi, ch, nte->replay);
             }
-            nte = nte->next;
-        } while (nte != NULL);
+        }
     }
 }
 
-float _WM_GetSamplesPerTick(uint32_t divisions, uint32_t tempo) {
+float _WM_GetSamplesPerTick(uint32_t divisions, uint32_t tempo, uint32_t rate) {
     float microseconds_per_tick;
     float secs_per_tick;
     float samples_per_tick;
@@ -540,19 +544,346 @@ float _WM_GetSamplesPerTick(uint32_t divisions, uint32_t tempo) {
     /* Slow but needed for accuracy */
     microseconds_per_tick = (float) tempo / (float) divisions;
     secs_per_tick = microseconds_per_tick / 1000000.0f;
-    samples_per_tick = _WM_SampleRate * secs_per_tick;
+    samples_per_tick = rate * secs_per_tick;
 
     return (samples_per_tick);
 }
 
+/*
+ * The track heap, see struct _track_heap. Each step of a merge does the
+ * tracks due at now and moves on to the next tick any of them is due at,
+ * which costs log(tracks) for each track done rather than a pass over
+ * all of the tracks for each step. The sort key is how far past now a
+ * track is due, with the track number below it to break ties.
+ */
+#define WM_TRACK_KEY(h,d) ((((uint64_t)((d).tick - (h)->now)) << 32) | (d).track)
+#define WM_TRACK_BEFORE(h,a,b) (WM_TRACK_KEY(h, a) < WM_TRACK_KEY(h, b))
+
+int _WM_AllocTrackHeap(struct _track_heap *heap, uint32_t tracks) {
+    heap->count = 0;
+    heap->now = 0;
+    heap->due = (struct _track_due *) malloc(sizeof(struct _track_due) * tracks);
+    if (heap->due == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, 0);
+        return (-1);
+    }
+    return (0);
+}
+
+void _WM_FreeTrackHeap(struct _track_heap *heap) {
+    free(heap->due);
+    heap->due = NULL;
+    heap->count = 0;
+}
+
+/* move the track at pos towards the root until its parent is due first */
+static void WM_TrackUp(struct _track_heap *heap, uint32_t pos) {
+    struct _track_due *due = heap->due;
+    struct _track_due entry = due[pos];
+    uint32_t parent;
+
+    while (pos) {
+        parent = (pos - 1) >> 1;
+        if (!WM_TRACK_BEFORE(heap, entry, due[parent]))
+            break;
+        due[pos] = due[parent];
+        pos = parent;
+    }
+    due[pos] = entry;
+}
+
+/* and the one at the root down until both its children are due after it */
+static void WM_TrackDown(struct _track_heap *heap) {
+    struct _track_due *due = heap->due;
+    struct _track_due entry = due[0];
+    uint32_t pos = 0;
+    uint32_t child;
+
+    while ((child = (pos << 1) + 1) < heap->count) {
+        if (((child + 1) < heap->count)
+                && WM_TRACK_BEFORE(heap, due[child + 1], due[child]))
+            child++;
+        if (!WM_TRACK_BEFORE(heap, due[child], entry))
+            break;
+        due[pos] = due[child];
+        pos = child;
+    }
+    due[pos] = entry;
+}
+
+/* tick is the absolute tick of its first event */
+void _WM_AddTrack(struct _track_heap *heap, uint32_t track, uint32_t tick) {
+    heap->due[heap->count].tick = tick;
+    heap->due[heap->count].track = track;
+    WM_TrackUp(heap, heap->count++);
+}
+
+/* the first track is next due at tick */
+void _WM_RequeueTrack(struct _track_heap *heap, uint32_t tick) {
+    heap->due[0].tick = tick;
+    WM_TrackDown(heap);
+}
+
+/* the first track has ended */
+void _WM_DropTrack(struct _track_heap *heap) {
+    if (--heap->count) {
+        heap->due[0] = heap->due[heap->count];
+        WM_TrackDown(heap);
+    }
+}
+
+/* moves now on to the next tick a track is due at and returns the ticks
+   that took, 0 once all of the tracks have ended */
+uint32_t _WM_StepTrackHeap(struct _track_heap *heap) {
+    uint32_t delta;
+
+    if (!heap->count)
+        return (0);
+    delta = heap->due[0].tick - heap->now;
+    heap->now += delta;
+    return (delta);
+}
+
 static void _WM_CheckEventMemoryPool(struct _mdi *mdi) {
     if ((mdi->event_count + 1) >= mdi->events_size) {
-        mdi->events_size += MEM_CHUNK;
+        /* doubled, so a long song is only copied over a few times */
+        mdi->events_size *= 2;
         mdi->events = (struct _event *) realloc(mdi->events,
                               (mdi->events_size * sizeof(struct _event)));
     }
 }
 
+/* append an event with its data kept out of line, see struct _event */
+static int WM_AddEventExt(struct _mdi *mdi, uint8_t evtype, union _event_value data) {
+    union _event_value *ext;
+    uint32_t index = mdi->event_ext_count;
+    uint32_t size;
+
+    if (mdi->ctx->probe) {
+        /* only the timing is wanted, the next event writes over this one */
+        mdi->event_count = 0;
+        index = 0;
+    } else {
+        if (index >= WM_EVENT_EXT_MAX) {
+            _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_LONGFIL, "(too many meta events)", 0);
+            return (-1);
+        }
+        if (index >= mdi->event_ext_size) {
+            /* most songs only have a handful */
+            size = (mdi->event_ext_size) ? (mdi->event_ext_size * 2) : 256;
+            ext = (union _event_value *) realloc(mdi->event_ext,
+                            (size * sizeof(union _event_value)));
+            if (ext == NULL) {
+                _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
+                return (-1);
+            }
+            mdi->event_ext = ext;
+            mdi->event_ext_size = size;
+        }
+        mdi->event_ext[index] = data;
+        mdi->event_ext_count++;
+    }
+
+    _WM_CheckEventMemoryPool(mdi);
+    mdi->events[mdi->event_count].evtype = evtype;
+    mdi->events[mdi->event_count].channel = WM_EVENT_EXT | (uint8_t) (index >> 16);
+    mdi->events[mdi->event_count].data = (uint16_t) index;
+    mdi->events[mdi->event_count].samples_to_next = 0;
+    mdi->event_count++;
+    return (0);
+}
+
+/*
+ * Every event goes in through here. Channel events always fit, only meta
+ * events, which have no channel, can have values wider than 16 bits.
+ */
+static int WM_AddEvent(struct _mdi *mdi, uint8_t evtype, uint8_t channel, uint32_t value) {
+    union _event_value data;
+
+    if (value > 0xffff) {
+        data.value = value;
+        return (WM_AddEventExt(mdi, evtype, data));
+    }
+    if (mdi->ctx->probe) {
+        mdi->event_count = 0;
+    }
+    _WM_CheckEventMemoryPool(mdi);
+    mdi->events[mdi->event_count].evtype = evtype;
+    mdi->events[mdi->event_count].channel = channel & 0x0f;
+    mdi->events[mdi->event_count].data = (uint16_t) value;
+    mdi->events[mdi->event_count].samples_to_next = 0;
+    mdi->event_count++;
+    return (0);
+}
+
+/*
+ * The text of meta events is kept in the song arena, but for a streamed
+ * song, which drops it along with each window, and a probe, which keeps
+ * none of it.
+ */
+#define WM_TEXT_ON_HEAP(mdi) (((mdi)->stream != NULL) || ((mdi)->ctx->probe))
+
+static char *WM_CopyText(struct _mdi *mdi, const uint8_t *data, uint32_t length) {
+    char *text;
+
+    if (WM_TEXT_ON_HEAP(mdi)) {
+        text = (char *) malloc(length + 1);
+        if (text == NULL) {
+            _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
+            return (NULL);
+        }
+    } else if ((text = (char *) _WM_SongAlloc(mdi, length + 1)) == NULL) {
+        return (NULL);
+    }
+    memcpy(text, data, length);
+    text[length] = '\0';
+    return (text);
+}
+
+static int WM_AddTextEvent(struct _mdi *mdi, uint8_t evtype, char *text) {
+    union _event_value data;
+
+    if (mdi->ctx->probe) {
+        free(text);
+        data.value = 0;
+        return (WM_AddEventExt(mdi, evtype, data));
+    }
+    data.string = text;
+    if (WM_AddEventExt(mdi, evtype, data) == -1) {
+        if (WM_TEXT_ON_HEAP(mdi)) {
+            free(text);
+        }
+        return (-1);
+    }
+    return (0);
+}
+
+/* the order of enum _event_type */
+const _WM_EventFunc _WM_event_table[ev_null] = {
+    _WM_do_midi_divisions,
+    _WM_do_note_off,
+    _WM_do_note_on,
+    _WM_do_aftertouch,
+    _WM_do_control_bank_select,
+    _WM_do_control_data_entry_course,
+    _WM_do_control_channel_volume,
+    _WM_do_control_channel_balance,
+    _WM_do_control_channel_pan,
+    _WM_do_control_channel_expression,
+    _WM_do_control_data_entry_fine,
+    _WM_do_control_channel_hold,
+    _WM_do_control_data_increment,
+    _WM_do_control_data_decrement,
+    _WM_do_control_non_registered_param_fine,
+    _WM_do_control_non_registered_param_course,
+    _WM_do_control_registered_param_fine,
+    _WM_do_control_registered_param_course,
+    _WM_do_control_channel_sound_off,
+    _WM_do_control_channel_controllers_off,
+    _WM_do_control_channel_notes_off,
+    _WM_do_control_dummy,
+    _WM_do_patch,
+    _WM_do_channel_pressure,
+    _WM_do_pitch,
+    _WM_do_sysex_roland_drum_track,
+    _WM_do_sysex_gm_reset,
+    _WM_do_sysex_roland_reset,
+    _WM_do_sysex_yamaha_reset,
+    _WM_do_meta_endoftrack,
+    _WM_do_meta_tempo,
+    _WM_do_meta_timesignature,
+    _WM_do_meta_keysignature,
+    _WM_do_meta_sequenceno,
+    _WM_do_meta_channelprefix,
+    _WM_do_meta_portprefix,
+    _WM_do_meta_smpteoffset,
+    _WM_do_meta_text,
+    _WM_do_meta_copyright,
+    _WM_do_meta_trackname,
+    _WM_do_meta_instrumentname,
+    _WM_do_meta_lyric,
+    _WM_do_meta_marker,
+    _WM_do_meta_cuepoint
+};
+
+/* unpack event into the form the do functions take */
+void _WM_EventData(struct _mdi *mdi, const struct _event *event, struct _event_data *data) {
+    if (event->channel & WM_EVENT_EXT) {
+        data->channel = 0;
+        data->data = mdi->event_ext[WM_EVENT_EXT_INDEX(event)];
+    } else {
+        data->channel = event->channel;
+        data->data.value = event->data;
+    }
+}
+
+void _WM_DoEvent(struct _mdi *mdi, const struct _event *event) {
+    struct _event_data data;
+
+    _WM_EventData(mdi, event, &data);
+    WM_TRACE(mdi, WM_TRACE_EVENT, WM_TRACE_INSTANT, data.channel, event->evtype);
+    _WM_event_table[event->evtype](mdi, &data);
+}
+
+static enum _event_type WM_ControlEvent(uint8_t controller);
+
+/*
+ * Plays a channel message that is not part of the song, see WildMidi_Live().
+ * The patches it needs are loaded there and then, so the first note of an
+ * instrument the song does not use comes late by the time it takes to
+ * decode it. Anything but channel messages is ignored.
+ */
+void _WM_DoLiveEvent(struct _mdi *mdi, uint32_t message) {
+    struct _event_data data;
+    enum _event_type evtype;
+    uint8_t ch = message & 0x0f;
+    uint8_t data_1 = (message >> 8) & 0x7f;
+    uint8_t data_2 = (message >> 16) & 0x7f;
+    uint32_t patch_count = mdi->patch_count;
+
+    data.channel = ch;
+    switch (message & 0xf0) {
+        case 0x80:
+            evtype = ev_note_off;
+            data.data.value = (data_1 << 8) | data_2;
+            break;
+        case 0x90:
+            evtype = ev_note_on;
+            data.data.value = (data_1 << 8) | data_2;
+            if (mdi->channel[ch].isdrum)
+                _WM_load_patch(mdi, ((mdi->channel[ch].bank << 8) | (data_1 | 0x80)));
+            break;
+        case 0xa0:
+            evtype = ev_aftertouch;
+            data.data.value = (data_1 << 8) | data_2;
+            break;
+        case 0xb0:
+            evtype = WM_ControlEvent(data_1);
+            data.data.value = (evtype == ev_control_dummy) ? ((data_1 << 8) | data_2) : data_2;
+            break;
+        case 0xc0:
+            evtype = ev_patch;
+            data.data.value = data_1;
+            if (!mdi->channel[ch].isdrum)
+                _WM_load_patch(mdi, ((mdi->channel[ch].bank << 8) | data_1));
+            break;
+        case 0xd0:
+            evtype = ev_channel_pressure;
+            data.data.value = data_1;
+            break;
+        case 0xe0:
+            evtype = ev_pitch;
+            data.data.value = (data_2 << 7) | data_1;
+            break;
+        default:
+            return;
+    }
+
+    if (mdi->patch_count != patch_count)
+        _WM_decode_patches(mdi);
+    _WM_event_table[evtype](mdi, &data);
+}
+
 void _WM_do_note_off_extra(struct _note *nte) {
 
     MIDI_EVENT_DEBUG(__FUNCTION__,0, 0);
@@ -605,15 +936,108 @@ void _WM_do_midi_divisions(struct _mdi *mdi, struct _event_data *data) {
     return;
 }
 
+/*
+ * Note pool
+ *
+ * A key can have two notes sounding, the one played last and the one it
+ * replays (see _WM_do_note_on()). Both come out of the pool the first
+ * time the key is hit and stay with it until the pool runs dry, then the
+ * keys with nothing sounding hand theirs back. So the pool only grows to
+ * the number of keys that are ever down at the same time.
+ */
+static struct _note *WM_SlotNotes(struct _mdi *mdi, uint16_t slot) {
+    return (mdi->note_block[slot / WM_KEY_BLOCK] + ((slot % WM_KEY_BLOCK) * 2));
+}
+
+/* the two notes of a key, NULL when it has none and so nothing sounding */
+static struct _note *WM_KeyNotes(struct _mdi *mdi, uint8_t ch, uint8_t note) {
+    uint16_t key = mdi->key_map[ch][note];
+
+    if (!key)
+        return (NULL);
+    return (WM_SlotNotes(mdi, key - 1));
+}
+
+/* returns how many slots came free */
+static uint32_t WM_SweepKeys(struct _mdi *mdi) {
+    uint16_t *key = &mdi->key_map[0][0];
+    struct _note *notes;
+    uint32_t freed = 0;
+    uint32_t i;
+
+    for (i = 0; i < 16 * 128; i++) {
+        if (!key[i])
+            continue;
+        notes = WM_SlotNotes(mdi, key[i] - 1);
+        if (notes[0].active || notes[1].active)
+            continue;
+        notes[0].noteid = mdi->free_key;
+        mdi->free_key = key[i];
+        key[i] = 0;
+        freed++;
+    }
+    return (freed);
+}
+
+static int WM_GrowKeys(struct _mdi *mdi) {
+    uint32_t block = mdi->key_slots / WM_KEY_BLOCK;
+    struct _note **voice;
+    uint32_t i;
+
+    if (block == (WM_MAX_VOICES / WM_KEY_BLOCK))
+        return (-1);
+
+    /* every slot can add one voice, so the voice list grows along */
+    voice = (struct _note **) realloc(mdi->voice, ((mdi->key_slots + WM_KEY_BLOCK) * sizeof(struct _note *)));
+    if (voice == NULL)
+        return (-1);
+    mdi->voice = voice;
+
+    mdi->note_block[block] = (struct _note *) _WM_SongAlloc(mdi, WM_KEY_BLOCK * 2 * sizeof(struct _note));
+    if (mdi->note_block[block] == NULL)
+        return (-1);
+
+    for (i = WM_KEY_BLOCK; i > 0; i--) {
+        WM_SlotNotes(mdi, mdi->key_slots + i - 1)->noteid = mdi->free_key;
+        mdi->free_key = mdi->key_slots + i;
+    }
+    mdi->key_slots += WM_KEY_BLOCK;
+    return (0);
+}
+
+static struct _note *WM_KeyNotesAlloc(struct _mdi *mdi, uint8_t ch, uint8_t note) {
+    struct _note *notes = WM_KeyNotes(mdi, ch, note);
+
+    if (notes != NULL)
+        return (notes);
+
+    if (!mdi->free_key) {
+        /* only sweep again once a good part of a block came free, a song
+           holding most of its keys down would sweep on every note on */
+        if ((WM_SweepKeys(mdi) < (WM_KEY_BLOCK / 4)) && (WM_GrowKeys(mdi) != 0) && (!mdi->free_key)) {
+            _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, 0);
+            return (NULL);
+        }
+    }
+
+    mdi->key_map[ch][note] = mdi->free_key;
+    notes = WM_SlotNotes(mdi, mdi->free_key - 1);
+    mdi->free_key = notes[0].noteid;
+    memset(notes, 0, (2 * sizeof(struct _note)));
+    return (notes);
+}
+
 void _WM_do_note_off(struct _mdi *mdi, struct _event_data *data) {
     struct _note *nte;
     uint8_t ch = data->channel;
 
     MIDI_EVENT_DEBUG(__FUNCTION__,ch, data->data.value);
+    WM_TRACE(mdi, WM_TRACE_NOTE_OFF, WM_TRACE_INSTANT, ch, (data->data.value >> 8));
 
-    nte = &mdi->note_table[0][ch][(data->data.value >> 8)];
+    if ((nte = WM_KeyNotes(mdi, ch, (data->data.value >> 8))) == NULL)
+        return;
     if (!nte->active) {
-        nte = &mdi->note_table[1][ch][(data->data.value >> 8)];
+        nte++;
         if (!nte->active) {
             return;
         }
@@ -650,14 +1074,40 @@ static inline uint32_t get_inc(struct _mdi *mdi, struct _note *nte) {
         note_f = 12700;
     }
     freq = _WM_freq_table[(note_f % 1200)] >> (10 - (note_f / 1200));
-    return (((freq / ((_WM_SampleRate * 100) / 1024)) * 1024
+    return (((freq / ((mdi->ctx->sample_rate * 100) / 1024)) * 1024
              / nte->sample->inc_div));
 }
 
+/*
+ * Make room for a note once the polyphony limit is reached, by cutting off
+ * the quietest note. Notes that are already being released go first.
+ */
+static void WM_StealVoice(struct _mdi *mdi) {
+    struct _note *note_data;
+    uint32_t i, victim = 0;
+    int releasing, victim_releasing = -1;
+    int32_t victim_level = 0;
+
+    for (i = 0; i < mdi->voice_count; i++) {
+        note_data = mdi->voice[i];
+        releasing = (note_data->env >= 4) || note_data->is_off;
+        if ((releasing > victim_releasing)
+                || ((releasing == victim_releasing) && (note_data->env_level < victim_level))) {
+            victim = i;
+            victim_releasing = releasing;
+            victim_level = note_data->env_level;
+        }
+    }
+
+    note_data = mdi->voice[victim];
+    note_data->active = 0;
+    note_data->replay = NULL;
+    mdi->voice[victim] = mdi->voice[--mdi->voice_count];
+    mdi->stolen_voices++;
+}
+
 void _WM_do_note_on(struct _mdi *mdi, struct _event_data *data) {
     struct _note *nte;
-    struct _note *prev_nte;
-    struct _note *nte_array;
     uint32_t freq = 0;
     struct _patch *patch;
     struct _sample *sample;
@@ -671,6 +1121,7 @@ void _WM_do_note_on(struct _mdi *mdi, struct _event_data *data) {
     }
 
     MIDI_EVENT_DEBUG(__FUNCTION__,ch, data->data.value);
+    WM_TRACE(mdi, WM_TRACE_NOTE_ON, WM_TRACE_INSTANT, ch, ((note << 8) | velocity));
 
     if (!mdi->channel[ch].isdrum) {
         patch = mdi->channel[ch].patch;
@@ -697,38 +1148,31 @@ void _WM_do_note_on(struct _mdi *mdi, struct _event_data *data) {
         return;
     }
 
-    nte = &mdi->note_table[0][ch][note];
+    if ((nte = WM_KeyNotesAlloc(mdi, ch, note)) == NULL)
+        return;
 
     if (nte->active) {
         if ((nte->modes & SAMPLE_ENVELOPE) && (nte->env < 3)
             && (!(nte->hold & HOLD_OFF)))
             return;
-        nte->replay = &mdi->note_table[1][ch][note];
+        nte->replay = &nte[1];
         nte->env = 6;
         nte->env_inc = -nte->sample->env_rate[6];
         nte = nte->replay;
     } else {
-        if (mdi->note_table[1][ch][note].active) {
+        if (nte[1].active) {
             if ((nte->modes & SAMPLE_ENVELOPE) && (nte->env < 3)
                 && (!(nte->hold & HOLD_OFF)))
                 return;
-            mdi->note_table[1][ch][note].replay = nte;
-            mdi->note_table[1][ch][note].env = 6;
-            mdi->note_table[1][ch][note].env_inc =
-            -mdi->note_table[1][ch][note].sample->env_rate[6];
+            nte[1].replay = nte;
+            nte[1].env = 6;
+            nte[1].env_inc = -nte[1].sample->env_rate[6];
         } else {
-            nte_array = mdi->note;
-            if (nte_array == NULL) {
-                mdi->note = nte;
-            } else {
-                do {
-                    prev_nte = nte_array;
-                    nte_array = nte_array->next;
-                } while (nte_array);
-                prev_nte->next = nte;
+            while (mdi->max_voices && (mdi->voice_count >= mdi->max_voices)) {
+                WM_StealVoice(mdi);
             }
+            mdi->voice[mdi->voice_count++] = nte;
             nte->active = 1;
-            nte->next = NULL;
         }
     }
     nte->noteid = (ch << 8) | note;
@@ -745,6 +1189,8 @@ void _WM_do_note_on(struct _mdi *mdi, struct _event_data *data) {
     nte->replay = NULL;
     nte->is_off = 0;
     nte->ignore_chan_events = 0;
+    nte->reverse = 0;
+    nte->turned = 0;
     _WM_AdjustNoteVolumes(mdi, ch, nte);
 }
 
@@ -754,9 +1200,10 @@ void _WM_do_aftertouch(struct _mdi *mdi, struct _event_data *data) {
 
     MIDI_EVENT_DEBUG(__FUNCTION__,ch, data->data.value);
 
-    nte = &mdi->note_table[0][ch][(data->data.value >> 8)];
+    if ((nte = WM_KeyNotes(mdi, ch, (data->data.value >> 8))) == NULL)
+        return;
     if (!nte->active) {
-        nte = &mdi->note_table[1][ch][(data->data.value >> 8)];
+        nte++;
         if (!nte->active) {
             return;
         }
@@ -842,7 +1289,8 @@ void _WM_do_control_data_entry_fine(struct _mdi *mdi,
 }
 
 void _WM_do_control_channel_hold(struct _mdi *mdi, struct _event_data *data) {
-    struct _note *note_data = mdi->note;
+    struct _note *note_data;
+    uint32_t i;
     uint8_t ch = data->channel;
     MIDI_EVENT_DEBUG(__FUNCTION__,ch, data->data.value);
 
@@ -850,38 +1298,26 @@ void _WM_do_control_channel_hold(struct _mdi *mdi, struct _event_data *data) {
         mdi->channel[ch].hold = 1;
     } else {
         mdi->channel[ch].hold = 0;
-        if (note_data) {
-            do {
-                if ((note_data->noteid >> 8) == ch) {
-                    if (note_data->hold & HOLD_OFF) {
-                        if (note_data->modes & SAMPLE_ENVELOPE) {
-                            if (note_data->modes & SAMPLE_CLAMPED) {
-                                if (note_data->env < 5) {
-                                    note_data->env = 5;
-                                    if (note_data->env_level
-                                        > note_data->sample->env_target[5]) {
-                                        note_data->env_inc =
-                                        -note_data->sample->env_rate[5];
-                                    } else {
-                                        note_data->env_inc =
-                                        note_data->sample->env_rate[5];
-                                    }
-                                }
-                            /*
-                            } else if (note_data->modes & SAMPLE_SUSTAIN) {
-                                if (note_data->env < 3) {
-                                    note_data->env = 3;
-                                    if (note_data->env_level
-                                        > note_data->sample->env_target[3]) {
-                                        note_data->env_inc =
-                                        -note_data->sample->env_rate[3];
-                                    } else {
-                                        note_data->env_inc =
-                                        note_data->sample->env_rate[3];
-                                    }
+        for (i = 0; i < mdi->voice_count; i++) {
+            note_data = mdi->voice[i];
+            if ((note_data->noteid >> 8) == ch) {
+                if (note_data->hold & HOLD_OFF) {
+                    if (note_data->modes & SAMPLE_ENVELOPE) {
+                        if (note_data->modes & SAMPLE_CLAMPED) {
+                            if (note_data->env < 5) {
+                                note_data->env = 5;
+                                if (note_data->env_level
+                                    > note_data->sample->env_target[5]) {
+                                    note_data->env_inc =
+                                    -note_data->sample->env_rate[5];
+                                } else {
+                                    note_data->env_inc =
+                                    note_data->sample->env_rate[5];
                                 }
-                             */
-                             } else if (note_data->env < 3) {
+                            }
+                        /*
+                        } else if (note_data->modes & SAMPLE_SUSTAIN) {
+                            if (note_data->env < 3) {
                                 note_data->env = 3;
                                 if (note_data->env_level
                                     > note_data->sample->env_target[3]) {
@@ -892,17 +1328,27 @@ void _WM_do_control_channel_hold(struct _mdi *mdi, struct _event_data *data) {
                                     note_data->sample->env_rate[3];
                                 }
                             }
-                        } else {
-                            if (note_data->modes & SAMPLE_LOOP) {
-                                note_data->modes ^= SAMPLE_LOOP;
+                         */
+                         } else if (note_data->env < 3) {
+                            note_data->env = 3;
+                            if (note_data->env_level
+                                > note_data->sample->env_target[3]) {
+                                note_data->env_inc =
+                                -note_data->sample->env_rate[3];
+                            } else {
+                                note_data->env_inc =
+                                note_data->sample->env_rate[3];
                             }
-                            note_data->env_inc = 0;
                         }
+                    } else {
+                        if (note_data->modes & SAMPLE_LOOP) {
+                            note_data->modes ^= SAMPLE_LOOP;
+                        }
+                        note_data->env_inc = 0;
                     }
-                    note_data->hold = 0x00;
                 }
-                note_data = note_data->next;
-            } while (note_data);
+                note_data->hold = 0x00;
+            }
         }
     }
 }
@@ -968,20 +1414,25 @@ void _WM_do_control_registered_param_course(struct _mdi *mdi,
 
 void _WM_do_control_channel_sound_off(struct _mdi *mdi,
                                       struct _event_data *data) {
-    struct _note *note_data = mdi->note;
+    struct _note *note_data;
+    uint32_t i;
     uint8_t ch = data->channel;
     MIDI_EVENT_DEBUG(__FUNCTION__,ch, data->data.value);
 
-    if (note_data) {
-        do {
-            if ((note_data->noteid >> 8) == ch) {
-                note_data->active = 0;
-                if (note_data->replay) {
-                    note_data->replay = NULL;
-                }
+    i = 0;
+    while (i < mdi->voice_count) {
+        note_data = mdi->voice[i];
+        if ((note_data->noteid >> 8) == ch) {
+            note_data->active = 0;
+            if (note_data->replay) {
+                note_data->replay = NULL;
             }
-            note_data = note_data->next;
-        } while (note_data);
+            /* inactive notes must not stay in the voice list, a note on
+               would add them a second time */
+            mdi->voice[i] = mdi->voice[--mdi->voice_count];
+        } else {
+            i++;
+        }
     }
 }
 
@@ -1003,35 +1454,34 @@ void _WM_do_control_channel_controllers_off(struct _mdi *mdi,
 
 void _WM_do_control_channel_notes_off(struct _mdi *mdi,
                                       struct _event_data *data) {
-    struct _note *note_data = mdi->note;
+    struct _note *note_data;
+    uint32_t i;
     uint8_t ch = data->channel;
     MIDI_EVENT_DEBUG(__FUNCTION__,ch, data->data.value);
 
     if (mdi->channel[ch].isdrum)
         return;
-    if (note_data) {
-        do {
-            if ((note_data->noteid >> 8) == ch) {
-                if (!note_data->hold) {
-                    if (note_data->modes & SAMPLE_ENVELOPE) {
-                        if (note_data->env < 5) {
-                            if (note_data->env_level
-                                > note_data->sample->env_target[5]) {
-                                note_data->env_inc =
-                                -note_data->sample->env_rate[5];
-                            } else {
-                                note_data->env_inc =
-                                note_data->sample->env_rate[5];
-                            }
-                            note_data->env = 5;
+    for (i = 0; i < mdi->voice_count; i++) {
+        note_data = mdi->voice[i];
+        if ((note_data->noteid >> 8) == ch) {
+            if (!note_data->hold) {
+                if (note_data->modes & SAMPLE_ENVELOPE) {
+                    if (note_data->env < 5) {
+                        if (note_data->env_level
+                            > note_data->sample->env_target[5]) {
+                            note_data->env_inc =
+                            -note_data->sample->env_rate[5];
+                        } else {
+                            note_data->env_inc =
+                            note_data->sample->env_rate[5];
                         }
+                        note_data->env = 5;
                     }
-                } else {
-                    note_data->hold |= HOLD_OFF;
                 }
+            } else {
+                note_data->hold |= HOLD_OFF;
             }
-            note_data = note_data->next;
-        } while (note_data);
+        }
     }
 }
 
@@ -1058,12 +1508,14 @@ void _WM_do_patch(struct _mdi *mdi, struct _event_data *data) {
 
 void _WM_do_channel_pressure(struct _mdi *mdi, struct _event_data *data) {
     uint8_t ch = data->channel;
-    struct _note *note_data = mdi->note;
+    struct _note *note_data;
+    uint32_t i;
     MIDI_EVENT_DEBUG(__FUNCTION__,ch, data->data.value);
 
     mdi->channel[ch].pressure = data->data.value;
 
-    while (note_data) {
+    for (i = 0; i < mdi->voice_count; i++) {
+        note_data = mdi->voice[i];
         if (!note_data->ignore_chan_events) {
             if ((note_data->noteid >> 8) == ch) {
                 note_data->velocity = data->data.value & 0xff;
@@ -1074,12 +1526,12 @@ void _WM_do_channel_pressure(struct _mdi *mdi, struct _event_data *data) {
                 }
             }
         }
-        note_data = note_data->next;
     }
 }
 
 void _WM_do_pitch(struct _mdi *mdi, struct _event_data *data) {
-    struct _note *note_data = mdi->note;
+    struct _note *note_data;
+    uint32_t i;
     uint8_t ch = data->channel;
 
     MIDI_EVENT_DEBUG(__FUNCTION__,ch, data->data.value);
@@ -1093,13 +1545,11 @@ void _WM_do_pitch(struct _mdi *mdi, struct _event_data *data) {
         * mdi->channel[ch].pitch / 8191;
     }
 
-    if (note_data) {
-        do {
-            if ((note_data->noteid >> 8) == ch) {
-                note_data->sample_inc = get_inc(mdi, note_data);
-            }
-            note_data = note_data->next;
-        } while (note_data);
+    for (i = 0; i < mdi->voice_count; i++) {
+        note_data = mdi->voice[i];
+        if ((note_data->noteid >> 8) == ch) {
+            note_data->sample_inc = get_inc(mdi, note_data);
+        }
     }
 }
 
@@ -1175,9 +1625,11 @@ void _WM_Release_Allowance(struct _mdi *mdi) {
     uint32_t release = 0;
     uint32_t longest_release = 0;
 
-    struct _note *note = mdi->note;
+    struct _note *note;
+    uint32_t i;
 
-    while (note != NULL) {
+    for (i = 0; i < mdi->voice_count; i++) {
+        note = mdi->voice[i];
 
         if (note->modes & SAMPLE_ENVELOPE) {
             /* ensure envelope isin a release state */
@@ -1199,7 +1651,6 @@ void _WM_Release_Allowance(struct _mdi *mdi) {
 
         if (release > longest_release) longest_release = release;
         note->replay = NULL;
-        note = note->next;
     }
 
     mdi->samples_to_mix = longest_release;
@@ -1404,24 +1855,267 @@ void _WM_do_meta_cuepoint(struct _mdi *mdi, struct _event_data *data) {
     return;
 }
 
+/*
+ * WM_MO_PRUNEEVENTS
+ *
+ * Drops the channel events nothing can be heard of: settings that are
+ * already in effect, pitch bends too small to move the pitch and settings
+ * that are changed again before anything plays with them. The channels
+ * are followed through the events the way the _WM_do_ functions change
+ * them. A volume, expression, balance, pan or pitch only goes unheard while
+ * its channel has yet to play a note, or when it is set again before any
+ * samples are mixed, a patch until the next note on its channel. The wait
+ * of a dropped event goes to the one before it so the timing is kept,
+ * which is why nothing is dropped from where a song starts.
+ */
+#define PRUNE_VOLUME     0
+#define PRUNE_EXPRESSION 1
+#define PRUNE_BALANCE    2
+#define PRUNE_PAN        3
+#define PRUNE_PITCH      4
+#define PRUNE_PATCH      5
+#define PRUNE_KINDS      6
+#define PRUNE_UNKNOWN    0x7fffffff /* no setting comes out as this */
+
+struct _prune_channel {
+    int32_t value[PRUNE_KINDS];
+    /* the last event to change each setting + 1, 0 once it is heard */
+    uint32_t pending[PRUNE_KINDS];
+    uint32_t pending_mix[PRUNE_KINDS]; /* mixed when it was done */
+    int32_t before[PRUNE_KINDS];       /* the setting before it */
+    int16_t pitch_range;
+    uint16_t reg_data;
+    uint8_t reg_non;
+    uint8_t bank;
+    uint8_t isdrum;
+    uint8_t sounded;
+};
+
+/* what _WM_do_sysex_gm_reset() sets, the pitch is left as it was */
+static void WM_PruneReset(struct _prune_channel *prune) {
+    int ch;
+
+    for (ch = 0; ch < 16; ch++) {
+        memset(prune[ch].pending, 0, sizeof(prune[ch].pending));
+        prune[ch].value[PRUNE_VOLUME] = 100;
+        prune[ch].value[PRUNE_EXPRESSION] = 127;
+        prune[ch].value[PRUNE_BALANCE] = 64;
+        prune[ch].value[PRUNE_PAN] = 64;
+        prune[ch].value[PRUNE_PATCH] = (ch != 9) ? 0 : PRUNE_UNKNOWN;
+        prune[ch].pitch_range = 200;
+        prune[ch].reg_data = 0xFFFF;
+        prune[ch].bank = 0;
+        prune[ch].isdrum = (ch == 9);
+    }
+}
+
+/* event i sets the setting to value, returns how many events that lets go,
+   which are marked with ev_null, i itself can only go if it is after first */
+static uint32_t WM_PruneSetting(struct _event *event, struct _prune_channel *prune,
+                                uint8_t kind, int32_t value, uint32_t i,
+                                uint32_t first, uint32_t mixed) {
+    uint32_t dropped = 0;
+
+    if ((prune->pending[kind]) && ((kind == PRUNE_PATCH)
+            || (!prune->sounded) || (prune->pending_mix[kind] == mixed))) {
+        /* nothing played with the one before, it can go instead */
+        event[prune->pending[kind] - 1].evtype = ev_null;
+        dropped++;
+        prune->pending[kind] = 0;
+        prune->value[kind] = prune->before[kind];
+    }
+    if (i <= first) {
+        /* kept, and so is any event before it */
+        prune->pending[kind] = 0;
+        prune->value[kind] = value;
+        return (dropped);
+    }
+    if (prune->value[kind] == value) {
+        /* if the one before went too this leaves the setting as it was */
+        event[i].evtype = ev_null;
+        return (dropped + 1);
+    }
+    prune->pending[kind] = i + 1;
+    prune->pending_mix[kind] = mixed;
+    prune->before[kind] = prune->value[kind];
+    prune->value[kind] = value;
+    return (dropped);
+}
+
+static void WM_PruneEvents(struct _mdi *mdi) {
+    struct _prune_channel prune[16];
+    struct _prune_channel *chan;
+    struct _event *event = mdi->events;
+    struct _event *smaller;
+    uint32_t song_start = 0; /* kept to take the waits of its song */
+    uint32_t mixed = 0;      /* count of the waits so far */
+    uint32_t dropped = 0;
+    uint32_t i;
+    uint32_t kept;
+    int16_t pitch;
+    uint16_t value;
+    uint8_t kind;
+
+    memset(prune, 0, sizeof(prune));
+    WM_PruneReset(prune);
+    for (i = 0; i < 16; i++) {
+        /* a loop keeps the last bend, see WM_MO_LOOP */
+        prune[i].value[PRUNE_PITCH] = PRUNE_UNKNOWN;
+    }
+
+    for (i = 0; i < mdi->event_count; i++) {
+        chan = &prune[event[i].channel & 0x0f];
+        value = event[i].data;
+
+        switch (event[i].evtype) {
+        case ev_note_on:
+            memset(chan->pending, 0, sizeof(chan->pending));
+            chan->sounded = 1;
+            break;
+        case ev_control_bank_select:
+            chan->bank = (uint8_t) value;
+            break;
+        case ev_control_data_entry_course:
+            if ((chan->reg_non == 0) && (chan->reg_data == 0x0000))
+                chan->pitch_range = value * 100 + (chan->pitch_range % 100);
+            break;
+        case ev_control_data_entry_fine:
+            if ((chan->reg_non == 0) && (chan->reg_data == 0x0000))
+                chan->pitch_range = (chan->pitch_range / 100) * 100 + value;
+            break;
+        case ev_control_data_increment:
+            if ((chan->reg_non == 0) && (chan->reg_data == 0x0000)
+                    && (chan->pitch_range < 0x3FFF))
+                chan->pitch_range++;
+            break;
+        case ev_control_data_decrement:
+            if ((chan->reg_non == 0) && (chan->reg_data == 0x0000)
+                    && (chan->pitch_range > 0))
+                chan->pitch_range--;
+            break;
+        case ev_control_non_registered_param_fine:
+        case ev_control_registered_param_fine:
+            chan->reg_data = (chan->reg_data & 0x3F80) | value;
+            chan->reg_non = (event[i].evtype == ev_control_non_registered_param_fine);
+            break;
+        case ev_control_non_registered_param_course:
+        case ev_control_registered_param_course:
+            chan->reg_data = (chan->reg_data & 0x7F) | (value << 7);
+            chan->reg_non = (event[i].evtype == ev_control_non_registered_param_course);
+            break;
+        case ev_control_channel_controllers_off:
+            chan->pending[PRUNE_EXPRESSION] = 0;
+            chan->pending[PRUNE_PITCH] = 0;
+            chan->value[PRUNE_EXPRESSION] = 127;
+            /* the notes playing keep their pitch until the next bend */
+            chan->value[PRUNE_PITCH] = PRUNE_UNKNOWN;
+            chan->pitch_range = 200;
+            chan->reg_data = 0xffff;
+            break;
+        case ev_control_channel_volume:
+        case ev_control_channel_expression:
+        case ev_control_channel_balance:
+        case ev_control_channel_pan:
+            kind = (event[i].evtype == ev_control_channel_volume) ? PRUNE_VOLUME
+                    : (event[i].evtype == ev_control_channel_expression) ? PRUNE_EXPRESSION
+                    : (event[i].evtype == ev_control_channel_balance) ? PRUNE_BALANCE
+                    : PRUNE_PAN;
+            dropped += WM_PruneSetting(event, chan, kind, (uint8_t) value,
+                    i, song_start, mixed);
+            break;
+        case ev_pitch:
+            /* as _WM_do_pitch() works it out */
+            pitch = value - 0x2000;
+            dropped += WM_PruneSetting(event, chan, PRUNE_PITCH, (pitch < 0)
+                    ? (chan->pitch_range * pitch / 8192)
+                    : (chan->pitch_range * pitch / 8191), i, song_start, mixed);
+            break;
+        case ev_patch:
+            if (chan->isdrum) {
+                /* picks the drum set, see _WM_do_patch() */
+                chan->bank = (uint8_t) value;
+            } else {
+                dropped += WM_PruneSetting(event, chan, PRUNE_PATCH,
+                        ((chan->bank << 8) | value), i, song_start, mixed);
+            }
+            break;
+        case ev_sysex_roland_drum_track:
+            chan->pending[PRUNE_PATCH] = 0;
+            chan->isdrum = (value > 0);
+            chan->value[PRUNE_PATCH] = (chan->isdrum) ? PRUNE_UNKNOWN : 0;
+            break;
+        case ev_sysex_gm_reset:
+        case ev_sysex_roland_reset:
+        case ev_sysex_yamaha_reset:
+            WM_PruneReset(prune);
+            break;
+        case ev_meta_endoftrack:
+            /* the next song of a type 2 file can be started at */
+            song_start = i + 1;
+            break;
+        default:
+            break;
+        }
+
+        if (event[i].samples_to_next)
+            mixed++;
+    }
+
+    if (!dropped)
+        return;
+
+    /* the first event is never dropped, there is always one to take the wait */
+    for (i = 0, kept = 0; i < mdi->event_count; i++) {
+        if (event[i].evtype == ev_null) {
+            event[kept - 1].samples_to_next += event[i].samples_to_next;
+        } else {
+            event[kept++] = event[i];
+        }
+    }
+    mdi->event_count = kept;
+
+    smaller = (struct _event *) realloc(mdi->events,
+                    ((mdi->event_count + 2) * sizeof(struct _event)));
+    if (smaller != NULL) {
+        mdi->events = smaller;
+        mdi->events_size = mdi->event_count + 2;
+    }
+}
+
 void _WM_ResetToStart(struct _mdi *mdi) {
     struct _event * event = NULL;
 
+    if (mdi->stream) {
+        /* back to the first window, which also strips what it has to */
+        _WM_RestartStream(mdi);
+    }
+
+    if ((mdi->extra_info.mixer_options & WM_MO_PRUNEEVENTS) && (!mdi->stream)
+            && (!mdi->song) && (!mdi->events_pruned) && (!mdi->ctx->probe)) {
+        /* only once, the events no longer change after this */
+        WM_PruneEvents(mdi);
+        mdi->events_pruned = 1;
+    }
+
     mdi->current_event = mdi->events;
     mdi->samples_to_mix = 0;
     mdi->extra_info.current_sample = 0;
 
     _WM_do_sysex_gm_reset(mdi, NULL);
 
+    if (mdi->song) {
+        /* the events are the shared song's, made ready when it was parsed */
+        return;
+    }
+
     /* Ensure last event is NULL */
     _WM_CheckEventMemoryPool(mdi);
     mdi->events[mdi->event_count].evtype = ev_null;
-    mdi->events[mdi->event_count].do_event = NULL;
-    mdi->events[mdi->event_count].event_data.channel = 0;
-    mdi->events[mdi->event_count].event_data.data.value = 0;
+    mdi->events[mdi->event_count].channel = 0;
+    mdi->events[mdi->event_count].data = 0;
     mdi->events[mdi->event_count].samples_to_next = 0;
 
-    if (_WM_MixerOptions & WM_MO_STRIPSILENCE) {
+    if ((mdi->extra_info.mixer_options & WM_MO_STRIPSILENCE) && (!mdi->stream)) {
         event = mdi->events;
         /* Scan for first note on removing any samples as we go */
         if (event->evtype != ev_note_on) {
@@ -1450,43 +2144,386 @@ void _WM_ResetToStart(struct _mdi *mdi) {
     }
 }
 
-int _WM_midi_setup_divisions(struct _mdi *mdi, uint32_t divisions) {
-    MIDI_EVENT_DEBUG(__FUNCTION__,0,0);
-    _WM_CheckEventMemoryPool(mdi);
-    mdi->events[mdi->event_count].evtype = ev_midi_divisions;
-    mdi->events[mdi->event_count].do_event = _WM_do_midi_divisions;
-    mdi->events[mdi->event_count].event_data.channel = 0;
-    mdi->events[mdi->event_count].event_data.data.value = divisions;
-    mdi->events[mdi->event_count].samples_to_next = 0;
-    mdi->event_count++;
-    return (0);
-}
+/*
+ * Seek index
+ *
+ * Every interval samples the channel states are written down, together
+ * with the keys that are down at that point, so a seek only has to run
+ * the events from the nearest checkpoint before it. Notes are not played
+ * while seeking, the keys are followed instead so the notes still
+ * sounding at the new position can be started again.
+ */
+#define SEEK_HOLD 0x0100 /* the note was started under the hold pedal */
+#define SEEK_OFF  0x0200 /* the key is up but the pedal keeps it going */
 
-int _WM_midi_setup_noteoff(struct _mdi *mdi, uint8_t channel,
-                           uint8_t note, uint8_t velocity) {
+static void WM_SeekDropNotes(struct _mdi *mdi) {
+    uint32_t i;
+
+    for (i = 0; i < mdi->voice_count; i++) {
+        mdi->voice[i]->active = 0;
+        mdi->voice[i]->replay = NULL;
+    }
+    mdi->voice_count = 0;
+}
+
+/* key release, tells apart the notes the hold pedal keeps going */
+static void WM_SeekKeyUp(uint16_t *key) {
+    if (*key & SEEK_HOLD) {
+        *key |= SEEK_OFF;
+    } else {
+        *key = 0;
+    }
+}
+
+/* run event, following the keys in held instead of playing notes */
+static void WM_SeekEvent(struct _mdi *mdi, struct _event *event, uint16_t held[16][128]) {
+    uint8_t ch = event->channel & 0x0f;
+    uint8_t note = (event->data >> 8) & 0x7f;
+    int i;
+
+    switch (event->evtype) {
+    case ev_note_on:
+        if (!(event->data & 0xff)) {
+            WM_SeekKeyUp(&held[ch][note]);
+        } else if (!mdi->channel[ch].isdrum) {
+            /* drums are left alone, hitting them again would be wrong */
+            held[ch][note] = (event->data & 0xff)
+                             | ((mdi->channel[ch].hold) ? SEEK_HOLD : 0);
+        }
+        return;
+    case ev_note_off:
+        WM_SeekKeyUp(&held[ch][note]);
+        return;
+    case ev_control_channel_notes_off:
+        if (!mdi->channel[ch].isdrum) {
+            for (i = 0; i < 128; i++)
+                WM_SeekKeyUp(&held[ch][i]);
+        }
+        break;
+    case ev_control_channel_sound_off:
+        for (i = 0; i < 128; i++)
+            held[ch][i] = 0;
+        break;
+    case ev_control_channel_hold:
+        if (event->data <= 63) {
+            for (i = 0; i < 128; i++) {
+                if (held[ch][i] & SEEK_OFF) {
+                    held[ch][i] = 0;
+                } else {
+                    held[ch][i] &= ~SEEK_HOLD;
+                }
+            }
+        }
+        break;
+    default:
+        break;
+    }
+    _WM_DoEvent(mdi, event);
+}
+
+static int WM_SeekAddPoint(struct _seek_index *index, struct _mdi *mdi,
+                           uint32_t event, uint32_t sample, uint16_t held[16][128]) {
+    struct _seek_point *point;
+    struct _seek_held *keys;
+    uint32_t ch, note;
+
+    if (!(index->point_count & 63)) {
+        point = (struct _seek_point *) realloc(index->point,
+                (index->point_count + 64) * sizeof(struct _seek_point));
+        if (point == NULL)
+            return (-1);
+        index->point = point;
+    }
+    point = &index->point[index->point_count++];
+    point->event = event;
+    point->sample = sample;
+    memcpy(point->channel, mdi->channel, sizeof(mdi->channel));
+    point->lyric = mdi->lyric;
+    point->held = index->held_count;
+    point->held_count = 0;
+
+    for (ch = 0; ch < 16; ch++) {
+        for (note = 0; note < 128; note++) {
+            if (!held[ch][note])
+                continue;
+            if (!(index->held_count & 63)) {
+                keys = (struct _seek_held *) realloc(index->held,
+                        (index->held_count + 64) * sizeof(struct _seek_held));
+                if (keys == NULL)
+                    return (-1);
+                index->held = keys;
+            }
+            keys = &index->held[index->held_count++];
+            keys->channel = ch;
+            keys->note = note;
+            keys->state = held[ch][note];
+            point->held_count++;
+        }
+    }
+    return (0);
+}
+
+void _WM_FreeSeekIndex(struct _mdi *mdi) {
+    if (mdi->seek_index == NULL)
+        return;
+    free(mdi->seek_index->point);
+    free(mdi->seek_index->held);
+    free(mdi->seek_index);
+    mdi->seek_index = NULL;
+}
+
+/*
+ * Walks the whole song once to write down the checkpoints, interval
+ * samples apart. Leaves the song rewound to the start.
+ */
+int _WM_BuildSeekIndex(struct _mdi *mdi, uint32_t interval, uint8_t restart_notes) {
+    struct _seek_index *index;
+    struct _event *event;
+    uint16_t held[16][128];
+    uint32_t sample = 0;
+    uint32_t next_point = 0;
+
+    _WM_FreeSeekIndex(mdi);
+    if ((index = (struct _seek_index *) calloc(1, sizeof(struct _seek_index))) == NULL)
+        return (-1);
+    index->interval = interval;
+    index->restart_notes = restart_notes;
+
+    WM_SeekDropNotes(mdi);
+    _WM_ResetToStart(mdi);
+    memset(held, 0, sizeof(held));
+
+    for (event = mdi->events; event->evtype != ev_null; event++) {
+        if (sample >= next_point) {
+            if (WM_SeekAddPoint(index, mdi, (uint32_t)(event - mdi->events), sample, held) == -1) {
+                free(index->point);
+                free(index->held);
+                free(index);
+                _WM_ResetToStart(mdi);
+                return (-1);
+            }
+            while (next_point <= sample)
+                next_point += interval;
+        }
+        WM_SeekEvent(mdi, event, held);
+        sample += event->samples_to_next;
+    }
+
+    mdi->seek_index = index;
+    _WM_ResetToStart(mdi);
+    return (0);
+}
+
+/*
+ * Moves playback to sample_pos from the last checkpoint before it, ending
+ * up in the same state WildMidi_FastSeek() leaves the song in. When asked
+ * for, the notes still sounding at sample_pos are started over there.
+ */
+void _WM_SeekIndexed(struct _mdi *mdi, uint32_t sample_pos) {
+    struct _seek_index *index = mdi->seek_index;
+    struct _seek_point *point;
+    struct _seek_held *keys;
+    struct _event *event;
+    struct _event_data data;
+    struct _note *nte;
+    uint16_t held[16][128];
+    uint32_t first = 0;
+    uint32_t last = index->point_count - 1;
+    uint32_t mid, i;
+
+    /* the last checkpoint at or before sample_pos, the first is at 0 */
+    while (first < last) {
+        mid = (first + last + 1) / 2;
+        if (index->point[mid].sample <= sample_pos) {
+            first = mid;
+        } else {
+            last = mid - 1;
+        }
+    }
+    point = &index->point[first];
+
+    WM_SeekDropNotes(mdi);
+    memcpy(mdi->channel, point->channel, sizeof(mdi->channel));
+    mdi->lyric = point->lyric;
+    memset(held, 0, sizeof(held));
+    keys = &index->held[point->held];
+    for (i = 0; i < point->held_count; i++)
+        held[keys[i].channel][keys[i].note] = keys[i].state;
+
+    event = &mdi->events[point->event];
+    mdi->extra_info.current_sample = point->sample;
+    mdi->samples_to_mix = 0;
+    while ((!mdi->samples_to_mix) && (event->evtype != ev_null)) {
+        WM_SeekEvent(mdi, event, held);
+        mdi->samples_to_mix = event->samples_to_next;
+
+        if ((mdi->extra_info.current_sample + mdi->samples_to_mix) > sample_pos) {
+            mdi->samples_to_mix = (mdi->extra_info.current_sample + mdi->samples_to_mix) - sample_pos;
+            mdi->extra_info.current_sample = sample_pos;
+        } else {
+            mdi->extra_info.current_sample += mdi->samples_to_mix;
+            mdi->samples_to_mix = 0;
+        }
+        event++;
+    }
+    mdi->current_event = event;
+
+    if (!index->restart_notes)
+        return;
+
+    for (i = 0; i < 16 * 128; i++) {
+        if (!held[i >> 7][i & 0x7f])
+            continue;
+        data.channel = i >> 7;
+        data.data.value = ((i & 0x7f) << 8) | (held[i >> 7][i & 0x7f] & 0xff);
+        _WM_do_note_on(mdi, &data);
+        nte = WM_KeyNotes(mdi, i >> 7, i & 0x7f);
+        if ((nte != NULL) && (nte->active)) {
+            nte->hold = (held[i >> 7][i & 0x7f] & SEEK_HOLD) ? 1 : 0;
+            if (held[i >> 7][i & 0x7f] & SEEK_OFF)
+                nte->hold |= HOLD_OFF;
+        }
+    }
+}
+
+/*
+ * The songs of a file are what lies between its end of track events, the
+ * way a type 2 midi or an xmi with several sequences plays them. Walks the
+ * events once to write down where each song starts along with the state
+ * of the channels there, as playing up to it would leave them. Leaves the
+ * song rewound to the start.
+ */
+int _WM_BuildSongIndex(struct _mdi *mdi) {
+    struct _song_start *start = NULL;
+    struct _song_start *grown;
+    struct _event *event;
+    uint16_t held[16][128];
+    uint32_t sample = 0;
+    uint32_t count = 0;
+
+    WM_SeekDropNotes(mdi);
+    _WM_ResetToStart(mdi);
+    memset(held, 0, sizeof(held));
+
+    event = mdi->events;
+    for (;;) {
+        if (!(count & 15)) {
+            grown = (struct _song_start *) realloc(start, (count + 16) * sizeof(struct _song_start));
+            if (grown == NULL) {
+                free(start);
+                _WM_ResetToStart(mdi);
+                return (-1);
+            }
+            start = grown;
+        }
+        start[count].event = (uint32_t)(event - mdi->events);
+        start[count].sample = sample;
+        memcpy(start[count].channel, mdi->channel, sizeof(mdi->channel));
+        start[count].lyric = mdi->lyric;
+        count++;
+
+        /* up to and including the end of track of this song */
+        while (event->evtype != ev_null) {
+            WM_SeekEvent(mdi, event, held);
+            sample += event->samples_to_next;
+            if ((event++)->evtype == ev_meta_endoftrack) {
+                break;
+            }
+        }
+        if (event->evtype == ev_null) {
+            break;
+        }
+    }
+
+    free(mdi->song_start);
+    mdi->song_start = start;
+    mdi->song_count = count;
+    _WM_ResetToStart(mdi);
+    return (0);
+}
+
+/* the song the event at index event is in */
+uint32_t _WM_SongAt(struct _mdi *mdi, uint32_t event) {
+    uint32_t first = 0;
+    uint32_t last = mdi->song_count - 1;
+    uint32_t mid;
+
+    /* the last song starting at or before it, the first starts at 0 */
+    while (first < last) {
+        mid = (first + last + 1) / 2;
+        if (mdi->song_start[mid].event <= event) {
+            first = mid;
+        } else {
+            last = mid - 1;
+        }
+    }
+    return (first);
+}
+
+/* moves playback to the start of song, with no notes playing */
+void _WM_StartSong(struct _mdi *mdi, uint32_t song) {
+    struct _song_start *start = &mdi->song_start[song];
+
+    WM_SeekDropNotes(mdi);
+    memcpy(mdi->channel, start->channel, sizeof(mdi->channel));
+    mdi->lyric = start->lyric;
+    mdi->current_event = &mdi->events[start->event];
+    mdi->extra_info.current_sample = start->sample;
+    mdi->samples_to_mix = 0;
+}
+
+/* moves playback to sample_pos by way of the song it is in, with no notes
+   playing, as building the table has rewound it */
+void _WM_SongSeekSample(struct _mdi *mdi, uint32_t sample_pos) {
+    struct _event *event;
+    uint16_t held[16][128];
+    uint32_t first = 0;
+    uint32_t last = mdi->song_count - 1;
+    uint32_t mid;
+
+    while (first < last) {
+        mid = (first + last + 1) / 2;
+        if (mdi->song_start[mid].sample <= sample_pos) {
+            first = mid;
+        } else {
+            last = mid - 1;
+        }
+    }
+    _WM_StartSong(mdi, first);
+
+    /* the keys held are of no use, the notes are not restarted */
+    memset(held, 0, sizeof(held));
+    event = mdi->current_event;
+    while (event->evtype != ev_null) {
+        WM_SeekEvent(mdi, event, held);
+        if ((mdi->extra_info.current_sample + (event++)->samples_to_next) > sample_pos) {
+            mdi->samples_to_mix = mdi->extra_info.current_sample + event[-1].samples_to_next - sample_pos;
+            mdi->extra_info.current_sample = sample_pos;
+            break;
+        }
+        mdi->extra_info.current_sample += event[-1].samples_to_next;
+    }
+    mdi->current_event = event;
+}
+
+int _WM_midi_setup_divisions(struct _mdi *mdi, uint32_t divisions) {
+    MIDI_EVENT_DEBUG(__FUNCTION__,0,0);
+    return (WM_AddEvent(mdi, ev_midi_divisions, 0, divisions));
+}
+
+int _WM_midi_setup_noteoff(struct _mdi *mdi, uint8_t channel,
+                           uint8_t note, uint8_t velocity) {
     MIDI_EVENT_DEBUG(__FUNCTION__,channel, note);
-    _WM_CheckEventMemoryPool(mdi);
     note &= 0x7f; /* silently bound note to 0..127 (github bug #180) */
-    mdi->events[mdi->event_count].evtype = ev_note_off;
-    mdi->events[mdi->event_count].do_event = _WM_do_note_off;
-    mdi->events[mdi->event_count].event_data.channel = channel;
-    mdi->events[mdi->event_count].event_data.data.value = (note << 8) | velocity;
-    mdi->events[mdi->event_count].samples_to_next = 0;
-    mdi->event_count++;
-    return (0);
+    return (WM_AddEvent(mdi, ev_note_off, channel, (note << 8) | velocity));
 }
 
 static int midi_setup_noteon(struct _mdi *mdi, uint8_t channel,
                              uint8_t note, uint8_t velocity) {
     MIDI_EVENT_DEBUG(__FUNCTION__,channel, note);
-    _WM_CheckEventMemoryPool(mdi);
     note &= 0x7f; /* silently bound note to 0..127 (github bug #180) */
-    mdi->events[mdi->event_count].evtype = ev_note_on;
-    mdi->events[mdi->event_count].do_event = _WM_do_note_on;
-    mdi->events[mdi->event_count].event_data.channel = channel;
-    mdi->events[mdi->event_count].event_data.data.value = (note << 8) | velocity;
-    mdi->events[mdi->event_count].samples_to_next = 0;
-    mdi->event_count++;
+    if (WM_AddEvent(mdi, ev_note_on, channel, ((note << 8) | velocity)) == -1)
+        return (-1);
 
     if (mdi->channel[channel].isdrum)
         _WM_load_patch(mdi, ((mdi->channel[channel].bank << 8) | (note | 0x80)));
@@ -1496,24 +2533,12 @@ static int midi_setup_noteon(struct _mdi *mdi, uint8_t channel,
 static int midi_setup_aftertouch(struct _mdi *mdi, uint8_t channel,
                                  uint8_t note, uint8_t pressure) {
     MIDI_EVENT_DEBUG(__FUNCTION__,channel, note);
-    _WM_CheckEventMemoryPool(mdi);
     note &= 0x7f; /* silently bound note to 0..127 (github bug #180) */
-    mdi->events[mdi->event_count].evtype = ev_aftertouch;
-    mdi->events[mdi->event_count].do_event = _WM_do_aftertouch;
-    mdi->events[mdi->event_count].event_data.channel = channel;
-    mdi->events[mdi->event_count].event_data.data.value = (note << 8) | pressure;
-    mdi->events[mdi->event_count].samples_to_next = 0;
-    mdi->event_count++;
-    return (0);
+    return (WM_AddEvent(mdi, ev_aftertouch, channel, (note << 8) | pressure));
 }
 
-static int midi_setup_control(struct _mdi *mdi, uint8_t channel,
-                              uint8_t controller, uint8_t setting) {
-    void (*tmp_event)(struct _mdi *mdi, struct _event_data *data);
-    enum _event_type ev;
-
-    MIDI_EVENT_DEBUG(__FUNCTION__,channel, controller);
-
+/* the event a controller maps to, ev_control_dummy if we do not support it */
+static enum _event_type WM_ControlEvent(uint8_t controller) {
     switch (controller) {
         /*
          **********************************************************************
@@ -1523,104 +2548,66 @@ static int midi_setup_control(struct _mdi *mdi, uint8_t channel,
          **********************************************************************
          */
         case 0:
-            ev = ev_control_bank_select;
-            tmp_event = _WM_do_control_bank_select;
-            mdi->channel[channel].bank = setting;
-            break;
+            return (ev_control_bank_select);
         case 6:
-            ev = ev_control_data_entry_course;
-            tmp_event = _WM_do_control_data_entry_course;
-            break;
+            return (ev_control_data_entry_course);
         case 7:
-            ev = ev_control_channel_volume;
-            tmp_event = _WM_do_control_channel_volume;
-            mdi->channel[channel].volume = setting;
-            break;
+            return (ev_control_channel_volume);
         case 8:
-            ev = ev_control_channel_balance;
-            tmp_event = _WM_do_control_channel_balance;
-            break;
+            return (ev_control_channel_balance);
         case 10:
-            ev = ev_control_channel_pan;
-            tmp_event = _WM_do_control_channel_pan;
-            break;
+            return (ev_control_channel_pan);
         case 11:
-            ev = ev_control_channel_expression;
-            tmp_event = _WM_do_control_channel_expression;
-            break;
+            return (ev_control_channel_expression);
         case 38:
-            ev = ev_control_data_entry_fine;
-            tmp_event = _WM_do_control_data_entry_fine;
-            break;
+            return (ev_control_data_entry_fine);
         case 64:
-            ev = ev_control_channel_hold;
-            tmp_event = _WM_do_control_channel_hold;
-            break;
+            return (ev_control_channel_hold);
         case 96:
-            ev = ev_control_data_increment;
-            tmp_event = _WM_do_control_data_increment;
-            break;
+            return (ev_control_data_increment);
         case 97:
-            ev = ev_control_data_decrement;
-            tmp_event = _WM_do_control_data_decrement;
-            break;
+            return (ev_control_data_decrement);
         case 98:
-            ev = ev_control_non_registered_param_fine;
-            tmp_event = _WM_do_control_non_registered_param_fine;
-            break;
+            return (ev_control_non_registered_param_fine);
         case 99:
-            ev = ev_control_non_registered_param_course;
-            tmp_event = _WM_do_control_non_registered_param_course;
-            break;
+            return (ev_control_non_registered_param_course);
         case 100:
-            ev = ev_control_registered_param_fine;
-            tmp_event = _WM_do_control_registered_param_fine;
-            break;
+            return (ev_control_registered_param_fine);
         case 101:
-            ev = ev_control_registered_param_course;
-            tmp_event = _WM_do_control_registered_param_course;
-            break;
+            return (ev_control_registered_param_course);
         case 120:
-            ev = ev_control_channel_sound_off;
-            tmp_event = _WM_do_control_channel_sound_off;
-            break;
+            return (ev_control_channel_sound_off);
         case 121:
-            ev = ev_control_channel_controllers_off;
-            tmp_event = _WM_do_control_channel_controllers_off;
-            break;
+            return (ev_control_channel_controllers_off);
         case 123:
-            ev = ev_control_channel_notes_off;
-            tmp_event = _WM_do_control_channel_notes_off;
-            break;
+            return (ev_control_channel_notes_off);
         default:
-            ev = ev_control_dummy;
-            tmp_event = _WM_do_control_dummy;
-            break;
+            return (ev_control_dummy);
+    }
+}
+
+static int midi_setup_control(struct _mdi *mdi, uint8_t channel,
+                              uint8_t controller, uint8_t setting) {
+    enum _event_type ev = WM_ControlEvent(controller);
+
+    MIDI_EVENT_DEBUG(__FUNCTION__,channel, controller);
+
+    if (ev == ev_control_bank_select) {
+        mdi->channel[channel].bank = setting;
+    } else if (ev == ev_control_channel_volume) {
+        mdi->channel[channel].volume = setting;
     }
 
-    _WM_CheckEventMemoryPool(mdi);
-    mdi->events[mdi->event_count].evtype = ev;
-    mdi->events[mdi->event_count].do_event = tmp_event;
-    mdi->events[mdi->event_count].event_data.channel = channel;
     if (ev != ev_control_dummy) {
-        mdi->events[mdi->event_count].event_data.data.value = setting;
-    } else {
-        mdi->events[mdi->event_count].event_data.data.value = (controller << 8) | setting;
+        return (WM_AddEvent(mdi, ev, channel, setting));
     }
-    mdi->events[mdi->event_count].samples_to_next = 0;
-    mdi->event_count++;
-    return (0);
+    return (WM_AddEvent(mdi, ev, channel, ((controller << 8) | setting)));
 }
 
 static int midi_setup_patch(struct _mdi *mdi, uint8_t channel, uint8_t patch) {
     MIDI_EVENT_DEBUG(__FUNCTION__,channel, patch);
-    _WM_CheckEventMemoryPool(mdi);
-    mdi->events[mdi->event_count].evtype = ev_patch;
-    mdi->events[mdi->event_count].do_event = _WM_do_patch;
-    mdi->events[mdi->event_count].event_data.channel = channel;
-    mdi->events[mdi->event_count].event_data.data.value = patch;
-    mdi->events[mdi->event_count].samples_to_next = 0;
-    mdi->event_count++;
+    if (WM_AddEvent(mdi, ev_patch, channel, patch) == -1)
+        return (-1);
 
     if (mdi->channel[channel].isdrum) {
         mdi->channel[channel].bank = patch;
@@ -1635,38 +2622,19 @@ static int midi_setup_patch(struct _mdi *mdi, uint8_t channel, uint8_t patch) {
 static int midi_setup_channel_pressure(struct _mdi *mdi, uint8_t channel,
                                        uint8_t pressure) {
     MIDI_EVENT_DEBUG(__FUNCTION__,channel, pressure);
-    _WM_CheckEventMemoryPool(mdi);
-    mdi->events[mdi->event_count].evtype = ev_channel_pressure;
-    mdi->events[mdi->event_count].do_event = _WM_do_channel_pressure;
-    mdi->events[mdi->event_count].event_data.channel = channel;
-    mdi->events[mdi->event_count].event_data.data.value = pressure;
-    mdi->events[mdi->event_count].samples_to_next = 0;
-    mdi->event_count++;
-    return (0);
+    return (WM_AddEvent(mdi, ev_channel_pressure, channel, pressure));
 }
 
 static int midi_setup_pitch(struct _mdi *mdi, uint8_t channel, uint16_t pitch) {
     MIDI_EVENT_DEBUG(__FUNCTION__,channel, pitch);
-    _WM_CheckEventMemoryPool(mdi);
-    mdi->events[mdi->event_count].evtype = ev_pitch;
-    mdi->events[mdi->event_count].do_event = _WM_do_pitch;
-    mdi->events[mdi->event_count].event_data.channel = channel;
-    mdi->events[mdi->event_count].event_data.data.value = pitch;
-    mdi->events[mdi->event_count].samples_to_next = 0;
-    mdi->event_count++;
-    return (0);
+    return (WM_AddEvent(mdi, ev_pitch, channel, pitch));
 }
 
 static int midi_setup_sysex_roland_drum_track(struct _mdi *mdi,
                                               uint8_t channel, uint16_t setting) {
     MIDI_EVENT_DEBUG(__FUNCTION__,channel, setting);
-    _WM_CheckEventMemoryPool(mdi);
-    mdi->events[mdi->event_count].evtype = ev_sysex_roland_drum_track;
-    mdi->events[mdi->event_count].do_event = _WM_do_sysex_roland_drum_track;
-    mdi->events[mdi->event_count].event_data.channel = channel;
-    mdi->events[mdi->event_count].event_data.data.value = setting;
-    mdi->events[mdi->event_count].samples_to_next = 0;
-    mdi->event_count++;
+    if (WM_AddEvent(mdi, ev_sysex_roland_drum_track, channel, setting) == -1)
+        return (-1);
 
     if (setting > 0) {
         mdi->channel[channel].isdrum = 1;
@@ -1679,134 +2647,57 @@ static int midi_setup_sysex_roland_drum_track(struct _mdi *mdi,
 static int midi_setup_sysex_gm_reset(struct _mdi *mdi) {
     MIDI_EVENT_DEBUG(__FUNCTION__,0,0);
 
-    _WM_CheckEventMemoryPool(mdi);
-    mdi->events[mdi->event_count].evtype = ev_sysex_roland_reset;
-    mdi->events[mdi->event_count].do_event = _WM_do_sysex_roland_reset;
-    mdi->events[mdi->event_count].event_data.channel = 0;
-    mdi->events[mdi->event_count].event_data.data.value = 0;
-    mdi->events[mdi->event_count].samples_to_next = 0;
-    mdi->event_count++;
-    return (0);
+    return (WM_AddEvent(mdi, ev_sysex_roland_reset, 0, 0));
 }
 
 static int midi_setup_sysex_roland_reset(struct _mdi *mdi) {
     MIDI_EVENT_DEBUG(__FUNCTION__,0,0);
-    _WM_CheckEventMemoryPool(mdi);
-    mdi->events[mdi->event_count].evtype = ev_sysex_roland_reset;
-    mdi->events[mdi->event_count].do_event = _WM_do_sysex_roland_reset;
-    mdi->events[mdi->event_count].event_data.channel = 0;
-    mdi->events[mdi->event_count].event_data.data.value = 0;
-    mdi->events[mdi->event_count].samples_to_next = 0;
-    mdi->event_count++;
-    return (0);
+    return (WM_AddEvent(mdi, ev_sysex_roland_reset, 0, 0));
 }
 
 static int midi_setup_sysex_yamaha_reset(struct _mdi *mdi) {
     MIDI_EVENT_DEBUG(__FUNCTION__,0,0);
-    _WM_CheckEventMemoryPool(mdi);
-    mdi->events[mdi->event_count].evtype = ev_sysex_roland_reset;
-    mdi->events[mdi->event_count].do_event = _WM_do_sysex_roland_reset;
-    mdi->events[mdi->event_count].event_data.channel = 0;
-    mdi->events[mdi->event_count].event_data.data.value = 0;
-    mdi->events[mdi->event_count].samples_to_next = 0;
-    mdi->event_count++;
-    return (0);
+    return (WM_AddEvent(mdi, ev_sysex_roland_reset, 0, 0));
 }
 
 int _WM_midi_setup_endoftrack(struct _mdi *mdi) {
     MIDI_EVENT_DEBUG(__FUNCTION__,0,0);
-    _WM_CheckEventMemoryPool(mdi);
-    mdi->events[mdi->event_count].evtype = ev_meta_endoftrack;
-    mdi->events[mdi->event_count].do_event = _WM_do_meta_endoftrack;
-    mdi->events[mdi->event_count].event_data.channel = 0;
-    mdi->events[mdi->event_count].event_data.data.value = 0;
-    mdi->events[mdi->event_count].samples_to_next = 0;
-    mdi->event_count++;
-    return (0);
+    return (WM_AddEvent(mdi, ev_meta_endoftrack, 0, 0));
 }
 
 int _WM_midi_setup_tempo(struct _mdi *mdi, uint32_t setting) {
     MIDI_EVENT_DEBUG(__FUNCTION__,0,setting);
-    _WM_CheckEventMemoryPool(mdi);
-    mdi->events[mdi->event_count].evtype = ev_meta_tempo;
-    mdi->events[mdi->event_count].do_event = _WM_do_meta_tempo;
-    mdi->events[mdi->event_count].event_data.channel = 0;
-    mdi->events[mdi->event_count].event_data.data.value = setting;
-    mdi->events[mdi->event_count].samples_to_next = 0;
-    mdi->event_count++;
-    return (0);
+    return (WM_AddEvent(mdi, ev_meta_tempo, 0, setting));
 }
 
 static int midi_setup_timesignature(struct _mdi *mdi, uint32_t setting) {
     MIDI_EVENT_DEBUG(__FUNCTION__,0, setting);
-    _WM_CheckEventMemoryPool(mdi);
-    mdi->events[mdi->event_count].evtype = ev_meta_timesignature;
-    mdi->events[mdi->event_count].do_event = _WM_do_meta_timesignature;
-    mdi->events[mdi->event_count].event_data.channel = 0;
-    mdi->events[mdi->event_count].event_data.data.value = setting;
-    mdi->events[mdi->event_count].samples_to_next = 0;
-    mdi->event_count++;
-    return (0);
+    return (WM_AddEvent(mdi, ev_meta_timesignature, 0, setting));
 }
 
 static int midi_setup_keysignature(struct _mdi *mdi, uint32_t setting) {
     MIDI_EVENT_DEBUG(__FUNCTION__,0, setting);
-    _WM_CheckEventMemoryPool(mdi);
-    mdi->events[mdi->event_count].evtype = ev_meta_keysignature;
-    mdi->events[mdi->event_count].do_event = _WM_do_meta_keysignature;
-    mdi->events[mdi->event_count].event_data.channel = 0;
-    mdi->events[mdi->event_count].event_data.data.value = setting;
-    mdi->events[mdi->event_count].samples_to_next = 0;
-    mdi->event_count++;
-    return (0);
+    return (WM_AddEvent(mdi, ev_meta_keysignature, 0, setting));
 }
 
 static int midi_setup_sequenceno(struct _mdi *mdi, uint32_t setting) {
     MIDI_EVENT_DEBUG(__FUNCTION__,0, setting);
-    _WM_CheckEventMemoryPool(mdi);
-    mdi->events[mdi->event_count].evtype = ev_meta_sequenceno;
-    mdi->events[mdi->event_count].do_event = _WM_do_meta_sequenceno;
-    mdi->events[mdi->event_count].event_data.channel = 0;
-    mdi->events[mdi->event_count].event_data.data.value = setting;
-    mdi->events[mdi->event_count].samples_to_next = 0;
-    mdi->event_count++;
-    return (0);
+    return (WM_AddEvent(mdi, ev_meta_sequenceno, 0, setting));
 }
 
 static int midi_setup_channelprefix(struct _mdi *mdi, uint32_t setting) {
     MIDI_EVENT_DEBUG(__FUNCTION__,0, setting);
-    _WM_CheckEventMemoryPool(mdi);
-    mdi->events[mdi->event_count].evtype = ev_meta_channelprefix;
-    mdi->events[mdi->event_count].do_event = _WM_do_meta_channelprefix;
-    mdi->events[mdi->event_count].event_data.channel = 0;
-    mdi->events[mdi->event_count].event_data.data.value = setting;
-    mdi->events[mdi->event_count].samples_to_next = 0;
-    mdi->event_count++;
-    return (0);
+    return (WM_AddEvent(mdi, ev_meta_channelprefix, 0, setting));
 }
 
 static int midi_setup_portprefix(struct _mdi *mdi, uint32_t setting) {
     MIDI_EVENT_DEBUG(__FUNCTION__,0, setting);
-    _WM_CheckEventMemoryPool(mdi);
-    mdi->events[mdi->event_count].evtype = ev_meta_portprefix;
-    mdi->events[mdi->event_count].do_event = _WM_do_meta_portprefix;
-    mdi->events[mdi->event_count].event_data.channel = 0;
-    mdi->events[mdi->event_count].event_data.data.value = setting;
-    mdi->events[mdi->event_count].samples_to_next = 0;
-    mdi->event_count++;
-    return (0);
+    return (WM_AddEvent(mdi, ev_meta_portprefix, 0, setting));
 }
 
 static int midi_setup_smpteoffset(struct _mdi *mdi, uint32_t setting) {
     MIDI_EVENT_DEBUG(__FUNCTION__,0, setting);
-    _WM_CheckEventMemoryPool(mdi);
-    mdi->events[mdi->event_count].evtype = ev_meta_smpteoffset;
-    mdi->events[mdi->event_count].do_event = _WM_do_meta_smpteoffset;
-    mdi->events[mdi->event_count].event_data.channel = 0;
-    mdi->events[mdi->event_count].event_data.data.value = setting;
-    mdi->events[mdi->event_count].samples_to_next = 0;
-    mdi->event_count++;
-    return (0);
+    return (WM_AddEvent(mdi, ev_meta_smpteoffset, 0, setting));
 }
 
 static void strip_text(char * text) {
@@ -1827,108 +2718,271 @@ static void strip_text(char * text) {
 static int midi_setup_text(struct _mdi *mdi, char * text) {
     MIDI_EVENT_SDEBUG(__FUNCTION__,0, text);
     strip_text(text);
-    _WM_CheckEventMemoryPool(mdi);
-    mdi->events[mdi->event_count].evtype = ev_meta_text;
-    mdi->events[mdi->event_count].do_event = _WM_do_meta_text;
-    mdi->events[mdi->event_count].event_data.channel = 0;
-    mdi->events[mdi->event_count].event_data.data.string = text;
-    mdi->events[mdi->event_count].samples_to_next = 0;
-    mdi->event_count++;
-    return (0);
+    return (WM_AddTextEvent(mdi, ev_meta_text, text));
 }
 
 static int midi_setup_copyright(struct _mdi *mdi, char * text) {
     MIDI_EVENT_SDEBUG(__FUNCTION__,0, text);
     strip_text(text);
-    _WM_CheckEventMemoryPool(mdi);
-    mdi->events[mdi->event_count].evtype = ev_meta_copyright;
-    mdi->events[mdi->event_count].do_event = _WM_do_meta_copyright;
-    mdi->events[mdi->event_count].event_data.channel = 0;
-    mdi->events[mdi->event_count].event_data.data.string = text;
-    mdi->events[mdi->event_count].samples_to_next = 0;
-    mdi->event_count++;
-    return (0);
+    return (WM_AddTextEvent(mdi, ev_meta_copyright, text));
 }
 
 static int midi_setup_trackname(struct _mdi *mdi, char * text) {
     MIDI_EVENT_SDEBUG(__FUNCTION__,0, text);
     strip_text(text);
-    _WM_CheckEventMemoryPool(mdi);
-    mdi->events[mdi->event_count].evtype = ev_meta_trackname;
-    mdi->events[mdi->event_count].do_event = _WM_do_meta_trackname;
-    mdi->events[mdi->event_count].event_data.channel = 0;
-    mdi->events[mdi->event_count].event_data.data.string = text;
-    mdi->events[mdi->event_count].samples_to_next = 0;
-    mdi->event_count++;
-    return (0);
+    return (WM_AddTextEvent(mdi, ev_meta_trackname, text));
 }
 
 static int midi_setup_instrumentname(struct _mdi *mdi, char * text) {
     MIDI_EVENT_SDEBUG(__FUNCTION__,0, text);
     strip_text(text);
-    _WM_CheckEventMemoryPool(mdi);
-    mdi->events[mdi->event_count].evtype = ev_meta_instrumentname;
-    mdi->events[mdi->event_count].do_event = _WM_do_meta_instrumentname;
-    mdi->events[mdi->event_count].event_data.channel = 0;
-    mdi->events[mdi->event_count].event_data.data.string = text;
-    mdi->events[mdi->event_count].samples_to_next = 0;
-    mdi->event_count++;
-    return (0);
+    return (WM_AddTextEvent(mdi, ev_meta_instrumentname, text));
 }
 
 static int midi_setup_lyric(struct _mdi *mdi, char * text) {
     MIDI_EVENT_SDEBUG(__FUNCTION__,0, text);
     strip_text(text);
-    _WM_CheckEventMemoryPool(mdi);
-    mdi->events[mdi->event_count].evtype = ev_meta_lyric;
-    mdi->events[mdi->event_count].do_event = _WM_do_meta_lyric;
-    mdi->events[mdi->event_count].event_data.channel = 0;
-    mdi->events[mdi->event_count].event_data.data.string = text;
-    mdi->events[mdi->event_count].samples_to_next = 0;
-    mdi->event_count++;
-    return (0);
+    return (WM_AddTextEvent(mdi, ev_meta_lyric, text));
 }
 
 static int midi_setup_marker(struct _mdi *mdi, char * text) {
     MIDI_EVENT_SDEBUG(__FUNCTION__,0, text);
     strip_text(text);
-    _WM_CheckEventMemoryPool(mdi);
-    mdi->events[mdi->event_count].evtype = ev_meta_marker;
-    mdi->events[mdi->event_count].do_event = _WM_do_meta_marker;
-    mdi->events[mdi->event_count].event_data.channel = 0;
-    mdi->events[mdi->event_count].event_data.data.string = text;
-    mdi->events[mdi->event_count].samples_to_next = 0;
-    mdi->event_count++;
-    return (0);
+    return (WM_AddTextEvent(mdi, ev_meta_marker, text));
 }
 
 static int midi_setup_cuepoint(struct _mdi *mdi, char * text) {
     MIDI_EVENT_SDEBUG(__FUNCTION__,0, text);
     strip_text(text);
-    _WM_CheckEventMemoryPool(mdi);
-    mdi->events[mdi->event_count].evtype = ev_meta_cuepoint;
-    mdi->events[mdi->event_count].do_event = _WM_do_meta_cuepoint;
-    mdi->events[mdi->event_count].event_data.channel = 0;
-    mdi->events[mdi->event_count].event_data.data.string = text;
-    mdi->events[mdi->event_count].samples_to_next = 0;
-    mdi->event_count++;
-    return (0);
+    return (WM_AddTextEvent(mdi, ev_meta_cuepoint, text));
+}
+
+/*
+ * Empty the event list. The strings of the text events of a streamed song
+ * are freed, but keep, which the caller holds on to, those of any other
+ * song stay in its arena until it is closed.
+ */
+void _WM_DropEvents(struct _mdi *mdi, const char *keep) {
+    char *text;
+    uint32_t i;
+
+    /* the text events of a probe have no text, see WM_AddTextEvent() */
+    for (i = 0; (i < mdi->event_count) && (mdi->stream != NULL) && (!mdi->ctx->probe); i++) {
+        /* Free up the string event storage */
+        switch (mdi->events[i].evtype) {
+        case ev_meta_text:
+        case ev_meta_copyright:
+        case ev_meta_trackname:
+        case ev_meta_instrumentname:
+        case ev_meta_lyric:
+        case ev_meta_marker:
+        case ev_meta_cuepoint:
+            text = mdi->event_ext[WM_EVENT_EXT_INDEX(&mdi->events[i])].string;
+            if (text != keep) {
+                free(text);
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    mdi->event_count = 0;
+    mdi->event_ext_count = 0;
+    mdi->current_event = mdi->events;
+}
+
+/*
+ * The song arena, see struct _song_block. Carved out memory is zeroed and
+ * aligned for anything a song keeps, it all goes in _WM_freeMDI().
+ */
+#define WM_ARENA_ALIGN 8
+#define WM_ARENA_ROUND(x) (((x) + (WM_ARENA_ALIGN - 1)) & ~(uint32_t)(WM_ARENA_ALIGN - 1))
+#define WM_ARENA_HEAD WM_ARENA_ROUND(sizeof(struct _song_block))
+#define WM_ARENA_FIRST 16384    /* what most songs need */
+#define WM_ARENA_MAX 262144     /* blocks double in size up to this */
+#define WM_ARENA_FIRST_BLOCK(mdi) \
+    ((struct _song_block *) ((uint8_t *) (mdi) + WM_ARENA_ROUND(sizeof(struct _mdi))))
+
+void *_WM_SongAlloc(struct _mdi *mdi, uint32_t size) {
+    struct _song_block *block = mdi->arena;
+    struct _song_block *grown;
+    uint32_t grow;
+    uint8_t *ptr;
+
+    size = WM_ARENA_ROUND(size);
+    if ((block->size - block->used) < size) {
+        grow = block->size * 2;
+        if (grow < WM_ARENA_FIRST) {
+            grow = WM_ARENA_FIRST;
+        } else if (grow > WM_ARENA_MAX) {
+            grow = WM_ARENA_MAX;
+        }
+        if (size > (grow / 4)) {
+            /* big enough to get a block of its own, what is left of
+               the block being carved up still gets used */
+            grown = (struct _song_block *) calloc(1, WM_ARENA_HEAD + size);
+            if (grown == NULL) {
+                _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
+                return (NULL);
+            }
+            grown->size = size;
+            grown->used = size;
+            grown->next = block->next;
+            block->next = grown;
+            return ((uint8_t *) grown + WM_ARENA_HEAD);
+        }
+        grown = (struct _song_block *) calloc(1, WM_ARENA_HEAD + grow);
+        if (grown == NULL) {
+            _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
+            return (NULL);
+        }
+        grown->size = grow;
+        grown->next = block;
+        mdi->arena = block = grown;
+    }
+    ptr = (uint8_t *) block + WM_ARENA_HEAD + block->used;
+    block->used += size;
+    return (ptr);
+}
+
+#ifdef WILDMIDI_TRACE
+#if defined(HAVE___ATOMIC_BUILTINS)
+#define trace_load(p)       __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define trace_store(p,v)    __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#else
+#define trace_load(p)       (*(volatile uint32_t *)(p))
+#define trace_store(p,v)    (*(volatile uint32_t *)(p) = (v))
+#endif
+
+/* a trace calling callback, with a ring of size events rounded up to a
+   power of two, or none for 0; NULL without memory for it */
+struct _trace *
+_WM_NewTrace(uint32_t size, void (*callback)(void *user, const struct _WM_TraceEvent *event), void *user) {
+    struct _trace *trace;
+    uint32_t events = 0;
+
+    if (size != 0) {
+        if (size > 0x01000000) {
+            size = 0x01000000;
+        }
+        events = 1;
+        while (events < size) {
+            events <<= 1;
+        }
+    }
+
+    /* the ring follows the struct */
+    trace = (struct _trace *) calloc(1, sizeof(struct _trace) + (events * sizeof(struct _WM_TraceEvent)));
+    if (trace == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, "(for the trace)", errno);
+        return (NULL);
+    }
+    trace->callback = callback;
+    trace->user = user;
+    if (events != 0) {
+        trace->ring = (struct _WM_TraceEvent *) (trace + 1);
+        trace->mask = events - 1;
+    }
+    return (trace);
+}
+
+/* events that find the ring full are dropped, not waited on */
+void _WM_TracePut(struct _trace *trace, const struct _WM_TraceEvent *event) {
+    uint32_t head = trace->head;
+
+    if (trace->callback) {
+        trace->callback(trace->user, event);
+    }
+    if ((trace->ring) && ((head - trace_load(&trace->tail)) <= trace->mask)) {
+        trace->ring[head & trace->mask] = *event;
+        trace_store(&trace->head, head + 1);
+    }
+}
+
+void _WM_Trace(struct _mdi *mdi, uint8_t type, uint8_t phase, uint8_t channel, uint32_t arg) {
+    struct _WM_TraceEvent event;
+
+    event.time = _WM_Clock();
+    event.arg = arg;
+    event.type = type;
+    event.phase = phase;
+    event.channel = channel;
+    event.thread = 0;
+    _WM_TracePut(mdi->trace, &event);
+}
+
+uint32_t _WM_ReadTrace(struct _trace *trace, struct _WM_TraceEvent *events, uint32_t count) {
+    uint32_t tail = trace->tail;
+    uint32_t head = trace_load(&trace->head);
+    uint32_t done = 0;
+
+    while ((tail != head) && (done < count)) {
+        events[done++] = trace->ring[tail & trace->mask];
+        tail++;
+    }
+    trace_store(&trace->tail, tail);
+    return (done);
+}
+
+/* as the context says handles opened from now on are to be traced */
+static struct _trace *WM_ContextTrace(struct _context *ctx) {
+    struct _trace *trace = NULL;
+
+    _WM_Lock(&ctx->lock);
+    if ((ctx->trace_size != 0) || (ctx->trace_callback != NULL)) {
+        trace = _WM_NewTrace(ctx->trace_size, ctx->trace_callback, ctx->trace_user);
+    }
+    _WM_Unlock(&ctx->lock);
+    return (trace);
+}
+#endif /* WILDMIDI_TRACE */
+
+static struct _mdi *WM_AllocMDI(struct _context *ctx) {
+    struct _mdi *mdi;
+    uint32_t first = (ctx->probe) ? 0 : WM_ARENA_FIRST;
+
+    /* zeroed pages, a probe never touches most of it, nor has an arena
+       to speak of as it keeps none of the text */
+    mdi = (struct _mdi *) calloc(1, WM_ARENA_ROUND(sizeof(struct _mdi)) + WM_ARENA_HEAD + first);
+    if (mdi == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
+        return (NULL);
+    }
+    mdi->arena = WM_ARENA_FIRST_BLOCK(mdi);
+    mdi->arena->size = first;
+    mdi->ctx = ctx;
+#ifdef WILDMIDI_TRACE
+    if (!ctx->probe) {
+        /* without the memory for it the handle goes untraced */
+        mdi->trace = WM_ContextTrace(ctx);
+    }
+#endif
+    return (mdi);
 }
 
 struct _mdi *
-_WM_initMDI(void) {
+_WM_initMDI(struct _context *ctx) {
     struct _mdi *mdi;
 
-    mdi = (struct _mdi *) malloc(sizeof(struct _mdi));
-    memset(mdi, 0, (sizeof(struct _mdi)));
+    if ((mdi = WM_AllocMDI(ctx)) == NULL) {
+        return (NULL);
+    }
 
+    mdi->patch_set = _WM_CurrentPatchSet(ctx);
     mdi->extra_info.copyright = NULL;
-    mdi->extra_info.mixer_options = _WM_MixerOptions;
+    mdi->extra_info.mixer_options = ctx->mixer_options;
+    _WM_PickMixer(mdi);
 
     _WM_load_patch(mdi, 0x0000);
 
-    mdi->events_size = MEM_CHUNK;
+    /* a probe only ever holds the last event, see WM_AddEvent() */
+    mdi->events_size = (ctx->probe) ? 4 : MEM_CHUNK;
     mdi->events = (struct _event *) malloc(mdi->events_size * sizeof(struct _event));
+    if (mdi->events == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
+        _WM_freeMDI(mdi);
+        return (NULL);
+    }
     mdi->event_count = 0;
     mdi->current_event = mdi->events;
 
@@ -1951,55 +3005,107 @@ _WM_initMDI(void) {
     return (mdi);
 }
 
+/*
+ * A handle that plays the events of a song parsed once, see
+ * WildMidi_Instantiate(). Its place in the song, its channels, notes and
+ * reverb are its own, the events and the info are those of song->mdi,
+ * which never plays and never changes once parsed. The patches are held
+ * again, live input may add to them.
+ */
+struct _mdi *
+_WM_ShareMDI(struct _song *song) {
+    struct _mdi *parsed = song->mdi;
+    struct _mdi *mdi;
+    uint32_t i;
+
+    if ((mdi = WM_AllocMDI(parsed->ctx)) == NULL) {
+        return (NULL);
+    }
+    mdi->song = song;
+    /* the patches the song was parsed with, whatever ctx has now */
+    mdi->patch_set = parsed->patch_set;
+    _WM_HoldPatchSet(mdi->patch_set);
+    mdi->events = parsed->events;
+    mdi->event_count = parsed->event_count;
+    mdi->event_ext = parsed->event_ext;
+    mdi->event_ext_count = parsed->event_ext_count;
+
+    if (parsed->patch_count != 0) {
+        mdi->patches = (struct _patch **) malloc(sizeof(struct _patch *) * parsed->patch_count);
+        if (mdi->patches == NULL) {
+            _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
+            _WM_freeMDI(mdi);
+            return (NULL);
+        }
+        _WM_Lock(&mdi->patch_set->lock);
+        for (i = 0; i < parsed->patch_count; i++) {
+            mdi->patches[i] = parsed->patches[i];
+            mdi->patches[i]->inuse_count++;
+        }
+        _WM_Unlock(&mdi->patch_set->lock);
+        mdi->patch_count = parsed->patch_count;
+    }
+
+    mdi->is_type2 = parsed->is_type2;
+    mdi->extra_info = parsed->extra_info;
+    _WM_PickMixer(mdi);
+
+    mdi->dyn_vol = 1.0;
+    mdi->dyn_vol_to_reach = 1.0;
+
+    _WM_ResetToStart(mdi);
+    return (mdi);
+}
+
 void _WM_freeMDI(struct _mdi *mdi) {
-    struct _sample *tmp_sample;
+    struct _song_block *block;
     uint32_t i;
 
     if (mdi->patch_count != 0) {
-        _WM_Lock(&_WM_patch_lock);
+        _WM_Lock(&mdi->patch_set->lock);
         for (i = 0; i < mdi->patch_count; i++) {
-            mdi->patches[i]->inuse_count--;
-            if (mdi->patches[i]->inuse_count == 0) {
-                /* free samples here */
-                while (mdi->patches[i]->first_sample) {
-                    tmp_sample = mdi->patches[i]->first_sample->next;
-                    free(mdi->patches[i]->first_sample->data);
-                    free(mdi->patches[i]->first_sample);
-                    mdi->patches[i]->first_sample = tmp_sample;
-                }
-                mdi->patches[i]->loaded = 0;
-            }
-        }
-        _WM_Unlock(&_WM_patch_lock);
-        free(mdi->patches);
-    }
-
-    if (mdi->event_count != 0) {
-        for (i = 0; i < mdi->event_count; i++) {
-            /* Free up the string event storage */
-            switch (mdi->events[i].evtype) {
-            case ev_meta_text:
-            case ev_meta_copyright:
-            case ev_meta_trackname:
-            case ev_meta_instrumentname:
-            case ev_meta_lyric:
-            case ev_meta_marker:
-            case ev_meta_cuepoint:
-                free(mdi->events[i].event_data.data.string);
-                break;
-            default:
-                break;
-            }
+            _WM_unuse_patch(mdi->patch_set, mdi->patches[i]);
         }
+        _WM_Unlock(&mdi->patch_set->lock);
+    }
+    free(mdi->patches);
+
+    /* what a handle of a shared song reads from the song instead, which
+       the caller lets go of after this, see _WM_ShareMDI() */
+    if (mdi->song == NULL) {
+        /* while the texts of a streamed song are still known to be its own */
+        _WM_DropEvents(mdi, NULL);
+        _WM_FreeStream(mdi);
+        free(mdi->events);
+        free(mdi->event_ext);
+        free(mdi->extra_info.copyright);
     }
 
-    free(mdi->events);
+    free(mdi->voice);
     _WM_free_reverb(mdi->reverb);
+    _WM_free_resample(mdi->resample);
     free(mdi->mix_buffer);
+    _WM_PoolFree(mdi->pool);
+    free(mdi->pool_buffer);
+    free(mdi->stem_buffer);
+    _WM_FreeSeekIndex(mdi);
+    free(mdi->song_start);
     if (mdi->tmp_info) {
         free(mdi->tmp_info->copyright);
         free(mdi->tmp_info);
     }
+
+    /* the patch map, the notes and the text of the events, but for the
+       block that came with the _mdi */
+    while (mdi->arena != NULL) {
+        block = mdi->arena;
+        mdi->arena = block->next;
+        if (block != WM_ARENA_FIRST_BLOCK(mdi)) {
+            free(block);
+        }
+    }
+    _WM_PutPatchSet(mdi->patch_set);
+    free(mdi->trace);
     free(mdi);
 }
 
@@ -2117,9 +3223,8 @@ uint32_t _WM_SetupMidiEvent(struct _mdi *mdi, const uint8_t * event_data, uint32
                     if (--input_length < tmp_length) goto shortbuf;
                     if (!tmp_length) break;/* broken file? */
 
-                    text = (char *) malloc(tmp_length + 1);
-                    memcpy(text, event_data, tmp_length);
-                    text[tmp_length] = '\0';
+                    if ((text = WM_CopyText(mdi, event_data, tmp_length)) == NULL)
+                        return 0;
                     midi_setup_text(mdi, text);
 
                     ret_cnt += tmp_length;
@@ -2157,10 +3262,9 @@ uint32_t _WM_SetupMidiEvent(struct _mdi *mdi, const uint8_t * event_data, uint32
                         mdi->extra_info.copyright[tmp_length] = '\0';
                     }
 
-                    /* NOTE: free'd when events are cleared during closure of mdi */
-                    text = (char *) malloc(tmp_length + 1);
-                    memcpy(text, event_data, tmp_length);
-                    text[tmp_length] = '\0';
+                    /* NOTE: kept until the mdi is closed, see WM_CopyText() */
+                    if ((text = WM_CopyText(mdi, event_data, tmp_length)) == NULL)
+                        return 0;
                     midi_setup_copyright(mdi, text);
 
                     ret_cnt += tmp_length;
@@ -2186,9 +3290,8 @@ uint32_t _WM_SetupMidiEvent(struct _mdi *mdi, const uint8_t * event_data, uint32
                     if (--input_length < tmp_length) goto shortbuf;
                     if (!tmp_length) break;/* broken file? */
 
-                    text = (char *) malloc(tmp_length + 1);
-                    memcpy(text, event_data, tmp_length);
-                    text[tmp_length] = '\0';
+                    if ((text = WM_CopyText(mdi, event_data, tmp_length)) == NULL)
+                        return 0;
                     midi_setup_trackname(mdi, text);
 
                     ret_cnt += tmp_length;
@@ -2214,9 +3317,8 @@ uint32_t _WM_SetupMidiEvent(struct _mdi *mdi, const uint8_t * event_data, uint32
                     if (--input_length < tmp_length) goto shortbuf;
                     if (!tmp_length) break;/* broken file? */
 
-                    text = (char *) malloc(tmp_length + 1);
-                    memcpy(text, event_data, tmp_length);
-                    text[tmp_length] = '\0';
+                    if ((text = WM_CopyText(mdi, event_data, tmp_length)) == NULL)
+                        return 0;
                     midi_setup_instrumentname(mdi, text);
 
                     ret_cnt += tmp_length;
@@ -2242,9 +3344,8 @@ uint32_t _WM_SetupMidiEvent(struct _mdi *mdi, const uint8_t * event_data, uint32
                     if (--input_length < tmp_length) goto shortbuf;
                     if (!tmp_length) break;/* broken file? */
 
-                    text = (char *) malloc(tmp_length + 1);
-                    memcpy(text, event_data, tmp_length);
-                    text[tmp_length] = '\0';
+                    if ((text = WM_CopyText(mdi, event_data, tmp_length)) == NULL)
+                        return 0;
                     midi_setup_lyric(mdi, text);
 
                     ret_cnt += tmp_length;
@@ -2270,9 +3371,8 @@ uint32_t _WM_SetupMidiEvent(struct _mdi *mdi, const uint8_t * event_data, uint32
                     if (--input_length < tmp_length) goto shortbuf;
                     if (!tmp_length) break;/* broken file? */
 
-                    text = (char *) malloc(tmp_length + 1);
-                    memcpy(text, event_data, tmp_length);
-                    text[tmp_length] = '\0';
+                    if ((text = WM_CopyText(mdi, event_data, tmp_length)) == NULL)
+                        return 0;
                     midi_setup_marker(mdi, text);
 
                     ret_cnt += tmp_length;
@@ -2298,9 +3398,8 @@ uint32_t _WM_SetupMidiEvent(struct _mdi *mdi, const uint8_t * event_data, uint32
                     if (--input_length < tmp_length) goto shortbuf;
                     if (!tmp_length) break;/* broken file? */
 
-                    text = (char *) malloc(tmp_length + 1);
-                    memcpy(text, event_data, tmp_length);
-                    text[tmp_length] = '\0';
+                    if ((text = WM_CopyText(mdi, event_data, tmp_length)) == NULL)
+                        return 0;
                     midi_setup_cuepoint(mdi, text);
 
                     ret_cnt += tmp_length;
@@ -2346,11 +3445,6 @@ uint32_t _WM_SetupMidiEvent(struct _mdi *mdi, const uint8_t * event_data, uint32
                      */
                     midi_setup_smpteoffset(mdi, ((event_data[3] << 24) + (event_data[4] << 16) + (event_data[5] << 8) + event_data[6]));
 
-                    /*
-                     Because this has 5 bytes of data we gonna "hack" it a little
-                     */
-                    mdi->events[mdi->events_size - 1].event_data.channel = event_data[2];
-
                     ret_cnt += 7;
                 } else if ((event_data[0] == 0x58) && (event_data[1] == 0x04)) {
                     /*
@@ -2395,7 +3489,7 @@ uint32_t _WM_SetupMidiEvent(struct _mdi *mdi, const uint8_t * event_data, uint32
                  Sysex Events
                  */
                 uint32_t sysex_len = 0;
-                uint8_t *sysex_store = NULL;
+                const uint8_t *sysex_store;
 
                 if (*event_data > 0x7f) {
                     do {
@@ -2413,8 +3507,7 @@ uint32_t _WM_SetupMidiEvent(struct _mdi *mdi, const uint8_t * event_data, uint32
                 if (--input_length < sysex_len) goto shortbuf;
                 if (!sysex_len) break;/* broken file? */
 
-                sysex_store = (uint8_t *) malloc(sizeof(uint8_t) * sysex_len);
-                memcpy(sysex_store, event_data, sysex_len);
+                sysex_store = event_data;
 
                 if (sysex_store[sysex_len - 1] == 0xF7) {
                     uint8_t rolandsysexid[] = { 0x41, 0x10, 0x42, 0x12 };
@@ -2429,7 +3522,7 @@ uint32_t _WM_SetupMidiEvent(struct _mdi *mdi, const uint8_t * event_data, uint32
                                 sysex_cs -= 0x80;
                             }
                             sysex_ofs++;
-                        } while (sysex_store[sysex_ofs + 1] != 0xf7);
+                        } while (((sysex_ofs + 1) < sysex_len) && (sysex_store[sysex_ofs + 1] != 0xf7));
                         sysex_cs = 128 - sysex_cs;
                         /* is roland sysex message valid */
                         if (sysex_cs == sysex_store[sysex_ofs]) {
@@ -2464,8 +3557,6 @@ uint32_t _WM_SetupMidiEvent(struct _mdi *mdi, const uint8_t * event_data, uint32
                         }
                     }
                 }
-                free(sysex_store);
-                sysex_store = NULL;
                 /*
                 event_data += sysex_len;
                 */
@@ -40,10 +40,157 @@
 #else /* unixish ... */
 #define _GNU_SOURCE
 #include <unistd.h> /* usleep() */
+#include <sched.h>  /* sched_yield() */
+#if defined(HAVE_LINUX_FUTEX)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
 #endif
 
 #include "lock.h"
 
+#ifdef WILDMIDI_LOCK_STATS
+#include <string.h>
+#include "wildmidi_lib.h"
+#include "wm_thread.h"
+/* the function, the sites call _WM_LockAt() */
+#undef _WM_Lock
+#endif
+
+/*
+ * The lock is a plain int so it can keep living inside the structures it
+ * protects, zeroed along with them: 0 is unlocked, 1 locked and, where we
+ * can block in the kernel, 2 locked with other threads waiting on it.
+ *
+ * Taking a contended lock first spins for a little while, the library
+ * only ever holds its locks for short stretches so the lock usually comes
+ * free before it is worth going to sleep. How long to spin adapts to how
+ * long it took the last few times.
+ */
+#if defined(_WIN32)
+#define WM_ATOMIC_LOCK 1
+#define lock_cas(p,o,n)     (InterlockedCompareExchange((LONG volatile *)(p), (n), (o)) == (o))
+#define lock_xchg(p,v)      ((int) InterlockedExchange((LONG volatile *)(p), (v)))
+#define lock_load(p)        (*(volatile int *)(p))
+#elif defined(HAVE___ATOMIC_BUILTINS)
+#define WM_ATOMIC_LOCK 1
+static inline int lock_cas(int *p, int o, int n) {
+    return (__atomic_compare_exchange_n(p, &o, n, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED));
+}
+#define lock_xchg(p,v)      __atomic_exchange_n((p), (v), __ATOMIC_ACQ_REL)
+#define lock_load(p)        __atomic_load_n((p), __ATOMIC_RELAXED)
+#endif
+
+#ifdef WM_ATOMIC_LOCK
+
+#if defined(_MSC_VER)
+#define cpu_relax() YieldProcessor()
+#elif defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#define cpu_relax() __builtin_ia32_pause()
+#elif defined(__GNUC__) && (defined(__aarch64__) || (defined(__arm__) && (__ARM_ARCH >= 7)))
+#define cpu_relax() __asm__ __volatile__("yield" ::: "memory")
+#else
+#define cpu_relax() do {} while (0)
+#endif
+
+#define LOCK_MIN_SPIN 16
+#define LOCK_MAX_SPIN 1000
+
+/* only a hint shared by all locks, racing on it does no harm */
+static int lock_spin = LOCK_MIN_SPIN * 4;
+
+static int lock_spin_get(void) {
+#if defined(HAVE___ATOMIC_BUILTINS) && !defined(_WIN32)
+    return (__atomic_load_n(&lock_spin, __ATOMIC_RELAXED));
+#else
+    return (*(volatile int *)&lock_spin);
+#endif
+}
+
+static void lock_spin_set(int spin) {
+#if defined(HAVE___ATOMIC_BUILTINS) && !defined(_WIN32)
+    __atomic_store_n(&lock_spin, spin, __ATOMIC_RELAXED);
+#else
+    *(volatile int *)&lock_spin = spin;
+#endif
+}
+
+/* spin while the lock is held, returns nonzero if we got it */
+static int lock_spin_acquire(int *wmlock) {
+    int limit = lock_spin_get() * 2;
+    int spins;
+
+    if (limit > LOCK_MAX_SPIN)
+        limit = LOCK_MAX_SPIN;
+
+    for (spins = 0; spins < limit; spins++) {
+        cpu_relax();
+        if ((lock_load(wmlock) == 0) && lock_cas(wmlock, 0, 1)) {
+            /* move the estimate an eighth toward what it took */
+            spins = lock_spin_get() + (spins - lock_spin_get()) / 8;
+            lock_spin_set((spins < LOCK_MIN_SPIN) ? LOCK_MIN_SPIN : spins);
+            return (1);
+        }
+    }
+
+    /* spinning didn't pay off, spin less next time */
+    spins = lock_spin_get() - (lock_spin_get() / 8);
+    lock_spin_set((spins < LOCK_MIN_SPIN) ? LOCK_MIN_SPIN : spins);
+    return (0);
+}
+
+#if defined(HAVE_LINUX_FUTEX)
+static void lock_wait(int *wmlock) {
+    syscall(SYS_futex, wmlock, FUTEX_WAIT_PRIVATE, 2, NULL, NULL, 0);
+}
+
+static void lock_wake(int *wmlock) {
+    syscall(SYS_futex, wmlock, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+}
+#else
+/* no way to sleep on the lock itself, back off from yielding to sleeping */
+static void lock_backoff(int tries) {
+#ifdef _WIN32
+    Sleep((tries < 16) ? 0 : 1);
+#elif defined(__OS2__) || defined(__EMX__)
+    DosSleep((tries < 16) ? 0 : 1);
+#elif defined(WILDMIDI_AMIGA)
+    (void) tries;
+    Delay(1);
+#elif defined(__vita__)
+    sceKernelDelayThread((tries < 16) ? 0 : 100);
+#elif defined(__SWITCH__)
+    svcSleepThread((tries < 16) ? 0 : 100 * 1000);
+#else
+    if (tries < 16)
+        sched_yield();
+    else
+        usleep(100);
+#endif
+}
+#endif
+
+/* the lock was held when we came for it */
+static void lock_contended(int *wmlock) {
+    if (lock_spin_acquire(wmlock)) {
+        return;
+    }
+#if defined(HAVE_LINUX_FUTEX)
+    /* mark the lock contended so the unlock wakes us */
+    while (lock_xchg(wmlock, 2) != 0) {
+        lock_wait(wmlock);
+    }
+#else
+    {
+        int tries = 0;
+        while (!lock_cas(wmlock, 0, 1)) {
+            lock_backoff(tries++);
+        }
+    }
+#endif
+}
+#endif /* WM_ATOMIC_LOCK */
+
 /*
  _WM_Lock(wmlock)
 
@@ -56,6 +203,12 @@
  If lock fails the process retries until successful.
  */
 void _WM_Lock(int * wmlock) {
+#ifdef WM_ATOMIC_LOCK
+    if (__builtin_expect((lock_cas(wmlock, 0, 1)), 1)) {
+        return; /* Lock cleanly set */
+    }
+    lock_contended(wmlock);
+#else /* no atomic operations, best effort */
     LOCK_START:
     /* Check if lock is clear, if so set it */
     if (__builtin_expect(((*wmlock) == 0), 1)) {
@@ -68,9 +221,7 @@ void _WM_Lock(int * wmlock) {
         }
         (*wmlock)--;
     }
-#ifdef _WIN32
-    Sleep(10);
-#elif defined(__OS2__) || defined(__EMX__)
+#if defined(__OS2__) || defined(__EMX__)
     DosSleep(10);
 #elif defined(WILDMIDI_AMIGA)
     Delay(1);
@@ -82,6 +233,7 @@ void _WM_Lock(int * wmlock) {
     usleep(500);
 #endif
     goto LOCK_START;
+#endif /* WM_ATOMIC_LOCK */
 }
 
 /*
@@ -94,10 +246,151 @@ void _WM_Lock(int * wmlock) {
  Removes a lock previously placed on the MDI tree.
  */
 void _WM_Unlock(int *wmlock) {
+#ifdef WM_ATOMIC_LOCK
+    /* unlocking a lock that isn't set just leaves it clear */
+#if defined(HAVE_LINUX_FUTEX)
+    if (__builtin_expect((lock_xchg(wmlock, 0) == 2), 0)) {
+        lock_wake(wmlock);
+    }
+#else
+    lock_xchg(wmlock, 0);
+#endif
+#else
     /* We don't want a -1 lock, so just to make sure */
     if ((*wmlock) != 0) {
         (*wmlock)--;
     }
+#endif
+}
+
+#ifdef WILDMIDI_LOCK_STATS
+/*
+ * The counters of a site are shared by every lock it takes, so they are
+ * added to atomically where we can, and best effort elsewhere.
+ */
+#if defined(HAVE___ATOMIC_BUILTINS)
+#define stat_add(p,v)       __atomic_fetch_add((p), (v), __ATOMIC_RELAXED)
+#define stat_load(p)        __atomic_load_n((p), __ATOMIC_RELAXED)
+#define site_load(p)        __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define site_store(p,v)     __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#elif defined(_WIN32)
+#define stat_add(p,v)       InterlockedExchangeAdd64((LONGLONG volatile *)(p), (LONGLONG)(v))
+#define stat_load(p)        ((uint64_t) InterlockedCompareExchange64((LONGLONG volatile *)(p), 0, 0))
+#define site_load(p)        (*(volatile int *)(p))
+#define site_store(p,v)     (*(volatile int *)(p) = (v))
+#else
+#define stat_add(p,v)       (*(p) += (v))
+#define stat_load(p)        (*(volatile uint64_t *)(p))
+#define site_load(p)        (*(volatile int *)(p))
+#define site_store(p,v)     (*(volatile int *)(p) = (v))
+#endif
+
+/* every site taken so far, the list only ever grows */
+static struct _WM_LockSite *lock_sites = NULL;
+static int lock_sites_lock = 0;
+
+static void lock_register(struct _WM_LockSite *site) {
+    _WM_Lock(&lock_sites_lock);
+    if (!site->registered) {
+        site->next = lock_sites;
+        lock_sites = site;
+        site_store(&site->registered, 1);
+    }
+    _WM_Unlock(&lock_sites_lock);
+}
+
+static void lock_waited(struct _WM_LockSite *site, uint64_t start) {
+    uint64_t waited = _WM_Clock() - start;
+    uint64_t max_wait = stat_load(&site->max_wait_ns);
+
+    stat_add(&site->contended, 1);
+    stat_add(&site->wait_ns, waited);
+#if defined(HAVE___ATOMIC_BUILTINS)
+    while ((waited > max_wait) && !__atomic_compare_exchange_n(&site->max_wait_ns,
+                &max_wait, waited, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        continue;
+    }
+#else
+    if (waited > max_wait) {
+        site->max_wait_ns = waited;
+    }
+#endif
+}
+
+void _WM_LockAt(int *wmlock, struct _WM_LockSite *site) {
+    uint64_t start;
+
+    if (__builtin_expect((!site_load(&site->registered)), 0)) {
+        lock_register(site);
+    }
+    stat_add(&site->acquired, 1);
+
+#ifdef WM_ATOMIC_LOCK
+    if (__builtin_expect((lock_cas(wmlock, 0, 1)), 1)) {
+        return;
+    }
+    start = _WM_Clock();
+    lock_contended(wmlock);
+#else
+    /* only a hint, the lock may still be taken before we get to it */
+    if (__builtin_expect(((*(volatile int *)wmlock) == 0), 1)) {
+        _WM_Lock(wmlock);
+        return;
+    }
+    start = _WM_Clock();
+    _WM_Lock(wmlock);
+#endif
+    lock_waited(site, start);
+}
+
+/*
+ * Fills in stats for up to count of the locks, the sites of the same name
+ * added together, and returns how many locks there are in all.
+ */
+uint32_t _WM_GetLockStats(struct _WM_LockStats *stats, uint32_t count) {
+    struct _WM_LockSite *site, *same;
+    struct _WM_LockStats *lock;
+    uint32_t locks = 0;
+    uint64_t max_wait;
+
+    _WM_Lock(&lock_sites_lock);
+    for (site = lock_sites; site != NULL; site = site->next) {
+        /* only the first site of a name starts a lock */
+        for (same = lock_sites; same != site; same = same->next) {
+            if (strcmp(same->name, site->name) == 0) {
+                break;
+            }
+        }
+        if (same != site) {
+            continue;
+        }
+        if (locks < count) {
+            lock = &stats[locks];
+            lock->name = (site->name[0] == '&') ? (site->name + 1) : site->name;
+            lock->acquired = 0;
+            lock->contended = 0;
+            lock->wait_us = 0;
+            lock->max_wait_us = 0;
+            for (same = site; same != NULL; same = same->next) {
+                if (strcmp(same->name, site->name) != 0) {
+                    continue;
+                }
+                lock->acquired += stat_load(&same->acquired);
+                lock->contended += stat_load(&same->contended);
+                lock->wait_us += stat_load(&same->wait_ns);
+                max_wait = stat_load(&same->max_wait_ns);
+                if (max_wait > lock->max_wait_us) {
+                    lock->max_wait_us = max_wait;
+                }
+            }
+            lock->wait_us /= 1000;
+            lock->max_wait_us /= 1000;
+        }
+        locks++;
+    }
+    _WM_Unlock(&lock_sites_lock);
+    return (locks);
 }
+#endif /* WILDMIDI_LOCK_STATS */
 
 #endif /* !WM_NO_LOCK */
@@ -0,0 +1,511 @@
+/*
+ * mixer.c -- Midi Wavetable Processing library
+ *
+ * Copyright (C) WildMIDI Developers 2001-2016
+ *
+ * This file is part of WildMIDI.
+ *
+ * WildMIDI is free software: you can redistribute and/or modify the player
+ * under the terms of the GNU General Public License and you can redistribute
+ * and/or modify the library under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either version 3 of
+ * the licenses, or(at your option) any later version.
+ *
+ * WildMIDI is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License and
+ * the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License and the
+ * GNU Lesser General Public License along with WildMIDI.  If not,  see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#if defined(HAVE_SSE2_INTRINSICS)
+#include <emmintrin.h>
+#endif
+#if defined(HAVE_AVX2_INTRINSICS)
+#include <immintrin.h>
+#endif
+#if defined(HAVE_NEON_INTRINSICS)
+#include <arm_neon.h>
+#endif
+
+#include "common.h"
+#include "reverb.h"
+#include "sample.h"
+#include "wildmidi_lib.h"
+#include "internal_midi.h"
+#include "mixer.h"
+
+#if defined(__GNUC__) || defined(__clang__)
+#define WM_TARGET(x) __attribute__((target(x)))
+#else
+#define WM_TARGET(x)
+#endif
+
+/* Gauss Interpolation code adapted from code supplied by Eric. A. Welsh */
+#define MAX_GAUSS_ORDER 34          /* 34 is as high as we can go before errors crop up */
+#define GAUSS_HALF (MAX_GAUSS_ORDER >> 1)
+
+/*
+ * The table holds the MAX_GAUSS_ORDER + 1 taps for each of the (1<<FPBITS)
+ * sample fractions as Q14 integers, padded with zero taps to GAUSS_TAPS so
+ * the vector kernels can work on whole registers. Sample data has zeroed
+ * guard frames around it (see SAMPLE_GUARD), so the full window can be
+ * used right up to both ends of a sample. The table itself is generated
+ * by gen_gauss.c and compiled in as read only data.
+ */
+#define GAUSS_TAPS 40
+#define GAUSS_BITS 14
+#include "gauss_table.h"
+
+/*
+ * The vector kernels below must give exactly the same output as the plain
+ * C one, so every "/ 1024" of the original mixer is done as a shift with
+ * the rounding corrected towards zero for negative values.
+ */
+
+static void mix_linear_c(struct _note *nte, int32_t *buffer, uint32_t count) {
+    const int16_t *data = nte->sample->data;
+    uint32_t sample_pos = nte->sample_pos;
+    uint32_t sample_inc = nte->sample_inc;
+    int32_t env_level = nte->env_level;
+    int32_t env_inc = nte->env_inc;
+    int32_t left_vol = (int32_t)nte->left_mix_volume;
+    int32_t right_vol = (int32_t)nte->right_mix_volume;
+    uint32_t data_pos;
+    int32_t premix;
+
+    while (count--) {
+        data_pos = sample_pos >> FPBITS;
+        premix = ((data[data_pos] + (((data[data_pos + 1] - data[data_pos]) * (int32_t)(sample_pos & FPMASK)) / 1024)) * (env_level >> 12)) / 1024;
+
+        *buffer++ += (premix * left_vol) / 1024;
+        *buffer++ += (premix * right_vol) / 1024;
+
+        sample_pos += sample_inc;
+        env_level += env_inc;
+    }
+
+    nte->sample_pos = sample_pos;
+    nte->env_level = env_level;
+}
+
+/*
+ * All gauss kernels share this tail: round the Q14 dot product back to
+ * a sample value, then apply the envelope and the panned volumes exactly
+ * like the linear kernel does.
+ */
+#define GAUSS_MIX_FRAME(acc) \
+    premix = (((acc) + (1 << (GAUSS_BITS - 1))) >> GAUSS_BITS); \
+    premix = (premix * (env_level >> 12)) / 1024; \
+    *buffer++ += (premix * left_vol) / 1024; \
+    *buffer++ += (premix * right_vol) / 1024; \
+    sample_pos += sample_inc; \
+    env_level += env_inc
+
+static void mix_gauss_c(struct _note *nte, int32_t *buffer, uint32_t count) {
+    const int16_t *data = nte->sample->data - GAUSS_HALF;
+    uint32_t sample_pos = nte->sample_pos;
+    uint32_t sample_inc = nte->sample_inc;
+    int32_t env_level = nte->env_level;
+    int32_t env_inc = nte->env_inc;
+    int32_t left_vol = (int32_t)nte->left_mix_volume;
+    int32_t right_vol = (int32_t)nte->right_mix_volume;
+    const int16_t *sptr, *gptr;
+    int32_t acc, premix;
+    int i;
+
+    while (count--) {
+        sptr = data + (sample_pos >> FPBITS);
+        gptr = gauss_table[sample_pos & FPMASK];
+        acc = 0;
+        for (i = 0; i <= MAX_GAUSS_ORDER; i++) {
+            acc += sptr[i] * gptr[i];
+        }
+        GAUSS_MIX_FRAME(acc);
+    }
+
+    nte->sample_pos = sample_pos;
+    nte->env_level = env_level;
+}
+
+/*
+ * A note playing a ping pong loop backwards is interpolated from the
+ * sample above it down to the one below, which is how the loop the loader
+ * used to unroll forwards was played. The gauss kernels play backwards as
+ * they are: their window reaches past the ends of the loop, where the
+ * unrolled loop was mirrored, so they could not give the same output
+ * anyway. A note only plays backwards on the way back through a ping
+ * pong loop, so there is only a plain C version.
+ */
+static void mix_linear_reverse_c(struct _note *nte, int32_t *buffer, uint32_t count) {
+    const int16_t *data = nte->sample->data;
+    uint32_t sample_pos = nte->sample_pos;
+    uint32_t sample_inc = nte->sample_inc;
+    int32_t env_level = nte->env_level;
+    int32_t env_inc = nte->env_inc;
+    int32_t left_vol = (int32_t)nte->left_mix_volume;
+    int32_t right_vol = (int32_t)nte->right_mix_volume;
+    uint32_t data_pos;
+    int32_t premix;
+
+    while (count--) {
+        data_pos = (sample_pos + FPMASK) >> FPBITS;
+        premix = ((data[data_pos] + (((data[data_pos - 1] - data[data_pos]) * (int32_t)((data_pos << FPBITS) - sample_pos)) / 1024)) * (env_level >> 12)) / 1024;
+
+        *buffer++ += (premix * left_vol) / 1024;
+        *buffer++ += (premix * right_vol) / 1024;
+
+        sample_pos += sample_inc;
+        env_level += env_inc;
+    }
+
+    nte->sample_pos = sample_pos;
+    nte->env_level = env_level;
+}
+
+#if defined(HAVE_SSE2_INTRINSICS)
+
+WM_TARGET("sse2")
+static inline __m128i sse2_div1024(__m128i x) {
+    return (_mm_srai_epi32(_mm_add_epi32(x, _mm_and_si128(_mm_srai_epi32(x, 31), _mm_set1_epi32(1023))), 10));
+}
+
+/* sse2 has no 32bit low multiply, build one from the unsigned 32x32->64 one */
+WM_TARGET("sse2")
+static inline __m128i sse2_mullo(__m128i a, __m128i b) {
+    __m128i even = _mm_mul_epu32(a, b);
+    __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return (_mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                               _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0))));
+}
+
+WM_TARGET("sse2")
+static void mix_linear_sse2(struct _note *nte, int32_t *buffer, uint32_t count) {
+    const int16_t *data = nte->sample->data;
+    uint32_t sample_inc = nte->sample_inc;
+    int32_t env_inc = nte->env_inc;
+    __m128i pos, env, pos_step, env_step;
+    __m128i frac_mask, left_vol, right_vol;
+    __m128i idx, s0, s1, premix, left, right;
+#if defined(_MSC_VER)
+    __declspec(align(16)) uint32_t ofs[4];
+#else
+    uint32_t ofs[4] __attribute__((aligned(16)));
+#endif
+
+    if (count >= 4) {
+        pos = _mm_add_epi32(_mm_set1_epi32((int32_t)nte->sample_pos),
+                            _mm_set_epi32((int32_t)(sample_inc * 3), (int32_t)(sample_inc * 2), (int32_t)sample_inc, 0));
+        env = _mm_add_epi32(_mm_set1_epi32(nte->env_level),
+                            _mm_set_epi32(env_inc * 3, env_inc * 2, env_inc, 0));
+        pos_step = _mm_set1_epi32((int32_t)(sample_inc * 4));
+        env_step = _mm_set1_epi32(env_inc * 4);
+        frac_mask = _mm_set1_epi32(FPMASK);
+        left_vol = _mm_set1_epi32((int32_t)nte->left_mix_volume);
+        right_vol = _mm_set1_epi32((int32_t)nte->right_mix_volume);
+
+        do {
+            idx = _mm_srli_epi32(pos, FPBITS);
+            _mm_store_si128((__m128i *)ofs, idx);
+            s0 = _mm_set_epi32(data[ofs[3]], data[ofs[2]], data[ofs[1]], data[ofs[0]]);
+            s1 = _mm_set_epi32(data[ofs[3] + 1], data[ofs[2] + 1], data[ofs[1] + 1], data[ofs[0] + 1]);
+
+            premix = _mm_add_epi32(s0, sse2_div1024(sse2_mullo(_mm_sub_epi32(s1, s0), _mm_and_si128(pos, frac_mask))));
+            premix = sse2_div1024(sse2_mullo(premix, _mm_srai_epi32(env, 12)));
+            left = sse2_div1024(sse2_mullo(premix, left_vol));
+            right = sse2_div1024(sse2_mullo(premix, right_vol));
+
+            _mm_storeu_si128((__m128i *)buffer, _mm_add_epi32(_mm_loadu_si128((__m128i *)buffer), _mm_unpacklo_epi32(left, right)));
+            _mm_storeu_si128((__m128i *)(buffer + 4), _mm_add_epi32(_mm_loadu_si128((__m128i *)(buffer + 4)), _mm_unpackhi_epi32(left, right)));
+
+            pos = _mm_add_epi32(pos, pos_step);
+            env = _mm_add_epi32(env, env_step);
+            buffer += 8;
+            count -= 4;
+        } while (count >= 4);
+
+        nte->sample_pos = (uint32_t)_mm_cvtsi128_si32(pos);
+        nte->env_level = _mm_cvtsi128_si32(env);
+    }
+
+    if (count) {
+        mix_linear_c(nte, buffer, count);
+    }
+}
+
+WM_TARGET("sse2")
+static void mix_gauss_sse2(struct _note *nte, int32_t *buffer, uint32_t count) {
+    const int16_t *data = nte->sample->data - GAUSS_HALF;
+    uint32_t sample_pos = nte->sample_pos;
+    uint32_t sample_inc = nte->sample_inc;
+    int32_t env_level = nte->env_level;
+    int32_t env_inc = nte->env_inc;
+    int32_t left_vol = (int32_t)nte->left_mix_volume;
+    int32_t right_vol = (int32_t)nte->right_mix_volume;
+    const int16_t *sptr, *gptr;
+    __m128i acc;
+    int32_t premix;
+
+    while (count--) {
+        sptr = data + (sample_pos >> FPBITS);
+        gptr = gauss_table[sample_pos & FPMASK];
+        acc = _mm_madd_epi16(_mm_loadu_si128((const __m128i *)sptr), _mm_loadu_si128((const __m128i *)gptr));
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_loadu_si128((const __m128i *)(sptr + 8)), _mm_loadu_si128((const __m128i *)(gptr + 8))));
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_loadu_si128((const __m128i *)(sptr + 16)), _mm_loadu_si128((const __m128i *)(gptr + 16))));
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_loadu_si128((const __m128i *)(sptr + 24)), _mm_loadu_si128((const __m128i *)(gptr + 24))));
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_loadu_si128((const __m128i *)(sptr + 32)), _mm_loadu_si128((const __m128i *)(gptr + 32))));
+        acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+        acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+        GAUSS_MIX_FRAME(_mm_cvtsi128_si32(acc));
+    }
+
+    nte->sample_pos = sample_pos;
+    nte->env_level = env_level;
+}
+
+#endif /* HAVE_SSE2_INTRINSICS */
+
+#if defined(HAVE_AVX2_INTRINSICS)
+
+WM_TARGET("avx2")
+static inline __m256i avx2_div1024(__m256i x) {
+    return (_mm256_srai_epi32(_mm256_add_epi32(x, _mm256_and_si256(_mm256_srai_epi32(x, 31), _mm256_set1_epi32(1023))), 10));
+}
+
+WM_TARGET("avx2")
+static void mix_linear_avx2(struct _note *nte, int32_t *buffer, uint32_t count) {
+    const int16_t *data = nte->sample->data;
+    uint32_t sample_inc = nte->sample_inc;
+    int32_t env_inc = nte->env_inc;
+    __m256i pos, env, pos_step, env_step, lanes;
+    __m256i frac_mask, left_vol, right_vol;
+    __m256i pair, s0, s1, premix, left, right, lo, hi;
+
+    if (count >= 8) {
+        lanes = _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+        pos = _mm256_add_epi32(_mm256_set1_epi32((int32_t)nte->sample_pos),
+                               _mm256_mullo_epi32(lanes, _mm256_set1_epi32((int32_t)sample_inc)));
+        env = _mm256_add_epi32(_mm256_set1_epi32(nte->env_level),
+                               _mm256_mullo_epi32(lanes, _mm256_set1_epi32(env_inc)));
+        pos_step = _mm256_set1_epi32((int32_t)(sample_inc * 8));
+        env_step = _mm256_set1_epi32(env_inc * 8);
+        frac_mask = _mm256_set1_epi32(FPMASK);
+        left_vol = _mm256_set1_epi32((int32_t)nte->left_mix_volume);
+        right_vol = _mm256_set1_epi32((int32_t)nte->right_mix_volume);
+
+        do {
+            /* one 32bit gather fetches both data[i] and data[i + 1] */
+            pair = _mm256_i32gather_epi32((const int *)data, _mm256_srli_epi32(pos, FPBITS), 2);
+            s0 = _mm256_srai_epi32(_mm256_slli_epi32(pair, 16), 16);
+            s1 = _mm256_srai_epi32(pair, 16);
+
+            premix = _mm256_add_epi32(s0, avx2_div1024(_mm256_mullo_epi32(_mm256_sub_epi32(s1, s0), _mm256_and_si256(pos, frac_mask))));
+            premix = avx2_div1024(_mm256_mullo_epi32(premix, _mm256_srai_epi32(env, 12)));
+            left = avx2_div1024(_mm256_mullo_epi32(premix, left_vol));
+            right = avx2_div1024(_mm256_mullo_epi32(premix, right_vol));
+
+            /* unpack works per 128bit lane, put the frames back in order */
+            lo = _mm256_unpacklo_epi32(left, right);
+            hi = _mm256_unpackhi_epi32(left, right);
+            _mm256_storeu_si256((__m256i *)buffer, _mm256_add_epi32(_mm256_loadu_si256((__m256i *)buffer), _mm256_permute2x128_si256(lo, hi, 0x20)));
+            _mm256_storeu_si256((__m256i *)(buffer + 8), _mm256_add_epi32(_mm256_loadu_si256((__m256i *)(buffer + 8)), _mm256_permute2x128_si256(lo, hi, 0x31)));
+
+            pos = _mm256_add_epi32(pos, pos_step);
+            env = _mm256_add_epi32(env, env_step);
+            buffer += 16;
+            count -= 8;
+        } while (count >= 8);
+
+        nte->sample_pos = (uint32_t)_mm_cvtsi128_si32(_mm256_castsi256_si128(pos));
+        nte->env_level = _mm_cvtsi128_si32(_mm256_castsi256_si128(env));
+    }
+
+    if (count) {
+        mix_linear_c(nte, buffer, count);
+    }
+}
+
+WM_TARGET("avx2")
+static void mix_gauss_avx2(struct _note *nte, int32_t *buffer, uint32_t count) {
+    const int16_t *data = nte->sample->data - GAUSS_HALF;
+    uint32_t sample_pos = nte->sample_pos;
+    uint32_t sample_inc = nte->sample_inc;
+    int32_t env_level = nte->env_level;
+    int32_t env_inc = nte->env_inc;
+    int32_t left_vol = (int32_t)nte->left_mix_volume;
+    int32_t right_vol = (int32_t)nte->right_mix_volume;
+    const int16_t *sptr, *gptr;
+    __m256i acc8;
+    __m128i acc;
+    int32_t premix;
+
+    while (count--) {
+        sptr = data + (sample_pos >> FPBITS);
+        gptr = gauss_table[sample_pos & FPMASK];
+        acc8 = _mm256_madd_epi16(_mm256_loadu_si256((const __m256i *)sptr), _mm256_loadu_si256((const __m256i *)gptr));
+        acc8 = _mm256_add_epi32(acc8, _mm256_madd_epi16(_mm256_loadu_si256((const __m256i *)(sptr + 16)), _mm256_loadu_si256((const __m256i *)(gptr + 16))));
+        acc = _mm_add_epi32(_mm256_castsi256_si128(acc8), _mm256_extracti128_si256(acc8, 1));
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_loadu_si128((const __m128i *)(sptr + 32)), _mm_loadu_si128((const __m128i *)(gptr + 32))));
+        acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+        acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+        GAUSS_MIX_FRAME(_mm_cvtsi128_si32(acc));
+    }
+
+    nte->sample_pos = sample_pos;
+    nte->env_level = env_level;
+}
+
+#endif /* HAVE_AVX2_INTRINSICS */
+
+#if defined(HAVE_NEON_INTRINSICS)
+
+static inline int32x4_t neon_div1024(int32x4_t x) {
+    return (vshrq_n_s32(vaddq_s32(x, vandq_s32(vshrq_n_s32(x, 31), vdupq_n_s32(1023))), 10));
+}
+
+static void mix_linear_neon(struct _note *nte, int32_t *buffer, uint32_t count) {
+    const int16_t *data = nte->sample->data;
+    uint32_t sample_inc = nte->sample_inc;
+    int32_t env_inc = nte->env_inc;
+    static const uint32_t lane_init[4] = { 0, 1, 2, 3 };
+    uint32x4_t pos, pos_step, lanes, idx;
+    int32x4_t env, env_step;
+    int32x4_t s0, s1, premix;
+    int32x4x2_t mix;
+    int32_t left_vol = (int32_t)nte->left_mix_volume;
+    int32_t right_vol = (int32_t)nte->right_mix_volume;
+    uint32_t ofs[4];
+
+    if (count >= 4) {
+        lanes = vld1q_u32(lane_init);
+        pos = vmlaq_n_u32(vdupq_n_u32(nte->sample_pos), lanes, sample_inc);
+        env = vmlaq_n_s32(vdupq_n_s32(nte->env_level), vreinterpretq_s32_u32(lanes), env_inc);
+        pos_step = vdupq_n_u32(sample_inc * 4);
+        env_step = vdupq_n_s32(env_inc * 4);
+
+        do {
+            idx = vshrq_n_u32(pos, FPBITS);
+            vst1q_u32(ofs, idx);
+            s0 = vdupq_n_s32(0);
+            s1 = vdupq_n_s32(0);
+            s0 = vsetq_lane_s32(data[ofs[0]], s0, 0);
+            s1 = vsetq_lane_s32(data[ofs[0] + 1], s1, 0);
+            s0 = vsetq_lane_s32(data[ofs[1]], s0, 1);
+            s1 = vsetq_lane_s32(data[ofs[1] + 1], s1, 1);
+            s0 = vsetq_lane_s32(data[ofs[2]], s0, 2);
+            s1 = vsetq_lane_s32(data[ofs[2] + 1], s1, 2);
+            s0 = vsetq_lane_s32(data[ofs[3]], s0, 3);
+            s1 = vsetq_lane_s32(data[ofs[3] + 1], s1, 3);
+
+            premix = vaddq_s32(s0, neon_div1024(vmulq_s32(vsubq_s32(s1, s0),
+                    vreinterpretq_s32_u32(vandq_u32(pos, vdupq_n_u32(FPMASK))))));
+            premix = neon_div1024(vmulq_s32(premix, vshrq_n_s32(env, 12)));
+
+            mix = vld2q_s32(buffer);
+            mix.val[0] = vaddq_s32(mix.val[0], neon_div1024(vmulq_n_s32(premix, left_vol)));
+            mix.val[1] = vaddq_s32(mix.val[1], neon_div1024(vmulq_n_s32(premix, right_vol)));
+            vst2q_s32(buffer, mix);
+
+            pos = vaddq_u32(pos, pos_step);
+            env = vaddq_s32(env, env_step);
+            buffer += 8;
+            count -= 4;
+        } while (count >= 4);
+
+        nte->sample_pos = vgetq_lane_u32(pos, 0);
+        nte->env_level = vgetq_lane_s32(env, 0);
+    }
+
+    if (count) {
+        mix_linear_c(nte, buffer, count);
+    }
+}
+
+static void mix_gauss_neon(struct _note *nte, int32_t *buffer, uint32_t count) {
+    const int16_t *data = nte->sample->data - GAUSS_HALF;
+    uint32_t sample_pos = nte->sample_pos;
+    uint32_t sample_inc = nte->sample_inc;
+    int32_t env_level = nte->env_level;
+    int32_t env_inc = nte->env_inc;
+    int32_t left_vol = (int32_t)nte->left_mix_volume;
+    int32_t right_vol = (int32_t)nte->right_mix_volume;
+    const int16_t *sptr, *gptr;
+    int32x4_t acc;
+    int32x2_t acc2;
+    int16x8_t s, g;
+    int32_t premix;
+    int i;
+
+    while (count--) {
+        sptr = data + (sample_pos >> FPBITS);
+        gptr = gauss_table[sample_pos & FPMASK];
+        acc = vdupq_n_s32(0);
+        for (i = 0; i < GAUSS_TAPS; i += 8) {
+            s = vld1q_s16(sptr + i);
+            g = vld1q_s16(gptr + i);
+            acc = vmlal_s16(acc, vget_low_s16(s), vget_low_s16(g));
+            acc = vmlal_s16(acc, vget_high_s16(s), vget_high_s16(g));
+        }
+        acc2 = vadd_s32(vget_low_s32(acc), vget_high_s32(acc));
+        acc2 = vpadd_s32(acc2, acc2);
+        GAUSS_MIX_FRAME(vget_lane_s32(acc2, 0));
+    }
+
+    nte->sample_pos = sample_pos;
+    nte->env_level = env_level;
+}
+
+#endif /* HAVE_NEON_INTRINSICS */
+
+struct _WM_Mixer _WM_MixLinear = { mix_linear_c, mix_linear_reverse_c };
+struct _WM_Mixer _WM_MixGauss = { mix_gauss_c, mix_gauss_c };
+
+void _WM_InitMixer(void) {
+    _WM_MixLinear.forward = mix_linear_c;
+    _WM_MixGauss.forward = mix_gauss_c;
+    _WM_MixGauss.reverse = mix_gauss_c;
+
+#if defined(HAVE_NEON_INTRINSICS)
+    _WM_MixLinear.forward = mix_linear_neon;
+    _WM_MixGauss.forward = mix_gauss_neon;
+    _WM_MixGauss.reverse = mix_gauss_neon;
+#endif
+
+#if defined(HAVE_SSE2_INTRINSICS)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    _WM_MixLinear.forward = mix_linear_sse2;
+    _WM_MixGauss.forward = mix_gauss_sse2;
+    _WM_MixGauss.reverse = mix_gauss_sse2;
+#elif defined(__GNUC__) || defined(__clang__)
+    if (__builtin_cpu_supports("sse2")) {
+        _WM_MixLinear.forward = mix_linear_sse2;
+        _WM_MixGauss.forward = mix_gauss_sse2;
+        _WM_MixGauss.reverse = mix_gauss_sse2;
+    }
+#endif
+#endif
+
+#if defined(HAVE_AVX2_INTRINSICS)
+    if (__builtin_cpu_supports("avx2")) {
+        _WM_MixLinear.forward = mix_linear_avx2;
+        _WM_MixGauss.forward = mix_gauss_avx2;
+        _WM_MixGauss.reverse = mix_gauss_avx2;
+    }
+#endif
+}
+
+void _WM_PickMixer(struct _mdi *mdi) {
+    if (mdi->extra_info.mixer_options & WM_MO_ENHANCED_RESAMPLING) {
+        mdi->mixer = &_WM_MixGauss;
+    } else {
+        mdi->mixer = &_WM_MixLinear;
+    }
+}
@@ -132,9 +132,10 @@ struct mus_ctx {
 #define DST_CHUNK 8192
 static void resize_dst(struct mus_ctx *ctx) {
     uint32_t pos = ctx->dst_ptr - ctx->dst;
-    ctx->dst = (uint8_t *) realloc(ctx->dst, ctx->dstsize + DST_CHUNK);
-    ctx->dstsize += DST_CHUNK;
-    ctx->dstrem += DST_CHUNK;
+    uint32_t grow = (ctx->dstsize > DST_CHUNK)? ctx->dstsize : DST_CHUNK;
+    ctx->dst = (uint8_t *) realloc(ctx->dst, ctx->dstsize + grow);
+    ctx->dstsize += grow;
+    ctx->dstrem += grow;
     ctx->dst_ptr = ctx->dst + pos;
 }
 
@@ -260,10 +261,18 @@ int _WM_mus2midi(const uint8_t *in, uint32_t insize,
     ctx.src = ctx.src_ptr = in;
     ctx.srcsize = insize;
 
-    ctx.dst = (uint8_t *) calloc(DST_CHUNK, sizeof(uint8_t));
+    /* A MUS event of n bytes turns into at most 2n midi bytes unless the
+     * tempo is scaled up, add the track preamble, one volume setup for
+     * each channel and the slack the event writer wants. The buffer still
+     * grows if a song needs more. */
+    ctx.dstsize = 2 * header.scoreLen + 33 + 4 * MIDI_MAXCHANNELS + 32;
+    ctx.dst = (uint8_t *) malloc(ctx.dstsize);
+    if (!ctx.dst) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, 0);
+        return (-1);
+    }
     ctx.dst_ptr = ctx.dst;
-    ctx.dstsize = DST_CHUNK;
-    ctx.dstrem = DST_CHUNK;
+    ctx.dstrem = ctx.dstsize;
 
     /* Map channel 15 to 9 (percussions) */
     for (temp = 0; temp < MIDI_MAXCHANNELS; ++temp) {
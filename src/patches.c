@@ -27,75 +27,432 @@
 #include <stdint.h>
 #include <stdlib.h>
 
+#include "common.h"
 #include "wildmidi_lib.h"
 #include "internal_midi.h"
 #include "lock.h"
 #include "patches.h"
 #include "sample.h"
+#include "wm_thread.h"
 
-struct _patch *_WM_patch[128];
-int _WM_patch_lock = 0;
-
-struct _patch *
-_WM_get_patch_data(struct _mdi *mdi, uint16_t patchid) {
+/* walk the patch set for patchid, the caller holds the patch set lock */
+static struct _patch *
+WM_find_patch(struct _patch_set *patches, uint16_t patchid) {
     struct _patch *search_patch;
 
-    _WM_Lock(&_WM_patch_lock);
-
-    search_patch = _WM_patch[patchid & 0x007F];
-
-    if (search_patch == NULL) {
-        _WM_Unlock(&_WM_patch_lock);
-        return (NULL);
-    }
+    search_patch = patches->patch[patchid & 0x007F];
 
     while (search_patch) {
         if (search_patch->patchid == patchid) {
-            _WM_Unlock(&_WM_patch_lock);
             return (search_patch);
         }
         search_patch = search_patch->next;
     }
     if ((patchid >> 8) != 0) {
-        _WM_Unlock(&_WM_patch_lock);
-        return (_WM_get_patch_data(mdi, patchid & 0x00FF));
+        return (WM_find_patch(patches, patchid & 0x00FF));
     }
-    _WM_Unlock(&_WM_patch_lock);
     return (NULL);
 }
 
-void _WM_load_patch(struct _mdi *mdi, uint16_t patchid) {
+/* is patch one of those the song holds samples for */
+static int
+WM_holds_patch(struct _mdi *mdi, struct _patch *patch) {
     uint32_t i;
-    struct _patch *tmp_patch = NULL;
 
     for (i = 0; i < mdi->patch_count; i++) {
-        if (mdi->patches[i]->patchid == patchid) {
+        if (mdi->patches[i] == patch) {
+            return (1);
+        }
+    }
+    return (0);
+}
+
+/* note what patchid resolves to for this song */
+static void
+WM_map_patch(struct _mdi *mdi, uint16_t patchid, struct _patch *patch) {
+    struct _patch_page *page = mdi->patch_map[patchid >> 8];
+
+    if (page == NULL) {
+        page = (struct _patch_page *) _WM_SongAlloc(mdi, sizeof(struct _patch_page));
+        if (page == NULL) {
             return;
         }
+        mdi->patch_map[patchid >> 8] = page;
     }
+    page->patch[patchid & 0x00FF] = patch;
+    page->resolved[patchid & 0x00FF] = 1;
+}
 
-    tmp_patch = _WM_get_patch_data(mdi, patchid);
-    if (tmp_patch == NULL) {
+/* take a patch a song uses again off the idle list */
+static void
+WM_unidle_patch(struct _patch_set *patches, struct _patch *patch) {
+    if (patch->idle_prev) {
+        patch->idle_prev->idle_next = patch->idle_next;
+    } else {
+        patches->idle_first = patch->idle_next;
+    }
+    if (patch->idle_next) {
+        patch->idle_next->idle_prev = patch->idle_prev;
+    } else {
+        patches->idle_last = patch->idle_prev;
+    }
+    patch->idle_prev = NULL;
+    patch->idle_next = NULL;
+    patch->idle = 0;
+}
+
+/* free the samples of a patch no song uses, it is decoded again on demand */
+static void
+WM_evict_patch(struct _patch_set *patches, struct _patch *patch) {
+    _WM_free_samples(patch);
+    patches->resident -= patch->sample_bytes;
+    patch->sample_bytes = 0;
+    patch->loaded = 0;
+}
+
+/*
+ * A song is done with patch, the caller holds the patch set lock. Once no
+ * song uses it the patch goes to the back of the idle list, and patches
+ * are freed from the front until the idle ones fit in the budget again.
+ */
+void
+_WM_unuse_patch(struct _patch_set *patches, struct _patch *patch) {
+    if (--patch->inuse_count != 0) {
+        return;
+    }
+    if ((patches->sample_budget == 0) || (patch->first_sample == NULL)) {
+        WM_evict_patch(patches, patch);
         return;
     }
 
-    _WM_Lock(&_WM_patch_lock);
-    if (!tmp_patch->loaded) {
-        if (_WM_load_sample(tmp_patch) == -1) {
-            _WM_Unlock(&_WM_patch_lock);
-            return;
-        }
+    patch->idle = 1;
+    patch->idle_next = NULL;
+    patch->idle_prev = patches->idle_last;
+    if (patches->idle_last) {
+        patches->idle_last->idle_next = patch;
+    } else {
+        patches->idle_first = patch;
+    }
+    patches->idle_last = patch;
+
+    while ((patches->resident > patches->sample_budget) && (patches->idle_first)) {
+        patch = patches->idle_first;
+        WM_unidle_patch(patches, patch);
+        WM_evict_patch(patches, patch);
+    }
+}
+
+/*
+ * Only patches the song holds are handed out, anything else may have its
+ * samples freed by another song at any time. Ids seen while parsing are
+ * already in the map, so the lock is only taken for ids the song never
+ * asked for up front.
+ */
+struct _patch *
+_WM_get_patch_data(struct _mdi *mdi, uint16_t patchid) {
+    struct _patch_page *page = mdi->patch_map[patchid >> 8];
+    struct _patch *search_patch;
+
+    if ((page) && (page->resolved[patchid & 0x00FF])) {
+        return (page->patch[patchid & 0x00FF]);
     }
+    if (mdi->ctx->probe) {
+        /* no patches to look at, see WildMidi_Probe() */
+        return (NULL);
+    }
+
+    _WM_Lock(&mdi->patch_set->lock);
+    search_patch = WM_find_patch(mdi->patch_set, patchid);
+    if ((search_patch) && (!WM_holds_patch(mdi, search_patch))) {
+        search_patch = NULL;
+    }
+    WM_map_patch(mdi, patchid, search_patch);
+    _WM_Unlock(&mdi->patch_set->lock);
+    return (search_patch);
+}
+
+void _WM_load_patch(struct _mdi *mdi, uint16_t patchid) {
+    struct _patch_page *page = mdi->patch_map[patchid >> 8];
+    struct _patch *tmp_patch = NULL;
 
-    if (tmp_patch->first_sample == NULL) {
-        _WM_Unlock(&_WM_patch_lock);
+    if (mdi->ctx->probe) {
         return;
     }
+    if ((page) && (page->resolved[patchid & 0x00FF])) {
+        return;
+    }
+
+    _WM_Lock(&mdi->patch_set->lock);
+    tmp_patch = WM_find_patch(mdi->patch_set, patchid);
+    if (tmp_patch == NULL) {
+        goto _end;
+    }
+
+    if (WM_holds_patch(mdi, tmp_patch)) {
+        goto _end;
+    }
+
+    if (!tmp_patch->loaded) {
+        /* decoded with the other new patches of the song once it is
+         * parsed, see _WM_decode_patches() */
+        tmp_patch->loaded = WM_PATCH_PENDING;
+        mdi->patch_set->misses++;
+    } else if ((tmp_patch->loaded == 1) && (tmp_patch->first_sample == NULL)) {
+        /* tried before and failed */
+        tmp_patch = NULL;
+        goto _end;
+    } else {
+        mdi->patch_set->hits++;
+        if (tmp_patch->idle) {
+            WM_unidle_patch(mdi->patch_set, tmp_patch);
+        }
+    }
 
     mdi->patch_count++;
     mdi->patches = (struct _patch **) realloc(mdi->patches,
                            (sizeof(struct _patch*) * mdi->patch_count));
     mdi->patches[mdi->patch_count - 1] = tmp_patch;
     tmp_patch->inuse_count++;
-    _WM_Unlock(&_WM_patch_lock);
+
+_end:
+    WM_map_patch(mdi, patchid, tmp_patch);
+    _WM_Unlock(&mdi->patch_set->lock);
+}
+
+struct _decode_job {
+    struct _patch_set *patches;
+    struct _patch **patch;
+    uint32_t count;
+    uint32_t next;
+    int lock;
+#ifdef WILDMIDI_TRACE
+    /* the begin and end of each patch, added to the trace once all are
+       done as the workers may not add to it themselves */
+    struct _WM_TraceEvent *trace;
+#endif
+};
+
+#ifdef WILDMIDI_TRACE
+static void
+WM_trace_decode(struct _decode_job *job, uint32_t i, uint8_t phase, int worker) {
+    struct _WM_TraceEvent *event;
+
+    if (job->trace == NULL) {
+        return;
+    }
+    event = &job->trace[(i * 2) + (phase == WM_TRACE_END)];
+    event->time = _WM_Clock();
+    event->arg = job->patch[i]->patchid;
+    event->type = WM_TRACE_PATCH_LOAD;
+    event->phase = phase;
+    event->channel = 0;
+    event->thread = (uint8_t) worker;
+}
+#endif
+
+static void
+WM_decode_job(void *data, int worker) {
+    struct _decode_job *job = (struct _decode_job *) data;
+    struct _patch *patch;
+    uint32_t i;
+
+    WMIDI_UNUSED(worker);
+
+    for (;;) {
+        _WM_Lock(&job->lock);
+        i = job->next++;
+        _WM_Unlock(&job->lock);
+        if (i >= job->count) {
+            break;
+        }
+
+        patch = job->patch[i];
+#ifdef WILDMIDI_TRACE
+        WM_trace_decode(job, i, WM_TRACE_BEGIN, worker);
+#endif
+        _WM_load_sample(job->patches, patch);
+#ifdef WILDMIDI_TRACE
+        WM_trace_decode(job, i, WM_TRACE_END, worker);
+#endif
+
+        _WM_Lock(&job->patches->lock);
+        patch->loaded = 1;
+        patch->sample_bytes = _WM_sample_bytes(patch);
+        job->patches->resident += patch->sample_bytes;
+        _WM_Unlock(&job->patches->lock);
+        /* lets other songs waiting for the patch carry on */
+        _WM_Unlock(&patch->lock);
+    }
+}
+
+/* forget a patch that failed to load, the caller holds the patch set lock */
+static void
+WM_drop_patch(struct _mdi *mdi, uint32_t idx) {
+    struct _patch *patch = mdi->patches[idx];
+    uint32_t i, j;
+
+    patch->inuse_count--;
+    mdi->patch_count--;
+    for (i = idx; i < mdi->patch_count; i++) {
+        mdi->patches[i] = mdi->patches[i + 1];
+    }
+
+    for (i = 0; i < 256; i++) {
+        if (mdi->patch_map[i] == NULL) {
+            continue;
+        }
+        for (j = 0; j < 256; j++) {
+            if (mdi->patch_map[i]->patch[j] == patch) {
+                mdi->patch_map[i]->patch[j] = NULL;
+            }
+        }
+    }
+    for (i = 0; i < 16; i++) {
+        if (mdi->channel[i].patch == patch) {
+            mdi->channel[i].patch = NULL;
+        }
+    }
+}
+
+/*
+ * Decode the patches the song asked for while it was parsed, spread over
+ * as many threads as there are cpus. Patches another song is decoding at
+ * the same time are waited for, and those that fail to load are dropped
+ * from the song again, as if it never asked for them.
+ */
+void
+_WM_decode_patches(struct _mdi *mdi) {
+    struct _patch_set *patches = mdi->patch_set;
+    struct _decode_job job;
+    struct _WM_Pool *pool = NULL;
+    struct _patch **list;
+    uint32_t waits = 0;
+    uint32_t i;
+    int threads;
+
+    if (mdi->patch_count == 0) {
+        return;
+    }
+    list = (struct _patch **) malloc(sizeof(struct _patch *) * mdi->patch_count);
+    if (list == NULL) {
+        return;
+    }
+
+    /* ours go to the front of the list, those to wait for to the back */
+    job.patches = patches;
+    job.patch = list;
+    job.count = 0;
+    job.next = 0;
+    job.lock = 0;
+#ifdef WILDMIDI_TRACE
+    job.trace = NULL;
+    if (mdi->trace) {
+        job.trace = (struct _WM_TraceEvent *) malloc(sizeof(struct _WM_TraceEvent) * 2 * mdi->patch_count);
+    }
+#endif
+    _WM_Lock(&patches->lock);
+    for (i = 0; i < mdi->patch_count; i++) {
+        struct _patch *patch = mdi->patches[i];
+        if (patch->loaded == WM_PATCH_PENDING) {
+            patch->loaded = WM_PATCH_DECODING;
+            _WM_Lock(&patch->lock);
+            list[job.count++] = patch;
+        } else if (patch->loaded == WM_PATCH_DECODING) {
+            waits++;
+            list[mdi->patch_count - waits] = patch;
+        }
+    }
+    _WM_Unlock(&patches->lock);
+
+    if (job.count != 0) {
+        threads = _WM_CpuCount();
+        if (threads > WM_MAX_THREADS) {
+            threads = WM_MAX_THREADS;
+        }
+        if ((uint32_t) threads > job.count) {
+            threads = job.count;
+        }
+        if (threads > 1) {
+            pool = _WM_PoolCreate(threads);
+        }
+        if (pool) {
+            _WM_PoolRun(pool, WM_decode_job, &job);
+            _WM_PoolFree(pool);
+        } else {
+            WM_decode_job(&job, 0);
+        }
+    }
+#ifdef WILDMIDI_TRACE
+    if (job.trace) {
+        for (i = 0; i < (job.count * 2); i++) {
+            _WM_TracePut(mdi->trace, &job.trace[i]);
+        }
+        free(job.trace);
+    }
+#endif
+
+    /* the lock is held by whoever decodes the patch until it is done */
+    for (i = 0; i < waits; i++) {
+        struct _patch *patch = list[mdi->patch_count - 1 - i];
+        _WM_Lock(&patch->lock);
+        _WM_Unlock(&patch->lock);
+    }
+    free(list);
+
+    _WM_Lock(&patches->lock);
+    i = mdi->patch_count;
+    while (i--) {
+        if (mdi->patches[i]->first_sample == NULL) {
+            WM_drop_patch(mdi, i);
+        }
+    }
+    _WM_Unlock(&patches->lock);
+}
+
+/*
+ * Count the patches of a song as used once more, so they stay loaded once
+ * the song is closed, and add them to list. Patches already on the list
+ * are not counted again. Returns -1 if the list could not grow.
+ */
+int
+_WM_hold_patches(struct _mdi *mdi, struct _patch ***list, uint32_t *count) {
+    struct _patch_set *patches = mdi->patch_set;
+    struct _patch **new_list;
+    uint32_t i, j;
+    int ret = 0;
+
+    _WM_Lock(&patches->lock);
+    for (i = 0; i < mdi->patch_count; i++) {
+        for (j = 0; j < *count; j++) {
+            if ((*list)[j] == mdi->patches[i]) {
+                break;
+            }
+        }
+        if (j < *count) {
+            continue;
+        }
+        new_list = (struct _patch **) realloc(*list, (sizeof(struct _patch *) * (*count + 1)));
+        if (new_list == NULL) {
+            ret = -1;
+            break;
+        }
+        *list = new_list;
+        (*list)[(*count)++] = mdi->patches[i];
+        mdi->patches[i]->inuse_count++;
+    }
+    _WM_Unlock(&patches->lock);
+    return (ret);
+}
+
+/* let go of the patches held with _WM_hold_patches() and free the list */
+void
+_WM_release_patches(struct _patch_set *patches, struct _patch **list, uint32_t count) {
+    uint32_t i;
+
+    _WM_Lock(&patches->lock);
+    for (i = 0; i < count; i++) {
+        _WM_unuse_patch(patches, list[i]);
+    }
+    _WM_Unlock(&patches->lock);
+    free(list);
 }
@@ -0,0 +1,227 @@
+/*
+ * resample.c -- Midi Wavetable Processing library
+ *
+ * Copyright (C) WildMIDI Developers 2001-2016
+ *
+ * This file is part of WildMIDI.
+ *
+ * WildMIDI is free software: you can redistribute and/or modify the player
+ * under the terms of the GNU General Public License and you can redistribute
+ * and/or modify the library under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either version 3 of
+ * the licenses, or(at your option) any later version.
+ *
+ * WildMIDI is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License and
+ * the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License and the
+ * GNU Lesser General Public License along with WildMIDI.  If not,  see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+
+#include <stdint.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "resample.h"
+
+/*
+ The mix is made at one rate and played at another, see
+ WildMidi_CreateContextRate(). Each output frame is worked out from the
+ RSM_TAPS input frames around it, with the filter for where it falls in
+ between two of them: a windowed sinc, cut off below the lower of the two
+ rates. This is done once for the stereo mix, not for each voice.
+ */
+
+/* input frames an output frame is centred after, so it lines up with them */
+#define RSM_CENTRE  ((RSM_TAPS / 2) - 1)
+
+/* _WM_init_resample_filter - the filters from in_rate to out_rate */
+struct _rsm_filter *_WM_init_resample_filter(uint32_t in_rate, uint32_t out_rate) {
+    struct _rsm_filter *filter;
+    double cutoff;
+    double coeff[RSM_TAPS];
+    double sum;
+    double x;
+    int32_t fixed;
+    int32_t fixed_sum;
+    int phase;
+    int i;
+
+    filter = (struct _rsm_filter *) malloc(sizeof(struct _rsm_filter));
+    if (filter == NULL) {
+        return NULL;
+    }
+    filter->in_rate = in_rate;
+    filter->out_rate = out_rate;
+    filter->step = ((uint64_t) in_rate << 32) / out_rate;
+
+    /* of the input rate, a little under half of the lower rate */
+    cutoff = 0.45 * ((out_rate < in_rate) ? ((double) out_rate / in_rate) : 1.0);
+
+    for (phase = 0; phase < RSM_PHASES; phase++) {
+        sum = 0.0;
+        for (i = 0; i < RSM_TAPS; i++) {
+            /* how far the tap is from the output frame, in input frames */
+            x = (double) (i - RSM_CENTRE) - ((double) phase / RSM_PHASES);
+            coeff[i] = (x == 0.0) ? (2.0 * cutoff)
+                    : (sin(2.0 * M_PI * cutoff * x) / (M_PI * x));
+            /* Blackman window over the taps */
+            coeff[i] *= 0.42 + 0.5 * cos(2.0 * M_PI * x / RSM_TAPS)
+                    + 0.08 * cos(4.0 * M_PI * x / RSM_TAPS);
+            sum += coeff[i];
+        }
+        /* each adds up to exactly 1, so a steady level stays as it is */
+        fixed_sum = 0;
+        for (i = 0; i < RSM_TAPS; i++) {
+            fixed = (int32_t) floor(coeff[i] / sum * (1 << RSM_SHIFT) + 0.5);
+            filter->coeff[phase][i] = (int16_t) fixed;
+            fixed_sum += fixed;
+        }
+        filter->coeff[phase][RSM_CENTRE] += (int16_t) ((1 << RSM_SHIFT) - fixed_sum);
+    }
+
+    return filter;
+}
+
+/* _WM_reset_resample - nothing has been put in yet */
+void _WM_reset_resample(struct _rsm *rsm) {
+    if (!rsm) return;
+    /* the first output frame lines up with the first input frame */
+    memset(rsm->in, 0, ((RSM_CENTRE * 2) * sizeof(int32_t)));
+    rsm->have = RSM_CENTRE;
+    rsm->pos = 0;
+    rsm->quiet = RSM_CENTRE;
+}
+
+/* _WM_init_resample - a resampler of its own, using filter */
+struct _rsm *_WM_init_resample(const struct _rsm_filter *filter) {
+    struct _rsm *rtn_rsm = (struct _rsm *) calloc(1, sizeof(struct _rsm));
+
+    if (rtn_rsm == NULL) {
+        return NULL;
+    }
+    rtn_rsm->filter = filter;
+    rtn_rsm->in_size = RSM_TAPS * 2;
+    rtn_rsm->in = (int32_t *) malloc((rtn_rsm->in_size * 2) * sizeof(int32_t));
+    if (rtn_rsm->in == NULL) {
+        free(rtn_rsm);
+        return NULL;
+    }
+    _WM_reset_resample(rtn_rsm);
+    return rtn_rsm;
+}
+
+/* _WM_free_resample - free up memory used for resampling */
+void _WM_free_resample(struct _rsm *rsm) {
+    if (!rsm) return;
+    free(rsm->in);
+    free(rsm->out);
+    free(rsm);
+}
+
+/* _WM_resample_needs - the input frames to add before frames can be output */
+uint32_t _WM_resample_needs(const struct _rsm *rsm, uint32_t frames) {
+    uint64_t last;
+
+    if (frames == 0) {
+        return 0;
+    }
+    last = ((rsm->pos + ((uint64_t) (frames - 1) * rsm->filter->step)) >> 32) + RSM_TAPS;
+    return ((last > rsm->have) ? (uint32_t) (last - rsm->have) : 0);
+}
+
+/*
+ _WM_resample_input - where to put frames more of input, cleared when they
+ are silent; returns NULL without the memory for them
+ */
+int32_t *_WM_resample_input(struct _rsm *rsm, uint32_t frames, int silent) {
+    int32_t *in;
+    uint32_t size;
+
+    if ((rsm->have + frames) > rsm->in_size) {
+        size = rsm->have + frames;
+        in = (int32_t *) realloc(rsm->in, ((size * 2) * sizeof(int32_t)));
+        if (in == NULL) {
+            return NULL;
+        }
+        rsm->in = in;
+        rsm->in_size = size;
+    }
+    in = rsm->in + (rsm->have * 2);
+    rsm->have += frames;
+    if (silent) {
+        memset(in, 0, ((frames * 2) * sizeof(int32_t)));
+        rsm->quiet += frames;
+    } else {
+        rsm->quiet = 0;
+    }
+    return in;
+}
+
+/*
+ _WM_do_resample - up to frames of output into rsm->out, fewer when the
+ input runs out; silent is set when it all came out of silence and has
+ not been written
+ */
+uint32_t _WM_do_resample(struct _rsm *rsm, uint32_t frames, int *silent) {
+    const struct _rsm_filter *filter = rsm->filter;
+    const int16_t *coeff;
+    const int32_t *in;
+    int32_t *out;
+    uint64_t pos = rsm->pos;
+    uint32_t done;
+    uint32_t used;
+    int64_t left;
+    int64_t right;
+    int i;
+
+    if (frames > rsm->out_size) {
+        out = (int32_t *) realloc(rsm->out, ((frames * 2) * sizeof(int32_t)));
+        if (out == NULL) {
+            return 0;
+        }
+        rsm->out = out;
+        rsm->out_size = frames;
+    }
+
+    *silent = (rsm->quiet >= rsm->have);
+    out = rsm->out;
+    for (done = 0; done < frames; done++) {
+        if (((pos >> 32) + RSM_TAPS) > rsm->have) {
+            break;
+        }
+        if (!*silent) {
+            in = rsm->in + ((pos >> 32) * 2);
+            coeff = filter->coeff[(pos >> (32 - RSM_PHASE_BITS)) & (RSM_PHASES - 1)];
+            left = 0;
+            right = 0;
+            for (i = 0; i < RSM_TAPS; i++) {
+                left += (int64_t) in[i * 2] * coeff[i];
+                right += (int64_t) in[i * 2 + 1] * coeff[i];
+            }
+            *out++ = (int32_t) (left >> RSM_SHIFT);
+            *out++ = (int32_t) (right >> RSM_SHIFT);
+        }
+        pos += filter->step;
+    }
+
+    /* what the next output frame starts from is all that is kept */
+    used = (uint32_t) (pos >> 32);
+    if (used > rsm->have) {
+        used = rsm->have;
+    }
+    memmove(rsm->in, rsm->in + (used * 2), (((rsm->have - used) * 2) * sizeof(int32_t)));
+    rsm->have -= used;
+    rsm->pos = pos - ((uint64_t) used << 32);
+    if (rsm->quiet > rsm->have) {
+        rsm->quiet = rsm->have;
+    }
+    return done;
+}
@@ -26,35 +26,244 @@
 #include <stdint.h>
 #include <math.h>
 #include <stdlib.h>
+#include <string.h>
+
+#if defined(HAVE_SSE2_INTRINSICS)
+#include <emmintrin.h>
+#endif
+#if defined(HAVE_NEON_INTRINSICS)
+#include <arm_neon.h>
+#endif
 
 #include "common.h"
 #include "reverb.h"
 
+#if defined(__GNUC__) || defined(__clang__)
+#define WM_TARGET(x) __attribute__((target(x)))
+#else
+#define WM_TARGET(x)
+#endif
+
 /*
  reverb function
  */
 void _WM_reset_reverb(struct _rvb *rvb) {
-    int i, j, k;
-    for (i = 0; i < rvb->l_buf_size; i++) {
-        rvb->l_buf[i] = 0;
+    if (!rvb) return;
+    memset(rvb->l_buf, 0, (rvb->room->l_buf_size * sizeof(int32_t)));
+    memset(rvb->r_buf, 0, (rvb->room->r_buf_size * sizeof(int32_t)));
+    memset(rvb->l_buf_flt_out, 0, sizeof(rvb->l_buf_flt_out));
+    memset(rvb->r_buf_flt_out, 0, sizeof(rvb->r_buf_flt_out));
+    rvb->l_buf_flt_in[0] = rvb->l_buf_flt_in[1] = 0;
+    rvb->r_buf_flt_in[0] = rvb->r_buf_flt_in[1] = 0;
+    rvb->quiet = 0;
+    rvb->idle = 1;
+}
+
+/*
+ The filter bank
+
+ All 48 filters of a side see the same input, only their outputs differ,
+ so they run as one bank: out = (in * b0 + in[-1] * b1 + in[-2] * b2
+ - out[-1] * a1 - out[-2] * a2) / 1024 for each filter, and the outputs
+ are summed (each / 8) into the value passed in. The vector versions keep
+ the integer arithmetic of the scalar one and so give identical results.
+ */
+static void rvb_filter_c(struct _rvb *rvb, int32_t *l_val, int32_t *r_val) {
+    int32_t l_rfl = *l_val;
+    int32_t r_rfl = *r_val;
+    int32_t l_sum = 0;
+    int32_t r_sum = 0;
+    int32_t l_buf_flt, r_buf_flt;
+    int j;
+
+    for (j = 0; j < RVB_FILTERS; j++) {
+        l_buf_flt = ((l_rfl * rvb->room->coeff[0][j])
+                + (rvb->l_buf_flt_in[0] * rvb->room->coeff[1][j])
+                + (rvb->l_buf_flt_in[1] * rvb->room->coeff[2][j])
+                - (rvb->l_buf_flt_out[0][j] * rvb->room->coeff[3][j])
+                - (rvb->l_buf_flt_out[1][j] * rvb->room->coeff[4][j]))
+                / 1024;
+        rvb->l_buf_flt_out[1][j] = rvb->l_buf_flt_out[0][j];
+        rvb->l_buf_flt_out[0][j] = l_buf_flt;
+        l_sum += l_buf_flt / 8;
+
+        r_buf_flt = ((r_rfl * rvb->room->coeff[0][j])
+                + (rvb->r_buf_flt_in[0] * rvb->room->coeff[1][j])
+                + (rvb->r_buf_flt_in[1] * rvb->room->coeff[2][j])
+                - (rvb->r_buf_flt_out[0][j] * rvb->room->coeff[3][j])
+                - (rvb->r_buf_flt_out[1][j] * rvb->room->coeff[4][j]))
+                / 1024;
+        rvb->r_buf_flt_out[1][j] = rvb->r_buf_flt_out[0][j];
+        rvb->r_buf_flt_out[0][j] = r_buf_flt;
+        r_sum += r_buf_flt / 8;
     }
-    for (i = 0; i < rvb->r_buf_size; i++) {
-        rvb->r_buf[i] = 0;
+    rvb->l_buf_flt_in[1] = rvb->l_buf_flt_in[0];
+    rvb->l_buf_flt_in[0] = l_rfl;
+    rvb->r_buf_flt_in[1] = rvb->r_buf_flt_in[0];
+    rvb->r_buf_flt_in[0] = r_rfl;
+
+    *l_val = l_sum;
+    *r_val = r_sum;
+}
+
+#if defined(HAVE_SSE2_INTRINSICS)
+
+/* x / (1 << n) rounding towards zero, like the c division */
+#define SSE2_DIV_POW2(x, n) \
+    _mm_srai_epi32(_mm_add_epi32((x), _mm_srli_epi32(_mm_srai_epi32((x), 31), (32 - (n)))), (n))
+
+/* sse2 lacks a 32bit low multiply, take the low halves of two 32x32->64 ones */
+WM_TARGET("sse2")
+static inline __m128i rvb_mullo_sse2(__m128i a, __m128i b) {
+    __m128i even = _mm_mul_epu32(a, b);
+    __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return (_mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                               _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0))));
+}
+
+WM_TARGET("sse2")
+static inline int32_t rvb_hsum_sse2(__m128i x) {
+    x = _mm_add_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2)));
+    x = _mm_add_epi32(x, _mm_shuffle_epi32(x, _MM_SHUFFLE(2, 3, 0, 1)));
+    return (_mm_cvtsi128_si32(x));
+}
+
+WM_TARGET("sse2")
+static void rvb_filter_sse2(struct _rvb *rvb, int32_t *l_val, int32_t *r_val) {
+    __m128i l_rfl = _mm_set1_epi32(*l_val);
+    __m128i r_rfl = _mm_set1_epi32(*r_val);
+    __m128i l_in0 = _mm_set1_epi32(rvb->l_buf_flt_in[0]);
+    __m128i l_in1 = _mm_set1_epi32(rvb->l_buf_flt_in[1]);
+    __m128i r_in0 = _mm_set1_epi32(rvb->r_buf_flt_in[0]);
+    __m128i r_in1 = _mm_set1_epi32(rvb->r_buf_flt_in[1]);
+    __m128i l_sum = _mm_setzero_si128();
+    __m128i r_sum = _mm_setzero_si128();
+    __m128i c0, c1, c2, c3, c4, out0, flt;
+    int j;
+
+    for (j = 0; j < RVB_FILTERS; j += 4) {
+        c0 = _mm_loadu_si128((const __m128i *)&rvb->room->coeff[0][j]);
+        c1 = _mm_loadu_si128((const __m128i *)&rvb->room->coeff[1][j]);
+        c2 = _mm_loadu_si128((const __m128i *)&rvb->room->coeff[2][j]);
+        c3 = _mm_loadu_si128((const __m128i *)&rvb->room->coeff[3][j]);
+        c4 = _mm_loadu_si128((const __m128i *)&rvb->room->coeff[4][j]);
+
+        out0 = _mm_loadu_si128((const __m128i *)&rvb->l_buf_flt_out[0][j]);
+        flt = _mm_add_epi32(rvb_mullo_sse2(l_rfl, c0), rvb_mullo_sse2(l_in0, c1));
+        flt = _mm_add_epi32(flt, rvb_mullo_sse2(l_in1, c2));
+        flt = _mm_sub_epi32(flt, rvb_mullo_sse2(out0, c3));
+        flt = _mm_sub_epi32(flt, rvb_mullo_sse2(_mm_loadu_si128((const __m128i *)&rvb->l_buf_flt_out[1][j]), c4));
+        flt = SSE2_DIV_POW2(flt, 10);
+        _mm_storeu_si128((__m128i *)&rvb->l_buf_flt_out[1][j], out0);
+        _mm_storeu_si128((__m128i *)&rvb->l_buf_flt_out[0][j], flt);
+        l_sum = _mm_add_epi32(l_sum, SSE2_DIV_POW2(flt, 3));
+
+        out0 = _mm_loadu_si128((const __m128i *)&rvb->r_buf_flt_out[0][j]);
+        flt = _mm_add_epi32(rvb_mullo_sse2(r_rfl, c0), rvb_mullo_sse2(r_in0, c1));
+        flt = _mm_add_epi32(flt, rvb_mullo_sse2(r_in1, c2));
+        flt = _mm_sub_epi32(flt, rvb_mullo_sse2(out0, c3));
+        flt = _mm_sub_epi32(flt, rvb_mullo_sse2(_mm_loadu_si128((const __m128i *)&rvb->r_buf_flt_out[1][j]), c4));
+        flt = SSE2_DIV_POW2(flt, 10);
+        _mm_storeu_si128((__m128i *)&rvb->r_buf_flt_out[1][j], out0);
+        _mm_storeu_si128((__m128i *)&rvb->r_buf_flt_out[0][j], flt);
+        r_sum = _mm_add_epi32(r_sum, SSE2_DIV_POW2(flt, 3));
     }
-    for (k = 0; k < 8; k++) {
-        for (i = 0; i < 6; i++) {
-            for (j = 0; j < 2; j++) {
-                rvb->l_buf_flt_in[k][i][j] = 0;
-                rvb->l_buf_flt_out[k][i][j] = 0;
-                rvb->r_buf_flt_in[k][i][j] = 0;
-                rvb->r_buf_flt_out[k][i][j] = 0;
-            }
-        }
+    rvb->l_buf_flt_in[1] = rvb->l_buf_flt_in[0];
+    rvb->l_buf_flt_in[0] = *l_val;
+    rvb->r_buf_flt_in[1] = rvb->r_buf_flt_in[0];
+    rvb->r_buf_flt_in[0] = *r_val;
+
+    *l_val = rvb_hsum_sse2(l_sum);
+    *r_val = rvb_hsum_sse2(r_sum);
+}
+
+#endif /* HAVE_SSE2_INTRINSICS */
+
+#if defined(HAVE_NEON_INTRINSICS)
+
+/* x / (1 << n) rounding towards zero, like the c division */
+#define NEON_DIV_POW2(x, n) \
+    vshrq_n_s32(vaddq_s32((x), vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(vshrq_n_s32((x), 31)), (32 - (n))))), (n))
+
+static inline int32_t rvb_hsum_neon(int32x4_t x) {
+    int32x2_t x2 = vadd_s32(vget_low_s32(x), vget_high_s32(x));
+    x2 = vpadd_s32(x2, x2);
+    return (vget_lane_s32(x2, 0));
+}
+
+static void rvb_filter_neon(struct _rvb *rvb, int32_t *l_val, int32_t *r_val) {
+    int32_t l_rfl = *l_val;
+    int32_t r_rfl = *r_val;
+    int32x4_t l_sum = vdupq_n_s32(0);
+    int32x4_t r_sum = vdupq_n_s32(0);
+    int32x4_t c0, c1, c2, c3, c4, out0, flt;
+    int j;
+
+    for (j = 0; j < RVB_FILTERS; j += 4) {
+        c0 = vld1q_s32(&rvb->room->coeff[0][j]);
+        c1 = vld1q_s32(&rvb->room->coeff[1][j]);
+        c2 = vld1q_s32(&rvb->room->coeff[2][j]);
+        c3 = vld1q_s32(&rvb->room->coeff[3][j]);
+        c4 = vld1q_s32(&rvb->room->coeff[4][j]);
+
+        out0 = vld1q_s32(&rvb->l_buf_flt_out[0][j]);
+        flt = vmulq_n_s32(c0, l_rfl);
+        flt = vmlaq_n_s32(flt, c1, rvb->l_buf_flt_in[0]);
+        flt = vmlaq_n_s32(flt, c2, rvb->l_buf_flt_in[1]);
+        flt = vmlsq_s32(flt, out0, c3);
+        flt = vmlsq_s32(flt, vld1q_s32(&rvb->l_buf_flt_out[1][j]), c4);
+        flt = NEON_DIV_POW2(flt, 10);
+        vst1q_s32(&rvb->l_buf_flt_out[1][j], out0);
+        vst1q_s32(&rvb->l_buf_flt_out[0][j], flt);
+        l_sum = vaddq_s32(l_sum, NEON_DIV_POW2(flt, 3));
+
+        out0 = vld1q_s32(&rvb->r_buf_flt_out[0][j]);
+        flt = vmulq_n_s32(c0, r_rfl);
+        flt = vmlaq_n_s32(flt, c1, rvb->r_buf_flt_in[0]);
+        flt = vmlaq_n_s32(flt, c2, rvb->r_buf_flt_in[1]);
+        flt = vmlsq_s32(flt, out0, c3);
+        flt = vmlsq_s32(flt, vld1q_s32(&rvb->r_buf_flt_out[1][j]), c4);
+        flt = NEON_DIV_POW2(flt, 10);
+        vst1q_s32(&rvb->r_buf_flt_out[1][j], out0);
+        vst1q_s32(&rvb->r_buf_flt_out[0][j], flt);
+        r_sum = vaddq_s32(r_sum, NEON_DIV_POW2(flt, 3));
     }
+    rvb->l_buf_flt_in[1] = rvb->l_buf_flt_in[0];
+    rvb->l_buf_flt_in[0] = l_rfl;
+    rvb->r_buf_flt_in[1] = rvb->r_buf_flt_in[0];
+    rvb->r_buf_flt_in[0] = r_rfl;
+
+    *l_val = rvb_hsum_neon(l_sum);
+    *r_val = rvb_hsum_neon(r_sum);
+}
+
+#endif /* HAVE_NEON_INTRINSICS */
+
+static _WM_ReverbFilter rvb_pick_filter(void) {
+#if defined(HAVE_SSE2_INTRINSICS)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    return (rvb_filter_sse2);
+#elif defined(__GNUC__) || defined(__clang__)
+    if (__builtin_cpu_supports("sse2"))
+        return (rvb_filter_sse2);
+#endif
+#endif
+#if defined(HAVE_NEON_INTRINSICS)
+    return (rvb_filter_neon);
+#endif
+    return (rvb_filter_c);
+}
+
+/* the smallest power of 2 greater than len */
+static int rvb_pow2_above(int len) {
+    int size = 1;
+    while (size <= len)
+        size <<= 1;
+    return (size);
 }
 
 /*
- _WM_init_reverb
+ _WM_init_reverb_room
 
  =========================
  Engine Description
@@ -69,8 +278,8 @@ void _WM_reset_reverb(struct _rvb *rvb) {
  The combined sounds are also sent to the reflective points on the opposite side.
 
  */
-struct _rvb *
-_WM_init_reverb(int rate, float room_x, float room_y, float listen_x,
+struct _rvb_room *
+_WM_init_reverb_room(int rate, float room_x, float room_y, float listen_x,
         float listen_y) {
 
     /* filters set at 125Hz, 250Hz, 500Hz, 1000Hz, 2000Hz, 4000Hz */
@@ -120,7 +329,7 @@ _WM_init_reverb(int rate, float room_x, float room_y, float listen_x,
     double SPR_LSN_YOFS = 0.0;
     double SPR_LSN_DST = 0.0;
 
-    struct _rvb *rtn_rvb = (struct _rvb *) malloc(sizeof(struct _rvb));
+    struct _rvb_room *rtn_rvb = (struct _rvb_room *) malloc(sizeof(struct _rvb_room));
     int j = 0;
     int i = 0;
 
@@ -250,22 +459,18 @@ _WM_init_reverb(int rate, float room_x, float room_y, float listen_x,
             double a1 = -2 * cs;
             double a2 = 1 - (alpha / A);
 
-            rtn_rvb->coeff[j][i][0] = (int32_t) ((b0 / a0) * 1024.0);
-            rtn_rvb->coeff[j][i][1] = (int32_t) ((b1 / a0) * 1024.0);
-            rtn_rvb->coeff[j][i][2] = (int32_t) ((b2 / a0) * 1024.0);
-            rtn_rvb->coeff[j][i][3] = (int32_t) ((a1 / a0) * 1024.0);
-            rtn_rvb->coeff[j][i][4] = (int32_t) ((a2 / a0) * 1024.0);
+            rtn_rvb->coeff[0][j * 6 + i] = (int32_t) ((b0 / a0) * 1024.0);
+            rtn_rvb->coeff[1][j * 6 + i] = (int32_t) ((b1 / a0) * 1024.0);
+            rtn_rvb->coeff[2][j * 6 + i] = (int32_t) ((b2 / a0) * 1024.0);
+            rtn_rvb->coeff[3][j * 6 + i] = (int32_t) ((a1 / a0) * 1024.0);
+            rtn_rvb->coeff[4][j * 6 + i] = (int32_t) ((a2 / a0) * 1024.0);
         }
     }
 
-    /* init the reverb buffers */
-    rtn_rvb->l_buf_size = (int) ((float) rate * (MAXL_DST / 340.29));
-    rtn_rvb->l_buf = (int32_t *) malloc(sizeof(int32_t) * (rtn_rvb->l_buf_size + 1));
-    rtn_rvb->l_out = 0;
-
-    rtn_rvb->r_buf_size = (int) ((float) rate * (MAXR_DST / 340.29));
-    rtn_rvb->r_buf = (int32_t *) malloc(sizeof(int32_t) * (rtn_rvb->r_buf_size + 1));
-    rtn_rvb->r_out = 0;
+    /* the reverb buffers have to be longer than the longest delay so a
+       tap never lands on the read position */
+    rtn_rvb->l_buf_size = rvb_pow2_above((int) ((float) rate * (MAXL_DST / 340.29)));
+    rtn_rvb->r_buf_size = rvb_pow2_above((int) ((float) rate * (MAXR_DST / 340.29)));
 
     for (i = 0; i < 4; i++) {
         rtn_rvb->l_sp_in[i] = (int) ((float) rate * (SPL_DST[i] / 340.29));
@@ -279,6 +484,31 @@ _WM_init_reverb(int rate, float room_x, float room_y, float listen_x,
     }
 
     rtn_rvb->gain = 4;
+    rtn_rvb->filter = rvb_pick_filter();
+
+    return rtn_rvb;
+}
+
+/* _WM_init_reverb - a reverb of its own, only the delay lines are allocated */
+struct _rvb *_WM_init_reverb(const struct _rvb_room *room) {
+    struct _rvb *rtn_rvb = (struct _rvb *) malloc(sizeof(struct _rvb));
+
+    if (rtn_rvb == NULL) {
+        return NULL;
+    }
+    rtn_rvb->room = room;
+    rtn_rvb->l_buf = (int32_t *) malloc(sizeof(int32_t) * room->l_buf_size);
+    rtn_rvb->r_buf = (int32_t *) malloc(sizeof(int32_t) * room->r_buf_size);
+    if ((rtn_rvb->l_buf == NULL) || (rtn_rvb->r_buf == NULL)) {
+        _WM_free_reverb(rtn_rvb);
+        return NULL;
+    }
+    rtn_rvb->l_out = 0;
+    rtn_rvb->r_out = 0;
+    memcpy(rtn_rvb->l_sp_in, room->l_sp_in, sizeof(rtn_rvb->l_sp_in));
+    memcpy(rtn_rvb->r_sp_in, room->r_sp_in, sizeof(rtn_rvb->r_sp_in));
+    memcpy(rtn_rvb->l_in, room->l_in, sizeof(rtn_rvb->l_in));
+    memcpy(rtn_rvb->r_in, room->r_in, sizeof(rtn_rvb->r_in));
 
     _WM_reset_reverb(rtn_rvb);
     return rtn_rvb;
@@ -292,12 +522,33 @@ void _WM_free_reverb(struct _rvb *rvb) {
     free(rvb);
 }
 
+/*
+ Everything that goes into the delay lines comes out of them again after
+ at most a line length, so once nothing has gone in for that long, and the
+ filters have died down, the reverb is silent until the next sound.
+ */
+static void rvb_check_idle(struct _rvb *rvb) {
+    int j;
+
+    if (rvb->quiet < rvb->room->l_buf_size || rvb->quiet < rvb->room->r_buf_size)
+        return;
+    if (rvb->l_buf_flt_in[0] | rvb->l_buf_flt_in[1]
+            | rvb->r_buf_flt_in[0] | rvb->r_buf_flt_in[1])
+        return;
+    for (j = 0; j < RVB_FILTERS; j++) {
+        if (rvb->l_buf_flt_out[0][j] | rvb->l_buf_flt_out[1][j]
+                | rvb->r_buf_flt_out[0][j] | rvb->r_buf_flt_out[1][j])
+            return;
+    }
+    rvb->idle = 1;
+}
+
 void _WM_do_reverb(struct _rvb *rvb, int32_t *buffer, int size) {
-    int i, j, k;
-    int32_t l_buf_flt = 0;
-    int32_t r_buf_flt = 0;
+    int i, j;
     int32_t l_rfl = 0;
     int32_t r_rfl = 0;
+    int l_mask = rvb->room->l_buf_size - 1;
+    int r_mask = rvb->room->r_buf_size - 1;
     int vol_div = 64;
 
     for (i = 0; i < size; i += 2) {
@@ -309,16 +560,25 @@ void _WM_do_reverb(struct _rvb *rvb, int32_t *buffer, int size) {
          */
         tmp_l_val = buffer[i] / vol_div;
         tmp_r_val = buffer[i + 1] / vol_div;
+
+        if (rvb->idle) {
+            /* the delay lines are empty, so no need to move along them */
+            if (!(tmp_l_val | tmp_r_val))
+                continue;
+            rvb->idle = 0;
+        }
+        rvb->quiet = (tmp_l_val | tmp_r_val) ? 0 : rvb->quiet + 1;
+
         for (j = 0; j < 4; j++) {
             rvb->l_buf[rvb->l_sp_in[j]] += tmp_l_val;
-            rvb->l_sp_in[j] = (rvb->l_sp_in[j] + 1) % rvb->l_buf_size;
+            rvb->l_sp_in[j] = (rvb->l_sp_in[j] + 1) & l_mask;
             rvb->l_buf[rvb->r_sp_in[j]] += tmp_r_val;
-            rvb->r_sp_in[j] = (rvb->r_sp_in[j] + 1) % rvb->l_buf_size;
+            rvb->r_sp_in[j] = (rvb->r_sp_in[j] + 1) & l_mask;
 
             rvb->r_buf[rvb->l_sp_in[j + 4]] += tmp_l_val;
-            rvb->l_sp_in[j + 4] = (rvb->l_sp_in[j + 4] + 1) % rvb->r_buf_size;
+            rvb->l_sp_in[j + 4] = (rvb->l_sp_in[j + 4] + 1) & r_mask;
             rvb->r_buf[rvb->r_sp_in[j + 4]] += tmp_r_val;
-            rvb->r_sp_in[j + 4] = (rvb->r_sp_in[j + 4] + 1) % rvb->r_buf_size;
+            rvb->r_sp_in[j + 4] = (rvb->r_sp_in[j + 4] + 1) & r_mask;
         }
 
         /*
@@ -326,52 +586,32 @@ void _WM_do_reverb(struct _rvb *rvb, int32_t *buffer, int size) {
          */
         l_rfl = rvb->l_buf[rvb->l_out];
         rvb->l_buf[rvb->l_out] = 0;
-        rvb->l_out = (rvb->l_out + 1) % rvb->l_buf_size;
+        rvb->l_out = (rvb->l_out + 1) & l_mask;
 
         r_rfl = rvb->r_buf[rvb->r_out];
         rvb->r_buf[rvb->r_out] = 0;
-        rvb->r_out = (rvb->r_out + 1) % rvb->r_buf_size;
-
-        for (k = 0; k < 8; k++) {
-            for (j = 0; j < 6; j++) {
-                l_buf_flt = ((l_rfl * rvb->coeff[k][j][0])
-                        + (rvb->l_buf_flt_in[k][j][0] * rvb->coeff[k][j][1])
-                        + (rvb->l_buf_flt_in[k][j][1] * rvb->coeff[k][j][2])
-                        - (rvb->l_buf_flt_out[k][j][0] * rvb->coeff[k][j][3])
-                        - (rvb->l_buf_flt_out[k][j][1] * rvb->coeff[k][j][4]))
-                        / 1024;
-                rvb->l_buf_flt_in[k][j][1] = rvb->l_buf_flt_in[k][j][0];
-                rvb->l_buf_flt_in[k][j][0] = l_rfl;
-                rvb->l_buf_flt_out[k][j][1] = rvb->l_buf_flt_out[k][j][0];
-                rvb->l_buf_flt_out[k][j][0] = l_buf_flt;
-                buffer[i] += l_buf_flt / 8;
-
-                r_buf_flt = ((r_rfl * rvb->coeff[k][j][0])
-                        + (rvb->r_buf_flt_in[k][j][0] * rvb->coeff[k][j][1])
-                        + (rvb->r_buf_flt_in[k][j][1] * rvb->coeff[k][j][2])
-                        - (rvb->r_buf_flt_out[k][j][0] * rvb->coeff[k][j][3])
-                        - (rvb->r_buf_flt_out[k][j][1] * rvb->coeff[k][j][4]))
-                        / 1024;
-                rvb->r_buf_flt_in[k][j][1] = rvb->r_buf_flt_in[k][j][0];
-                rvb->r_buf_flt_in[k][j][0] = r_rfl;
-                rvb->r_buf_flt_out[k][j][1] = rvb->r_buf_flt_out[k][j][0];
-                rvb->r_buf_flt_out[k][j][0] = r_buf_flt;
-                buffer[i + 1] += r_buf_flt / 8;
-            }
-        }
+        rvb->r_out = (rvb->r_out + 1) & r_mask;
+
+        rvb->room->filter(rvb, &l_rfl, &r_rfl);
+        buffer[i] += l_rfl;
+        buffer[i + 1] += r_rfl;
 
         /*
          add filtered result back into the buffers but on the opposite side
          */
         tmp_l_val = buffer[i + 1] / vol_div;
         tmp_r_val = buffer[i] / vol_div;
+        if (tmp_l_val | tmp_r_val)
+            rvb->quiet = 0;
         for (j = 0; j < 4; j++) {
             rvb->l_buf[rvb->l_in[j]] += tmp_l_val;
-            rvb->l_in[j] = (rvb->l_in[j] + 1) % rvb->l_buf_size;
+            rvb->l_in[j] = (rvb->l_in[j] + 1) & l_mask;
 
             rvb->r_buf[rvb->r_in[j]] += tmp_r_val;
-            rvb->r_in[j] = (rvb->r_in[j] + 1) % rvb->r_buf_size;
+            rvb->r_in[j] = (rvb->r_in[j] + 1) & r_mask;
         }
+
+        if ((rvb->quiet) && (!(rvb->quiet & 63)))
+            rvb_check_idle(rvb);
     }
 }
-
@@ -25,19 +25,46 @@
 
 #include <stdio.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 
-#include "lock.h"
 #include "common.h"
+#include "wm_error.h"
 #include "patches.h"
 #include "gus_pat.h"
 #include "wildmidi_lib.h"
 #include "internal_midi.h"
 #include "sample.h"
+#include "sample_cache.h"
 
 /*
  FIXME: Need to decide if this stuff needs to be broken up for different formats.
  */
 
+/*
+ a zero filled pool of size bytes for the samples of a patch, aligned to
+ SAMPLE_POOL_ALIGN so the slots (see SAMPLE_POOL_SLOT) are as well. What
+ malloc() gave is kept just before it for _WM_free_sample_pool().
+ */
+uint8_t *_WM_alloc_sample_pool(uint32_t size) {
+    uint8_t *block = (uint8_t *) calloc(1, (size + sizeof(void *) + SAMPLE_POOL_ALIGN - 1));
+    uint8_t *pool;
+
+    if (block == NULL) return (NULL);
+    pool = block + sizeof(void *);
+    pool += (SAMPLE_POOL_ALIGN - ((uintptr_t) pool & (SAMPLE_POOL_ALIGN - 1))) & (SAMPLE_POOL_ALIGN - 1);
+    memcpy((pool - sizeof(void *)), &block, sizeof(void *));
+    return (pool);
+}
+
+void _WM_free_sample_pool(uint8_t *pool) {
+    void *block;
+
+    if (pool == NULL) return;
+    memcpy(&block, (pool - sizeof(void *)), sizeof(void *));
+    free(block);
+}
+
 uint32_t _WM_get_decay_samples(struct _mdi * mdi, uint8_t channel, uint8_t note) {
     struct _patch *patch = NULL;
     struct _sample *sample = NULL;
@@ -77,57 +104,81 @@ uint32_t _WM_get_decay_samples(struct _mdi * mdi, uint8_t channel, uint8_t note)
 }
 
 
+/*
+ * Lock free, sample_patch must be held by the calling song so its samples
+ * stay put. Picks the first sample whose range holds freq, falling back to
+ * the last one starting below it.
+ */
 struct _sample *_WM_get_sample_data(struct _patch *sample_patch, uint32_t freq) {
-    struct _sample *last_sample = NULL;
-    struct _sample *return_sample = NULL;
+    struct _sample_range *range;
+    struct _sample *return_sample;
+    uint16_t i;
 
-    _WM_Lock(&_WM_patch_lock);
-    if (sample_patch == NULL) {
-        _WM_Unlock(&_WM_patch_lock);
-        return (NULL);
-    }
-    if (sample_patch->first_sample == NULL) {
-        _WM_Unlock(&_WM_patch_lock);
+    if ((sample_patch == NULL) || (sample_patch->range_count == 0)) {
         return (NULL);
     }
+
+    range = sample_patch->ranges;
+    return_sample = range[0].sample;
     if (freq == 0) {
-        _WM_Unlock(&_WM_patch_lock);
-        return (sample_patch->first_sample);
+        return (return_sample);
     }
 
-    return_sample = sample_patch->first_sample;
-    last_sample = sample_patch->first_sample;
-    while (last_sample) {
-        if (freq > last_sample->freq_low) {
-            if (freq < last_sample->freq_high) {
-                _WM_Unlock(&_WM_patch_lock);
-                return (last_sample);
-            } else {
-                return_sample = last_sample;
+    for (i = 0; i < sample_patch->range_count; i++) {
+        if (freq > range[i].freq_low) {
+            if (freq < range[i].freq_high) {
+                return (range[i].sample);
             }
+            return_sample = range[i].sample;
         }
-        last_sample = last_sample->next;
     }
-    _WM_Unlock(&_WM_patch_lock);
     return (return_sample);
 }
 
+/* free the sample data of a patch, the caller holds the patch set lock */
+void _WM_free_samples(struct _patch *sample_patch) {
+    struct _sample *tmp_sample;
+
+    while (sample_patch->first_sample) {
+        tmp_sample = sample_patch->first_sample->next;
+        free(sample_patch->first_sample);
+        sample_patch->first_sample = tmp_sample;
+    }
+    _WM_free_sample_pool(sample_patch->sample_pool);
+    sample_patch->sample_pool = NULL;
+    sample_patch->sample_pool_size = 0;
+    free(sample_patch->ranges);
+    sample_patch->ranges = NULL;
+    sample_patch->range_count = 0;
+}
+
+/* the heap the samples of a patch take, as _WM_free_samples() gives back */
+uint32_t _WM_sample_bytes(struct _patch *sample_patch) {
+    struct _sample *tmp_sample;
+    uint32_t bytes = (sizeof(struct _sample_range) * sample_patch->range_count)
+                   + sample_patch->sample_pool_size;
+
+    for (tmp_sample = sample_patch->first_sample; tmp_sample; tmp_sample = tmp_sample->next) {
+        bytes += sizeof(struct _sample);
+    }
+    return (bytes);
+}
+
 /* sample loading */
 
+/* decode the .pat file of sample_patch, bypassing the sample cache */
 int
-_WM_load_sample(struct _patch *sample_patch) {
+_WM_decode_sample(struct _patch_set *patches, struct _patch *sample_patch) {
     struct _sample *guspat = NULL;
     struct _sample *tmp_sample = NULL;
     uint32_t i = 0;
 
-    /* we only want to try loading the guspat once. */
-    sample_patch->loaded = 1;
-
-    if ((guspat = _WM_load_gus_pat(sample_patch->filename, _WM_fix_release)) == NULL) {
+    if ((guspat = _WM_load_gus_pat(sample_patch->filename, patches->fix_release, patches->rate,
+                                   &sample_patch->sample_pool, &sample_patch->sample_pool_size)) == NULL) {
         return (-1);
     }
 
-    if (_WM_auto_amp) {
+    if (patches->auto_amp) {
         int16_t tmp_max = 0;
         int16_t tmp_min = 0;
         int16_t samp_max = 0;
@@ -148,7 +199,7 @@ _WM_load_sample(struct _patch *sample_patch) {
                 tmp_min = samp_min;
             tmp_sample = tmp_sample->next;
         } while (tmp_sample);
-        if (_WM_auto_amp_with_amp) {
+        if (patches->auto_amp_with_amp) {
             if (tmp_max >= -tmp_min) {
                 sample_patch->amp = (sample_patch->amp
                                      * ((32767 << 10) / tmp_max)) >> 10;
@@ -218,17 +269,49 @@ _WM_load_sample(struct _patch *sample_patch) {
                 }
                 if (sample_patch->env[i].set & 0x01) {
                     guspat->env_rate[i] = (int32_t) (4194303.0f
-                                                     / ((float) _WM_SampleRate
+                                                     / ((float) patches->rate
                                                         * (sample_patch->env[i].time / 1000.0f)));
                 }
             } else {
                 guspat->env_target[i] = 4194303;
                 guspat->env_rate[i] = (int32_t) (4194303.0f
-                                                 / ((float) _WM_SampleRate * env_time_table[63]));
+                                                 / ((float) patches->rate * env_time_table[63]));
             }
         }
 
         guspat = guspat->next;
     } while (guspat);
+
+    return (_WM_build_ranges(sample_patch));
+}
+
+/* set up the key ranges of the samples just loaded for sample_patch */
+int
+_WM_build_ranges(struct _patch *sample_patch) {
+    struct _sample *guspat;
+    uint32_t i;
+
+    for (guspat = sample_patch->first_sample, i = 0; guspat; guspat = guspat->next)
+        i++;
+    sample_patch->ranges = (struct _sample_range *) malloc(sizeof(struct _sample_range) * i);
+    if (sample_patch->ranges == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, 0);
+        _WM_free_samples(sample_patch);
+        return (-1);
+    }
+    for (guspat = sample_patch->first_sample, i = 0; guspat; guspat = guspat->next, i++) {
+        sample_patch->ranges[i].freq_low = guspat->freq_low;
+        sample_patch->ranges[i].freq_high = guspat->freq_high;
+        sample_patch->ranges[i].sample = guspat;
+    }
+    sample_patch->range_count = i;
     return (0);
 }
+
+int
+_WM_load_sample(struct _patch_set *patches, struct _patch *sample_patch) {
+    if (_WM_LoadCachedSample(patches, sample_patch) == 0) {
+        return (0);
+    }
+    return (_WM_decode_sample(patches, sample_patch));
+}
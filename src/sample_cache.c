@@ -0,0 +1,569 @@
+/*
+ * sample_cache.c -- Midi Wavetable Processing library
+ *
+ * Copyright (C) WildMIDI Developers 2001-2016
+ *
+ * This file is part of WildMIDI.
+ *
+ * WildMIDI is free software: you can redistribute and/or modify the player
+ * under the terms of the GNU General Public License and you can redistribute
+ * and/or modify the library under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either version 3 of
+ * the licenses, or(at your option) any later version.
+ *
+ * WildMIDI is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License and
+ * the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License and the
+ * GNU Lesser General Public License along with WildMIDI.  If not,  see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "config.h"
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "common.h"
+#include "wm_error.h"
+#include "file_io.h"
+#include "lock.h"
+#include "patches.h"
+#include "sample.h"
+#include "sample_cache.h"
+#include "wm_thread.h"
+
+/*
+ * File layout, all in the byte order of the machine that wrote it:
+ *
+ *   the header
+ *   an entry for every patch that has samples, sorted by patch id
+ *   for every patch its samples, each a sample record followed by its
+ *   frames, with SAMPLE_GUARD silent frames on either side
+ *
+ * Sample records and frame data start on WM_CACHE_ALIGN byte boundaries.
+ * Every entry has a checksum of the samples of its patch, checked when the
+ * patch is loaded, and the header one of the entries.
+ */
+
+#define WM_CACHE_MAGIC "WMSCACHE"
+#define WM_CACHE_BYTE_ORDER 0x01020304U
+#define WM_CACHE_ALIGN 16
+#define WM_CACHE_ROUND(x) (((x) + (WM_CACHE_ALIGN - 1)) & ~(WM_CACHE_ALIGN - 1))
+
+struct _cache_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t rate;
+    uint32_t config_hash;
+    uint32_t patch_count;
+    uint32_t entry_sum;
+};
+
+struct _cache_entry {
+    uint16_t patchid;
+    int16_t amp;
+    uint32_t sample_count;
+    uint32_t offset;
+    uint32_t size;
+    uint32_t sum;
+};
+
+struct _cache_sample {
+    uint32_t data_length;
+    uint32_t loop_start;
+    uint32_t loop_end;
+    uint32_t loop_size;
+    uint32_t freq_low;
+    uint32_t freq_high;
+    uint32_t freq_root;
+    uint32_t inc_div;
+    uint32_t note_off_decay;
+    uint32_t rate;
+    uint32_t loop_fraction;
+    uint32_t modes;
+    uint32_t frames;        /* frames stored, not counting the guards */
+    int32_t env_rate[7];
+    int32_t env_target[7];
+    uint32_t reserved;
+};
+
+/* bytes taken by the frames of a sample along with their guards */
+#define WM_CACHE_PCM_SIZE(frames) \
+    WM_CACHE_ROUND(((frames) + (SAMPLE_GUARD * 2)) * sizeof(int16_t))
+
+/* FNV-1a */
+uint32_t _WM_CacheHash(uint32_t hash, const void *data, uint32_t size) {
+    const uint8_t *p = (const uint8_t *) data;
+
+    while (size--) {
+        hash ^= *p++;
+        hash *= 16777619U;
+    }
+    return (hash);
+}
+
+/* the same a word at a time for the sample data, size is a multiple of 4 */
+static uint32_t WM_CacheSum(const void *data, uint32_t size) {
+    const uint32_t *p = (const uint32_t *) data;
+    uint32_t sum = WM_CACHE_HASH_INIT;
+
+    size >>= 2;
+    while (size--) {
+        sum ^= *p++;
+        sum *= 16777619U;
+    }
+    return (sum);
+}
+
+/*
+ * Map the cache the config asked for, if it is there and fits the config.
+ * Not finding it is not an error, patches then get loaded from their .pat
+ * files as usual.
+ */
+void _WM_OpenSampleCache(struct _patch_set *patches) {
+    const struct _cache_header *header;
+    const uint8_t *cache;
+    uint32_t size;
+    uint32_t table_size;
+
+    if (patches->cache_file == NULL) {
+        return;
+    }
+    if ((cache = (const uint8_t *) _WM_MapFile(patches->cache_file, &size)) == NULL) {
+        return;
+    }
+
+    header = (const struct _cache_header *) cache;
+    if ((size < sizeof(struct _cache_header))
+            || (memcmp(header->magic, WM_CACHE_MAGIC, 8) != 0)
+            || (header->version != WM_CACHE_VERSION)
+            || (header->byte_order != WM_CACHE_BYTE_ORDER)) {
+        _WM_DEBUG_MSG("%s: not a sample cache of this version, ignoring it", patches->cache_file);
+        _WM_UnmapFile(cache, size);
+        return;
+    }
+    if ((header->rate != patches->rate) || (header->config_hash != patches->config_hash)) {
+        _WM_DEBUG_MSG("%s: sample cache was written for another config or rate, ignoring it", patches->cache_file);
+        _WM_UnmapFile(cache, size);
+        return;
+    }
+    table_size = header->patch_count * sizeof(struct _cache_entry);
+    if ((header->patch_count > (WM_MAXFILESIZE / sizeof(struct _cache_entry)))
+            || (table_size > (size - sizeof(struct _cache_header)))
+            || (WM_CacheSum((cache + sizeof(struct _cache_header)), table_size) != header->entry_sum)) {
+        _WM_DEBUG_MSG("%s: sample cache is corrupt, ignoring it", patches->cache_file);
+        _WM_UnmapFile(cache, size);
+        return;
+    }
+
+    patches->cache = cache;
+    patches->cache_size = size;
+}
+
+void _WM_CloseSampleCache(struct _patch_set *patches) {
+    if (patches->cache) {
+        _WM_UnmapFile(patches->cache, patches->cache_size);
+        patches->cache = NULL;
+        patches->cache_size = 0;
+    }
+    free(patches->cache_file);
+    patches->cache_file = NULL;
+}
+
+static const struct _cache_entry *
+WM_FindCacheEntry(struct _patch_set *patches, uint16_t patchid) {
+    const struct _cache_header *header = (const struct _cache_header *) patches->cache;
+    const struct _cache_entry *entry = (const struct _cache_entry *)
+                                       (patches->cache + sizeof(struct _cache_header));
+    uint32_t lo = 0;
+    uint32_t hi = header->patch_count;
+    uint32_t mid;
+
+    while (lo < hi) {
+        mid = (lo + hi) >> 1;
+        if (entry[mid].patchid == patchid) {
+            return (&entry[mid]);
+        }
+        if (entry[mid].patchid < patchid) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return (NULL);
+}
+
+/*
+ * Fill in the samples of sample_patch from the cache. Returns -1 when the
+ * cache has nothing usable for it, the caller then loads the .pat file.
+ * Lock free, the cache does not change while the patch set lives. The
+ * samples point straight into the cache, which is mapped read-only and
+ * shared wherever the platform allows, so every process playing from the
+ * same cache keeps just the one copy of the frames in memory.
+ */
+int _WM_LoadCachedSample(struct _patch_set *patches, struct _patch *sample_patch) {
+    const struct _cache_entry *entry;
+    const struct _cache_sample *record;
+    const uint8_t *block;
+    struct _sample *sample;
+    struct _sample **link;
+    uint32_t ofs;
+    uint32_t i;
+
+    if ((patches->cache == NULL)
+            || ((entry = WM_FindCacheEntry(patches, sample_patch->patchid)) == NULL)) {
+        return (-1);
+    }
+
+    if ((entry->offset > patches->cache_size)
+            || (entry->size > (patches->cache_size - entry->offset))
+            || (entry->offset & (WM_CACHE_ALIGN - 1))
+            || (WM_CacheSum((patches->cache + entry->offset), entry->size) != entry->sum)) {
+        _WM_DEBUG_MSG("%s: cached samples of patch %u are corrupt, loading %s",
+                      patches->cache_file, sample_patch->patchid, sample_patch->filename);
+        return (-1);
+    }
+
+    block = patches->cache + entry->offset;
+    link = &sample_patch->first_sample;
+    for (i = 0, ofs = 0; i < entry->sample_count; i++) {
+        if ((entry->size - ofs) < sizeof(struct _cache_sample)) {
+            goto _corrupt;
+        }
+        record = (const struct _cache_sample *) (block + ofs);
+        ofs += sizeof(struct _cache_sample);
+        if ((record->frames > WM_MAXFILESIZE)
+                || (record->frames < ((record->data_length >> 10) + 2))
+                || ((entry->size - ofs) < WM_CACHE_PCM_SIZE(record->frames))) {
+            goto _corrupt;
+        }
+        /* the mixer turns around at both ends of a ping pong loop */
+        if ((record->modes & SAMPLE_PINGPONG)
+                && ((record->loop_start >= record->loop_end)
+                    || ((record->loop_end >> 10) > (record->data_length >> 10)))) {
+            goto _corrupt;
+        }
+
+        sample = (struct _sample *) malloc(sizeof(struct _sample));
+        if (sample == NULL) {
+            goto _nomem;
+        }
+        sample->next = NULL;
+        *link = sample;
+        link = &sample->next;
+
+        /* the frames are used in place, guards and all */
+        sample->data = (int16_t *) (block + ofs + (SAMPLE_GUARD * sizeof(int16_t)));
+        ofs += WM_CACHE_PCM_SIZE(record->frames);
+
+        sample->data_length = record->data_length;
+        sample->loop_start = record->loop_start;
+        sample->loop_end = record->loop_end;
+        sample->loop_size = record->loop_size;
+        sample->loop_fraction = (uint8_t) record->loop_fraction;
+        sample->rate = (uint16_t) record->rate;
+        sample->freq_low = record->freq_low;
+        sample->freq_high = record->freq_high;
+        sample->freq_root = record->freq_root;
+        sample->modes = (uint8_t) record->modes;
+        memcpy(sample->env_rate, record->env_rate, sizeof(sample->env_rate));
+        memcpy(sample->env_target, record->env_target, sizeof(sample->env_target));
+        sample->inc_div = record->inc_div;
+        sample->note_off_decay = record->note_off_decay;
+    }
+    if (sample_patch->first_sample == NULL) {
+        goto _corrupt;
+    }
+
+    sample_patch->amp = entry->amp;
+    return (_WM_build_ranges(sample_patch));
+
+_corrupt:
+    _WM_DEBUG_MSG("%s: cached samples of patch %u are corrupt, loading %s",
+                  patches->cache_file, sample_patch->patchid, sample_patch->filename);
+    _WM_free_samples(sample_patch);
+    return (-1);
+
+_nomem:
+    _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
+    _WM_free_samples(sample_patch);
+    return (-1);
+}
+
+/* writing */
+
+struct _cache_job {
+    struct _patch_set *patches;
+    struct _patch *patch;
+    uint32_t count;
+    uint32_t next;
+    int lock;
+};
+
+static void WM_CacheDecodeJob(void *data, int worker) {
+    struct _cache_job *job = (struct _cache_job *) data;
+    uint32_t i;
+
+    WMIDI_UNUSED(worker);
+
+    for (;;) {
+        _WM_Lock(&job->lock);
+        i = job->next++;
+        _WM_Unlock(&job->lock);
+        if (i >= job->count) {
+            break;
+        }
+        _WM_decode_sample(job->patches, &job->patch[i]);
+    }
+}
+
+static int WM_ComparePatches(const void *a, const void *b) {
+    return ((int) ((const struct _patch *) a)->patchid
+            - (int) ((const struct _patch *) b)->patchid);
+}
+
+/* lay out the samples of one patch the way the loader expects them */
+static uint8_t *WM_CacheBlock(struct _patch *patch, uint32_t *size, uint32_t *count) {
+    struct _cache_sample *record;
+    struct _sample *sample;
+    uint8_t *block;
+    uint32_t frames;
+    uint32_t ofs;
+
+    *size = 0;
+    *count = 0;
+    for (sample = patch->first_sample; sample; sample = sample->next) {
+        frames = (sample->data_length >> 10) + 2;
+        *size += sizeof(struct _cache_sample) + WM_CACHE_PCM_SIZE(frames);
+        (*count)++;
+    }
+
+    block = (uint8_t *) calloc(1, *size);
+    if (block == NULL) {
+        return (NULL);
+    }
+
+    for (sample = patch->first_sample, ofs = 0; sample; sample = sample->next) {
+        frames = (sample->data_length >> 10) + 2;
+        record = (struct _cache_sample *) (block + ofs);
+        record->data_length = sample->data_length;
+        record->loop_start = sample->loop_start;
+        record->loop_end = sample->loop_end;
+        record->loop_size = sample->loop_size;
+        record->freq_low = sample->freq_low;
+        record->freq_high = sample->freq_high;
+        record->freq_root = sample->freq_root;
+        record->inc_div = sample->inc_div;
+        record->note_off_decay = sample->note_off_decay;
+        record->rate = sample->rate;
+        record->loop_fraction = sample->loop_fraction;
+        record->modes = sample->modes;
+        record->frames = frames;
+        memcpy(record->env_rate, sample->env_rate, sizeof(record->env_rate));
+        memcpy(record->env_target, sample->env_target, sizeof(record->env_target));
+        ofs += sizeof(struct _cache_sample);
+
+        /* the guards are zeroed already */
+        memcpy((block + ofs + (SAMPLE_GUARD * sizeof(int16_t))), sample->data,
+               (frames * sizeof(int16_t)));
+        ofs += WM_CACHE_PCM_SIZE(frames);
+    }
+    return (block);
+}
+
+/*
+ * Decode every patch of the set afresh, on as many threads as there are
+ * cpus, and write them to cache_file. The patches songs hold are left
+ * alone. The file is written under a temporary name and moved in place
+ * once complete, so a cache that is in use is never overwritten.
+ */
+int _WM_WriteSampleCache(struct _patch_set *patches, const char *cache_file) {
+    struct _cache_header header;
+    struct _cache_entry *entry = NULL;
+    struct _cache_job job;
+    struct _WM_Pool *pool = NULL;
+    struct _patch *patch;
+    char *tmp_file = NULL;
+    FILE *out = NULL;
+    uint8_t *block;
+    uint8_t pad[WM_CACHE_ALIGN];
+    uint32_t entry_count = 0;
+    uint32_t pos;
+    uint32_t size, count;
+    uint32_t i;
+    int threads;
+    int ret = -1;
+
+    job.patches = patches;
+    job.patch = NULL;
+    job.count = 0;
+    job.next = 0;
+    job.lock = 0;
+
+    /* private copies of the patches, so decoding them disturbs nobody */
+    _WM_Lock(&patches->lock);
+    for (i = 0; i < 128; i++) {
+        for (patch = patches->patch[i]; patch; patch = patch->next) {
+            if (patch->filename) job.count++;
+        }
+    }
+    if (job.count != 0) {
+        job.patch = (struct _patch *) malloc(sizeof(struct _patch) * job.count);
+    }
+    if (job.patch != NULL) {
+        job.count = 0;
+        for (i = 0; i < 128; i++) {
+            for (patch = patches->patch[i]; patch; patch = patch->next) {
+                if (!patch->filename) continue;
+                job.patch[job.count] = *patch;
+                job.patch[job.count].loaded = 1;
+                job.patch[job.count].lock = 0;
+                job.patch[job.count].inuse_count = 0;
+                job.patch[job.count].first_sample = NULL;
+                job.patch[job.count].sample_pool = NULL;
+                job.patch[job.count].sample_pool_size = 0;
+                job.patch[job.count].ranges = NULL;
+                job.patch[job.count].range_count = 0;
+                job.patch[job.count].next = NULL;
+                job.count++;
+            }
+        }
+    }
+    _WM_Unlock(&patches->lock);
+    if ((job.patch == NULL) && (job.count != 0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
+        return (-1);
+    }
+
+    if (job.count != 0) {
+        threads = _WM_CpuCount();
+        if (threads > WM_MAX_THREADS) {
+            threads = WM_MAX_THREADS;
+        }
+        if ((uint32_t) threads > job.count) {
+            threads = job.count;
+        }
+        if (threads > 1) {
+            pool = _WM_PoolCreate(threads);
+        }
+        if (pool) {
+            _WM_PoolRun(pool, WM_CacheDecodeJob, &job);
+            _WM_PoolFree(pool);
+        } else {
+            WM_CacheDecodeJob(&job, 0);
+        }
+        qsort(job.patch, job.count, sizeof(struct _patch), WM_ComparePatches);
+    }
+
+    for (i = 0; i < job.count; i++) {
+        if (job.patch[i].first_sample) entry_count++;
+    }
+    entry = (struct _cache_entry *) calloc((entry_count) ? entry_count : 1, sizeof(struct _cache_entry));
+    tmp_file = (char *) malloc(strlen(cache_file) + 5);
+    if ((entry == NULL) || (tmp_file == NULL)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
+        goto _end;
+    }
+    strcpy(tmp_file, cache_file);
+    strcat(tmp_file, ".tmp");
+
+    if ((out = fopen(tmp_file, "wb")) == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_OPEN, tmp_file, errno);
+        goto _end;
+    }
+
+    /* the header and entries are written again once the sums are known */
+    memset(&header, 0, sizeof(header));
+    memset(pad, 0, sizeof(pad));
+    pos = sizeof(header) + (entry_count * sizeof(struct _cache_entry));
+    if ((fwrite(&header, sizeof(header), 1, out) != 1)
+            || ((entry_count) && (fwrite(entry, (entry_count * sizeof(struct _cache_entry)), 1, out) != 1))
+            || ((WM_CACHE_ROUND(pos) != pos) && (fwrite(pad, (WM_CACHE_ROUND(pos) - pos), 1, out) != 1))) {
+        goto _write_error;
+    }
+    pos = WM_CACHE_ROUND(pos);
+
+    for (i = 0, count = 0; i < job.count; i++) {
+        struct _cache_entry *e;
+
+        if (!job.patch[i].first_sample) continue;
+        e = &entry[count++];
+        if ((block = WM_CacheBlock(&job.patch[i], &size, &e->sample_count)) == NULL) {
+            _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
+            goto _end;
+        }
+        if ((size > WM_MAXFILESIZE) || (pos > (WM_MAXFILESIZE - size))) {
+            _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_LONGFIL, cache_file, 0);
+            free(block);
+            goto _end;
+        }
+        e->patchid = job.patch[i].patchid;
+        e->amp = job.patch[i].amp;
+        e->offset = pos;
+        e->size = size;
+        e->sum = WM_CacheSum(block, size);
+        if (fwrite(block, size, 1, out) != 1) {
+            free(block);
+            goto _write_error;
+        }
+        free(block);
+        pos += size;
+    }
+
+    memcpy(header.magic, WM_CACHE_MAGIC, 8);
+    header.version = WM_CACHE_VERSION;
+    header.byte_order = WM_CACHE_BYTE_ORDER;
+    header.rate = patches->rate;
+    header.config_hash = patches->config_hash;
+    header.patch_count = entry_count;
+    header.entry_sum = WM_CacheSum(entry, (entry_count * sizeof(struct _cache_entry)));
+    if ((fseek(out, 0, SEEK_SET) != 0)
+            || (fwrite(&header, sizeof(header), 1, out) != 1)
+            || ((entry_count) && (fwrite(entry, (entry_count * sizeof(struct _cache_entry)), 1, out) != 1))) {
+        goto _write_error;
+    }
+    if (fclose(out) != 0) {
+        out = NULL;
+        goto _write_error;
+    }
+    out = NULL;
+
+#ifdef _WIN32
+    /* rename() does not replace files there */
+    remove(cache_file);
+#endif
+    if (rename(tmp_file, cache_file) != 0) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_OPEN, cache_file, errno);
+        remove(tmp_file);
+        goto _end;
+    }
+    ret = 0;
+    goto _end;
+
+_write_error:
+    _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_OPEN, tmp_file, errno);
+    if (out) fclose(out);
+    out = NULL;
+    remove(tmp_file);
+
+_end:
+    if (out) {
+        fclose(out);
+        remove(tmp_file);
+    }
+    for (i = 0; i < job.count; i++) {
+        _WM_free_samples(&job.patch[i]);
+    }
+    free(job.patch);
+    free(entry);
+    free(tmp_file);
+    return (ret);
+}
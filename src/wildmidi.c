@@ -28,6 +28,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 #if defined(__DJGPP__)
 #include <sys/types.h>
@@ -42,6 +43,7 @@
 #include <io.h>
 #include <dir.h>
 #ifdef AUDIODRV_DOSSB
+#include <dos.h>
 #include "dossb.h"
 #endif
 
@@ -116,6 +118,11 @@ static int msleep(unsigned long millisec);
 #include <unistd.h>
 #include <getopt.h>
 #include <time.h>
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#define WILDMIDI_OUTPUT_THREAD 1
+#define WILDMIDI_BATCH_THREADS 1
+#endif
 #ifdef AUDIODRV_ALSA
 #  include <alsa/asoundlib.h>
 #elif defined AUDIODRV_OSS
@@ -249,14 +256,26 @@ static int midi_test_max = 1;
 
 static unsigned int rate = 32072;
 
+/* bytes rendered at a time, set from --period */
+static uint32_t render_size = 16384;
+#if defined(AUDIODRV_OSS) || defined(AUDIODRV_ALSA)
+/* frames per device period and milliseconds buffered by the device, 0 for the defaults */
+static unsigned int out_period = 0;
+static unsigned int out_latency = 0;
+#endif
+
 static int (*send_output)(int8_t *output_data, int output_size);
+/* set by drivers rendering straight into the memory of the device, used
+   instead of WildMidi_GetOutput() and send_output, returning as it does */
+static int (*render_output)(midi *handle, int output_size);
 static void (*close_output)(void);
 static void (*pause_output)(void);
 static void (*resume_output)(void);
 
 #define wmidi_geterrno() errno /* generic case */
 #if defined(_WIN32)
-static int audio_fd = -1;
+typedef int wmidi_fd;
+static wmidi_fd audio_fd = -1;
 #define WM_IS_BADF(_fd) ((_fd)<0)
 #define WM_BADF -1
 static inline int wmidi_fileexists (const char *path) {
@@ -276,7 +295,8 @@ static inline int wmidi_write (int fd, const void *buf, size_t size) {
 }
 
 #elif defined(__DJGPP__)
-static int audio_fd = -1;
+typedef int wmidi_fd;
+static wmidi_fd audio_fd = -1;
 #define WM_IS_BADF(_fd) ((_fd)<0)
 #define WM_BADF -1
 static inline int wmidi_fileexists (const char *path) {
@@ -297,7 +317,8 @@ static inline int wmidi_write (int fd, const void *buf, size_t size) {
 }
 
 #elif defined(__OS2__) || defined(__EMX__)
-static int audio_fd = -1;
+typedef int wmidi_fd;
+static wmidi_fd audio_fd = -1;
 #define WM_IS_BADF(_fd) ((_fd)<0)
 #define WM_BADF -1
 static inline int wmidi_fileexists (const char *path) {
@@ -318,7 +339,8 @@ static inline int wmidi_write (int fd, const void *buf, size_t size) {
 }
 
 #elif defined(WILDMIDI_AMIGA)
-static BPTR audio_fd = 0;
+typedef BPTR wmidi_fd;
+static wmidi_fd audio_fd = 0;
 #define WM_IS_BADF(_fd) ((_fd)==0)
 #define WM_BADF 0
 #undef wmidi_geterrno
@@ -355,7 +377,8 @@ static LONG wmidi_write (BPTR fd, /*const*/ void *buf, LONG size) {
 }
 
 #else /* common posix case */
-static int audio_fd = -1;
+typedef int wmidi_fd;
+static wmidi_fd audio_fd = -1;
 #define WM_IS_BADF(_fd) ((_fd)<0)
 #define WM_BADF -1
 static inline int wmidi_fileexists (const char *path) {
@@ -386,26 +409,31 @@ static void resume_output_nop(void) {
  */
 static char midi_file[1024];
 
-static void mk_midifile_name(const char *src) {
+/* dst is 1024 bytes, src with its extension replaced by ext (4 chars) */
+static void mk_output_name(char *dst, const char *src, const char *ext) {
     char *p;
     int len;
 
-    strncpy(midi_file, src, sizeof(midi_file) - 1);
-    midi_file[sizeof(midi_file) - 1] = 0;
+    strncpy(dst, src, 1023);
+    dst[1023] = 0;
 
-    p = strrchr(midi_file, '.');
+    p = strrchr(dst, '.');
     if (p && (len = strlen(p)) <= 4) {
-        if (p - midi_file <= (int)sizeof(midi_file) - 5) {
-            memcpy(p, ".mid", 5);
+        if (p - dst <= 1024 - 5) {
+            memcpy(p, ext, 5);
             return;
         }
     }
 
-    len = strlen(midi_file);
-    if (len > (int)sizeof(midi_file) - 5)
-        len = (int)sizeof(midi_file) - 5;
-    p = &midi_file[len];
-    memcpy(p, ".mid", 5);
+    len = strlen(dst);
+    if (len > 1024 - 5)
+        len = 1024 - 5;
+    p = &dst[len];
+    memcpy(p, ext, 5);
+}
+
+static void mk_midifile_name(const char *src) {
+    mk_output_name(midi_file, src, ".mid");
 }
 
 static int write_midi_output(void *output_data, int output_size) {
@@ -448,7 +476,7 @@ static uint32_t wav_size;
 static int write_wav_output(int8_t *output_data, int output_size);
 static void close_wav_output(void);
 
-static int open_wav_output(void) {
+static int write_wav_header(wmidi_fd fd) {
     uint8_t wav_hdr[] = {
         0x52, 0x49, 0x46, 0x46, /* "RIFF"  */
         0x00, 0x00, 0x00, 0x00, /* riffsize: pcm size + 36 (filled when closing.) */
@@ -464,7 +492,52 @@ static int open_wav_output(void) {
         0x64, 0x61, 0x74, 0x61, /* "data"  */
         0x00, 0x00, 0x00, 0x00  /* datasize: the pcm size (filled when closing.)  */
     };
+    uint32_t bytes_per_sec;
+
+    wav_hdr[24] = (rate) & 0xFF;
+    wav_hdr[25] = (rate >> 8) & 0xFF;
+
+    bytes_per_sec = rate * 4;
+    wav_hdr[28] = (bytes_per_sec) & 0xFF;
+    wav_hdr[29] = (bytes_per_sec >> 8) & 0xFF;
+    wav_hdr[30] = (bytes_per_sec >> 16) & 0xFF;
+    wav_hdr[31] = (bytes_per_sec >> 24) & 0xFF;
+
+    if (wmidi_write(fd, wav_hdr, 44) < 0) {
+        fprintf(stderr, "ERROR: failed writing wav header (%s)\r\n", strerror(wmidi_geterrno()));
+        return (-1);
+    }
+    return (0);
+}
+
+/* fills in the sizes left out by write_wav_header() */
+static int finish_wav_header(wmidi_fd fd, uint32_t size) {
+    uint8_t wav_count[4];
 
+    wav_count[0] = (size) & 0xFF;
+    wav_count[1] = (size >> 8) & 0xFF;
+    wav_count[2] = (size >> 16) & 0xFF;
+    wav_count[3] = (size >> 24) & 0xFF;
+    wmidi_seekset(fd, 40);
+    if (wmidi_write(fd, wav_count, 4) < 0) {
+        fprintf(stderr, "\nERROR: failed writing wav (%s)\r\n", strerror(wmidi_geterrno()));
+        return (-1);
+    }
+
+    size += 36;
+    wav_count[0] = (size) & 0xFF;
+    wav_count[1] = (size >> 8) & 0xFF;
+    wav_count[2] = (size >> 16) & 0xFF;
+    wav_count[3] = (size >> 24) & 0xFF;
+    wmidi_seekset(fd, 4);
+    if (wmidi_write(fd, wav_count, 4) < 0) {
+        fprintf(stderr, "\nERROR: failed writing wav (%s)\r\n", strerror(wmidi_geterrno()));
+        return (-1);
+    }
+    return (0);
+}
+
+static int open_wav_output(void) {
     if (wav_file[0] == '\0')
         return (-1);
 
@@ -472,21 +545,9 @@ static int open_wav_output(void) {
     if (WM_IS_BADF(audio_fd)) {
         fprintf(stderr, "Error: unable to open file for writing (%s)\r\n", strerror(wmidi_geterrno()));
         return (-1);
-    } else {
-        uint32_t bytes_per_sec;
-
-        wav_hdr[24] = (rate) & 0xFF;
-        wav_hdr[25] = (rate >> 8) & 0xFF;
-
-        bytes_per_sec = rate * 4;
-        wav_hdr[28] = (bytes_per_sec) & 0xFF;
-        wav_hdr[29] = (bytes_per_sec >> 8) & 0xFF;
-        wav_hdr[30] = (bytes_per_sec >> 16) & 0xFF;
-        wav_hdr[31] = (bytes_per_sec >> 24) & 0xFF;
     }
 
-    if (wmidi_write(audio_fd, wav_hdr, 44) < 0) {
-        fprintf(stderr, "ERROR: failed writing wav header (%s)\r\n", strerror(wmidi_geterrno()));
+    if (write_wav_header(audio_fd) < 0) {
         wmidi_close(audio_fd);
         audio_fd = WM_BADF;
         return (-1);
@@ -521,36 +582,341 @@ static int write_wav_output(int8_t *output_data, int output_size) {
 }
 
 static void close_wav_output(void) {
-    uint8_t wav_count[4];
     if (WM_IS_BADF(audio_fd))
         return;
 
     printf("Finishing and closing wav output\r");
-    wav_count[0] = (wav_size) & 0xFF;
-    wav_count[1] = (wav_size >> 8) & 0xFF;
-    wav_count[2] = (wav_size >> 16) & 0xFF;
-    wav_count[3] = (wav_size >> 24) & 0xFF;
-    wmidi_seekset(audio_fd, 40);
-    if (wmidi_write(audio_fd, wav_count, 4) < 0) {
-        fprintf(stderr, "\nERROR: failed writing wav (%s)\r\n", strerror(wmidi_geterrno()));
-        goto end;
+    finish_wav_header(audio_fd, wav_size);
+    printf("\n");
+    wmidi_close(audio_fd);
+    audio_fd = WM_BADF;
+}
+
+/*
+ Batch Output Functions, called on the render threads of the library
+ */
+
+/* gathered so the file is written in few, large pieces */
+#define BATCH_WAV_BUFFER 262144
+
+struct _batch_wav {
+    wmidi_fd fd;
+    uint32_t size;
+    uint32_t fill;
+    int8_t buffer[BATCH_WAV_BUFFER];
+};
+
+/* what the sink wrote, for the realtime factor at the end */
+static uint64_t batch_frames = 0;
+#ifdef WILDMIDI_BATCH_THREADS
+static pthread_mutex_t batch_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static void *open_batch_wav(void *user, uint32_t job, const char *midifile, const struct _WM_Info *info) {
+    struct _batch_wav *wav;
+    char name[1024];
+
+    /* unused params */
+    (void)user;
+    (void)job;
+
+    if (info == NULL) {
+        /* the error itself may be gone by now, replaced by the next one */
+        fprintf(stderr, "Failed opening %s\r\n", midifile);
+        return (NULL);
     }
+    wav = (struct _batch_wav *) malloc(sizeof(struct _batch_wav));
+    if (wav == NULL) {
+        fprintf(stderr, "Not enough memory for %s\r\n", midifile);
+        return (NULL);
+    }
+
+    mk_output_name(name, midifile, ".wav");
+    wav->fd = wmidi_open_write(name);
+    if (WM_IS_BADF(wav->fd)) {
+        fprintf(stderr, "Error: unable to open %s for writing (%s)\r\n", name, strerror(wmidi_geterrno()));
+        free(wav);
+        return (NULL);
+    }
+    if (write_wav_header(wav->fd) < 0) {
+        wmidi_close(wav->fd);
+        free(wav);
+        return (NULL);
+    }
+    wav->size = 0;
+    wav->fill = 0;
+    printf("Rendering %s\r\n", name);
+    return (wav);
+}
 
-    wav_size += 36;
-    wav_count[0] = (wav_size) & 0xFF;
-    wav_count[1] = (wav_size >> 8) & 0xFF;
-    wav_count[2] = (wav_size >> 16) & 0xFF;
-    wav_count[3] = (wav_size >> 24) & 0xFF;
-    wmidi_seekset(audio_fd, 4);
-    if (wmidi_write(audio_fd, wav_count, 4) < 0) {
+static int flush_batch_wav(struct _batch_wav *wav) {
+    if (wav->fill == 0)
+        return (0);
+    if (wmidi_write(wav->fd, wav->buffer, wav->fill) < 0) {
         fprintf(stderr, "\nERROR: failed writing wav (%s)\r\n", strerror(wmidi_geterrno()));
-        goto end;
+        return (-1);
     }
+    wav->size += wav->fill;
+    wav->fill = 0;
+    return (0);
+}
 
-end:    printf("\n");
-    if (!WM_IS_BADF(audio_fd))
-        wmidi_close(audio_fd);
-    audio_fd = WM_BADF;
+static int write_batch_wav(void *out, const void *data, uint32_t frames) {
+    struct _batch_wav *wav = (struct _batch_wav *) out;
+    const int8_t *src = (const int8_t *) data;
+    uint32_t bytes = frames * 4;
+    uint32_t n;
+#ifdef WORDS_BIGENDIAN
+    uint32_t i;
+#endif
+
+    while (bytes) {
+        if (wav->fill == BATCH_WAV_BUFFER && flush_batch_wav(wav) < 0)
+            return (-1);
+        n = BATCH_WAV_BUFFER - wav->fill;
+        if (n > bytes)
+            n = bytes;
+#ifdef WORDS_BIGENDIAN
+/* libWildMidi outputs host-endian, *.wav must have little-endian. */
+        for (i = 0; i < n; i += 2) {
+            wav->buffer[wav->fill + i] = src[i + 1];
+            wav->buffer[wav->fill + i + 1] = src[i];
+        }
+#else
+        memcpy(&wav->buffer[wav->fill], src, n);
+#endif
+        wav->fill += n;
+        src += n;
+        bytes -= n;
+    }
+    return (0);
+}
+
+static void close_batch_wav(void *out, int status) {
+    struct _batch_wav *wav = (struct _batch_wav *) out;
+
+    (void)status; /* unused param, a song cut short is kept as far as it got */
+
+    flush_batch_wav(wav);
+#ifdef WILDMIDI_BATCH_THREADS
+    pthread_mutex_lock(&batch_lock);
+#endif
+    batch_frames += wav->size / 4;
+#ifdef WILDMIDI_BATCH_THREADS
+    pthread_mutex_unlock(&batch_lock);
+#endif
+    finish_wav_header(wav->fd, wav->size);
+    wmidi_close(wav->fd);
+    free(wav);
+}
+
+static const struct _WM_BatchSink batch_wav_sink = {
+    open_batch_wav,
+    write_batch_wav,
+    close_batch_wav
+};
+
+/*
+ Batch Conversion Functions, each file converted with a single call so
+ that any number of them can run at once
+ */
+
+#define MAX_BATCH_THREADS 64
+
+struct _batch_cvt {
+    char **files;
+    uint32_t count;
+    const struct _WM_CvtOptions *options;
+
+    /* under lock */
+    uint32_t next;
+    uint32_t failed;
+    unsigned long int bytes;
+#ifdef WILDMIDI_BATCH_THREADS
+    pthread_mutex_t lock;
+#endif
+};
+
+/* returns the bytes of midi written, or -1 */
+static long convert_batch_file(const char *file, const struct _WM_CvtOptions *options) {
+    char name[1024];
+    uint8_t *data;
+    uint32_t size;
+    wmidi_fd fd;
+    long ret = -1;
+
+    if (WildMidi_ConvertToMidiOpt(file, &data, &size, options) < 0) {
+        /* the error itself may be gone by now, replaced by the next one */
+        fprintf(stderr, "Failed converting %s\r\n", file);
+        return (-1);
+    }
+
+    mk_output_name(name, file, ".mid");
+    if (wmidi_fileexists(name)) {
+        fprintf(stderr, "Error: %s already exists\r\n", name);
+    } else {
+        fd = wmidi_open_write(name);
+        if (WM_IS_BADF(fd)) {
+            fprintf(stderr, "Error: unable to open %s for writing (%s)\r\n", name, strerror(wmidi_geterrno()));
+        } else {
+            if (wmidi_write(fd, data, size) < 0) {
+                fprintf(stderr, "\nERROR: failed writing %s (%s)\r\n", name, strerror(wmidi_geterrno()));
+            } else {
+                ret = (long) size;
+            }
+            wmidi_close(fd);
+        }
+    }
+
+    free(data);
+    return (ret);
+}
+
+static void *convert_batch_worker(void *data) {
+    struct _batch_cvt *cvt = (struct _batch_cvt *) data;
+    uint32_t i;
+    long size;
+
+    for (;;) {
+#ifdef WILDMIDI_BATCH_THREADS
+        pthread_mutex_lock(&cvt->lock);
+#endif
+        i = cvt->next++;
+#ifdef WILDMIDI_BATCH_THREADS
+        pthread_mutex_unlock(&cvt->lock);
+#endif
+        if (i >= cvt->count)
+            break;
+
+        size = convert_batch_file(cvt->files[i], cvt->options);
+
+#ifdef WILDMIDI_BATCH_THREADS
+        pthread_mutex_lock(&cvt->lock);
+#endif
+        if (size < 0) {
+            cvt->failed++;
+        } else {
+            cvt->bytes += size;
+        }
+#ifdef WILDMIDI_BATCH_THREADS
+        pthread_mutex_unlock(&cvt->lock);
+#endif
+    }
+
+    return (NULL);
+}
+
+/* seconds since some point in the past */
+static double batch_clock(void) {
+#if (defined _WIN32) || (defined __CYGWIN__)
+    return (GetTickCount() / 1000.0);
+#elif defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec + ts.tv_nsec / 1e9);
+#else
+    return ((double) clock() / CLOCKS_PER_SEC);
+#endif
+}
+
+/* how fast the songs rendered, in seconds of audio per second taken */
+static void print_realtime_factor(uint32_t done, uint32_t count, uint64_t frames, double secs) {
+    double audio = (double) frames / rate;
+
+    if (secs <= 0.0)
+        secs = 0.001;
+    printf("Rendered %u of %u files, %.1f seconds of audio in %.2f seconds, %.1fx realtime\r\n",
+           done, count, audio, secs, audio / secs);
+}
+
+/* returns how many files failed */
+static uint32_t convert_batch(char **files, uint32_t count, int threads,
+                              const struct _WM_CvtOptions *options) {
+    struct _batch_cvt cvt;
+    double start, secs;
+#ifdef WILDMIDI_BATCH_THREADS
+    pthread_t thread[MAX_BATCH_THREADS];
+    int started = 0;
+    int i;
+
+    if (threads == 0) {
+        long n = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (n > 0) ? (int) n : 1;
+    }
+    if (threads > MAX_BATCH_THREADS) {
+        threads = MAX_BATCH_THREADS;
+    }
+    if ((uint32_t) threads > count) {
+        threads = (int) count;
+    }
+#else
+    /* without thread support the files are converted one after the other */
+    (void)threads;
+#endif
+
+    cvt.files = files;
+    cvt.count = count;
+    cvt.options = options;
+    cvt.next = 0;
+    cvt.failed = 0;
+    cvt.bytes = 0;
+
+    start = batch_clock();
+#ifdef WILDMIDI_BATCH_THREADS
+    pthread_mutex_init(&cvt.lock, NULL);
+    /* this thread is one of the workers */
+    for (i = 1; i < threads; i++) {
+        if (pthread_create(&thread[started], NULL, convert_batch_worker, &cvt) != 0)
+            break;
+        started++;
+    }
+    convert_batch_worker(&cvt);
+    for (i = 0; i < started; i++) {
+        pthread_join(thread[i], NULL);
+    }
+    pthread_mutex_destroy(&cvt.lock);
+#else
+    convert_batch_worker(&cvt);
+#endif
+    secs = batch_clock() - start;
+    if (secs <= 0.0)
+        secs = 0.001;
+
+    printf("Converted %u of %u files to %lu bytes of midi in %.2f seconds, %.1f files/s, %.2f MB/s\r\n",
+           count - cvt.failed, count, cvt.bytes, secs, (count - cvt.failed) / secs,
+           cvt.bytes / secs / (1024.0 * 1024.0));
+    return (cvt.failed);
+}
+
+/* reads file names one per line, for lists too long for the command line */
+static char **read_file_list(FILE *list, uint32_t *count) {
+    char line[1024];
+    char **files = NULL;
+    char **grown;
+    uint32_t alloc = 0;
+    size_t len;
+
+    *count = 0;
+    while (fgets(line, sizeof(line), list) != NULL) {
+        len = strlen(line);
+        while (len && (line[len - 1] == '\n' || line[len - 1] == '\r'))
+            line[--len] = 0;
+        if (!len)
+            continue;
+
+        if (*count == alloc) {
+            alloc = (alloc) ? alloc * 2 : 256;
+            grown = (char **) realloc(files, alloc * sizeof(char *));
+            if (grown == NULL)
+                break;
+            files = grown;
+        }
+        if ((files[*count] = (char *) malloc(len + 1)) == NULL)
+            break;
+        memcpy(files[*count], line, len + 1);
+        (*count)++;
+    }
+    return (files);
 }
 
 #if (defined _WIN32) || (defined __CYGWIN__)
@@ -871,98 +1237,101 @@ close_dart_output (void) {
 /* SoundBlaster/Pro/16/AWE32 driver for DOS -- adapted from
  * libMikMod,  written by Andrew Zabolotny <bit@eltech.ru>,
  * further fixes by O.Sezer <sezero@users.sourceforge.net>.
- * Timer callback functionality replaced by a push mechanism
- * to keep the wildmidi player changes to a minimum, for now.
+ * The DMA buffer plays as two halves: the SB IRQ asks for the
+ * half the DMA just left to be filled again, and the song is
+ * rendered straight into it in the sample format of the card.
  */
 
-/* The last buffer byte filled with sound */
-static unsigned int buff_tail = 0;
-
-static int write_sb_output(int8_t *data, unsigned int siz) {
+/* bit n set: half n of the DMA buffer has played and wants filling */
+static volatile unsigned int sb_refill = 0;
+/* the half being filled and how many bytes of it are */
+static unsigned int sb_half = 0;
+static unsigned int sb_fill = 0;
+/* what the card plays, and its bytes per frame */
+static uint16_t sb_format = WM_FMT_S16;
+static unsigned int sb_frame = 4;
+
+/* called from the SB IRQ, once the DMA crossed into the other half */
+static void sb_refill_request(void) {
     unsigned int dma_size, dma_pos;
-    unsigned int cnt;
 
     sb_query_dma(&dma_size, &dma_pos);
-    /* There isn't much sense in filling less than 256 bytes */
-    dma_pos &= ~255;
-
-    /* If nothing to mix, quit */
-    if (buff_tail == dma_pos)
-        return 0;
-
-    /* If DMA pointer still didn't wrapped around ... */
-    if (dma_pos > buff_tail) {
-        if ((cnt = dma_pos - buff_tail) > siz)
-            cnt = siz;
-        memcpy(sb.dma_buff->linear + buff_tail, data, cnt);
-        buff_tail += cnt;
-        /* If we arrived right to the DMA buffer end, jump to the beginning */
-        if (buff_tail >= dma_size)
-            buff_tail = 0;
-    } else {
-        /* If wrapped around, fill first to the end of buffer */
-        if ((cnt = dma_size - buff_tail) > siz)
-            cnt = siz;
-        memcpy(sb.dma_buff->linear + buff_tail, data, cnt);
-        buff_tail += cnt;
-        siz -= cnt;
-        if (!siz) return cnt;
-
-        /* Now fill from buffer beginning to current DMA pointer */
-        if (dma_pos > siz) dma_pos = siz;
-        data += cnt;
-        cnt += dma_pos;
-
-        memcpy(sb.dma_buff->linear, data, dma_pos);
-        buff_tail = dma_pos;
-    }
-    return cnt;
-}
-
-static int write_sb_s16stereo(int8_t *data, int siz) {
-/* libWildMidi sint16 stereo -> SB16 sint16 stereo */
-    int i;
-    while (1) {
-        i = write_sb_output(data, siz);
-        if ((siz -= i) <= 0) return 0;
-        data += i;
-        /*usleep(100);*/
-    }
-}
-
-static int write_sb_u8stereo(int8_t *data, int siz) {
-/* libWildMidi sint16 stereo -> SB uint8 stereo */
-    int16_t *src = (int16_t *) data;
-    uint8_t *dst = (uint8_t *) data;
-    int i = (siz /= 2);
-    for (; i >= 0; --i) {
-        *dst++ = (*src++ >> 8) + 128;
-    }
-    while (1) {
-        i = write_sb_output(data, siz);
-        if ((siz -= i) <= 0) return 0;
-        data += i;
-        /*usleep(100);*/
-    }
-}
-
-static int write_sb_u8mono(int8_t *data, int siz) {
-/* libWildMidi sint16 stereo -> SB uint8 mono */
-    int16_t *src = (int16_t *) data;
-    uint8_t *dst = (uint8_t *) data;
-    int i = (siz /= 4); int val;
-    for (; i >= 0; --i) {
-    /* do a cheap (left+right)/2 */
-        val  = *src++;
-        val += *src++;
-        *dst++ = (val >> 9) + 128;
-    }
-    while (1) {
-        i = write_sb_output(data, siz);
-        if ((siz -= i) <= 0) return 0;
-        data += i;
-        /*usleep(100);*/
+    sb_refill |= (dma_pos < (dma_size >> 1)) ? 2 : 1;
+}
+
+/* waits for the half to fill to be free, returns where the rest of it
+   starts and sets frames to how many fit there */
+static uint8_t *sb_next_block(unsigned int *frames) {
+    unsigned int half = sb.dma_buff->size >> 1;
+
+    while (!(sb_refill & (1 << sb_half))) {
+        /* the DMA is still playing it */
+    }
+    *frames = (half - sb_fill) / sb_frame;
+    return (sb.dma_buff->linear + (sb_half * half) + sb_fill);
+}
+
+/* frames more of the half are filled, moves on once it is full */
+static void sb_filled(unsigned int frames) {
+    sb_fill += frames * sb_frame;
+    if (sb_fill >= (sb.dma_buff->size >> 1)) {
+        disable();
+        sb_refill &= ~(1 << sb_half);
+        enable();
+        sb_half ^= 1;
+        sb_fill = 0;
+    }
+}
+
+static int render_sb_output(midi *handle, int size) {
+    unsigned int frames;
+    uint8_t *block = sb_next_block(&frames);
+    int res;
+
+    if (frames > (unsigned int) (size >> 2))
+        frames = size >> 2;
+    res = WildMidi_Render(handle, frames, block, sb_format);
+    if (res <= 0)
+        return (res);
+    sb_filled(res);
+    return (res * 4);
+}
+
+/* packs libWildMidi sint16 stereo into the halves, what is pushed
+   rather than rendered is only the silence after a song */
+static int write_sb_output(int8_t *data, int siz) {
+    const int16_t *src = (const int16_t *) data;
+    unsigned int frames, i;
+    uint8_t *dst;
+    int val;
+
+    while (siz >= 4) {
+        dst = sb_next_block(&frames);
+        if (frames > (unsigned int) (siz >> 2))
+            frames = siz >> 2;
+        switch (sb_format) {
+        case WM_FMT_S16:
+            memcpy(dst, src, frames * 4);
+            src += frames * 2;
+            break;
+        case WM_FMT_U8:
+            for (i = 0; i < frames * 2; i++) {
+                *dst++ = (*src++ >> 8) + 128;
+            }
+            break;
+        default:
+            for (i = 0; i < frames; i++) {
+            /* do a cheap (left+right)/2 */
+                val  = *src++;
+                val += *src++;
+                *dst++ = (val >> 9) + 128;
+            }
+            break;
+        }
+        sb_filled(frames);
+        siz -= frames * 4;
     }
+    return (0);
 }
 
 static void sb_silence_s16(void) {
@@ -1001,9 +1370,12 @@ static int open_sb_output(void)
     /* Enable speaker output */
     sb_output(TRUE);
 
-    /* Set our routine to be called during SB IRQs */
-    buff_tail = 0;
-    sb.timer_callback = NULL;/* see above  */
+    /* Set our routine to be called during SB IRQs: the DMA starts
+     * in the first half, so the second is free to fill first. */
+    sb_refill = 2;
+    sb_half = 1;
+    sb_fill = 0;
+    sb.timer_callback = sb_refill_request;
 
     /* Start cyclic DMA transfer */
     if (!sb_start_dma(((sb.caps & SBMODE_16BITS) ? SBMODE_16BITS | SBMODE_SIGNED : 0) |
@@ -1015,22 +1387,27 @@ static int open_sb_output(void)
     }
 
     if (sb.caps & SBMODE_16BITS) { /* can do stereo, too */
-        send_output = write_sb_s16stereo;
+        sb_format = WM_FMT_S16;
+        sb_frame = 4;
         pause_output = sb_silence_s16;
         resume_output = resume_output_nop;
         printf("Sound Blaster 16 or compatible (16 bit, stereo, %u Hz)\n", rate);
     } else if (sb.caps & SBMODE_STEREO) {
-        send_output = write_sb_u8stereo;
+        sb_format = WM_FMT_U8;
+        sb_frame = 2;
         pause_output = sb_silence_u8;
         resume_output = resume_output_nop;
         printf("Sound Blaster Pro or compatible (8 bit, stereo, %u Hz)\n", rate);
     } else {
-        send_output = write_sb_u8mono;
+        sb_format = WM_FMT_U8_MONO;
+        sb_frame = 1;
         pause_output = sb_silence_u8;
         resume_output = resume_output_nop;
         printf("Sound Blaster %c or compatible (8 bit, mono, %u Hz)\n",
                (sb.dspver < SBVER_20)? '1' : '2', rate);
     }
+    send_output = write_sb_output;
+    render_output = render_sb_output;
     close_output = close_sb_output;
 
     return 0;
@@ -1167,6 +1544,8 @@ static int open_alsa_output(void) {
     int err;
     unsigned int alsa_buffer_time;
     unsigned int alsa_period_time;
+    snd_pcm_uframes_t period_size;
+    snd_pcm_uframes_t buffer_size;
     unsigned int r;
 
     if (!pcmname[0]) {
@@ -1210,15 +1589,28 @@ static int open_alsa_output(void) {
         fprintf(stderr, "ALSA: sample rate set to %uHz instead of %u\r\n", rate, r);
     }
 
-    alsa_buffer_time = 500000;
+    alsa_buffer_time = (out_latency) ? out_latency * 1000 : 500000;
     alsa_period_time = 50000;
+    if (!out_latency && out_period) {
+        /* four periods unless told otherwise */
+        alsa_buffer_time = (unsigned int) (((uint64_t) out_period * 4 * 1000000) / rate);
+    }
 
     if ((err = snd_pcm_hw_params_set_buffer_time_near(pcm, hw, &alsa_buffer_time, 0)) < 0) {
         fprintf(stderr, "Set buffer time failed: %s.\r\n", snd_strerror(err));
         goto fail;
     }
 
-    if ((err = snd_pcm_hw_params_set_period_time_near(pcm, hw, &alsa_period_time, 0)) < 0) {
+    if (out_period) {
+        period_size = out_period;
+        err = snd_pcm_hw_params_set_period_size_near(pcm, hw, &period_size, 0);
+    } else {
+        if (out_latency) {
+            alsa_period_time = alsa_buffer_time / 4;
+        }
+        err = snd_pcm_hw_params_set_period_time_near(pcm, hw, &alsa_period_time, 0);
+    }
+    if (err < 0) {
         fprintf(stderr, "Set period time failed: %s.\r\n", snd_strerror(err));
         goto fail;
     }
@@ -1228,8 +1620,18 @@ static int open_alsa_output(void) {
         goto fail;
     }
 
+    snd_pcm_hw_params_get_period_size(hw, &period_size, 0);
+    snd_pcm_hw_params_get_buffer_size(hw, &buffer_size);
+    if (out_period || out_latency) {
+        printf("ALSA: %lu frames per period, %lu frames buffered (%.1f ms)\r\n",
+               (unsigned long) period_size, (unsigned long) buffer_size,
+               ((double) buffer_size * 1000.0) / rate);
+    }
+
     snd_pcm_sw_params_alloca(&sw);
     snd_pcm_sw_params_current(pcm, sw);
+    /* wake up for every period */
+    snd_pcm_sw_params_set_avail_min(pcm, sw, period_size);
     if (snd_pcm_sw_params(pcm, sw) < 0) {
         fprintf(stderr, "Unable to install sw params\r\n");
         goto fail;
@@ -1302,6 +1704,8 @@ static void pause_output_oss(void) {
 }
 
 static int open_oss_output(void) {
+    audio_buf_info info;
+    int fragsize, numfrags;
     int tmp;
     unsigned int r;
 
@@ -1339,12 +1743,35 @@ static int open_oss_output(void) {
         fprintf(stderr, "OSS: sample rate set to %uHz instead of %u\r\n", rate, r);
     }
 
-    tmp = (DEFAULT_NUMFRAGS<<16)|DEFAULT_FRAGSIZE;
+    fragsize = DEFAULT_FRAGSIZE;
+    numfrags = DEFAULT_NUMFRAGS;
+    if (out_period) {
+        /* fragments are a power of two bytes, 4 bytes per frame */
+        for (fragsize = 4; (fragsize < 16) && ((1U << fragsize) < (out_period * 4)); fragsize++)
+            ;
+        numfrags = 4;
+    }
+    if (out_latency) {
+        numfrags = (int) ((((uint64_t) rate * 4 * out_latency) / 1000) >> fragsize);
+        if (numfrags < 2) {
+            numfrags = 2;
+        } else if (numfrags > 0x7FFF) {
+            numfrags = 0x7FFF;
+        }
+    }
+
+    tmp = (numfrags<<16)|fragsize;
     if (ioctl(audio_fd, SNDCTL_DSP_SETFRAGMENT, &tmp) < 0) {
         fprintf(stderr, "ERROR: Unable to set fragment size\r\n");
         goto fail;
     }
 
+    if ((out_period || out_latency) && (ioctl(audio_fd, SNDCTL_DSP_GETOSPACE, &info) == 0)) {
+        printf("OSS: %d frames per fragment, %d frames buffered (%.1f ms)\r\n",
+               info.fragsize / 4, (info.fragsize / 4) * info.fragstotal,
+               ((double) (info.fragsize / 4) * info.fragstotal * 1000.0) / rate);
+    }
+
     send_output = write_oss_output;
     close_output = close_oss_output;
     pause_output = pause_output_oss;
@@ -1513,6 +1940,379 @@ static int open_noaudio_output(void) {
 #endif /* AUDIODRV_ALSA */
 #endif /* _WIN32 || __CYGWIN__ */
 
+#ifdef WILDMIDI_OUTPUT_THREAD
+/*
+ Output Thread
+ The main loop renders into a ring buffer and a thread of its own feeds the
+ audio driver from it, so a slow render does not starve the device and a
+ stalled device does not hold up the keyboard.
+ */
+
+#if defined(HAVE___ATOMIC_BUILTINS)
+#define ring_load(p)        __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define ring_store(p,v)     __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#else
+#define ring_load(p)        (*(volatile uint32_t *)(p))
+#define ring_store(p,v)     (*(volatile uint32_t *)(p) = (v))
+#endif
+
+/* milliseconds of audio the ring holds, 0 to write from the main loop */
+static unsigned int ring_ms = 500;
+
+static struct {
+    int8_t *data;
+    uint32_t size;      /* a power of 2, so the counts wrap with it */
+    /* byte counts, head only moved by the main loop, tail by the thread */
+    uint32_t head;
+    uint32_t tail;
+    /* under mutex, which is only taken to sleep and wake */
+    int stop;
+    int paused;
+    int failed;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    pthread_t thread;
+} ring;
+
+static int (*device_output)(int8_t *output_data, int output_size);
+static void (*device_close)(void);
+static void (*device_pause)(void);
+static void (*device_resume)(void);
+
+static void ring_wake(void) {
+    pthread_mutex_lock(&ring.mutex);
+    pthread_cond_broadcast(&ring.cond);
+    pthread_mutex_unlock(&ring.mutex);
+}
+
+static void *ring_thread(void *arg) {
+    uint32_t tail = ring.tail;
+    uint32_t head, ofs, n;
+    int paused = 0;
+    int stop;
+
+    (void)arg; /* unused param */
+
+    for (;;) {
+        pthread_mutex_lock(&ring.mutex);
+        for (;;) {
+            head = ring_load(&ring.head);
+            if ((ring.paused != paused) || ring.stop || (!paused && (head != tail))) {
+                break;
+            }
+            pthread_cond_wait(&ring.cond, &ring.mutex);
+        }
+        if (ring.paused != paused) {
+            paused = ring.paused;
+            pthread_mutex_unlock(&ring.mutex);
+            if (paused) {
+                device_pause();
+            } else {
+                device_resume();
+            }
+            continue;
+        }
+        stop = ring.stop;
+        pthread_mutex_unlock(&ring.mutex);
+        if (head == tail) {
+            if (stop) {
+                break;
+            }
+            continue;
+        }
+
+        ofs = tail & (ring.size - 1);
+        n = head - tail;
+        if (n > ring.size - ofs) {
+            n = ring.size - ofs;
+        }
+        if (n > render_size) {
+            n = render_size;
+        }
+        if (device_output(&ring.data[ofs], n) < 0) {
+            pthread_mutex_lock(&ring.mutex);
+            ring.failed = 1;
+            pthread_cond_broadcast(&ring.cond);
+            pthread_mutex_unlock(&ring.mutex);
+            break;
+        }
+        tail += n;
+        ring_store(&ring.tail, tail);
+        ring_wake();
+    }
+    return (NULL);
+}
+
+static int write_ring_output(int8_t *output_data, int output_size) {
+    uint32_t head = ring.head;
+    uint32_t ofs, n;
+
+    while (output_size > 0) {
+        pthread_mutex_lock(&ring.mutex);
+        while (!ring.failed && ((head - ring_load(&ring.tail)) == ring.size)) {
+            pthread_cond_wait(&ring.cond, &ring.mutex);
+        }
+        if (ring.failed) {
+            pthread_mutex_unlock(&ring.mutex);
+            return (-1);
+        }
+        pthread_mutex_unlock(&ring.mutex);
+
+        ofs = head & (ring.size - 1);
+        n = ring.size - (head - ring_load(&ring.tail));
+        if (n > ring.size - ofs) {
+            n = ring.size - ofs;
+        }
+        if (n > (uint32_t) output_size) {
+            n = output_size;
+        }
+        memcpy(&ring.data[ofs], output_data, n);
+        output_data += n;
+        output_size -= n;
+        head += n;
+        ring_store(&ring.head, head);
+        ring_wake();
+    }
+    return (0);
+}
+
+static void ring_set_pause(int paused) {
+    pthread_mutex_lock(&ring.mutex);
+    ring.paused = paused;
+    pthread_cond_broadcast(&ring.cond);
+    pthread_mutex_unlock(&ring.mutex);
+}
+
+static void pause_ring_output(void) {
+    ring_set_pause(1);
+}
+
+static void resume_ring_output(void) {
+    ring_set_pause(0);
+}
+
+/* plays what is left in the ring before closing the driver */
+static void close_ring_output(void) {
+    pthread_mutex_lock(&ring.mutex);
+    ring.stop = 1;
+    ring.paused = 0;
+    pthread_cond_broadcast(&ring.cond);
+    pthread_mutex_unlock(&ring.mutex);
+    pthread_join(ring.thread, NULL);
+
+    pthread_cond_destroy(&ring.cond);
+    pthread_mutex_destroy(&ring.mutex);
+    free(ring.data);
+    ring.data = NULL;
+    device_close();
+}
+
+/* moves the opened driver behind a ring buffer of ms milliseconds */
+static int open_ring_output(unsigned int ms) {
+    uint32_t want = (uint32_t) (((uint64_t) rate * ms) / 1000) * 4;
+    uint32_t size = 1;
+
+    if (want < (render_size * 2)) {
+        want = render_size * 2;
+    }
+    while (size < want) {
+        size <<= 1;
+    }
+    ring.data = (int8_t *) malloc(size);
+    if (ring.data == NULL) {
+        return (-1);
+    }
+    ring.size = size;
+    ring.head = 0;
+    ring.tail = 0;
+    ring.stop = 0;
+    ring.paused = 0;
+    ring.failed = 0;
+    if (pthread_mutex_init(&ring.mutex, NULL) != 0) {
+        goto fail;
+    }
+    if (pthread_cond_init(&ring.cond, NULL) != 0) {
+        pthread_mutex_destroy(&ring.mutex);
+        goto fail;
+    }
+
+    device_output = send_output;
+    device_close = close_output;
+    device_pause = pause_output;
+    device_resume = resume_output;
+    if (pthread_create(&ring.thread, NULL, ring_thread, NULL) != 0) {
+        pthread_cond_destroy(&ring.cond);
+        pthread_mutex_destroy(&ring.mutex);
+        goto fail;
+    }
+
+    /* the ring only takes what is pushed */
+    render_output = NULL;
+    send_output = write_ring_output;
+    close_output = close_ring_output;
+    pause_output = pause_ring_output;
+    resume_output = resume_ring_output;
+    return (0);
+
+fail:
+    free(ring.data);
+    ring.data = NULL;
+    return (-1);
+}
+#endif /* WILDMIDI_OUTPUT_THREAD */
+
+#ifdef WILDMIDI_TRACE
+/*
+ * --trace writes what the library traced of the songs played to a file
+ * in the Chrome trace event format, which chrome://tracing and Perfetto
+ * load. Each song is a process of its own, the threads patches were
+ * loaded on threads of it.
+ */
+static char trace_file[1024];
+static FILE *trace_out = NULL;
+static uint64_t trace_start = 0;
+static uint32_t trace_count = 0;
+static int trace_song = 0;
+
+static const char *trace_name(uint8_t type) {
+    switch (type) {
+    case WM_TRACE_NOTE_ON:    return ("note on");
+    case WM_TRACE_NOTE_OFF:   return ("note off");
+    case WM_TRACE_EVENT:      return ("event");
+    case WM_TRACE_PATCH_LOAD: return ("patch load");
+    case WM_TRACE_MIX:        return ("mix");
+    }
+    return ("unknown");
+}
+
+static int open_trace_output(void) {
+    trace_out = fopen(trace_file, "w");
+    if (trace_out == NULL) {
+        fprintf(stderr, "Error: unable to open %s for writing (%s)\r\n", trace_file, strerror(errno));
+        return (-1);
+    }
+    fprintf(trace_out, "{\"traceEvents\":[");
+    return (0);
+}
+
+/* writes out what is in the trace of handle so far */
+static void write_trace_output(midi *handle) {
+    struct _WM_TraceEvent events[256];
+    struct _WM_TraceEvent *event;
+    static const char phase[3] = { 'i', 'B', 'E' };
+    int count, i;
+
+    if (trace_out == NULL) {
+        return;
+    }
+    while ((count = WildMidi_ReadTrace(handle, events, 256)) > 0) {
+        for (i = 0; i < count; i++) {
+            event = &events[i];
+            if (trace_count == 0) {
+                trace_start = event->time;
+            }
+            fprintf(trace_out, "%s\n{\"name\":\"%s\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":%d,\"tid\":%u,",
+                    (trace_count++) ? "," : "", trace_name(event->type), phase[event->phase % 3],
+                    (double) (int64_t) (event->time - trace_start) / 1000.0, trace_song, event->thread);
+            if (event->phase == WM_TRACE_INSTANT) {
+                fprintf(trace_out, "\"s\":\"t\",");
+            }
+            if (event->type == WM_TRACE_NOTE_ON) {
+                fprintf(trace_out, "\"args\":{\"channel\":%u,\"note\":%u,\"velocity\":%u}}",
+                        event->channel, event->arg >> 8, event->arg & 0xff);
+            } else {
+                fprintf(trace_out, "\"args\":{\"channel\":%u,\"arg\":%u}}", event->channel, event->arg);
+            }
+        }
+    }
+}
+
+static void close_trace_output(void) {
+    if (trace_out == NULL) {
+        return;
+    }
+    fprintf(trace_out, "\n]}\n");
+    if (fclose(trace_out) != 0) {
+        fprintf(stderr, "\nERROR: failed writing trace (%s)\r\n", strerror(errno));
+    }
+    trace_out = NULL;
+}
+#endif /* WILDMIDI_TRACE */
+
+/* frames rendered at a time by render_headless() */
+#define HEADLESS_FRAMES 65536
+
+/*
+ * --headless renders the files one after the other to the wav file opened
+ * for --wavout, as fast as they go: in large blocks, without the key
+ * controls or the progress display of playback. Returns how many failed.
+ */
+static uint32_t render_headless(char **files, uint32_t count,
+                                unsigned long int play_from, unsigned long int play_to) {
+    int8_t *buffer;
+    void *midi_ptr;
+    struct _WM_Info *wm_info;
+    unsigned long int seek_to;
+    uint32_t frames, failed = 0;
+    uint64_t total = 0;
+    double start;
+    uint32_t i;
+    int res;
+
+    buffer = (int8_t *) malloc(HEADLESS_FRAMES * 4);
+    if (buffer == NULL) {
+        fprintf(stderr, "Not enough memory, exiting\n");
+        return (count);
+    }
+
+    start = batch_clock();
+    for (i = 0; i < count; i++) {
+        WildMidi_ClearError();
+        midi_ptr = WildMidi_Open(files[i]);
+        if (midi_ptr == NULL) {
+            fprintf(stderr, "Skipping %s: %s\r\n", files[i], WildMidi_GetError());
+            failed++;
+            continue;
+        }
+        printf("Rendering %s\r\n", files[i]);
+
+        if (play_from != 0) {
+            seek_to = play_from;
+            WildMidi_FastSeek(midi_ptr, &seek_to);
+        }
+        for (;;) {
+            frames = HEADLESS_FRAMES;
+            if (play_to > play_from) {
+                wm_info = WildMidi_GetInfo(midi_ptr);
+                if (wm_info->current_sample >= play_to)
+                    break;
+                if ((play_to - wm_info->current_sample) < frames)
+                    frames = play_to - wm_info->current_sample;
+            }
+            res = WildMidi_Render(midi_ptr, frames, buffer, WM_FMT_S16);
+#ifdef WILDMIDI_TRACE
+            write_trace_output(midi_ptr);
+#endif
+            if (res <= 0)
+                break;
+            if (write_wav_output(buffer, res * 4) < 0) {
+                WildMidi_Close(midi_ptr);
+                free(buffer);
+                return (failed + (count - i));
+            }
+            total += res;
+        }
+#ifdef WILDMIDI_TRACE
+        trace_song++;
+#endif
+        WildMidi_Close(midi_ptr);
+    }
+
+    print_realtime_factor(count - failed, count, total, batch_clock() - start);
+    free(buffer);
+    return (failed);
+}
+
 static struct option const long_options[] = {
     { "version", 0, 0, 'v' },
     { "help", 0, 0, 'h' },
@@ -1534,9 +2334,25 @@ static struct option const long_options[] = {
 #endif
     { "roundtempo", 0, 0, 'n' },
     { "skipsilentstart", 0, 0, 's' },
+    { "stream", 0, 0, 'S' },
+    { "prune", 0, 0, 'z' },
     { "textaslyric", 0, 0, 'a' },
     { "playfrom", 1, 0, 'i'},
     { "playto", 1, 0, 'j'},
+    { "write_cache", 1, 0, 'C'},
+    { "render-batch", 1, 0, 'B'},
+    { "headless", 0, 0, 'H'},
+    { "convert-batch", 1, 0, 'X'},
+#ifdef WILDMIDI_TRACE
+    { "trace", 1, 0, 'T'},
+#endif
+#ifdef WILDMIDI_OUTPUT_THREAD
+    { "buffer", 1, 0, 'u'},
+#endif
+#if defined(AUDIODRV_OSS) || defined(AUDIODRV_ALSA)
+    { "period", 1, 0, 'P'},
+    { "latency", 1, 0, 'L'},
+#endif
     { NULL, 0, NULL, 0 }
 };
 
@@ -1545,10 +2361,18 @@ static void do_help(void) {
     printf("  -h    --help        Display this help and exit\n");
 #if defined(AUDIODRV_OSS) || defined(AUDIODRV_ALSA)
     printf("  -d D  --device=D    Use device D for audio output instead of default\n");
+    printf("  -P N  --period=N    Render and write to the device N frames at a time\n");
+    printf("  -L M  --latency=M   Have the device buffer M milliseconds of audio\n");
+#endif
+#ifdef WILDMIDI_OUTPUT_THREAD
+    printf("  -u M  --buffer=M    Buffer M milliseconds of audio for the output thread\n");
+    printf("                      default is %u, 0 writes to the device directly\n", ring_ms);
 #endif
     printf("MIDI Options:\n");
     printf("  -n    --roundtempo  Round tempo to nearest whole number\n");
     printf("  -s    --skipsilentstart Skips any silence at the start of playback\n");
+    printf("  -S    --stream      Read MIDI files as they play instead of all at once\n");
+    printf("  -z    --prune       Drop the events that cannot be heard after reading\n");
     printf("  -t    --test_midi   Listen to test MIDI\n");
     printf("Non-MIDI Options:\n");
     printf("  -x    --tomidi      Convert file to midi and save to file\n");
@@ -1556,6 +2380,9 @@ static void do_help(void) {
     printf("                                   1 - MT32 to GM\n");
     printf("                                   2 - MT32 to GS\n");
     printf("  -f F  --frequency=F Use frequency F Hz for playback (MUS)\n");
+    printf("  -X N  --convert-batch=N Convert every file given to a midi file of the\n");
+    printf("                      same name on N threads, 0 for one per cpu, and exit,\n");
+    printf("                      '-' as the only file reads the names from stdin\n");
     printf("Software Wavetable Options:\n");
     printf("  -o W  --wavout=W    Save output to W in 16bit stereo format wav file\n");
     printf("  -l    --log_vol     Use log volume adjustments\n");
@@ -1564,6 +2391,16 @@ static void do_help(void) {
     printf("                      defaults to: %s\n", WILDMIDI_CFG);
     printf("  -m V  --mastervol=V Set the master volume (0..127), default is 100\n");
     printf("  -b    --reverb      Enable final output reverb engine\n");
+#ifdef WILDMIDI_TRACE
+    printf("  -T F  --trace=F     Save a trace of notes, events, patch loads and mixing\n");
+    printf("                      to F in the Chrome trace format\n");
+#endif
+    printf("  -C F  --write_cache=F Write the samples of the config to cache file F\n");
+    printf("                      and exit, '-' for the sample_cache of the config\n");
+    printf("  -B N  --render-batch=N Save every file given to a wav file of the same\n");
+    printf("                      name on N threads, 0 for one per cpu, and exit\n");
+    printf("  -H    --headless    With -o render straight to the wav file, without\n");
+    printf("                      the key controls or the progress display, and exit\n");
 }
 
 static void do_version(void) {
@@ -1582,6 +2419,8 @@ static void do_syntax(void) {
 }
 
 static char config_file[1024];
+static char cache_file[1024];
+static struct _WM_CvtOptions cvt_options = { 0, 0 };
 
 int main(int argc, char **argv) {
     struct _WM_Info *wm_info;
@@ -1621,6 +2460,13 @@ int main(int argc, char **argv) {
 
     unsigned long int play_from = 0;
     unsigned long int play_to = 0;
+    int batch_threads = -1;
+    double batch_start;
+    int headless = 0;
+    int convert_threads = -1;
+#ifdef WILDMIDI_OUTPUT_THREAD
+    int ring_set = 0;
+#endif
 
     memset(lyrics,' ',MAX_LYRIC_CHAR);
     memset(display_lyrics,' ',MAX_DISPLAY_LYRICS);
@@ -1634,7 +2480,7 @@ int main(int argc, char **argv) {
 
     do_version();
     while (1) {
-        i = getopt_long(argc, argv, "0vho:tx:g:f:lr:c:m:btak:p:ed:nsi:j:", long_options,
+        i = getopt_long(argc, argv, "0vho:tx:g:f:lr:c:m:btak:p:ed:nsSzi:j:C:B:HX:u:P:L:T:", long_options,
                 &option_index);
         if (i == -1)
             break;
@@ -1668,10 +2514,12 @@ int main(int argc, char **argv) {
             wav_file[sizeof(wav_file) - 1] = 0;
             break;
         case 'g': /* XMIDI Conversion */
-            WildMidi_SetCvtOption(WM_CO_XMI_TYPE, (uint16_t) atoi(optarg));
+            cvt_options.xmi_convert_type = (uint16_t) atoi(optarg);
+            WildMidi_SetCvtOption(WM_CO_XMI_TYPE, cvt_options.xmi_convert_type);
             break;
         case 'f': /* MIDI-like Conversion */
-            WildMidi_SetCvtOption(WM_CO_FREQUENCY, (uint16_t) atoi(optarg));
+            cvt_options.frequency = (uint16_t) atoi(optarg);
+            WildMidi_SetCvtOption(WM_CO_FREQUENCY, cvt_options.frequency);
             break;
         case 'x': /* MIDI Output */
             if (!*optarg) {
@@ -1725,6 +2573,12 @@ int main(int argc, char **argv) {
         case 's': /* strip silence at start */
             mixer_options |= WM_MO_STRIPSILENCE;
             break;
+        case 'S': /* convert midi files while they play */
+            mixer_options |= WM_MO_STREAM;
+            break;
+        case 'z': /* drop the events that cannot be heard */
+            mixer_options |= WM_MO_PRUNEEVENTS;
+            break;
         case '0': /* treat as type 2 midi when writing to file */
             mixer_options |= WM_MO_SAVEASTYPE0;
             break;
@@ -1734,13 +2588,80 @@ int main(int argc, char **argv) {
         case 'j':
             play_to = (unsigned long int)(atof(optarg) * (double)rate);
             break;
+        case 'C': /* Sample cache */
+            if (!*optarg) {
+                fprintf(stderr, "Error: empty cache file name.\n");
+                return (1);
+            }
+            strncpy(cache_file, optarg, sizeof(cache_file));
+            cache_file[sizeof(cache_file) - 1] = 0;
+            break;
+        case 'B': /* Render files to wav on several threads */
+            res = atoi(optarg);
+            if (res < 0 || res > 255) {
+                fprintf(stderr, "Error: bad thread count %i.\n", res);
+                return (1);
+            }
+            batch_threads = res;
+            break;
+        case 'H': /* Render to the wav file without the player */
+            headless = 1;
+            break;
+        case 'X': /* Convert files to midi on several threads */
+            res = atoi(optarg);
+            if (res < 0 || res > 255) {
+                fprintf(stderr, "Error: bad thread count %i.\n", res);
+                return (1);
+            }
+            convert_threads = res;
+            break;
+#ifdef WILDMIDI_TRACE
+        case 'T': /* Trace file */
+            if (!*optarg) {
+                fprintf(stderr, "Error: empty trace file name.\n");
+                return (1);
+            }
+            strncpy(trace_file, optarg, sizeof(trace_file));
+            trace_file[sizeof(trace_file) - 1] = 0;
+            break;
+#endif
+#ifdef WILDMIDI_OUTPUT_THREAD
+        case 'u': /* Output thread buffer */
+            res = atoi(optarg);
+            if (res < 0 || res > 60000) {
+                fprintf(stderr, "Error: bad buffer length %i.\n", res);
+                return (1);
+            }
+            ring_ms = (unsigned int) res;
+            ring_set = 1;
+            break;
+#endif
+#if defined(AUDIODRV_OSS) || defined(AUDIODRV_ALSA)
+        case 'P': /* Device period */
+            res = atoi(optarg);
+            if (res < 16 || res > 4096) {
+                fprintf(stderr, "Error: bad period %i, use 16 to 4096 frames.\n", res);
+                return (1);
+            }
+            out_period = (unsigned int) res;
+            render_size = out_period * 4;
+            break;
+        case 'L': /* Device latency */
+            res = atoi(optarg);
+            if (res < 1 || res > 10000) {
+                fprintf(stderr, "Error: bad latency %i.\n", res);
+                return (1);
+            }
+            out_latency = (unsigned int) res;
+            break;
+#endif
         default:
             do_syntax();
             return (1);
         }
     }
 
-    if (optind >= argc && !test_midi) {
+    if (optind >= argc && !test_midi && !cache_file[0]) {
         fprintf(stderr, "ERROR: No midi file given\r\n");
         do_syntax();
         return (1);
@@ -1752,6 +2673,48 @@ int main(int argc, char **argv) {
             return (1);
         }
     }
+    if (batch_threads >= 0) {
+        if (test_midi || midi_file[0] != '\0' || wav_file[0] != '\0') {
+            fprintf(stderr, "--render-batch cannot be used with --test_midi, --tomidi or --wavout.\n");
+            return (1);
+        }
+    }
+    if (headless) {
+        if (wav_file[0] == '\0' || test_midi || midi_file[0] != '\0') {
+            fprintf(stderr, "--headless needs --wavout and cannot be used with --test_midi or --tomidi.\n");
+            return (1);
+        }
+    }
+    if (convert_threads >= 0) {
+        if (test_midi || batch_threads >= 0 || midi_file[0] != '\0' || wav_file[0] != '\0') {
+            fprintf(stderr, "--convert-batch cannot be used with --test_midi, --render-batch, --tomidi or --wavout.\n");
+            return (1);
+        }
+    }
+
+    /* check if we only need to convert the files to midi */
+    if (convert_threads >= 0) {
+        char **files = &argv[optind];
+        char **list = NULL;
+        uint32_t count = argc - optind;
+        uint32_t failed;
+
+        if (count == 1 && strcmp(files[0], "-") == 0) {
+            files = list = read_file_list(stdin, &count);
+        }
+        failed = convert_batch(files, count, convert_threads, &cvt_options);
+        if (list) {
+            while (count)
+                free(list[--count]);
+            free(list);
+        }
+        if (failed) {
+            fprintf(stderr, "%u files failed, last error: %s\r\n", failed,
+                    (WildMidi_GetError()) ? WildMidi_GetError() : "none");
+            WildMidi_ClearError();
+        }
+        return ((failed) ? 1 : 0);
+    }
 
     /* check if we only need to convert a file to midi */
     if (midi_file[0] != '\0') {
@@ -1780,6 +2743,54 @@ int main(int argc, char **argv) {
         config_file[sizeof(config_file) - 1] = 0;
     }
 
+    /* check if we only need to write the sample cache */
+    if (cache_file[0] != '\0') {
+        const char *real_file = (strcmp(cache_file, "-") == 0) ? NULL : cache_file;
+
+        if (WildMidi_Init(config_file, rate, mixer_options) == -1) {
+            fprintf(stderr, "%s\r\n", WildMidi_GetError());
+            WildMidi_ClearError();
+            return (1);
+        }
+        printf("Writing sample cache for %s at %u Hz\r\n", config_file, rate);
+        if (WildMidi_SaveSampleCache(real_file) == -1) {
+            fprintf(stderr, "Writing the sample cache failed: %s.\r\n", WildMidi_GetError());
+            WildMidi_ClearError();
+            WildMidi_Shutdown();
+            return (1);
+        }
+        WildMidi_Shutdown();
+        return (0);
+    }
+
+    /* check if we only need to render the files to wav */
+    if (batch_threads >= 0) {
+        if (WildMidi_Init(config_file, rate, mixer_options) == -1) {
+            fprintf(stderr, "%s\r\n", WildMidi_GetError());
+            WildMidi_ClearError();
+            return (1);
+        }
+        WildMidi_MasterVolume(master_volume);
+        batch_start = batch_clock();
+        res = WildMidi_RenderBatch((const char * const *) &argv[optind], argc - optind,
+                                   (uint8_t) batch_threads, WM_FMT_S16, &batch_wav_sink, NULL);
+        if (res >= 0) {
+            print_realtime_factor(argc - optind - res, argc - optind, batch_frames,
+                                  batch_clock() - batch_start);
+        }
+        if (res != 0) {
+            if (res < 0) {
+                fprintf(stderr, "%s\r\n", WildMidi_GetError());
+            } else {
+                fprintf(stderr, "%d of %d files failed, last error: %s\r\n", res, argc - optind,
+                        (WildMidi_GetError()) ? WildMidi_GetError() : "none");
+            }
+            WildMidi_ClearError();
+        }
+        WildMidi_Shutdown();
+        return ((res != 0) ? 1 : 0);
+    }
+
     printf("Initializing Sound System\n");
     if (wav_file[0] != '\0') {
         if (open_wav_output() == -1) {
@@ -1789,6 +2800,22 @@ int main(int argc, char **argv) {
         if (open_audio_output() == -1) {
             return (1);
         }
+#ifdef WILDMIDI_OUTPUT_THREAD
+#if defined(AUDIODRV_OSS) || defined(AUDIODRV_ALSA)
+        if (out_period || out_latency) {
+            if (!ring_set) {
+                /* no more ahead than the device holds */
+                ring_ms = (out_latency) ? out_latency : ((out_period * 4 * 1000) + rate - 1) / rate;
+            }
+            ring_set = 1;
+        }
+#endif
+        if (ring_ms && open_ring_output(ring_ms) == -1) {
+            fprintf(stderr, "Unable to start the output thread, writing to the device directly\n");
+        } else if (ring_ms && ring_set) {
+            printf("Output thread buffers %u ms\n", (ring.size / 4) * 1000 / rate);
+        }
+#endif
     }
 
     libraryver = WildMidi_GetVersion();
@@ -1801,6 +2828,34 @@ int main(int argc, char **argv) {
         WildMidi_ClearError();
         return (1);
     }
+#ifdef WILDMIDI_TRACE
+    if (trace_file[0] != '\0') {
+        /* drained after every render, so the ring only needs to hold a
+           block worth and the patches of a song */
+        if (open_trace_output() == -1) {
+            WildMidi_Shutdown();
+            return (1);
+        }
+        if (WildMidi_SetTrace(NULL, 65536, NULL, NULL) == -1) {
+            fprintf(stderr, "%s\r\n", WildMidi_GetError());
+            WildMidi_ClearError();
+            close_trace_output();
+            WildMidi_Shutdown();
+            return (1);
+        }
+    }
+#endif
+
+    if (headless) {
+        WildMidi_MasterVolume(master_volume);
+        res = (int) render_headless(&argv[optind], argc - optind, play_from, play_to);
+        close_output();
+#ifdef WILDMIDI_TRACE
+        close_trace_output();
+#endif
+        WildMidi_Shutdown();
+        return ((res != 0) ? 1 : 0);
+    }
 
     printf(" +  Volume up        e  Better resampling    n  Next Midi\n");
     printf(" -  Volume down      l  Log volume           q  Quit\n");
@@ -1939,6 +2994,9 @@ int main(int argc, char **argv) {
                     break;
                 case 'q':
                     printf("\r\n");
+#ifdef WILDMIDI_TRACE
+                    write_trace_output(midi_ptr);
+#endif
                     if (inpause) goto end2;
                     goto end1;
                 case '-':
@@ -2024,8 +3082,8 @@ int main(int argc, char **argv) {
             }
 
             if (play_to != 0) {
-                if ((wm_info->current_sample + 4096) <= play_to) {
-                    samples = 16384;
+                if ((wm_info->current_sample + (render_size >> 2)) <= play_to) {
+                    samples = render_size;
                 } else {
                     samples = (play_to - wm_info->current_sample) << 2;
                     if (!samples) {
@@ -2035,9 +3093,16 @@ int main(int argc, char **argv) {
                 }
             }
             else {
-                samples = 16384;
+                samples = render_size;
+            }
+            if (render_output != NULL) {
+                res = render_output(midi_ptr, samples);
+            } else {
+                res = WildMidi_GetOutput(midi_ptr, output_buffer, samples);
             }
-            res = WildMidi_GetOutput(midi_ptr, output_buffer, samples);
+#ifdef WILDMIDI_TRACE
+            write_trace_output(midi_ptr);
+#endif
 
             if (res <= 0)
                 break;
@@ -2071,13 +3136,17 @@ int main(int argc, char **argv) {
                 display_lyrics, modes, (int)master_volume, pro_mins,
                 pro_secs, perc_play, spinner[spinpoint++ % 4]);
 
-            if (send_output(output_buffer, res) < 0) {
+            if ((render_output == NULL) && (send_output(output_buffer, res) < 0)) {
             /* driver prints an error message already. */
                 printf("\r");
                 goto end2;
             }
         }
         NEXTMIDI: fprintf(stderr, "\r\n");
+#ifdef WILDMIDI_TRACE
+        write_trace_output(midi_ptr);
+        trace_song++;
+#endif
         if (WildMidi_Close(midi_ptr) == -1) {
             ret_err = WildMidi_GetError();
             fprintf(stderr, "OOPS: failed closing midi handle!\r\n%s\r\n",ret_err);
@@ -2090,6 +3159,9 @@ end1: memset(output_buffer, 0, 16384);
     msleep(5);
 end2: close_output();
     free(output_buffer);
+#ifdef WILDMIDI_TRACE
+    close_trace_output();
+#endif
     if (WildMidi_Shutdown() == -1) {
         ret_err = WildMidi_GetError();
         fprintf(stderr, "OOPS: failure shutting down libWildMidi\r\n%s\r\n", ret_err);
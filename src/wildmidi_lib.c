@@ -37,6 +37,9 @@
 #include "file_io.h"
 #include "lock.h"
 #include "reverb.h"
+#include "resample.h"
+#include "mixer.h"
+#include "wm_thread.h"
 #include "gus_pat.h"
 #include "common.h"
 #include "wildmidi_lib.h"
@@ -49,6 +52,7 @@
 #include "f_xmidi.h"
 #include "patches.h"
 #include "sample.h"
+#include "sample_cache.h"
 #include "mus2mid.h"
 #include "xmi2mid.h"
 
@@ -58,11 +62,15 @@
  * =========================
  */
 
+/* how many contexts are alive, the default one included */
 static int WM_Initialized = 0;
-uint16_t _WM_MixerOptions = 0;
 
-uint16_t _WM_SampleRate;
-int16_t _WM_MasterVolume;
+/* the context set up by WildMidi_Init() */
+static struct _context *WM_Context = NULL;
+
+/* patch sets in use, shared between contexts with the same config */
+static struct _patch_set *WM_PatchSets = NULL;
+static int WM_PatchSets_lock = 0;
 
 /* when converting files to midi */
 typedef struct _cvt_options {
@@ -74,16 +82,6 @@ typedef struct _cvt_options {
 static _cvt_options WM_ConvertOptions = {0, 0, 0};
 
 
-float _WM_reverb_room_width = 16.875f;
-float _WM_reverb_room_length = 22.5f;
-
-float _WM_reverb_listen_posx = 8.4375f;
-float _WM_reverb_listen_posy = 16.875f;
-
-int _WM_fix_release = 0;
-int _WM_auto_amp = 0;
-int _WM_auto_amp_with_amp = 0;
-
 struct _miditrack {
     uint32_t length;
     uint32_t ptr;
@@ -97,94 +95,34 @@ struct _mdi_patches {
     struct _mdi_patch *next;
 };
 
-#define FPBITS 10
-#define FPMASK ((1L<<FPBITS)-1L)
-
-
-/* Gauss Interpolation code adapted from code supplied by Eric. A. Welsh */
-static double newt_coeffs[58][58];  /* for start/end of samples */
-#define MAX_GAUSS_ORDER 34          /* 34 is as high as we can go before errors crop up */
-static double *gauss_table = NULL;  /* *gauss_table[1<<FPBITS] */
-static int gauss_n = MAX_GAUSS_ORDER;
-static int gauss_lock;
-
-static void init_gauss(void) {
-    /* init gauss table */
-    int n = gauss_n;
-    int m, i, k, n_half = (n >> 1);
-    int j;
-    int sign;
-    double ck;
-    double x, x_inc, xz;
-    double z[35];
-    double *gptr, *t;
-
-    _WM_Lock(&gauss_lock);
-    if (gauss_table) {
-        _WM_Unlock(&gauss_lock);
-        return;
-    }
-
-    newt_coeffs[0][0] = 1;
-    for (i = 0; i <= n; i++) {
-        newt_coeffs[i][0] = 1;
-        newt_coeffs[i][i] = 1;
-
-        if (i > 1) {
-            newt_coeffs[i][0] = newt_coeffs[i - 1][0] / i;
-            newt_coeffs[i][i] = newt_coeffs[i - 1][0] / i;
-        }
-
-        for (j = 1; j < i; j++) {
-            newt_coeffs[i][j] = newt_coeffs[i - 1][j - 1]
-                    + newt_coeffs[i - 1][j];
-            if (i > 1)
-                newt_coeffs[i][j] /= i;
-        }
-        z[i] = i / (4 * M_PI);
-    }
-
-    for (i = 0; i <= n; i++)
-        for (j = 0, sign = (int) pow(-1, i); j <= i; j++, sign *= -1)
-            newt_coeffs[i][j] *= sign;
-
-    t = (double *) malloc((1<<FPBITS) * (n + 1) * sizeof(double));
-    x_inc = 1.0 / (1<<FPBITS);
-    for (m = 0, x = 0.0; m < (1<<FPBITS); m++, x += x_inc) {
-        xz = (x + n_half) / (4 * M_PI);
-        gptr = &t[m * (n + 1)];
-
-        for (k = 0; k <= n; k++) {
-            ck = 1.0;
-
-            for (i = 0; i <= n; i++) {
-                if (i == k)
-                    continue;
-
-                ck *= (sin(xz - z[i])) / (sin(z[k] - z[i]));
-            }
-            *gptr++ = ck;
-        }
-    }
-
-    gauss_table = t;
-    _WM_Unlock(&gauss_lock);
-}
-
-static void free_gauss(void) {
-    _WM_Lock(&gauss_lock);
-    free(gauss_table);
-    gauss_table = NULL;
-    _WM_Unlock(&gauss_lock);
-}
-
 struct _hndl {
     void * handle;
     struct _hndl *next;
     struct _hndl *prev;
 };
 
-static struct _hndl * first_handle = NULL;
+/*
+ * Handles mixed into one accumulator, see WildMidi_CreateBus(). The lock
+ * guards the members and is taken before that of any of them.
+ */
+struct _bus_member {
+    struct _mdi *mdi;
+    uint16_t gain;      /* WM_BUS_UNITY leaves the song as it is */
+};
+
+struct _bus {
+    int lock;
+    uint16_t options;   /* WM_MO_REVERB or 0 */
+    uint32_t rate;      /* of the first handle added, 0 until then */
+    struct _bus_member *member;
+    uint32_t member_count;
+    uint32_t member_size;
+    int32_t *mix_buffer;
+    uint32_t mix_buffer_size;
+    /* its own, so it outlives the patch sets of its handles */
+    struct _rvb_room *reverb_room;
+    struct _rvb *reverb;
+};
 
 #define MAX_AUTO_AMP 2.0
 
@@ -212,34 +150,46 @@ uint16_t _cvt_get_option (uint16_t tag) {
     return r;
 }
 
-static void WM_InitPatches(void) {
+static void WM_InitPatches(struct _patch_set *patches) {
     int i;
     for (i = 0; i < 128; i++) {
-        _WM_patch[i] = NULL;
+        patches->patch[i] = NULL;
     }
+    patches->fix_release = 0;
+    patches->auto_amp = 0;
+    patches->auto_amp_with_amp = 0;
+    patches->reverb_room_width = 16.875f;
+    patches->reverb_room_length = 22.5f;
+    patches->reverb_listen_posx = 8.4375f;
+    patches->reverb_listen_posy = 16.875f;
+    patches->cache_file = NULL;
+    patches->config_hash = WM_CACHE_HASH_INIT;
+    patches->cache = NULL;
+    patches->cache_size = 0;
+    patches->sample_budget = 0;
+    patches->resident = 0;
+    patches->hits = 0;
+    patches->misses = 0;
+    patches->idle_first = NULL;
+    patches->idle_last = NULL;
 }
 
-static void WM_FreePatches(void) {
+static void WM_FreePatches(struct _patch_set *patches) {
     int i;
     struct _patch * tmp_patch;
-    struct _sample * tmp_sample;
 
-    _WM_Lock(&_WM_patch_lock);
+    _WM_Lock(&patches->lock);
     for (i = 0; i < 128; i++) {
-        while (_WM_patch[i]) {
-            while (_WM_patch[i]->first_sample) {
-                tmp_sample = _WM_patch[i]->first_sample->next;
-                free(_WM_patch[i]->first_sample->data);
-                free(_WM_patch[i]->first_sample);
-                _WM_patch[i]->first_sample = tmp_sample;
-            }
-            free(_WM_patch[i]->filename);
-            tmp_patch = _WM_patch[i]->next;
-            free(_WM_patch[i]);
-            _WM_patch[i] = tmp_patch;
+        while (patches->patch[i]) {
+            _WM_free_samples(patches->patch[i]);
+            free(patches->patch[i]->filename);
+            tmp_patch = patches->patch[i]->next;
+            free(patches->patch[i]);
+            patches->patch[i] = tmp_patch;
         }
     }
-    _WM_Unlock(&_WM_patch_lock);
+    _WM_CloseSampleCache(patches);
+    _WM_Unlock(&patches->lock);
 }
 
 /* wm_strdup -- adds extra space for appending up to 4 chars */
@@ -353,7 +303,7 @@ static char** WM_LC_Tokenize_Line(char *line_data) {
     return (token_data);
 }
 
-static int load_config(const char *config_file, const char *conf_dir) {
+static int load_config(struct _patch_set *patches, const char *config_file, const char *conf_dir) {
     uint32_t config_size = 0;
     char *config_buffer = NULL;
     const char *dir_end = NULL;
@@ -365,17 +315,20 @@ static int load_config(const char *config_file, const char *conf_dir) {
     struct _patch * tmp_patch;
     char **line_tokens = NULL;
     int token_count = 0;
+    int shift;
 
     config_buffer = (char *) _WM_BufferFile(config_file, &config_size);
     if (!config_buffer) {
-        WM_FreePatches();
+        WM_FreePatches(patches);
         return (-1);
     }
+    /* before parsing, which cuts the text into tokens in place */
+    patches->config_hash = _WM_CacheHash(patches->config_hash, config_buffer, config_size);
 
     if (conf_dir) {
         if (!(config_dir = wm_strdup(conf_dir))) {
             _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
-            WM_FreePatches();
+            WM_FreePatches(patches);
             _WM_FreeBufferFile(config_buffer);
             return (-1);
         }
@@ -385,8 +338,8 @@ static int load_config(const char *config_file, const char *conf_dir) {
             config_dir = (char *) malloc((dir_end - config_file + 2));
             if (config_dir == NULL) {
                 _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
-                WM_FreePatches();
-                free(config_buffer);
+                WM_FreePatches(patches);
+                _WM_FreeBufferFile(config_buffer);
                 return (-1);
             }
             strncpy(config_dir, config_file, (dir_end - config_file + 1));
@@ -415,13 +368,13 @@ static int load_config(const char *config_file, const char *conf_dir) {
                         free(config_dir);
                         if (!line_tokens[1]) {
                             _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(missing name in dir line)", 0);
-                            WM_FreePatches();
+                            WM_FreePatches(patches);
                             free(line_tokens);
                             _WM_FreeBufferFile(config_buffer);
                             return (-1);
                         } else if (!(config_dir = wm_strdup(line_tokens[1]))) {
                             _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
-                            WM_FreePatches();
+                            WM_FreePatches(patches);
                             free(line_tokens);
                             _WM_FreeBufferFile(config_buffer);
                             return (-1);
@@ -434,7 +387,7 @@ static int load_config(const char *config_file, const char *conf_dir) {
                         char *new_config = NULL;
                         if (!line_tokens[1]) {
                             _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(missing name in source line)", 0);
-                            WM_FreePatches();
+                            WM_FreePatches(patches);
                             free(line_tokens);
                             _WM_FreeBufferFile(config_buffer);
                             return (-1);
@@ -442,7 +395,7 @@ static int load_config(const char *config_file, const char *conf_dir) {
                             new_config = (char *) malloc(strlen(config_dir) + strlen(line_tokens[1]) + 1);
                             if (new_config == NULL) {
                                 _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
-                                WM_FreePatches();
+                                WM_FreePatches(patches);
                                 free(config_dir);
                                 free(line_tokens);
                                 _WM_FreeBufferFile(config_buffer);
@@ -453,13 +406,13 @@ static int load_config(const char *config_file, const char *conf_dir) {
                         } else {
                             if (!(new_config = wm_strdup(line_tokens[1]))) {
                                 _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
-                                WM_FreePatches();
+                                WM_FreePatches(patches);
                                 free(line_tokens);
                                 _WM_FreeBufferFile(config_buffer);
                                 return (-1);
                             }
                         }
-                        if (load_config(new_config, config_dir) == -1) {
+                        if (load_config(patches, new_config, config_dir) == -1) {
                             free(new_config);
                             free(line_tokens);
                             _WM_FreeBufferFile(config_buffer);
@@ -470,7 +423,7 @@ static int load_config(const char *config_file, const char *conf_dir) {
                     } else if (wm_strcasecmp(line_tokens[0], "bank") == 0) {
                         if (!line_tokens[1] || !wm_isdigit(line_tokens[1][0])) {
                             _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(syntax error in bank line)", 0);
-                            WM_FreePatches();
+                            WM_FreePatches(patches);
                             free(config_dir);
                             free(line_tokens);
                             _WM_FreeBufferFile(config_buffer);
@@ -480,7 +433,7 @@ static int load_config(const char *config_file, const char *conf_dir) {
                     } else if (wm_strcasecmp(line_tokens[0], "drumset") == 0) {
                         if (!line_tokens[1] || !wm_isdigit(line_tokens[1][0])) {
                             _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(syntax error in drumset line)", 0);
-                            WM_FreePatches();
+                            WM_FreePatches(patches);
                             free(config_dir);
                             free(line_tokens);
                             _WM_FreeBufferFile(config_buffer);
@@ -490,99 +443,157 @@ static int load_config(const char *config_file, const char *conf_dir) {
                     } else if (wm_strcasecmp(line_tokens[0], "reverb_room_width") == 0) {
                         if (!line_tokens[1] || !wm_isdigit(line_tokens[1][0])) {
                             _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(syntax error in reverb_room_width line)", 0);
-                            WM_FreePatches();
+                            WM_FreePatches(patches);
                             free(config_dir);
                             free(line_tokens);
                             _WM_FreeBufferFile(config_buffer);
                             return (-1);
                         }
-                        _WM_reverb_room_width = (float) atof(line_tokens[1]);
-                        if (_WM_reverb_room_width < 1.0f) {
+                        patches->reverb_room_width = (float) atof(line_tokens[1]);
+                        if (patches->reverb_room_width < 1.0f) {
                             _WM_DEBUG_MSG("%s: reverb_room_width < 1m, setting to 1m", config_file);
-                            _WM_reverb_room_width = 1.0f;
-                        } else if (_WM_reverb_room_width > 100.0f) {
+                            patches->reverb_room_width = 1.0f;
+                        } else if (patches->reverb_room_width > 100.0f) {
                             _WM_DEBUG_MSG("%s: reverb_room_width > 100m, setting to 100m", config_file);
-                            _WM_reverb_room_width = 100.0f;
+                            patches->reverb_room_width = 100.0f;
                         }
                     } else if (wm_strcasecmp(line_tokens[0], "reverb_room_length") == 0) {
                         if (!line_tokens[1] || !wm_isdigit(line_tokens[1][0])) {
                             _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(syntax error in reverb_room_length line)", 0);
-                            WM_FreePatches();
+                            WM_FreePatches(patches);
                             free(config_dir);
                             free(line_tokens);
                             _WM_FreeBufferFile(config_buffer);
                             return (-1);
                         }
-                        _WM_reverb_room_length = (float) atof(line_tokens[1]);
-                        if (_WM_reverb_room_length < 1.0f) {
+                        patches->reverb_room_length = (float) atof(line_tokens[1]);
+                        if (patches->reverb_room_length < 1.0f) {
                             _WM_DEBUG_MSG("%s: reverb_room_length < 1m, setting to 1m", config_file);
-                            _WM_reverb_room_length = 1.0f;
-                        } else if (_WM_reverb_room_length > 100.0f) {
+                            patches->reverb_room_length = 1.0f;
+                        } else if (patches->reverb_room_length > 100.0f) {
                             _WM_DEBUG_MSG("%s: reverb_room_length > 100m, setting to 100m", config_file);
-                            _WM_reverb_room_length = 100.0f;
+                            patches->reverb_room_length = 100.0f;
                         }
                     } else if (wm_strcasecmp(line_tokens[0], "reverb_listener_posx") == 0) {
                         if (!line_tokens[1] || !wm_isdigit(line_tokens[1][0])) {
                             _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(syntax error in reverb_listen_posx line)", 0);
-                            WM_FreePatches();
+                            WM_FreePatches(patches);
                             free(config_dir);
                             free(line_tokens);
                             _WM_FreeBufferFile(config_buffer);
                             return (-1);
                         }
-                        _WM_reverb_listen_posx = (float) atof(line_tokens[1]);
-                        if ((_WM_reverb_listen_posx > _WM_reverb_room_width)
-                                || (_WM_reverb_listen_posx < 0.0f)) {
+                        patches->reverb_listen_posx = (float) atof(line_tokens[1]);
+                        if ((patches->reverb_listen_posx > patches->reverb_room_width)
+                                || (patches->reverb_listen_posx < 0.0f)) {
                             _WM_DEBUG_MSG("%s: reverb_listen_posx set outside of room", config_file);
-                            _WM_reverb_listen_posx = _WM_reverb_room_width / 2.0f;
+                            patches->reverb_listen_posx = patches->reverb_room_width / 2.0f;
                         }
                     } else if (wm_strcasecmp(line_tokens[0],
                             "reverb_listener_posy") == 0) {
                         if (!line_tokens[1] || !wm_isdigit(line_tokens[1][0])) {
                             _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(syntax error in reverb_listen_posy line)", 0);
-                            WM_FreePatches();
+                            WM_FreePatches(patches);
                             free(config_dir);
                             free(line_tokens);
                             _WM_FreeBufferFile(config_buffer);
                             return (-1);
                         }
-                        _WM_reverb_listen_posy = (float) atof(line_tokens[1]);
-                        if ((_WM_reverb_listen_posy > _WM_reverb_room_width)
-                                || (_WM_reverb_listen_posy < 0.0f)) {
+                        patches->reverb_listen_posy = (float) atof(line_tokens[1]);
+                        if ((patches->reverb_listen_posy > patches->reverb_room_width)
+                                || (patches->reverb_listen_posy < 0.0f)) {
                             _WM_DEBUG_MSG("%s: reverb_listen_posy set outside of room", config_file);
-                            _WM_reverb_listen_posy = _WM_reverb_room_length * 0.75f;
+                            patches->reverb_listen_posy = patches->reverb_room_length * 0.75f;
                         }
                     } else if (wm_strcasecmp(line_tokens[0], "guspat_editor_author_cant_read_so_fix_release_time_for_me") == 0) {
-                        _WM_fix_release = 1;
+                        patches->fix_release = 1;
+                    } else if (wm_strcasecmp(line_tokens[0], "sample_cache") == 0) {
+                        if (!line_tokens[1]) {
+                            _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(missing name in sample_cache line)", 0);
+                            WM_FreePatches(patches);
+                            free(config_dir);
+                            free(line_tokens);
+                            _WM_FreeBufferFile(config_buffer);
+                            return (-1);
+                        }
+                        free(patches->cache_file);
+                        if (!IS_ABSOLUTE_PATH(line_tokens[1]) && config_dir) {
+                            patches->cache_file = (char *) malloc(strlen(config_dir) + strlen(line_tokens[1]) + 1);
+                            if (patches->cache_file != NULL) {
+                                strcpy(patches->cache_file, config_dir);
+                                strcat(patches->cache_file, line_tokens[1]);
+                            }
+                        } else {
+                            patches->cache_file = wm_strdup(line_tokens[1]);
+                        }
+                        if (patches->cache_file == NULL) {
+                            _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
+                            WM_FreePatches(patches);
+                            free(config_dir);
+                            free(line_tokens);
+                            _WM_FreeBufferFile(config_buffer);
+                            return (-1);
+                        }
                     } else if (wm_strcasecmp(line_tokens[0], "auto_amp") == 0) {
-                        _WM_auto_amp = 1;
+                        patches->auto_amp = 1;
                     } else if (wm_strcasecmp(line_tokens[0], "auto_amp_with_amp") == 0) {
-                        _WM_auto_amp = 1;
-                        _WM_auto_amp_with_amp = 1;
+                        patches->auto_amp = 1;
+                        patches->auto_amp_with_amp = 1;
+                    } else if (wm_strcasecmp(line_tokens[0], "sample_budget") == 0) {
+                        if (!line_tokens[1] || !wm_isdigit(line_tokens[1][0])) {
+                            _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(syntax error in sample_budget line)", 0);
+                            WM_FreePatches(patches);
+                            free(config_dir);
+                            free(line_tokens);
+                            _WM_FreeBufferFile(config_buffer);
+                            return (-1);
+                        }
+                        /* megabytes unless it ends in k or g, as much as
+                           fits in a size_t */
+                        shift = 20;
+                        patches->sample_budget = (size_t) atol(line_tokens[1]);
+                        switch (line_tokens[1][strlen(line_tokens[1]) - 1]) {
+                        case 'k': case 'K': shift = 10; break;
+                        case 'g': case 'G': shift = 30; break;
+                        }
+                        if (patches->sample_budget > (((size_t) -1) >> shift)) {
+                            patches->sample_budget = (size_t) -1;
+                        } else {
+                            patches->sample_budget <<= shift;
+                        }
                     } else if (wm_isdigit(line_tokens[0][0])) {
                         patchid = (patchid & 0xFF80)
                                 | (atoi(line_tokens[0]) & 0x7F);
-                        if (_WM_patch[(patchid & 0x7F)] == NULL) {
-                            _WM_patch[(patchid & 0x7F)] = (struct _patch *) malloc(sizeof(struct _patch));
-                            if (_WM_patch[(patchid & 0x7F)] == NULL) {
+                        if (patches->patch[(patchid & 0x7F)] == NULL) {
+                            patches->patch[(patchid & 0x7F)] = (struct _patch *) malloc(sizeof(struct _patch));
+                            if (patches->patch[(patchid & 0x7F)] == NULL) {
                                 _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
-                                WM_FreePatches();
+                                WM_FreePatches(patches);
                                 free(config_dir);
                                 free(line_tokens);
                                 _WM_FreeBufferFile(config_buffer);
                                 return (-1);
                             }
-                            tmp_patch = _WM_patch[(patchid & 0x7F)];
+                            tmp_patch = patches->patch[(patchid & 0x7F)];
                             tmp_patch->patchid = patchid;
                             tmp_patch->filename = NULL;
                             tmp_patch->amp = 1024;
                             tmp_patch->note = 0;
                             tmp_patch->next = NULL;
                             tmp_patch->first_sample = NULL;
+                            tmp_patch->sample_pool = NULL;
+                            tmp_patch->sample_pool_size = 0;
+                            tmp_patch->ranges = NULL;
+                            tmp_patch->range_count = 0;
+                            tmp_patch->lock = 0;
                             tmp_patch->loaded = 0;
                             tmp_patch->inuse_count = 0;
+                            tmp_patch->sample_bytes = 0;
+                            tmp_patch->idle = 0;
+                            tmp_patch->idle_prev = NULL;
+                            tmp_patch->idle_next = NULL;
                         } else {
-                            tmp_patch = _WM_patch[(patchid & 0x7F)];
+                            tmp_patch = patches->patch[(patchid & 0x7F)];
                             if (tmp_patch->patchid == patchid) {
                                 free(tmp_patch->filename);
                                 tmp_patch->filename = NULL;
@@ -598,7 +609,7 @@ static int load_config(const char *config_file, const char *conf_dir) {
                                     if (tmp_patch->next == NULL) {
                                         if ((tmp_patch->next = (struct _patch *) malloc(sizeof(struct _patch))) == NULL) {
                                             _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, 0);
-                                            WM_FreePatches();
+                                            WM_FreePatches(patches);
                                             free(config_dir);
                                             free(line_tokens);
                                             _WM_FreeBufferFile(config_buffer);
@@ -611,8 +622,17 @@ static int load_config(const char *config_file, const char *conf_dir) {
                                         tmp_patch->note = 0;
                                         tmp_patch->next = NULL;
                                         tmp_patch->first_sample = NULL;
+                                        tmp_patch->sample_pool = NULL;
+                                        tmp_patch->sample_pool_size = 0;
+                                        tmp_patch->ranges = NULL;
+                                        tmp_patch->range_count = 0;
+                                        tmp_patch->lock = 0;
                                         tmp_patch->loaded = 0;
                                         tmp_patch->inuse_count = 0;
+                                        tmp_patch->sample_bytes = 0;
+                                        tmp_patch->idle = 0;
+                                        tmp_patch->idle_prev = NULL;
+                                        tmp_patch->idle_next = NULL;
                                     } else {
                                         tmp_patch = tmp_patch->next;
                                         free(tmp_patch->filename);
@@ -624,7 +644,7 @@ static int load_config(const char *config_file, const char *conf_dir) {
                                     tmp_patch->next = (struct _patch *) malloc(sizeof(struct _patch));
                                     if (tmp_patch->next == NULL) {
                                         _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
-                                        WM_FreePatches();
+                                        WM_FreePatches(patches);
                                         free(config_dir);
                                         free(line_tokens);
                                         _WM_FreeBufferFile(config_buffer);
@@ -637,14 +657,23 @@ static int load_config(const char *config_file, const char *conf_dir) {
                                     tmp_patch->note = 0;
                                     tmp_patch->next = NULL;
                                     tmp_patch->first_sample = NULL;
+                                    tmp_patch->sample_pool = NULL;
+                                    tmp_patch->sample_pool_size = 0;
+                                    tmp_patch->ranges = NULL;
+                                    tmp_patch->range_count = 0;
+                                    tmp_patch->lock = 0;
                                     tmp_patch->loaded = 0;
                                     tmp_patch->inuse_count = 0;
+                                    tmp_patch->sample_bytes = 0;
+                                    tmp_patch->idle = 0;
+                                    tmp_patch->idle_prev = NULL;
+                                    tmp_patch->idle_next = NULL;
                                 }
                             }
                         }
                         if (!line_tokens[1]) {
                             _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(missing name in patch line)", 0);
-                            WM_FreePatches();
+                            WM_FreePatches(patches);
                             free(config_dir);
                             free(line_tokens);
                             _WM_FreeBufferFile(config_buffer);
@@ -653,7 +682,7 @@ static int load_config(const char *config_file, const char *conf_dir) {
                             tmp_patch->filename = (char *) malloc(strlen(config_dir) + strlen(line_tokens[1]) + 5);
                             if (tmp_patch->filename == NULL) {
                                 _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, 0);
-                                WM_FreePatches();
+                                WM_FreePatches(patches);
                                 free(config_dir);
                                 free(line_tokens);
                                 _WM_FreeBufferFile(config_buffer);
@@ -664,7 +693,7 @@ static int load_config(const char *config_file, const char *conf_dir) {
                         } else {
                             if (!(tmp_patch->filename = wm_strdup(line_tokens[1]))) {
                                 _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, 0);
-                                WM_FreePatches();
+                                WM_FreePatches(patches);
                                 free(config_dir);
                                 free(line_tokens);
                                 _WM_FreeBufferFile(config_buffer);
@@ -752,7 +781,7 @@ static int load_config(const char *config_file, const char *conf_dir) {
                     }
                 }
                 else if (_WM_Global_ErrorI) { /* malloc() failure in WM_LC_Tokenize_Line() */
-                    WM_FreePatches();
+                    WM_FreePatches(patches);
                     free(line_tokens);
                     _WM_FreeBufferFile(config_buffer);
                     return (-1);
@@ -771,24 +800,153 @@ static int load_config(const char *config_file, const char *conf_dir) {
     return (0);
 }
 
-static int WM_LoadConfig(const char *config_file) {
-    return load_config(config_file, NULL);
+static int WM_LoadConfig(struct _patch_set *patches, const char *config_file) {
+    if (load_config(patches, config_file, NULL) == -1) {
+        return (-1);
+    }
+    _WM_OpenSampleCache(patches);
+    return (0);
+}
+
+/* loads a patch set that is not shared yet, with the one reference */
+static struct _patch_set *WM_NewPatchSet(const char *config_file, uint32_t rate) {
+    struct _patch_set *patches;
+
+    patches = (struct _patch_set *) calloc(1, sizeof(struct _patch_set));
+    if (patches == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
+        return (NULL);
+    }
+    patches->config_file = (char *) malloc(strlen(config_file) + 1);
+    if (patches->config_file == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
+        free(patches);
+        return (NULL);
+    }
+    strcpy(patches->config_file, config_file);
+    patches->rate = rate;
+
+    WM_InitPatches(patches);
+    if (WM_LoadConfig(patches, config_file) == -1) {
+        free(patches->config_file);
+        free(patches);
+        return (NULL);
+    }
+    patches->refs = 1;
+    return (patches);
+}
+
+/*
+ * Returns the patch set for config_file at rate, sharing one that is
+ * already loaded if there is one.
+ */
+static struct _patch_set *WM_GetPatchSet(const char *config_file, uint32_t rate) {
+    struct _patch_set *patches;
+
+    _WM_Lock(&WM_PatchSets_lock);
+    for (patches = WM_PatchSets; patches != NULL; patches = patches->next) {
+        if ((patches->rate == rate) && (strcmp(patches->config_file, config_file) == 0)) {
+            patches->refs++;
+            _WM_Unlock(&WM_PatchSets_lock);
+            return (patches);
+        }
+    }
+
+    /* loaded under the lock, so two contexts never load the same one */
+    if ((patches = WM_NewPatchSet(config_file, rate)) != NULL) {
+        patches->next = WM_PatchSets;
+        WM_PatchSets = patches;
+    }
+    _WM_Unlock(&WM_PatchSets_lock);
+    return (patches);
+}
+
+/* another reference to patches, see _WM_PutPatchSet() */
+void _WM_HoldPatchSet(struct _patch_set *patches) {
+    _WM_Lock(&WM_PatchSets_lock);
+    patches->refs++;
+    _WM_Unlock(&WM_PatchSets_lock);
+}
+
+/*
+ * The patch set songs opened in ctx now get, held for the caller. Every
+ * song keeps the one it was opened with, see WildMidi_ReloadConfig().
+ */
+struct _patch_set *_WM_CurrentPatchSet(struct _context *ctx) {
+    struct _patch_set *patches;
+
+    _WM_Lock(&ctx->lock);
+    patches = ctx->patches;
+    if (patches != NULL) {
+        _WM_HoldPatchSet(patches);
+    }
+    _WM_Unlock(&ctx->lock);
+    return (patches);
+}
+
+/* lets go of a reference to patches, the last one frees it */
+void _WM_PutPatchSet(struct _patch_set *patches) {
+    struct _patch_set **link;
+
+    if (patches == NULL) {
+        return;
+    }
+    _WM_Lock(&WM_PatchSets_lock);
+    if (--patches->refs != 0) {
+        _WM_Unlock(&WM_PatchSets_lock);
+        return;
+    }
+    for (link = &WM_PatchSets; *link != NULL; link = &(*link)->next) {
+        if (*link == patches) {
+            *link = patches->next;
+            break;
+        }
+    }
+    _WM_Unlock(&WM_PatchSets_lock);
+
+    WM_FreePatches(patches);
+    free(patches->reverb_room);
+    free(patches->config_file);
+    free(patches);
+}
+
+/* lets go of the patches WildMidi_PreloadPatches() held in ctx */
+static void WM_DropPreload(struct _context *ctx) {
+    struct _patch_set *patches;
+    struct _patch **list;
+    uint32_t count;
+
+    _WM_Lock(&ctx->lock);
+    patches = ctx->preload_set;
+    list = ctx->preload;
+    count = ctx->preload_count;
+    ctx->preload_set = NULL;
+    ctx->preload = NULL;
+    ctx->preload_count = 0;
+    _WM_Unlock(&ctx->lock);
+
+    if (patches != NULL) {
+        _WM_release_patches(patches, list, count);
+        _WM_PutPatchSet(patches);
+    }
 }
 
-static int add_handle(void * handle) {
+static int add_handle(struct _context *ctx, void * handle) {
     struct _hndl *tmp_handle = NULL;
 
-    if (first_handle == NULL) {
-        first_handle = (struct _hndl *) malloc(sizeof(struct _hndl));
-        if (first_handle == NULL) {
+    _WM_Lock(&ctx->lock);
+    if (ctx->first_handle == NULL) {
+        ctx->first_handle = (struct _hndl *) malloc(sizeof(struct _hndl));
+        if (ctx->first_handle == NULL) {
             _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
+            _WM_Unlock(&ctx->lock);
             return (-1);
         }
-        first_handle->handle = handle;
-        first_handle->prev = NULL;
-        first_handle->next = NULL;
+        ctx->first_handle->handle = handle;
+        ctx->first_handle->prev = NULL;
+        ctx->first_handle->next = NULL;
     } else {
-        tmp_handle = first_handle;
+        tmp_handle = ctx->first_handle;
         if (tmp_handle->next) {
             while (tmp_handle->next)
                 tmp_handle = tmp_handle->next;
@@ -796,6 +954,7 @@ static int add_handle(void * handle) {
         tmp_handle->next = (struct _hndl *) malloc(sizeof(struct _hndl));
         if (tmp_handle->next == NULL) {
             _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
+            _WM_Unlock(&ctx->lock);
             return (-1);
         }
         tmp_handle->next->prev = tmp_handle;
@@ -803,6 +962,7 @@ static int add_handle(void * handle) {
         tmp_handle->next = NULL;
         tmp_handle->handle = handle;
     }
+    _WM_Unlock(&ctx->lock);
     return (0);
 }
 
@@ -819,362 +979,544 @@ static int add_handle(void * handle) {
 #endif
 
 
-static int WM_GetOutput_Linear(midi * handle, int8_t *buffer, uint32_t size) {
-    uint32_t buffer_used = 0;
-    uint32_t i, env_ptr;
-    struct _mdi *mdi = (struct _mdi *) handle;
-    uint32_t real_samples_to_mix = 0;
-    uint32_t data_pos;
-    int32_t premix, left_mix, right_mix;
-/*  int32_t vol_mul; */
-    struct _note *note_data = NULL;
-    uint32_t count;
-    struct _event *event = mdi->current_event;
-    int32_t *tmp_buffer;
-    int32_t *out_buffer;
+/*
+ * A ping pong loop is played as it is in the sample, the note turns around
+ * at its ends rather than the loader unrolling it into a forward loop twice
+ * its size. Going backwards it always turns at the loop start, going
+ * forwards at the loop end while it loops and on its first pass, which is
+ * how a note released part way through the loop, or a drum that never
+ * loops, played the unrolled loop.
+ */
+#define WM_TurnsAtLoopEnd(nte) \
+    (((nte)->modes & SAMPLE_LOOP) \
+     || (((nte)->modes & SAMPLE_PINGPONG) && !(nte)->turned))
+
+static void WM_TurnNote(struct _note *nte) {
+    uint32_t loop_start = nte->sample->loop_start;
+    uint32_t loop_end = nte->sample->loop_end;
+    uint32_t loop_size = nte->sample->loop_size;
+    uint32_t past;
+
+    /* how far it went past the end it was heading for, a full turn being
+       there and back again */
+    if (nte->reverse) {
+        past = (loop_start - nte->sample_pos) % (loop_size * 2);
+    } else {
+        past = (nte->sample_pos - loop_end) % (loop_size * 2);
+        nte->turned = 1;
+    }
+    if (past > loop_size) {
+        /* back to heading the same way */
+        past -= loop_size;
+    } else {
+        nte->reverse ^= 1;
+    }
+    nte->sample_pos = (nte->reverse) ? (loop_end - past) : (loop_start + past);
+}
 
-    _WM_Lock(&mdi->lock);
+/*
+ * A note playing backwards gets the reverse kernel with its increment
+ * negated for the run, sample_pos being stepped modulo 2^32 that makes it
+ * step down.
+ */
+static inline void WM_MixRun(struct _note *nte, int32_t *mix_ptr,
+                             uint32_t count, const struct _WM_Mixer *mixer) {
+    if (__builtin_expect((nte->reverse), 0)) {
+        nte->sample_inc = -nte->sample_inc;
+        mixer->reverse(nte, mix_ptr, count);
+        nte->sample_inc = -nte->sample_inc;
+    } else {
+        mixer->forward(nte, mix_ptr, count);
+    }
+}
 
-    buffer_used = 0;
-    memset(buffer, 0, size);
+/*
+ * How many of the next count frames the note can be mixed for before its
+ * sample position or envelope needs checking again, the frames in between
+ * can be handed to the mixer kernel as a single run.
+ *
+ * This is what keeps the envelope out of the kernels: every stage is a
+ * straight line from env_level to env_target at env_inc a frame, so the
+ * frame it gets there is worked out here and the stage machine in
+ * WM_MixNote() only runs on that frame. Inside a run the kernels just
+ * step the ramp, which they have to do every frame anyway to give the
+ * same output as before.
+ */
+static inline uint32_t WM_SimpleFrames(struct _note *nte, uint32_t count) {
+    uint32_t frames = count;
+    uint32_t limit;
+    int32_t env_target;
+
+    if (nte->reverse) {
+        if (nte->sample_inc) {
+            limit = (nte->sample_pos - nte->sample->loop_start) / nte->sample_inc;
+            if (limit < frames)
+                frames = limit;
+        }
+    } else if (WM_TurnsAtLoopEnd(nte)) {
+        if (nte->sample_pos > nte->sample->loop_end)
+            return (0);
+        if (nte->sample_inc) {
+            limit = (nte->sample->loop_end - nte->sample_pos) / nte->sample_inc;
+            if (limit < frames)
+                frames = limit;
+        }
+    } else {
+        if (nte->sample_pos >= nte->sample->data_length)
+            return (0);
+        if (nte->sample_inc) {
+            limit = (nte->sample->data_length - 1 - nte->sample_pos) / nte->sample_inc;
+            if (limit < frames)
+                frames = limit;
+        }
+    }
 
-    if ( (size / 2) > mdi->mix_buffer_size) {
-        if ( (size / 2) <= ( mdi->mix_buffer_size * 2 )) {
-            mdi->mix_buffer_size += MEM_CHUNK;
+    if (nte->env_inc) {
+        env_target = nte->sample->env_target[nte->env];
+        if (nte->env_inc < 0) {
+            if (nte->env_level <= env_target)
+                return (0);
+            limit = (uint32_t)(nte->env_level - env_target - 1) / (uint32_t)(-nte->env_inc);
         } else {
-            mdi->mix_buffer_size = size / 2;
+            if (nte->env_level >= env_target)
+                return (0);
+            limit = (uint32_t)(env_target - nte->env_level - 1) / (uint32_t)nte->env_inc;
         }
-        mdi->mix_buffer = (int32_t *) realloc(mdi->mix_buffer, mdi->mix_buffer_size * sizeof(int32_t));
+        if (limit < frames)
+            frames = limit;
     }
 
-    tmp_buffer = mdi->mix_buffer;
+    return (frames);
+}
 
-    memset(tmp_buffer, 0, ((size / 2) * sizeof(int32_t)));
-    out_buffer = tmp_buffer;
+/*
+ * Renders note over the next count frames into mix_ptr. Nothing changes
+ * between two events apart from what the note does itself, so the frames
+ * up to the next point where the sample position or the envelope needs
+ * attention are handed to the mixer kernel in one go, together with that
+ * frame itself which then gets checked here.
+ *
+ * Returns the note that now takes this note's place in the active list:
+ * the note itself, the replay note that took over from it, or NULL when
+ * it ended. Only the note (and its replay) is touched, which is what lets
+ * several threads render different notes of the same stretch at once.
+ */
+static struct _note *WM_MixNote(struct _note *note_data, int32_t *mix_ptr,
+                                uint32_t count, const struct _WM_Mixer *mixer) {
+    uint32_t env_ptr;
+    uint32_t run;
+
+    while (count) {
+        run = WM_SimpleFrames(note_data, count);
+        if (run >= count) {
+            WM_MixRun(note_data, mix_ptr, count, mixer);
+            break;
+        }
+        WM_MixRun(note_data, mix_ptr, run + 1, mixer);
+        mix_ptr += run * 2;
+        count -= run;
 
-    do {
-        if (__builtin_expect((!mdi->samples_to_mix), 0)) {
-            while ((!mdi->samples_to_mix) && (event->do_event)) {
-                event->do_event(mdi, &event->event_data);
-                if ((mdi->extra_info.mixer_options & WM_MO_LOOP) && (event[0].evtype == ev_meta_endoftrack)) {
-                    _WM_ResetToStart(mdi);
-                    event = mdi->current_event;
-                } else {
-                    mdi->samples_to_mix = event->samples_to_next;
-                    event++;
-                    mdi->current_event = event;
-                }
+        /*
+         * ========================
+         * sample position checking
+         * ========================
+         */
+#ifdef DEBUG_RESAMPLE
+        fprintf(stderr,"\r\n%d -> INC %i, ENV %i, LEVEL %i, TARGET %d, RATE %i, SAMPLE POS %i, SAMPLE LENGTH %i",
+                (uint32_t)note_data,
+                note_data->env_inc,
+                note_data->env, note_data->env_level,
+                note_data->sample->env_target[note_data->env],
+                note_data->sample->env_rate[note_data->env],
+                note_data->sample_pos,
+                note_data->sample->data_length);
+        if (note_data->modes & SAMPLE_LOOP)
+            fprintf(stderr,", LOOP %i + %i",
+                    note_data->sample->loop_start,
+                    note_data->sample->loop_size);
+        fprintf(stderr,"\r\n");
+#endif
+
+        /* the kernel already stepped sample_pos and env_level */
+        if (__builtin_expect((note_data->reverse), 0)) {
+            if ((int32_t)(note_data->sample_pos - note_data->sample->loop_start) < 0) {
+                WM_TurnNote(note_data);
+            }
+        } else if (__builtin_expect((note_data->modes & SAMPLE_PINGPONG), 0)
+                   && WM_TurnsAtLoopEnd(note_data)) {
+            if (note_data->sample_pos > note_data->sample->loop_end) {
+                WM_TurnNote(note_data);
+            }
+        } else if (__builtin_expect((note_data->modes & SAMPLE_LOOP), 1)) {
+            if (__builtin_expect(
+                                 (note_data->sample_pos > note_data->sample->loop_end),
+                                 0)) {
+                note_data->sample_pos = note_data->sample->loop_start
+                    + ((note_data->sample_pos
+                        - note_data->sample->loop_start)
+                    % note_data->sample->loop_size);
             }
 
-            if (__builtin_expect((!mdi->samples_to_mix), 0)) {
-                if (mdi->extra_info.current_sample >= mdi->extra_info.approx_total_samples) {
-                    break;
-                } else if ((mdi->extra_info.approx_total_samples
-                             - mdi->extra_info.current_sample) > (size >> 2)) {
-                    mdi->samples_to_mix = size >> 2;
+        } else if (__builtin_expect(
+                                      (note_data->sample_pos
+                                       >= note_data->sample->data_length),
+                                      0)) {
+            goto _END_THIS_NOTE;
+        }
+
+        if (__builtin_expect((note_data->env_inc == 0), 0)) {
+            RESAMPLE_DEBUGS("Next Frame: 0 env_inc");
+            goto _NEXT_FRAME;
+        }
+
+        if (note_data->env_inc < 0) {
+            if (__builtin_expect((note_data->env_level
+                > note_data->sample->env_target[note_data->env]), 0)) {
+                RESAMPLE_DEBUGS("Next Frame: env_lvl > env_target");
+                goto _NEXT_FRAME;
+            }
+        } else if (note_data->env_inc > 0) {
+            if (__builtin_expect((note_data->env_level
+                < note_data->sample->env_target[note_data->env]), 0)) {
+                RESAMPLE_DEBUGS("Next Frame: env_lvl < env_target");
+                goto _NEXT_FRAME;
+            }
+        }
+
+        /* Yes could have a condition here but
+           it would create another bottleneck */
+        note_data->env_level =
+                note_data->sample->env_target[note_data->env];
+        switch (note_data->env) {
+        case 0:
+            if (!(note_data->modes & SAMPLE_ENVELOPE)) {
+                note_data->env_inc = 0;
+                RESAMPLE_DEBUGS("Next Frame: No Envelope");
+                goto _NEXT_FRAME;
+            }
+            break;
+        case 2:
+            if (note_data->modes & SAMPLE_SUSTAIN /*|| note_data->hold*/) {
+                note_data->env_inc = 0;
+                RESAMPLE_DEBUGS("Next Frame: SAMPLE_SUSTAIN");
+                goto _NEXT_FRAME;
+            } else {
+                env_ptr = (note_data->modes & SAMPLE_CLAMPED)? 5 : 4;
+                note_data->env = env_ptr;
+                if (note_data->env_level
+                        > note_data->sample->env_target[env_ptr]) {
+                    note_data->env_inc =
+                            -note_data->sample->env_rate[env_ptr];
                 } else {
-                    mdi->samples_to_mix = mdi->extra_info.approx_total_samples
-                                           - mdi->extra_info.current_sample;
+                    note_data->env_inc =
+                            note_data->sample->env_rate[env_ptr];
                 }
+                /* the note gets mixed into this frame once more */
+                continue;
+            }
+            break;
+        case 5:
+            if (__builtin_expect((note_data->env_level == 0), 1)) {
+                goto _END_THIS_NOTE;
             }
+            /* sample release */
+            if (note_data->modes & SAMPLE_LOOP)
+                note_data->modes ^= SAMPLE_LOOP;
+            note_data->env_inc = 0;
+            RESAMPLE_DEBUGS("Next Frame: Sample Release");
+            goto _NEXT_FRAME;
+        case 6:
+            _END_THIS_NOTE:
+            note_data->active = 0;
+            if (__builtin_expect((note_data->replay != NULL), 1)) {
+                /* the replay note takes over from this very frame */
+                note_data = note_data->replay;
+                note_data->active = 1;
+                RESAMPLE_DEBUGS("Next Frame: Replay Note");
+                continue;
+            }
+            RESAMPLE_DEBUGS("Next Note: Killed Off Note");
+            return (NULL);
         }
-        if (__builtin_expect((mdi->samples_to_mix > (size >> 2)), 1)) {
-            real_samples_to_mix = size >> 2;
+        note_data->env++;
+
+        if (note_data->is_off == 1) {
+            _WM_do_note_off_extra(note_data);
         } else {
-            real_samples_to_mix = mdi->samples_to_mix;
-            if (real_samples_to_mix == 0) {
-                continue;
+
+            if (note_data->env_level
+                >= note_data->sample->env_target[note_data->env]) {
+                note_data->env_inc =
+                    -note_data->sample->env_rate[note_data->env];
+            } else {
+                note_data->env_inc =
+                    note_data->sample->env_rate[note_data->env];
             }
         }
+        RESAMPLE_DEBUGI("Next Frame: Next ENV ", note_data->env);
 
-        /* do mixing here */
-        count = real_samples_to_mix;
+    _NEXT_FRAME:
+        mix_ptr += 2;
+        count--;
+    }
 
-        do {
-            note_data = mdi->note;
-            left_mix = right_mix = 0;
-            RESAMPLE_DEBUGI("SAMPLES_TO_MIX",count);
-            if (__builtin_expect((note_data != NULL), 1)) {
-                RESAMPLE_DEBUGS("Processing Notes");
-                while (note_data) {
-                    /*
-                     * ===================
-                     * resample the sample
-                     * ===================
-                     */
-                    data_pos = note_data->sample_pos >> FPBITS;
-                    premix = ((note_data->sample->data[data_pos] + (((note_data->sample->data[data_pos + 1] - note_data->sample->data[data_pos]) * (int32_t)(note_data->sample_pos & FPMASK)) / 1024)) * (note_data->env_level >> 12)) / 1024;
-
-                    left_mix += (premix * (int32_t)note_data->left_mix_volume) / 1024;
-                    right_mix += (premix * (int32_t)note_data->right_mix_volume) / 1024;
-
-                    /*
-                     * ========================
-                     * sample position checking
-                     * ========================
-                     */
-#ifdef DEBUG_RESAMPLE
-                    fprintf(stderr,"\r\n%d -> INC %i, ENV %i, LEVEL %i, TARGET %d, RATE %i, SAMPLE POS %i, SAMPLE LENGTH %i, PREMIX %i (%i:%i)",
-                            (uint32_t)note_data,
-                            note_data->env_inc,
-                            note_data->env, note_data->env_level,
-                            note_data->sample->env_target[note_data->env],
-                            note_data->sample->env_rate[note_data->env],
-                            note_data->sample_pos,
-                            note_data->sample->data_length,
-                            premix, left_mix, right_mix);
-                    if (note_data->modes & SAMPLE_LOOP)
-                        fprintf(stderr,", LOOP %i + %i",
-                                note_data->sample->loop_start,
-                                note_data->sample->loop_size);
-                    fprintf(stderr,"\r\n");
-#endif
+    return (note_data);
+}
 
-                    note_data->sample_pos += note_data->sample_inc;
+/*
+ * A stretch is only split across the render threads when every thread
+ * gets a fair share of notes and there is enough work overall to be worth
+ * waking them up for.
+ */
+#define WM_MT_MIN_NOTES 2
+#define WM_MT_MIN_WORK 4096
+
+struct _mix_job {
+    struct _note **notes;
+    uint32_t note_count;
+    int32_t *buffer;        /* the mix buffer, rendered into by worker 0 */
+    int32_t *pool_buffer;   /* private accumulators of workers 1 and up */
+    uint32_t frames;
+    int threads;
+    const struct _WM_Mixer *mixer;
+};
 
-                    if (__builtin_expect((note_data->modes & SAMPLE_LOOP), 1)) {
-                        if (__builtin_expect(
-                                             (note_data->sample_pos > note_data->sample->loop_end),
-                                             0)) {
-                            note_data->sample_pos = note_data->sample->loop_start
-                                + ((note_data->sample_pos
-                                    - note_data->sample->loop_start)
-                                % note_data->sample->loop_size);
-                        }
+static void WM_MixJob(void *data, int worker) {
+    struct _mix_job *job = (struct _mix_job *) data;
+    uint32_t i = (job->note_count * worker) / job->threads;
+    uint32_t last = (job->note_count * (worker + 1)) / job->threads;
+    int32_t *buffer = job->buffer;
 
-                    } else if (__builtin_expect(
-                                                  (note_data->sample_pos
-                                                   >= note_data->sample->data_length),
-                                                  0)) {
-                        goto _END_THIS_NOTE;
-                    }
+    if (worker) {
+        buffer = job->pool_buffer + ((worker - 1) * job->frames * 2);
+        memset(buffer, 0, ((job->frames * 2) * sizeof(int32_t)));
+    }
 
-                    if (__builtin_expect((note_data->env_inc == 0), 0)) {
-                        note_data = note_data->next;
-                        RESAMPLE_DEBUGS("Next Note: 0 env_inc");
-                        continue;
-                    }
+    for (; i < last; i++) {
+        job->notes[i] = WM_MixNote(job->notes[i], buffer, job->frames, job->mixer);
+    }
+}
 
-                    note_data->env_level += note_data->env_inc;
+/*
+ * Renders the active notes over a stretch of frames using the render
+ * threads, each of them taking a contiguous share of the note list. The
+ * private accumulators are summed into the mix buffer in integer, so the
+ * result is identical to rendering the notes one after the other. Returns
+ * 0 when the stretch is better rendered on the calling thread.
+ */
+static int WM_MixNotesThreaded(struct _mdi *mdi, int32_t *buffer,
+                               uint32_t frames, const struct _WM_Mixer *mixer) {
+    struct _mix_job job;
+    int32_t *priv;
+    uint32_t i, j, note_count = mdi->voice_count;
+
+    job.threads = _WM_PoolThreads(mdi->pool);
+    if ((note_count < (uint32_t)(job.threads * WM_MT_MIN_NOTES))
+            || ((note_count * frames) < WM_MT_MIN_WORK)) {
+        return (0);
+    }
 
-                    if (note_data->env_inc < 0) {
-                        if (__builtin_expect((note_data->env_level
-                            > note_data->sample->env_target[note_data->env]), 0)) {
-                            note_data = note_data->next;
-                            RESAMPLE_DEBUGS("Next Note: env_lvl > env_target");
-                            continue;
-                        }
-                    } else if (note_data->env_inc > 0) {
-                        if (__builtin_expect((note_data->env_level
-                            < note_data->sample->env_target[note_data->env]), 0)) {
-                            note_data = note_data->next;
-                            RESAMPLE_DEBUGS("Next Note: env_lvl < env_target");
-                            continue;
-                        }
-                    }
+    j = (job.threads - 1) * frames * 2;
+    if (j > mdi->pool_buffer_size) {
+        priv = (int32_t *) realloc(mdi->pool_buffer, (j * sizeof(int32_t)));
+        if (priv == NULL)
+            return (0);
+        mdi->pool_buffer = priv;
+        mdi->pool_buffer_size = j;
+    }
 
-                    /* Yes could have a condition here but
-                       it would create another bottleneck */
-                    note_data->env_level =
-                            note_data->sample->env_target[note_data->env];
-                    switch (note_data->env) {
-                    case 0:
-                        if (!(note_data->modes & SAMPLE_ENVELOPE)) {
-                            note_data->env_inc = 0;
-                            note_data = note_data->next;
-                            RESAMPLE_DEBUGS("Next Note: No Envelope");
-                            continue;
-                        }
-                        break;
-                    case 2:
-                        if (note_data->modes & SAMPLE_SUSTAIN /*|| note_data->hold*/) {
-                            note_data->env_inc = 0;
-                            note_data = note_data->next;
-                            RESAMPLE_DEBUGS("Next Note: SAMPLE_SUSTAIN");
-                            continue;
-                        } else {
-                            env_ptr = (note_data->modes & SAMPLE_CLAMPED)? 5 : 4;
-                            note_data->env = env_ptr;
-                            if (note_data->env_level
-                                    > note_data->sample->env_target[env_ptr]) {
-                                note_data->env_inc =
-                                        -note_data->sample->env_rate[env_ptr];
-                            } else {
-                                note_data->env_inc =
-                                        note_data->sample->env_rate[env_ptr];
-                            }
-                            continue;
-                        }
-                        break;
-                    case 5:
-                        if (__builtin_expect((note_data->env_level == 0), 1)) {
-                            goto _END_THIS_NOTE;
-                        }
-                        /* sample release */
-                        if (note_data->modes & SAMPLE_LOOP)
-                            note_data->modes ^= SAMPLE_LOOP;
-                        note_data->env_inc = 0;
-                        note_data = note_data->next;
-                        RESAMPLE_DEBUGS("Next Note: Sample Release");
-
-                        continue;
-                    case 6:
-                        _END_THIS_NOTE:
-                        if (__builtin_expect((note_data->replay != NULL), 1)) {
-                            note_data->active = 0;
-                            {
-                                struct _note *prev_note = NULL;
-                                struct _note *nte_array = mdi->note;
-
-                                if (nte_array != note_data) {
-                                    do {
-                                        prev_note = nte_array;
-                                        nte_array = nte_array->next;
-                                    } while (nte_array != note_data);
-                                }
-                                if (prev_note) {
-                                    prev_note->next = note_data->replay;
-                                } else {
-                                    mdi->note = note_data->replay;
-                                }
-                                note_data->replay->next = note_data->next;
-                                note_data = note_data->replay;
-                                note_data->active = 1;
-                            }
-                        } else {
-                            note_data->active = 0;
-                            {
-                                struct _note *prev_note = NULL;
-                                struct _note *nte_array = mdi->note;
-
-                                if (nte_array != note_data) {
-                                    do {
-                                        prev_note = nte_array;
-                                        nte_array = nte_array->next;
-                                    } while ((nte_array != note_data)
-                                            && (nte_array));
-                                }
-                                if (prev_note) {
-                                    prev_note->next = note_data->next;
-                                } else {
-                                    mdi->note = note_data->next;
-                                }
-                                note_data = note_data->next;
-                            }
-                        }
-                        RESAMPLE_DEBUGS("Next Note: Killed Off Note");
-                        continue;
-                    }
-                    note_data->env++;
+    job.notes = mdi->voice;
+    job.note_count = note_count;
+    job.buffer = buffer;
+    job.pool_buffer = mdi->pool_buffer;
+    job.frames = frames;
+    job.mixer = mixer;
+    _WM_PoolRun(mdi->pool, WM_MixJob, &job);
+
+    priv = mdi->pool_buffer;
+    for (j = 1; j < (uint32_t) job.threads; j++) {
+        for (i = 0; i < (frames * 2); i++)
+            buffer[i] += priv[i];
+        priv += frames * 2;
+    }
 
-                    if (note_data->is_off == 1) {
-                        _WM_do_note_off_extra(note_data);
-                    } else {
+    /* close the gaps left by the notes that ended */
+    for (i = 0, j = 0; i < note_count; i++) {
+        if (mdi->voice[i] != NULL)
+            mdi->voice[j++] = mdi->voice[i];
+    }
+    mdi->voice_count = j;
 
-                        if (note_data->env_level
-                            >= note_data->sample->env_target[note_data->env]) {
-                            note_data->env_inc =
-                                -note_data->sample->env_rate[note_data->env];
-                        } else {
-                            note_data->env_inc =
-                                note_data->sample->env_rate[note_data->env];
-                        }
-                    }
-                    note_data = note_data->next;
-#ifdef DEBUG_RESAMPLE
-                    if (note_data != NULL)
-                        RESAMPLE_DEBUGI("Next Note: Next ENV ", note_data->env);
-                    else
-                        RESAMPLE_DEBUGS("Next Note: Next ENV");
-#endif
-                    continue;
-                }
-            }
-            *tmp_buffer++ = left_mix;
-            *tmp_buffer++ = right_mix;
-        } while (--count);
+    return (1);
+}
 
-        buffer_used += real_samples_to_mix * 4;
-        size -= (real_samples_to_mix << 2);
-        mdi->extra_info.current_sample += real_samples_to_mix;
-        mdi->samples_to_mix -= real_samples_to_mix;
-    } while (size);
+/*
+ * Renders the active notes over a stretch of frames into the accumulator
+ * of their channel, stems holds one every stride samples. The channels
+ * are then summed into the mix buffer, in integer, so the mix comes out
+ * the same as when the notes are rendered straight into it.
+ */
+static void WM_MixStems(struct _mdi *mdi, int32_t *buffer, int32_t *stems,
+                        uint32_t stride, uint32_t frames, const struct _WM_Mixer *mixer) {
+    struct _note *note_data;
+    int32_t *stem;
+    uint32_t i, ch;
 
-    tmp_buffer = out_buffer;
+    for (ch = 0; ch < 16; ch++) {
+        memset(stems + (ch * stride), 0, ((frames * 2) * sizeof(int32_t)));
+    }
 
-    if (mdi->extra_info.mixer_options & WM_MO_REVERB) {
-        _WM_do_reverb(mdi->reverb, tmp_buffer, (buffer_used / 2));
+    i = 0;
+    while (i < mdi->voice_count) {
+        note_data = mdi->voice[i];
+        note_data = WM_MixNote(note_data, stems + ((note_data->noteid >> 8) * stride), frames, mixer);
+        if (note_data != NULL) {
+            mdi->voice[i++] = note_data;
+        } else {
+            mdi->voice[i] = mdi->voice[--mdi->voice_count];
+        }
     }
 
-    /* _WM_DynamicVolumeAdjust(mdi, tmp_buffer, (buffer_used/2)); */
+    for (ch = 0; ch < 16; ch++) {
+        stem = stems + (ch * stride);
+        for (i = 0; i < (frames * 2); i++)
+            buffer[i] += stem[i];
+    }
+}
 
-    for (i = 0; i < buffer_used; i += 4) {
-        left_mix = *tmp_buffer++;
-        right_mix = *tmp_buffer++;
+/*
+ * The reverb of a song is only allocated once it is switched on, the
+ * filters and delays it is built from are worked out once for all the
+ * songs of a patch set, which fixes the rate and the room.
+ */
+static struct _rvb *WM_GetReverb(struct _mdi *mdi) {
+    struct _patch_set *patches = mdi->patch_set;
+    struct _rvb_room *room;
+
+    if (mdi->reverb)
+        return (mdi->reverb);
+
+    _WM_Lock(&patches->lock);
+    if (patches->reverb_room == NULL) {
+        patches->reverb_room = _WM_init_reverb_room(patches->rate,
+                patches->reverb_room_width, patches->reverb_room_length,
+                patches->reverb_listen_posx, patches->reverb_listen_posy);
+    }
+    room = patches->reverb_room;
+    _WM_Unlock(&patches->lock);
 
-        /*
-         * ===================
-         * Write to the buffer
-         * ===================
-         */
-#ifdef WORDS_BIGENDIAN
-        (*buffer++) = ((left_mix >> 8) & 0x7f) | ((left_mix >> 24) & 0x80);
-        (*buffer++) = left_mix & 0xff;
-        (*buffer++) = ((right_mix >> 8) & 0x7f) | ((right_mix >> 24) & 0x80);
-        (*buffer++) = right_mix & 0xff;
-#else
-        (*buffer++) = left_mix & 0xff;
-        (*buffer++) = ((left_mix >> 8) & 0x7f) | ((left_mix >> 24) & 0x80);
-        (*buffer++) = right_mix & 0xff;
-        (*buffer++) = ((right_mix >> 8) & 0x7f) | ((right_mix >> 24) & 0x80);
+    if (room != NULL)
+        mdi->reverb = _WM_init_reverb(room);
+    return (mdi->reverb);
+}
+
+/*
+ * Live input, see WildMidi_Live(). The producer does not take mdi->lock,
+ * the queue head and tail are handed over with acquire and release
+ * ordering instead.
+ */
+#if defined(HAVE___ATOMIC_BUILTINS)
+#define live_load(p)        __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define live_store(p,v)     __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#else /* msvc gives volatile acquire and release semantics, elsewhere best effort */
+#define live_load(p)        (*(volatile uint32_t *)(p))
+#define live_store(p,v)     (*(volatile uint32_t *)(p) = (v))
 #endif
+
+#define WM_LIVE_NONE 0xFFFFFFFF
+
+/* plays the live messages up to head that are due by frame, returns the
+   frame the next one is due at */
+static uint32_t WM_DoLiveEvents(struct _mdi *mdi, uint32_t head, uint32_t frame) {
+    struct _live_queue *live = mdi->live;
+    struct _live_event *event;
+    uint32_t tail = live->tail;
+
+    while (tail != head) {
+        event = &live->event[tail & (WM_LIVE_EVENTS - 1)];
+        if (event->frame > frame)
+            break;
+        _WM_DoLiveEvent(mdi, event->message);
+        mdi->events_done++;
+        tail++;
     }
+    live_store(&live->tail, tail);
 
-    _WM_Unlock(&mdi->lock);
-    return (buffer_used);
+    if (tail == head)
+        return (WM_LIVE_NONE);
+    return (live->event[tail & (WM_LIVE_EVENTS - 1)].frame);
 }
 
-static int WM_GetOutput_Gauss(midi * handle, int8_t *buffer, uint32_t size) {
-    uint32_t buffer_used = 0;
-    uint32_t i, env_ptr;
-    struct _mdi *mdi = (struct _mdi *) handle;
+/* makes room in the mix buffer for frames, returns -1 without the memory */
+static int WM_MixBuffer(struct _mdi *mdi, uint32_t frames) {
+    int32_t *mix_buffer;
+    uint32_t size;
+
+    if ((frames * 2) <= mdi->mix_buffer_size) {
+        return (0);
+    }
+    /* in steps, for callers that ask for a little more each time */
+    size = mdi->mix_buffer_size + MEM_CHUNK;
+    if (size < (frames * 2)) {
+        size = frames * 2;
+    }
+    mix_buffer = (int32_t *) realloc(mdi->mix_buffer, (size * sizeof(int32_t)));
+    if (mix_buffer == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, "(to mix the song)", 0);
+        return (-1);
+    }
+    mdi->mix_buffer = mix_buffer;
+    mdi->mix_buffer_size = size;
+    return (0);
+}
+
+/*
+ * Mixes up to frames stereo frames of the song into mdi->mix_buffer, reverb
+ * included, and returns how many it mixed. That is only less than asked for
+ * once the song has ended. The caller holds mdi->lock and converts the mix
+ * buffer into whatever output format was asked for. Events are always
+ * processed here on the calling thread, only the notes may be rendered on
+ * the render threads.
+ *
+ * Unless stems is NULL, every channel is also mixed on its own into it,
+ * channel ch at stems + (ch * frames * 2), without reverb.
+ *
+ * Unless silent is NULL, stretches without a note playing are not cleared
+ * in the mix buffer until a note starts. Should none start and the reverb
+ * have nothing left to play either, the mix buffer is left as it was,
+ * *silent is set and it is up to the caller to write out silence.
+ *
+ * Unless dry is 0 the song is mixed without its reverb, a bus runs its
+ * own over all of its songs at once, see WM_BusRender().
+ *
+ * The mix buffer has to hold frames already, see WM_MixBuffer().
+ */
+static uint32_t WM_MixFrames(struct _mdi *mdi, uint32_t frames, int32_t *stems, int *silent, int dry) {
+    uint32_t stride = frames * 2;
+    uint32_t quiet_frames = 0;
+    uint32_t frames_used = 0;
     uint32_t real_samples_to_mix = 0;
-    uint32_t data_pos;
-    int32_t premix, left_mix, right_mix;
     struct _note *note_data = NULL;
-    uint32_t count;
-    int16_t *sptr;
-    double y, xd;
-    double *gptr, *gend;
-    int left, right, temp_n;
-    int ii, jj;
+    uint32_t i;
+    const struct _WM_Mixer *mixer = mdi->mixer;
     struct _event *event = mdi->current_event;
     int32_t *tmp_buffer;
-    int32_t *out_buffer;
-
-    _WM_Lock(&mdi->lock);
-
-    buffer_used = 0;
-    memset(buffer, 0, size);
+    uint32_t live_head = 0;
+    uint32_t live_next;
 
-    if ( (size / 2) > mdi->mix_buffer_size) {
-        if ( (size / 2) <= ( mdi->mix_buffer_size * 2 )) {
-            mdi->mix_buffer_size += MEM_CHUNK;
-        } else {
-            mdi->mix_buffer_size = size / 2;
-        }
-        mdi->mix_buffer = (int32_t *) realloc(mdi->mix_buffer, mdi->mix_buffer_size * sizeof(int32_t));
+    if (mdi->live != NULL) {
+        /* what was queued after this has to wait for the next call */
+        live_head = live_load(&mdi->live->head);
     }
+    WM_TRACE(mdi, WM_TRACE_MIX, WM_TRACE_BEGIN, 0, frames);
 
     tmp_buffer = mdi->mix_buffer;
 
-    memset(tmp_buffer, 0, ((size / 2) * sizeof(int32_t)));
-    out_buffer = tmp_buffer;
-
     do {
         if (__builtin_expect((!mdi->samples_to_mix), 0)) {
-            while ((!mdi->samples_to_mix) && (event->do_event)) {
-                event->do_event(mdi, &event->event_data);
+            while ((!mdi->samples_to_mix) && WM_HAVE_EVENT(mdi, event)) {
+                _WM_DoEvent(mdi, event);
+                mdi->events_done++;
                 if ((mdi->extra_info.mixer_options & WM_MO_LOOP) && (event[0].evtype == ev_meta_endoftrack)) {
                     _WM_ResetToStart(mdi);
                     event = mdi->current_event;
@@ -1185,269 +1527,187 @@ static int WM_GetOutput_Gauss(midi * handle, int8_t *buffer, uint32_t size) {
                 }
             }
 
-            if (!mdi->samples_to_mix) {
-                if (mdi->extra_info.current_sample
-                    >= mdi->extra_info.approx_total_samples) {
-                    break;
+            if (__builtin_expect((!mdi->samples_to_mix), 0)) {
+                if (mdi->extra_info.current_sample >= mdi->extra_info.approx_total_samples) {
+                    if (mdi->live == NULL)
+                        break;
+                    /* live input keeps playing after the song */
+                    mdi->samples_to_mix = frames;
                 } else if ((mdi->extra_info.approx_total_samples
-                            - mdi->extra_info.current_sample) > (size >> 2)) {
-                    mdi->samples_to_mix = size >> 2;
+                             - mdi->extra_info.current_sample) > frames) {
+                    mdi->samples_to_mix = frames;
                 } else {
                     mdi->samples_to_mix = mdi->extra_info.approx_total_samples
-                    - mdi->extra_info.current_sample;
+                                           - mdi->extra_info.current_sample;
                 }
             }
         }
-        if (__builtin_expect((mdi->samples_to_mix > (size >> 2)), 1)) {
-            real_samples_to_mix = size >> 2;
+        if (__builtin_expect((mdi->samples_to_mix > frames), 1)) {
+            real_samples_to_mix = frames;
         } else {
             real_samples_to_mix = mdi->samples_to_mix;
             if (real_samples_to_mix == 0) {
                 continue;
             }
         }
+        if (mdi->live != NULL) {
+            live_next = WM_DoLiveEvents(mdi, live_head, frames_used);
+            if ((live_next - frames_used) < real_samples_to_mix) {
+                real_samples_to_mix = live_next - frames_used;
+            }
+        }
 
-        /* do mixing here */
-        count = real_samples_to_mix;
-        do {
-            note_data = mdi->note;
-            left_mix = right_mix = 0;
-            if (__builtin_expect((note_data != NULL), 1)) {
-                while (note_data) {
-                    /*
-                     * ===================
-                     * resample the sample
-                     * ===================
-                     */
-                    data_pos = note_data->sample_pos >> FPBITS;
-
-                    /* check to see if we're near one of the ends */
-                    left = data_pos;
-                    right = (note_data->sample->data_length >> FPBITS) - left
-                            - 1;
-                    temp_n = (right << 1) - 1;
-                    if (temp_n <= 0)
-                        temp_n = 1;
-                    if (temp_n > (left << 1) + 1)
-                        temp_n = (left << 1) + 1;
-
-                    /* use Newton if we can't fill the window */
-                    if (temp_n < gauss_n) {
-                        xd = note_data->sample_pos & FPMASK;
-                        xd /= (1L << FPBITS);
-                        xd += temp_n >> 1;
-                        y = 0;
-                        sptr = note_data->sample->data
-                                + (note_data->sample_pos >> FPBITS)
-                                - (temp_n >> 1);
-                        for (ii = temp_n; ii;) {
-                            for (jj = 0; jj <= ii; jj++)
-                                y += sptr[jj] * newt_coeffs[ii][jj];
-                            y *= xd - --ii;
-                        }
-                        y += *sptr;
-                    } else { /* otherwise, use Gauss as usual */
-                        y = 0;
-                        gptr = &gauss_table[(note_data->sample_pos & FPMASK) *
-                                     (gauss_n + 1)];
-                        gend = gptr + gauss_n;
-                        sptr = note_data->sample->data
-                                + (note_data->sample_pos >> FPBITS)
-                                - (gauss_n >> 1);
-                        do {
-                            y += *(sptr++) * *(gptr++);
-                        } while (gptr <= gend);
-                    }
+        /* do mixing here, the notes add to what is in the buffer */
+        RESAMPLE_DEBUGI("SAMPLES_TO_MIX",real_samples_to_mix);
+        if (mdi->voice_count > mdi->peak_voices) {
+            mdi->peak_voices = mdi->voice_count;
+        }
+        if ((silent != NULL) && (quiet_frames == frames_used)
+                && (mdi->voice_count == 0)) {
+            /* nothing to mix until the next event, clear it only if needed */
+            quiet_frames += real_samples_to_mix;
+        } else if (quiet_frames != 0) {
+            memset(mdi->mix_buffer, 0, (((quiet_frames + real_samples_to_mix) * 2) * sizeof(int32_t)));
+            quiet_frames = 0;
+        } else {
+            memset(tmp_buffer, 0, ((real_samples_to_mix * 2) * sizeof(int32_t)));
+        }
+        if (stems != NULL) {
+            WM_MixStems(mdi, tmp_buffer, stems + (frames_used * 2), stride, real_samples_to_mix, mixer);
+        } else if ((mdi->pool == NULL)
+                || (!WM_MixNotesThreaded(mdi, tmp_buffer, real_samples_to_mix, mixer))) {
+            i = 0;
+            while (i < mdi->voice_count) {
+                note_data = WM_MixNote(mdi->voice[i], tmp_buffer, real_samples_to_mix, mixer);
+                if (note_data != NULL) {
+                    mdi->voice[i++] = note_data;
+                } else {
+                    /* the last voice has not been mixed yet, it comes next */
+                    mdi->voice[i] = mdi->voice[--mdi->voice_count];
+                }
+            }
+        }
+        tmp_buffer += real_samples_to_mix * 2;
 
-                    premix = (int32_t)((y * (note_data->env_level >> 12)) / 1024);
-
-                    left_mix += (premix * (int32_t)note_data->left_mix_volume) / 1024;
-                    right_mix += (premix * (int32_t)note_data->right_mix_volume) / 1024;
-
-                    /*
-                     * ========================
-                     * sample position checking
-                     * ========================
-                     */
-                    note_data->sample_pos += note_data->sample_inc;
-                    if (__builtin_expect(
-                                         (note_data->sample_pos > note_data->sample->loop_end),
-                                         0)) {
-                        if (note_data->modes & SAMPLE_LOOP) {
-                            note_data->sample_pos =
-                            note_data->sample->loop_start
-                            + ((note_data->sample_pos
-                                - note_data->sample->loop_start)
-                               % note_data->sample->loop_size);
-                        } else if (__builtin_expect(
-                                                    (note_data->sample_pos
-                                                     >= note_data->sample->data_length),
-                                                    0)) {
-                            goto _END_THIS_NOTE;
-                        }
-                    }
+        frames_used += real_samples_to_mix;
+        frames -= real_samples_to_mix;
+        mdi->extra_info.current_sample += real_samples_to_mix;
+        mdi->samples_to_mix -= real_samples_to_mix;
+    } while (frames);
 
-                    if (__builtin_expect((note_data->env_inc == 0), 0)) {
-                        /*
-                         fprintf(stderr,"\r\nINC = 0, ENV %i, LEVEL %i, TARGET %d, RATE %i\r\n",
-                                 note_data->env, note_data->env_level,
-                                 note_data->sample->env_target[note_data->env],
-                                 note_data->sample->env_rate[note_data->env]);
-                         */
-                        note_data = note_data->next;
-                        continue;
-                    }
+    if (mdi->live != NULL) {
+        /* those due after the end of the buffer start off the next one */
+        WM_DoLiveEvents(mdi, live_head, WM_LIVE_NONE);
+    }
 
-                    note_data->env_level += note_data->env_inc;
-                    /*
-                     fprintf(stderr,"\r\nENV %i, LEVEL %i, TARGET %d, RATE %i, INC %i\r\n",
-                             note_data->env, note_data->env_level,
-                             note_data->sample->env_target[note_data->env],
-                             note_data->sample->env_rate[note_data->env],
-                             note_data->env_inc);
-                     */
-                    if (note_data->env_inc < 0) {
-                        if (note_data->env_level
-                            > note_data->sample->env_target[note_data->env]) {
-                            note_data = note_data->next;
-                            continue;
-                        }
-                    } else if (note_data->env_inc > 0) {
-                        if (note_data->env_level
-                            < note_data->sample->env_target[note_data->env]) {
-                            note_data = note_data->next;
-                            continue;
-                        }
-                    }
+    if ((frames_used != 0) && (quiet_frames == frames_used)) {
+        if ((dry) || !(mdi->extra_info.mixer_options & WM_MO_REVERB)
+                || (mdi->reverb == NULL) || (mdi->reverb->idle)) {
+            *silent = 1;
+            WM_TRACE(mdi, WM_TRACE_MIX, WM_TRACE_END, 0, frames_used);
+            return (frames_used);
+        }
+        /* the reverb still rings on */
+        memset(mdi->mix_buffer, 0, ((frames_used * 2) * sizeof(int32_t)));
+    }
 
-                    /* Yes could have a condition here but
-                       it would create another bottleneck */
-
-                    note_data->env_level =
-                    note_data->sample->env_target[note_data->env];
-                    switch (note_data->env) {
-                        case 0:
-                            if (!(note_data->modes & SAMPLE_ENVELOPE)) {
-                                note_data->env_inc = 0;
-                                note_data = note_data->next;
-                                continue;
-                            }
-                            break;
-                        case 2:
-                            if (note_data->modes & SAMPLE_SUSTAIN /*|| note_data->hold*/) {
-                                note_data->env_inc = 0;
-                                note_data = note_data->next;
-                                continue;
-                            } else {
-                                env_ptr = (note_data->modes & SAMPLE_CLAMPED)? 5 : 4;
-                                note_data->env = env_ptr;
-                                if (note_data->env_level
-                                        > note_data->sample->env_target[env_ptr]) {
-                                    note_data->env_inc =
-                                        -note_data->sample->env_rate[env_ptr];
-                                } else {
-                                    note_data->env_inc =
-                                        note_data->sample->env_rate[env_ptr];
-                                }
-                                continue;
-                            }
-                            break;
-                        case 5:
-                            if (__builtin_expect((note_data->env_level == 0), 1)) {
-                                goto _END_THIS_NOTE;
-                            }
-                            /* sample release */
-                            if (note_data->modes & SAMPLE_LOOP)
-                                note_data->modes ^= SAMPLE_LOOP;
-                            note_data->env_inc = 0;
-                            note_data = note_data->next;
-                            continue;
-                        case 6:
-                        _END_THIS_NOTE:
-                            if (__builtin_expect((note_data->replay != NULL), 1)) {
-                                note_data->active = 0;
-                                {
-                                    struct _note *prev_note = NULL;
-                                    struct _note *nte_array = mdi->note;
-
-                                    if (nte_array != note_data) {
-                                        do {
-                                            prev_note = nte_array;
-                                            nte_array = nte_array->next;
-                                        } while (nte_array != note_data);
-                                    }
-                                    if (prev_note) {
-                                        prev_note->next = note_data->replay;
-                                    } else {
-                                        mdi->note = note_data->replay;
-                                    }
-                                    note_data->replay->next = note_data->next;
-                                    note_data = note_data->replay;
-                                    note_data->active = 1;
-                                }
-                            } else {
-                                note_data->active = 0;
-                                {
-                                    struct _note *prev_note = NULL;
-                                    struct _note *nte_array = mdi->note;
-
-                                    if (nte_array != note_data) {
-                                        do {
-                                            prev_note = nte_array;
-                                            nte_array = nte_array->next;
-                                        } while ((nte_array != note_data)
-                                                 && (nte_array));
-                                    }
-                                    if (prev_note) {
-                                        prev_note->next = note_data->next;
-                                    } else {
-                                        mdi->note = note_data->next;
-                                    }
-                                    note_data = note_data->next;
-                                }
-                            }
-                            continue;
-                    }
-                    note_data->env++;
+    if ((!dry) && (mdi->extra_info.mixer_options & WM_MO_REVERB) && (WM_GetReverb(mdi) != NULL)) {
+        /* without the memory for it the song plays on dry */
+        _WM_do_reverb(mdi->reverb, mdi->mix_buffer, (frames_used * 2));
+    }
 
-                    if (note_data->is_off == 1) {
-                        _WM_do_note_off_extra(note_data);
-                    } else {
+    /* _WM_DynamicVolumeAdjust(mdi, mdi->mix_buffer, (frames_used * 2)); */
 
-                        if (note_data->env_level
-                            >= note_data->sample->env_target[note_data->env]) {
-                            note_data->env_inc =
-                            -note_data->sample->env_rate[note_data->env];
-                        } else {
-                            note_data->env_inc =
-                            note_data->sample->env_rate[note_data->env];
-                        }
-                    }
-                    note_data = note_data->next;
-                    continue;
-                }
-            }
-            *tmp_buffer++ = left_mix;
-            *tmp_buffer++ = right_mix;
-        } while (--count);
+    WM_TRACE(mdi, WM_TRACE_MIX, WM_TRACE_END, 0, frames_used);
+    return (frames_used);
+}
 
-        buffer_used += real_samples_to_mix * 4;
-        size -= (real_samples_to_mix << 2);
-        mdi->extra_info.current_sample += real_samples_to_mix;
-        mdi->samples_to_mix -= real_samples_to_mix;
-    } while (size);
+/*
+ * The frames of the mix at the output rate, where they are returned in mix.
+ * When the song is mixed at another rate, see WildMidi_CreateContextRate(),
+ * as many frames of it are mixed as it takes to make frames of output.
+ * Returns -1 without the memory for them.
+ */
+static int WM_MixOutput(struct _mdi *mdi, uint32_t frames, int32_t **mix, int *silent, int dry) {
+    const struct _context *ctx = mdi->ctx;
+    uint32_t needs;
+    uint32_t got = 0;
+    int32_t *in;
+    int quiet = 0;
+
+    if (ctx->resample == NULL) {
+        if (WM_MixBuffer(mdi, frames) == -1) {
+            return (-1);
+        }
+        frames = WM_MixFrames(mdi, frames, NULL, silent, dry);
+        *mix = mdi->mix_buffer;
+        return ((int) frames);
+    }
+    if ((mdi->resample == NULL)
+            && ((mdi->resample = _WM_init_resample(ctx->resample)) == NULL)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, "(to resample the mix)", 0);
+        return (-1);
+    }
 
-    tmp_buffer = out_buffer;
+    needs = _WM_resample_needs(mdi->resample, frames);
+    if (needs != 0) {
+        if (WM_MixBuffer(mdi, needs) == -1) {
+            return (-1);
+        }
+        got = WM_MixFrames(mdi, needs, NULL, &quiet, dry);
+        if ((in = _WM_resample_input(mdi->resample, got, quiet)) == NULL) {
+            _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, "(to resample the mix)", 0);
+            return (-1);
+        }
+        if (!quiet) {
+            memcpy(in, mdi->mix_buffer, ((got * 2) * sizeof(int32_t)));
+        }
+    }
 
-    if (mdi->extra_info.mixer_options & WM_MO_REVERB) {
-        _WM_do_reverb(mdi->reverb, tmp_buffer, (buffer_used / 2));
+    frames = _WM_do_resample(mdi->resample, frames, &quiet);
+    *mix = mdi->resample->out;
+    if (quiet && (silent != NULL)) {
+        *silent = 1;
+    } else if (quiet) {
+        memset(*mix, 0, ((frames * 2) * sizeof(int32_t)));
     }
+    return ((int) frames);
+}
 
-    /* _WM_DynamicVolumeAdjust(mdi, tmp_buffer, (buffer_used/2)); */
+/* samples at the rate a context mixes at as they are at its output rate,
+   and back, for the positions taken and given out */
+static uint32_t WM_ToOutput(const struct _context *ctx, uint32_t samples) {
+    if (ctx->output_rate == ctx->sample_rate)
+        return (samples);
+    return ((uint32_t) (((uint64_t) samples * ctx->output_rate) / ctx->sample_rate));
+}
+
+static uint32_t WM_ToMix(const struct _context *ctx, uint32_t samples) {
+    if (ctx->output_rate == ctx->sample_rate)
+        return (samples);
+    return ((uint32_t) (((uint64_t) samples * ctx->sample_rate) / ctx->output_rate));
+}
+
+/* true for one of the WM_FMT_* sample formats */
+#define WM_FMT_VALID(format) (((format) >= WM_FMT_S16) && ((format) <= WM_FMT_U8_MONO))
+
+/* true for a mixed sample the 16 bit output cannot hold */
+#define WM_CLIPS(sample) ((uint32_t) ((sample) + 32768) > 65535)
+
+/*
+ * The output formats, each sample of the mix buffer is converted and
+ * written out once. They return how many of the samples were beyond the
+ * 16 bit range, which the 16 bit output wraps and the others clamp.
+ */
+static uint32_t WM_Write_S16(const int32_t *mix, int8_t *buffer, uint32_t frames) {
+    uint32_t i;
+    uint32_t clipped = 0;
+    int32_t left_mix, right_mix;
 
-    for (i = 0; i < buffer_used; i += 4) {
-        left_mix = *tmp_buffer++;
-        right_mix = *tmp_buffer++;
+    for (i = 0; i < frames; i++) {
+        left_mix = *mix++;
+        right_mix = *mix++;
+        clipped += WM_CLIPS(left_mix) + WM_CLIPS(right_mix);
 
         /*
          * ===================
@@ -1466,49 +1726,320 @@ static int WM_GetOutput_Gauss(midi * handle, int8_t *buffer, uint32_t size) {
         (*buffer++) = ((right_mix >> 8) & 0x7f) | ((right_mix >> 24) & 0x80);
 #endif
     }
+    return (clipped);
+}
+
+static uint32_t WM_Write_Float(const int32_t *mix, float *buffer, uint32_t frames) {
+    uint32_t i;
+    uint32_t clipped = 0;
+
+    for (i = 0; i < (frames * 2); i++) {
+        clipped += WM_CLIPS(mix[i]);
+        buffer[i] = (float)mix[i] * (1.0f / 32768.0f);
+    }
+    return (clipped);
+}
+
+static uint32_t WM_Write_S32(const int32_t *mix, int32_t *buffer, uint32_t frames) {
+    uint32_t i;
+    uint32_t clipped = 0;
+    int32_t sample;
+
+    for (i = 0; i < (frames * 2); i++) {
+        sample = mix[i];
+        if (sample > 32767) {
+            sample = 32767;
+            clipped++;
+        } else if (sample < -32768) {
+            sample = -32768;
+            clipped++;
+        }
+        buffer[i] = sample * 65536;
+    }
+    return (clipped);
+}
+
+/* the 8 bit outputs clamp to the 16 bit range before dropping the low byte */
+#define WM_CLAMP16(sample, clipped) do { \
+        if ((sample) > 32767) { \
+            (sample) = 32767; \
+            (clipped)++; \
+        } else if ((sample) < -32768) { \
+            (sample) = -32768; \
+            (clipped)++; \
+        } \
+    } while (0)
+
+static uint32_t WM_Write_U8(const int32_t *mix, uint8_t *buffer, uint32_t frames) {
+    uint32_t i;
+    uint32_t clipped = 0;
+    int32_t sample;
+
+    for (i = 0; i < (frames * 2); i++) {
+        sample = mix[i];
+        WM_CLAMP16(sample, clipped);
+        buffer[i] = (uint8_t) ((sample >> 8) + 128);
+    }
+    return (clipped);
+}
+
+static uint32_t WM_Write_U8_Mono(const int32_t *mix, uint8_t *buffer, uint32_t frames) {
+    uint32_t i;
+    uint32_t clipped = 0;
+    int32_t left_mix, right_mix;
+
+    for (i = 0; i < frames; i++) {
+        left_mix = *mix++;
+        right_mix = *mix++;
+        WM_CLAMP16(left_mix, clipped);
+        WM_CLAMP16(right_mix, clipped);
+        buffer[i] = (uint8_t) (((left_mix + right_mix) >> 9) + 128);
+    }
+    return (clipped);
+}
+
+static uint32_t WM_Write(const int32_t *mix, void *out, uint32_t frames, uint16_t format) {
+    switch (format) {
+    case WM_FMT_S16:
+        return (WM_Write_S16(mix, (int8_t *) out, frames));
+    case WM_FMT_S32:
+        return (WM_Write_S32(mix, (int32_t *) out, frames));
+    case WM_FMT_FLOAT:
+        return (WM_Write_Float(mix, (float *) out, frames));
+    case WM_FMT_U8:
+        return (WM_Write_U8(mix, (uint8_t *) out, frames));
+    case WM_FMT_U8_MONO:
+        return (WM_Write_U8_Mono(mix, (uint8_t *) out, frames));
+    }
+    return (0);
+}
+
+/* writes frames of silence in format to out */
+static void WM_WriteSilence(void *out, uint32_t frames, uint16_t format) {
+    switch (format) {
+    case WM_FMT_S16:
+        memset(out, 0, (frames * 4));
+        break;
+    case WM_FMT_S32:
+    case WM_FMT_FLOAT:
+        /* zero is all bits clear in both */
+        memset(out, 0, (frames * 8));
+        break;
+    case WM_FMT_U8:
+        memset(out, 0x80, (frames * 2));
+        break;
+    case WM_FMT_U8_MONO:
+        memset(out, 0x80, frames);
+        break;
+    }
+}
+
+/* adds the time since start to the render time of mdi */
+static void WM_RenderTime(struct _mdi *mdi, uint64_t start) {
+    uint64_t took = _WM_Clock() - start;
+
+    mdi->render_ns += took;
+    if (took > mdi->worst_render_ns) {
+        mdi->worst_render_ns = took;
+    }
+}
+
+/* returns the frames rendered, only fewer than asked for once the song ended,
+   or -1 without the memory to mix them */
+static int WM_Render(struct _mdi *mdi, uint32_t frames, void *out, uint16_t format) {
+    int32_t *mix;
+    int silent = 0;
+    int mixed;
+    uint64_t start;
+
+    _WM_Lock(&mdi->lock);
+    start = _WM_Clock();
+
+    mixed = WM_MixOutput(mdi, frames, &mix, &silent, 0);
+    if (mixed == -1) {
+        _WM_Unlock(&mdi->lock);
+        return (-1);
+    }
+    frames = (uint32_t) mixed;
+    if (silent) {
+        WM_WriteSilence(out, frames, format);
+    } else {
+        mdi->clipped += WM_Write(mix, out, frames, format);
+    }
+
+    WM_RenderTime(mdi, start);
     _WM_Unlock(&mdi->lock);
-    return (buffer_used);
+    return ((int) frames);
 }
 
-/*
- * =========================
- * External Functions
- * =========================
- */
+/* as WM_Render(), with the channels written to those of stems not NULL;
+   returns -1 without the memory for them */
+static int WM_RenderStems(struct _mdi *mdi, uint32_t frames, void *out, void **stems, uint16_t format) {
+    uint32_t stride = frames * 2;
+    uint32_t ch;
+    int32_t *stem_buffer;
+    uint64_t start;
 
-WM_SYMBOL int WildMidi_ConvertToMidi (const char *file, uint8_t **out, uint32_t *size) {
-    uint8_t *buf;
-    int ret;
+    _WM_Lock(&mdi->lock);
+    if (mdi->ctx->resample != NULL) {
+        /* each channel would need a resampler of its own */
+        _WM_Unlock(&mdi->lock);
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(not with a mixing rate other than the output rate)", 0);
+        return (-1);
+    }
+    start = _WM_Clock();
 
-    if (!file) {
-        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL filename)", 0);
+    if ((stride * 16) > mdi->stem_buffer_size) {
+        stem_buffer = (int32_t *) realloc(mdi->stem_buffer, ((stride * 16) * sizeof(int32_t)));
+        if (stem_buffer == NULL) {
+            _WM_Unlock(&mdi->lock);
+            _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, "(to render the channels)", 0);
+            return (-1);
+        }
+        mdi->stem_buffer = stem_buffer;
+        mdi->stem_buffer_size = stride * 16;
+    }
+    if (WM_MixBuffer(mdi, frames) == -1) {
+        _WM_Unlock(&mdi->lock);
         return (-1);
     }
-    if ((buf = (uint8_t *) _WM_BufferFile(file, size)) == NULL) {
+
+    frames = WM_MixFrames(mdi, frames, mdi->stem_buffer, NULL, 0);
+    mdi->clipped += WM_Write(mdi->mix_buffer, out, frames, format);
+    for (ch = 0; ch < 16; ch++) {
+        if (stems[ch] != NULL) {
+            WM_Write(mdi->stem_buffer + (ch * stride), stems[ch], frames, format);
+        }
+    }
+
+    WM_RenderTime(mdi, start);
+
+    _WM_Unlock(&mdi->lock);
+    return ((int) frames);
+}
+
+/* adds a song to the mix of its bus, the bus lock is held; returns -1
+   without the memory to mix it */
+static int WM_BusMix(struct _bus *bus, struct _bus_member *member, uint32_t frames) {
+    struct _mdi *mdi = member->mdi;
+    int32_t *mix = bus->mix_buffer;
+    int32_t *song_mix;
+    int32_t gain = member->gain;
+    int silent = 0;
+    int mixed;
+    uint64_t start;
+    uint32_t i;
+
+    _WM_Lock(&mdi->lock);
+    start = _WM_Clock();
+
+    /* once the song has ended it adds nothing */
+    mixed = WM_MixOutput(mdi, frames, &song_mix, &silent, 1);
+    if (mixed == -1) {
+        _WM_Unlock(&mdi->lock);
         return (-1);
     }
+    frames = (uint32_t) mixed;
+    if (!silent) {
+        if (gain == WM_BUS_UNITY) {
+            for (i = 0; i < (frames * 2); i++)
+                mix[i] += song_mix[i];
+        } else {
+            for (i = 0; i < (frames * 2); i++)
+                mix[i] += (int32_t) (((int64_t) song_mix[i] * gain) >> 8);
+        }
+    }
 
-    ret = WildMidi_ConvertBufferToMidi(buf, *size, out, size);
-    _WM_FreeBufferFile(buf);
-    return ret;
+    WM_RenderTime(mdi, start);
+    _WM_Unlock(&mdi->lock);
+    return (0);
 }
 
-WM_SYMBOL int WildMidi_ConvertBufferToMidi (const uint8_t *in, uint32_t insize,
-                                            uint8_t **out, uint32_t *outsize) {
+/* takes mdi off the bus, the bus lock is held */
+static void WM_BusDrop(struct _bus *bus, struct _mdi *mdi) {
+    uint32_t i;
+
+    for (i = 0; i < bus->member_count; i++) {
+        if (bus->member[i].mdi == mdi) {
+            bus->member[i] = bus->member[--bus->member_count];
+            break;
+        }
+    }
+    mdi->bus = NULL;
+}
+
+/* renders frames of every song on the bus into a single output, returns
+   -1 without the memory for the mix or for that of one of the songs */
+static int WM_BusRender(struct _bus *bus, uint32_t frames, void *out, uint16_t format) {
+    int32_t *mix_buffer;
+    uint32_t i;
+
+    _WM_Lock(&bus->lock);
+    if ((frames * 2) > bus->mix_buffer_size) {
+        mix_buffer = (int32_t *) realloc(bus->mix_buffer, ((frames * 2) * sizeof(int32_t)));
+        if (mix_buffer == NULL) {
+            _WM_Unlock(&bus->lock);
+            _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, "(to mix the bus)", 0);
+            return (-1);
+        }
+        bus->mix_buffer = mix_buffer;
+        bus->mix_buffer_size = frames * 2;
+    }
+    memset(bus->mix_buffer, 0, ((frames * 2) * sizeof(int32_t)));
+
+    for (i = 0; i < bus->member_count; i++) {
+        if (WM_BusMix(bus, &bus->member[i], frames) == -1) {
+            _WM_Unlock(&bus->lock);
+            return (-1);
+        }
+    }
+
+    if ((bus->options & WM_MO_REVERB) && (bus->reverb != NULL)) {
+        /* once for all of the songs, which are mixed dry */
+        _WM_do_reverb(bus->reverb, bus->mix_buffer, (frames * 2));
+    }
+    WM_Write(bus->mix_buffer, out, frames, format);
+
+    _WM_Unlock(&bus->lock);
+    return ((int) frames);
+}
+
+/*
+ * =========================
+ * External Functions
+ * =========================
+ */
+
+/* the options set by WildMidi_SetCvtOption(), as they are right now */
+static void WM_CvtOptionsNow(struct _WM_CvtOptions *options) {
+    _WM_Lock(&WM_ConvertOptions.lock);
+    options->xmi_convert_type = WM_ConvertOptions.xmi_convert_type;
+    options->frequency = WM_ConvertOptions.frequency;
+    _WM_Unlock(&WM_ConvertOptions.lock);
+}
+
+/* touches no global state besides the error, any number of these may run at once */
+static int WM_ConvertBufferToMidi(const uint8_t *in, uint32_t insize,
+                                  uint8_t **out, uint32_t *outsize,
+                                  const struct _WM_CvtOptions *options) {
     if (!in || !out || !outsize) {
         _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL params)", 0);
         return (-1);
     }
+    if (insize < 4) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_CORUPT, "(too short)", 0);
+        return (-1);
+    }
 
     if (!memcmp(in, "FORM", 4)) {
         if (_WM_xmi2midi(in, insize, out, outsize,
-                _cvt_get_option(WM_CO_XMI_TYPE)) < 0) {
+                options->xmi_convert_type) < 0) {
             return (-1);
         }
     }
     else if (!memcmp(in, "MUS", 3)) {
         if (_WM_mus2midi(in, insize, out, outsize,
-                _cvt_get_option(WM_CO_FREQUENCY)) < 0) {
+                options->frequency) < 0) {
             return (-1);
         }
     }
@@ -1524,6 +2055,59 @@ WM_SYMBOL int WildMidi_ConvertBufferToMidi (const uint8_t *in, uint32_t insize,
     return (0);
 }
 
+static int WM_ConvertToMidi(const char *file, uint8_t **out, uint32_t *size,
+                            const struct _WM_CvtOptions *options) {
+    const uint8_t *buf;
+    uint32_t bufsize;
+    int ret;
+
+    if (!file) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL filename)", 0);
+        return (-1);
+    }
+    if ((buf = (const uint8_t *) _WM_MapFile(file, &bufsize)) == NULL) {
+        return (-1);
+    }
+
+    ret = WM_ConvertBufferToMidi(buf, bufsize, out, size, options);
+    _WM_UnmapFile(buf, bufsize);
+    return ret;
+}
+
+WM_SYMBOL int WildMidi_ConvertToMidi (const char *file, uint8_t **out, uint32_t *size) {
+    struct _WM_CvtOptions options;
+
+    WM_CvtOptionsNow(&options);
+    return (WM_ConvertToMidi(file, out, size, &options));
+}
+
+WM_SYMBOL int WildMidi_ConvertBufferToMidi (const uint8_t *in, uint32_t insize,
+                                            uint8_t **out, uint32_t *outsize) {
+    struct _WM_CvtOptions options;
+
+    WM_CvtOptionsNow(&options);
+    return (WM_ConvertBufferToMidi(in, insize, out, outsize, &options));
+}
+
+WM_SYMBOL int WildMidi_ConvertToMidiOpt (const char *file, uint8_t **out, uint32_t *size,
+                                         const struct _WM_CvtOptions *options) {
+    if (options == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL options)", 0);
+        return (-1);
+    }
+    return (WM_ConvertToMidi(file, out, size, options));
+}
+
+WM_SYMBOL int WildMidi_ConvertBufferToMidiOpt (const uint8_t *in, uint32_t insize,
+                                               uint8_t **out, uint32_t *outsize,
+                                               const struct _WM_CvtOptions *options) {
+    if (options == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL options)", 0);
+        return (-1);
+    }
+    return (WM_ConvertBufferToMidi(in, insize, out, outsize, options));
+}
+
 WM_SYMBOL const char *WildMidi_GetString(uint16_t info) {
     static char WM_Version[] = "WildMidi Processing Library " PACKAGE_VERSION;
     switch (info) {
@@ -1537,54 +2121,165 @@ WM_SYMBOL long WildMidi_GetVersion (void) {
     return (LIBWILDMIDI_VERSION);
 }
 
-static int _WM_Init(const struct _WM_VIO *callbacks,
-                    const char *config_file, uint16_t rate, uint16_t mixer_options) {
-    if (WM_Initialized) {
-        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_ALR_INIT, NULL, 0);
+/* the locks are there before and after WildMidi_Init(), so are their counts */
+WM_SYMBOL int WildMidi_GetLockStats (struct _WM_LockStats *stats, uint32_t count) {
+    if ((stats == NULL) && (count != 0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL stats)", 0);
         return (-1);
     }
+#if defined(WILDMIDI_LOCK_STATS) && !defined(WM_NO_LOCK)
+    return ((int) _WM_GetLockStats(stats, count));
+#else
+    WMIDI_UNUSED(count);
+    _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(built without lock statistics)", 0);
+    return (-1);
+#endif
+}
 
-    if (config_file == NULL) {
+/* the rates a context can mix and play at */
+#define WM_MIN_RATE 11025
+#define WM_MAX_RATE 192000
+
+static struct _context *WM_CreateContext(const char *config_file, uint32_t rate, uint32_t mix_rate, uint16_t mixer_options) {
+    struct _context *ctx;
+
+    if (config_file == NULL) {
         _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG,
                 "(NULL config file pointer)", 0);
-        return (-1);
+        return (NULL);
+    }
+    if (mixer_options & 0x03F0) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(invalid option)",
+                0);
+        return (NULL);
+    }
+    if (mix_rate == 0) {
+        mix_rate = rate;
+    }
+    if ((rate < WM_MIN_RATE) || (rate > WM_MAX_RATE)
+            || (mix_rate < WM_MIN_RATE) || (mix_rate > WM_MAX_RATE)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG,
+                "(rate out of bounds, range is 11025 - 192000)", 0);
+        return (NULL);
     }
 
-    _WM_BufferFile = callbacks->allocate_file;
-    _WM_FreeBufferFile = callbacks->free_file;
+    ctx = (struct _context *) calloc(1, sizeof(struct _context));
+    if (ctx == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
+        return (NULL);
+    }
+    if ((mix_rate != rate)
+            && ((ctx->resample = _WM_init_resample_filter(mix_rate, rate)) == NULL)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
+        free(ctx);
+        return (NULL);
+    }
+    /* the patches are decoded for the rate they are mixed at */
+    if ((ctx->patches = WM_GetPatchSet(config_file, mix_rate)) == NULL) {
+        free(ctx->resample);
+        free(ctx);
+        return (NULL);
+    }
 
-    WM_InitPatches();
-    if (WM_LoadConfig(config_file) == -1) {
-        return (-1);
+    ctx->sample_rate = mix_rate;
+    ctx->output_rate = rate;
+    ctx->mixer_options = mixer_options;
+    ctx->master_volume = 948;
+    ctx->reverb_room_width = ctx->patches->reverb_room_width;
+    ctx->reverb_room_length = ctx->patches->reverb_room_length;
+    ctx->reverb_listen_posx = ctx->patches->reverb_listen_posx;
+    ctx->reverb_listen_posy = ctx->patches->reverb_listen_posy;
+
+    _WM_Lock(&WM_PatchSets_lock);
+    if (WM_Initialized++ == 0) {
+        _WM_InitMixer();
     }
+    _WM_Unlock(&WM_PatchSets_lock);
 
-    if (mixer_options & 0x0FF0) {
-        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(invalid option)",
-                0);
-        WM_FreePatches();
+    return (ctx);
+}
+
+/* lets go of a reference to song, the last one takes it and its mdi */
+static void WM_ReleaseSong(struct _song *song) {
+    struct _context *ctx = song->mdi->ctx;
+
+    _WM_Lock(&ctx->lock);
+    if (--song->refs != 0) {
+        _WM_Unlock(&ctx->lock);
+        return;
+    }
+    if (song->prev) {
+        song->prev->next = song->next;
+    } else {
+        ctx->first_song = song->next;
+    }
+    if (song->next) {
+        song->next->prev = song->prev;
+    }
+    _WM_Unlock(&ctx->lock);
+
+    _WM_freeMDI(song->mdi);
+    free(song);
+}
+
+static void WM_FreeContext(struct _context *ctx) {
+    /* the opens still queued finish first, their handles go below */
+    _WM_QueueFree(ctx->loader);
+    ctx->loader = NULL;
+    WM_DropPreload(ctx);
+    while (ctx->first_handle) {
+        /* closes open handle and rotates the handles list. */
+        WildMidi_Close((struct _mdi *) ctx->first_handle->handle);
+    }
+    while (ctx->first_song) {
+        /* with the handles gone only the caller's reference is left */
+        ctx->first_song->refs = 1;
+        WM_ReleaseSong(ctx->first_song);
+    }
+    _WM_PutPatchSet(ctx->patches);
+    free(ctx->resample);
+    free(ctx);
+
+    _WM_Lock(&WM_PatchSets_lock);
+    WM_Initialized--;
+    _WM_Unlock(&WM_PatchSets_lock);
+}
+
+static int _WM_Init(const struct _WM_VIO *callbacks, const struct _WM_VIO_Map *map_callbacks,
+                    const char *config_file, uint16_t rate, uint16_t mixer_options) {
+    if (WM_Context) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_ALR_INIT, NULL, 0);
         return (-1);
     }
-    _WM_MixerOptions = mixer_options;
 
-    if (rate < 11025) {
+    if (config_file == NULL) {
         _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG,
-                "(rate out of bounds, range is 11025 - 65535)", 0);
-        WM_FreePatches();
+                "(NULL config file pointer)", 0);
         return (-1);
     }
-    _WM_SampleRate = rate;
 
-    gauss_lock = 0;
-    _WM_patch_lock = 0;
-    _WM_MasterVolume = 948;
-    WM_Initialized = 1;
+    _WM_BufferFile = callbacks->allocate_file;
+    _WM_FreeBufferFile = callbacks->free_file;
+    if (map_callbacks) {
+        _WM_MapFile = map_callbacks->map_file;
+        _WM_UnmapFile = map_callbacks->unmap_file;
+    } else {
+        _WM_MapFile = _WM_MapFileImpl;
+        _WM_UnmapFile = _WM_UnmapFileImpl;
+    }
+
+    if ((WM_Context = WM_CreateContext(config_file, rate, 0, mixer_options)) == NULL) {
+        _WM_MapFile = _WM_MapFileImpl;
+        _WM_UnmapFile = _WM_UnmapFileImpl;
+        return (-1);
+    }
 
     return (0);
 }
 
 WM_SYMBOL int WildMidi_Init(const char *config_file, uint16_t rate, uint16_t mixer_options) {
     struct _WM_VIO callbacks_ = { _WM_BufferFileImpl, _WM_FreeBufferFileImpl };
-    return _WM_Init(&callbacks_, config_file, rate, mixer_options);
+    return _WM_Init(&callbacks_, NULL, config_file, rate, mixer_options);
 }
 
 WM_SYMBOL int WildMidi_InitVIO(struct _WM_VIO *callbacks, const char *config_file, uint16_t rate, uint16_t mixer_options) {
@@ -1593,28 +2288,216 @@ WM_SYMBOL int WildMidi_InitVIO(struct _WM_VIO *callbacks, const char *config_fil
         return (-1);
     }
 
-    return _WM_Init(callbacks, config_file, rate, mixer_options);
+    return _WM_Init(callbacks, NULL, config_file, rate, mixer_options);
 }
 
-WM_SYMBOL int WildMidi_MasterVolume(uint8_t master_volume) {
-    if (!WM_Initialized) {
-        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
+WM_SYMBOL int WildMidi_InitVIOMap(struct _WM_VIO *callbacks, struct _WM_VIO_Map *map_callbacks,
+                                  const char *config_file, uint16_t rate, uint16_t mixer_options) {
+    struct _WM_VIO callbacks_ = { _WM_BufferFileImpl, _WM_FreeBufferFileImpl };
+
+    if (callbacks && (!callbacks->allocate_file || !callbacks->free_file)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL VIO callbacks)", 0);
+        return (-1);
+    }
+    if (!map_callbacks || !map_callbacks->map_file || !map_callbacks->unmap_file) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL VIO map callbacks)", 0);
+        return (-1);
+    }
+
+    return _WM_Init((callbacks) ? callbacks : &callbacks_, map_callbacks, config_file, rate, mixer_options);
+}
+
+WM_SYMBOL wm_context *WildMidi_CreateContext(const char *config_file, uint16_t rate, uint16_t mixer_options) {
+    return ((wm_context *) WM_CreateContext(config_file, rate, 0, mixer_options));
+}
+
+WM_SYMBOL wm_context *WildMidi_CreateContextRate(const char *config_file, uint32_t rate, uint32_t mix_rate, uint16_t mixer_options) {
+    return ((wm_context *) WM_CreateContext(config_file, rate, mix_rate, mixer_options));
+}
+
+WM_SYMBOL int WildMidi_FreeContext(wm_context *context) {
+    if (context == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL context)", 0);
+        return (-1);
+    }
+    if (context == WM_Context) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG,
+                "(default context, use WildMidi_Shutdown)", 0);
         return (-1);
     }
+
+    WM_FreeContext((struct _context *) context);
+    return (0);
+}
+
+static int WM_MasterVolume(struct _context *ctx, uint8_t master_volume) {
     if (master_volume > 127) {
         _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG,
                 "(master volume out of range, range is 0-127)", 0);
         return (-1);
     }
 
-    _WM_MasterVolume = _WM_lin_volume[master_volume];
+    ctx->master_volume = _WM_lin_volume[master_volume];
+
+    return (0);
+}
+
+WM_SYMBOL int WildMidi_MasterVolume(uint8_t master_volume) {
+    if (!WM_Context) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
+        return (-1);
+    }
+
+    return (WM_MasterVolume(WM_Context, master_volume));
+}
+
+WM_SYMBOL int WildMidi_MasterVolumeCtx(wm_context *context, uint8_t master_volume) {
+    if (context == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL context)", 0);
+        return (-1);
+    }
+
+    return (WM_MasterVolume((struct _context *) context, master_volume));
+}
+
+static int WM_SaveSampleCache(struct _context *ctx, const char *cache_file) {
+    struct _patch_set *patches = _WM_CurrentPatchSet(ctx);
+    int ret;
+
+    if (cache_file == NULL) {
+        cache_file = patches->cache_file;
+    }
+    if (cache_file == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG,
+                "(no sample cache file given or set in the config)", 0);
+        _WM_PutPatchSet(patches);
+        return (-1);
+    }
+
+    ret = _WM_WriteSampleCache(patches, cache_file);
+    _WM_PutPatchSet(patches);
+    return (ret);
+}
+
+WM_SYMBOL int WildMidi_SaveSampleCache(const char *cache_file) {
+    if (!WM_Context) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
+        return (-1);
+    }
+
+    return (WM_SaveSampleCache(WM_Context, cache_file));
+}
+
+WM_SYMBOL int WildMidi_SaveSampleCacheCtx(wm_context *context, const char *cache_file) {
+    if (context == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL context)", 0);
+        return (-1);
+    }
+
+    return (WM_SaveSampleCache((struct _context *) context, cache_file));
+}
+
+static int WM_GetSampleStats(struct _context *ctx, struct _WM_SampleStats *stats) {
+    struct _patch_set *patches;
+
+    if (stats == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL stats)", 0);
+        return (-1);
+    }
+
+    patches = _WM_CurrentPatchSet(ctx);
+    _WM_Lock(&patches->lock);
+    stats->budget = (uint32_t) (patches->sample_budget >> 10);
+    stats->resident = (uint32_t) (patches->resident >> 10);
+    stats->hits = patches->hits;
+    stats->misses = patches->misses;
+    _WM_Unlock(&patches->lock);
+    _WM_PutPatchSet(patches);
+    return (0);
+}
+
+WM_SYMBOL int WildMidi_GetSampleStats(struct _WM_SampleStats *stats) {
+    if (!WM_Context) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
+        return (-1);
+    }
+
+    return (WM_GetSampleStats(WM_Context, stats));
+}
+
+WM_SYMBOL int WildMidi_GetSampleStatsCtx(wm_context *context, struct _WM_SampleStats *stats) {
+    if (context == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL context)", 0);
+        return (-1);
+    }
+
+    return (WM_GetSampleStats((struct _context *) context, stats));
+}
+
+/*
+ * Load config_file again, or another one, into a patch set of its own and
+ * make it the one songs opened from now on get. The loading is done with
+ * no lock held so the songs already open play on, each with the patch set
+ * it was opened with, which goes once the last of them is closed.
+ */
+static int WM_ReloadConfig(struct _context *ctx, const char *config_file) {
+    struct _patch_set *current = _WM_CurrentPatchSet(ctx);
+    struct _patch_set *patches;
+
+    if (config_file == NULL) {
+        config_file = current->config_file;
+    }
+    patches = WM_NewPatchSet(config_file, current->rate);
+    _WM_PutPatchSet(current);
+    if (patches == NULL) {
+        return (-1);
+    }
 
+    /* first on the list, so contexts created from now on share it too */
+    _WM_Lock(&WM_PatchSets_lock);
+    patches->next = WM_PatchSets;
+    WM_PatchSets = patches;
+    _WM_Unlock(&WM_PatchSets_lock);
+
+    _WM_Lock(&ctx->lock);
+    current = ctx->patches;
+    ctx->patches = patches;
+    ctx->reverb_room_width = patches->reverb_room_width;
+    ctx->reverb_room_length = patches->reverb_room_length;
+    ctx->reverb_listen_posx = patches->reverb_listen_posx;
+    ctx->reverb_listen_posy = patches->reverb_listen_posy;
+    _WM_Unlock(&ctx->lock);
+
+    /* of no use to the songs opened from now on */
+    WM_DropPreload(ctx);
+    _WM_PutPatchSet(current);
     return (0);
 }
 
+WM_SYMBOL int WildMidi_ReloadConfig(const char *config_file) {
+    if (!WM_Context) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
+        return (-1);
+    }
+
+    return (WM_ReloadConfig(WM_Context, config_file));
+}
+
+WM_SYMBOL int WildMidi_ReloadConfigCtx(wm_context *context, const char *config_file) {
+    if (context == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL context)", 0);
+        return (-1);
+    }
+
+    return (WM_ReloadConfig((struct _context *) context, config_file));
+}
+
 WM_SYMBOL int WildMidi_Close(midi * handle) {
     struct _mdi *mdi = (struct _mdi *) handle;
+    struct _context *ctx;
     struct _hndl * tmp_handle;
+    struct _song *song;
+    struct _bus *bus;
 
     if (!WM_Initialized) {
         _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
@@ -1624,19 +2507,28 @@ WM_SYMBOL int WildMidi_Close(midi * handle) {
         _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL handle)", 0);
         return (-1);
     }
-    if (first_handle == NULL) {
+    if ((bus = mdi->bus) != NULL) {
+        /* it stops being mixed into the bus first */
+        _WM_Lock(&bus->lock);
+        WM_BusDrop(bus, mdi);
+        _WM_Unlock(&bus->lock);
+    }
+    ctx = mdi->ctx;
+    _WM_Lock(&ctx->lock);
+    if (ctx->first_handle == NULL) {
         _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(no midi's open)", 0);
+        _WM_Unlock(&ctx->lock);
         return (-1);
     }
     _WM_Lock(&mdi->lock);
-    if (first_handle->handle == handle) {
-        tmp_handle = first_handle->next;
-        free(first_handle);
-        first_handle = tmp_handle;
-        if (first_handle)
-            first_handle->prev = NULL;
+    if (ctx->first_handle->handle == handle) {
+        tmp_handle = ctx->first_handle->next;
+        free(ctx->first_handle);
+        ctx->first_handle = tmp_handle;
+        if (ctx->first_handle)
+            ctx->first_handle->prev = NULL;
     } else {
-        tmp_handle = first_handle;
+        tmp_handle = ctx->first_handle;
         while (tmp_handle->handle != handle) {
             tmp_handle = tmp_handle->next;
             if (tmp_handle == NULL) {
@@ -1651,67 +2543,114 @@ WM_SYMBOL int WildMidi_Close(midi * handle) {
             free(tmp_handle);
         }
     }
+    _WM_Unlock(&ctx->lock);
 
+    song = mdi->song;
     _WM_freeMDI(mdi);
+    if (song) {
+        WM_ReleaseSong(song);
+    }
 
     return (0);
 }
 
-WM_SYMBOL midi *WildMidi_Open(const char *midifile) {
-    uint8_t *mididata = NULL;
-    uint32_t midisize = 0;
+static struct _mdi *WM_ParseBuffer(struct _context *ctx, const uint8_t *midibuffer, uint32_t size) {
     uint8_t mus_hdr[] = { 'M', 'U', 'S', 0x1A };
     uint8_t xmi_hdr[] = { 'F', 'O', 'R', 'M' };
-    midi * ret = NULL;
 
-    if (!WM_Initialized) {
-        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
+    if (size < 18) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_CORUPT, "(too short)", 0);
         return (NULL);
     }
-    if (midifile == NULL) {
-        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL filename)", 0);
-        return (NULL);
+    if (memcmp(midibuffer,"HMIMIDIP", 8) == 0) {
+        return (_WM_ParseNewHmp(ctx, midibuffer, size));
+    } else if (memcmp(midibuffer, "HMI-MIDISONG061595", 18) == 0) {
+        return (_WM_ParseNewHmi(ctx, midibuffer, size));
+    } else if (memcmp(midibuffer, mus_hdr, 4) == 0) {
+        return (_WM_ParseNewMus(ctx, midibuffer, size));
+    } else if (memcmp(midibuffer, xmi_hdr, 4) == 0) {
+        return (_WM_ParseNewXmi(ctx, midibuffer, size));
     }
+    return (_WM_ParseNewMidi(ctx, midibuffer, size));
+}
+
+static midi *WM_OpenBuffer(struct _context *ctx, const uint8_t *midibuffer, uint32_t size) {
+    struct _mdi *mdi;
 
-    if ((mididata = (uint8_t *) _WM_BufferFile(midifile, &midisize)) == NULL) {
+    if ((mdi = WM_ParseBuffer(ctx, midibuffer, size)) == NULL)
         return (NULL);
-    }
-    if (midisize < 18) {
-        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_CORUPT, "(too short)", 0);
+
+    _WM_decode_patches(mdi);
+    if (add_handle(ctx, mdi) != 0) {
+        _WM_freeMDI(mdi);
         return (NULL);
     }
-    if (memcmp(mididata,"HMIMIDIP", 8) == 0) {
-        ret = (void *) _WM_ParseNewHmp(mididata, midisize);
-    } else if (memcmp(mididata, "HMI-MIDISONG061595", 18) == 0) {
-        ret = (void *) _WM_ParseNewHmi(mididata, midisize);
-    } else if (memcmp(mididata, mus_hdr, 4) == 0) {
-        ret = (void *) _WM_ParseNewMus(mididata, midisize);
-    } else if (memcmp(mididata, xmi_hdr, 4) == 0) {
-        ret = (void *) _WM_ParseNewXmi(mididata, midisize);
-    } else {
-        ret = (void *) _WM_ParseNewMidi(mididata, midisize);
+
+    return ((midi *) mdi);
+}
+
+static midi *WM_Open(struct _context *ctx, const char *midifile) {
+    const uint8_t *mididata = NULL;
+    uint32_t midisize = 0;
+    midi * ret = NULL;
+
+    if (midifile == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL filename)", 0);
+        return (NULL);
     }
-    _WM_FreeBufferFile(mididata);
 
-    if (ret) {
-        if (add_handle(ret) != 0) {
-            WildMidi_Close(ret);
-            ret = NULL;
-        }
+    if ((mididata = (const uint8_t *) _WM_MapFile(midifile, &midisize)) == NULL) {
+        return (NULL);
     }
+    ret = WM_OpenBuffer(ctx, mididata, midisize);
+    _WM_UnmapFile(mididata, midisize);
 
     return (ret);
 }
 
-WM_SYMBOL midi *WildMidi_OpenBuffer(const uint8_t *midibuffer, uint32_t size) {
-    uint8_t mus_hdr[] = { 'M', 'U', 'S', 0x1A };
-    uint8_t xmi_hdr[] = { 'F', 'O', 'R', 'M' };
-    midi * ret = NULL;
+/*
+ * Run the parsers over a buffer with a throw away context that has no
+ * patches, only the timing and the meta data of the song are kept.
+ */
+static int WM_Probe(uint32_t rate, uint16_t mixer_options, const uint8_t *midibuffer, uint32_t size, struct _WM_Info *info) {
+    struct _context ctx;
+    struct _mdi *mdi;
 
-    if (!WM_Initialized) {
-        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
-        return (NULL);
+    if (midibuffer == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL midi data buffer)", 0);
+        return (-1);
+    }
+    if (info == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL info)", 0);
+        return (-1);
+    }
+    if (size > WM_MAXFILESIZE) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_LONGFIL, NULL, 0);
+        return (-1);
     }
+
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.sample_rate = rate;
+    /* only the option that changes the timing, nothing is played */
+    ctx.mixer_options = mixer_options & WM_MO_ROUNDTEMPO;
+    ctx.probe = 1;
+
+    if ((mdi = WM_ParseBuffer(&ctx, midibuffer, size)) == NULL)
+        return (-1);
+
+    info->current_sample = 0;
+    info->approx_total_samples = mdi->extra_info.approx_total_samples;
+    info->mixer_options = mdi->extra_info.mixer_options;
+    info->total_midi_time = (info->approx_total_samples * 1000) / rate;
+    /* handed over to the caller */
+    info->copyright = mdi->extra_info.copyright;
+    mdi->extra_info.copyright = NULL;
+
+    _WM_freeMDI(mdi);
+    return (0);
+}
+
+static midi *WM_OpenBufferChecked(struct _context *ctx, const uint8_t *midibuffer, uint32_t size) {
     if (midibuffer == NULL) {
         _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL midi data buffer)", 0);
         return (NULL);
@@ -1721,36 +2660,1227 @@ WM_SYMBOL midi *WildMidi_OpenBuffer(const uint8_t *midibuffer, uint32_t size) {
         _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_LONGFIL, NULL, 0);
         return (NULL);
     }
-    if (size < 18) {
-        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_CORUPT, "(too short)", 0);
+    return (WM_OpenBuffer(ctx, midibuffer, size));
+}
+
+WM_SYMBOL midi *WildMidi_Open(const char *midifile) {
+    if (!WM_Context) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
         return (NULL);
     }
-    if (memcmp(midibuffer,"HMIMIDIP", 8) == 0) {
-        ret = (void *) _WM_ParseNewHmp(midibuffer, size);
-    } else if (memcmp(midibuffer, "HMI-MIDISONG061595", 18) == 0) {
-        ret = (void *) _WM_ParseNewHmi(midibuffer, size);
-    } else if (memcmp(midibuffer, mus_hdr, 4) == 0) {
-        ret = (void *) _WM_ParseNewMus(midibuffer, size);
-    } else if (memcmp(midibuffer, xmi_hdr, 4) == 0) {
-        ret = (void *) _WM_ParseNewXmi(midibuffer, size);
-    } else {
-        ret = (void *) _WM_ParseNewMidi(midibuffer, size);
+    return (WM_Open(WM_Context, midifile));
+}
+
+WM_SYMBOL midi *WildMidi_OpenCtx(wm_context *context, const char *midifile) {
+    if (context == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL context)", 0);
+        return (NULL);
+    }
+    return (WM_Open((struct _context *) context, midifile));
+}
+
+WM_SYMBOL midi *WildMidi_OpenBuffer(const uint8_t *midibuffer, uint32_t size) {
+    if (!WM_Context) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
+        return (NULL);
+    }
+    return (WM_OpenBufferChecked(WM_Context, midibuffer, size));
+}
+
+WM_SYMBOL midi *WildMidi_OpenBufferCtx(wm_context *context, const uint8_t *midibuffer, uint32_t size) {
+    if (context == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL context)", 0);
+        return (NULL);
+    }
+    return (WM_OpenBufferChecked((struct _context *) context, midibuffer, size));
+}
+
+/*
+ * Decode the patches asked for through a song that never plays, the same
+ * way as those of a song being opened, and hold them in ctx in place of
+ * the ones held before. Patches on both lists stay loaded all along.
+ */
+static int WM_PreloadPatches(struct _context *ctx, const uint16_t *patchids, uint32_t count) {
+    struct _patch_set *patches, *old_set;
+    struct _patch *patch;
+    struct _patch **list = NULL, **old_list;
+    uint16_t *all = NULL;
+    uint32_t list_count = 0, old_count;
+    struct _mdi *mdi;
+    uint32_t i;
+
+    if ((patchids != NULL) && (count == 0)) {
+        WM_DropPreload(ctx);
+        return (0);
+    }
+    if ((mdi = _WM_initMDI(ctx)) == NULL) {
+        return (-1);
+    }
+    patches = mdi->patch_set;
+
+    if (patchids == NULL) {
+        /* every patch the config names */
+        _WM_Lock(&patches->lock);
+        for (i = 0, count = 0; i < 128; i++) {
+            for (patch = patches->patch[i]; patch; patch = patch->next) {
+                count++;
+            }
+        }
+        if ((count != 0) && ((all = (uint16_t *) malloc(sizeof(uint16_t) * count)) != NULL)) {
+            for (i = 0, count = 0; i < 128; i++) {
+                for (patch = patches->patch[i]; patch; patch = patch->next) {
+                    all[count++] = patch->patchid;
+                }
+            }
+        }
+        _WM_Unlock(&patches->lock);
+        if ((count != 0) && (all == NULL)) {
+            _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
+            _WM_freeMDI(mdi);
+            return (-1);
+        }
+        patchids = all;
+    }
+
+    for (i = 0; i < count; i++) {
+        _WM_load_patch(mdi, patchids[i]);
+    }
+    free(all);
+    _WM_decode_patches(mdi);
+
+    if (_WM_hold_patches(mdi, &list, &list_count) != 0) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
+        _WM_release_patches(patches, list, list_count);
+        _WM_freeMDI(mdi);
+        return (-1);
+    }
+    _WM_HoldPatchSet(patches);
+    _WM_freeMDI(mdi);
+
+    _WM_Lock(&ctx->lock);
+    old_set = ctx->preload_set;
+    old_list = ctx->preload;
+    old_count = ctx->preload_count;
+    ctx->preload_set = patches;
+    ctx->preload = list;
+    ctx->preload_count = list_count;
+    _WM_Unlock(&ctx->lock);
+
+    if (old_set != NULL) {
+        _WM_release_patches(old_set, old_list, old_count);
+        _WM_PutPatchSet(old_set);
+    }
+    return (0);
+}
+
+WM_SYMBOL int WildMidi_PreloadPatches(const uint16_t *patchids, uint32_t count) {
+    if (!WM_Context) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
+        return (-1);
+    }
+    return (WM_PreloadPatches(WM_Context, patchids, count));
+}
+
+WM_SYMBOL int WildMidi_PreloadPatchesCtx(wm_context *context, const uint16_t *patchids, uint32_t count) {
+    if (context == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL context)", 0);
+        return (-1);
+    }
+    return (WM_PreloadPatches((struct _context *) context, patchids, count));
+}
+
+struct _open_job {
+    struct _context *ctx;
+    void (*done)(void *user, midi *handle);
+    void *user;
+    char midifile[1];
+};
+
+static void WM_OpenJob(void *data) {
+    struct _open_job *job = (struct _open_job *) data;
+
+    job->done(job->user, WM_Open(job->ctx, job->midifile));
+    free(job);
+}
+
+/*
+ * Open midifile on the loader thread of ctx, started the first time it is
+ * needed, and hand the handle to done from there. Without thread support
+ * the file is opened before this returns.
+ */
+static int WM_OpenAsync(struct _context *ctx, const char *midifile,
+                        void (*done)(void *user, midi *handle), void *user) {
+    struct _open_job *job;
+    struct _WM_Queue *loader;
+
+    if (midifile == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL filename)", 0);
+        return (-1);
+    }
+    if (done == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL callback)", 0);
+        return (-1);
+    }
+
+    job = (struct _open_job *) malloc(sizeof(struct _open_job) + strlen(midifile));
+    if (job == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
+        return (-1);
+    }
+    job->ctx = ctx;
+    job->done = done;
+    job->user = user;
+    strcpy(job->midifile, midifile);
+
+    _WM_Lock(&ctx->lock);
+    if (ctx->loader == NULL) {
+        ctx->loader = _WM_QueueCreate();
+    }
+    loader = ctx->loader;
+    _WM_Unlock(&ctx->lock);
+
+    if (loader == NULL) {
+        WM_OpenJob(job);
+        return (0);
+    }
+    if (_WM_QueuePost(loader, WM_OpenJob, job) != 0) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
+        free(job);
+        return (-1);
+    }
+    return (0);
+}
+
+WM_SYMBOL int WildMidi_OpenAsync(const char *midifile, void (*done)(void *user, midi *handle), void *user) {
+    if (!WM_Context) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
+        return (-1);
+    }
+    return (WM_OpenAsync(WM_Context, midifile, done, user));
+}
+
+WM_SYMBOL int WildMidi_OpenAsyncCtx(wm_context *context, const char *midifile,
+                                    void (*done)(void *user, midi *handle), void *user) {
+    if (context == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL context)", 0);
+        return (-1);
+    }
+    return (WM_OpenAsync((struct _context *) context, midifile, done, user));
+}
+
+WM_SYMBOL int WildMidi_Probe(const uint8_t *midibuffer, uint32_t size, struct _WM_Info *info) {
+    /* works without WildMidi_Init(), the timing is then worked out at 44100 */
+    if (!WM_Context)
+        return (WM_Probe(44100, 0, midibuffer, size, info));
+    return (WM_Probe(WM_Context->output_rate, WM_Context->mixer_options, midibuffer, size, info));
+}
+
+WM_SYMBOL int WildMidi_ProbeCtx(wm_context *context, const uint8_t *midibuffer, uint32_t size, struct _WM_Info *info) {
+    struct _context *ctx = (struct _context *) context;
+    if (context == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL context)", 0);
+        return (-1);
+    }
+    return (WM_Probe(ctx->output_rate, ctx->mixer_options, midibuffer, size, info));
+}
+
+static wm_song *WM_Parse(struct _context *ctx, const uint8_t *midibuffer, uint32_t size) {
+    struct _song *song;
+    struct _mdi *mdi;
+
+    if (midibuffer == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL midi data buffer)", 0);
+        return (NULL);
+    }
+    if (size > WM_MAXFILESIZE) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_LONGFIL, NULL, 0);
+        return (NULL);
+    }
+
+    if ((mdi = WM_ParseBuffer(ctx, midibuffer, size)) == NULL)
+        return (NULL);
+    if (mdi->stream) {
+        /* its events are only ever a window of the song */
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(streamed songs cannot be shared)", 0);
+        _WM_freeMDI(mdi);
+        return (NULL);
+    }
+    song = (struct _song *) malloc(sizeof(struct _song));
+    if (song == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
+        _WM_freeMDI(mdi);
+        return (NULL);
+    }
+    _WM_decode_patches(mdi);
+
+    song->mdi = mdi;
+    song->refs = 1;
+    song->prev = NULL;
+    _WM_Lock(&ctx->lock);
+    song->next = ctx->first_song;
+    if (song->next) {
+        song->next->prev = song;
+    }
+    ctx->first_song = song;
+    _WM_Unlock(&ctx->lock);
+
+    return ((wm_song *) song);
+}
+
+WM_SYMBOL wm_song *WildMidi_Parse(const uint8_t *midibuffer, uint32_t size) {
+    if (!WM_Context) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
+        return (NULL);
+    }
+    return (WM_Parse(WM_Context, midibuffer, size));
+}
+
+WM_SYMBOL wm_song *WildMidi_ParseCtx(wm_context *context, const uint8_t *midibuffer, uint32_t size) {
+    if (context == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL context)", 0);
+        return (NULL);
+    }
+    return (WM_Parse((struct _context *) context, midibuffer, size));
+}
+
+WM_SYMBOL midi *WildMidi_Instantiate(wm_song *handle) {
+    struct _song *song = (struct _song *) handle;
+    struct _context *ctx;
+    struct _mdi *mdi;
+
+    if (!WM_Initialized) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
+        return (NULL);
+    }
+    if (handle == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL song)", 0);
+        return (NULL);
+    }
+
+    ctx = song->mdi->ctx;
+    _WM_Lock(&ctx->lock);
+    song->refs++;
+    _WM_Unlock(&ctx->lock);
+
+    if ((mdi = _WM_ShareMDI(song)) == NULL) {
+        WM_ReleaseSong(song);
+        return (NULL);
+    }
+    if (add_handle(ctx, mdi) != 0) {
+        _WM_freeMDI(mdi);
+        WM_ReleaseSong(song);
+        return (NULL);
+    }
+    return ((midi *) mdi);
+}
+
+WM_SYMBOL int WildMidi_ReleaseSong(wm_song *handle) {
+    if (!WM_Initialized) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
+        return (-1);
+    }
+    if (handle == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL song)", 0);
+        return (-1);
+    }
+    WM_ReleaseSong((struct _song *) handle);
+    return (0);
+}
+
+/* frames each batch job renders between calls to the sink */
+#define WM_BATCH_FRAMES 4096
+
+struct _batch_job {
+    struct _context *ctx;
+    const char * const *midifiles;
+    uint32_t count;
+    uint16_t format;
+    const struct _WM_BatchSink *sink;
+    void *user;
+
+    /* under lock */
+    uint32_t next;
+    uint32_t failed;
+    int lock;
+
+    /* the patches the songs of patches used, under its lock */
+    struct _patch_set *patches;
+    struct _patch **held;
+    uint32_t held_count;
+};
+
+/* returns 0 if the whole song went to the sink */
+static int WM_BatchSong(struct _batch_job *job, uint32_t idx, void *buffer) {
+    const struct _WM_BatchSink *sink = job->sink;
+    struct _mdi *mdi;
+    struct _WM_Info info;
+    int frames;
+    void *out;
+    int status = 0;
+
+    mdi = (struct _mdi *) WM_Open(job->ctx, job->midifiles[idx]);
+    if (mdi == NULL) {
+        sink->open(job->user, idx, job->midifiles[idx], NULL);
+        return (-1);
+    }
+    /* every song has to end */
+    mdi->extra_info.mixer_options &= ~WM_MO_LOOP;
+
+    info.copyright = mdi->extra_info.copyright;
+    info.current_sample = 0;
+    info.approx_total_samples = WM_ToOutput(job->ctx, mdi->extra_info.approx_total_samples);
+    info.mixer_options = mdi->extra_info.mixer_options;
+    info.total_midi_time = (info.approx_total_samples * 1000) / job->ctx->output_rate;
+
+    out = sink->open(job->user, idx, job->midifiles[idx], &info);
+    if (out != NULL) {
+        do {
+            frames = WM_Render(mdi, WM_BATCH_FRAMES, buffer, job->format);
+            if (frames == -1) {
+                status = -1;
+                break;
+            }
+            if ((frames != 0) && (sink->write(out, buffer, (uint32_t) frames) != 0)) {
+                status = -1;
+                break;
+            }
+        } while (frames == WM_BATCH_FRAMES);
+        sink->close(out, status);
+    } else {
+        status = -1;
+    }
+
+    /* so the next songs find the patches still loaded */
+    if (mdi->patch_set == job->patches) {
+        _WM_hold_patches(mdi, &job->held, &job->held_count);
+    }
+    WildMidi_Close(mdi);
+    return (status);
+}
+
+static void WM_BatchJob(void *data, int worker) {
+    struct _batch_job *job = (struct _batch_job *) data;
+    void *buffer;
+    uint32_t i;
+    int status;
+
+    WMIDI_UNUSED(worker);
+
+    /* big enough for any of the formats */
+    buffer = malloc(WM_BATCH_FRAMES * 2 * sizeof(int32_t));
+
+    for (;;) {
+        _WM_Lock(&job->lock);
+        i = job->next++;
+        _WM_Unlock(&job->lock);
+        if (i >= job->count) {
+            break;
+        }
+
+        if (buffer == NULL) {
+            _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, 0);
+            job->sink->open(job->user, i, job->midifiles[i], NULL);
+            status = -1;
+        } else {
+            status = WM_BatchSong(job, i, buffer);
+        }
+        if (status != 0) {
+            _WM_Lock(&job->lock);
+            job->failed++;
+            _WM_Unlock(&job->lock);
+        }
+    }
+
+    free(buffer);
+}
+
+/*
+ * Render a list of files on a pool of threads, each taking the next file
+ * once done with the last. The songs are opened with the context as if by
+ * WildMidi_OpenCtx(), so all of them share its patches, and every patch a
+ * song loaded stays loaded until the whole batch is done.
+ */
+static int WM_RenderBatch(struct _context *ctx, const char * const *midifiles, uint32_t count, uint8_t threads,
+                          uint16_t format, const struct _WM_BatchSink *sink, void *user) {
+    struct _batch_job job;
+    struct _WM_Pool *pool = NULL;
+    int workers = threads;
+
+    if (midifiles == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL file list)", 0);
+        return (-1);
+    }
+    if ((sink == NULL) || (sink->open == NULL) || (sink->write == NULL) || (sink->close == NULL)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL sink)", 0);
+        return (-1);
+    }
+    if (!WM_FMT_VALID(format)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(invalid format)", 0);
+        return (-1);
+    }
+    if (count > 0x7FFFFFFF) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(too many files)", 0);
+        return (-1);
+    }
+    if (count == 0) {
+        return (0);
+    }
+
+    job.ctx = ctx;
+    job.midifiles = midifiles;
+    job.count = count;
+    job.format = format;
+    job.sink = sink;
+    job.user = user;
+    job.next = 0;
+    job.failed = 0;
+    job.lock = 0;
+    job.patches = _WM_CurrentPatchSet(ctx);
+    job.held = NULL;
+    job.held_count = 0;
+
+    if (workers == 0) {
+        workers = _WM_CpuCount();
+    }
+    if (workers > WM_MAX_THREADS) {
+        workers = WM_MAX_THREADS;
+    }
+    if ((uint32_t) workers > count) {
+        workers = count;
+    }
+    /* without thread support the files are rendered one after the other */
+    if (workers > 1) {
+        pool = _WM_PoolCreate(workers);
+    }
+    if (pool) {
+        _WM_PoolRun(pool, WM_BatchJob, &job);
+        _WM_PoolFree(pool);
+    } else {
+        WM_BatchJob(&job, 0);
+    }
+
+    _WM_release_patches(job.patches, job.held, job.held_count);
+    _WM_PutPatchSet(job.patches);
+    return ((int) job.failed);
+}
+
+WM_SYMBOL int WildMidi_RenderBatch(const char * const *midifiles, uint32_t count, uint8_t threads,
+                                   uint16_t format, const struct _WM_BatchSink *sink, void *user) {
+    if (!WM_Context) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
+        return (-1);
+    }
+    return (WM_RenderBatch(WM_Context, midifiles, count, threads, format, sink, user));
+}
+
+WM_SYMBOL int WildMidi_RenderBatchCtx(wm_context *context, const char * const *midifiles, uint32_t count, uint8_t threads,
+                                      uint16_t format, const struct _WM_BatchSink *sink, void *user) {
+    if (context == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL context)", 0);
+        return (-1);
+    }
+    return (WM_RenderBatch((struct _context *) context, midifiles, count, threads, format, sink, user));
+}
+
+WM_SYMBOL int WildMidi_FastSeek(midi * handle, unsigned long int *sample_pos) {
+    struct _mdi *mdi;
+    struct _event *event;
+    struct _note *note_data;
+    unsigned long int seek_pos;
+    uint32_t i;
+
+    if (!WM_Initialized) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
+        return (-1);
+    }
+    if (handle == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL handle)", 0);
+        return (-1);
+    }
+    if (sample_pos == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL seek position pointer)", 0);
+        return (-1);
+    }
+
+    mdi = (struct _mdi *) handle;
+    _WM_Lock(&mdi->lock);
+    event = mdi->current_event;
+    /* the caller counts at the output rate, the song at the mixing rate */
+    seek_pos = WM_ToMix(mdi->ctx, (uint32_t) *sample_pos);
+
+    /* make sure we havent asked for a positions beyond the end of the song. */
+    if ((!mdi->streaming) && (seek_pos > mdi->extra_info.approx_total_samples)) {
+        /* if so set the position to the end of the song */
+        seek_pos = mdi->extra_info.approx_total_samples;
+        *sample_pos = WM_ToOutput(mdi->ctx, (uint32_t) seek_pos);
+    }
+
+    /* was end of song requested and are we are there? */
+    if ((!mdi->streaming) && (seek_pos == mdi->extra_info.approx_total_samples)) {
+        /* yes */
+        _WM_Unlock(&mdi->lock);
+        return (0);
+    }
+
+    if (mdi->seek_index) {
+        /* start from the nearest checkpoint */
+        _WM_SeekIndexed(mdi, seek_pos);
+        _WM_reset_reverb(mdi->reverb);
+        _WM_reset_resample(mdi->resample);
+        _WM_Unlock(&mdi->lock);
+        return (0);
+    }
+
+    /* did we want to fast forward? */
+    if (mdi->extra_info.current_sample > seek_pos) {
+        /* no - reset some stuff */
+        _WM_ResetToStart((struct _mdi *) handle);
+        event = mdi->events;
+        mdi->extra_info.current_sample = 0;
+        mdi->samples_to_mix = 0;
+    }
+
+    if ((mdi->extra_info.current_sample + mdi->samples_to_mix) > seek_pos) {
+        mdi->samples_to_mix = (mdi->extra_info.current_sample + mdi->samples_to_mix) - seek_pos;
+        mdi->extra_info.current_sample = seek_pos;
+    } else {
+        mdi->extra_info.current_sample += mdi->samples_to_mix;
+        mdi->samples_to_mix = 0;
+        while ((!mdi->samples_to_mix) && WM_HAVE_EVENT(mdi, event)) {
+            _WM_DoEvent(mdi, event);
+            mdi->samples_to_mix = event->samples_to_next;
+                
+            if ((mdi->extra_info.current_sample + mdi->samples_to_mix) > seek_pos) {
+                mdi->samples_to_mix = (mdi->extra_info.current_sample + mdi->samples_to_mix) - seek_pos;
+                mdi->extra_info.current_sample = seek_pos;
+            } else {
+                mdi->extra_info.current_sample += mdi->samples_to_mix;
+                mdi->samples_to_mix = 0;
+            }
+            event++;
+        }
+        mdi->current_event = event;
+        if (mdi->stream && (mdi->extra_info.current_sample < seek_pos)) {
+            /* a streamed song can turn out to end before the position */
+            *sample_pos = WM_ToOutput(mdi->ctx, mdi->extra_info.current_sample);
+        }
+    }
+
+    /*
+     * Clear notes as this is a fast seek so we only care
+     * about new notes.
+     *
+     * NOTE: This function is for performance only.
+     * Might need a WildMidi_SlowSeek if we need better accuracy.
+     */
+    for (i = 0; i < mdi->voice_count; i++) {
+        note_data = mdi->voice[i];
+        note_data->active = 0;
+        if (note_data->replay) {
+            note_data->replay = NULL;
+        }
+    }
+    mdi->voice_count = 0;
+
+    /* clear the reverb buffers since we not gonna be using them here */
+    _WM_reset_reverb(mdi->reverb);
+    _WM_reset_resample(mdi->resample);
+
+    _WM_Unlock(&mdi->lock);
+    return (0);
+}
+
+WM_SYMBOL int WildMidi_SetSeekIndex(midi * handle, uint16_t interval, uint8_t restart_notes) {
+    struct _mdi *mdi;
+    uint32_t sample_pos;
+
+    if (!WM_Initialized) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
+        return (-1);
+    }
+    if (handle == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL handle)", 0);
+        return (-1);
+    }
+
+    mdi = (struct _mdi *) handle;
+    if (mdi->stream) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(not available for streamed midi)", 0);
+        return (-1);
+    }
+    _WM_Lock(&mdi->lock);
+    if (interval == 0) {
+        _WM_FreeSeekIndex(mdi);
+        _WM_Unlock(&mdi->lock);
+        return (0);
+    }
+
+    sample_pos = mdi->extra_info.current_sample;
+    if (_WM_BuildSeekIndex(mdi, ((uint32_t) interval * mdi->ctx->sample_rate), restart_notes) == -1) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, 0);
+        _WM_Unlock(&mdi->lock);
+        return (-1);
+    }
+    /* building it rewound the song, go back to where it was */
+    if (sample_pos != 0) {
+        _WM_SeekIndexed(mdi, sample_pos);
+    }
+    _WM_reset_reverb(mdi->reverb);
+
+    _WM_Unlock(&mdi->lock);
+    return (0);
+}
+
+WM_SYMBOL int WildMidi_SongSeek (midi * handle, int8_t nextsong) {
+    struct _mdi *mdi;
+    struct _note *note_data;
+    uint32_t song;
+    uint32_t at;
+    uint32_t i;
+
+    if (!WM_Initialized) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
+        return (-1);
+    }
+    if (handle == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL handle)", 0);
+        return (-1);
+    }
+    mdi = (struct _mdi *) handle;
+    _WM_Lock(&mdi->lock);
+
+    if ((!mdi->is_type2) && (nextsong != 0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(Illegal use. Only usable with files detected to be type 2 compatible.", 0);
+        _WM_Unlock(&mdi->lock);
+        return (-1);
+    }
+    if ((nextsong > 1) || (nextsong < -1)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(Invalid nextsong: -1 is previous song, 0 is start of current song, 1 is next song)", 0);
+        _WM_Unlock(&mdi->lock);
+        return (-1);
+    }
+
+    if (mdi->stream) {
+        /* only the window is there, read again from the start */
+        _WM_ResetToStart(mdi);
+        for (i = 0; i < mdi->voice_count; i++) {
+            note_data = mdi->voice[i];
+            note_data->active = 0;
+            note_data->replay = NULL;
+        }
+        mdi->voice_count = 0;
+        _WM_reset_resample(mdi->resample);
+        _WM_Unlock(&mdi->lock);
+        return (0);
+    }
+
+    /* where each song starts is worked out once, each seek is then just
+       a matter of putting back the state it starts in */
+    if (mdi->song_start == NULL) {
+        /* building the index rewinds, so go back to where it was */
+        at = mdi->extra_info.current_sample;
+        if (_WM_BuildSongIndex(mdi) == -1) {
+            _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, "(to index the songs)", errno);
+            _WM_Unlock(&mdi->lock);
+            return (-1);
+        }
+        if (at != 0) {
+            _WM_SongSeekSample(mdi, at);
+        }
+    }
+    i = (uint32_t)(mdi->current_event - mdi->events);
+    song = _WM_SongAt(mdi, i);
+
+    if (nextsong == -1) {
+        /* goto start of previous song, the first one stays where it is */
+        if (song != 0) {
+            song--;
+        }
+    } else if (nextsong == 1) {
+        /* goto start of next song, or that of the last one again */
+        if ((song + 1) < mdi->song_count) {
+            song++;
+        } else if (mdi->events[i].evtype == ev_null) {
+            /* it has already ended */
+            song = mdi->song_count;
+        }
+    }
+
+    /* once the last song has ended it stays where it is */
+    if (song < mdi->song_count) {
+        _WM_StartSong(mdi, song);
+        _WM_reset_resample(mdi->resample);
+    }
+
+    _WM_Unlock(&mdi->lock);
+    return (0);
+}
+
+WM_SYMBOL int WildMidi_GetSongInfo (midi * handle, uint32_t song, struct _WM_SongInfo *info) {
+    struct _mdi *mdi;
+    uint32_t at;
+    int count;
+
+    if (!WM_Initialized) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
+        return (-1);
+    }
+    if (handle == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL handle)", 0);
+        return (-1);
+    }
+    mdi = (struct _mdi *) handle;
+    _WM_Lock(&mdi->lock);
+
+    if (mdi->stream) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(not with a streamed file)", 0);
+        _WM_Unlock(&mdi->lock);
+        return (-1);
+    }
+
+    if (mdi->song_start == NULL) {
+        /* building the index rewinds, so play on from where it was */
+        at = mdi->extra_info.current_sample;
+        if (_WM_BuildSongIndex(mdi) == -1) {
+            _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, "(to index the songs)", errno);
+            _WM_Unlock(&mdi->lock);
+            return (-1);
+        }
+        if (at != 0) {
+            _WM_SongSeekSample(mdi, at);
+        }
+    }
+
+    if (info != NULL) {
+        if (song >= mdi->song_count) {
+            _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(no such song)", 0);
+            _WM_Unlock(&mdi->lock);
+            return (-1);
+        }
+        info->start_sample = WM_ToOutput(mdi->ctx, mdi->song_start[song].sample);
+        if ((song + 1) < mdi->song_count) {
+            info->total_samples = WM_ToOutput(mdi->ctx, mdi->song_start[song + 1].sample) - info->start_sample;
+        } else {
+            info->total_samples = WM_ToOutput(mdi->ctx, mdi->extra_info.approx_total_samples) - info->start_sample;
+        }
+    }
+
+    count = (int) mdi->song_count;
+    _WM_Unlock(&mdi->lock);
+    return (count);
+}
+
+WM_SYMBOL int WildMidi_GetOutput(midi * handle, int8_t *buffer, uint32_t size) {
+    int frames;
+
+    if (__builtin_expect((!WM_Initialized), 0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
+        return (-1);
+    }
+    if (__builtin_expect((handle == NULL), 0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL handle)", 0);
+        return (-1);
+    }
+    if (__builtin_expect((buffer == NULL), 0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL buffer pointer)", 0);
+        return (-1);
+    }
+    if (__builtin_expect((size == 0), 0)) {
+        return (0);
+    }
+    if (__builtin_expect((!!(size % 4)), 0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(size not a multiple of 4)", 0);
+        return (-1);
+    }
+
+    frames = WM_Render((struct _mdi *) handle, (size >> 2), buffer, WM_FMT_S16);
+    if (frames == -1) {
+        return (-1);
+    }
+    /* what is left once the song has ended stays silent */
+    memset(buffer + (frames * 4), 0, (size - (frames * 4)));
+    return (frames * 4);
+}
+
+WM_SYMBOL int WildMidi_GetOutputFloat(midi * handle, float *buffer, uint32_t count) {
+    int frames;
+
+    if (__builtin_expect((!WM_Initialized), 0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
+        return (-1);
+    }
+    if (__builtin_expect((handle == NULL), 0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL handle)", 0);
+        return (-1);
+    }
+    if (__builtin_expect((buffer == NULL), 0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL buffer pointer)", 0);
+        return (-1);
+    }
+    if (__builtin_expect((count == 0), 0)) {
+        return (0);
+    }
+    if (__builtin_expect((!!(count % 2)), 0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(count not a multiple of 2)", 0);
+        return (-1);
+    }
+
+    frames = WM_Render((struct _mdi *) handle, (count >> 1), buffer, WM_FMT_FLOAT);
+    if (frames == -1) {
+        return (-1);
+    }
+    return (frames * 2);
+}
+
+WM_SYMBOL int WildMidi_GetOutputS32(midi * handle, int32_t *buffer, uint32_t count) {
+    int frames;
+
+    if (__builtin_expect((!WM_Initialized), 0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
+        return (-1);
+    }
+    if (__builtin_expect((handle == NULL), 0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL handle)", 0);
+        return (-1);
+    }
+    if (__builtin_expect((buffer == NULL), 0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL buffer pointer)", 0);
+        return (-1);
+    }
+    if (__builtin_expect((count == 0), 0)) {
+        return (0);
+    }
+    if (__builtin_expect((!!(count % 2)), 0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(count not a multiple of 2)", 0);
+        return (-1);
+    }
+
+    frames = WM_Render((struct _mdi *) handle, (count >> 1), buffer, WM_FMT_S32);
+    if (frames == -1) {
+        return (-1);
+    }
+    return (frames * 2);
+}
+
+WM_SYMBOL int WildMidi_Render(midi * handle, uint32_t frames, void *out, uint16_t format) {
+    if (__builtin_expect((!WM_Initialized), 0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
+        return (-1);
+    }
+    if (__builtin_expect((handle == NULL), 0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL handle)", 0);
+        return (-1);
+    }
+    if (__builtin_expect((out == NULL), 0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL buffer pointer)", 0);
+        return (-1);
+    }
+    if (__builtin_expect((!WM_FMT_VALID(format)), 0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(invalid format)", 0);
+        return (-1);
+    }
+    if (__builtin_expect((frames == 0), 0)) {
+        return (0);
+    }
+    if (__builtin_expect((frames > 0x3FFFFFFF), 0)) {
+        /* the mix buffer holds frames * 2 samples */
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(too many frames)", 0);
+        return (-1);
+    }
+
+    return (WM_Render((struct _mdi *) handle, frames, out, format));
+}
+
+WM_SYMBOL int WildMidi_RenderStems(midi * handle, uint32_t frames, void *out, void **stems, uint16_t format) {
+    if (__builtin_expect((!WM_Initialized), 0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
+        return (-1);
+    }
+    if (__builtin_expect((handle == NULL), 0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL handle)", 0);
+        return (-1);
+    }
+    if (__builtin_expect((out == NULL), 0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL buffer pointer)", 0);
+        return (-1);
+    }
+    if (__builtin_expect((stems == NULL), 0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL stems)", 0);
+        return (-1);
+    }
+    if (__builtin_expect((!WM_FMT_VALID(format)), 0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(invalid format)", 0);
+        return (-1);
+    }
+    if (__builtin_expect((frames == 0), 0)) {
+        return (0);
+    }
+    if (__builtin_expect((frames > 0x01FFFFFF), 0)) {
+        /* the channel buffers hold frames * 32 samples */
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(too many frames)", 0);
+        return (-1);
+    }
+
+    return (WM_RenderStems((struct _mdi *) handle, frames, out, stems, format));
+}
+
+WM_SYMBOL wm_bus * WildMidi_CreateBus(uint16_t options) {
+    struct _bus *bus;
+
+    if (options & ~WM_MO_REVERB) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(invalid option)", 0);
+        return (NULL);
+    }
+    if ((bus = (struct _bus *) calloc(1, sizeof(struct _bus))) == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
+        return (NULL);
+    }
+    bus->options = options;
+    return ((wm_bus *) bus);
+}
+
+WM_SYMBOL int WildMidi_FreeBus(wm_bus *bus) {
+    struct _bus *b = (struct _bus *) bus;
+
+    if (bus == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL bus)", 0);
+        return (-1);
+    }
+
+    /* the handles still on it carry on by themselves */
+    _WM_Lock(&b->lock);
+    while (b->member_count) {
+        WM_BusDrop(b, b->member[0].mdi);
+    }
+    _WM_Unlock(&b->lock);
+
+    if (b->reverb != NULL) {
+        _WM_free_reverb(b->reverb);
+    }
+    free(b->reverb_room);
+    free(b->mix_buffer);
+    free(b->member);
+    free(b);
+    return (0);
+}
+
+WM_SYMBOL int WildMidi_BusAdd(wm_bus *bus, midi *handle, uint16_t gain) {
+    struct _bus *b = (struct _bus *) bus;
+    struct _mdi *mdi = (struct _mdi *) handle;
+    struct _patch_set *patches;
+    struct _bus_member *member;
+    uint32_t size;
+    uint32_t i;
+
+    if (!WM_Initialized) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
+        return (-1);
+    }
+    if (bus == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL bus)", 0);
+        return (-1);
+    }
+    if (handle == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL handle)", 0);
+        return (-1);
+    }
+
+    _WM_Lock(&b->lock);
+    if (mdi->bus == b) {
+        /* already on it, only the gain changes */
+        for (i = 0; i < b->member_count; i++) {
+            if (b->member[i].mdi == mdi)
+                b->member[i].gain = gain;
+        }
+        _WM_Unlock(&b->lock);
+        return (0);
+    }
+    if (mdi->bus != NULL) {
+        _WM_Unlock(&b->lock);
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(handle is on another bus)", 0);
+        return (-1);
+    }
+    patches = mdi->patch_set;
+    if ((b->rate != 0) && (b->rate != mdi->ctx->output_rate)) {
+        _WM_Unlock(&b->lock);
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(handle rate differs from the bus)", 0);
+        return (-1);
+    }
+    if (b->member_count >= b->member_size) {
+        size = (b->member_size) ? (b->member_size * 2) : 8;
+        member = (struct _bus_member *) realloc(b->member, (size * sizeof(struct _bus_member)));
+        if (member == NULL) {
+            _WM_Unlock(&b->lock);
+            _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, errno);
+            return (-1);
+        }
+        b->member = member;
+        b->member_size = size;
+    }
+
+    if (b->rate == 0) {
+        b->rate = mdi->ctx->output_rate;
+        if (b->options & WM_MO_REVERB) {
+            /* the room of the first handle's config, without the memory
+               for it the bus plays on dry */
+            b->reverb_room = _WM_init_reverb_room(b->rate,
+                    patches->reverb_room_width, patches->reverb_room_length,
+                    patches->reverb_listen_posx, patches->reverb_listen_posy);
+            if (b->reverb_room != NULL)
+                b->reverb = _WM_init_reverb(b->reverb_room);
+        }
+    }
+
+    b->member[b->member_count].mdi = mdi;
+    b->member[b->member_count].gain = gain;
+    b->member_count++;
+    mdi->bus = b;
+    _WM_Unlock(&b->lock);
+    return (0);
+}
+
+WM_SYMBOL int WildMidi_BusRemove(wm_bus *bus, midi *handle) {
+    struct _bus *b = (struct _bus *) bus;
+    struct _mdi *mdi = (struct _mdi *) handle;
+
+    if (bus == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL bus)", 0);
+        return (-1);
+    }
+    if (handle == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL handle)", 0);
+        return (-1);
+    }
+
+    _WM_Lock(&b->lock);
+    if (mdi->bus != b) {
+        _WM_Unlock(&b->lock);
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(handle is not on the bus)", 0);
+        return (-1);
+    }
+    WM_BusDrop(b, mdi);
+    _WM_Unlock(&b->lock);
+    return (0);
+}
+
+WM_SYMBOL int WildMidi_BusRender(wm_bus *bus, uint32_t frames, void *out, uint16_t format) {
+    if (__builtin_expect((!WM_Initialized), 0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
+        return (-1);
+    }
+    if (__builtin_expect((bus == NULL), 0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL bus)", 0);
+        return (-1);
+    }
+    if (__builtin_expect((out == NULL), 0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL buffer pointer)", 0);
+        return (-1);
+    }
+    if (__builtin_expect((!WM_FMT_VALID(format)), 0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(invalid format)", 0);
+        return (-1);
+    }
+    if (__builtin_expect((frames == 0), 0)) {
+        return (0);
+    }
+    if (__builtin_expect((frames > 0x3FFFFFFF), 0)) {
+        /* the mix buffer holds frames * 2 samples */
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(too many frames)", 0);
+        return (-1);
+    }
+
+    return (WM_BusRender((struct _bus *) bus, frames, out, format));
+}
+
+WM_SYMBOL int WildMidi_GetMidiOutput(midi * handle, int8_t **buffer, uint32_t *size) {
+    if (__builtin_expect((!WM_Initialized), 0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
+        return (-1);
+    }
+    if (__builtin_expect((handle == NULL), 0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL handle)", 0);
+        return (-1);
+    }
+    if (__builtin_expect((buffer == NULL), 0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL buffer pointer)", 0);
+        return (-1);
+    }
+    if (((struct _mdi *)handle)->stream) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(not available for streamed midi)", 0);
+        return (-1);
+    }
+    return _WM_Event2Midi((struct _mdi *)handle, (uint8_t **)buffer, size);
+}
+
+WM_SYMBOL int WildMidi_WriteMidi(midi * handle,
+                                 int (*write_fn)(void *ctx, const uint8_t *data, uint32_t size),
+                                 void *ctx) {
+    if (__builtin_expect((!WM_Initialized), 0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
+        return (-1);
+    }
+    if (__builtin_expect((handle == NULL), 0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL handle)", 0);
+        return (-1);
+    }
+    if (__builtin_expect((write_fn == NULL), 0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL write function)", 0);
+        return (-1);
+    }
+    if (((struct _mdi *)handle)->stream) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(not available for streamed midi)", 0);
+        return (-1);
+    }
+    return _WM_WriteMidi((struct _mdi *)handle, write_fn, ctx);
+}
+
+
+WM_SYMBOL int WildMidi_SetOption(midi * handle, uint16_t options, uint16_t setting) {
+    struct _mdi *mdi;
+
+    if (!WM_Initialized) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
+        return (-1);
+    }
+    if (handle == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL handle)", 0);
+        return (-1);
+    }
+
+    mdi = (struct _mdi *) handle;
+    _WM_Lock(&mdi->lock);
+    if ((!(options & 0x800F)) || (options & 0x7FF0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(invalid option)", 0);
+        _WM_Unlock(&mdi->lock);
+        return (-1);
+    }
+    if (setting & 0x7FF0) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(invalid setting)", 0);
+        _WM_Unlock(&mdi->lock);
+        return (-1);
     }
 
-    if (ret) {
-        if (add_handle(ret) != 0) {
-            WildMidi_Close(ret);
-            ret = NULL;
-        }
+    mdi->extra_info.mixer_options = ((mdi->extra_info.mixer_options & (0x80FF ^ options))
+                                    | (options & setting));
+    _WM_PickMixer(mdi);
+
+    if (options & WM_MO_LOG_VOLUME) {
+            _WM_AdjustChannelVolumes(mdi, 16);  /* Settings greater than 15
+                                                   adjusts all channels */
+    } else if (options & WM_MO_REVERB) {
+        /* starts off empty again when switched back on */
+        _WM_free_reverb(mdi->reverb);
+        mdi->reverb = NULL;
     }
 
-    return (ret);
+    _WM_Unlock(&mdi->lock);
+    return (0);
 }
 
-WM_SYMBOL int WildMidi_FastSeek(midi * handle, unsigned long int *sample_pos) {
+WM_SYMBOL int WildMidi_SetRenderThreads(midi * handle, uint8_t threads) {
     struct _mdi *mdi;
-    struct _event *event;
-    struct _note *note_data;
+    struct _WM_Pool *pool = NULL;
+    struct _WM_Pool *old_pool;
 
     if (!WM_Initialized) {
         _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
@@ -1760,90 +3890,55 @@ WM_SYMBOL int WildMidi_FastSeek(midi * handle, unsigned long int *sample_pos) {
         _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL handle)", 0);
         return (-1);
     }
-    if (sample_pos == NULL) {
-        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL seek position pointer)", 0);
+    if (threads > WM_MAX_THREADS) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(too many threads)", 0);
         return (-1);
     }
 
+    if (threads > 1) {
+#ifndef WM_HAVE_THREADS
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(built without thread support)", 0);
+        return (-1);
+#else
+        pool = _WM_PoolCreate(threads);
+        if (pool == NULL) {
+            _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, "(to start render threads)", 0);
+            return (-1);
+        }
+#endif
+    }
+
     mdi = (struct _mdi *) handle;
     _WM_Lock(&mdi->lock);
-    event = mdi->current_event;
-
-    /* make sure we havent asked for a positions beyond the end of the song. */
-    if (*sample_pos > mdi->extra_info.approx_total_samples) {
-        /* if so set the position to the end of the song */
-        *sample_pos = mdi->extra_info.approx_total_samples;
-    }
+    old_pool = mdi->pool;
+    mdi->pool = pool;
+    _WM_Unlock(&mdi->lock);
 
-    /* was end of song requested and are we are there? */
-    if (*sample_pos == mdi->extra_info.approx_total_samples) {
-        /* yes */
-        _WM_Unlock(&mdi->lock);
-        return (0);
-    }
+    _WM_PoolFree(old_pool);
+    return (0);
+}
 
-    /* did we want to fast forward? */
-    if (mdi->extra_info.current_sample > *sample_pos) {
-        /* no - reset some stuff */
-        event = mdi->events;
-        _WM_ResetToStart((struct _mdi *) handle);
-        mdi->extra_info.current_sample = 0;
-        mdi->samples_to_mix = 0;
-    }
+WM_SYMBOL int WildMidi_SetPolyphony(midi * handle, uint16_t voices) {
+    struct _mdi *mdi = (struct _mdi *) handle;
 
-    if ((mdi->extra_info.current_sample + mdi->samples_to_mix) > *sample_pos) {
-        mdi->samples_to_mix = (mdi->extra_info.current_sample + mdi->samples_to_mix) - *sample_pos;
-        mdi->extra_info.current_sample = *sample_pos;
-    } else {
-        mdi->extra_info.current_sample += mdi->samples_to_mix;
-        mdi->samples_to_mix = 0;
-        while ((!mdi->samples_to_mix) && (event->do_event)) {
-            event->do_event(mdi, &event->event_data);
-            mdi->samples_to_mix = event->samples_to_next;
-                
-            if ((mdi->extra_info.current_sample + mdi->samples_to_mix) > *sample_pos) {
-                mdi->samples_to_mix = (mdi->extra_info.current_sample + mdi->samples_to_mix) - *sample_pos;
-                mdi->extra_info.current_sample = *sample_pos;
-            } else {
-                mdi->extra_info.current_sample += mdi->samples_to_mix;
-                mdi->samples_to_mix = 0;
-            }
-            event++;
-        }
-        mdi->current_event = event;
+    if (!WM_Initialized) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
+        return (-1);
     }
-
-    /*
-     * Clear notes as this is a fast seek so we only care
-     * about new notes.
-     *
-     * NOTE: This function is for performance only.
-     * Might need a WildMidi_SlowSeek if we need better accuracy.
-     */
-    note_data = mdi->note;
-    if (note_data) {
-        do {
-            note_data->active = 0;
-            if (note_data->replay) {
-                note_data->replay = NULL;
-            }
-            note_data = note_data->next;
-        } while (note_data);
+    if (handle == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL handle)", 0);
+        return (-1);
     }
-    mdi->note = NULL;
-
-    /* clear the reverb buffers since we not gonna be using them here */
-    _WM_reset_reverb(mdi->reverb);
 
+    _WM_Lock(&mdi->lock);
+    mdi->max_voices = voices;
     _WM_Unlock(&mdi->lock);
     return (0);
 }
 
-WM_SYMBOL int WildMidi_SongSeek (midi * handle, int8_t nextsong) {
-    struct _mdi *mdi;
-    struct _event *event;
-    struct _event *event_new;
-    struct _note *note_data;
+WM_SYMBOL long WildMidi_GetStolenVoices(midi * handle) {
+    struct _mdi *mdi = (struct _mdi *) handle;
+    long stolen;
 
     if (!WM_Initialized) {
         _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
@@ -1853,148 +3948,165 @@ WM_SYMBOL int WildMidi_SongSeek (midi * handle, int8_t nextsong) {
         _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL handle)", 0);
         return (-1);
     }
-    mdi = (struct _mdi *) handle;
+
     _WM_Lock(&mdi->lock);
+    stolen = (long) mdi->stolen_voices;
+    _WM_Unlock(&mdi->lock);
+    return (stolen);
+}
 
-    if ((!mdi->is_type2) && (nextsong != 0)) {
-        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(Illegal use. Only usable with files detected to be type 2 compatible.", 0);
-        _WM_Unlock(&mdi->lock);
+WM_SYMBOL int WildMidi_GetStats(midi * handle, struct _WM_Stats *stats) {
+    struct _mdi *mdi = (struct _mdi *) handle;
+    struct _mdi *events;
+    struct _song_block *block;
+    uint32_t i;
+
+    if (!WM_Initialized) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
         return (-1);
     }
-    if ((nextsong > 1) || (nextsong < -1)) {
-        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(Invalid nextsong: -1 is previous song, 0 is start of current song, 1 is next song)", 0);
-        _WM_Unlock(&mdi->lock);
+    if (handle == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL handle)", 0);
         return (-1);
     }
-
-    event = mdi->current_event;
-
-    if (nextsong == -1) {
-        /* goto start of previous song */
-        /*
-         * So with this one we have to go back 2 eof's
-         * then forward 1 event to get to the start of
-         * the previous song.
-         * NOTE: We will automatically stop at the start 
-         * of the data.
-         */
-        uint8_t eof_cnt = 1;
-        while (event != mdi->events) {
-            if (event[-1].evtype == ev_meta_endoftrack) {
-                if (eof_cnt == 0) {
-                    break;
-                }
-                eof_cnt = 0;
-            }
-            event--;
-        }
-        event_new = event;
-        event = mdi->events;
-        _WM_ResetToStart((struct _mdi *) handle);
-
-    } else if (nextsong == 1) {
-        /* goto start of next song */
-        while (event->evtype != ev_null) {
-            if (event->evtype == ev_meta_endoftrack) {
-                event++;
-                if (event->evtype == ev_null) {
-                    event--;
-                    goto START_THIS_SONG;
-                } else {
-                    break;
-                }
-            }
-            event++;
-        }
-        event_new = event;
-        event = mdi->current_event;
-
-    } else {
-    START_THIS_SONG:
-        /* goto start of this song */
-        /* first find the offset */
-        while (event != mdi->events) {
-            if (event[-1].evtype == ev_meta_endoftrack) {
-                break;
-            }
-            event--;
-        }
-        event_new = event;
-        event = mdi->events;
-        _WM_ResetToStart((struct _mdi *) handle);
+    if (stats == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL stats)", 0);
+        return (-1);
     }
 
-    while (event != event_new) {
-        event->do_event(mdi, &event->event_data);
-        mdi->extra_info.current_sample += event->samples_to_next;
-        event++;
+    _WM_Lock(&mdi->lock);
+    stats->voices = mdi->voice_count;
+    stats->peak_voices = mdi->peak_voices;
+    stats->stolen_voices = mdi->stolen_voices;
+    stats->worst_render_us = (uint32_t) (mdi->worst_render_ns / 1000);
+    stats->events = mdi->events_done;
+    stats->clipped = mdi->clipped;
+    stats->render_us = mdi->render_ns / 1000;
+
+    /* the events of an instance are those of the song it shares, which
+       stay as they are while any handle plays them */
+    events = (mdi->song != NULL) ? mdi->song->mdi : mdi;
+    stats->event_bytes = ((uint64_t) events->events_size * sizeof(struct _event))
+        + ((uint64_t) events->event_ext_size * sizeof(union _event_value));
+    for (block = events->arena; block != NULL; block = block->next) {
+        stats->event_bytes += block->size;
     }
+    _WM_Unlock(&mdi->lock);
 
-    mdi->current_event = event;
-
-    note_data = mdi->note;
-    if (note_data) {
-        do {
-            note_data->active = 0;
-            if (note_data->replay) {
-                note_data->replay = NULL;
-            }
-            note_data = note_data->next;
-        } while (note_data);
+    /* the patches only change as a handle opens and closes, their samples
+       under the lock of the patch set */
+    stats->sample_bytes = 0;
+    _WM_Lock(&mdi->patch_set->lock);
+    for (i = 0; i < mdi->patch_count; i++) {
+        stats->sample_bytes += mdi->patches[i]->sample_bytes;
     }
-    mdi->note = NULL;
+    _WM_Unlock(&mdi->patch_set->lock);
+    return (0);
+}
 
-    _WM_Unlock(&mdi->lock);
+static int WM_SetTraceCtx(struct _context *ctx, uint32_t ring_size,
+        void (*callback)(void *user, const struct _WM_TraceEvent *event), void *user) {
+#ifndef WILDMIDI_TRACE
+    WMIDI_UNUSED(ctx);
+    WMIDI_UNUSED(ring_size);
+    WMIDI_UNUSED(callback);
+    WMIDI_UNUSED(user);
+    _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(built without tracing)", 0);
+    return (-1);
+#else
+    _WM_Lock(&ctx->lock);
+    ctx->trace_size = ring_size;
+    ctx->trace_callback = callback;
+    ctx->trace_user = user;
+    _WM_Unlock(&ctx->lock);
     return (0);
+#endif
 }
 
-WM_SYMBOL int WildMidi_GetOutput(midi * handle, int8_t *buffer, uint32_t size) {
-    if (__builtin_expect((!WM_Initialized), 0)) {
+WM_SYMBOL int WildMidi_SetTrace(midi * handle, uint32_t ring_size,
+        void (*callback)(void *user, const struct _WM_TraceEvent *event), void *user) {
+    struct _mdi *mdi = (struct _mdi *) handle;
+#ifdef WILDMIDI_TRACE
+    struct _trace *trace = NULL;
+    struct _trace *old_trace;
+#endif
+
+    if (!WM_Initialized) {
         _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
         return (-1);
     }
-    if (__builtin_expect((handle == NULL), 0)) {
-        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL handle)", 0);
-        return (-1);
-    }
-    if (__builtin_expect((buffer == NULL), 0)) {
-        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL buffer pointer)", 0);
-        return (-1);
+    if (handle == NULL) {
+        /* for the handles opened from now on */
+        return (WM_SetTraceCtx(WM_Context, ring_size, callback, user));
     }
-    if (__builtin_expect((size == 0), 0)) {
-        return (0);
+
+#ifndef WILDMIDI_TRACE
+    /* which only says it was built without */
+    WMIDI_UNUSED(mdi);
+    return (WM_SetTraceCtx(WM_Context, ring_size, callback, user));
+#else
+    if ((ring_size != 0) || (callback != NULL)) {
+        trace = _WM_NewTrace(ring_size, callback, user);
+        if (trace == NULL) {
+            return (-1);
+        }
     }
-    if (__builtin_expect((!!(size % 4)), 0)) {
-        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(size not a multiple of 4)", 0);
+
+    _WM_Lock(&mdi->lock);
+    old_trace = mdi->trace;
+    mdi->trace = trace;
+    _WM_Unlock(&mdi->lock);
+
+    free(old_trace);
+    return (0);
+#endif
+}
+
+WM_SYMBOL int WildMidi_SetTraceCtx(wm_context *context, uint32_t ring_size,
+        void (*callback)(void *user, const struct _WM_TraceEvent *event), void *user) {
+    if (context == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL context)", 0);
         return (-1);
     }
 
-    if (((struct _mdi *) handle)->extra_info.mixer_options & WM_MO_ENHANCED_RESAMPLING) {
-        if (!gauss_table) init_gauss();
-        return (WM_GetOutput_Gauss(handle, buffer, size));
-    }
-    return (WM_GetOutput_Linear(handle, buffer, size));
+    return (WM_SetTraceCtx((struct _context *) context, ring_size, callback, user));
 }
 
-WM_SYMBOL int WildMidi_GetMidiOutput(midi * handle, int8_t **buffer, uint32_t *size) {
-    if (__builtin_expect((!WM_Initialized), 0)) {
+/* takes no lock, only WildMidi_SetTrace() must not change the trace meanwhile */
+WM_SYMBOL int WildMidi_ReadTrace(midi * handle, struct _WM_TraceEvent *events, uint32_t count) {
+    struct _mdi *mdi = (struct _mdi *) handle;
+
+    if (!WM_Initialized) {
         _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
         return (-1);
     }
-    if (__builtin_expect((handle == NULL), 0)) {
+    if (handle == NULL) {
         _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL handle)", 0);
         return (-1);
     }
-    if (__builtin_expect((buffer == NULL), 0)) {
-        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL buffer pointer)", 0);
+    if ((events == NULL) && (count != 0)) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL events)", 0);
         return (-1);
     }
-    return _WM_Event2Midi((struct _mdi *)handle, (uint8_t **)buffer, size);
-}
 
+#ifndef WILDMIDI_TRACE
+    WMIDI_UNUSED(mdi);
+    return (0);
+#else
+    if ((mdi->trace == NULL) || (mdi->trace->ring == NULL)) {
+        return (0);
+    }
+    if (count > 0x7fffffff) {
+        count = 0x7fffffff;
+    }
+    return ((int) _WM_ReadTrace(mdi->trace, events, count));
+#endif
+}
 
-WM_SYMBOL int WildMidi_SetOption(midi * handle, uint16_t options, uint16_t setting) {
-    struct _mdi *mdi;
+WM_SYMBOL int WildMidi_Live(midi * handle, uint32_t midi_event, uint32_t frame) {
+    struct _mdi *mdi = (struct _mdi *) handle;
+    struct _live_queue *live;
+    uint32_t head;
 
     if (!WM_Initialized) {
         _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
@@ -2005,30 +4117,27 @@ WM_SYMBOL int WildMidi_SetOption(midi * handle, uint16_t options, uint16_t setti
         return (-1);
     }
 
-    mdi = (struct _mdi *) handle;
-    _WM_Lock(&mdi->lock);
-    if ((!(options & 0x800F)) || (options & 0x7FF0)) {
-        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(invalid option)", 0);
-        _WM_Unlock(&mdi->lock);
-        return (-1);
-    }
-    if (setting & 0x7FF0) {
-        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(invalid setting)", 0);
+    /* there is only the one producer, so only we ever set mdi->live,
+       the lock is for the song arena it comes out of */
+    live = mdi->live;
+    if (live == NULL) {
+        _WM_Lock(&mdi->lock);
+        live = (struct _live_queue *) _WM_SongAlloc(mdi, sizeof(struct _live_queue));
+        mdi->live = live;
         _WM_Unlock(&mdi->lock);
-        return (-1);
+        if (live == NULL) {
+            return (-1);
+        }
     }
 
-    mdi->extra_info.mixer_options = ((mdi->extra_info.mixer_options & (0x80FF ^ options))
-                                    | (options & setting));
-
-    if (options & WM_MO_LOG_VOLUME) {
-            _WM_AdjustChannelVolumes(mdi, 16);  /* Settings greater than 15
-                                                   adjusts all channels */
-    } else if (options & WM_MO_REVERB) {
-        _WM_reset_reverb(mdi->reverb);
+    head = live->head;
+    if ((head - live_load(&live->tail)) == WM_LIVE_EVENTS) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(live queue full)", 0);
+        return (-1);
     }
-
-    _WM_Unlock(&mdi->lock);
+    live->event[head & (WM_LIVE_EVENTS - 1)].frame = WM_ToMix(mdi->ctx, frame);
+    live->event[head & (WM_LIVE_EVENTS - 1)].message = midi_event;
+    live_store(&live->head, head + 1);
     return (0);
 }
 
@@ -2071,10 +4180,10 @@ WildMidi_GetInfo(midi * handle) {
         }
         mdi->tmp_info->copyright = NULL;
     }
-    mdi->tmp_info->current_sample = mdi->extra_info.current_sample;
-    mdi->tmp_info->approx_total_samples = mdi->extra_info.approx_total_samples;
+    mdi->tmp_info->current_sample = WM_ToOutput(mdi->ctx, mdi->extra_info.current_sample);
+    mdi->tmp_info->approx_total_samples = WM_ToOutput(mdi->ctx, mdi->extra_info.approx_total_samples);
     mdi->tmp_info->mixer_options = mdi->extra_info.mixer_options;
-    mdi->tmp_info->total_midi_time = (mdi->tmp_info->approx_total_samples * 1000) / _WM_SampleRate;
+    mdi->tmp_info->total_midi_time = (mdi->tmp_info->approx_total_samples * 1000) / mdi->ctx->output_rate;
     if (mdi->extra_info.copyright) {
         free(mdi->tmp_info->copyright);
         mdi->tmp_info->copyright = (char *) malloc(strlen(mdi->extra_info.copyright) + 1);
@@ -2095,35 +4204,23 @@ WildMidi_GetInfo(midi * handle) {
 }
 
 WM_SYMBOL int WildMidi_Shutdown(void) {
-    if (!WM_Initialized) {
+    if (!WM_Context) {
         _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
         return (-1);
     }
-    while (first_handle) {
-        /* closes open handle and rotates the handles list. */
-        WildMidi_Close((struct _mdi *) first_handle->handle);
-    }
-    WM_FreePatches();
-    free_gauss();
+    WM_FreeContext(WM_Context);
+    WM_Context = NULL;
 
     /* reset the globals */
     _cvt_reset_options ();
-    _WM_MasterVolume = 948;
-    _WM_MixerOptions = 0;
-    _WM_fix_release = 0;
-    _WM_auto_amp = 0;
-    _WM_auto_amp_with_amp = 0;
-    _WM_reverb_room_width = 16.875f;
-    _WM_reverb_room_length = 22.5f;
-    _WM_reverb_listen_posx = 8.4375f;
-    _WM_reverb_listen_posy = 16.875f;
-
-    WM_Initialized = 0;
 
     if (_WM_Global_ErrorS != NULL) free(_WM_Global_ErrorS);
+    _WM_Global_ErrorS = NULL;
 
     _WM_BufferFile = _WM_BufferFileImpl;
     _WM_FreeBufferFile = _WM_FreeBufferFileImpl;
+    _WM_MapFile = _WM_MapFileImpl;
+    _WM_UnmapFile = _WM_UnmapFileImpl;
 
     return (0);
 }
@@ -2164,6 +4261,104 @@ WM_SYMBOL char * WildMidi_GetLyric (midi * handle) {
     return (lyric);
 }
 
+/*
+ * Reports the lyrics, text, markers, cue points, tempo and time signature
+ * changes of the whole song with the sample each is played at, for a
+ * karaoke display to lay out ahead of playing. Only the timing of the
+ * events is looked at, nothing is played. The entries are gathered under
+ * the lock and handed to callback after it, so callback may use the handle.
+ */
+WM_SYMBOL int WildMidi_GetTimeline (midi * handle, uint16_t types,
+        void (*callback)(void *user, const struct _WM_TimelineEvent *event), void *user) {
+    struct _mdi *mdi = (struct _mdi *) handle;
+    struct _event *event;
+    struct _event_data data;
+    struct _WM_TimelineEvent *entry;
+    struct _WM_TimelineEvent *grown;
+    uint16_t type;
+    uint32_t sample = 0;
+    uint32_t size = 0;
+    uint32_t count = 0;
+    uint32_t i;
+
+    if (!WM_Initialized) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_INIT, NULL, 0);
+        return (-1);
+    }
+    if (handle == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL handle)", 0);
+        return (-1);
+    }
+    if (callback == NULL) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(NULL callback)", 0);
+        return (-1);
+    }
+    if (mdi->stream) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_INVALID_ARG, "(not available for streamed midi)", 0);
+        return (-1);
+    }
+
+    entry = NULL;
+    _WM_Lock(&mdi->lock);
+    for (event = mdi->events; event->evtype != ev_null; event++) {
+        switch (event->evtype) {
+        case ev_meta_lyric:
+            type = WM_TIMELINE_LYRIC;
+            break;
+        case ev_meta_text:
+            type = WM_TIMELINE_TEXT;
+            break;
+        case ev_meta_marker:
+            type = WM_TIMELINE_MARKER;
+            break;
+        case ev_meta_cuepoint:
+            type = WM_TIMELINE_CUEPOINT;
+            break;
+        case ev_meta_tempo:
+            type = WM_TIMELINE_TEMPO;
+            break;
+        case ev_meta_timesignature:
+            type = WM_TIMELINE_TIMESIG;
+            break;
+        default:
+            type = 0;
+            break;
+        }
+        if (type & types) {
+            if (count == size) {
+                size += 64;
+                grown = (struct _WM_TimelineEvent *) realloc(entry, (size * sizeof(struct _WM_TimelineEvent)));
+                if (grown == NULL) {
+                    _WM_Unlock(&mdi->lock);
+                    free(entry);
+                    _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, "(to list the timeline)", errno);
+                    return (-1);
+                }
+                entry = grown;
+            }
+            _WM_EventData(mdi, event, &data);
+            entry[count].type = type;
+            if ((type == WM_TIMELINE_TEMPO) || (type == WM_TIMELINE_TIMESIG)) {
+                entry[count].value = data.data.value;
+                entry[count].text = NULL;
+            } else {
+                entry[count].value = 0;
+                entry[count].text = data.data.string;
+            }
+            entry[count].sample = WM_ToOutput(mdi->ctx, sample);
+            count++;
+        }
+        sample += event->samples_to_next;
+    }
+    _WM_Unlock(&mdi->lock);
+
+    for (i = 0; i < count; i++) {
+        callback(user, &entry[i]);
+    }
+    free(entry);
+    return ((int) count);
+}
+
 /*
  * Return Last Error Message
  */
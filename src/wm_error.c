@@ -27,6 +27,7 @@
 #include <string.h>
 #include <stdarg.h>
 #include <stdlib.h>
+#include "lock.h"
 #include "wm_error.h"
 
 void _WM_DEBUG_MSG(const char * wmfmt, ...) {
@@ -67,6 +68,10 @@ static const char *errors[WM_ERR_MAX+1] = {
 char * _WM_Global_ErrorS = NULL;
 int _WM_Global_ErrorI = 0;
 
+/* patches are decoded and files converted on several threads, which may
+ * all fail at once */
+static int error_lock = 0;
+
 void _WM_GLOBAL_ERROR(const char *func, int lne, int wmerno, const char *wmfor, int error) {
 
     char *errorstring;
@@ -74,10 +79,6 @@ void _WM_GLOBAL_ERROR(const char *func, int lne, int wmerno, const char *wmfor,
     if (wmerno < 0 || wmerno >= WM_ERR_MAX)
          wmerno = WM_ERR_MAX; /* set to invalid error code. */
 
-    _WM_Global_ErrorI = wmerno;
-
-    if (_WM_Global_ErrorS != NULL) free(_WM_Global_ErrorS);
-
     errorstring = (char *) malloc(MAX_ERROR_LEN+1);
 
     if (error == 0) {
@@ -99,7 +100,12 @@ void _WM_GLOBAL_ERROR(const char *func, int lne, int wmerno, const char *wmfor,
     }
 
     errorstring[MAX_ERROR_LEN] = 0;
+
+    _WM_Lock(&error_lock);
+    _WM_Global_ErrorI = wmerno;
+    if (_WM_Global_ErrorS != NULL) free(_WM_Global_ErrorS);
     _WM_Global_ErrorS = errorstring;
+    _WM_Unlock(&error_lock);
 }
 
 void _WM_ERROR_NEW(const char * wmfmt, ...) {
@@ -110,6 +116,10 @@ void _WM_ERROR_NEW(const char * wmfmt, ...) {
     vsprintf(errorstring, wmfmt, args);
     va_end(args);
     errorstring[MAX_ERROR_LEN] = 0;
-    _WM_Global_ErrorS = errorstring;
+
+    _WM_Lock(&error_lock);
     _WM_Global_ErrorI = WM_ERR_MAX;/* well, it's a custom error message */
+    if (_WM_Global_ErrorS != NULL) free(_WM_Global_ErrorS);
+    _WM_Global_ErrorS = errorstring;
+    _WM_Unlock(&error_lock);
 }
@@ -0,0 +1,444 @@
+/*
+ * wm_thread.c -- Midi Wavetable Processing library
+ *
+ * Copyright (C) WildMIDI Developers 2001-2016
+ *
+ * This file is part of WildMIDI.
+ *
+ * WildMIDI is free software: you can redistribute and/or modify the player
+ * under the terms of the GNU General Public License and you can redistribute
+ * and/or modify the library under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either version 3 of
+ * the licenses, or(at your option) any later version.
+ *
+ * WildMIDI is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License and
+ * the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License and the
+ * GNU Lesser General Public License along with WildMIDI.  If not,  see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#if defined(HAVE_WIN32_THREADS)
+/* condition variables need vista or newer */
+#if !defined(_WIN32_WINNT) || (_WIN32_WINNT < 0x0600)
+#undef _WIN32_WINNT
+#define _WIN32_WINNT 0x0600
+#endif
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <process.h>
+#elif defined(HAVE_PTHREAD)
+#include <pthread.h>
+#include <unistd.h>
+#endif
+#if defined(_WIN32) && !defined(HAVE_WIN32_THREADS)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif !defined(_WIN32)
+#include <time.h>
+#endif
+
+#include "wm_thread.h"
+
+#ifdef WM_HAVE_THREADS
+
+#if defined(HAVE_WIN32_THREADS)
+typedef HANDLE wm_thread_t;
+typedef CRITICAL_SECTION wm_mutex_t;
+typedef CONDITION_VARIABLE wm_cond_t;
+#define wm_mutex_init(m)    (InitializeCriticalSection(m), 0)
+#define wm_mutex_destroy(m) DeleteCriticalSection(m)
+#define wm_mutex_lock(m)    EnterCriticalSection(m)
+#define wm_mutex_unlock(m)  LeaveCriticalSection(m)
+#define wm_cond_init(c)     (InitializeConditionVariable(c), 0)
+#define wm_cond_destroy(c)  ((void)0)
+#define wm_cond_wait(c,m)   SleepConditionVariableCS((c), (m), INFINITE)
+#define wm_cond_broadcast(c) WakeAllConditionVariable(c)
+#else
+typedef pthread_t wm_thread_t;
+typedef pthread_mutex_t wm_mutex_t;
+typedef pthread_cond_t wm_cond_t;
+#define wm_mutex_init(m)    pthread_mutex_init((m), NULL)
+#define wm_mutex_destroy(m) pthread_mutex_destroy(m)
+#define wm_mutex_lock(m)    pthread_mutex_lock(m)
+#define wm_mutex_unlock(m)  pthread_mutex_unlock(m)
+#define wm_cond_init(c)     pthread_cond_init((c), NULL)
+#define wm_cond_destroy(c)  pthread_cond_destroy(c)
+#define wm_cond_wait(c,m)   pthread_cond_wait((c), (m))
+#define wm_cond_broadcast(c) pthread_cond_broadcast(c)
+#endif
+
+struct _WM_Worker {
+    struct _WM_Pool *pool;
+    int number;
+    wm_thread_t thread;
+};
+
+struct _WM_Pool {
+    int threads;
+    int started;            /* worker threads actually running */
+    wm_mutex_t mutex;
+    wm_cond_t wake;         /* new job, or shutdown */
+    wm_cond_t done;         /* last worker finished the job */
+    uint32_t generation;    /* bumped for every job */
+    int busy;               /* workers still on the current job */
+    int quit;
+    _WM_PoolJob job;
+    void *data;
+    struct _WM_Worker *worker;
+};
+
+static void worker_loop(struct _WM_Worker *self) {
+    struct _WM_Pool *pool = self->pool;
+    uint32_t seen = 0;
+    _WM_PoolJob job;
+    void *data;
+
+    wm_mutex_lock(&pool->mutex);
+    for (;;) {
+        while ((pool->generation == seen) && (!pool->quit))
+            wm_cond_wait(&pool->wake, &pool->mutex);
+        if (pool->quit)
+            break;
+        seen = pool->generation;
+        job = pool->job;
+        data = pool->data;
+        wm_mutex_unlock(&pool->mutex);
+
+        job(data, self->number);
+
+        wm_mutex_lock(&pool->mutex);
+        if (--pool->busy == 0)
+            wm_cond_broadcast(&pool->done);
+    }
+    wm_mutex_unlock(&pool->mutex);
+}
+
+#if defined(HAVE_WIN32_THREADS)
+static unsigned __stdcall worker_main(void *arg) {
+    worker_loop((struct _WM_Worker *) arg);
+    return (0);
+}
+
+static int start_worker(struct _WM_Worker *worker) {
+    worker->thread = (HANDLE) _beginthreadex(NULL, 0, worker_main, worker, 0, NULL);
+    return ((worker->thread) ? 0 : -1);
+}
+
+static void join_worker(struct _WM_Worker *worker) {
+    WaitForSingleObject(worker->thread, INFINITE);
+    CloseHandle(worker->thread);
+}
+#else
+static void *worker_main(void *arg) {
+    worker_loop((struct _WM_Worker *) arg);
+    return (NULL);
+}
+
+static int start_worker(struct _WM_Worker *worker) {
+    return ((pthread_create(&worker->thread, NULL, worker_main, worker)) ? -1 : 0);
+}
+
+static void join_worker(struct _WM_Worker *worker) {
+    pthread_join(worker->thread, NULL);
+}
+#endif
+
+int _WM_CpuCount(void) {
+#if defined(HAVE_WIN32_THREADS)
+    SYSTEM_INFO si;
+    GetSystemInfo(&si);
+    return ((si.dwNumberOfProcessors > 0) ? (int) si.dwNumberOfProcessors : 1);
+#elif defined(_SC_NPROCESSORS_ONLN)
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return ((n > 0) ? (int) n : 1);
+#else
+    return (1);
+#endif
+}
+
+struct _WM_Pool *_WM_PoolCreate(int threads) {
+    struct _WM_Pool *pool;
+    int i;
+
+    if ((threads < 2) || (threads > WM_MAX_THREADS))
+        return (NULL);
+
+    pool = (struct _WM_Pool *) calloc(1, sizeof(struct _WM_Pool));
+    if (pool == NULL)
+        return (NULL);
+    pool->worker = (struct _WM_Worker *) calloc((threads - 1), sizeof(struct _WM_Worker));
+    if (pool->worker == NULL) {
+        free(pool);
+        return (NULL);
+    }
+    pool->threads = threads;
+
+    if (wm_mutex_init(&pool->mutex) != 0) {
+        free(pool->worker);
+        free(pool);
+        return (NULL);
+    }
+    if (wm_cond_init(&pool->wake) != 0) {
+        wm_mutex_destroy(&pool->mutex);
+        free(pool->worker);
+        free(pool);
+        return (NULL);
+    }
+    if (wm_cond_init(&pool->done) != 0) {
+        wm_cond_destroy(&pool->wake);
+        wm_mutex_destroy(&pool->mutex);
+        free(pool->worker);
+        free(pool);
+        return (NULL);
+    }
+
+    for (i = 0; i < (threads - 1); i++) {
+        pool->worker[i].pool = pool;
+        pool->worker[i].number = i + 1;
+        if (start_worker(&pool->worker[i]) != 0) {
+            _WM_PoolFree(pool);
+            return (NULL);
+        }
+        pool->started++;
+    }
+
+    return (pool);
+}
+
+int _WM_PoolThreads(struct _WM_Pool *pool) {
+    return ((pool) ? pool->threads : 1);
+}
+
+void _WM_PoolRun(struct _WM_Pool *pool, _WM_PoolJob job, void *data) {
+    wm_mutex_lock(&pool->mutex);
+    pool->job = job;
+    pool->data = data;
+    pool->busy = pool->threads - 1;
+    pool->generation++;
+    wm_cond_broadcast(&pool->wake);
+    wm_mutex_unlock(&pool->mutex);
+
+    job(data, 0);
+
+    wm_mutex_lock(&pool->mutex);
+    while (pool->busy)
+        wm_cond_wait(&pool->done, &pool->mutex);
+    wm_mutex_unlock(&pool->mutex);
+}
+
+void _WM_PoolFree(struct _WM_Pool *pool) {
+    int i;
+
+    if (pool == NULL)
+        return;
+
+    wm_mutex_lock(&pool->mutex);
+    pool->quit = 1;
+    wm_cond_broadcast(&pool->wake);
+    wm_mutex_unlock(&pool->mutex);
+
+    for (i = 0; i < pool->started; i++)
+        join_worker(&pool->worker[i]);
+
+    wm_cond_destroy(&pool->done);
+    wm_cond_destroy(&pool->wake);
+    wm_mutex_destroy(&pool->mutex);
+    free(pool->worker);
+    free(pool);
+}
+
+struct _WM_QueueItem {
+    _WM_QueueJob job;
+    void *data;
+    struct _WM_QueueItem *next;
+};
+
+struct _WM_Queue {
+    wm_mutex_t mutex;
+    wm_cond_t wake;         /* new job, or shutdown */
+    struct _WM_QueueItem *first;
+    struct _WM_QueueItem *last;
+    int quit;
+    wm_thread_t thread;
+};
+
+static void queue_loop(struct _WM_Queue *queue) {
+    struct _WM_QueueItem *item;
+
+    wm_mutex_lock(&queue->mutex);
+    for (;;) {
+        while ((queue->first == NULL) && (!queue->quit))
+            wm_cond_wait(&queue->wake, &queue->mutex);
+        /* the jobs already posted still run on shutdown */
+        if ((item = queue->first) == NULL)
+            break;
+        if ((queue->first = item->next) == NULL)
+            queue->last = NULL;
+        wm_mutex_unlock(&queue->mutex);
+
+        item->job(item->data);
+        free(item);
+
+        wm_mutex_lock(&queue->mutex);
+    }
+    wm_mutex_unlock(&queue->mutex);
+}
+
+#if defined(HAVE_WIN32_THREADS)
+static unsigned __stdcall queue_main(void *arg) {
+    queue_loop((struct _WM_Queue *) arg);
+    return (0);
+}
+
+static int start_queue(struct _WM_Queue *queue) {
+    queue->thread = (HANDLE) _beginthreadex(NULL, 0, queue_main, queue, 0, NULL);
+    return ((queue->thread) ? 0 : -1);
+}
+
+static void join_queue(struct _WM_Queue *queue) {
+    WaitForSingleObject(queue->thread, INFINITE);
+    CloseHandle(queue->thread);
+}
+#else
+static void *queue_main(void *arg) {
+    queue_loop((struct _WM_Queue *) arg);
+    return (NULL);
+}
+
+static int start_queue(struct _WM_Queue *queue) {
+    return ((pthread_create(&queue->thread, NULL, queue_main, queue)) ? -1 : 0);
+}
+
+static void join_queue(struct _WM_Queue *queue) {
+    pthread_join(queue->thread, NULL);
+}
+#endif
+
+struct _WM_Queue *_WM_QueueCreate(void) {
+    struct _WM_Queue *queue;
+
+    queue = (struct _WM_Queue *) calloc(1, sizeof(struct _WM_Queue));
+    if (queue == NULL)
+        return (NULL);
+    if (wm_mutex_init(&queue->mutex) != 0) {
+        free(queue);
+        return (NULL);
+    }
+    if (wm_cond_init(&queue->wake) != 0) {
+        wm_mutex_destroy(&queue->mutex);
+        free(queue);
+        return (NULL);
+    }
+    if (start_queue(queue) != 0) {
+        wm_cond_destroy(&queue->wake);
+        wm_mutex_destroy(&queue->mutex);
+        free(queue);
+        return (NULL);
+    }
+    return (queue);
+}
+
+int _WM_QueuePost(struct _WM_Queue *queue, _WM_QueueJob job, void *data) {
+    struct _WM_QueueItem *item;
+
+    item = (struct _WM_QueueItem *) malloc(sizeof(struct _WM_QueueItem));
+    if (item == NULL)
+        return (-1);
+    item->job = job;
+    item->data = data;
+    item->next = NULL;
+
+    wm_mutex_lock(&queue->mutex);
+    if (queue->last)
+        queue->last->next = item;
+    else
+        queue->first = item;
+    queue->last = item;
+    wm_cond_broadcast(&queue->wake);
+    wm_mutex_unlock(&queue->mutex);
+    return (0);
+}
+
+void _WM_QueueFree(struct _WM_Queue *queue) {
+    if (queue == NULL)
+        return;
+
+    wm_mutex_lock(&queue->mutex);
+    queue->quit = 1;
+    wm_cond_broadcast(&queue->wake);
+    wm_mutex_unlock(&queue->mutex);
+
+    join_queue(queue);
+
+    wm_cond_destroy(&queue->wake);
+    wm_mutex_destroy(&queue->mutex);
+    free(queue);
+}
+
+#else /* no thread support, everything renders on the calling thread */
+
+int _WM_CpuCount(void) {
+    return (1);
+}
+
+struct _WM_Pool *_WM_PoolCreate(int threads) {
+    (void) threads;
+    return (NULL);
+}
+
+int _WM_PoolThreads(struct _WM_Pool *pool) {
+    (void) pool;
+    return (1);
+}
+
+void _WM_PoolRun(struct _WM_Pool *pool, _WM_PoolJob job, void *data) {
+    (void) pool;
+    job(data, 0);
+}
+
+void _WM_PoolFree(struct _WM_Pool *pool) {
+    (void) pool;
+}
+
+struct _WM_Queue *_WM_QueueCreate(void) {
+    return (NULL);
+}
+
+int _WM_QueuePost(struct _WM_Queue *queue, _WM_QueueJob job, void *data) {
+    (void) queue;
+    job(data);
+    return (0);
+}
+
+void _WM_QueueFree(struct _WM_Queue *queue) {
+    (void) queue;
+}
+
+#endif /* WM_HAVE_THREADS */
+
+uint64_t _WM_Clock(void) {
+#if defined(_WIN32)
+    LARGE_INTEGER count, freq;
+
+    QueryPerformanceCounter(&count);
+    QueryPerformanceFrequency(&freq);
+    return (((uint64_t) (count.QuadPart / freq.QuadPart) * 1000000000)
+            + (uint64_t) ((count.QuadPart % freq.QuadPart) * 1000000000 / freq.QuadPart));
+#elif defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (((uint64_t) ts.tv_sec * 1000000000) + (uint64_t) ts.tv_nsec);
+#else
+    return ((uint64_t) clock() * (1000000000 / CLOCKS_PER_SEC));
+#endif
+}
@@ -57,6 +57,19 @@ typedef struct {
     uint16_t tracks;
 } midi_descriptor;
 
+/* Events and sysex data of a conversion are bump allocated from a chain
+ * of blocks, the first one sized from the input, and all released at once
+ * when the conversion is done. */
+typedef struct _event_block {
+    struct _event_block *next;
+    uint32_t used;
+    uint32_t size;
+} event_block;
+
+#define BLOCK_HDR ((sizeof(event_block) + 7) & ~7)
+#define BLOCK_MIN 4096
+#define BLOCK_MAX (1 << 24)
+
 struct xmi_ctx {
     const uint8_t *src, *src_ptr;
     uint32_t srcsize;
@@ -70,11 +83,15 @@ struct xmi_ctx {
     signed short *timing;
     midi_event *list;
     midi_event *current;
+    event_block *arena;
+    uint32_t arena_hint;
+    uint32_t dst_estimate;
 };
 
 /* forward declarations of private functions */
-static void DeleteEventList(midi_event *mlist);
-static void CreateNewEvent(struct xmi_ctx *ctx, int32_t time); /* List manipulation */
+static void *ArenaAlloc(struct xmi_ctx *ctx, uint32_t len);
+static void ArenaFree(struct xmi_ctx *ctx);
+static int CreateNewEvent(struct xmi_ctx *ctx, int32_t time); /* List manipulation */
 static int GetVLQ(struct xmi_ctx *ctx, uint32_t *quant); /* Variable length quantity */
 static int GetVLQ2(struct xmi_ctx *ctx, uint32_t *quant);/* Variable length quantity */
 static int PutVLQ(struct xmi_ctx *ctx, uint32_t value);  /* Variable length quantity */
@@ -122,9 +139,10 @@ static void copy(struct xmi_ctx *ctx, char *b, uint32_t len)
 #define DST_CHUNK 8192
 static void resize_dst(struct xmi_ctx *ctx) {
     uint32_t pos = ctx->dst_ptr - ctx->dst;
-    ctx->dst = (uint8_t *) realloc(ctx->dst, ctx->dstsize + DST_CHUNK);
-    ctx->dstsize += DST_CHUNK;
-    ctx->dstrem += DST_CHUNK;
+    uint32_t grow = (ctx->dstsize > DST_CHUNK)? ctx->dstsize : DST_CHUNK;
+    ctx->dst = (uint8_t *) realloc(ctx->dst, ctx->dstsize + grow);
+    ctx->dstsize += grow;
+    ctx->dstrem += grow;
     ctx->dst_ptr = ctx->dst + pos;
 }
 
@@ -477,6 +495,11 @@ int _WM_xmi2midi(const uint8_t *in, uint32_t insize,
     ctx.src = ctx.src_ptr = in;
     ctx.srcsize = insize;
     ctx.convert_type = convert_type;
+    /* XMI events are at least two bytes and expand to at most two list
+     * entries, a third of the input is plenty for most files */
+    ctx.arena_hint = (insize < BLOCK_MAX)? (insize / 3) * sizeof(midi_event) : BLOCK_MAX;
+    if (ctx.arena_hint < BLOCK_MIN)
+        ctx.arena_hint = BLOCK_MIN;
 
     if (ParseXMI(&ctx) < 0) {
         _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_NOT_XMI, NULL, 0);
@@ -488,10 +511,17 @@ int _WM_xmi2midi(const uint8_t *in, uint32_t insize,
         goto _end;
     }
 
-    ctx.dst = (uint8_t *) malloc(DST_CHUNK);
+    /* the list knows how large the midi can get, so the output is sized
+     * once: the header, then 8 bytes for each track header on top of what
+     * CreateNewEvent and ConvertSystemMessage counted for the events */
+    ctx.dstsize = 14 + 8 * ctx.info.tracks + ctx.dst_estimate;
+    ctx.dst = (uint8_t *) malloc(ctx.dstsize);
+    if (!ctx.dst) {
+        _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, 0);
+        goto _end;
+    }
     ctx.dst_ptr = ctx.dst;
-    ctx.dstsize = DST_CHUNK;
-    ctx.dstrem = DST_CHUNK;
+    ctx.dstrem = ctx.dstsize;
 
     /* Header is 14 bytes long and add the rest as well */
     write1(&ctx, 'M');
@@ -517,42 +547,68 @@ _end:   /* cleanup */
         *out = NULL;
         *outsize = 0;
     }
-    if (ctx.events) {
-        for (i = 0; i < ctx.info.tracks; i++)
-            DeleteEventList(ctx.events[i]);
-        free(ctx.events);
-    }
+    free(ctx.events);
     free(ctx.timing);
+    ArenaFree(&ctx);
 
     return (ret);
 }
 
-static void DeleteEventList(midi_event *mlist) {
-    midi_event *event;
-    midi_event *next;
+/* Returns len zeroed bytes from the arena, NULL when out of memory */
+static void *ArenaAlloc(struct xmi_ctx *ctx, uint32_t len) {
+    event_block *block = ctx->arena;
+    uint8_t *ptr;
+
+    len = (len + 7) & ~7;
+    if (!block || block->size - block->used < len) {
+        uint32_t size = (block)? block->size * 2 : ctx->arena_hint;
+        if (size < len)
+            size = len;
+        block = (event_block *) malloc(BLOCK_HDR + size);
+        if (!block) {
+            _WM_GLOBAL_ERROR(__FUNCTION__, __LINE__, WM_ERR_MEM, NULL, 0);
+            return (NULL);
+        }
+        block->next = ctx->arena;
+        block->used = 0;
+        block->size = size;
+        ctx->arena = block;
+    }
+
+    ptr = (uint8_t *) block + BLOCK_HDR + block->used;
+    block->used += len;
+    memset(ptr, 0, len);
+    return (ptr);
+}
 
-    next = mlist;
+static void ArenaFree(struct xmi_ctx *ctx) {
+    event_block *block;
 
-    while ((event = next) != NULL) {
-        next = event->next;
-        free(event->buffer);
-        free(event);
+    while ((block = ctx->arena) != NULL) {
+        ctx->arena = block->next;
+        free(block);
     }
 }
 
 /* Sets current to the new event and updates list */
-static void CreateNewEvent(struct xmi_ctx *ctx, int32_t time) {
+static int CreateNewEvent(struct xmi_ctx *ctx, int32_t time) {
+    midi_event *event = (midi_event *) ArenaAlloc(ctx, sizeof(midi_event));
+
+    if (!event)
+        return (-1);
+    /* delta, status and two data bytes at most */
+    ctx->dst_estimate += 8;
+
     if (!ctx->list) {
-        ctx->list = ctx->current = (midi_event *) calloc(1, sizeof(midi_event));
+        ctx->list = ctx->current = event;
         ctx->current->time = (time < 0)? 0 : time;
-        return;
+        return (0);
     }
 
     if (time < 0) {
-        midi_event *event = (midi_event *) calloc(1, sizeof(midi_event));
         event->next = ctx->list;
         ctx->list = ctx->current = event;
-        return;
+        return (0);
     }
 
     if (ctx->current->time > time)
@@ -560,20 +616,20 @@ static void CreateNewEvent(struct xmi_ctx *ctx, int32_t time) {
 
     while (ctx->current->next) {
         if (ctx->current->next->time > time) {
-            midi_event *event = (midi_event *) calloc(1, sizeof(midi_event));
             event->next = ctx->current->next;
             ctx->current->next = event;
             ctx->current = event;
             ctx->current->time = time;
-            return;
+            return (0);
         }
 
         ctx->current = ctx->current->next;
     }
 
-    ctx->current->next = (midi_event *) calloc(1, sizeof(midi_event));
+    ctx->current->next = event;
     ctx->current = ctx->current->next;
     ctx->current->time = time;
+    return (0);
 }
 
 /* Conventional Variable Length Quantity */
@@ -662,7 +718,8 @@ static int ConvertEvent(struct xmi_ctx *ctx, const int32_t time,
                     && (status & 0xF) == 9) )
             return (2);
 
-        CreateNewEvent(ctx, time);
+        if (CreateNewEvent(ctx, time) < 0)
+            return (-1);
         ctx->current->status = status;
         ctx->current->data[0] = 0;
         ctx->current->data[1] = data;
@@ -685,7 +742,8 @@ static int ConvertEvent(struct xmi_ctx *ctx, const int32_t time,
             ctx->convert_type == XMIDI_CONVERT_MT32_TO_GS ||
             ctx->convert_type == XMIDI_CONVERT_MT32_TO_GS127DRUM)
         {
-            CreateNewEvent (ctx, time);
+            if (CreateNewEvent(ctx, time) < 0)
+                return (-1);
             ctx->current->status = 0xB0 | (status&0xF);
             ctx->current->data[0] = 0;
             ctx->current->data[1] = mt32asgs[data*2+1];
@@ -694,7 +752,8 @@ static int ConvertEvent(struct xmi_ctx *ctx, const int32_t time,
         }
         else if (ctx->convert_type == XMIDI_CONVERT_MT32_TO_GS127)
         {
-            CreateNewEvent (ctx, time);
+            if (CreateNewEvent(ctx, time) < 0)
+                return (-1);
             ctx->current->status = 0xB0 | (status&0xF);
             ctx->current->data[0] = 0;
             ctx->current->data[1] = 127;
@@ -704,13 +763,15 @@ static int ConvertEvent(struct xmi_ctx *ctx, const int32_t time,
     else if ((status >> 4) == 0xC && (status&0xF) == 9 &&
         (ctx->convert_type == XMIDI_CONVERT_MT32_TO_GS127DRUM || ctx->convert_type == XMIDI_CONVERT_MT32_TO_GS127))
     {
-        CreateNewEvent (ctx, time);
+        if (CreateNewEvent(ctx, time) < 0)
+            return (-1);
         ctx->current->status = 0xB9;
         ctx->current->data[0] = 0;
         ctx->current->data[1] = 127;
     }
 
-    CreateNewEvent(ctx, time);
+    if (CreateNewEvent(ctx, time) < 0)
+        return (-1);
     ctx->current->status = status;
 
     ctx->current->data[0] = data;
@@ -726,7 +787,8 @@ static int ConvertEvent(struct xmi_ctx *ctx, const int32_t time,
     /* XMI Note On handling */
     prev = ctx->current;
     i = GetVLQ(ctx, &delta);
-    CreateNewEvent(ctx, time + delta * 3);
+    if (CreateNewEvent(ctx, time + delta * 3) < 0)
+        return (-1);
 
     ctx->current->status = status;
     ctx->current->data[0] = data;
@@ -741,7 +803,8 @@ static int32_t ConvertSystemMessage(struct xmi_ctx *ctx, const int32_t time,
                                     const uint8_t status) {
     int32_t i = 0;
 
-    CreateNewEvent(ctx, time);
+    if (CreateNewEvent(ctx, time) < 0)
+        return (-1);
     ctx->current->status = status;
 
     /* Handling of Meta events */
@@ -755,7 +818,11 @@ static int32_t ConvertSystemMessage(struct xmi_ctx *ctx, const int32_t time,
     if (!ctx->current->len)
         return (i);
 
-    ctx->current->buffer = (uint8_t *) malloc(sizeof(uint8_t)*ctx->current->len);
+    ctx->current->buffer = (uint8_t *) ArenaAlloc(ctx, ctx->current->len);
+    if (!ctx->current->buffer)
+        return (-1);
+    /* meta type and a length of up to five bytes besides the data */
+    ctx->dst_estimate += 6 + ctx->current->len;
     copy(ctx, (char *) ctx->current->buffer, ctx->current->len);
 
     return (i + ctx->current->len);
@@ -771,10 +838,12 @@ static int32_t ConvertFiletoList(struct xmi_ctx *ctx) {
     int32_t tempo_set = 0;
     uint32_t status = 0;
     uint32_t file_size = getsrcsize(ctx);
+    int32_t ret = 0;
 
     /* Set Drum track to correct setting if required */
     if (ctx->convert_type == XMIDI_CONVERT_MT32_TO_GS127) {
-        CreateNewEvent(ctx, 0);
+        if (CreateNewEvent(ctx, 0) < 0)
+            return (0);
         ctx->current->status = 0xB9;
         ctx->current->data[0] = 0;
         ctx->current->data[1] = 127;
@@ -788,7 +857,7 @@ static int32_t ConvertFiletoList(struct xmi_ctx *ctx) {
 
         switch (status >> 4) {
         case MIDI_STATUS_NOTE_ON:
-            ConvertEvent(ctx, time, status, 3);
+            ret = ConvertEvent(ctx, time, status, 3);
             break;
 
         /* 2 byte data */
@@ -796,13 +865,13 @@ static int32_t ConvertFiletoList(struct xmi_ctx *ctx) {
         case MIDI_STATUS_AFTERTOUCH:
         case MIDI_STATUS_CONTROLLER:
         case MIDI_STATUS_PITCH_WHEEL:
-            ConvertEvent(ctx, time, status, 2);
+            ret = ConvertEvent(ctx, time, status, 2);
             break;
 
         /* 1 byte data */
         case MIDI_STATUS_PROG_CHANGE:
         case MIDI_STATUS_PRESSURE:
-            ConvertEvent(ctx, time, status, 1);
+            ret = ConvertEvent(ctx, time, status, 1);
             break;
 
         case MIDI_STATUS_SYSEX:
@@ -829,12 +898,14 @@ static int32_t ConvertFiletoList(struct xmi_ctx *ctx) {
 
                 seeksrc(ctx, pos);
             }
-            ConvertSystemMessage(ctx, time, status);
+            ret = ConvertSystemMessage(ctx, time, status);
             break;
 
         default:
             break;
         }
+        if (ret < 0) /* out of memory */
+            return (0);
     }
     return ((tempo * 3) / 25000);
 }
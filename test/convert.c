@@ -0,0 +1,348 @@
+/*
+ * convert.c -- Midi Wavetable Processing library
+ *
+ * Copyright (C) WildMIDI Developers 2001-2016
+ *
+ * This file is part of WildMIDI.
+ *
+ * WildMIDI is free software: you can redistribute and/or modify the player
+ * under the terms of the GNU General Public License and you can redistribute
+ * and/or modify the library under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either version 3 of
+ * the licenses, or(at your option) any later version.
+ *
+ * WildMIDI is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License and
+ * the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License and the
+ * GNU Lesser General Public License along with WildMIDI.  If not,  see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * wildmidi-convert checks the vector kernels gus_pat.c converts patch
+ * samples with against its plain C ones, and both against the samples
+ * worked out here one at a time. The kernels are static, so gus_pat.c is
+ * built into this program rather than linked from the library.
+ *
+ * Every kernel is run over each length up to a few vectors and some longer
+ * ones, from every byte alignment, with the output written between canary
+ * samples that must be left as they were. Then whole samples go through
+ * convert_sample() in every combination of 8 and 16 bit, signed and
+ * unsigned, reversed or not, looped or not and ping pong or not, with
+ * loops in the middle of the sample, of no length, over all of it, ending
+ * on its last sample and running past its end, the samples, loop points
+ * and modes coming out of it having to be the same for every set of
+ * kernels.
+ */
+
+#include "../src/gus_pat.c"
+
+/*
+ * What gus_pat.c needs of sample.c, which would bring the rest of the
+ * library with it. The same as there, the pool starting on an alignment
+ * boundary with the block malloc() gave kept just before it.
+ */
+uint8_t *_WM_alloc_sample_pool(uint32_t size) {
+    uint8_t *block = (uint8_t *) calloc(1, (size + sizeof(void *) + SAMPLE_POOL_ALIGN - 1));
+    uint8_t *pool;
+
+    if (block == NULL) return (NULL);
+    pool = block + sizeof(void *);
+    pool += (SAMPLE_POOL_ALIGN - ((uintptr_t) pool & (SAMPLE_POOL_ALIGN - 1))) & (SAMPLE_POOL_ALIGN - 1);
+    memcpy((pool - sizeof(void *)), &block, sizeof(void *));
+    return (pool);
+}
+
+void _WM_free_sample_pool(uint8_t *pool) {
+    void *block;
+
+    if (pool == NULL) return;
+    memcpy(&block, (pool - sizeof(void *)), sizeof(void *));
+    free(block);
+}
+
+/* samples in the longest run of a kernel */
+#define CONVERT_MAX 4133
+/* samples left untouched on each side of the output */
+#define CONVERT_CANARY 16
+#define CANARY_VALUE ((int16_t) 0x5a5a)
+
+static const char *convert_name[4] = {
+    "8 bit signed", "16 bit signed", "8 bit unsigned", "16 bit unsigned"
+};
+
+struct _convert_set {
+    const char *name;
+    const struct _WM_SampleConvert *cvt;
+};
+
+static uint32_t convert_seed;
+
+/* a plain lcg, so every build converts the same data */
+static uint8_t convert_rand(void) {
+    convert_seed = convert_seed * 1103515245 + 12345;
+    return ((uint8_t) (convert_seed >> 16));
+}
+
+/* sample i of src in the format of the SAMPLE_16BIT and SAMPLE_UNSIGNED
+   bits of modes, as signed 16 bit */
+static int16_t expect_sample(const uint8_t *src, uint8_t modes, uint32_t i) {
+    uint16_t value;
+
+    if (modes & SAMPLE_16BIT) {
+        value = (uint16_t) (src[i * 2] | (src[i * 2 + 1] << 8));
+    } else {
+        value = (uint16_t) (src[i] << 8);
+    }
+    if (modes & SAMPLE_UNSIGNED)
+        value ^= 0x8000;
+    return ((int16_t) value);
+}
+
+static void fill_canary(int16_t *buffer, uint32_t count) {
+    uint32_t i;
+
+    for (i = 0; i < count; i++) {
+        buffer[i] = CANARY_VALUE;
+    }
+}
+
+/* the canaries around count samples at out, returning 0 if they are intact */
+static int check_canary(const int16_t *out, uint32_t count) {
+    uint32_t i;
+
+    for (i = 1; i <= CONVERT_CANARY; i++) {
+        if ((out[-(int32_t) i] != CANARY_VALUE) || (out[count + i - 1] != CANARY_VALUE))
+            return (-1);
+    }
+    return (0);
+}
+
+/*
+ * Each kernel of set from each alignment of its source and output over
+ * count samples, against expect_sample() and, reversed, the source read
+ * backwards. Returns the number of runs that failed.
+ */
+static int check_kernels(const struct _convert_set *set, uint32_t count) {
+    static uint8_t src[(CONVERT_MAX * 2) + 16];
+    static int16_t out[CONVERT_MAX + (CONVERT_CANARY * 2) + 16];
+    uint32_t align, i;
+    int16_t *dst;
+    uint8_t format;
+    int failed = 0;
+
+    for (align = 0; align < 16; align++) {
+        convert_seed = (count * 16) + align;
+        for (i = 0; i < sizeof(src); i++) {
+            src[i] = convert_rand();
+        }
+        for (format = 0; format < 4; format++) {
+            /* the output only ever starts on a whole sample */
+            dst = out + CONVERT_CANARY + (align & 7);
+            fill_canary(out, sizeof(out) / sizeof(int16_t));
+            set->cvt->convert[format](src + align, dst, count);
+            for (i = 0; i < count; i++) {
+                if (dst[i] != expect_sample(src + align, format, i))
+                    break;
+            }
+            if ((i < count) || (check_canary(dst, count) != 0)) {
+                printf("%s %s: FAILED converting %lu samples from byte %lu\n",
+                       set->name, convert_name[format], (unsigned long) count,
+                       (unsigned long) align);
+                failed++;
+                continue;
+            }
+
+            set->cvt->reverse(dst, count);
+            for (i = 0; i < count; i++) {
+                if (dst[i] != expect_sample(src + align, format, count - 1 - i))
+                    break;
+            }
+            if ((i < count) || (check_canary(dst, count) != 0)) {
+                printf("%s %s: FAILED reversing %lu samples from sample %lu\n",
+                       set->name, convert_name[format], (unsigned long) count,
+                       (unsigned long) (align & 7));
+                failed++;
+            }
+        }
+    }
+    return (failed);
+}
+
+struct _convert_loop {
+    const char *name;
+    uint32_t loop_start;
+    int32_t loop_end;
+    int from_end;   /* loop_end is from the end of the sample */
+};
+
+static const struct _convert_loop convert_loop[] = {
+    { "a loop", 37, 412, 0 },
+    { "an empty loop", 200, 200, 0 },
+    { "a loop of the whole sample", 0, 0, 1 },
+    { "a loop to the end", 130, 0, 1 },
+    { "a loop to the last sample", 130, -1, 1 },
+    { "a loop past the end", 130, 1, 1 },
+    { NULL, 0, 0, 0 }
+};
+
+/*
+ * A whole sample of count samples through convert_sample() with each set,
+ * in modes with loop. The first set is checked against the samples worked
+ * out here and the loop, length and modes the mixer needs, each other set
+ * against the first, samples, guards and all. Returns the number of sets
+ * that failed.
+ */
+static int check_sample(const struct _convert_set *sets, int set_count,
+                        uint8_t modes, const struct _convert_loop *loop, uint32_t count) {
+    uint8_t bytes = (modes & SAMPLE_16BIT) ? 2 : 1;
+    uint32_t frames = GUS_SAMPLE_FRAMES(count * bytes, modes);
+    uint32_t slot_size = SAMPLE_POOL_SLOT(frames);
+    uint32_t loop_end = (uint32_t) loop->loop_end;
+    struct _sample want, got;
+    uint8_t *data, *pool;
+    int16_t *slot;
+    uint32_t i, from;
+    int set;
+    int failed = 0;
+
+    if (loop->from_end)
+        loop_end += count;
+    data = (uint8_t *) malloc(count * bytes);
+    pool = _WM_alloc_sample_pool(slot_size * 2);
+    if ((data == NULL) || (pool == NULL)) {
+        fprintf(stderr, "Out of memory\n");
+        free(data);
+        _WM_free_sample_pool(pool);
+        return (1);
+    }
+    convert_seed = modes + count;
+    for (i = 0; i < (count * bytes); i++) {
+        data[i] = convert_rand();
+    }
+
+    /* played forwards as signed samples, the loop flipped in bytes of the
+       file as the loader has it, even where that takes it below the start,
+       and a ping pong loop only where the mixer can turn at both its ends */
+    memset(&want, 0, sizeof(want));
+    want.data_length = count;
+    want.loop_start = loop->loop_start;
+    want.loop_end = loop_end;
+    want.loop_fraction = 0x3c;
+    want.modes = modes & ~(SAMPLE_UNSIGNED | SAMPLE_REVERSE);
+    if (modes & SAMPLE_REVERSE) {
+        want.loop_start = ((count - loop_end) * bytes) / bytes;
+        want.loop_end = count - loop->loop_start;
+        want.loop_fraction = 0xc3;
+    }
+    if ((want.loop_end > want.data_length) || (want.loop_start >= want.loop_end))
+        want.modes &= ~SAMPLE_PINGPONG;
+
+    for (set = 0; set < set_count; set++) {
+        memset(&got, 0, sizeof(got));
+        got.data_length = count * bytes;
+        got.loop_start = loop->loop_start * bytes;
+        got.loop_end = loop_end * bytes;
+        got.loop_fraction = 0x3c;
+        got.modes = modes;
+        memset(pool + slot_size, 0, slot_size);
+        convert_sample(sets[set].cvt, data, &got, pool + slot_size);
+
+        if ((got.data_length != want.data_length) || (got.loop_start != want.loop_start)
+                || (got.loop_end != want.loop_end) || (got.loop_fraction != want.loop_fraction)
+                || (got.modes != want.modes)) {
+            printf("%s modes 0x%02x, %s: FAILED, length %lu loop %lu to %lu fraction 0x%02x"
+                   " modes 0x%02x\n", sets[set].name, modes, loop->name,
+                   (unsigned long) got.data_length, (unsigned long) got.loop_start,
+                   (unsigned long) got.loop_end, got.loop_fraction, got.modes);
+            failed++;
+            continue;
+        }
+        if (set != 0) {
+            if (memcmp(pool, pool + slot_size, slot_size) != 0) {
+                printf("%s modes 0x%02x, %s: FAILED, not the same as %s\n",
+                       sets[set].name, modes, loop->name, sets[0].name);
+                failed++;
+            }
+            continue;
+        }
+
+        slot = (int16_t *) (pool + slot_size);
+        for (i = 0; i < (slot_size / sizeof(int16_t)); i++) {
+            if ((i >= SAMPLE_GUARD) && (i < (SAMPLE_GUARD + count))) {
+                from = (modes & SAMPLE_REVERSE) ? (count - 1 - (i - SAMPLE_GUARD))
+                        : (i - SAMPLE_GUARD);
+                if (slot[i] != expect_sample(data, modes, from))
+                    break;
+            } else if (slot[i] != 0) {
+                break;
+            }
+        }
+        if ((got.data != (slot + SAMPLE_GUARD)) || (i < (slot_size / sizeof(int16_t)))) {
+            printf("%s modes 0x%02x, %s: FAILED at sample %ld of the slot\n",
+                   sets[set].name, modes, loop->name, (long) i - SAMPLE_GUARD);
+            failed++;
+        }
+        memcpy(pool, pool + slot_size, slot_size);
+    }
+
+    free(data);
+    _WM_free_sample_pool(pool);
+    return (failed);
+}
+
+int main(void) {
+    static const uint32_t lengths[] = { 100, 255, 256, 257, 1000, 1023, 4096, CONVERT_MAX };
+    static const uint32_t sample_lengths[] = { 413, 1024, 1027 };
+    struct _convert_set sets[2];
+    int set_count = 1;
+    uint32_t count;
+    uint8_t modes;
+    int failed = 0;
+    int set, i, loop;
+
+    sets[0].name = "c";
+    sets[0].cvt = &cvt_c;
+    /* the kernels the loader picks on this cpu, if they are not the c ones */
+    if (cvt_pick() != &cvt_c) {
+#if defined(HAVE_NEON_INTRINSICS)
+        sets[1].name = "neon";
+#else
+        sets[1].name = "sse2";
+#endif
+        sets[1].cvt = cvt_pick();
+        set_count++;
+    }
+
+    for (set = 0; set < set_count; set++) {
+        for (count = 0; count <= 67; count++) {
+            failed += check_kernels(&sets[set], count);
+        }
+        for (i = 0; i < (int) (sizeof(lengths) / sizeof(lengths[0])); i++) {
+            failed += check_kernels(&sets[set], lengths[i]);
+        }
+    }
+
+    /* every combination of the bits up to SAMPLE_REVERSE */
+    for (modes = 0; modes < 32; modes++) {
+        for (loop = 0; convert_loop[loop].name != NULL; loop++) {
+            for (i = 0; i < (int) (sizeof(sample_lengths) / sizeof(sample_lengths[0])); i++) {
+                failed += check_sample(sets, set_count, modes, &convert_loop[loop],
+                                       sample_lengths[i]);
+            }
+        }
+    }
+
+    for (set = 0; set < set_count; set++) {
+        printf("%s kernels: checked\n", sets[set].name);
+    }
+    if (failed) {
+        printf("FAILED, %d checks\n", failed);
+        return (1);
+    }
+    printf("All conversions are the same\n");
+    return (0);
+}
@@ -0,0 +1,1706 @@
+/*
+ * golden.c -- Midi Wavetable Processing library
+ *
+ * Copyright (C) WildMIDI Developers 2001-2016
+ *
+ * This file is part of WildMIDI.
+ *
+ * WildMIDI is free software: you can redistribute and/or modify the player
+ * under the terms of the GNU General Public License and you can redistribute
+ * and/or modify the library under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation, either version 3 of
+ * the licenses, or(at your option) any later version.
+ *
+ * WildMIDI is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License and
+ * the GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License and the
+ * GNU Lesser General Public License along with WildMIDI.  If not,  see
+ * <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * wildmidi-golden renders one song of each file type the library reads,
+ * midi, xmi, mus, hmp and hmi, with linear and gauss resampling and checks
+ * the output against test/golden.txt. That holds a hash of the 16 bit
+ * output of each render, and how loud each sixteenth of it was so a render
+ * that is not bit exact can still be held to an error bound with -e.
+ *
+ * The first lines of test/golden.txt are the output of the library from
+ * before the mixer was reworked. Each change since that was meant to alter
+ * the output adds the renders it altered, with the error bound it keeps to
+ * against them, so the output is checked against every change on the way
+ * back to the library as it was. See read_golden().
+ *
+ * The songs and their patch set are written here rather than shipped as
+ * binary files. All the songs play the same score of notes, written out in
+ * each format, on a handful of patches made up of nothing but integer
+ * maths so they come out the same wherever this runs. The patches cover
+ * 8 and 16 bit, signed and unsigned, looped, ping pong looped and reversed
+ * samples, with and without envelopes.
+ *
+ * With -l a song of just the ping pong looped patches is rendered instead,
+ * and checked against the same patches unrolled the way the loader used to
+ * unroll them. See check_loops().
+ *
+ * With -p the renders are timed instead, against a fixed loop of plain
+ * mixing timed along with them, and checked against the times test/
+ * render_time.txt has of the library from before the changes and of the
+ * last change timed. See check_perf().
+ */
+
+#include "config.h"
+
+#include <errno.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if (defined _WIN32) || (defined __CYGWIN__)
+#include <windows.h>
+#include "getopt_long.h"
+#else
+#include <getopt.h>
+#include <sys/time.h>
+#endif
+
+#include "wildmidi_lib.h"
+
+#define GOLDEN_RATE 44100
+/* the scores are in ticks of 1/120th of a second: 60 divisions at 120 bpm */
+#define GOLDEN_DIVISIONS 60
+#define GOLDEN_TEMPO 500000
+#define GOLDEN_BPM 120
+#define GOLDEN_TICKS 960
+#define GOLDEN_END (GOLDEN_TICKS + 120)
+#define GOLDEN_BLOCKS 16
+#define GOLDEN_CHANNELS 5
+/* lines the golden file may have for a render */
+#define GOLDEN_CHANGES 16
+/* what ctest takes for a test that was not run */
+#define GOLDEN_SKIPPED 77
+
+enum {
+    FORMAT_MIDI,
+    FORMAT_XMI,
+    FORMAT_MUS,
+    FORMAT_HMP,
+    FORMAT_HMI,
+    FORMATS
+};
+
+static const char *format_name[FORMATS] = {
+    "midi", "xmi", "mus", "hmp", "hmi"
+};
+
+static const char *resampler_name[2] = {
+    "linear", "gauss"
+};
+
+static const uint8_t golden_channel[GOLDEN_CHANNELS] = { 0, 1, 2, 3, 9 };
+
+struct _golden_event {
+    uint32_t time;
+    uint32_t length;    /* of a note on, for xmi and hmi which give it there */
+    uint32_t order;
+    uint8_t status;
+    uint8_t data1;
+    uint8_t data2;
+};
+
+struct _golden_result {
+    char change[32];    /* the output of which, see read_golden() */
+    double error;
+    uint32_t frames;
+    uint64_t hash;
+    uint32_t rms[GOLDEN_BLOCKS];
+};
+
+static struct option const long_options[] = {
+    { "golden", 1, 0, 'g' },
+    { "type", 1, 0, 't' },
+    { "dir", 1, 0, 'd' },
+    { "error", 1, 0, 'e' },
+    { "perf", 1, 0, 'p' },
+    { "slower", 1, 0, 's' },
+    { "faster", 1, 0, 'f' },
+    { "build", 1, 0, 'B' },
+    { "runs", 1, 0, 'n' },
+    { "options", 1, 0, 'o' },
+    { "bus", 0, 0, 'b' },
+    { "threads", 1, 0, 'j' },
+    { "update", 0, 0, 'u' },
+    { "change", 1, 0, 'c' },
+    { "loops", 1, 0, 'l' },
+    { "loops-gauss", 1, 0, 'L' },
+    { "help", 0, 0, 'h' },
+    { NULL, 0, NULL, 0 }
+};
+
+static void do_help(void) {
+    printf("Usage: wildmidi-golden [options]\n\n");
+    printf("  -g F  --golden=F    Check the renders against the golden file F\n");
+    printf("  -t T  --type=T      Only render the song of type T, one of midi, xmi,\n");
+    printf("                      mus, hmp or hmi\n");
+    printf("  -d D  --dir=D       Write the patch set to the directory D, default is .\n");
+    printf("  -e N  --error=N     Pass a render that is not bit exact if each part of it\n");
+    printf("                      is within N percent of the golden loudness\n");
+    printf("  -p F  --perf=F      Time the renders against the reference file F\n");
+    printf("  -B B  --build=B     The build type the times are of, default is Release\n");
+    printf("  -s N  --slower=N    Fail if the renders are N percent slower than the last\n");
+    printf("                      change in the reference file, default is 25\n");
+    printf("  -f N  --faster=N    Fail if the renders are not N percent faster than the\n");
+    printf("                      first, from before the changes, default is 0\n");
+    printf("  -n N  --runs=N      Time each render N times and keep the fastest,\n");
+    printf("                      default is 5\n");
+    printf("  -o N  --options=N   Render with the mixer options N, which must not change\n");
+    printf("                      the output, such as 0x0400 for WM_MO_PRUNEEVENTS\n");
+    printf("  -b    --bus         Render through a bus, which must not change the output\n");
+    printf("  -j N  --threads=N   Render each song on N threads, which must not change\n");
+    printf("                      the output\n");
+    printf("  -u    --update      Add the renders that changed to the golden file, or\n");
+    printf("                      the times to the reference file, instead of checking\n");
+    printf("  -c C  --change=C    The change the renders added by -u are of, each of the\n");
+    printf("                      golden ones within the -e of the output before it\n");
+    printf("  -l N  --loops=N     Check the ping pong loops are within N db of them\n");
+    printf("                      unrolled, as the loader used to\n");
+    printf("  -L N  --loops-gauss=N\n");
+    printf("                      The same for the gauss resampler, default is -l\n");
+    printf("  -h    --help        Display this help and exit\n");
+}
+
+/* milliseconds since some point in the past */
+static double golden_clock(void) {
+#if (defined _WIN32) || (defined __CYGWIN__)
+    LARGE_INTEGER count, freq;
+    QueryPerformanceCounter(&count);
+    QueryPerformanceFrequency(&freq);
+    return ((double) count.QuadPart * 1000.0 / (double) freq.QuadPart);
+#elif defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6);
+#else
+    return ((double) clock() * 1000.0 / CLOCKS_PER_SEC);
+#endif
+}
+
+/*
+ * =========================
+ * The score
+ * =========================
+ */
+
+static uint32_t golden_seed;
+
+/* a plain lcg, so every build plays the same notes */
+static uint32_t golden_rand(uint32_t range) {
+    golden_seed = golden_seed * 1103515245 + 12345;
+    return ((golden_seed >> 16) % range);
+}
+
+static struct _golden_event *score;
+static uint32_t score_count;
+static uint32_t score_alloc;
+
+static int add_event(uint32_t time, uint8_t status, uint8_t data1, uint8_t data2,
+                     uint32_t length) {
+    struct _golden_event *event;
+
+    if (score_count == score_alloc) {
+        event = (struct _golden_event *) realloc(score,
+                    sizeof(struct _golden_event) * (score_alloc + 256));
+        if (event == NULL)
+            return (-1);
+        score = event;
+        score_alloc += 256;
+    }
+    event = &score[score_count];
+    event->time = time;
+    event->length = length;
+    event->order = score_count++;
+    event->status = status;
+    event->data1 = data1;
+    event->data2 = data2;
+    return (0);
+}
+
+static int add_note(uint32_t time, uint8_t channel, uint8_t note, uint8_t velocity,
+                    uint32_t length) {
+    if ((add_event(time, 0x90 | channel, note, velocity, length) != 0)
+            || (add_event(time + length, 0x80 | channel, note, 0, 0) != 0))
+        return (-1);
+    return (0);
+}
+
+/* note offs go before anything else at a time, note ons after */
+static int event_rank(const struct _golden_event *event) {
+    switch (event->status & 0xf0) {
+    case 0x80:
+        return (0);
+    case 0x90:
+        return (2);
+    default:
+        return (1);
+    }
+}
+
+static int compare_events(const void *a, const void *b) {
+    const struct _golden_event *ea = (const struct _golden_event *) a;
+    const struct _golden_event *eb = (const struct _golden_event *) b;
+
+    if (ea->time != eb->time)
+        return ((ea->time < eb->time) ? -1 : 1);
+    if (event_rank(ea) != event_rank(eb))
+        return (event_rank(ea) - event_rank(eb));
+    return ((ea->order < eb->order) ? -1 : 1);
+}
+
+/*
+ * Four melodic channels on patches 0 to 3 play runs of notes and the odd
+ * two note chord, overlapping each other but never the same note of a
+ * channel, with the drums on channel 9 keeping time under them.
+ */
+static int make_score(void) {
+    uint32_t note_end[128];
+    uint32_t t, length;
+    uint8_t ch, note;
+    int i, chord;
+
+    golden_seed = 1;
+    score_count = 0;
+
+    for (i = 0; i < GOLDEN_CHANNELS; i++) {
+        ch = golden_channel[i];
+        if ((add_event(0, 0xc0 | ch, (ch == 9) ? 0 : ch, 0, 0) != 0)
+                || (add_event(0, 0xb0 | ch, 7, 100 - (i * 8), 0) != 0)
+                || (add_event(0, 0xb0 | ch, 10, (i * 30) & 0x7f, 0) != 0)
+                || (add_event(GOLDEN_TICKS / 2, 0xb0 | ch, 7, 120 - (i * 12), 0) != 0))
+            return (-1);
+    }
+
+    for (i = 0; i < 4; i++) {
+        ch = golden_channel[i];
+        memset(note_end, 0, sizeof(note_end));
+        for (t = i * 7; t < GOLDEN_TICKS - 100; t += 10 + golden_rand(40)) {
+            length = 20 + golden_rand(70);
+            for (chord = (golden_rand(3) == 0) ? 2 : 1; chord > 0; chord--) {
+                note = 40 + (i * 5) + golden_rand(30);
+                while (note_end[note] > t)
+                    note++;
+                note_end[note] = t + length;
+                if (add_note(t, ch, note, 50 + golden_rand(77), length) != 0)
+                    return (-1);
+            }
+        }
+    }
+
+    for (t = 0; t < GOLDEN_TICKS; t += 30) {
+        static const uint8_t drum[4] = { 35, 38, 36, 38 };
+        if (add_note(t, 9, drum[(t / 30) % 4], 80 + golden_rand(47), 10) != 0)
+            return (-1);
+    }
+
+    qsort(score, score_count, sizeof(struct _golden_event), compare_events);
+    return (0);
+}
+
+/*
+ * Only the patches with ping pong loops, golden2 on channel 0 and golden4
+ * on channel 1, held through the loop and let go of on the way back and
+ * forth through it, or on the first pass before it turns, with the drums
+ * on them struck short and let ring.
+ */
+static int make_loop_score(void) {
+    uint32_t t;
+
+    score_count = 0;
+    if ((add_event(0, 0xc0, 2, 0, 0) != 0) || (add_event(0, 0xc1, 4, 0, 0) != 0)
+            || (add_event(0, 0xc9, 0, 0, 0) != 0)
+            /* held at the sustain of its envelope, then let go */
+            || (add_note(0, 0, 60, 100, 480) != 0)
+            || (add_note(540, 0, 67, 90, 7) != 0)
+            || (add_note(600, 0, 55, 90, 95) != 0)
+            /* no sustain, let go of part way through the envelope */
+            || (add_note(60, 1, 64, 100, 30) != 0)
+            || (add_note(300, 1, 52, 100, 300) != 0)
+            || (add_note(700, 1, 71, 80, 3) != 0)
+            || (add_note(800, 9, 38, 110, 200) != 0))
+        return (-1);
+    for (t = 0; t < 720; t += 45) {
+        if (add_note(t, 9, ((t / 45) & 1) ? 38 : 36, 70 + (t / 15), 5) != 0)
+            return (-1);
+    }
+
+    qsort(score, score_count, sizeof(struct _golden_event), compare_events);
+    return (0);
+}
+
+/*
+ * =========================
+ * Writing the songs
+ * =========================
+ */
+
+static uint8_t *song_data;
+static uint32_t song_size;
+static uint32_t song_alloc;
+
+static int put_byte(uint8_t byte) {
+    if (song_size == song_alloc) {
+        uint8_t *more = (uint8_t *) realloc(song_data, song_alloc + 4096);
+        if (more == NULL)
+            return (-1);
+        song_data = more;
+        song_alloc += 4096;
+    }
+    song_data[song_size++] = byte;
+    return (0);
+}
+
+static int put_bytes(const void *data, uint32_t size) {
+    const uint8_t *bytes = (const uint8_t *) data;
+    uint32_t i;
+
+    for (i = 0; i < size; i++) {
+        if (put_byte(bytes[i]) != 0)
+            return (-1);
+    }
+    return (0);
+}
+
+static int put_le32(uint32_t value) {
+    uint8_t bytes[4];
+
+    bytes[0] = value & 0xff;
+    bytes[1] = (value >> 8) & 0xff;
+    bytes[2] = (value >> 16) & 0xff;
+    bytes[3] = (value >> 24) & 0xff;
+    return (put_bytes(bytes, 4));
+}
+
+static void set_le32(uint32_t ofs, uint32_t value) {
+    song_data[ofs] = value & 0xff;
+    song_data[ofs + 1] = (value >> 8) & 0xff;
+    song_data[ofs + 2] = (value >> 16) & 0xff;
+    song_data[ofs + 3] = (value >> 24) & 0xff;
+}
+
+static void set_be32(uint32_t ofs, uint32_t value) {
+    song_data[ofs] = (value >> 24) & 0xff;
+    song_data[ofs + 1] = (value >> 16) & 0xff;
+    song_data[ofs + 2] = (value >> 8) & 0xff;
+    song_data[ofs + 3] = value & 0xff;
+}
+
+/* a midi variable length value, most significant 7 bits first */
+static int put_vlq(uint32_t value) {
+    uint8_t vlq[5];
+    int i = 0;
+
+    do {
+        vlq[i++] = value & 0x7f;
+        value >>= 7;
+    } while (value);
+    while (i > 1) {
+        if (put_byte(vlq[--i] | 0x80) != 0)
+            return (-1);
+    }
+    return (put_byte(vlq[0]));
+}
+
+/* hmp has them the other way round, ending on the byte with the top bit set */
+static int put_hmp_vlq(uint32_t value) {
+    while (value > 0x7f) {
+        if (put_byte(value & 0x7f) != 0)
+            return (-1);
+        value >>= 7;
+    }
+    return (put_byte(value | 0x80));
+}
+
+static int put_delta(int format, uint32_t delta) {
+    switch (format) {
+    case FORMAT_XMI:
+        /* xmi waits by summing bytes under 0x80 */
+        while (delta > 0x7f) {
+            if (put_byte(0x7f) != 0)
+                return (-1);
+            delta -= 0x7f;
+        }
+        if (delta)
+            return (put_byte(delta));
+        return (0);
+    case FORMAT_HMP:
+        return (put_hmp_vlq(delta));
+    default:
+        return (put_vlq(delta));
+    }
+}
+
+/*
+ * Writes the events of channel, or of them all if channel is negative, as
+ * a track of format. Xmi and hmi give the length of a note with its note
+ * on in place of note offs.
+ */
+static int put_track(int format, int channel) {
+    const struct _golden_event *event;
+    uint32_t start = song_size;
+    uint32_t now = 0;
+    uint32_t i;
+
+    for (i = 0; i < score_count; i++) {
+        event = &score[i];
+        if ((channel >= 0) && ((event->status & 0x0f) != channel))
+            continue;
+        if (((event->status & 0xf0) == 0x80)
+                && ((format == FORMAT_XMI) || (format == FORMAT_HMI)))
+            continue;
+        if ((put_delta(format, event->time - now) != 0)
+                || (put_byte(event->status) != 0)
+                || (put_byte(event->data1) != 0))
+            return (-1);
+        now = event->time;
+        if (((event->status & 0xf0) != 0xc0) && (put_byte(event->data2) != 0))
+            return (-1);
+        if (((event->status & 0xf0) == 0x90)
+                && ((format == FORMAT_XMI) || (format == FORMAT_HMI))
+                && (put_vlq(event->length) != 0))
+            return (-1);
+    }
+    /*
+     * the library reads an xmi event chunk to its end without skipping the
+     * pad byte, so waiting a tick apart keeps the chunk an even length
+     */
+    if ((format == FORMAT_XMI)
+            && ((song_size - start + ((GOLDEN_END - now + 0x7e) / 0x7f) + 3) & 1)) {
+        if (put_byte(1) != 0)
+            return (-1);
+        now++;
+    }
+    if ((put_delta(format, GOLDEN_END - now) != 0) || (put_byte(0xff) != 0)
+            || (put_byte(0x2f) != 0) || (put_byte(0) != 0))
+        return (-1);
+    return (0);
+}
+
+/* a type 1 midi file with a tempo track and a track for each channel */
+static int make_midi(void) {
+    static const uint8_t header[] = {
+        'M', 'T', 'h', 'd', 0, 0, 0, 6, 0, 1, 0, GOLDEN_CHANNELS + 1,
+        GOLDEN_DIVISIONS >> 8, GOLDEN_DIVISIONS & 0xff,
+        'M', 'T', 'r', 'k', 0, 0, 0, 21,
+        0, 0xff, 0x51, 3,
+        (GOLDEN_TEMPO >> 16) & 0xff, (GOLDEN_TEMPO >> 8) & 0xff, GOLDEN_TEMPO & 0xff,
+        0, 0xff, 0x03, 6, 'g', 'o', 'l', 'd', 'e', 'n',
+        0, 0xff, 0x2f, 0
+    };
+    uint32_t start;
+    int i;
+
+    if (put_bytes(header, sizeof(header)) != 0)
+        return (-1);
+    for (i = 0; i < GOLDEN_CHANNELS; i++) {
+        start = song_size;
+        if ((put_bytes("MTrk\0\0\0\0", 8) != 0)
+                || (put_track(FORMAT_MIDI, golden_channel[i]) != 0))
+            return (-1);
+        set_be32(start + 4, song_size - start - 8);
+    }
+    return (0);
+}
+
+static int begin_chunk(const char *tag, uint32_t *start) {
+    *start = song_size;
+    if ((put_bytes(tag, 4) != 0) || (put_bytes("\0\0\0\0", 4) != 0))
+        return (-1);
+    return (0);
+}
+
+/* iff chunks are padded to an even length, the pad byte not being counted */
+static int end_chunk(uint32_t start) {
+    set_be32(start + 4, song_size - start - 8);
+    if ((song_size & 1) && (put_byte(0) != 0))
+        return (-1);
+    return (0);
+}
+
+/* an xmi file of the one song, all its channels in the one event chunk */
+static int make_xmi(void) {
+    static const uint8_t info[] = { 1, 0 };
+    uint32_t form, chunk, cat, song;
+
+    if ((begin_chunk("FORM", &form) != 0) || (put_bytes("XDIR", 4) != 0)
+            || (begin_chunk("INFO", &chunk) != 0) || (put_bytes(info, 2) != 0)
+            || (end_chunk(chunk) != 0) || (end_chunk(form) != 0))
+        return (-1);
+    if ((begin_chunk("CAT ", &cat) != 0) || (put_bytes("XMID", 4) != 0)
+            || (begin_chunk("FORM", &song) != 0) || (put_bytes("XMID", 4) != 0)
+            || (begin_chunk("EVNT", &chunk) != 0) || (put_track(FORMAT_XMI, -1) != 0)
+            || (end_chunk(chunk) != 0) || (end_chunk(song) != 0) || (end_chunk(cat) != 0))
+        return (-1);
+    return (0);
+}
+
+/*
+ * Mus plays at 140 ticks a second with its own events, the drums on
+ * channel 15, and the wait after an event following it with the top bit
+ * of the event set.
+ */
+static int make_mus(void) {
+    static const uint8_t header[] = {
+        'M', 'U', 'S', 0x1a, 0, 0, 16, 0, GOLDEN_CHANNELS, 0, 0, 0, 0, 0, 0, 0
+    };
+    const struct _golden_event *event;
+    uint32_t now = 0, then;
+    uint32_t last = 0;
+    uint32_t i;
+    uint8_t ch;
+
+    if (put_bytes(header, sizeof(header)) != 0)
+        return (-1);
+    for (i = 0; i <= score_count; i++) {
+        event = (i < score_count) ? &score[i] : NULL;
+        then = (((event) ? event->time : GOLDEN_END) * 7 + 3) / 6;
+        if (then != now) {
+            song_data[last] |= 0x80;
+            if (put_vlq(then - now) != 0)
+                return (-1);
+            now = then;
+        }
+        last = song_size;
+        if (event == NULL)
+            break;
+
+        ch = event->status & 0x0f;
+        if (ch == 9)
+            ch = 15;
+        switch (event->status & 0xf0) {
+        case 0x80:
+            if ((put_byte(0x00 | ch) != 0) || (put_byte(event->data1) != 0))
+                return (-1);
+            break;
+        case 0x90:
+            if ((put_byte(0x10 | ch) != 0) || (put_byte(event->data1 | 0x80) != 0)
+                    || (put_byte(event->data2) != 0))
+                return (-1);
+            break;
+        case 0xc0:
+            if ((put_byte(0x40 | ch) != 0) || (put_byte(0) != 0)
+                    || (put_byte(event->data1) != 0))
+                return (-1);
+            break;
+        default:
+            /* the volume and pan controllers */
+            if ((put_byte(0x40 | ch) != 0) || (put_byte((event->data1 == 7) ? 3 : 4) != 0)
+                    || (put_byte(event->data2) != 0))
+                return (-1);
+            break;
+        }
+    }
+    /* score end */
+    if (put_byte(0x60) != 0)
+        return (-1);
+    song_data[4] = (song_size - 16) & 0xff;
+    song_data[5] = ((song_size - 16) >> 8) & 0xff;
+    return (0);
+}
+
+/* an hmp file with a chunk for each channel */
+static int make_hmp(void) {
+    uint32_t start;
+    int i;
+
+    if (put_bytes("HMIMIDIP", 8) != 0)
+        return (-1);
+    while (song_size < 776) {
+        if (put_byte(0) != 0)
+            return (-1);
+    }
+    set_le32(48, GOLDEN_CHANNELS);
+    set_le32(56, GOLDEN_BPM);
+    set_le32(60, GOLDEN_END / 120);
+
+    for (i = 0; i < GOLDEN_CHANNELS; i++) {
+        start = song_size;
+        if ((put_le32(i) != 0) || (put_le32(0) != 0) || (put_le32(i) != 0)
+                || (put_track(FORMAT_HMP, golden_channel[i]) != 0))
+            return (-1);
+        /* the length of a chunk counts its header */
+        set_le32(start + 4, song_size - start);
+    }
+    set_le32(32, song_size);
+    return (0);
+}
+
+/* an hmi file with a track for each channel */
+static int make_hmi(void) {
+    uint32_t start;
+    int i;
+
+    if (put_bytes("HMI-MIDISONG061595", 18) != 0)
+        return (-1);
+    while (song_size < 370 + (4 * GOLDEN_CHANNELS)) {
+        if (put_byte(0) != 0)
+            return (-1);
+    }
+    song_data[212] = GOLDEN_BPM;
+    song_data[228] = GOLDEN_CHANNELS;
+
+    for (i = 0; i < GOLDEN_CHANNELS; i++) {
+        start = song_size;
+        set_le32(370 + (4 * i), start);
+        if (put_bytes("HMI-MIDITRACK", 13) != 0)
+            return (-1);
+        while (song_size < start + 0x5b + 4) {
+            if (put_byte(0) != 0)
+                return (-1);
+        }
+        /* where the events of the track start */
+        set_le32(start + 0x57, 0x5b + 4);
+        if (put_track(FORMAT_HMI, golden_channel[i]) != 0)
+            return (-1);
+    }
+    return (0);
+}
+
+static int make_song(int format, uint8_t **data, uint32_t *size) {
+    int ret = -1;
+
+    song_data = NULL;
+    song_size = song_alloc = 0;
+    switch (format) {
+    case FORMAT_MIDI:
+        ret = make_midi();
+        break;
+    case FORMAT_XMI:
+        ret = make_xmi();
+        break;
+    case FORMAT_MUS:
+        ret = make_mus();
+        break;
+    case FORMAT_HMP:
+        ret = make_hmp();
+        break;
+    case FORMAT_HMI:
+        ret = make_hmi();
+        break;
+    }
+    if (ret != 0) {
+        free(song_data);
+        fprintf(stderr, "Out of memory\n");
+        return (-1);
+    }
+    *data = song_data;
+    *size = song_size;
+    return (0);
+}
+
+/*
+ * =========================
+ * The patch set
+ * =========================
+ */
+
+struct _golden_patch {
+    const char *name;
+    uint8_t modes;
+    uint32_t samples;
+    uint32_t loop_start;
+    uint32_t loop_end;
+};
+
+#define PATCH_16BIT     0x01
+#define PATCH_UNSIGNED  0x02
+#define PATCH_LOOP      0x04
+#define PATCH_PINGPONG  0x08
+#define PATCH_REVERSE   0x10
+#define PATCH_SUSTAIN   0x20
+#define PATCH_ENVELOPE  0x40
+
+static const struct _golden_patch golden_patch[] = {
+    { "golden0.pat", PATCH_16BIT | PATCH_LOOP | PATCH_SUSTAIN | PATCH_ENVELOPE, 8000, 2000, 7000 },
+    { "golden1.pat", PATCH_UNSIGNED, 6000, 0, 0 },
+    { "golden2.pat", PATCH_16BIT | PATCH_LOOP | PATCH_PINGPONG | PATCH_SUSTAIN | PATCH_ENVELOPE, 5000, 1000, 4000 },
+    { "golden3.pat", PATCH_16BIT | PATCH_REVERSE, 3000, 0, 0 },
+    { "golden4.pat", PATCH_UNSIGNED | PATCH_LOOP | PATCH_PINGPONG | PATCH_ENVELOPE, 4000, 500, 3500 },
+    { NULL, 0, 0, 0, 0 }
+};
+
+static const char golden_cfg[] =
+    "# written by wildmidi-golden\n"
+    "bank 0\n"
+    "0 golden0.pat\n"
+    "1 golden1.pat amp=120\n"
+    "2 golden2.pat\n"
+    "3 golden3.pat pan=30\n"
+    "4 golden4.pat\n"
+    "drumset 0\n"
+    "35 golden1.pat\n"
+    "36 golden4.pat\n"
+    "38 golden2.pat\n";
+
+static void put_le(uint8_t *data, uint32_t value, int bytes) {
+    int i;
+
+    for (i = 0; i < bytes; i++) {
+        data[i] = value & 0xff;
+        value >>= 8;
+    }
+}
+
+/*
+ * A triangle wave at around middle C with a little noise over it, at
+ * 22050 samples a second, either 16 bit or 8 bit. With unroll a ping pong
+ * loop is written out as the loader used to unroll it, forward through the
+ * loop, back to its start and on to the end of the sample, with the loop
+ * made a forward one over the way back and forth.
+ */
+static int write_patch(const char *dir, const struct _golden_patch *patch, int unroll) {
+    uint8_t header[239 + 96];
+    uint8_t *sample = &header[239];
+    static const uint8_t env_rate[6] = { 0x3f, 0x3f, 0x3f, 0x3f, 0x2f, 0x2f };
+    static const uint8_t env_offset[6] = { 250, 240, 230, 230, 60, 0 };
+    uint32_t bytes = (patch->modes & PATCH_16BIT) ? 2 : 1;
+    uint32_t loop_size = patch->loop_end - patch->loop_start;
+    uint32_t samples = patch->samples;
+    uint32_t loop_start = patch->loop_start;
+    uint32_t loop_end = patch->loop_end;
+    uint8_t modes = patch->modes;
+    uint8_t *data;
+    uint32_t i, from;
+    int32_t value;
+    char *path;
+    FILE *file;
+    int ret = 0;
+
+    if (!(modes & PATCH_PINGPONG))
+        unroll = 0;
+    if (unroll) {
+        samples += loop_size * 2;
+        loop_start += loop_size;
+        loop_end += loop_size * 2;
+        modes &= ~PATCH_PINGPONG;
+    }
+
+    memset(header, 0, sizeof(header));
+    memcpy(header, "GF1PATCH110\0ID#000002\0", 22);
+    header[82] = 1;     /* instruments */
+    header[83] = 14;    /* voices */
+    header[151] = 1;    /* layers */
+    header[198] = 1;    /* samples */
+    put_le(&sample[8], samples * bytes, 4);
+    put_le(&sample[12], loop_start * bytes, 4);
+    put_le(&sample[16], loop_end * bytes, 4);
+    put_le(&sample[20], 22050, 2);
+    put_le(&sample[22], 8176, 4);
+    put_le(&sample[26], 12543853, 4);
+    /* 84 samples a cycle */
+    put_le(&sample[30], 262500, 4);
+    memcpy(&sample[37], env_rate, 6);
+    memcpy(&sample[43], env_offset, 6);
+    sample[55] = modes;
+
+    data = (uint8_t *) malloc(patch->samples * bytes);
+    path = (char *) malloc(strlen(dir) + strlen(patch->name) + 2);
+    if ((data == NULL) || (path == NULL)) {
+        fprintf(stderr, "Out of memory\n");
+        free(data);
+        free(path);
+        return (-1);
+    }
+    golden_seed = patch->samples;
+    for (i = 0; i < patch->samples; i++) {
+        value = (int32_t) (i % 84);
+        value = ((value < 42) ? value : (84 - value)) * 1400 - 29400;
+        value += (int32_t) golden_rand(2001) - 1000;
+        if (patch->modes & PATCH_16BIT) {
+            if (patch->modes & PATCH_UNSIGNED)
+                value += 32768;
+            put_le(&data[i * 2], (uint32_t) value & 0xffff, 2);
+        } else {
+            value /= 256;
+            if (patch->modes & PATCH_UNSIGNED)
+                value += 128;
+            data[i] = (uint8_t) value;
+        }
+    }
+
+    sprintf(path, "%s/%s", dir, patch->name);
+    if ((file = fopen(path, "wb")) == NULL) {
+        fprintf(stderr, "Unable to write %s: %s\n", path, strerror(errno));
+        free(data);
+        free(path);
+        return (-1);
+    }
+    if (fwrite(header, sizeof(header), 1, file) != 1)
+        ret = -1;
+    for (i = 0; (ret == 0) && (i < samples); i++) {
+        from = i;
+        if (unroll && (i > patch->loop_end)) {
+            /* back from the loop end to its start, then on from there */
+            from = (i <= patch->loop_end + loop_size) ? ((patch->loop_end * 2) - i)
+                    : (i - (loop_size * 2));
+        }
+        if (fwrite(&data[from * bytes], bytes, 1, file) != 1)
+            ret = -1;
+    }
+    if (fclose(file) != 0)
+        ret = -1;
+    if (ret != 0)
+        fprintf(stderr, "Unable to write %s: %s\n", path, strerror(errno));
+    free(data);
+    free(path);
+    return (ret);
+}
+
+/* writes the patch set and its config to dir, returning the config name */
+static char *write_patch_set(const char *dir) {
+    char *cfg;
+    FILE *file;
+    int i;
+
+    for (i = 0; golden_patch[i].name != NULL; i++) {
+        if (write_patch(dir, &golden_patch[i], 0) != 0)
+            return (NULL);
+    }
+
+    cfg = (char *) malloc(strlen(dir) + sizeof("/golden.cfg"));
+    if (cfg == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return (NULL);
+    }
+    sprintf(cfg, "%s/golden.cfg", dir);
+    if (((file = fopen(cfg, "w")) == NULL)
+            || (fputs(golden_cfg, file) == EOF) || (fclose(file) != 0)) {
+        fprintf(stderr, "Unable to write %s: %s\n", cfg, strerror(errno));
+        free(cfg);
+        return (NULL);
+    }
+    return (cfg);
+}
+
+/*
+ * =========================
+ * Rendering
+ * =========================
+ */
+
+/* without 64 bit constants, which not every c89 compiler takes */
+#define FNV_BASIS ((((uint64_t) 0xcbf29ce4) << 32) | 0x84222325)
+#define FNV_PRIME ((((uint64_t) 0x00000100) << 32) | 0x000001b3)
+
+/* render the songs through a bus, see WildMidi_CreateBus() */
+static int use_bus;
+
+/* render the songs on this many threads, see WildMidi_SetRenderThreads() */
+static int render_threads;
+
+/* the next frames of the song into buffer, returns the bytes written */
+static int render_block(midi *handle, wm_bus *bus, int16_t *buffer, uint32_t frames) {
+    struct _WM_Info *info;
+    uint32_t left;
+
+    if (bus == NULL)
+        return (WildMidi_GetOutput(handle, (int8_t *) buffer, (frames * 4)));
+
+    /* a bus plays on past the end of its songs */
+    if ((info = WildMidi_GetInfo(handle)) == NULL)
+        return (-1);
+    left = info->approx_total_samples - info->current_sample;
+    if (left < frames)
+        frames = left;
+    if (frames == 0)
+        return (0);
+    return (WildMidi_BusRender(bus, frames, buffer, WM_FMT_S16) * 4);
+}
+
+/* fnv-1a over the samples as little endian 16 bit */
+static uint64_t hash_samples(uint64_t hash, const int16_t *samples, uint32_t count) {
+    uint32_t i;
+
+    for (i = 0; i < count; i++) {
+        hash = (hash ^ ((uint16_t) samples[i] & 0xff)) * FNV_PRIME;
+        hash = (hash ^ ((uint16_t) samples[i] >> 8)) * FNV_PRIME;
+    }
+    return (hash);
+}
+
+/*
+ * Renders song through with resampler, keeping what the golden file checks
+ * in result if it is not NULL, and all of the output in output if that is
+ * not NULL, for the caller to free. Returns the time taken in milliseconds,
+ * or a negative value on error.
+ */
+static double render_song(const uint8_t *data, uint32_t size, int resampler,
+                          struct _golden_result *result, int16_t **output) {
+    static int16_t buffer[4096 * 2];
+    double block_sum[GOLDEN_BLOCKS];
+    double *sums = NULL;
+    int16_t *kept = NULL;
+    uint32_t frames = 0, alloc = 0, kept_alloc = 0;
+    uint32_t i, block;
+    double start, ms;
+    midi *handle;
+    wm_bus *bus = NULL;
+    int got;
+
+    if ((handle = WildMidi_OpenBuffer(data, size)) == NULL) {
+        fprintf(stderr, "Unable to open the song: %s\n", WildMidi_GetError());
+        WildMidi_ClearError();
+        return (-1.0);
+    }
+    if (resampler && (WildMidi_SetOption(handle, WM_MO_ENHANCED_RESAMPLING,
+                                         WM_MO_ENHANCED_RESAMPLING) != 0)) {
+        fprintf(stderr, "Unable to set options: %s\n", WildMidi_GetError());
+        WildMidi_Close(handle);
+        return (-1.0);
+    }
+    if ((render_threads > 1)
+            && (WildMidi_SetRenderThreads(handle, (uint8_t) render_threads) != 0)) {
+        fprintf(stderr, "Unable to set the render threads: %s\n", WildMidi_GetError());
+        WildMidi_ClearError();
+        WildMidi_Close(handle);
+        return (-1.0);
+    }
+    if (use_bus && (((bus = WildMidi_CreateBus(0)) == NULL)
+            || (WildMidi_BusAdd(bus, handle, WM_BUS_UNITY) != 0))) {
+        fprintf(stderr, "Unable to set up the bus: %s\n", WildMidi_GetError());
+        WildMidi_ClearError();
+        if (bus != NULL)
+            WildMidi_FreeBus(bus);
+        WildMidi_Close(handle);
+        return (-1.0);
+    }
+
+    if (result != NULL) {
+        memset(result, 0, sizeof(struct _golden_result));
+        result->hash = FNV_BASIS;
+    }
+    start = golden_clock();
+    while ((got = render_block(handle, bus, buffer, 4096)) > 0) {
+        if (result != NULL) {
+            uint32_t count = (uint32_t) got / 2;
+            result->hash = hash_samples(result->hash, buffer, count);
+            /* the loudness of every 1024 frames, put into blocks at the end */
+            if ((frames + (count / 2)) / 1024 + 1 > alloc) {
+                double *more = (double *) realloc(sums, sizeof(double) * (alloc + 64));
+                if (more == NULL) {
+                    free(sums);
+                    if (bus != NULL)
+                        WildMidi_FreeBus(bus);
+                    WildMidi_Close(handle);
+                    fprintf(stderr, "Out of memory\n");
+                    return (-1.0);
+                }
+                memset(&more[alloc], 0, sizeof(double) * 64);
+                sums = more;
+                alloc += 64;
+            }
+            for (i = 0; i < count; i++) {
+                sums[(frames + (i / 2)) / 1024] += (double) buffer[i] * (double) buffer[i];
+            }
+        }
+        if (output != NULL) {
+            if (frames + ((uint32_t) got / 4) > kept_alloc) {
+                int16_t *more = (int16_t *) realloc(kept,
+                                    sizeof(int16_t) * 2 * (kept_alloc + 65536));
+                if (more == NULL) {
+                    free(kept);
+                    free(sums);
+                    if (bus != NULL)
+                        WildMidi_FreeBus(bus);
+                    WildMidi_Close(handle);
+                    fprintf(stderr, "Out of memory\n");
+                    return (-1.0);
+                }
+                kept = more;
+                kept_alloc += 65536;
+            }
+            memcpy(&kept[frames * 2], buffer, (size_t) got);
+        }
+        frames += (uint32_t) got / 4;
+    }
+    ms = golden_clock() - start;
+    if (bus != NULL)
+        WildMidi_FreeBus(bus);
+    WildMidi_Close(handle);
+    if (got < 0) {
+        fprintf(stderr, "Unable to render the song: %s\n", WildMidi_GetError());
+        WildMidi_ClearError();
+        free(kept);
+        free(sums);
+        return (-1.0);
+    }
+    if (output != NULL)
+        *output = kept;
+
+    if (result != NULL) {
+        result->frames = frames;
+        memset(block_sum, 0, sizeof(block_sum));
+        for (i = 0; i < (frames + 1023) / 1024; i++) {
+            block = (uint32_t) (((double) i * 1024.0 * GOLDEN_BLOCKS) / (double) frames);
+            block_sum[(block < GOLDEN_BLOCKS) ? block : (GOLDEN_BLOCKS - 1)] += sums[i];
+        }
+        for (block = 0; block < GOLDEN_BLOCKS; block++) {
+            result->rms[block] = (uint32_t) (sqrt(block_sum[block]
+                    / ((double) frames * 2.0 / GOLDEN_BLOCKS)) + 0.5);
+        }
+        free(sums);
+    }
+    return (ms);
+}
+
+/*
+ * =========================
+ * Golden and baseline files
+ * =========================
+ */
+
+/*
+ * The golden file holds the output of the tree from before the changes it
+ * checks, then of each change since that altered the output on purpose, a
+ * line for each render they changed, in the order they were made:
+ *   type resampler change error frames hash rms ...
+ * with the hash in hex and error the percent the loudness of each part may
+ * differ from that of the line before it. Reads the lines for format and
+ * resampler into result, returning how many there are.
+ */
+static int read_golden(FILE *file, int format, int resampler,
+                       struct _golden_result *result, int max) {
+    char line[512];
+    char type[16], resample[16], hash[17];
+    char *next;
+    unsigned long frames;
+    int block, used;
+    int count = 0;
+
+    rewind(file);
+    while ((count < max) && (fgets(line, sizeof(line), file) != NULL)) {
+        if ((line[0] == '#') || (sscanf(line, "%15s %15s %31s %lf %lu %16s%n", type, resample,
+                                        result->change, &result->error, &frames, hash,
+                                        &used) < 6))
+            continue;
+        if ((strcmp(type, format_name[format]) != 0)
+                || (strcmp(resample, resampler_name[resampler]) != 0))
+            continue;
+
+        result->frames = (uint32_t) frames;
+        result->hash = 0;
+        for (next = hash; *next; next++) {
+            result->hash <<= 4;
+            if ((*next >= '0') && (*next <= '9')) {
+                result->hash |= *next - '0';
+            } else if ((*next >= 'a') && (*next <= 'f')) {
+                result->hash |= *next - 'a' + 10;
+            }
+        }
+        next = &line[used];
+        for (block = 0; block < GOLDEN_BLOCKS; block++) {
+            result->rms[block] = (uint32_t) strtoul(next, &next, 10);
+        }
+        result++;
+        count++;
+    }
+    return (count);
+}
+
+static void write_golden(FILE *file, int format, int resampler,
+                         const struct _golden_result *result) {
+    int block;
+
+    fprintf(file, "%s %s %s %g %lu %08lx%08lx", format_name[format],
+            resampler_name[resampler], result->change, result->error,
+            (unsigned long) result->frames, (unsigned long) (result->hash >> 32),
+            (unsigned long) (result->hash & 0xffffffff));
+    for (block = 0; block < GOLDEN_BLOCKS; block++) {
+        fprintf(file, " %lu", (unsigned long) result->rms[block]);
+    }
+    fprintf(file, "\n");
+}
+
+/* whether got is close enough to want, each block within error percent */
+static int within_error(const struct _golden_result *got,
+                        const struct _golden_result *want, double error) {
+    double bound;
+    int block;
+
+    if (got->frames != want->frames)
+        return (0);
+    for (block = 0; block < GOLDEN_BLOCKS; block++) {
+        bound = (double) want->rms[block] * error / 100.0;
+        /* a block of silence should stay close to silent */
+        if (bound < 1.0)
+            bound = 1.0;
+        if (fabs((double) got->rms[block] - (double) want->rms[block]) > bound)
+            return (0);
+    }
+    return (1);
+}
+
+/*
+ * Checks the lines of a render in the golden file against each other, each
+ * change within its error of the output before it, and the whole of them
+ * within the errors added up of the baseline. Returns 0 if they all are.
+ */
+static int check_changes(const struct _golden_result *want, int count) {
+    double error = 0.0;
+    int i;
+
+    for (i = 1; i < count; i++) {
+        error += want[i].error;
+        if (!within_error(&want[i], &want[i - 1], want[i].error)) {
+            printf("FAILED, %s is not within %g%% of %s\n", want[i].change, want[i].error,
+                   want[i - 1].change);
+            return (-1);
+        }
+        if (!within_error(&want[i], &want[0], error)) {
+            printf("FAILED, %s is not within %g%% of %s\n", want[i].change, error,
+                   want[0].change);
+            return (-1);
+        }
+    }
+    return (0);
+}
+
+static void print_changes(const struct _golden_result *want, int count) {
+    int i;
+
+    for (i = count - 1; i > 0; i--) {
+        printf(", %s within %g%% of %s", want[i].change, want[i].error, want[i - 1].change);
+    }
+    printf("\n");
+}
+
+/*
+ * Checks every render against the last line the golden file has for it. With
+ * update, a render that is not bit exact with that line is added to the file
+ * as the output of change instead, as long as it is within error of it.
+ */
+static int check_golden(const char *golden_file, int only, double error,
+                        const char *change, int update) {
+    struct _golden_result got[FORMATS][2];
+    struct _golden_result want[GOLDEN_CHANGES];
+    FILE *file;
+    uint8_t *data;
+    uint32_t size;
+    int format, resampler;
+    int count;
+    int failed = 0;
+    int added = 0;
+
+    file = fopen(golden_file, "r");
+    if ((file == NULL) && !(update && (errno == ENOENT))) {
+        fprintf(stderr, "Unable to open %s: %s\n", golden_file, strerror(errno));
+        return (1);
+    }
+
+    for (format = 0; format < FORMATS; format++) {
+        for (resampler = 0; resampler < 2; resampler++) {
+            got[format][resampler].frames = 0;
+        }
+        if ((only >= 0) && (format != only))
+            continue;
+        if (make_song(format, &data, &size) != 0) {
+            failed++;
+            continue;
+        }
+        for (resampler = 0; resampler < 2; resampler++) {
+            struct _golden_result *result = &got[format][resampler];
+            printf("%s %s: ", format_name[format], resampler_name[resampler]);
+            count = (file != NULL) ? read_golden(file, format, resampler, want, GOLDEN_CHANGES) : 0;
+            if (render_song(data, size, resampler, result, NULL) < 0.0) {
+                printf("FAILED to render\n");
+                failed++;
+                continue;
+            }
+            strncpy(result->change, (update) ? change : "this", sizeof(result->change) - 1);
+            result->error = (update && (count != 0)) ? error : 0.0;
+            if (check_changes(want, count) != 0) {
+                failed++;
+            } else if ((count != 0) && (result->frames == want[count - 1].frames)
+                    && (result->hash == want[count - 1].hash)) {
+                printf("%lu frames, bit exact with %s", (unsigned long) result->frames,
+                       want[count - 1].change);
+                print_changes(want, count);
+                result->frames = 0;
+            } else if (update && ((count == 0) || within_error(result, &want[count - 1], error))) {
+                printf("%lu frames, the output of %s\n", (unsigned long) result->frames, change);
+                added++;
+            } else if ((count != 0) && (!update) && (error > 0.0)
+                    && within_error(result, &want[count - 1], error)) {
+                printf("%lu frames, within %g%% of %s", (unsigned long) result->frames,
+                       error, want[count - 1].change);
+                print_changes(want, count);
+            } else if (count == 0) {
+                printf("FAILED, not in %s\n", golden_file);
+                failed++;
+            } else {
+                printf("FAILED, the output changed\n  got:  ");
+                write_golden(stdout, format, resampler, result);
+                printf("  want: ");
+                write_golden(stdout, format, resampler, &want[count - 1]);
+                failed++;
+            }
+        }
+        free(data);
+    }
+    if (file != NULL)
+        fclose(file);
+    if (failed || !added)
+        return ((failed) ? 1 : 0);
+
+    /* only ever added to, so every change stays checked against the baseline */
+    if ((file = fopen(golden_file, "a")) == NULL) {
+        fprintf(stderr, "Unable to write %s: %s\n", golden_file, strerror(errno));
+        return (1);
+    }
+    if (ftell(file) == 0) {
+        fprintf(file, "# written by wildmidi-golden -u, do not edit\n");
+        fprintf(file, "# type resampler change error frames hash rms of each sixteenth\n");
+    }
+    for (format = 0; format < FORMATS; format++) {
+        for (resampler = 0; resampler < 2; resampler++) {
+            if (got[format][resampler].frames != 0)
+                write_golden(file, format, resampler, &got[format][resampler]);
+        }
+    }
+    if (fclose(file) != 0) {
+        fprintf(stderr, "Unable to write %s: %s\n", golden_file, strerror(errno));
+        return (1);
+    }
+    return (0);
+}
+
+/*
+ * =========================
+ * Ping pong loops
+ * =========================
+ */
+
+/* how far below the loudness of want its difference to got is, in db */
+static double signal_to_noise(const int16_t *want, const int16_t *got, uint32_t count) {
+    double signal = 0.0, noise = 0.0, diff;
+    uint32_t i;
+
+    for (i = 0; i < count; i++) {
+        diff = (double) got[i] - (double) want[i];
+        signal += (double) want[i] * (double) want[i];
+        noise += diff * diff;
+    }
+    if (noise == 0.0)
+        return (HUGE_VAL);
+    if (signal == 0.0)
+        return (0.0);
+    return (10.0 * log10(signal / noise));
+}
+
+/*
+ * The mixer turns around at the ends of a ping pong loop where the loader
+ * used to unroll it. Renders the loop song with the patch set as it is,
+ * then with the ping pong patches written out unrolled the way the loader
+ * did, which plays them just as it used to, failing if the two are not
+ * within bound[resampler] db of each other. Leaves the library set up with
+ * the unrolled patches.
+ */
+static int check_loops(const char *cfg, const char *dir, uint16_t options, const double *bound) {
+    struct _golden_result got[2], want[2];
+    int16_t *got_output[2] = { NULL, NULL };
+    int16_t *want_output[2] = { NULL, NULL };
+    uint8_t *data;
+    uint32_t size;
+    double snr;
+    int resampler, i;
+    int rendered = 0;
+    int failed = 0;
+
+    if ((make_loop_score() != 0) || (make_song(FORMAT_MIDI, &data, &size) != 0))
+        return (1);
+
+    for (resampler = 0; resampler < 2; resampler++) {
+        if (render_song(data, size, resampler, &got[resampler], &got_output[resampler]) >= 0.0)
+            rendered++;
+    }
+
+    WildMidi_Shutdown();
+    for (i = 0; golden_patch[i].name != NULL; i++) {
+        if ((golden_patch[i].modes & PATCH_PINGPONG)
+                && (write_patch(dir, &golden_patch[i], 1) != 0))
+            failed++;
+    }
+    if (WildMidi_Init(cfg, GOLDEN_RATE, options) == -1) {
+        fprintf(stderr, "%s\n", WildMidi_GetError());
+        WildMidi_ClearError();
+        failed++;
+    } else {
+        WildMidi_MasterVolume(100);
+        for (resampler = 0; resampler < 2; resampler++) {
+            if (render_song(data, size, resampler, &want[resampler],
+                            &want_output[resampler]) >= 0.0)
+                rendered++;
+        }
+    }
+
+    for (resampler = 0; (rendered == 4) && (resampler < 2); resampler++) {
+        printf("loops %s: ", resampler_name[resampler]);
+        if (got[resampler].frames != want[resampler].frames) {
+            printf("FAILED, %lu frames where unrolled it is %lu\n",
+                   (unsigned long) got[resampler].frames,
+                   (unsigned long) want[resampler].frames);
+            failed++;
+            continue;
+        }
+        snr = signal_to_noise(want_output[resampler], got_output[resampler],
+                              want[resampler].frames * 2);
+        if (snr == HUGE_VAL) {
+            printf("ok, the same as unrolled\n");
+        } else if (snr >= bound[resampler]) {
+            printf("ok, %.1f db from unrolled\n", snr);
+        } else {
+            printf("FAILED, %.1f db from unrolled, under %g db\n", snr, bound[resampler]);
+            failed++;
+        }
+    }
+
+    for (resampler = 0; resampler < 2; resampler++) {
+        free(got_output[resampler]);
+        free(want_output[resampler]);
+    }
+    free(data);
+    return ((failed || (rendered != 4)) ? 1 : 0);
+}
+
+/*
+ * =========================
+ * Render times
+ * =========================
+ */
+
+static uint32_t calibrate_sink;
+
+/*
+ * A fixed amount of mixing done the plain way, a sample of a voice at a
+ * time with linear interpolation as the mixer worked before it was
+ * vectorized. The renders are timed against it, so their times can be
+ * held to those of another machine, or of the library as it was before.
+ * Returns the milliseconds it took.
+ */
+static double calibrate(void) {
+    static int16_t wave[4096 + 1];
+    static int32_t mix[1024 * 2];
+    uint32_t pos[16], inc[16];
+    int32_t vol_l[16], vol_r[16];
+    uint32_t block, i, v, ofs, frac;
+    int32_t sample;
+    double start;
+
+    for (i = 0; i <= 4096; i++) {
+        sample = (int32_t) (i % 84);
+        wave[i] = (int16_t) (((sample < 42) ? sample : (84 - sample)) * 1400 - 29400);
+    }
+    for (v = 0; v < 16; v++) {
+        pos[v] = 0;
+        inc[v] = 700 + (v * 97);
+        vol_l[v] = 200 + (v * 10);
+        vol_r[v] = 400 - (v * 10);
+    }
+
+    start = golden_clock();
+    for (block = 0; block < 400; block++) {
+        memset(mix, 0, sizeof(mix));
+        for (v = 0; v < 16; v++) {
+            for (i = 0; i < 1024; i++) {
+                ofs = (pos[v] >> 10) & 4095;
+                frac = pos[v] & 1023;
+                sample = wave[ofs] + (((wave[ofs + 1] - wave[ofs]) * (int32_t) frac) >> 10);
+                mix[i * 2] += (sample * vol_l[v]) >> 10;
+                mix[i * 2 + 1] += (sample * vol_r[v]) >> 10;
+                pos[v] += inc[v];
+            }
+        }
+        /* so none of it can be left out */
+        calibrate_sink += (uint32_t) mix[block & 2047];
+    }
+    return (golden_clock() - start);
+}
+
+/*
+ * The reference file holds the time of each render over that of the
+ * calibration loop, for each build type, as of the library before the
+ * changes and of each change since that was timed:
+ *   build change type resampler ratio
+ * Adds up the ratios of the first and of the last change recorded for
+ * build in first and last, returning 0 if there are any.
+ */
+static int read_reference(FILE *file, const char *build, int only,
+                          double *first, double *last, char *first_change, char *last_change) {
+    char line[128];
+    char type[16], resample[16], built[32], change[32];
+    char now[32];
+    double ratio;
+    int format;
+
+    *first = *last = 0.0;
+    now[0] = first_change[0] = '\0';
+    if (file == NULL)
+        return (-1);
+    rewind(file);
+    while (fgets(line, sizeof(line), file) != NULL) {
+        if ((line[0] == '#') || (sscanf(line, "%31s %31s %15s %15s %lf", built, change,
+                                        type, resample, &ratio) != 5))
+            continue;
+        if (strcmp(built, build) != 0)
+            continue;
+        for (format = 0; format < FORMATS; format++) {
+            if (strcmp(type, format_name[format]) == 0)
+                break;
+        }
+        if ((format == FORMATS) || ((only >= 0) && (format != only)))
+            continue;
+        if (first_change[0] == '\0')
+            strcpy(first_change, change);
+        if (strcmp(change, now) != 0) {
+            strcpy(now, change);
+            *last = 0.0;
+        }
+        if (strcmp(change, first_change) == 0)
+            *first += ratio;
+        *last += ratio;
+    }
+    strcpy(last_change, now);
+    return ((first_change[0] == '\0') ? -1 : 0);
+}
+
+/*
+ * Times each render against the calibration loop run just before it, and
+ * keeps the best of runs. Fails if all the renders together are over slower
+ * percent slower than the last change recorded in the reference file for
+ * build, or not at least faster percent faster than the first, the library
+ * from before the changes. A render on its own is too short to hold to the
+ * bounds without tripping over the noise of whatever else the machine is
+ * doing. With update, the times are added to the reference file as those
+ * of change instead.
+ */
+static int check_perf(const char *reference_file, const char *build, int only,
+                      double slower, double faster, int runs, const char *change, int update) {
+    double ratio[FORMATS][2];
+    double best, took, cal;
+    double total = 0.0, first, last;
+    char first_change[32], last_change[32];
+    FILE *file;
+    uint8_t *data;
+    uint32_t size;
+    int format, resampler, run;
+    int failed = 0;
+
+    file = fopen(reference_file, "r");
+    if ((file == NULL) && !(update && (errno == ENOENT))) {
+        fprintf(stderr, "Unable to open %s: %s\n", reference_file, strerror(errno));
+        return (1);
+    }
+    if ((read_reference(file, build, only, &first, &last, first_change, last_change) != 0)
+            && !update) {
+        printf("No reference for a %s build in %s, not timed\n", build, reference_file);
+        fclose(file);
+        return (GOLDEN_SKIPPED);
+    }
+    if (file != NULL)
+        fclose(file);
+
+    for (format = 0; format < FORMATS; format++) {
+        ratio[format][0] = ratio[format][1] = -1.0;
+        if ((only >= 0) && (format != only))
+            continue;
+        if (make_song(format, &data, &size) != 0) {
+            failed++;
+            continue;
+        }
+        for (resampler = 0; resampler < 2; resampler++) {
+            best = -1.0;
+            for (run = 0; run < runs; run++) {
+                cal = calibrate();
+                if ((took = render_song(data, size, resampler, NULL, NULL)) < 0.0)
+                    break;
+                if ((best < 0.0) || ((took / cal) < best))
+                    best = took / cal;
+            }
+            printf("%s %s: ", format_name[format], resampler_name[resampler]);
+            if (run < runs) {
+                printf("FAILED to render\n");
+                failed++;
+                continue;
+            }
+            ratio[format][resampler] = best;
+            total += best;
+            printf("%.3f of the calibration loop\n", best);
+        }
+        free(data);
+    }
+    if (failed)
+        return (1);
+
+    if (!update) {
+        printf("All: %.3f against %.3f for %s, %+.0f%%, and %.3f for %s, %+.0f%%\n",
+               total, last, last_change, (total / last - 1.0) * 100.0,
+               first, first_change, (total / first - 1.0) * 100.0);
+        if (total > last * (1.0 + (slower / 100.0))) {
+            printf("FAILED, over %g%% slower than %s\n", slower, last_change);
+            failed++;
+        }
+        if (total > first * (1.0 - (faster / 100.0))) {
+            printf("FAILED, not %g%% faster than %s\n", faster, first_change);
+            failed++;
+        }
+        return ((failed) ? 1 : 0);
+    }
+
+    /* only ever added to, like the golden file */
+    if ((file = fopen(reference_file, "a")) == NULL) {
+        fprintf(stderr, "Unable to write %s: %s\n", reference_file, strerror(errno));
+        return (1);
+    }
+    if (ftell(file) == 0) {
+        fprintf(file, "# written by wildmidi-golden -p -u, do not edit\n");
+        fprintf(file, "# build change type resampler time over that of the calibration loop\n");
+    }
+    for (format = 0; format < FORMATS; format++) {
+        for (resampler = 0; resampler < 2; resampler++) {
+            if (ratio[format][resampler] >= 0.0)
+                fprintf(file, "%s %s %s %s %.3f\n", build, change, format_name[format],
+                        resampler_name[resampler], ratio[format][resampler]);
+        }
+    }
+    if (fclose(file) != 0) {
+        fprintf(stderr, "Unable to write %s: %s\n", reference_file, strerror(errno));
+        return (1);
+    }
+    return (0);
+}
+
+int main(int argc, char **argv) {
+    const char *golden_file = "golden.txt";
+    const char *reference_file = NULL;
+    const char *build = "Release";
+    const char *dir = ".";
+    const char *change = NULL;
+    double error = 0.0;
+    double slower = 25.0;
+    double faster = 0.0;
+    double loops[2] = { -1.0, -1.0 };
+    int runs = 5;
+    uint16_t options = 0;
+    int update = 0;
+    int only = -1;
+    int option_index = 0;
+    char *cfg;
+    int ret;
+    int i;
+
+    while (1) {
+        i = getopt_long(argc, argv, "g:t:d:e:p:B:s:f:n:o:bj:uc:l:L:h", long_options, &option_index);
+        if (i == -1)
+            break;
+        switch (i) {
+        case 'g':
+            golden_file = optarg;
+            break;
+        case 't':
+            for (only = 0; only < FORMATS; only++) {
+                if (strcmp(optarg, format_name[only]) == 0)
+                    break;
+            }
+            if (only == FORMATS) {
+                fprintf(stderr, "Unknown type %s\n", optarg);
+                return (1);
+            }
+            break;
+        case 'd':
+            dir = optarg;
+            break;
+        case 'e':
+            error = atof(optarg);
+            break;
+        case 'p':
+            reference_file = optarg;
+            break;
+        case 'B':
+            build = optarg;
+            break;
+        case 's':
+            slower = atof(optarg);
+            break;
+        case 'f':
+            faster = atof(optarg);
+            break;
+        case 'n':
+            runs = atoi(optarg);
+            if (runs < 1) runs = 1;
+            break;
+        case 'o':
+            options = (uint16_t) strtol(optarg, NULL, 0);
+            break;
+        case 'b':
+            use_bus = 1;
+            break;
+        case 'j':
+            render_threads = atoi(optarg);
+            break;
+        case 'u':
+            update = 1;
+            break;
+        case 'c':
+            change = optarg;
+            break;
+        case 'l':
+            loops[0] = atof(optarg);
+            break;
+        case 'L':
+            loops[1] = atof(optarg);
+            break;
+        case 'h':
+            do_help();
+            return (0);
+        default:
+            do_help();
+            return (1);
+        }
+    }
+
+    if (loops[1] < 0.0)
+        loops[1] = loops[0];
+    if (update && (change == NULL)) {
+        fprintf(stderr, "The change the output is of has to be given with -c\n");
+        return (1);
+    }
+
+    if ((make_score() != 0) || ((cfg = write_patch_set(dir)) == NULL)) {
+        free(score);
+        return (1);
+    }
+    if (WildMidi_Init(cfg, GOLDEN_RATE, options) == -1) {
+        fprintf(stderr, "%s\n", WildMidi_GetError());
+        WildMidi_ClearError();
+        free(cfg);
+        free(score);
+        return (1);
+    }
+    WildMidi_MasterVolume(100);
+
+    if ((loops[0] >= 0.0) || (loops[1] >= 0.0)) {
+        ret = check_loops(cfg, dir, options, loops);
+    } else if (reference_file != NULL) {
+        ret = check_perf(reference_file, build, only, slower, faster, runs, change, update);
+    } else {
+        ret = check_golden(golden_file, only, error, change, update);
+    }
+
+    WildMidi_Shutdown();
+    free(cfg);
+    free(score);
+    return (ret);
+}